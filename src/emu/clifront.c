@@ -165,6 +165,17 @@ int cli_execute(int argc, char **argv, const options_entry *osd_options)
 		goto error;
 	}
 
+	/* benchmarks run flat out for a fixed amount of emulated time; these */
+	/* settings override anything the INI files might say */
+	if (options_get_int(options, OPTION_BENCH) > 0)
+	{
+		options_set_int(options, OPTION_SECONDS_TO_RUN, options_get_int(options, OPTION_BENCH), OPTION_PRIORITY_MAXIMUM);
+		options_set_bool(options, OPTION_THROTTLE, FALSE, OPTION_PRIORITY_MAXIMUM);
+		options_set_bool(options, OPTION_SKIP_GAMEINFO, TRUE, OPTION_PRIORITY_MAXIMUM);
+		options_set_int(options, OPTION_FRAMESKIP, 0, OPTION_PRIORITY_MAXIMUM);
+		options_set_bool(options, OPTION_AUTOFRAMESKIP, FALSE, OPTION_PRIORITY_MAXIMUM);
+	}
+
 	/* run the game */
 	result = mame_execute(options);
 
@@ -430,13 +430,22 @@ CPUDEFS += -DHAS_SH2=$(if $(filter SH2,$(CPUS)),1,0)
 
 ifneq ($(filter SH2,$(CPUS)),)
 OBJDIRS += $(CPUOBJ)/sh2
-CPUOBJS += $(CPUOBJ)/sh2/sh2.o
 DBGOBJS += $(CPUOBJ)/sh2/sh2dasm.o
+
+ifdef X86_SH2_DRC
+CPUOBJS += $(CPUOBJ)/sh2/sh2drc.o $(DRCOBJ)
+else
+CPUOBJS += $(CPUOBJ)/sh2/sh2.o
+endif
 endif
 
 $(CPUOBJ)/sh2/sh2.o:	$(CPUSRC)/sh2/sh2.c \
 						$(CPUSRC)/sh2/sh2.h
 
+$(CPUOBJ)/sh2/sh2drc.o:	$(CPUSRC)/sh2/sh2drc.c \
+						$(CPUSRC)/sh2/sh2.c \
+						$(CPUSRC)/sh2/sh2.h
+
 #-------------------------------------------------
 # Hitachi SH4
 #-------------------------------------------------
@@ -88,11 +88,22 @@
 
 #define ICOUNTADDR			MABS(&mips3.core->icount)
 
+#ifdef PTR64
+#define FASTRAMADDR(disp)	MBISD(REG_DRC_TEMP, REG_EBX, 1, disp)
+#else
+#define FASTRAMADDR(disp)	MBD(REG_EBX, fastbase + (disp))
+#endif
+
 
 /***************************************************************************
     USEFUL PRIMITIVES
 ***************************************************************************/
 
+#ifdef PTR64
+#define emit_mov_r64_m64	emit_mov_r64pair_m64
+#define emit_mov_m64_r64	emit_mov_m64_r64pair
+#endif
+
 INLINE void emit_mov_r64_m64(x86code **emitptr, UINT8 reghi, UINT8 reglo, DECLARE_MEMPARAMS)
 {
 	emit_mov_r32_m32(emitptr, reglo, MEMPARAMS);
@@ -191,6 +202,7 @@ static UINT32 compile_one(drc_core *drc, UINT32 pc, UINT32 physpc);
 
 static void append_generate_exception(drc_core *drc, UINT8 exception);
 static void append_readwrite_and_translate(drc_core *drc, int size, UINT8 flags);
+static void append_tlb_lookup(drc_core *drc, UINT8 dreg, UINT8 indexreg);
 static void append_tlb_verify(drc_core *drc, UINT32 pc, void *target);
 static void append_update_cycle_counting(drc_core *drc);
 static void append_check_interrupts(drc_core *drc, int inline_generate);
@@ -327,7 +339,7 @@ static void drc_reset_callback(drc_core *drc)
 	mips3.drcdata->handle_pc_tlb_mismatch = drc->cache_top;
 	emit_mov_r32_r32(DRCTOP, REG_EAX, REG_EDI);												// mov  eax,edi
 	emit_shr_r32_imm(DRCTOP, REG_EAX, 12);													// shr  eax,12
-	emit_mov_r32_m32(DRCTOP, REG_EBX, MISD(REG_EAX, 4, mips3.core->tlb_table));				// mov  ebx,tlb_table[eax*4]
+	append_tlb_lookup(drc, REG_EBX, REG_EAX);												// mov  ebx,tlb_table[eax*4]
 	emit_test_r32_imm(DRCTOP, REG_EBX, 2);													// test ebx,2
 	emit_mov_r32_r32(DRCTOP, REG_EAX, REG_EDI);												// mov  eax,edi
 	emit_jcc(DRCTOP, COND_NZ, mips3.drcdata->generate_tlbload_exception);					// jnz  generate_tlbload_exception
@@ -480,7 +492,7 @@ exit:
 
 static void drc_entrygen_callback(drc_core *drc)
 {
-	emit_mov_r32_imm(DRCTOP, REG_ESI, (FPTR)&mips3.core->r[17]);
+	emit_mov_rp_imm(DRCTOP, REG_ESI, &mips3.core->r[17]);
 	append_check_interrupts(drc, 1);
 }
 
@@ -614,10 +626,10 @@ static void append_readwrite_and_translate(drc_core *drc, int size, UINT8 flags)
 	emit_link link1 = { 0 }, link2 = { 0 }, link3 = { 0 };
 	int ramnum;
 
-	emit_mov_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 4));										// mov  eax,[esp+4]
+	emit_mov_r32_m32(DRCTOP, REG_EAX, MSTACK(4));											// mov  eax,[esp+4]
 	emit_mov_r32_r32(DRCTOP, REG_EBX, REG_EAX);												// mov  ebx,eax
 	emit_shr_r32_imm(DRCTOP, REG_EBX, 12);													// shr  ebx,12
-	emit_mov_r32_m32(DRCTOP, REG_EBX, MISD(REG_EBX, 4, mips3.core->tlb_table));				// mov  ebx,tlb_table[ebx*4]
+	append_tlb_lookup(drc, REG_EBX, REG_EBX);												// mov  ebx,tlb_table[ebx*4]
 	emit_and_r32_imm(DRCTOP, REG_EAX, 0xfff);												// and  eax,0xfff
 	emit_shr_r32_imm(DRCTOP, REG_EBX, ((flags & ARW_WRITE) ? 1 : 2));						// shr  ebx,2/1 (read/write)
 	emit_lea_r32_m32(DRCTOP, REG_EBX, MBISD(REG_EAX, REG_EBX, ((flags & ARW_WRITE) ? 2 : 4), 0));
@@ -626,7 +638,7 @@ static void append_readwrite_and_translate(drc_core *drc, int size, UINT8 flags)
 	for (ramnum = 0; ramnum < MIPS3_MAX_FASTRAM; ramnum++)
 		if (!Machine->debug_mode && mips3.fastram[ramnum].base && (!(flags & ARW_WRITE) || !mips3.fastram[ramnum].readonly))
 		{
-			UINT32 fastbase = (UINT32)((UINT8 *)mips3.fastram[ramnum].base - mips3.fastram[ramnum].start);
+			FPTR fastbase = (FPTR)((UINT8 *)mips3.fastram[ramnum].base - mips3.fastram[ramnum].start);
 			if (mips3.fastram[ramnum].end != 0xffffffff)
 			{
 				emit_cmp_r32_imm(DRCTOP, REG_EBX, mips3.fastram[ramnum].end);				// cmp  ebx,fastram_end
@@ -637,6 +649,9 @@ static void append_readwrite_and_translate(drc_core *drc, int size, UINT8 flags)
 				emit_cmp_r32_imm(DRCTOP, REG_EBX, mips3.fastram[ramnum].start);				// cmp  ebx,fastram_start
 				emit_jcc_short_link(DRCTOP, COND_B, &link3);								// jb   notram
 			}
+#ifdef PTR64
+			emit_mov_r64_imm(DRCTOP, REG_DRC_TEMP, fastbase);								// mov  r11,fastbase
+#endif
 
 			if (!(flags & ARW_WRITE))
 			{
@@ -645,28 +660,28 @@ static void append_readwrite_and_translate(drc_core *drc, int size, UINT8 flags)
 					if (mips3.core->bigendian)
 						emit_xor_r32_imm(DRCTOP, REG_EBX, 3);								// xor   ebx,3
 					if (flags & ARW_SIGNED)
-						emit_movsx_r32_m8(DRCTOP, REG_EAX, MBD(REG_EBX, fastbase));			// movsx eax,byte ptr [ebx+fastbase]
+						emit_movsx_r32_m8(DRCTOP, REG_EAX, FASTRAMADDR(0));					// movsx eax,byte ptr [ebx+fastbase]
 					else
-						emit_movzx_r32_m8(DRCTOP, REG_EAX, MBD(REG_EBX, fastbase));			// movzx eax,byte ptr [ebx+fastbase]
+						emit_movzx_r32_m8(DRCTOP, REG_EAX, FASTRAMADDR(0));					// movzx eax,byte ptr [ebx+fastbase]
 				}
 				else if (size == 2)
 				{
 					if (mips3.core->bigendian)
 						emit_xor_r32_imm(DRCTOP, REG_EBX, 2);								// xor   ebx,2
 					if (flags & ARW_SIGNED)
-						emit_movsx_r32_m16(DRCTOP, REG_EAX, MBD(REG_EBX, fastbase));		// movsx eax,word ptr [ebx+fastbase]
+						emit_movsx_r32_m16(DRCTOP, REG_EAX, FASTRAMADDR(0));				// movsx eax,word ptr [ebx+fastbase]
 					else
-						emit_movzx_r32_m16(DRCTOP, REG_EAX, MBD(REG_EBX, fastbase));		// movzx eax,word ptr [ebx+fastbase]
+						emit_movzx_r32_m16(DRCTOP, REG_EAX, FASTRAMADDR(0));				// movzx eax,word ptr [ebx+fastbase]
 				}
 				else if (size == 4)
-					emit_mov_r32_m32(DRCTOP, REG_EAX, MBD(REG_EBX, fastbase));				// mov   eax,[ebx+fastbase]
+					emit_mov_r32_m32(DRCTOP, REG_EAX, FASTRAMADDR(0));						// mov   eax,[ebx+fastbase]
 				else if (size == 8)
 				{
 					if (mips3.core->bigendian)
-						emit_mov_r64_m64(DRCTOP, REG_EAX, REG_EDX, MBD(REG_EBX, (FPTR)fastbase));
+						emit_mov_r64_m64(DRCTOP, REG_EAX, REG_EDX, FASTRAMADDR(0));
 																							// mov   eax:edx,[ebx+fastbase]
 					else
-						emit_mov_r64_m64(DRCTOP, REG_EDX, REG_EAX, MBD(REG_EBX, (FPTR)fastbase));
+						emit_mov_r64_m64(DRCTOP, REG_EDX, REG_EAX, FASTRAMADDR(0));
 																							// mov   edx:eax,[ebx+fastbase]
 				}
 				emit_ret(DRCTOP);															// ret
@@ -675,34 +690,34 @@ static void append_readwrite_and_translate(drc_core *drc, int size, UINT8 flags)
 			{
 				if (size == 1)
 				{
-					emit_mov_r8_m8(DRCTOP, REG_AL, MBD(REG_ESP, 8));						// mov   al,[esp+8]
+					emit_mov_r8_m8(DRCTOP, REG_AL, MSTACK(8));								// mov   al,[esp+8]
 					if (mips3.core->bigendian)
 						emit_xor_r32_imm(DRCTOP, REG_EBX, 3);								// xor   ebx,3
-					emit_mov_m8_r8(DRCTOP, MBD(REG_EBX, fastbase), REG_AL);					// mov   [ebx+fastbase],al
+					emit_mov_m8_r8(DRCTOP, FASTRAMADDR(0), REG_AL);							// mov   [ebx+fastbase],al
 				}
 				else if (size == 2)
 				{
-					emit_mov_r16_m16(DRCTOP, REG_AX, MBD(REG_ESP, 8));						// mov   ax,[esp+8]
+					emit_mov_r16_m16(DRCTOP, REG_AX, MSTACK(8));							// mov   ax,[esp+8]
 					if (mips3.core->bigendian)
 						emit_xor_r32_imm(DRCTOP, REG_EBX, 2);								// xor   ebx,2
-					emit_mov_m16_r16(DRCTOP, MBD(REG_EBX, fastbase), REG_AX);				// mov   [ebx+fastbase],ax
+					emit_mov_m16_r16(DRCTOP, FASTRAMADDR(0), REG_AX);						// mov   [ebx+fastbase],ax
 				}
 				else if (size == 4)
 				{
 					if (!(flags & ARW_MASKED))
 					{
-						emit_mov_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 8));					// mov   eax,[esp+8]
-						emit_mov_m32_r32(DRCTOP, MBD(REG_EBX, fastbase), REG_EAX);			// mov   [ebx+fastbase],eax
+						emit_mov_r32_m32(DRCTOP, REG_EAX, MSTACK(8));						// mov   eax,[esp+8]
+						emit_mov_m32_r32(DRCTOP, FASTRAMADDR(0), REG_EAX);					// mov   [ebx+fastbase],eax
 					}
 					else
 					{
-						emit_mov_r32_m32(DRCTOP, REG_ECX, MBD(REG_ESP, 12));				// mov   ecx,[esp+12]
+						emit_mov_r32_m32(DRCTOP, REG_ECX, MSTACK(12));						// mov   ecx,[esp+12]
 						emit_mov_r32_r32(DRCTOP, REG_EAX, REG_ECX);							// mov   eax,ecx
-						emit_and_r32_m32(DRCTOP, REG_ECX, MBD(REG_EBX, fastbase));			// and   ecx,[ebx+fastbase]
+						emit_and_r32_m32(DRCTOP, REG_ECX, FASTRAMADDR(0));					// and   ecx,[ebx+fastbase]
 						emit_not_r32(DRCTOP, REG_EAX);										// not   eax
-						emit_and_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 8));					// and   eax,[esp+8]
+						emit_and_r32_m32(DRCTOP, REG_EAX, MSTACK(8));						// and   eax,[esp+8]
 						emit_or_r32_r32(DRCTOP, REG_EAX, REG_ECX);							// or    eax,ecx
-						emit_mov_m32_r32(DRCTOP, MBD(REG_EBX, fastbase), REG_EAX);			// mov   [ebx+fastbase],eax
+						emit_mov_m32_r32(DRCTOP, FASTRAMADDR(0), REG_EAX);					// mov   [ebx+fastbase],eax
 					}
 				}
 				else if (size == 8)
@@ -711,54 +726,54 @@ static void append_readwrite_and_translate(drc_core *drc, int size, UINT8 flags)
 					{
 						if (mips3.core->bigendian)
 						{
-							emit_mov_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 8));				// mov   eax,[esp+8]
-							emit_mov_m32_r32(DRCTOP, MBD(REG_EBX, fastbase+4), REG_EAX);	// mov   [ebx+fastbase+4],eax
-							emit_mov_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 12));			// mov   eax,[esp+12]
-							emit_mov_m32_r32(DRCTOP, MBD(REG_EBX, fastbase), REG_EAX);		// mov   [ebx+fastbase],eax
+							emit_mov_r32_m32(DRCTOP, REG_EAX, MSTACK(8));					// mov   eax,[esp+8]
+							emit_mov_m32_r32(DRCTOP, FASTRAMADDR(4), REG_EAX);				// mov   [ebx+fastbase+4],eax
+							emit_mov_r32_m32(DRCTOP, REG_EAX, MSTACK(12));					// mov   eax,[esp+12]
+							emit_mov_m32_r32(DRCTOP, FASTRAMADDR(0), REG_EAX);				// mov   [ebx+fastbase],eax
 						}
 						else
 						{
-							emit_mov_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 8));				// mov   eax,[esp+8]
-							emit_mov_m32_r32(DRCTOP, MBD(REG_EBX, fastbase), REG_EAX);		// mov   [ebx+fastbase],eax
-							emit_mov_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 12));			// mov   eax,[esp+12]
-							emit_mov_m32_r32(DRCTOP, MBD(REG_EBX, fastbase+4), REG_EAX);	// mov   [ebx+fastbase+4],eax
+							emit_mov_r32_m32(DRCTOP, REG_EAX, MSTACK(8));					// mov   eax,[esp+8]
+							emit_mov_m32_r32(DRCTOP, FASTRAMADDR(0), REG_EAX);				// mov   [ebx+fastbase],eax
+							emit_mov_r32_m32(DRCTOP, REG_EAX, MSTACK(12));					// mov   eax,[esp+12]
+							emit_mov_m32_r32(DRCTOP, FASTRAMADDR(4), REG_EAX);				// mov   [ebx+fastbase+4],eax
 						}
 					}
 					else
 					{
 						if (mips3.core->bigendian)
 						{
-							emit_mov_r32_m32(DRCTOP, REG_ECX, MBD(REG_ESP, 16));			// mov   ecx,[esp+16]
+							emit_mov_r32_m32(DRCTOP, REG_ECX, MSTACK(16));					// mov   ecx,[esp+16]
 							emit_mov_r32_r32(DRCTOP, REG_EAX, REG_ECX);						// mov   eax,ecx
-							emit_and_r32_m32(DRCTOP, REG_ECX, MBD(REG_EBX, fastbase+4));	// and   ecx,[ebx+fastbase+4]
+							emit_and_r32_m32(DRCTOP, REG_ECX, FASTRAMADDR(4));				// and   ecx,[ebx+fastbase+4]
 							emit_not_r32(DRCTOP, REG_EAX);									// not   eax
-							emit_and_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 8));				// and   eax,[esp+8]
+							emit_and_r32_m32(DRCTOP, REG_EAX, MSTACK(8));					// and   eax,[esp+8]
 							emit_or_r32_r32(DRCTOP, REG_EAX, REG_ECX);						// or    eax,ecx
-							emit_mov_m32_r32(DRCTOP, MBD(REG_EBX, fastbase+4), REG_EAX);	// mov   [ebx+fastbase+4],eax
-							emit_mov_r32_m32(DRCTOP, REG_ECX, MBD(REG_ESP, 20));			// mov   ecx,[esp+20]
+							emit_mov_m32_r32(DRCTOP, FASTRAMADDR(4), REG_EAX);				// mov   [ebx+fastbase+4],eax
+							emit_mov_r32_m32(DRCTOP, REG_ECX, MSTACK(20));					// mov   ecx,[esp+20]
 							emit_mov_r32_r32(DRCTOP, REG_EAX, REG_ECX);						// mov   eax,ecx
-							emit_and_r32_m32(DRCTOP, REG_ECX, MBD(REG_EBX, fastbase));		// and   ecx,[ebx+fastbase]
+							emit_and_r32_m32(DRCTOP, REG_ECX, FASTRAMADDR(0));				// and   ecx,[ebx+fastbase]
 							emit_not_r32(DRCTOP, REG_EAX);									// not   eax
-							emit_and_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 12));			// and   eax,[esp+12]
+							emit_and_r32_m32(DRCTOP, REG_EAX, MSTACK(12));					// and   eax,[esp+12]
 							emit_or_r32_r32(DRCTOP, REG_EAX, REG_ECX);						// or    eax,ecx
-							emit_mov_m32_r32(DRCTOP, MBD(REG_EBX, fastbase), REG_EAX);		// mov   [ebx+fastbase],eax
+							emit_mov_m32_r32(DRCTOP, FASTRAMADDR(0), REG_EAX);				// mov   [ebx+fastbase],eax
 						}
 						else
 						{
-							emit_mov_r32_m32(DRCTOP, REG_ECX, MBD(REG_ESP, 16));			// mov   ecx,[esp+16]
+							emit_mov_r32_m32(DRCTOP, REG_ECX, MSTACK(16));					// mov   ecx,[esp+16]
 							emit_mov_r32_r32(DRCTOP, REG_EAX, REG_ECX);						// mov   eax,ecx
-							emit_and_r32_m32(DRCTOP, REG_ECX, MBD(REG_EBX, fastbase));		// and   ecx,[ebx+fastbase]
+							emit_and_r32_m32(DRCTOP, REG_ECX, FASTRAMADDR(0));				// and   ecx,[ebx+fastbase]
 							emit_not_r32(DRCTOP, REG_EAX);									// not   eax
-							emit_and_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 8));				// and   eax,[esp+8]
+							emit_and_r32_m32(DRCTOP, REG_EAX, MSTACK(8));					// and   eax,[esp+8]
 							emit_or_r32_r32(DRCTOP, REG_EAX, REG_ECX);						// or    eax,ecx
-							emit_mov_m32_r32(DRCTOP, MBD(REG_EBX, fastbase), REG_EAX);		// mov   [ebx+fastbase],eax
-							emit_mov_r32_m32(DRCTOP, REG_ECX, MBD(REG_ESP, 20));			// mov   ecx,[esp+20]
+							emit_mov_m32_r32(DRCTOP, FASTRAMADDR(0), REG_EAX);				// mov   [ebx+fastbase],eax
+							emit_mov_r32_m32(DRCTOP, REG_ECX, MSTACK(20));					// mov   ecx,[esp+20]
 							emit_mov_r32_r32(DRCTOP, REG_EAX, REG_ECX);						// mov   eax,ecx
-							emit_and_r32_m32(DRCTOP, REG_ECX, MBD(REG_EBX, fastbase+4));	// and   ecx,[ebx+fastbase+4]
+							emit_and_r32_m32(DRCTOP, REG_ECX, FASTRAMADDR(4));				// and   ecx,[ebx+fastbase+4]
 							emit_not_r32(DRCTOP, REG_EAX);									// not   eax
-							emit_and_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 12));			// and   eax,[esp+12]
+							emit_and_r32_m32(DRCTOP, REG_EAX, MSTACK(12));					// and   eax,[esp+12]
 							emit_or_r32_r32(DRCTOP, REG_EAX, REG_ECX);						// or    eax,ecx
-							emit_mov_m32_r32(DRCTOP, MBD(REG_EBX, fastbase+4), REG_EAX);	// mov   [ebx+fastbase+4],eax
+							emit_mov_m32_r32(DRCTOP, FASTRAMADDR(4), REG_EAX);				// mov   [ebx+fastbase+4],eax
 						}
 					}
 				}
@@ -773,81 +788,96 @@ static void append_readwrite_and_translate(drc_core *drc, int size, UINT8 flags)
 
 	if (flags & ARW_WRITE)
 	{
-		emit_mov_m32_r32(DRCTOP, MBD(REG_ESP, 4), REG_EBX);									// mov  [esp+4],ebx
+		emit_mov_m32_r32(DRCTOP, MSTACK(4), REG_EBX);										// mov  [esp+4],ebx
 		if (size == 1)
-			emit_jmp(DRCTOP, (x86code *)mips3.core->memory.writebyte);						// jmp  writebyte
+			drc_append_tail_call_c(drc, (x86code *)mips3.core->memory.writebyte, "ii");		// jmp  writebyte
 		else if (size == 2)
-			emit_jmp(DRCTOP, (x86code *)mips3.core->memory.writeword);						// jmp  writeword
+			drc_append_tail_call_c(drc, (x86code *)mips3.core->memory.writeword, "ii");		// jmp  writeword
 		else if (size == 4)
 		{
 			if (!(flags & ARW_MASKED))
-				emit_jmp(DRCTOP, (x86code *)mips3.core->memory.writelong);					// jmp  writelong
+				drc_append_tail_call_c(drc, (x86code *)mips3.core->memory.writelong, "ii");	// jmp  writelong
 			else
-				emit_jmp(DRCTOP, (x86code *)mips3.core->memory.writelong_masked);			// jmp  writelong_masked
+				drc_append_tail_call_c(drc, (x86code *)mips3.core->memory.writelong_masked, "iii");	// jmp  writelong_masked
 		}
 		else
 		{
 			if (!(flags & ARW_MASKED))
-				emit_jmp(DRCTOP, (x86code *)mips3.core->memory.writedouble);				// jmp  writedouble
+				drc_append_tail_call_c(drc, (x86code *)mips3.core->memory.writedouble, "iq");	// jmp  writedouble
 			else
-				emit_jmp(DRCTOP, (x86code *)mips3.core->memory.writedouble_masked);			// jmp  writedouble_masked
+				drc_append_tail_call_c(drc, (x86code *)mips3.core->memory.writedouble_masked, "iqq");	// jmp  writedouble_masked
 		}
 	}
 	else
 	{
 		if (size == 1)
 		{
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			emit_push_r32(DRCTOP, REG_EBX);													// push ebx
-			emit_call(DRCTOP, (x86code *)mips3.core->memory.readbyte);						// call  readbyte
+			drc_append_call_c(drc, (x86code *)mips3.core->memory.readbyte, "i");			// call  readbyte
 			if (flags & ARW_SIGNED)
 				emit_movsx_r32_r8(DRCTOP, REG_EAX, REG_AL);									// movsx eax,al
 			else
 				emit_movzx_r32_r8(DRCTOP, REG_EAX, REG_AL);									// movzx eax,al
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_ret(DRCTOP);																// ret
 		}
 		else if (size == 2)
 		{
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			emit_push_r32(DRCTOP, REG_EBX);													// push ebx
-			emit_call(DRCTOP, (x86code *)mips3.core->memory.readword);						// call  readword
+			drc_append_call_c(drc, (x86code *)mips3.core->memory.readword, "i");			// call  readword
 			if (flags & ARW_SIGNED)
 				emit_movsx_r32_r16(DRCTOP, REG_EAX, REG_AX);								// movsx eax,ax
 			else
 				emit_movzx_r32_r16(DRCTOP, REG_EAX, REG_AX);								// movzx eax,ax
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_ret(DRCTOP);																// ret
 		}
 		else if (size == 4)
 		{
-			emit_mov_m32_r32(DRCTOP, MBD(REG_ESP, 4), REG_EBX);								// mov  [esp+4],ebx
+			emit_mov_m32_r32(DRCTOP, MSTACK(4), REG_EBX);									// mov  [esp+4],ebx
 			if (!(flags & ARW_MASKED))
-				emit_jmp(DRCTOP, (x86code *)mips3.core->memory.readlong);					// jmp  readlong
+				drc_append_tail_call_c(drc, (x86code *)mips3.core->memory.readlong, "i");	// jmp  readlong
 			else
-				emit_jmp(DRCTOP, (x86code *)mips3.core->memory.readlong_masked);			// jmp  readlong_masked
+				drc_append_tail_call_c(drc, (x86code *)mips3.core->memory.readlong_masked, "ii");	// jmp  readlong_masked
 		}
 		else
 		{
-			emit_mov_m32_r32(DRCTOP, MBD(REG_ESP, 4), REG_EBX);								// mov  [esp+4],ebx
+			emit_mov_m32_r32(DRCTOP, MSTACK(4), REG_EBX);									// mov  [esp+4],ebx
 			if (!(flags & ARW_MASKED))
-				emit_jmp(DRCTOP, (x86code *)mips3.core->memory.readdouble);					// jmp  readdouble
+				drc_append_tail_call_c(drc, (x86code *)mips3.core->memory.readdouble, "i");	// jmp  readdouble
 			else
-				emit_jmp(DRCTOP, (x86code *)mips3.core->memory.readdouble_masked);			// jmp  readdouble_masked
+				drc_append_tail_call_c(drc, (x86code *)mips3.core->memory.readdouble_masked, "iq");	// jmp  readdouble_masked
 		}
 	}
 	{
 		int valuebytes = (size == 8) ? 8 : 4;
 		int stackbytes = 4 + ((flags & ARW_WRITE) ? 4 + valuebytes : 4) + ((flags & ARW_MASKED) ? valuebytes : 0);
 		resolve_link(DRCTOP, &link1);													// error:
-		emit_mov_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 4));									// mov  eax,[esp+4]
-		emit_add_r32_imm(DRCTOP, REG_ESP, stackbytes);										// add  esp,stack_bytes
+		emit_mov_r32_m32(DRCTOP, REG_EAX, MSTACK(4));										// mov  eax,[esp+4]
+		emit_stack_free(DRCTOP, stackbytes);												// add  esp,stack_bytes
 		emit_jmp(DRCTOP, (flags & ARW_WRITE) ? (x86code *)mips3.drcdata->generate_tlbstore_exception : (x86code *)mips3.drcdata->generate_tlbload_exception);
 																							// jmp    generate_exception
 	}
 }
 
 
+/*------------------------------------------------------------------
+    append_tlb_lookup
+------------------------------------------------------------------*/
+
+static void append_tlb_lookup(drc_core *drc, UINT8 dreg, UINT8 indexreg)
+{
+#ifdef PTR64
+	emit_mov_rp_mp(DRCTOP, REG_DRC_TEMP, MABS(&mips3.core->tlb_table));					// mov  r11,[tlb_table]
+	emit_mov_r32_m32(DRCTOP, dreg, MBISD(REG_DRC_TEMP, indexreg, 4, 0));					// mov  dreg,[r11+indexreg*4]
+#else
+	emit_mov_r32_m32(DRCTOP, dreg, MISD(indexreg, 4, mips3.core->tlb_table));				// mov  dreg,tlb_table[indexreg*4]
+#endif
+}
+
+
 /*------------------------------------------------------------------
     append_tlb_verify
 ------------------------------------------------------------------*/
@@ -857,7 +887,12 @@ static void append_tlb_verify(drc_core *drc, UINT32 pc, void *target)
 	/* addresses 0x80000000-0xbfffffff are direct-mapped; no checking needed */
 	if (pc < 0x80000000 || pc >= 0xc0000000)
 	{
+#ifdef PTR64
+		emit_mov_rp_mp(DRCTOP, REG_DRC_TEMP, MABS(&mips3.core->tlb_table));				// mov  r11,[tlb_table]
+		emit_cmp_m32_imm(DRCTOP, MBD(REG_DRC_TEMP, (pc >> 12) * 4), mips3.core->tlb_table[pc >> 12]);
+#else
 		emit_cmp_m32_imm(DRCTOP, MABS(&mips3.core->tlb_table[pc >> 12]), mips3.core->tlb_table[pc >> 12]);
+#endif
 																							// cmp  tlbtable[pc >> 12],physpc & 0xfffff000
 		emit_jcc(DRCTOP, COND_NE, target);													// jne  handle_pc_tlb_mismatch
 	}
@@ -870,11 +905,11 @@ static void append_tlb_verify(drc_core *drc, UINT32 pc, void *target)
 
 static void append_update_cycle_counting(drc_core *drc)
 {
-	emit_sub_r32_imm(DRCTOP, REG_ESP, 8);													// sub  esp,8
+	emit_stack_alloc(DRCTOP, 8);															// sub  esp,8
 	emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);											// mov  [icount],ebp
-	emit_push_imm(DRCTOP, (FPTR)mips3.core);												// push mips3.core
-	emit_call(DRCTOP, (x86code *)mips3com_update_cycle_counting);							// call update_cycle_counting
-	emit_add_r32_imm(DRCTOP, REG_ESP, 12);													// add  esp,12
+	emit_push_pointer(DRCTOP, mips3.core);													// push mips3.core
+	drc_append_call_c(drc, (x86code *)mips3com_update_cycle_counting, "p");					// call update_cycle_counting
+	emit_stack_free(DRCTOP, 12);															// add  esp,12
 	emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);											// mov  ebp,[icount]
 }
 
@@ -947,7 +982,13 @@ static void append_branch_or_dispatch(drc_core *drc, UINT32 newpc, int cycles)
 
 static void ddiv(INT64 *rs, INT64 *rt)
 {
-	if (*rt)
+	/* dividing by -1 can overflow, which traps on x86 but not on the MIPS */
+	if (*rt == -1)
+	{
+		mips3.core->lo = 0 - (UINT64)*rs;
+		mips3.core->hi = 0;
+	}
+	else if (*rt)
 	{
 		mips3.core->lo = *rs / *rt;
 		mips3.core->hi = *rs % *rt;
@@ -1179,11 +1220,12 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			{
 				if (RSREG != 0)
 				{
+					emit_xor_r32_r32(DRCTOP, REG_ECX, REG_ECX);								// xor  ecx,ecx
 					emit_mov_r64_m64(DRCTOP, REG_EDX, REG_EAX, REGADDR(RSREG));				// mov  edx:eax,[rsreg]
 					emit_sub_r32_imm(DRCTOP, REG_EAX, SIMMVAL);								// sub  eax,[rtreg].lo
 					emit_sbb_r32_imm(DRCTOP, REG_EDX, ((INT32)SIMMVAL >> 31));				// sbb  edx,[rtreg].lo
-					emit_shr_r32_imm(DRCTOP, REG_EDX, 31);									// shr  edx,31
-					emit_mov_m32_r32(DRCTOP, REGADDRLO(RTREG), REG_EDX);					// mov  [rdreg].lo,edx
+					emit_setcc_r8(DRCTOP, COND_L, REG_CL);									// setl cl
+					emit_mov_m32_r32(DRCTOP, REGADDRLO(RTREG), REG_ECX);					// mov  [rdreg].lo,ecx
 					emit_mov_m32_imm(DRCTOP, REGADDRHI(RTREG), 0);							// mov  [rdreg].hi,0
 				}
 				else
@@ -1214,7 +1256,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 				}
 				else
 				{
-					emit_mov_m32_imm(DRCTOP, REGADDRLO(RTREG), (0 < SIMMVAL));				// mov  [rtreg].lo,const
+					emit_mov_m32_imm(DRCTOP, REGADDRLO(RTREG), (SIMMVAL != 0));				// mov  [rtreg].lo,const
 					emit_mov_m32_imm(DRCTOP, REGADDRHI(RTREG), 0);							// mov  [rtreg].hi,sign-extend(const)
 				}
 			}
@@ -1453,7 +1495,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			emit_push_r32(DRCTOP, REG_EBX);													// push ebx
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_double_masked);				// call read_and_translate_double_masked
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_pop_r32(DRCTOP, REG_ECX);													// pop  ecx
 
 			if (RTREG != 0)
@@ -1500,7 +1542,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			emit_push_r32(DRCTOP, REG_EBX);													// push ebx
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_double_masked);				// call read_and_translate_double_masked
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_pop_r32(DRCTOP, REG_ECX);													// pop  ecx
 
 			if (RTREG != 0)
@@ -1582,7 +1624,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x20:	/* LB */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
@@ -1594,7 +1636,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_byte_signed);				// call read_and_translate_byte_signed
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			if (RTREG != 0)
 			{
 				emit_cdq(DRCTOP);															// cdq
@@ -1606,7 +1648,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x21:	/* LH */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
@@ -1618,7 +1660,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_word_signed);				// call read_and_translate_word_signed
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			if (RTREG != 0)
 			{
 				emit_cdq(DRCTOP);															// cdq
@@ -1630,7 +1672,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x22:	/* LWL */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
 			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));							// mov  eax,[rsreg].lo
 			if (SIMMVAL)
 				emit_add_r32_imm(DRCTOP, REG_EAX, SIMMVAL);									// add  eax,SIMMVAL
@@ -1645,7 +1687,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			emit_push_r32(DRCTOP, REG_EBX);													// push ebx
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_long_masked);				// call read_and_translate_long_masked
-			emit_add_r32_imm(DRCTOP, REG_ESP, 8);											// add  esp,8
+			emit_stack_free(DRCTOP, 8);														// add  esp,8
 			emit_pop_r32(DRCTOP, REG_ECX);													// pop  ecx
 
 			if (RTREG != 0)
@@ -1659,14 +1701,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 				emit_cdq(DRCTOP);															// cdq
 				emit_mov_m64_r64(DRCTOP, REGADDR(RTREG), REG_EDX, REG_EAX);					// mov  [rtreg],edx:eax
 			}
-			emit_add_r32_imm(DRCTOP, REG_ESP, 4);											// add  esp,4
+			emit_stack_free(DRCTOP, 4);														// add  esp,4
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x23:	/* LW */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
@@ -1678,7 +1720,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_long);						// call read_and_translate_long
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			if (RTREG != 0)
 			{
 				emit_cdq(DRCTOP);															// cdq
@@ -1690,7 +1732,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x24:	/* LBU */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
@@ -1702,7 +1744,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_byte_unsigned);				// call read_and_translate_byte_unsigned
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			if (RTREG != 0)
 			{
 				emit_mov_m32_imm(DRCTOP, REGADDRHI(RTREG), 0);								// mov  [rtreg].hi,0
@@ -1714,7 +1756,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x25:	/* LHU */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
@@ -1726,7 +1768,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_word_unsigned);				// call read_and_translate_word_unsigned
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			if (RTREG != 0)
 			{
 				emit_mov_m32_imm(DRCTOP, REGADDRHI(RTREG), 0);								// mov  [rtreg].hi,0
@@ -1738,7 +1780,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x26:	/* LWR */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
 			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));							// mov  eax,[rsreg].lo
 			if (SIMMVAL)
 				emit_add_r32_imm(DRCTOP, REG_EAX, SIMMVAL);									// add  eax,SIMMVAL
@@ -1753,7 +1795,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			emit_push_r32(DRCTOP, REG_EBX);													// push ebx
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_long_masked);				// call read_and_translate_long_masked
-			emit_add_r32_imm(DRCTOP, REG_ESP, 8);											// add  esp,8
+			emit_stack_free(DRCTOP, 8);														// add  esp,8
 			emit_pop_r32(DRCTOP, REG_ECX);													// pop  ecx
 
 			if (RTREG != 0)
@@ -1767,14 +1809,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 				emit_cdq(DRCTOP);															// cdq
 				emit_mov_m64_r64(DRCTOP, REGADDR(RTREG), REG_EDX, REG_EAX);					// mov  [rtreg],edx:eax
 			}
-			emit_add_r32_imm(DRCTOP, REG_ESP, 4);											// add  esp,4
+			emit_stack_free(DRCTOP, 4);														// add  esp,4
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x27:	/* LWU */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
@@ -1786,7 +1828,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_long);						// call read_and_translate_long
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			if (RTREG != 0)
 			{
 				emit_mov_m32_imm(DRCTOP, REGADDRHI(RTREG), 0);								// mov  [rtreg].hi,0
@@ -1798,7 +1840,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x28:	/* SB */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
 			if (RTREG != 0)
 				emit_push_m32(DRCTOP, REGADDRLO(RTREG));									// push dword [rtreg].lo
 			else
@@ -1814,14 +1856,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_byte);						// call writebyte
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x29:	/* SH */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
 			if (RTREG != 0)
 				emit_push_m32(DRCTOP, REGADDRLO(RTREG));									// push dword [rtreg].lo
 			else
@@ -1837,14 +1879,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_word);						// call writeword
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x2a:	/* SWL */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
 			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));							// mov  eax,[rsreg].lo
 			if (SIMMVAL)
 				emit_add_r32_imm(DRCTOP, REG_EAX, SIMMVAL);									// add  eax,SIMMVAL
@@ -1866,14 +1908,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 				emit_push_imm(DRCTOP, 0);													// push 0
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_long_masked);				// call write_and_translate_long_masked
-			emit_add_r32_imm(DRCTOP, REG_ESP, 16);											// add  esp,16
+			emit_stack_free(DRCTOP, 16);													// add  esp,16
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x2b:	/* SW */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
 			if (RTREG != 0)
 				emit_push_m32(DRCTOP, REGADDRLO(RTREG));									// push dword [rtreg].lo
 			else
@@ -1889,14 +1931,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_long);						// call write_and_translate_long
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x2c:	/* SDL */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 12);											// sub  esp,12
+			emit_stack_alloc(DRCTOP, 12);													// sub  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));							// mov  eax,[rsreg].lo
 			if (SIMMVAL)
 				emit_add_r32_imm(DRCTOP, REG_EAX, SIMMVAL);									// add  eax,SIMMVAL
@@ -1931,14 +1973,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			}
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_double_masked);			// call write_and_translate_double_masked
-			emit_add_r32_imm(DRCTOP, REG_ESP, 32);											// add  esp,32
+			emit_stack_free(DRCTOP, 32);													// add  esp,32
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x2d:	/* SDR */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 12);											// sub  esp,12
+			emit_stack_alloc(DRCTOP, 12);													// sub  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));							// mov  eax,[rsreg].lo
 			if (SIMMVAL)
 				emit_add_r32_imm(DRCTOP, REG_EAX, SIMMVAL);									// add  eax,SIMMVAL
@@ -1973,14 +2015,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			}
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_double_masked);			// call write_and_translate_double_masked
-			emit_add_r32_imm(DRCTOP, REG_ESP, 32);											// add  esp,32
+			emit_stack_free(DRCTOP, 32);													// add  esp,32
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x2e:	/* SWR */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
 			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));							// mov  eax,[rsreg].lo
 			if (SIMMVAL)
 				emit_add_r32_imm(DRCTOP, REG_EAX, SIMMVAL);									// add  eax,SIMMVAL
@@ -2002,7 +2044,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 				emit_push_imm(DRCTOP, 0);													// push 0
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_long_masked);				// call write_and_translate_long_masked
-			emit_add_r32_imm(DRCTOP, REG_ESP, 16);											// add  esp,16
+			emit_stack_free(DRCTOP, 16);													// add  esp,16
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -2014,7 +2056,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x31:	/* LWC1 */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].los
@@ -2026,7 +2068,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_long);						// call read_and_translate_long
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_m32_r32(DRCTOP, FPR32ADDR(RTREG), REG_EAX);							// mov  [rtreg],eax
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2034,7 +2076,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x32:	/* LWC2 */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
@@ -2046,7 +2088,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_long);						// call read_and_translate_long
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_m32_r32(DRCTOP, CPR2ADDR(RTREG), REG_EAX);								// mov  [rtreg],eax
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2065,7 +2107,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x35:	/* LDC1 */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
@@ -2078,14 +2120,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_double);					// call read_and_translate_double
 			emit_mov_m64_r64(DRCTOP, FPR64ADDR(RTREG), REG_EDX, REG_EAX);					// mov  [rtreg],edx:eax
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x36:	/* LDC2 */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
@@ -2098,14 +2140,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_double);					// call read_and_translate_long
 			emit_mov_m64_r64(DRCTOP, CPR2ADDR(RTREG), REG_EDX, REG_EAX);					// mov  [rtreg],edx:eax
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x37:	/* LD */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
@@ -2119,7 +2161,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_double);					// call read_and_translate_double
 			if (RTREG != 0)
 				emit_mov_m64_r64(DRCTOP, REGADDR(RTREG), REG_EDX, REG_EAX);					// mov  [rtreg],edx:eax
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -2128,7 +2170,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 		case 0x39:	/* SWC1 */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
 			emit_push_m32(DRCTOP, FPR32ADDR(RTREG));										// push dword [rtreg]
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
@@ -2141,14 +2183,14 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_long);						// call write_and_translate_long
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x3a:	/* SWC2 */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
 			emit_push_m32(DRCTOP, CPR2ADDR(RTREG));											// push dword [rtreg]
 			if (RSREG != 0 && SIMMVAL != 0)
 			{
@@ -2161,7 +2203,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_long);						// call write_and_translate_long
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -2184,7 +2226,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_double);					// call write_and_translate_double
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -2204,7 +2246,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_double);					// call write_and_translate_double
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -2232,7 +2274,7 @@ static UINT32 recompile_instruction(drc_core *drc, UINT32 pc, UINT32 physpc)
 			else
 				emit_push_imm(DRCTOP, SIMMVAL);												// push SIMMVAL
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_double);					// call write_and_translate_double
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -2549,10 +2591,17 @@ static UINT32 recompile_special1(drc_core *drc, UINT32 pc, UINT32 op)
 			{
 				emit_mov_r32_m32(DRCTOP, REG_ECX, REGADDRLO(RTREG));						// mov  ecx,[rtreg].lo
 				emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));						// mov  eax,[rsreg].lo
-				emit_cdq(DRCTOP);															// cdq
 				emit_cmp_r32_imm(DRCTOP, REG_ECX, 0);										// cmp  ecx,0
 				emit_jcc_short_link(DRCTOP, COND_E, &link1);								// je   skip
+				emit_cmp_r32_imm(DRCTOP, REG_ECX, -1);										// cmp  ecx,-1
+				emit_jcc_short_link(DRCTOP, COND_NE, &link2);								// jne  divide
+				emit_neg_r32(DRCTOP, REG_EAX);												// neg  eax
+				emit_xor_r32_r32(DRCTOP, REG_EDX, REG_EDX);									// xor  edx,edx
+				emit_jmp_short_link(DRCTOP, &link3);										// jmp  store
+				resolve_link(DRCTOP, &link2);											// divide:
+				emit_cdq(DRCTOP);															// cdq
 				emit_idiv_r32(DRCTOP, REG_ECX);												// idiv ecx
+				resolve_link(DRCTOP, &link3);											// store:
 				emit_push_r32(DRCTOP, REG_EDX);												// push edx
 				emit_cdq(DRCTOP);															// cdq
 				emit_mov_m64_r64(DRCTOP, LOADDR, REG_EDX, REG_EAX);							// mov  [lo],edx:eax
@@ -2670,19 +2719,19 @@ static UINT32 recompile_special1(drc_core *drc, UINT32 pc, UINT32 op)
 			return RECOMPILE_SUCCESSFUL_CP(8,4);
 
 		case 0x1e:	/* DDIV */
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
-			emit_push_imm(DRCTOP, (FPTR)&mips3.core->r[RTREG]);								// push [rtreg]
-			emit_push_imm(DRCTOP, (FPTR)&mips3.core->r[RSREG]);								// push [rsreg]
-			emit_call(DRCTOP, (x86code *)ddiv);												// call ddiv
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
+			emit_push_pointer(DRCTOP, &mips3.core->r[RTREG]);								// push [rtreg]
+			emit_push_pointer(DRCTOP, &mips3.core->r[RSREG]);								// push [rsreg]
+			drc_append_call_c(drc, (x86code *)ddiv, "pp");									// call ddiv
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			return RECOMPILE_SUCCESSFUL_CP(68,4);
 
 		case 0x1f:	/* DDIVU */
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
-			emit_push_imm(DRCTOP, (FPTR)&mips3.core->r[RTREG]);								// push [rtreg]
-			emit_push_imm(DRCTOP, (FPTR)&mips3.core->r[RSREG]);								// push [rsreg]
-			emit_call(DRCTOP, (x86code *)ddivu);											// call ddivu
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
+			emit_push_pointer(DRCTOP, &mips3.core->r[RTREG]);								// push [rtreg]
+			emit_push_pointer(DRCTOP, &mips3.core->r[RSREG]);								// push [rsreg]
+			drc_append_call_c(drc, (x86code *)ddivu, "pp");									// call ddivu
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			return RECOMPILE_SUCCESSFUL_CP(68,4);
 	}
 
@@ -2946,11 +2995,17 @@ static UINT32 recompile_special2(drc_core *drc, UINT32 pc, UINT32 op)
 				}
 				if (RTREG != 0)
 				{
+					emit_xor_r32_r32(DRCTOP, REG_ECX, REG_ECX);								// xor  ecx,ecx
 					emit_sub_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RTREG));					// sub  eax,[rtreg].lo
 					emit_sbb_r32_m32(DRCTOP, REG_EDX, REGADDRHI(RTREG));					// sbb  edx,[rtreg].lo
+					emit_setcc_r8(DRCTOP, COND_L, REG_CL);									// setl cl
+					emit_mov_m32_r32(DRCTOP, REGADDRLO(RDREG), REG_ECX);					// mov  [rdreg].lo,ecx
+				}
+				else
+				{
+					emit_shr_r32_imm(DRCTOP, REG_EDX, 31);									// shr  edx,31
+					emit_mov_m32_r32(DRCTOP, REGADDRLO(RDREG), REG_EDX);					// mov  [rdreg].lo,edx
 				}
-				emit_shr_r32_imm(DRCTOP, REG_EDX, 31);										// shr  edx,31
-				emit_mov_m32_r32(DRCTOP, REGADDRLO(RDREG), REG_EDX);						// mov  [rdreg].lo,edx
 				emit_mov_m32_imm(DRCTOP, REGADDRHI(RDREG), 0);								// mov  [rdreg].hi,0
 			}
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3309,7 +3364,7 @@ static UINT32 recompile_regimm(drc_core *drc, UINT32 pc, UINT32 op)
 
 		case 0x02:	/* BLTZL */
 			if (RSREG == 0)
-				return RECOMPILE_SUCCESSFUL_CP(1,4);
+				return RECOMPILE_SUCCESSFUL_CP(1,8);
 			else
 			{
 				emit_cmp_m32_imm(DRCTOP, REGADDRHI(RSREG), 0);								// cmp  [rsreg].hi,0
@@ -3476,7 +3531,7 @@ static UINT32 recompile_regimm(drc_core *drc, UINT32 pc, UINT32 op)
 
 		case 0x12:	/* BLTZALL */
 			if (RSREG == 0)
-				return RECOMPILE_SUCCESSFUL_CP(1,4);
+				return RECOMPILE_SUCCESSFUL_CP(1,8);
 			else
 			{
 				emit_cmp_m32_imm(DRCTOP, REGADDRHI(RSREG), 0);								// cmp  [rsreg].hi,0
@@ -3565,11 +3620,11 @@ static UINT32 recompile_set_cop0_reg(drc_core *drc, UINT8 reg)
 		case COP0_Count:
 			emit_mov_m32_r32(DRCTOP, CPR0ADDR(COP0_Count), REG_EAX);						// mov  [COP0_Count],eax
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
-			emit_call(DRCTOP, (x86code *)activecpu_gettotalcycles64);						// call activecpu_gettotalcycles64
+			drc_append_call_c(drc, (x86code *)activecpu_gettotalcycles64, "");				// call activecpu_gettotalcycles64
 			emit_pop_r32(DRCTOP, REG_EBX);													// pop  ebx
-			emit_add_r32_imm(DRCTOP, REG_ESP, 8);											// add  esp,8
+			emit_stack_free(DRCTOP, 8);														// add  esp,8
 			emit_sub_r32_r32(DRCTOP, REG_EAX, REG_EBX);										// sub  eax,ebx
 			emit_sbb_r32_imm(DRCTOP, REG_EDX, 0);											// sbb  edx,0
 			emit_sub_r32_r32(DRCTOP, REG_EAX, REG_EBX);										// sub  eax,ebx
@@ -3619,9 +3674,9 @@ static UINT32 recompile_get_cop0_reg(drc_core *drc, UINT8 reg)
 			emit_xor_r32_r32(DRCTOP, REG_EBP, REG_EBP);										// xor  ebp,ebp
 			resolve_link(DRCTOP, &link1);												// notneg:
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 12);											// sub  esp,12
-			emit_call(DRCTOP, (x86code *)activecpu_gettotalcycles64);						// call activecpu_gettotalcycles64
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_alloc(DRCTOP, 12);													// sub  esp,12
+			drc_append_call_c(drc, (x86code *)activecpu_gettotalcycles64, "");				// call activecpu_gettotalcycles64
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_sub_r32_m32(DRCTOP, REG_EAX, MABS(LO(&mips3.core->count_zero_time)));		// sub  eax,[mips3.core->count_zero_time+0]
 			emit_sbb_r32_m32(DRCTOP, REG_EDX, MABS(HI(&mips3.core->count_zero_time)));		// sbb  edx,[mips3.core->count_zero_time+4]
 			emit_shrd_r32_r32_imm(DRCTOP, REG_EAX, REG_EDX, 1);								// shrd eax,edx,1
@@ -3746,26 +3801,26 @@ static UINT32 recompile_cop0(drc_core *drc, UINT32 pc, UINT32 op)
 			switch (op & 0x01ffffff)
 			{
 				case 0x01:	/* TLBR */
-					emit_sub_r32_imm(DRCTOP, REG_ESP, 8);									// sub  esp,8
-					emit_push_imm(DRCTOP, (FPTR)mips3.core);								// push mips3.core
+					emit_stack_alloc(DRCTOP, 8);											// sub  esp,8
+					emit_push_pointer(DRCTOP, mips3.core);									// push mips3.core
 					drc_append_save_call_restore(drc, (x86code *)mips3com_tlbr, 12);		// call tlbr
 					return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 				case 0x02:	/* TLBWI */
-					emit_sub_r32_imm(DRCTOP, REG_ESP, 8);									// sub  esp,8
-					emit_push_imm(DRCTOP, (FPTR)mips3.core);								// push mips3.core
+					emit_stack_alloc(DRCTOP, 8);											// sub  esp,8
+					emit_push_pointer(DRCTOP, mips3.core);									// push mips3.core
 					drc_append_save_call_restore(drc, (x86code *)mips3com_tlbwi, 12);		// call tlbwi
 					return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 				case 0x06:	/* TLBWR */
-					emit_sub_r32_imm(DRCTOP, REG_ESP, 8);									// sub  esp,8
-					emit_push_imm(DRCTOP, (FPTR)mips3.core);								// push mips3.core
+					emit_stack_alloc(DRCTOP, 8);											// sub  esp,8
+					emit_push_pointer(DRCTOP, mips3.core);									// push mips3.core
 					drc_append_save_call_restore(drc, (x86code *)mips3com_tlbwr, 12);		// call tlbwr
 					return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 				case 0x08:	/* TLBP */
-					emit_sub_r32_imm(DRCTOP, REG_ESP, 8);									// sub  esp,8
-					emit_push_imm(DRCTOP, (FPTR)mips3.core);								// push mips3.core
+					emit_stack_alloc(DRCTOP, 8);											// sub  esp,8
+					emit_push_pointer(DRCTOP, mips3.core);									// push mips3.core
 					drc_append_save_call_restore(drc, (x86code *)mips3com_tlbp, 12);		// call tlbp
 					return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -4385,7 +4440,37 @@ static UINT32 recompile_cop1(drc_core *drc, UINT32 pc, UINT32 op)
 
 				case 0x31:
 				case 0x39:
-					emit_mov_m8_imm(DRCTOP, CF1ADDR((op >> 8) & 7), 0);						/* C.UN.S/D */
+					if (USE_SSE)
+					{
+						if (IS_SINGLE(op))	/* C.UN.S */
+						{
+							emit_movss_r128_m32(DRCTOP, REG_XMM0, FPR32ADDR(FSREG));		// movss xmm0,[fsreg]
+							emit_ucomiss_r128_m32(DRCTOP, REG_XMM0, FPR32ADDR(FTREG));		// ucomiss xmm0,[ftreg]
+						}
+						else
+						{
+							emit_movsd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FSREG));		// movsd xmm0,[fsreg]
+							emit_ucomisd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FTREG));		// ucomisd xmm0,[ftreg]
+						}
+						emit_setcc_m8(DRCTOP, COND_P, CF1ADDR((op >> 8) & 7)); 				// setp [cf[x]]
+					}
+					else
+					{
+						if (IS_SINGLE(op))	/* C.UN.S */
+						{
+							emit_fld_m32(DRCTOP, FPR32ADDR(FTREG));							// fld  [ftreg]
+							emit_fld_m32(DRCTOP, FPR32ADDR(FSREG));							// fld  [fsreg]
+						}
+						else
+						{
+							emit_fld_m64(DRCTOP, FPR64ADDR(FTREG));							// fld  [ftreg]
+							emit_fld_m64(DRCTOP, FPR64ADDR(FSREG));							// fld  [fsreg]
+						}
+						emit_fucompp(DRCTOP);												// fucompp
+						emit_fstsw_ax(DRCTOP);												// fnstsw ax
+						emit_sahf(DRCTOP);													// sahf
+						emit_setcc_m8(DRCTOP, COND_P, CF1ADDR((op >> 8) & 7)); 				// setp [cf[x]]
+					}
 					return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 				case 0x32:
@@ -4403,6 +4488,8 @@ static UINT32 recompile_cop1(drc_core *drc, UINT32 pc, UINT32 op)
 							emit_comisd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FTREG));		// comisd xmm0,[ftreg]
 						}
 						emit_setcc_m8(DRCTOP, COND_E, CF1ADDR((op >> 8) & 7)); 				// sete [cf[x]]
+						emit_setcc_r8(DRCTOP, COND_NP, REG_AL);								// setnp al
+						emit_and_m8_r8(DRCTOP, CF1ADDR((op >> 8) & 7), REG_AL);				// and  [cf[x]],al
 					}
 					else
 					{
@@ -4420,6 +4507,8 @@ static UINT32 recompile_cop1(drc_core *drc, UINT32 pc, UINT32 op)
 						emit_fstsw_ax(DRCTOP);												// fnstsw ax
 						emit_sahf(DRCTOP);													// sahf
 						emit_setcc_m8(DRCTOP, COND_E, CF1ADDR((op >> 8) & 7)); 				// sete [cf[x]]
+						emit_setcc_r8(DRCTOP, COND_NP, REG_AL);								// setnp al
+						emit_and_m8_r8(DRCTOP, CF1ADDR((op >> 8) & 7), REG_AL);				// and  [cf[x]],al
 					}
 					return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -4464,32 +4553,32 @@ static UINT32 recompile_cop1(drc_core *drc, UINT32 pc, UINT32 op)
 					{
 						if (IS_SINGLE(op))	/* C.OLT.S */
 						{
-							emit_movss_r128_m32(DRCTOP, REG_XMM0, FPR32ADDR(FSREG));		// movss xmm0,[fsreg]
-							emit_comiss_r128_m32(DRCTOP, REG_XMM0, FPR32ADDR(FTREG));		// comiss xmm0,[ftreg]
+							emit_movss_r128_m32(DRCTOP, REG_XMM0, FPR32ADDR(FTREG));		// movss xmm0,[ftreg]
+							emit_comiss_r128_m32(DRCTOP, REG_XMM0, FPR32ADDR(FSREG));		// comiss xmm0,[fsreg]
 						}
 						else
 						{
-							emit_movsd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FSREG));		// movsd xmm0,[fsreg]
-							emit_comisd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FTREG));		// comisd xmm0,[ftreg]
+							emit_movsd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FTREG));		// movsd xmm0,[ftreg]
+							emit_comisd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FSREG));		// comisd xmm0,[fsreg]
 						}
-						emit_setcc_m8(DRCTOP, COND_B, CF1ADDR((op >> 8) & 7)); 				// setb [cf[x]]
+						emit_setcc_m8(DRCTOP, COND_A, CF1ADDR((op >> 8) & 7)); 				// seta [cf[x]]
 					}
 					else
 					{
 						if (IS_SINGLE(op))	/* C.OLT.S */
 						{
-							emit_fld_m32(DRCTOP, FPR32ADDR(FTREG));							// fld  [ftreg]
 							emit_fld_m32(DRCTOP, FPR32ADDR(FSREG));							// fld  [fsreg]
+							emit_fld_m32(DRCTOP, FPR32ADDR(FTREG));							// fld  [ftreg]
 						}
 						else
 						{
-							emit_fld_m64(DRCTOP, FPR64ADDR(FTREG));							// fld  [ftreg]
 							emit_fld_m64(DRCTOP, FPR64ADDR(FSREG));							// fld  [fsreg]
+							emit_fld_m64(DRCTOP, FPR64ADDR(FTREG));							// fld  [ftreg]
 						}
 						emit_fcompp(DRCTOP);												// fcompp
 						emit_fstsw_ax(DRCTOP);												// fnstsw ax
 						emit_sahf(DRCTOP);													// sahf
-						emit_setcc_m8(DRCTOP, COND_B, CF1ADDR((op >> 8) & 7)); 				// setb [cf[x]]
+						emit_setcc_m8(DRCTOP, COND_A, CF1ADDR((op >> 8) & 7)); 				// seta [cf[x]]
 					}
 					return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -4534,32 +4623,32 @@ static UINT32 recompile_cop1(drc_core *drc, UINT32 pc, UINT32 op)
 					{
 						if (IS_SINGLE(op))	/* C.OLE.S */
 						{
-							emit_movss_r128_m32(DRCTOP, REG_XMM0, FPR32ADDR(FSREG));		// movss xmm0,[fsreg]
-							emit_comiss_r128_m32(DRCTOP, REG_XMM0, FPR32ADDR(FTREG));		// comiss xmm0,[ftreg]
+							emit_movss_r128_m32(DRCTOP, REG_XMM0, FPR32ADDR(FTREG));		// movss xmm0,[ftreg]
+							emit_comiss_r128_m32(DRCTOP, REG_XMM0, FPR32ADDR(FSREG));		// comiss xmm0,[fsreg]
 						}
 						else
 						{
-							emit_movsd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FSREG));		// movsd xmm0,[fsreg]
-							emit_comisd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FTREG));		// comisd xmm0,[ftreg]
+							emit_movsd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FTREG));		// movsd xmm0,[ftreg]
+							emit_comisd_r128_m64(DRCTOP, REG_XMM0, FPR64ADDR(FSREG));		// comisd xmm0,[fsreg]
 						}
-						emit_setcc_m8(DRCTOP, COND_BE, CF1ADDR((op >> 8) & 7)); 			// setle [cf[x]]
+						emit_setcc_m8(DRCTOP, COND_AE, CF1ADDR((op >> 8) & 7)); 				// setae [cf[x]]
 					}
 					else
 					{
 						if (IS_SINGLE(op))	/* C.OLE.S */
 						{
-							emit_fld_m32(DRCTOP, FPR32ADDR(FTREG));							// fld  [ftreg]
 							emit_fld_m32(DRCTOP, FPR32ADDR(FSREG));							// fld  [fsreg]
+							emit_fld_m32(DRCTOP, FPR32ADDR(FTREG));							// fld  [ftreg]
 						}
 						else
 						{
-							emit_fld_m64(DRCTOP, FPR64ADDR(FTREG));							// fld  [ftreg]
 							emit_fld_m64(DRCTOP, FPR64ADDR(FSREG));							// fld  [fsreg]
+							emit_fld_m64(DRCTOP, FPR64ADDR(FTREG));							// fld  [ftreg]
 						}
 						emit_fcompp(DRCTOP);												// fcompp
 						emit_fstsw_ax(DRCTOP);												// fnstsw ax
 						emit_sahf(DRCTOP);													// sahf
-						emit_setcc_m8(DRCTOP, COND_BE, CF1ADDR((op >> 8) & 7)); 			// setbe [cf[x]]
+						emit_setcc_m8(DRCTOP, COND_AE, CF1ADDR((op >> 8) & 7)); 				// setae [cf[x]]
 					}
 					return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -4627,12 +4716,12 @@ static UINT32 recompile_cop1x(drc_core *drc, UINT32 pc, UINT32 op)
 		case 0x00:		/* LWXC1 */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));							// mov  eax,[rsreg]
 			emit_add_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RTREG));							// add  eax,[rtreg]
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_long);						// call read_and_translate_long
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_m32_r32(DRCTOP, FPR32ADDR(FDREG), REG_EAX);							// mov  [fdreg],eax
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -4640,27 +4729,27 @@ static UINT32 recompile_cop1x(drc_core *drc, UINT32 pc, UINT32 op)
 		case 0x01:		/* LDXC1 */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 8);											// sub  esp,8
+			emit_stack_alloc(DRCTOP, 8);													// sub  esp,8
 			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));							// mov  eax,[rsreg]
 			emit_add_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RTREG));							// add  eax,[rtreg]
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->read_and_translate_double);					// call read_and_translate_double
 			emit_mov_m32_r32(DRCTOP, FPR64ADDRLO(FDREG), REG_EAX);							// mov  [fdreg].lo,eax
 			emit_mov_m32_r32(DRCTOP, FPR64ADDRHI(FDREG), REG_EDX);							// mov  [fdreg].hi,edx
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
 		case 0x08:		/* SWXC1 */
 			emit_mov_m32_r32(DRCTOP, ICOUNTADDR, REG_EBP);									// mov  [icount],ebp
 			emit_save_pc_before_call(DRCTOP);												// save pc
-			emit_sub_r32_imm(DRCTOP, REG_ESP, 4);											// sub  esp,4
+			emit_stack_alloc(DRCTOP, 4);													// sub  esp,4
 			emit_push_m32(DRCTOP, FPR32ADDR(FSREG));										// push [fsreg]
 			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RSREG));							// mov  eax,[rsreg]
 			emit_add_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RTREG));							// add  eax,[rtreg]
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_long);						// call write_and_translate_long
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,8
+			emit_stack_free(DRCTOP, 12);													// add  esp,8
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -4673,7 +4762,7 @@ static UINT32 recompile_cop1x(drc_core *drc, UINT32 pc, UINT32 op)
 			emit_add_r32_m32(DRCTOP, REG_EAX, REGADDRLO(RTREG));							// add  eax,[rtreg]
 			emit_push_r32(DRCTOP, REG_EAX);													// push eax
 			emit_call(DRCTOP, mips3.drcdata->write_and_translate_double);					// call write_and_translate_double
-			emit_add_r32_imm(DRCTOP, REG_ESP, 12);											// add  esp,12
+			emit_stack_free(DRCTOP, 12);													// add  esp,12
 			emit_mov_r32_m32(DRCTOP, REG_EBP, ICOUNTADDR);									// mov  ebp,[icount]
 			return RECOMPILE_SUCCESSFUL_CP(1,4);
 
@@ -988,9 +988,9 @@ INLINE void handle_cop1_fr0(UINT32 op)
 				case 0x31:
 				case 0x39:
 					if (IS_SINGLE(op))	/* C.UN.S */
-						SET_FCC((op >> 8) & 7, 0);
+						SET_FCC((op >> 8) & 7, (FSVALS_FR0 != FSVALS_FR0 || FTVALS_FR0 != FTVALS_FR0));
 					else				/* C.UN.D */
-						SET_FCC((op >> 8) & 7, 0);
+						SET_FCC((op >> 8) & 7, (FSVALD_FR0 != FSVALD_FR0 || FTVALD_FR0 != FTVALD_FR0));
 					break;
 
 				case 0x32:
@@ -1004,9 +1004,9 @@ INLINE void handle_cop1_fr0(UINT32 op)
 				case 0x33:
 				case 0x3b:
 					if (IS_SINGLE(op))	/* C.UEQ.S */
-						SET_FCC((op >> 8) & 7, (FSVALS_FR0 == FTVALS_FR0));
+						SET_FCC((op >> 8) & 7, !(FSVALS_FR0 < FTVALS_FR0 || FSVALS_FR0 > FTVALS_FR0));
 					else				/* C.UEQ.D */
-						SET_FCC((op >> 8) & 7, (FSVALD_FR0 == FTVALD_FR0));
+						SET_FCC((op >> 8) & 7, !(FSVALD_FR0 < FTVALD_FR0 || FSVALD_FR0 > FTVALD_FR0));
 					break;
 
 				case 0x34:
@@ -1020,9 +1020,9 @@ INLINE void handle_cop1_fr0(UINT32 op)
 				case 0x35:
 				case 0x3d:
 					if (IS_SINGLE(op))	/* C.ULT.S */
-						SET_FCC((op >> 8) & 7, (FSVALS_FR0 < FTVALS_FR0));
+						SET_FCC((op >> 8) & 7, !(FSVALS_FR0 >= FTVALS_FR0));
 					else				/* C.ULT.D */
-						SET_FCC((op >> 8) & 7, (FSVALD_FR0 < FTVALD_FR0));
+						SET_FCC((op >> 8) & 7, !(FSVALD_FR0 >= FTVALD_FR0));
 					break;
 
 				case 0x36:
@@ -1036,9 +1036,9 @@ INLINE void handle_cop1_fr0(UINT32 op)
 				case 0x37:
 				case 0x3f:
 					if (IS_SINGLE(op))	/* C.ULE.S */
-						SET_FCC((op >> 8) & 7, (FSVALS_FR0 <= FTVALS_FR0));
+						SET_FCC((op >> 8) & 7, !(FSVALS_FR0 > FTVALS_FR0));
 					else				/* C.ULE.D */
-						SET_FCC((op >> 8) & 7, (FSVALD_FR0 <= FTVALD_FR0));
+						SET_FCC((op >> 8) & 7, !(FSVALD_FR0 > FTVALD_FR0));
 					break;
 
 				default:
@@ -1344,9 +1344,9 @@ INLINE void handle_cop1_fr1(UINT32 op)
 				case 0x31:
 				case 0x39:
 					if (IS_SINGLE(op))	/* C.UN.S */
-						SET_FCC((op >> 8) & 7, 0);
+						SET_FCC((op >> 8) & 7, (FSVALS_FR1 != FSVALS_FR1 || FTVALS_FR1 != FTVALS_FR1));
 					else				/* C.UN.D */
-						SET_FCC((op >> 8) & 7, 0);
+						SET_FCC((op >> 8) & 7, (FSVALD_FR1 != FSVALD_FR1 || FTVALD_FR1 != FTVALD_FR1));
 					break;
 
 				case 0x32:
@@ -1360,9 +1360,9 @@ INLINE void handle_cop1_fr1(UINT32 op)
 				case 0x33:
 				case 0x3b:
 					if (IS_SINGLE(op))	/* C.UEQ.S */
-						SET_FCC((op >> 8) & 7, (FSVALS_FR1 == FTVALS_FR1));
+						SET_FCC((op >> 8) & 7, !(FSVALS_FR1 < FTVALS_FR1 || FSVALS_FR1 > FTVALS_FR1));
 					else				/* C.UEQ.D */
-						SET_FCC((op >> 8) & 7, (FSVALD_FR1 == FTVALD_FR1));
+						SET_FCC((op >> 8) & 7, !(FSVALD_FR1 < FTVALD_FR1 || FSVALD_FR1 > FTVALD_FR1));
 					break;
 
 				case 0x34:
@@ -1376,9 +1376,9 @@ INLINE void handle_cop1_fr1(UINT32 op)
 				case 0x35:
 				case 0x3d:
 					if (IS_SINGLE(op))	/* C.ULT.S */
-						SET_FCC((op >> 8) & 7, (FSVALS_FR1 < FTVALS_FR1));
+						SET_FCC((op >> 8) & 7, !(FSVALS_FR1 >= FTVALS_FR1));
 					else				/* C.ULT.D */
-						SET_FCC((op >> 8) & 7, (FSVALD_FR1 < FTVALD_FR1));
+						SET_FCC((op >> 8) & 7, !(FSVALD_FR1 >= FTVALD_FR1));
 					break;
 
 				case 0x36:
@@ -1392,9 +1392,9 @@ INLINE void handle_cop1_fr1(UINT32 op)
 				case 0x37:
 				case 0x3f:
 					if (IS_SINGLE(op))	/* C.ULE.S */
-						SET_FCC((op >> 8) & 7, (FSVALS_FR1 <= FTVALS_FR1));
+						SET_FCC((op >> 8) & 7, !(FSVALS_FR1 > FTVALS_FR1));
 					else				/* C.ULE.D */
-						SET_FCC((op >> 8) & 7, (FSVALD_FR1 <= FTVALD_FR1));
+						SET_FCC((op >> 8) & 7, !(FSVALD_FR1 > FTVALD_FR1));
 					break;
 
 				default:
@@ -1718,7 +1718,13 @@ int mips3_execute(int cycles)
 						mips3.core.icount -= 3;
 						break;
 					case 0x1a:	/* DIV */
-						if (RTVAL32)
+						if (RTVAL32 == 0xffffffff)
+						{
+							/* can overflow, which traps on the host but not on the MIPS */
+							LOVAL64 = (INT32)(0 - RSVAL32);
+							HIVAL64 = 0;
+						}
+						else if (RTVAL32)
 						{
 							LOVAL64 = (INT32)((INT32)RSVAL32 / (INT32)RTVAL32);
 							HIVAL64 = (INT32)((INT32)RSVAL32 % (INT32)RTVAL32);
@@ -1746,7 +1752,12 @@ int mips3_execute(int cycles)
 						mips3.core.icount -= 7;
 						break;
 					case 0x1e:	/* DDIV */
-						if (RTVAL64)
+						if (RTVAL64 == ~(UINT64)0)
+						{
+							LOVAL64 = 0 - RSVAL64;
+							HIVAL64 = 0;
+						}
+						else if (RTVAL64)
 						{
 							LOVAL64 = (INT64)RSVAL64 / (INT64)RTVAL64;
 							HIVAL64 = (INT64)RSVAL64 % (INT64)RTVAL64;
@@ -0,0 +1,562 @@
+/***************************************************************************
+
+    mips3cmp.c
+
+    Standalone consistency check for the MIPS III cores. It generates a
+    random program from a seed, runs it on whichever core it is linked
+    with, and prints the registers and data memory at the end. Linking
+    it once with the interpreter and once with the recompiler and
+    comparing the output over many seeds checks the recompiler against
+    the interpreter; mips3cmp.mak does exactly that.
+
+    Usage: mips3cmp <seed> [-be] [-fastram] [-count <n>] [-nofpu] [-keep <n>] [-list]
+
+***************************************************************************/
+
+#include <stdarg.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#include "cpuintrf.h"
+#include "mips3.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define RAM_SIZE			(8 * 1024 * 1024)
+
+#define CODE_BASE			0x80001000		/* program start, in kseg0 */
+#define DATA_BASE			0x00100000		/* physical address of the data r28 points at */
+#define DATA_SIZE			0x1100
+#define FPR_SAVE			0x1000			/* where the FPU registers are stored at the end */
+
+#define DEFAULT_COUNT		200				/* random instructions in the loop body */
+#define LOOP_COUNT			3				/* times the body runs */
+
+/* instruction field builders */
+#define RTYPE(op,rs,rt,rd,sa,fn)	(((op) << 26) | ((rs) << 21) | ((rt) << 16) | ((rd) << 11) | ((sa) << 6) | (fn))
+#define ITYPE(op,rs,rt,imm)			(((op) << 26) | ((rs) << 21) | ((rt) << 16) | ((imm) & 0xffff))
+#define SPECIAL(rs,rt,rd,sa,fn)		RTYPE(0x00, rs, rt, rd, sa, fn)
+#define COP1(fmt,ft,fs,fd,fn)		RTYPE(0x11, fmt, ft, fs, fd, fn)
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* pieces of the emulator the cores reference */
+static running_machine machine;
+running_machine *Machine = &machine;
+UINT8 opcode_entry;
+UINT8 *opcode_base;
+UINT8 *opcode_arg_base;
+offs_t opcode_mask;
+offs_t opcode_memory_min, opcode_memory_max = 0xffffffff;
+address_space active_address_space[ADDRESS_SPACES];
+int activecpu;
+UINT32 cycles_per_second[MAX_CPU];
+subseconds_t subseconds_per_cycle[MAX_CPU];
+mame_time time_never, time_zero;
+
+/* the test machine: RAM mirrored over the whole address space */
+static UINT8 *ram;
+static UINT64 total_cycles;
+
+/* program generator state */
+static UINT32 rand_seed;
+static UINT32 *code;
+static int codeindex;
+static int use_fpu = TRUE;
+
+unsigned dasmmips3(char *buffer, unsigned pc, UINT32 op);
+
+
+
+/***************************************************************************
+    EMULATOR STUBS
+***************************************************************************/
+
+void CLIB_DECL fatalerror(const char *text, ...)
+{
+	va_list arg;
+
+	va_start(arg, text);
+	vfprintf(stderr, text, arg);
+	va_end(arg);
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+void CLIB_DECL logerror(const char *text, ...) { }
+void CLIB_DECL mame_printf_debug(const char *text, ...) { }
+void mame_debug_hook(void) { }
+void memory_set_opbase(offs_t offset) { }
+void cpunum_set_input_line(int cpunum, int line, int state) { }
+UINT64 activecpu_gettotalcycles64(void) { return total_cycles; }
+
+void *auto_malloc_file_line(size_t size, const char *file, int line)
+{
+	return malloc_or_die_file_line(size, file, line);
+}
+
+void *malloc_or_die_file_line(size_t size, const char *file, int line)
+{
+	void *result = calloc(1, size);
+	if (result == NULL)
+		fatalerror("Out of memory allocating %d bytes (%s:%d)", (int)size, file, line);
+	return result;
+}
+
+mame_timer *_mame_timer_alloc(void (*callback)(running_machine *, int), const char *file, int line, const char *func)
+{
+	/* the COMPARE interrupt is never enabled by the test programs */
+	return malloc_or_die_file_line(64, file, line);
+}
+
+void mame_timer_adjust(mame_timer *which, mame_time duration, int param, mame_time period) { }
+
+void *osd_alloc_executable(size_t size)
+{
+	/* malloc'ed memory isn't executable on most current systems */
+#ifdef _WIN32
+	return VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+#else
+	void *result = mmap(NULL, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANON, -1, 0);
+	return (result == MAP_FAILED) ? NULL : result;
+#endif
+}
+
+void osd_free_executable(void *ptr, size_t size)
+{
+#ifdef _WIN32
+	VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+	munmap(ptr, size);
+#endif
+}
+
+#define RAM_OFFSET(a)	((a) & (RAM_SIZE - 1))
+
+UINT8 program_read_byte_32le(offs_t address)					{ return ram[RAM_OFFSET(address)]; }
+UINT16 program_read_word_32le(offs_t address)					{ return *(UINT16 *)&ram[RAM_OFFSET(address) & ~1]; }
+UINT32 program_read_dword_32le(offs_t address)					{ return *(UINT32 *)&ram[RAM_OFFSET(address) & ~3]; }
+UINT32 program_read_masked_32le(offs_t address, UINT32 mask)	{ return *(UINT32 *)&ram[RAM_OFFSET(address) & ~3]; }
+void program_write_byte_32le(offs_t address, UINT8 data)		{ ram[RAM_OFFSET(address)] = data; }
+void program_write_word_32le(offs_t address, UINT16 data)		{ *(UINT16 *)&ram[RAM_OFFSET(address) & ~1] = data; }
+void program_write_dword_32le(offs_t address, UINT32 data)		{ *(UINT32 *)&ram[RAM_OFFSET(address) & ~3] = data; }
+void program_write_masked_32le(offs_t address, UINT32 data, UINT32 mask)
+{
+	UINT32 *dest = (UINT32 *)&ram[RAM_OFFSET(address) & ~3];
+	*dest = (*dest & mask) | (data & ~mask);
+}
+
+UINT8 program_read_byte_32be(offs_t address)					{ return ram[BYTE4_XOR_BE(RAM_OFFSET(address))]; }
+UINT16 program_read_word_32be(offs_t address)					{ return *(UINT16 *)&ram[WORD_XOR_BE(RAM_OFFSET(address) & ~1)]; }
+UINT32 program_read_dword_32be(offs_t address)					{ return *(UINT32 *)&ram[RAM_OFFSET(address) & ~3]; }
+UINT32 program_read_masked_32be(offs_t address, UINT32 mask)	{ return *(UINT32 *)&ram[RAM_OFFSET(address) & ~3]; }
+void program_write_byte_32be(offs_t address, UINT8 data)		{ ram[BYTE4_XOR_BE(RAM_OFFSET(address))] = data; }
+void program_write_word_32be(offs_t address, UINT16 data)		{ *(UINT16 *)&ram[WORD_XOR_BE(RAM_OFFSET(address) & ~1)] = data; }
+void program_write_dword_32be(offs_t address, UINT32 data)		{ *(UINT32 *)&ram[RAM_OFFSET(address) & ~3] = data; }
+void program_write_masked_32be(offs_t address, UINT32 data, UINT32 mask)
+{
+	UINT32 *dest = (UINT32 *)&ram[RAM_OFFSET(address) & ~3];
+	*dest = (*dest & mask) | (data & ~mask);
+}
+
+
+
+/***************************************************************************
+    PROGRAM GENERATOR
+***************************************************************************/
+
+/*-------------------------------------------------
+    rand_range - return a pseudo-random value
+    in the range 0 to range-1
+-------------------------------------------------*/
+
+static UINT32 rand_range(UINT32 range)
+{
+	rand_seed = rand_seed * 1664525 + 1013904223;
+	return ((rand_seed >> 8) ^ (rand_seed << 13)) % range;
+}
+
+
+/* r0 and r26/r27/r28 (exception scratch, loop counter, data pointer) are never destinations */
+#define DEST_REG()		(1 + rand_range(25))
+#define SOURCE_REG()	rand_range(27)
+
+/* the programs run with FR=1, but stick to even registers so FR=0 behaves the same */
+#define FPU_REG()		(rand_range(15) * 2)
+
+
+/*-------------------------------------------------
+    emit - append an instruction
+-------------------------------------------------*/
+
+INLINE void emit(UINT32 op)
+{
+	code[codeindex++] = op;
+}
+
+
+/*-------------------------------------------------
+    emit_random_op - append one random
+    non-branching instruction
+-------------------------------------------------*/
+
+static void emit_random_op(void)
+{
+	int kind = rand_range(use_fpu ? 100 : 88);
+
+	/* three-register ALU ops, excluding the ones that trap on overflow */
+	if (kind < 40)
+	{
+		static const UINT8 funcs[] = { 0x21,0x23,0x24,0x25,0x26,0x27,0x2b,0x2d,0x2f,0x04,0x06,0x07,0x14,0x16,0x17,0x0a,0x0b };
+		emit(SPECIAL(SOURCE_REG(), SOURCE_REG(), DEST_REG(), 0, funcs[rand_range(ARRAY_LENGTH(funcs))]));
+	}
+
+	/* shifts by immediate */
+	else if (kind < 50)
+	{
+		static const UINT8 funcs[] = { 0x00,0x02,0x03,0x38,0x3a,0x3b,0x3c,0x3e,0x3f };
+		emit(SPECIAL(0, SOURCE_REG(), DEST_REG(), rand_range(32), funcs[rand_range(ARRAY_LENGTH(funcs))]));
+	}
+
+	/* immediate ALU ops */
+	else if (kind < 62)
+	{
+		static const UINT8 ops[] = { 0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x19 };
+		emit(ITYPE(ops[rand_range(ARRAY_LENGTH(ops))], SOURCE_REG(), DEST_REG(), rand_range(0x10000)));
+	}
+
+	/* multiplies and divides, optionally followed by an mfhi/mflo; no dmult/dmultu, */
+	/* since the interpreter doesn't compute the upper 64 bits of those */
+	else if (kind < 70)
+	{
+		static const UINT8 funcs[] = { 0x18,0x19,0x1a,0x1b,0x1e,0x1f };
+		emit(SPECIAL(SOURCE_REG(), SOURCE_REG(), 0, 0, funcs[rand_range(ARRAY_LENGTH(funcs))]));
+		if (rand_range(2))
+			emit(SPECIAL(0, 0, DEST_REG(), 0, rand_range(2) ? 0x10 : 0x12));
+	}
+
+	/* mthi/mtlo */
+	else if (kind < 73)
+		emit(SPECIAL(SOURCE_REG(), 0, 0, 0, rand_range(2) ? 0x11 : 0x13));
+
+	/* aligned loads and stores off r28, including the unaligned left/right forms */
+	else if (kind < 88)
+	{
+		static const UINT8 ops[] =   { 0x20,0x21,0x23,0x24,0x25,0x27,0x37,0x22,0x26,0x1a,0x1b,0x28,0x29,0x2b,0x3f,0x2a,0x2e,0x2c,0x2d };
+		static const UINT8 align[] = {    1,   2,   4,   1,   2,   4,   8,   1,   1,   1,   1,   1,   2,   4,   8,   1,   1,   1,   1 };
+		int which = rand_range(ARRAY_LENGTH(ops));
+		int store = (ops[which] >= 0x28 && ops[which] != 0x37);
+		emit(ITYPE(ops[which], 28, store ? SOURCE_REG() : DEST_REG(), rand_range(0xff8) & ~(align[which] - 1)));
+	}
+
+	/* FPU ops; values start out integral so results are exact */
+	else if (kind < 97)
+	{
+		int fmt = 17;
+		switch (rand_range(12))
+		{
+			case 0:	case 1: case 2: case 3:		/* add/sub/mul/div.d */
+				emit(COP1(fmt, FPU_REG(), FPU_REG(), FPU_REG(), rand_range(4)));
+				break;
+
+			case 4:								/* abs/neg.d */
+				emit(COP1(fmt, 0, FPU_REG(), FPU_REG(), rand_range(2) ? 5 : 7));
+				break;
+
+			case 5:								/* mov.d */
+				emit(COP1(fmt, 0, FPU_REG(), FPU_REG(), 6));
+				break;
+
+			case 6:								/* dmtc1 */
+				emit(COP1(5, SOURCE_REG(), FPU_REG(), 0, 0));
+				break;
+
+			case 7:								/* mfc1 */
+				emit(COP1(0, DEST_REG(), FPU_REG(), 0, 0));
+				break;
+
+			case 8:								/* dmtc1/dmfc1 through f30 */
+				if (rand_range(2))
+					emit(COP1(5, SOURCE_REG(), 30, 0, 0));
+				else
+					emit(COP1(1, DEST_REG(), 30, 0, 0));
+				break;
+
+			case 9:								/* cvt.d.w */
+				emit(COP1(20, 0, FPU_REG(), FPU_REG(), 0x21));
+				break;
+
+			case 10:							/* round/trunc/ceil/floor.l/w into f30 */
+				emit(COP1(fmt, 0, FPU_REG(), 30, 0x08 + rand_range(8)));
+				break;
+
+			case 11:							/* swc1/sdc1 */
+				emit(ITYPE(rand_range(2) ? 0x39 : 0x3d, 28, FPU_REG(), rand_range(0xff8) & ~7));
+				break;
+		}
+	}
+
+	/* FPU compares */
+	else
+		emit(COP1(rand_range(2) ? 17 : 16, FPU_REG(), FPU_REG(), 0, 0x30 + rand_range(16)));
+}
+
+
+/*-------------------------------------------------
+    generate_program - build a program that loads
+    random values into the registers, runs a
+    random loop body a few times and then spins
+-------------------------------------------------*/
+
+static offs_t generate_program(int count, int keep)
+{
+	offs_t loopstart, endpc;
+	int regnum, opnum;
+
+	codeindex = 0;
+
+	/* CU1 and FR on */
+	emit(ITYPE(0x0f, 0, 1, 0x2400));							/* lui   r1,$2400 */
+	emit(RTYPE(0x10, 4, 1, 12, 0, 0));							/* mtc0  r1,sr */
+
+	/* random 64-bit values in r1-r25 */
+	for (regnum = 1; regnum <= 25; regnum++)
+	{
+		emit(ITYPE(0x0f, 0, regnum, rand_range(0x10000)));			/* lui   rN,imm */
+		emit(ITYPE(0x0d, regnum, regnum, rand_range(0x10000)));		/* ori   rN,rN,imm */
+		emit(SPECIAL(0, regnum, regnum, 16, 0x38));				/* dsll  rN,rN,16 */
+		emit(ITYPE(0x0d, regnum, regnum, rand_range(0x10000)));		/* ori   rN,rN,imm */
+		emit(SPECIAL(0, regnum, regnum, 16, 0x38));				/* dsll  rN,rN,16 */
+		emit(ITYPE(0x0d, regnum, regnum, rand_range(0x10000)));		/* ori   rN,rN,imm */
+	}
+
+	/* small integers in the even FPU registers */
+	for (regnum = 0; regnum < 32; regnum += 2)
+	{
+		emit(COP1(5, 1 + regnum / 2, regnum, 0, 0));			/* dmtc1 rN,fN */
+		emit(COP1(20, 0, regnum, regnum, 0x21));				/* cvt.d.w fN,fN */
+	}
+
+	emit(ITYPE(0x0f, 0, 28, 0x8000 | (DATA_BASE >> 16)));		/* lui   r28,data */
+	emit(ITYPE(0x09, 0, 27, LOOP_COUNT));						/* addiu r27,r0,count */
+	loopstart = CODE_BASE + codeindex * 4;
+
+	for (opnum = 0; opnum < count; opnum++)
+	{
+		int kind = rand_range(100);
+
+		/* forward conditional branches, likely and not, with a random op in the delay slot */
+		if (kind < 10 && count - opnum > 8)
+		{
+			int skip = 1 + rand_range(5);
+			int likely = (rand_range(3) == 0);
+
+			switch (rand_range(6))
+			{
+				case 0:	emit(ITYPE(likely ? 0x14 : 0x04, SOURCE_REG(), SOURCE_REG(), skip));	break;	/* beq */
+				case 1:	emit(ITYPE(likely ? 0x15 : 0x05, SOURCE_REG(), SOURCE_REG(), skip));	break;	/* bne */
+				case 2:	emit(ITYPE(likely ? 0x16 : 0x06, SOURCE_REG(), 0, skip));				break;	/* blez */
+				case 3:	emit(ITYPE(likely ? 0x17 : 0x07, SOURCE_REG(), 0, skip));				break;	/* bgtz */
+				case 4:	emit(ITYPE(0x01, SOURCE_REG(), rand_range(4) | (rand_range(4) == 0 ? 0x10 : 0), skip));	break;	/* bltz/bgez(al)(l) */
+				case 5:	emit(RTYPE(0x11, 8, use_fpu ? rand_range(4) : 0, 0, 0, 0) | skip);		break;	/* bc1f/t(l) */
+			}
+			emit_random_op();
+			opnum++;
+		}
+
+		/* forward jumps, with and without link */
+		else if (kind < 12 && count - opnum > 8)
+		{
+			offs_t dest = CODE_BASE + (codeindex + 2 + 1 + rand_range(5)) * 4;
+			emit(((rand_range(2) ? 0x03 : 0x02) << 26) | ((dest >> 2) & 0x3ffffff));
+			emit_random_op();
+			opnum++;
+		}
+		else
+			emit_random_op();
+	}
+
+	/* when narrowing down a mismatch, turn everything after the first few instructions into nops */
+	if (keep >= 0)
+		for (opnum = (loopstart - CODE_BASE) / 4 + keep; opnum < codeindex; opnum++)
+			code[opnum] = 0;
+
+	/* loop back, then store the FPU registers and spin */
+	emit(ITYPE(0x09, 27, 27, -1));								/* addiu r27,r27,-1 */
+	emit(ITYPE(0x05, 27, 0, (loopstart - (CODE_BASE + codeindex * 4 + 4)) >> 2));	/* bne r27,r0,loop */
+	emit(0);													/* nop */
+	for (regnum = 0; regnum < 32; regnum++)
+		emit(ITYPE(0x3d, 28, regnum, FPR_SAVE + regnum * 8));	/* sdc1  fN,$1000+N*8(r28) */
+	endpc = CODE_BASE + codeindex * 4;
+	emit((0x02 << 26) | ((endpc >> 2) & 0x3ffffff));			/* j     * */
+	emit(0);													/* nop */
+	return endpc;
+}
+
+
+
+/***************************************************************************
+    RESULTS
+***************************************************************************/
+
+/*-------------------------------------------------
+    canonical_nan - replace a double NaN with a
+    single pattern; which operand's payload a NaN
+    result carries depends on whether the host
+    computed it with x87 or SSE, and the real chip
+    produces neither
+-------------------------------------------------*/
+
+static UINT64 canonical_nan(UINT64 value)
+{
+	if ((value & U64(0x7ff0000000000000)) == U64(0x7ff0000000000000) && (value & U64(0x000fffffffffffff)) != 0)
+		return U64(0x7ff7ffffffffffff);
+	return value;
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+int CLIB_DECL main(int argc, char *argv[])
+{
+	struct mips3_config config = { 16384, 16384, 0 };
+	int bigendian = FALSE, fastram = FALSE, list = FALSE, count = DEFAULT_COUNT, keep = -1;
+	void (*get_info)(UINT32 state, cpuinfo *info);
+	void (*set_info)(UINT32 state, cpuinfo *info);
+	int argnum, regnum, slice, offset;
+	offs_t endpc;
+	cpuinfo info;
+
+	/* parse the command line */
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage:\n  mips3cmp <seed> [-be] [-fastram] [-count <n>] [-nofpu] [-keep <n>] [-list]\n");
+		return 1;
+	}
+	rand_seed = atoi(argv[1]) * 7919 + 1;
+	for (argnum = 2; argnum < argc; argnum++)
+	{
+		if (strcmp(argv[argnum], "-be") == 0)
+			bigendian = TRUE;
+		else if (strcmp(argv[argnum], "-fastram") == 0)
+			fastram = TRUE;
+		else if (strcmp(argv[argnum], "-nofpu") == 0)
+			use_fpu = FALSE;
+		else if (strcmp(argv[argnum], "-list") == 0)
+			list = TRUE;
+		else if (strcmp(argv[argnum], "-count") == 0 && argnum + 1 < argc)
+			count = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-keep") == 0 && argnum + 1 < argc)
+			keep = atoi(argv[++argnum]);
+		else
+			fatalerror("Unknown option %s", argv[argnum]);
+	}
+	get_info = bigendian ? r5000be_get_info : r5000le_get_info;
+
+	/* set up the memory the cores see */
+	ram = malloc_or_die(RAM_SIZE);
+	opcode_base = opcode_arg_base = ram;
+	opcode_mask = RAM_SIZE - 1;
+	active_address_space[ADDRESS_SPACE_PROGRAM].addrmask = 0xffffffff;
+	active_address_space[ADDRESS_SPACE_PROGRAM].readlookup = malloc_or_die(1 << LEVEL1_BITS);
+
+	/* the exception vector just skips the faulting instruction */
+	code = (UINT32 *)&ram[0x180];
+	codeindex = 0;
+	emit(RTYPE(0x10, 0, 26, 14, 0, 0));							/* mfc0  r26,epc */
+	emit(ITYPE(0x09, 26, 26, 4));								/* addiu r26,r26,4 */
+	emit(RTYPE(0x10, 4, 26, 14, 0, 0));							/* mtc0  r26,epc */
+	emit(0x42000018);											/* eret */
+
+	/* the program, and random data for it to work on */
+	code = (UINT32 *)&ram[RAM_OFFSET(CODE_BASE)];
+	endpc = generate_program(count, keep);
+	for (offset = 0; offset < DATA_SIZE; offset++)
+		ram[DATA_BASE + offset] = rand_range(0x100);
+
+	/* list it if asked, to help track down a mismatch */
+	if (list)
+		for (offset = 0; offset < codeindex; offset++)
+		{
+			char buffer[256];
+			dasmmips3(buffer, CODE_BASE + offset * 4, code[offset]);
+			printf("%08X: %08X  %s\n", CODE_BASE + offset * 4, code[offset], buffer);
+		}
+
+	/* start the core */
+	get_info(CPUINFO_PTR_SET_INFO, &info);
+	set_info = info.setinfo;
+	get_info(CPUINFO_PTR_INIT, &info);
+	(*info.init)(0, 50000000, &config, NULL);
+	if (fastram)
+	{
+		info.i = 0;					(*set_info)(CPUINFO_INT_MIPS3_FASTRAM_SELECT, &info);
+		info.i = 0;					(*set_info)(CPUINFO_INT_MIPS3_FASTRAM_START, &info);
+		info.i = RAM_SIZE - 1;		(*set_info)(CPUINFO_INT_MIPS3_FASTRAM_END, &info);
+		info.i = 0;					(*set_info)(CPUINFO_INT_MIPS3_FASTRAM_READONLY, &info);
+		info.p = ram;				(*set_info)(CPUINFO_PTR_MIPS3_FASTRAM_BASE, &info);
+	}
+	get_info(CPUINFO_PTR_RESET, &info);
+	(*info.reset)();
+	info.i = CODE_BASE;
+	(*set_info)(CPUINFO_INT_PC, &info);
+
+	/* run in slices until the program reaches its final loop */
+	get_info(CPUINFO_PTR_EXECUTE, &info);
+	for (slice = 0; slice < 1000; slice++)
+	{
+		cpuinfo pc;
+
+		total_cycles += (*info.execute)(1000);
+		get_info(CPUINFO_INT_PC, &pc);
+		if (pc.i == endpc)
+			break;
+	}
+	if (slice == 1000)
+		printf("did not finish\n");
+
+	/* dump the state; COUNT and RANDOM depend on cycle timing, which the cores count differently */
+	for (regnum = MIPS3_PC; regnum <= MIPS3_FPR31; regnum++)
+	{
+		UINT64 value;
+
+		get_info(CPUINFO_INT_REGISTER + regnum, &info);
+		value = info.i;
+
+		/* the interpreter zero-extends jal's return address; the recompiler sign-extends it like the hardware */
+		if (regnum == MIPS3_R31)
+			value = (INT32)value;
+		if (regnum >= MIPS3_FPR0)
+			value = canonical_nan(value);
+		printf("%-3d %08X%08X\n", regnum, (UINT32)(value >> 32), (UINT32)value);
+	}
+	for (offset = FPR_SAVE; offset < FPR_SAVE + 32 * 8; offset += 8)
+	{
+		/* RAM holds host-order 32-bit words, so a big-endian double has its halves swapped */
+		UINT32 *words = (UINT32 *)&ram[DATA_BASE + offset];
+		UINT64 value = bigendian ? (((UINT64)words[0] << 32) | words[1]) : (((UINT64)words[1] << 32) | words[0]);
+
+		value = canonical_nan(value);
+		words[bigendian ? 1 : 0] = (UINT32)value;
+		words[bigendian ? 0 : 1] = (UINT32)(value >> 32);
+	}
+	for (offset = 0; offset < DATA_SIZE; offset += 16)
+		printf("%04X %08X %08X %08X %08X\n", offset,
+				*(UINT32 *)&ram[DATA_BASE + offset + 0], *(UINT32 *)&ram[DATA_BASE + offset + 4],
+				*(UINT32 *)&ram[DATA_BASE + offset + 8], *(UINT32 *)&ram[DATA_BASE + offset + 12]);
+	return 0;
+}
@@ -0,0 +1,42 @@
+# Builds mips3cmp twice, once with the interpreter and once with the
+# recompiler, and compares their results on random programs.  Run from
+# this directory with "make -f mips3cmp.mak [PTR64=1]"; SEEDS sets how
+# many programs are tried in each configuration.
+
+SRC = ../../..
+SEEDS = 500
+
+CC = gcc
+CFLAGS = -O1 -std=gnu89 -DINLINE="static __inline__" -DCRLF=2 -DLSB_FIRST -DHAS_R5000=1 \
+	-I$(SRC)/emu -I$(SRC)/emu/cpu -I$(SRC)/lib/util -I$(SRC)/osd
+
+ifdef PTR64
+CFLAGS += -DPTR64
+DRCSRC = $(SRC)/emu/cpu/x64drc.c
+else
+DRCSRC = $(SRC)/emu/cpu/x86drc.c
+endif
+
+check: mips3cmp_int mips3cmp_drc
+	@fail=0; \
+	for opts in "" "-fastram" "-be" "-be -fastram"; do \
+		seed=1; \
+		while [ $$seed -le $(SEEDS) ]; do \
+			if ! ./mips3cmp_int $$seed $$opts > mips3cmp_int.txt || \
+			   ! ./mips3cmp_drc $$seed $$opts > mips3cmp_drc.txt || \
+			   ! cmp -s mips3cmp_int.txt mips3cmp_drc.txt; then echo "seed $$seed $$opts differs"; fail=$$((fail + 1)); fi; \
+			seed=$$((seed + 1)); \
+		done; \
+	done; \
+	rm -f mips3cmp_int.txt mips3cmp_drc.txt; \
+	echo "$$fail mismatches"; \
+	[ $$fail -eq 0 ]
+
+mips3cmp_int: mips3cmp.c mips3.c mips3com.c mips3dsm.c
+	$(CC) $(CFLAGS) mips3cmp.c mips3.c mips3com.c mips3dsm.c -lm -o $@
+
+mips3cmp_drc: mips3cmp.c mips3drc.c mdrcold.c mips3com.c mips3dsm.c $(DRCSRC) $(SRC)/emu/cpu/x86emit.h
+	$(CC) $(CFLAGS) mips3cmp.c mips3drc.c mips3com.c mips3dsm.c $(DRCSRC) -lm -o $@
+
+clean:
+	rm -f mips3cmp_int mips3cmp_drc
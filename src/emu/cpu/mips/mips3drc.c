@@ -18,7 +18,6 @@
 
 #ifdef PTR64
 #include "cpu/x64drc.h"
-#include "mips3fe.h"
 #else
 #include "cpu/x86drc.h"
 #endif
@@ -364,92 +363,6 @@ static void code_log(const char *label, x86code *start, x86code *stop)
 	fflush(logfile);
 }
 
-
-#ifdef PTR64
-
-/*-------------------------------------------------
-    desc_flags_log - generate a string
-    representing the instruction description
-    flags
--------------------------------------------------*/
-
-static const char *desc_flags_log(UINT32 flags)
-{
-	static char tempbuf[30];
-	char *dest = tempbuf;
-
-	/* branches */
-	if (flags & IDESC_IS_UNCONDITIONAL_BRANCH)
-		*dest++ = 'U';
-	else if (flags & IDESC_IS_CONDITIONAL_BRANCH)
-		*dest++ = 'C';
-	else
-		*dest++ = '.';
-
-	/* intrablock branches */
-	*dest++ = (flags & IDESC_INTRABLOCK_BRANCH) ? 'i' : '.';
-
-	/* branch targets */
-	*dest++ = (flags & IDESC_IS_BRANCH_TARGET) ? 'B' : '.';
-
-	/* delay slots */
-	*dest++ = (flags & IDESC_IN_DELAY_SLOT) ? 'D' : '.';
-
-	/* exceptions */
-	if (flags & IDESC_WILL_CAUSE_EXCEPTION)
-		*dest++ = 'E';
-	else if (flags & IDESC_CAN_CAUSE_EXCEPTION)
-		*dest++ = 'e';
-	else
-		*dest++ = '.';
-
-	/* read/write */
-	if (flags & IDESC_READS_MEMORY)
-		*dest++ = 'R';
-	else if (flags & IDESC_WRITES_MEMORY)
-		*dest++ = 'W';
-	else
-		*dest++ = '.';
-
-	/* TLB validation */
-	*dest++ = (flags & IDESC_VALIDATE_TLB) ? 'V' : '.';
-
-	/* TLB modification */
-	*dest++ = (flags & IDESC_MODIFIES_TRANSLATION) ? 'T' : '.';
-
-	/* redispatch */
-	*dest++ = (flags & IDESC_REDISPATCH) ? 'R' : '.';
-	return tempbuf;
-}
-
-
-/*-------------------------------------------------
-    desc_log - log a list of descriptions
--------------------------------------------------*/
-
-static void desc_log(const mips3_opcode_desc *desclist, int indent)
-{
-	/* open the file, creating it if necessary */
-	if (!open_logfile())
-		return;
-	if (indent == 0)
-		fprintf(logfile, "\nDescriptor list @ %08X\n", desclist->pc);
-
-	/* output each descriptor */
-	while (desclist != NULL)
-	{
-		char buffer[100];
-		dasmmips3(buffer, desclist->pc, *desclist->opptr);
-		fprintf(logfile, "%08X [%08X] t:%08X f:%s: %-30s\n", desclist->pc, desclist->physpc, desclist->targetpc, desc_flags_log(desclist->flags), buffer);
-		if (desclist->delay)
-			desc_log(desclist->delay, indent + 1);
-		if (desclist->flags & IDESC_END_SEQUENCE)
-			fprintf(logfile, "-----\n");
-		desclist = desclist->next;
-	}
-}
-#endif
-
 #else
 
 #define code_log_reset()
@@ -465,11 +378,7 @@ static void desc_log(const mips3_opcode_desc *desclist, int indent)
     RECOMPILER CORE
 ***************************************************************************/
 
-#ifdef PTR64
-#include "mdrc64.c"
-#else
 #include "mdrcold.c"
-#endif
 
 
 
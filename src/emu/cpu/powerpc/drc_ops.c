@@ -13,6 +13,18 @@
 #define RECOMPILE_END_OF_STRING			0x0002
 #define RECOMPILE_ADD_DISPATCH			0x0004
 
+/* AH cannot be encoded alongside the REX prefix, so use the DRC scratch register on x64 */
+#ifdef PTR64
+#define REG_CRTEMP8						REG_R11L
+#else
+#define REG_CRTEMP8						REG_AH
+#endif
+
+#ifdef PTR64
+#define emit_mov_r64_m64	emit_mov_r64pair_m64
+#define emit_mov_m64_r64	emit_mov_m64_r64pair
+#endif
+
 INLINE void emit_mov_r64_m64(x86code **emitptr, UINT8 reghi, UINT8 reglo, DECLARE_MEMPARAMS)
 {
 	emit_mov_r32_m32(emitptr, reglo, MEMPARAMS);
@@ -71,11 +83,15 @@ static void ppcdrc_reset(drc_core *drc)
 	code_log("flush:", drc->flush, drc->cache_top);
 
 	ppc.invoke_exception_handler = drc->cache_top;
-	drc_append_restore_volatiles(drc);
+#ifdef PTR64
+	emit_mov_r64_r64(DRCTOP, REG_RAX, REG_PARAM1);
+#else
 	emit_mov_r32_m32(DRCTOP, REG_EAX, MBD(REG_ESP, 4));
-	emit_mov_r32_m32(DRCTOP, REG_ESP, MABS(&ppc.host_esp));
+#endif
+	drc_append_restore_volatiles(drc);
+	emit_mov_rp_mp(DRCTOP, REG_ESP, MABS(&ppc.host_esp));
 	emit_mov_m32_r32(DRCTOP, MABS(&SRR0), REG_EDI);		/* save return address */
-	emit_jmp_r32(DRCTOP, REG_EAX);
+	emit_jmp_rp(DRCTOP, REG_EAX);
 	code_log("invoke_exception_handler:", ppc.invoke_exception_handler, drc->cache_top);
 
 	ppc.generate_interrupt_exception = drc->cache_top;
@@ -218,7 +234,7 @@ static void update_counters(drc_core *drc)
 
 static void ppcdrc_entrygen(drc_core *drc)
 {
-	emit_mov_m32_r32(DRCTOP, MABS(&ppc.host_esp), REG_ESP);
+	emit_mov_mp_rp(DRCTOP, MABS(&ppc.host_esp), REG_ESP);
 	append_check_interrupts(drc, 0);
 }
 
@@ -245,15 +261,19 @@ static UINT32 compile_one(drc_core *drc, UINT32 pc)
 	{
 		/* first check to see if the code is up to date; if not, recompile */
 		emit_push_imm(DRCTOP, pc);
-		emit_call(DRCTOP, (x86code *)ppcdrc_getopptr);
-		emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+		drc_append_call_c(drc, (x86code *)ppcdrc_getopptr, "i");
+		emit_stack_free(DRCTOP, 4);
+#ifdef PTR64
+		emit_test_r64_r64(DRCTOP, REG_RAX, REG_RAX);
+#else
 		emit_cmp_r32_imm(DRCTOP, REG_EAX, 0);
+#endif
 		emit_jcc(DRCTOP, COND_NZ, drc->recompile);
 
 		/* code is up to date; do the exception */
 		emit_mov_m32_r32(DRCTOP, MABS(&SRR0), REG_EDI);		/* save return address */
-		emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&ppc.generate_isi_exception));
-		emit_jmp_r32(DRCTOP, REG_EAX);
+		emit_mov_rp_mp(DRCTOP, REG_EAX, MABS(&ppc.generate_isi_exception));
+		emit_jmp_rp(DRCTOP, REG_EAX);
 		return RECOMPILE_SUCCESSFUL | RECOMPILE_END_OF_STRING;
 	}
 
@@ -332,7 +352,7 @@ static void append_generate_exception(drc_core *drc, UINT8 exception)
 	resolve_link(DRCTOP, &link1);
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)ppc_set_msr);
+	drc_append_call_c(drc, (x86code *)ppc_set_msr, "i");
 	emit_pop_r32(DRCTOP, REG_EDX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -401,15 +421,15 @@ static void append_check_interrupts(drc_core *drc, int inline_generate)
 		emit_jcc_short_link(DRCTOP, COND_Z, &link3);
 
 		emit_mov_m32_r32(DRCTOP, MABS(&SRR0), REG_EDI);		/* save return address */
-		emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&ppc.generate_interrupt_exception));
-		emit_jmp_r32(DRCTOP, REG_EAX);
+		emit_mov_rp_mp(DRCTOP, REG_EAX, MABS(&ppc.generate_interrupt_exception));
+		emit_jmp_rp(DRCTOP, REG_EAX);
 		resolve_link(DRCTOP, &link3);
 
 		emit_test_r32_imm(DRCTOP, REG_EAX, 0x2);			/* is it a decrementer exception */
 		emit_jcc_short_link(DRCTOP, COND_Z, &link4);
 		emit_mov_m32_r32(DRCTOP, MABS(&SRR0), REG_EDI);		/* save return address */
-		emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&ppc.generate_decrementer_exception));
-		emit_jmp_r32(DRCTOP, REG_EAX);
+		emit_mov_rp_mp(DRCTOP, REG_EAX, MABS(&ppc.generate_decrementer_exception));
+		emit_jmp_rp(DRCTOP, REG_EAX);
 		resolve_link(DRCTOP, &link4);
 
 		resolve_link(DRCTOP, &link1);
@@ -436,8 +456,8 @@ static void append_check_interrupts(drc_core *drc, int inline_generate)
 		emit_jcc_short_link(DRCTOP, COND_Z, &link4);
 
 		emit_mov_m32_r32(DRCTOP, MABS(&SRR0), REG_EDI);		/* save return address */
-		emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&ppc.generate_interrupt_exception));
-		emit_jmp_r32(DRCTOP, REG_EAX);
+		emit_mov_rp_mp(DRCTOP, REG_EAX, MABS(&ppc.generate_interrupt_exception));
+		emit_jmp_rp(DRCTOP, REG_EAX);
 
 		/* check if it's FIT exception */
 		resolve_link(DRCTOP, &link3);
@@ -454,8 +474,8 @@ static void append_check_interrupts(drc_core *drc, int inline_generate)
 		emit_mov_m32_r32(DRCTOP, MABS(&ppc_fit_trigger_cycle), REG_EAX);
 
 		emit_mov_m32_r32(DRCTOP, MABS(&SRR0), REG_EDI);		/* save return address */
-		emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&ppc.generate_fit_exception));
-		emit_jmp_r32(DRCTOP, REG_EAX);
+		emit_mov_rp_mp(DRCTOP, REG_EAX, MABS(&ppc.generate_fit_exception));
+		emit_jmp_rp(DRCTOP, REG_EAX);
 
 		resolve_link(DRCTOP, &link1);
 		resolve_link(DRCTOP, &link2);
@@ -508,12 +528,12 @@ static void append_set_cr0(drc_core *drc)
     */
 
 	emit_setcc_r8(DRCTOP, COND_Z, REG_AL);
-	emit_setcc_r8(DRCTOP, COND_L, REG_AH);
+	emit_setcc_r8(DRCTOP, COND_L, REG_CRTEMP8);
 	emit_setcc_r8(DRCTOP, COND_G, REG_BL);
 	emit_shl_r8_imm(DRCTOP, REG_AL, 1);
-	emit_shl_r8_imm(DRCTOP, REG_AH, 3);
+	emit_shl_r8_imm(DRCTOP, REG_CRTEMP8, 3);
 	emit_shl_r8_imm(DRCTOP, REG_BL, 2);
-	emit_or_r8_r8(DRCTOP, REG_BL, REG_AH);
+	emit_or_r8_r8(DRCTOP, REG_BL, REG_CRTEMP8);
 	emit_or_r8_r8(DRCTOP, REG_BL, REG_AL);
 
 	emit_bt_m32_imm(DRCTOP, MABS(&XER), 31);		// set XER SO bit to carry
@@ -576,8 +596,8 @@ static UINT32 recompile_addex(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_addex);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_addex, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -654,8 +674,8 @@ static UINT32 recompile_addmex(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_addmex);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_addmex, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -664,8 +684,8 @@ static UINT32 recompile_addzex(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_addzex);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_addzex, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -980,12 +1000,12 @@ static UINT32 recompile_cmp(drc_core *drc, UINT32 op)
 	emit_cmp_r32_m32(DRCTOP, REG_ECX, MABS(&REG(RB)));
 
 	emit_setcc_r8(DRCTOP, COND_Z, REG_AL);
-	emit_setcc_r8(DRCTOP, COND_L, REG_AH);
+	emit_setcc_r8(DRCTOP, COND_L, REG_CRTEMP8);
 	emit_setcc_r8(DRCTOP, COND_G, REG_BL);
 	emit_shl_r8_imm(DRCTOP, REG_AL, 1);
-	emit_shl_r8_imm(DRCTOP, REG_AH, 3);
+	emit_shl_r8_imm(DRCTOP, REG_CRTEMP8, 3);
 	emit_shl_r8_imm(DRCTOP, REG_BL, 2);
-	emit_or_r8_r8(DRCTOP, REG_BL, REG_AH);
+	emit_or_r8_r8(DRCTOP, REG_BL, REG_CRTEMP8);
 	emit_or_r8_r8(DRCTOP, REG_BL, REG_AL);
 
 	emit_bt_m32_imm(DRCTOP, MABS(&XER), 31);		// set XER SO bit to carry
@@ -1003,12 +1023,12 @@ static UINT32 recompile_cmpi(drc_core *drc, UINT32 op)
 	emit_cmp_r32_imm(DRCTOP, REG_ECX, SIMM16);
 
 	emit_setcc_r8(DRCTOP, COND_Z, REG_AL);
-	emit_setcc_r8(DRCTOP, COND_L, REG_AH);
+	emit_setcc_r8(DRCTOP, COND_L, REG_CRTEMP8);
 	emit_setcc_r8(DRCTOP, COND_G, REG_BL);
 	emit_shl_r8_imm(DRCTOP, REG_AL, 1);
-	emit_shl_r8_imm(DRCTOP, REG_AH, 3);
+	emit_shl_r8_imm(DRCTOP, REG_CRTEMP8, 3);
 	emit_shl_r8_imm(DRCTOP, REG_BL, 2);
-	emit_or_r8_r8(DRCTOP, REG_BL, REG_AH);
+	emit_or_r8_r8(DRCTOP, REG_BL, REG_CRTEMP8);
 	emit_or_r8_r8(DRCTOP, REG_BL, REG_AL);
 
 	emit_bt_m32_imm(DRCTOP, MABS(&XER), 31);		// set XER SO bit to carry
@@ -1026,12 +1046,12 @@ static UINT32 recompile_cmpl(drc_core *drc, UINT32 op)
 	emit_cmp_r32_m32(DRCTOP, REG_ECX, MABS(&REG(RB)));
 
 	emit_setcc_r8(DRCTOP, COND_Z, REG_AL);
-	emit_setcc_r8(DRCTOP, COND_B, REG_AH);
+	emit_setcc_r8(DRCTOP, COND_B, REG_CRTEMP8);
 	emit_setcc_r8(DRCTOP, COND_A, REG_BL);
 	emit_shl_r8_imm(DRCTOP, REG_AL, 1);
-	emit_shl_r8_imm(DRCTOP, REG_AH, 3);
+	emit_shl_r8_imm(DRCTOP, REG_CRTEMP8, 3);
 	emit_shl_r8_imm(DRCTOP, REG_BL, 2);
-	emit_or_r8_r8(DRCTOP, REG_BL, REG_AH);
+	emit_or_r8_r8(DRCTOP, REG_BL, REG_CRTEMP8);
 	emit_or_r8_r8(DRCTOP, REG_BL, REG_AL);
 
 	emit_bt_m32_imm(DRCTOP, MABS(&XER), 31);		// set XER SO bit to carry
@@ -1049,12 +1069,12 @@ static UINT32 recompile_cmpli(drc_core *drc, UINT32 op)
 	emit_cmp_r32_imm(DRCTOP, REG_ECX, UIMM16);
 
 	emit_setcc_r8(DRCTOP, COND_Z, REG_AL);
-	emit_setcc_r8(DRCTOP, COND_B, REG_AH);
+	emit_setcc_r8(DRCTOP, COND_B, REG_CRTEMP8);
 	emit_setcc_r8(DRCTOP, COND_A, REG_BL);
 	emit_shl_r8_imm(DRCTOP, REG_AL, 1);
-	emit_shl_r8_imm(DRCTOP, REG_AH, 3);
+	emit_shl_r8_imm(DRCTOP, REG_CRTEMP8, 3);
 	emit_shl_r8_imm(DRCTOP, REG_BL, 2);
-	emit_or_r8_r8(DRCTOP, REG_BL, REG_AH);
+	emit_or_r8_r8(DRCTOP, REG_BL, REG_CRTEMP8);
 	emit_or_r8_r8(DRCTOP, REG_BL, REG_AL);
 
 	emit_bt_m32_imm(DRCTOP, MABS(&XER), 31);		// set XER SO bit to carry
@@ -1086,8 +1106,8 @@ static UINT32 recompile_crand(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_crand);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_crand, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -1096,8 +1116,8 @@ static UINT32 recompile_crandc(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_crandc);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_crandc, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -1106,8 +1126,8 @@ static UINT32 recompile_creqv(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_creqv);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_creqv, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -1116,8 +1136,8 @@ static UINT32 recompile_crnand(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_crnand);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_crnand, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -1126,8 +1146,8 @@ static UINT32 recompile_crnor(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_crnor);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_crnor, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -1136,8 +1156,8 @@ static UINT32 recompile_cror(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_cror);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_cror, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -1146,8 +1166,8 @@ static UINT32 recompile_crorc(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_crorc);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_crorc, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -1156,8 +1176,8 @@ static UINT32 recompile_crxor(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_crxor);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_crxor, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -1196,8 +1216,8 @@ static UINT32 recompile_divwx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_divwx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_divwx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -1206,8 +1226,8 @@ static UINT32 recompile_divwux(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_divwux);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_divwux, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
 }
@@ -1280,8 +1300,8 @@ static UINT32 recompile_lbz(drc_core *drc, UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EAX);
 	}
-	emit_call(DRCTOP, (x86code *)READ8);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ8, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movzx_r32_r8(DRCTOP, REG_EAX, REG_AL);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
@@ -1296,8 +1316,8 @@ static UINT32 recompile_lbzu(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EDX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ8);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ8, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movzx_r32_r8(DRCTOP, REG_EAX, REG_AL);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
@@ -1312,8 +1332,8 @@ static UINT32 recompile_lbzux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ8);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ8, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movzx_r32_r8(DRCTOP, REG_EAX, REG_AL);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
@@ -1330,8 +1350,8 @@ static UINT32 recompile_lbzx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)READ8);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ8, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movzx_r32_r8(DRCTOP, REG_EAX, REG_AL);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
@@ -1352,8 +1372,8 @@ static UINT32 recompile_lha(drc_core *drc, UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EAX);
 	}
-	emit_call(DRCTOP, (x86code *)READ16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ16, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movsx_r32_r16(DRCTOP, REG_EAX, REG_AX);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
@@ -1368,8 +1388,8 @@ static UINT32 recompile_lhau(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EDX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ16, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movsx_r32_r16(DRCTOP, REG_EAX, REG_AX);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
@@ -1384,8 +1404,8 @@ static UINT32 recompile_lhaux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ16, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movsx_r32_r16(DRCTOP, REG_EAX, REG_AX);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
@@ -1402,8 +1422,8 @@ static UINT32 recompile_lhax(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)READ16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ16, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movsx_r32_r16(DRCTOP, REG_EAX, REG_AX);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
@@ -1420,8 +1440,8 @@ static UINT32 recompile_lhbrx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)READ16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ16, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_imm(DRCTOP, REG_ECX, 8);
 	emit_rol_r16_cl(DRCTOP, REG_AX);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
@@ -1443,8 +1463,8 @@ static UINT32 recompile_lhz(drc_core *drc, UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EAX);
 	}
-	emit_call(DRCTOP, (x86code *)READ16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ16, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -1458,8 +1478,8 @@ static UINT32 recompile_lhzu(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EDX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ16, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -1473,8 +1493,8 @@ static UINT32 recompile_lhzux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ16, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -1490,8 +1510,8 @@ static UINT32 recompile_lhzx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)READ16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ16, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -1502,8 +1522,8 @@ static UINT32 recompile_lmw(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_lmw);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_lmw, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -1513,8 +1533,8 @@ static UINT32 recompile_lswi(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_lswi);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_lswi, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -1524,8 +1544,8 @@ static UINT32 recompile_lswx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_lswx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_lswx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -1535,8 +1555,8 @@ static UINT32 recompile_lwarx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_lwarx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_lwarx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -1551,8 +1571,8 @@ static UINT32 recompile_lwbrx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)READ32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ32, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_bswap_r32(DRCTOP, REG_EAX);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
@@ -1573,8 +1593,8 @@ static UINT32 recompile_lwz(drc_core *drc, UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EAX);
 	}
-	emit_call(DRCTOP, (x86code *)READ32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ32, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -1588,8 +1608,8 @@ static UINT32 recompile_lwzu(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EDX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ32, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -1603,8 +1623,8 @@ static UINT32 recompile_lwzux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ32, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -1620,8 +1640,8 @@ static UINT32 recompile_lwzx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)READ32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ32, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -1682,8 +1702,8 @@ static UINT32 recompile_mfspr(drc_core *drc, UINT32 op)
 	{
 		emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 		emit_push_imm(DRCTOP, SPR);
-		emit_call(DRCTOP, (x86code *)ppc_get_spr);
-		emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+		drc_append_call_c(drc, (x86code *)ppc_get_spr, "i");
+		emit_stack_free(DRCTOP, 4);
 		emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	}
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RT)), REG_EAX);
@@ -1695,8 +1715,8 @@ static UINT32 recompile_mtcrf(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mtcrf);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mtcrf, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -1707,8 +1727,8 @@ static UINT32 recompile_mtmsr(drc_core *drc, UINT32 op)
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RS)));
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)ppc_set_msr);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_set_msr, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -1730,8 +1750,8 @@ static UINT32 recompile_mtspr(drc_core *drc, UINT32 op)
 		emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 		emit_push_r32(DRCTOP, REG_EAX);
 		emit_push_imm(DRCTOP, SPR);
-		emit_call(DRCTOP, (x86code *)ppc_set_spr);
-		emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+		drc_append_call_c(drc, (x86code *)ppc_set_spr, "ii");
+		emit_stack_free(DRCTOP, 8);
 		emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	}
 
@@ -1890,8 +1910,8 @@ static UINT32 recompile_rfi(drc_core *drc, UINT32 op)
 	emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&ppc.srr1));	/* get saved MSR from SRR1 */
 
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)ppc_set_msr);		/* set MSR */
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_set_msr, "i");		/* set MSR */
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,0) | RECOMPILE_END_OF_STRING | RECOMPILE_ADD_DISPATCH;
@@ -1973,8 +1993,8 @@ static UINT32 recompile_slwx(drc_core *drc, UINT32 op)
 #else
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_slwx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_slwx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #endif
 
@@ -1985,8 +2005,8 @@ static UINT32 recompile_srawx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_srawx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_srawx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -1996,8 +2016,8 @@ static UINT32 recompile_srawix(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_srawix);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_srawix, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2020,8 +2040,8 @@ static UINT32 recompile_srwx(drc_core *drc, UINT32 op)
 #else
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_srwx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_srwx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #endif
 
@@ -2045,8 +2065,8 @@ static UINT32 recompile_stb(drc_core *drc, UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EAX);
 	}
-	emit_call(DRCTOP, (x86code *)WRITE8);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE8, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2063,8 +2083,8 @@ static UINT32 recompile_stbu(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EDX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)WRITE8);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE8, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2081,8 +2101,8 @@ static UINT32 recompile_stbux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)WRITE8);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE8, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2101,8 +2121,8 @@ static UINT32 recompile_stbx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)WRITE8);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE8, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2125,8 +2145,8 @@ static UINT32 recompile_sth(drc_core *drc, UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EDX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EDX);
 	}
-	emit_call(DRCTOP, (x86code *)WRITE16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE16, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2147,8 +2167,8 @@ static UINT32 recompile_sthbrx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)WRITE16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE16, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2165,8 +2185,8 @@ static UINT32 recompile_sthu(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EDX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)WRITE16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE16, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2183,8 +2203,8 @@ static UINT32 recompile_sthux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)WRITE16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE16, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2203,8 +2223,8 @@ static UINT32 recompile_sthx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)WRITE16);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE16, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2214,8 +2234,8 @@ static UINT32 recompile_stmw(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_stmw);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_stmw, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2225,8 +2245,8 @@ static UINT32 recompile_stswi(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_stswi);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_stswi, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2236,8 +2256,8 @@ static UINT32 recompile_stswx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_stswx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_stswx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2257,8 +2277,8 @@ static UINT32 recompile_stw(drc_core *drc, UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EAX);
 	}
-	emit_call(DRCTOP, (x86code *)WRITE32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE32, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2277,8 +2297,8 @@ static UINT32 recompile_stwbrx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)WRITE32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE32, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2288,8 +2308,8 @@ static UINT32 recompile_stwcx_rc(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_stwcx_rc);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_stwcx_rc, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2304,8 +2324,8 @@ static UINT32 recompile_stwu(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EAX);
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)WRITE32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE32, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2320,8 +2340,8 @@ static UINT32 recompile_stwux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EAX);
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)WRITE32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE32, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2338,8 +2358,8 @@ static UINT32 recompile_stwx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)WRITE32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE32, "ii");
+	emit_stack_free(DRCTOP, 8);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2368,8 +2388,8 @@ static UINT32 recompile_subfcx(drc_core *drc, UINT32 op)
 	{
 		emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 		emit_push_imm(DRCTOP, op);
-		emit_call(DRCTOP, (x86code *)ppc_subfcx);
-		emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+		drc_append_call_c(drc, (x86code *)ppc_subfcx, "i");
+		emit_stack_free(DRCTOP, 4);
 		emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 	}
 	else
@@ -2444,8 +2464,8 @@ static UINT32 recompile_subfmex(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_subfmex);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_subfmex, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2455,8 +2475,8 @@ static UINT32 recompile_subfzex(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_subfzex);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_subfzex, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2654,8 +2674,8 @@ static UINT32 recompile_mfdcr(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mfdcr);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mfdcr, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2665,8 +2685,8 @@ static UINT32 recompile_mtdcr(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mtdcr);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mtdcr, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2676,8 +2696,8 @@ static UINT32 recompile_wrtee(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_wrtee);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_wrtee, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2687,8 +2707,8 @@ static UINT32 recompile_wrteei(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_wrteei);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_wrteei, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2721,15 +2741,15 @@ static UINT32 recompile_lfs(drc_core *drc,UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EAX);
 	}
-	emit_call(DRCTOP, (genf*)READ32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ32, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movd_r128_r32(DRCTOP, REG_XMM0, REG_EAX);
 	emit_cvtss2sd_r128_r128(DRCTOP, REG_XMM1, REG_XMM0);		// convert float to double
 	emit_movq_m64_r128(DRCTOP, MABS(&FPR(RT)), REG_XMM1);
 #else
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_lfs);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_lfs, "i");
+	emit_stack_free(DRCTOP, 4);
 #endif
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -2744,15 +2764,15 @@ static UINT32 recompile_lfsu(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EDX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ32, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movd_r128_r32(DRCTOP, REG_XMM0, REG_EAX);
 	emit_cvtss2sd_r128_r128(DRCTOP, REG_XMM1, REG_XMM0);		// convert float to double
 	emit_movq_m64_r128(DRCTOP, MABS(&FPR(RT)), REG_XMM1);
 #else
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_lfsu);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_lfsu, "i");
+	emit_stack_free(DRCTOP, 4);
 #endif
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -2772,8 +2792,8 @@ static UINT32 recompile_lfd(drc_core *drc, UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EAX);
 	}
-	emit_call(DRCTOP, (x86code *)READ64);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ64, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m64_r64(DRCTOP, MABS(&FPR(RT)), REG_EDX, REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -2787,8 +2807,8 @@ static UINT32 recompile_lfdu(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EDX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ64);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ64, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m64_r64(DRCTOP, MABS(&FPR(RT)), REG_EDX, REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -2813,12 +2833,12 @@ static UINT32 recompile_stfs(drc_core *drc, UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EAX);
 	}
-	emit_call(DRCTOP, (x86code *)WRITE32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE32, "ii");
+	emit_stack_free(DRCTOP, 8);
 #else
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_stfs);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_stfs, "i");
+	emit_stack_free(DRCTOP, 4);
 #endif
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -2838,12 +2858,12 @@ static UINT32 recompile_stfsu(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EAX);
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)WRITE32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE32, "ii");
+	emit_stack_free(DRCTOP, 8);
 #else
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_stfsu);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_stfsu, "i");
+	emit_stack_free(DRCTOP, 4);
 #endif
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -2866,8 +2886,8 @@ static UINT32 recompile_stfd(drc_core *drc, UINT32 op)
 		emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 		emit_push_r32(DRCTOP, REG_EAX);
 	}
-	emit_call(DRCTOP, (x86code *)WRITE64);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 12);
+	drc_append_call_c(drc, (x86code *)WRITE64, "iq");
+	emit_stack_free(DRCTOP, 12);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2884,8 +2904,8 @@ static UINT32 recompile_stfdu(drc_core *drc, UINT32 op)
 	emit_add_r32_imm(DRCTOP, REG_EAX, SIMM16);
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EAX);
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)WRITE64);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 12);
+	drc_append_call_c(drc, (x86code *)WRITE64, "iq");
+	emit_stack_free(DRCTOP, 12);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2898,8 +2918,8 @@ static UINT32 recompile_lfdux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ64);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ64, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m64_r64(DRCTOP, MABS(&FPR(RT)), REG_EDX, REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -2915,8 +2935,8 @@ static UINT32 recompile_lfdx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)READ64);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ64, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_m64_r64(DRCTOP, MABS(&FPR(RT)), REG_EDX, REG_EAX);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -2931,15 +2951,15 @@ static UINT32 recompile_lfsux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EDX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EDX);
 	emit_push_r32(DRCTOP, REG_EDX);
-	emit_call(DRCTOP, (x86code *)READ32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ32, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movd_r128_r32(DRCTOP, REG_XMM0, REG_EAX);
 	emit_cvtss2sd_r128_r128(DRCTOP, REG_XMM1, REG_XMM0);		// convert float to double
 	emit_movq_m64_r128(DRCTOP, MABS(&FPR(RT)), REG_XMM1);
 #else
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_lfsux);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_lfsux, "i");
+	emit_stack_free(DRCTOP, 4);
 #endif
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -2956,15 +2976,15 @@ static UINT32 recompile_lfsx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)READ32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)READ32, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_movd_r128_r32(DRCTOP, REG_XMM0, REG_EAX);
 	emit_cvtss2sd_r128_r128(DRCTOP, REG_XMM1, REG_XMM0);		// convert float to double
 	emit_movq_m64_r128(DRCTOP, MABS(&FPR(RT)), REG_XMM1);
 #else
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_lfsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_lfsx, "i");
+	emit_stack_free(DRCTOP, 4);
 #endif
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -2975,8 +2995,8 @@ static UINT32 recompile_mfsr(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mfsr);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mfsr, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2986,8 +3006,8 @@ static UINT32 recompile_mfsrin(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mfsrin);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mfsrin, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -2997,8 +3017,8 @@ static UINT32 recompile_mftb(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mftb);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mftb, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3008,8 +3028,8 @@ static UINT32 recompile_mtsr(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mtsr);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mtsr, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3019,8 +3039,8 @@ static UINT32 recompile_mtsrin(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mtsrin);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mtsrin, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3042,8 +3062,8 @@ static UINT32 recompile_stfdux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EAX);
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)WRITE64);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 12);
+	drc_append_call_c(drc, (x86code *)WRITE64, "iq");
+	emit_stack_free(DRCTOP, 12);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3062,12 +3082,12 @@ static UINT32 recompile_stfdx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)WRITE64);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 12);
+	drc_append_call_c(drc, (x86code *)WRITE64, "iq");
+	emit_stack_free(DRCTOP, 12);
 
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_stfdx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_stfdx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3087,12 +3107,12 @@ static UINT32 recompile_stfiwx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)WRITE32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE32, "ii");
+	emit_stack_free(DRCTOP, 8);
 #else
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_stfiwx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_stfiwx, "i");
+	emit_stack_free(DRCTOP, 4);
 #endif
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -3112,12 +3132,12 @@ static UINT32 recompile_stfsux(drc_core *drc, UINT32 op)
 	emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RB)));
 	emit_mov_m32_r32(DRCTOP, MABS(&REG(RA)), REG_EAX);
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)WRITE32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE32, "ii");
+	emit_stack_free(DRCTOP, 8);
 #else
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_stfsux);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_stfsux, "i");
+	emit_stack_free(DRCTOP, 4);
 #endif
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -3139,12 +3159,12 @@ static UINT32 recompile_stfsx(drc_core *drc, UINT32 op)
 		emit_add_r32_m32(DRCTOP, REG_EAX, MABS(&REG(RA)));
 	}
 	emit_push_r32(DRCTOP, REG_EAX);
-	emit_call(DRCTOP, (x86code *)WRITE32);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 8);
+	drc_append_call_c(drc, (x86code *)WRITE32, "ii");
+	emit_stack_free(DRCTOP, 8);
 #else
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_stfsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_stfsx, "i");
+	emit_stack_free(DRCTOP, 4);
 #endif
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
@@ -3183,8 +3203,8 @@ static UINT32 recompile_fabsx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fabsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fabsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_mov_r64_m64(DRCTOP, REG_EDX, REG_EAX, MABS(&FPR(RB)));
@@ -3203,8 +3223,8 @@ static UINT32 recompile_faddx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_faddx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_faddx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3223,8 +3243,8 @@ static UINT32 recompile_fcmpo(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fcmpo);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fcmpo, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3234,8 +3254,8 @@ static UINT32 recompile_fcmpu(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fcmpu);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fcmpu, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3245,8 +3265,8 @@ static UINT32 recompile_fctiwx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fctiwx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fctiwx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3256,8 +3276,8 @@ static UINT32 recompile_fctiwzx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fctiwzx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fctiwzx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3268,8 +3288,8 @@ static UINT32 recompile_fdivx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fdivx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fdivx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3297,8 +3317,8 @@ static UINT32 recompile_fmrx(drc_core *drc, UINT32 op)
 #else
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fmrx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fmrx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #endif
 
@@ -3310,8 +3330,8 @@ static UINT32 recompile_fnabsx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fnabsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fnabsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_mov_r64_m64(DRCTOP, REG_EDX, REG_EAX, MABS(&FPR(RB)));
@@ -3331,8 +3351,8 @@ static UINT32 recompile_fnegx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fnegx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fnegx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_mov_r64_m64(DRCTOP, REG_EDX, REG_EAX, MABS(&FPR(RB)));
@@ -3351,8 +3371,8 @@ static UINT32 recompile_frspx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_frspx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_frspx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 /*
     _movq_r128_m64(REG_XMM0, MABS(&FPR(RB)));
@@ -3369,8 +3389,8 @@ static UINT32 recompile_frsqrtex(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_frsqrtex);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_frsqrtex, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3380,8 +3400,8 @@ static UINT32 recompile_fsqrtx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fsqrtx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fsqrtx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3392,8 +3412,8 @@ static UINT32 recompile_fsubx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fsubx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fsubx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3413,8 +3433,8 @@ static UINT32 recompile_mffsx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mffsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mffsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3424,8 +3444,8 @@ static UINT32 recompile_mtfsb0x(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mtfsb0x);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mtfsb0x, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3435,8 +3455,8 @@ static UINT32 recompile_mtfsb1x(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mtfsb1x);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mtfsb1x, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3446,8 +3466,8 @@ static UINT32 recompile_mtfsfx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mtfsfx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mtfsfx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3457,8 +3477,8 @@ static UINT32 recompile_mtfsfix(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mtfsfix);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mtfsfix, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3468,8 +3488,8 @@ static UINT32 recompile_mcrfs(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_mcrfs);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_mcrfs, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3480,8 +3500,8 @@ static UINT32 recompile_faddsx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_faddsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_faddsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3502,8 +3522,8 @@ static UINT32 recompile_fdivsx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fdivsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fdivsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3523,8 +3543,8 @@ static UINT32 recompile_fresx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fresx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fresx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3534,8 +3554,8 @@ static UINT32 recompile_fsqrtsx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fsqrtsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fsqrtsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3546,8 +3566,8 @@ static UINT32 recompile_fsubsx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fsubsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fsubsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3568,8 +3588,8 @@ static UINT32 recompile_fmaddx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fmaddx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fmaddx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3592,8 +3612,8 @@ static UINT32 recompile_fmsubx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fmsubx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fmsubx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3616,8 +3636,8 @@ static UINT32 recompile_fmulx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fmulx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fmulx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3637,8 +3657,8 @@ static UINT32 recompile_fnmaddx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fnmaddx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fnmaddx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3648,8 +3668,8 @@ static UINT32 recompile_fnmsubx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fnmsubx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fnmsubx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3659,8 +3679,8 @@ static UINT32 recompile_fselx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fselx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fselx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3671,8 +3691,8 @@ static UINT32 recompile_fmaddsx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fmaddsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fmaddsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3695,8 +3715,8 @@ static UINT32 recompile_fmsubsx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fmsubsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fmsubsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3719,8 +3739,8 @@ static UINT32 recompile_fmulsx(drc_core *drc, UINT32 op)
 #if !COMPILE_FPU || !USE_SSE2
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fmulsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fmulsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 #else
 	emit_movq_r128_m64(DRCTOP, REG_XMM0, MABS(&FPR(RA)));
@@ -3740,8 +3760,8 @@ static UINT32 recompile_fnmaddsx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fnmaddsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fnmaddsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3751,8 +3771,8 @@ static UINT32 recompile_fnmsubsx(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_fnmsubsx);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_fnmsubsx, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3765,8 +3785,8 @@ static UINT32 recompile_esa(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_esa);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_esa, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -3776,8 +3796,8 @@ static UINT32 recompile_dsa(drc_core *drc, UINT32 op)
 {
 	emit_mov_m32_r32(DRCTOP, MABS(&ppc_icount), REG_EBP);
 	emit_push_imm(DRCTOP, op);
-	emit_call(DRCTOP, (x86code *)ppc_dsa);
-	emit_add_r32_imm(DRCTOP, REG_ESP, 4);
+	drc_append_call_c(drc, (x86code *)ppc_dsa, "i");
+	emit_stack_free(DRCTOP, 4);
 	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&ppc_icount));
 
 	return RECOMPILE_SUCCESSFUL_CP(1,4);
@@ -6,7 +6,11 @@
 
 #include "ppc.h"
 #include "debugger.h"
+#ifdef PTR64
+#include "cpu/x64drc.h"
+#else
 #include "cpu/x86drc.h"
+#endif
 
 
 #define PPC_DRC
@@ -314,7 +318,7 @@ typedef struct {
 	void (*write64_unaligned)(offs_t address, UINT64 data);
 
 	/* saved ESP when entering entry point */
-	UINT32 host_esp;
+	FPTR host_esp;
 } PPC_REGS;
 
 
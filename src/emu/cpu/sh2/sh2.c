@@ -103,6 +103,14 @@
 #include "debugger.h"
 #include "sh2.h"
 
+#ifdef SH2_DRC
+#ifdef PTR64
+#include "cpu/x64drc.h"
+#else
+#include "cpu/x86drc.h"
+#endif
+#endif
+
 /* speed up delay loops, bail out of tight loops */
 #define BUSY_LOOP_HACKS 	1
 
@@ -157,6 +165,12 @@ typedef struct
 	int     is_slave, cpu_number;
 
 	void	(*ftcsr_read_callback)(UINT32 data);
+
+#ifdef SH2_DRC
+	drc_core *drc;
+	x86code	*check_irq;
+	UINT32	drc_generation;
+#endif
 } SH2;
 
 static int sh2_icount;
@@ -189,6 +203,22 @@ static TIMER_CALLBACK( sh2_timer_callback );
 #define Rn	((opcode>>8)&15)
 #define Rm	((opcode>>4)&15)
 
+#ifdef SH2_DRC
+/* one bit per 4k page of the external address space that holds recompiled code */
+static UINT8 sh2drc_code_pages[0x08000000 >> 15];
+static UINT32 sh2drc_code_generation;
+
+static void sh2drc_init(void);
+static void sh2drc_exit(void);
+static int sh2drc_execute(int cycles);
+static void sh2drc_code_modified(void);
+
+#define SH2DRC_PAGE(A)			(((A) & 0x07ffffff) >> 12)
+#define SH2DRC_CHECK_WRITE(A)	do { UINT32 page = SH2DRC_PAGE(A); if (sh2drc_code_pages[page >> 3] & (1 << (page & 7))) sh2drc_code_modified(); } while (0)
+#else
+#define SH2DRC_CHECK_WRITE(A)
+#endif
+
 INLINE UINT8 RB(offs_t A)
 {
 	if (A >= 0xe0000000)
@@ -242,6 +272,7 @@ INLINE void WB(offs_t A, UINT8 V)
 
 	if (A >= 0xc0000000)
 	{
+		SH2DRC_CHECK_WRITE(A);
 		program_write_byte_32be(A,V);
 		return;
 	}
@@ -249,6 +280,7 @@ INLINE void WB(offs_t A, UINT8 V)
 	if (A >= 0x40000000)
 		return;
 
+	SH2DRC_CHECK_WRITE(A);
 	program_write_byte_32be(A & AM,V);
 }
 
@@ -262,6 +294,7 @@ INLINE void WW(offs_t A, UINT16 V)
 
 	if (A >= 0xc0000000)
 	{
+		SH2DRC_CHECK_WRITE(A);
 		program_write_word_32be(A,V);
 		return;
 	}
@@ -269,6 +302,7 @@ INLINE void WW(offs_t A, UINT16 V)
 	if (A >= 0x40000000)
 		return;
 
+	SH2DRC_CHECK_WRITE(A);
 	program_write_word_32be(A & AM,V);
 }
 
@@ -282,6 +316,7 @@ INLINE void WL(offs_t A, UINT32 V)
 
 	if (A >= 0xc0000000)
 	{
+		SH2DRC_CHECK_WRITE(A);
 		program_write_dword_32be(A,V);
 		return;
 	}
@@ -289,6 +324,7 @@ INLINE void WL(offs_t A, UINT32 V)
 	if (A >= 0x40000000)
 		return;
 
+	SH2DRC_CHECK_WRITE(A);
 	program_write_dword_32be(A & AM,V);
 }
 
@@ -2294,6 +2330,9 @@ static void sh2_reset(void)
 
 	void (*f)(UINT32 data);
 	int (*save_irqcallback)(int);
+#ifdef SH2_DRC
+	drc_core *drc = sh2.drc;
+#endif
 
 	cpunum = sh2.cpu_number;
 	m = sh2.m;
@@ -2322,8 +2361,14 @@ static void sh2_reset(void)
 	change_pc(sh2.pc & AM);
 
 	sh2.internal_irq_level = -1;
+
+#ifdef SH2_DRC
+	sh2.drc = drc;
+	drc_cache_reset(sh2.drc);
+#endif
 }
 
+#ifndef SH2_DRC
 /* Execute cycles - returns number of cycles actually run */
 static int sh2_execute(int cycles)
 {
@@ -2381,6 +2426,7 @@ static int sh2_execute(int cycles)
 
 	return cycles - sh2_icount;
 }
+#endif
 
 /* Get registers, return context size */
 static void sh2_get_context(void *dst)
@@ -2571,6 +2617,7 @@ static void sh2_dmac_check(int dma)
 						src --;
 					if(incd == 2)
 						dst --;
+					SH2DRC_CHECK_WRITE(dst);
 					program_write_byte_32be(dst, program_read_byte_32be(src));
 					if(incs == 1)
 						src ++;
@@ -2587,6 +2634,7 @@ static void sh2_dmac_check(int dma)
 						src -= 2;
 					if(incd == 2)
 						dst -= 2;
+					SH2DRC_CHECK_WRITE(dst);
 					program_write_word_32be(dst, program_read_word_32be(src));
 					if(incs == 1)
 						src += 2;
@@ -2603,6 +2651,7 @@ static void sh2_dmac_check(int dma)
 						src -= 4;
 					if(incd == 2)
 						dst -= 4;
+					SH2DRC_CHECK_WRITE(dst);
 					program_write_dword_32be(dst, program_read_dword_32be(src));
 					if(incs == 1)
 						src += 4;
@@ -2619,6 +2668,7 @@ static void sh2_dmac_check(int dma)
 				{
 					if(incd == 2)
 						dst -= 16;
+					SH2DRC_CHECK_WRITE(dst);
 					program_write_dword_32be(dst, program_read_dword_32be(src));
 					program_write_dword_32be(dst+4, program_read_dword_32be(src+4));
 					program_write_dword_32be(dst+8, program_read_dword_32be(src+8));
@@ -2883,6 +2933,13 @@ void sh2_set_frt_input(int cpunum, int state)
 	cpuintrf_pop_context();
 }
 
+/* called from the write handlers of RAM that devices other than the SH-2s
+   (SCU DMA, for instance) can fill with SH-2 code */
+void sh2_notify_code_write(offs_t address)
+{
+	SH2DRC_CHECK_WRITE(address);
+}
+
 static void set_irq_line(int irqline, int state)
 {
 	if (irqline == INPUT_LINE_NMI)
@@ -2976,6 +3033,10 @@ static void sh2_init(int index, int clock, const void *config, int (*irqcallback
 	state_save_register_item("sh2", index, sh2.r[13]);
 	state_save_register_item("sh2", index, sh2.r[14]);
 	state_save_register_item("sh2", index, sh2.ea);
+
+#ifdef SH2_DRC
+	sh2drc_init();
+#endif
 }
 
 
@@ -3127,7 +3188,12 @@ void sh2_get_info(UINT32 state, cpuinfo *info)
 		case CPUINFO_PTR_SET_CONTEXT:					info->setcontext = sh2_set_context;		break;
 		case CPUINFO_PTR_INIT:							info->init = sh2_init;					break;
 		case CPUINFO_PTR_RESET:							info->reset = sh2_reset;				break;
+#ifdef SH2_DRC
+		case CPUINFO_PTR_EXIT:							info->exit = sh2drc_exit;				break;
+		case CPUINFO_PTR_EXECUTE:						info->execute = sh2drc_execute;			break;
+#else
 		case CPUINFO_PTR_EXECUTE:						info->execute = sh2_execute;			break;
+#endif
 		case CPUINFO_PTR_BURN:							info->burn = NULL;						break;
 #ifdef MAME_DEBUG
 		case CPUINFO_PTR_DISASSEMBLE:					info->disassemble = sh2_dasm;			break;
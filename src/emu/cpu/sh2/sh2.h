@@ -74,6 +74,7 @@ extern void sh2_get_info(UINT32 state, cpuinfo *info);
 
 WRITE32_HANDLER( sh2_internal_w );
 READ32_HANDLER( sh2_internal_r );
+void sh2_notify_code_write(offs_t address);
 
 #ifdef MAME_DEBUG
 extern unsigned DasmSH2( char *dst, unsigned pc, UINT16 opcode );
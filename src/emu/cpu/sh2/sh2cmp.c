@@ -0,0 +1,671 @@
+/***************************************************************************
+
+    sh2cmp.c
+
+    Standalone consistency check for the SH-2 cores. It generates a
+    random program from a seed, runs it on whichever core it is linked
+    with, and prints the registers and data memory at the end. Linking
+    it once with the interpreter and once with the recompiler and
+    comparing the output over many seeds checks the recompiler against
+    the interpreter; sh2cmp.mak does exactly that.
+
+    The program runs several times. Between runs one of its instructions
+    is replaced behind the core's back, the way a DMA controller would,
+    and sh2_notify_code_write() is called for it, so a recompiler that
+    keeps running stale code shows up as a mismatch.
+
+    Usage: sh2cmp <seed> [-count <n>] [-list]
+
+***************************************************************************/
+
+#include <stdarg.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#include "cpuintrf.h"
+#include "sh2.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define RAM_SIZE			(8 * 1024 * 1024)
+
+#define VECTOR_BASE			0x00000000		/* VBR; the TRAPA vectors all point at TRAP_HANDLER */
+#define TRAP_HANDLER		0x00000800
+#define CODE_BASE			0x00001000		/* program start */
+#define DATA_BASE			0x00100000		/* data the pointer registers point into */
+#define DATA_SIZE			0x2000
+#define STACK_TOP			(DATA_BASE + 0x1e00)
+#define GBR_BASE			(DATA_BASE + 0x1000)
+
+#define DEFAULT_COUNT		200				/* random units in the program */
+#define PASSES				3				/* times the program runs */
+#define MAX_CODE			0x2000			/* words of room for the program */
+#define MAX_PENDING			64
+
+/* pending branch fixups */
+#define FIX_DISP8			0				/* bt/bf/bt/s/bf/s */
+#define FIX_DISP12			1				/* bra/bsr */
+#define FIX_MOVIMM			2				/* mov #imm,Rk ahead of braf/bsrf */
+#define FIX_MOVA			3				/* mova ahead of jmp/jsr/rts; needs a long-aligned target */
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _pending_branch pending_branch;
+struct _pending_branch
+{
+	int				fixup;				/* which word to patch, and how */
+	int				type;
+	offs_t			pc;					/* address the displacement is relative to */
+	int				units;				/* units left to skip */
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* pieces of the emulator the cores reference */
+static running_machine machine;
+running_machine *Machine = &machine;
+UINT8 opcode_entry;
+UINT8 *opcode_base;
+UINT8 *opcode_arg_base;
+offs_t opcode_mask;
+offs_t opcode_memory_min, opcode_memory_max = 0xffffffff;
+address_space active_address_space[ADDRESS_SPACES];
+int activecpu;
+UINT32 cycles_per_second[MAX_CPU];
+subseconds_t subseconds_per_cycle[MAX_CPU];
+mame_time time_never, time_zero;
+
+/* the test machine: RAM mirrored over the whole address space */
+static UINT8 *ram;
+static UINT64 total_cycles;
+
+/* program generator state */
+static UINT32 rand_seed;
+static int codeindex;
+static UINT8 plain[MAX_CODE];			/* words holding an op that can be swapped for any other plain op */
+static pending_branch pending[MAX_PENDING];
+static int pending_count;
+
+unsigned DasmSH2(char *buffer, unsigned pc, UINT16 opcode);
+
+
+
+/***************************************************************************
+    EMULATOR STUBS
+***************************************************************************/
+
+void CLIB_DECL fatalerror(const char *text, ...)
+{
+	va_list arg;
+
+	va_start(arg, text);
+	vfprintf(stderr, text, arg);
+	va_end(arg);
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+void CLIB_DECL logerror(const char *text, ...) { }
+void CLIB_DECL mame_printf_debug(const char *text, ...) { }
+void mame_debug_hook(void) { }
+void memory_set_opbase(offs_t offset) { }
+void cpunum_set_input_line(int cpunum, int line, int state) { }
+void cpuintrf_push_context(int cpunum) { }
+void cpuintrf_pop_context(void) { }
+UINT32 cpunum_gettotalcycles(int cpunum) { return (UINT32)total_cycles; }
+UINT64 activecpu_gettotalcycles64(void) { return total_cycles; }
+void state_save_register_memory(const char *module, UINT32 instance, const char *name, void *val, UINT32 valsize, UINT32 valcount) { }
+
+void *auto_malloc_file_line(size_t size, const char *file, int line)
+{
+	return malloc_or_die_file_line(size, file, line);
+}
+
+void *malloc_or_die_file_line(size_t size, const char *file, int line)
+{
+	void *result = calloc(1, size);
+	if (result == NULL)
+		fatalerror("Out of memory allocating %d bytes (%s:%d)", (int)size, file, line);
+	return result;
+}
+
+mame_timer *_mame_timer_alloc(void (*callback)(running_machine *, int), const char *file, int line, const char *func)
+{
+	/* the free-running timer and the DMA controller are never started by the test programs */
+	return malloc_or_die_file_line(64, file, line);
+}
+
+void mame_timer_adjust(mame_timer *which, mame_time duration, int param, mame_time period) { }
+
+void *osd_alloc_executable(size_t size)
+{
+	/* malloc'ed memory isn't executable on most current systems */
+#ifdef _WIN32
+	return VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+#else
+	void *result = mmap(NULL, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANON, -1, 0);
+	return (result == MAP_FAILED) ? NULL : result;
+#endif
+}
+
+void osd_free_executable(void *ptr, size_t size)
+{
+#ifdef _WIN32
+	VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+	munmap(ptr, size);
+#endif
+}
+
+#define RAM_OFFSET(a)	((a) & (RAM_SIZE - 1))
+
+UINT8 program_read_byte_32be(offs_t address)					{ return ram[BYTE4_XOR_BE(RAM_OFFSET(address))]; }
+UINT16 program_read_word_32be(offs_t address)					{ return *(UINT16 *)&ram[WORD_XOR_BE(RAM_OFFSET(address) & ~1)]; }
+UINT32 program_read_dword_32be(offs_t address)					{ return *(UINT32 *)&ram[RAM_OFFSET(address) & ~3]; }
+UINT32 program_read_masked_32be(offs_t address, UINT32 mask)	{ return *(UINT32 *)&ram[RAM_OFFSET(address) & ~3]; }
+void program_write_byte_32be(offs_t address, UINT8 data)		{ ram[BYTE4_XOR_BE(RAM_OFFSET(address))] = data; }
+void program_write_word_32be(offs_t address, UINT16 data)		{ *(UINT16 *)&ram[WORD_XOR_BE(RAM_OFFSET(address) & ~1)] = data; }
+void program_write_dword_32be(offs_t address, UINT32 data)		{ *(UINT32 *)&ram[RAM_OFFSET(address) & ~3] = data; }
+void program_write_masked_32be(offs_t address, UINT32 data, UINT32 mask)
+{
+	UINT32 *dest = (UINT32 *)&ram[RAM_OFFSET(address) & ~3];
+	*dest = (*dest & mask) | (data & ~mask);
+}
+
+
+
+/***************************************************************************
+    PROGRAM GENERATOR
+***************************************************************************/
+
+/*-------------------------------------------------
+    rand_range - return a pseudo-random value
+    in the range 0 to range-1
+-------------------------------------------------*/
+
+static UINT32 rand_range(UINT32 range)
+{
+	rand_seed = rand_seed * 1664525 + 1013904223;
+	return ((rand_seed >> 8) ^ (rand_seed << 13)) % range;
+}
+
+
+/* r8-r13 point into the data and are never written except by post-increment and */
+/* pre-decrement; r15 is the stack; everything else is fair game */
+#define DEST_REG()		(rand_range(9) == 8 ? 14 : rand_range(8))
+#define SOURCE_REG()	rand_range(16)
+#define POINTER_REG()	(8 + rand_range(6))
+
+#define PC_NOW			(CODE_BASE + codeindex * 2)
+
+
+/*-------------------------------------------------
+    emit - append an instruction
+-------------------------------------------------*/
+
+INLINE void emit(UINT16 op)
+{
+	if (codeindex >= MAX_CODE)
+		fatalerror("Program too long");
+	plain[codeindex] = FALSE;
+	program_write_word_32be(PC_NOW, op);
+	codeindex++;
+}
+
+
+/*-------------------------------------------------
+    random_plain_op - return one random
+    instruction that is neither a branch nor
+    PC-relative, and which doesn't depend on R0
+    having been set up first; these are safe in
+    a delay slot
+-------------------------------------------------*/
+
+static UINT16 random_plain_op(void)
+{
+	int kind = rand_range(100);
+
+	/* two-register ALU, compare, multiply and divide-step ops: 0010, 0011, 0110, and mul.l */
+	if (kind < 40)
+	{
+		static const UINT16 ops[] =
+		{
+			0x2007,0x2008,0x2009,0x200a,0x200b,0x200c,0x200d,0x200e,0x200f,
+			0x3000,0x3002,0x3003,0x3004,0x3005,0x3006,0x3007,0x3008,0x300a,0x300b,0x300c,0x300d,0x300e,0x300f,
+			0x6003,0x6007,0x6008,0x6009,0x600a,0x600b,0x600c,0x600d,0x600e,0x600f,
+			0x0007
+		};
+		return ops[rand_range(ARRAY_LENGTH(ops))] | (DEST_REG() << 8) | (SOURCE_REG() << 4);
+	}
+
+	/* single-register shifts, dt, movt, cmp/pz, cmp/pl and the register forms of sts/stc/lds/ldc */
+	else if (kind < 55)
+	{
+		static const UINT16 dest_ops[] =
+		{
+			0x4000,0x4001,0x4004,0x4005,0x4008,0x4009,0x4010,0x4018,0x4019,0x4020,0x4021,0x4024,0x4025,0x4028,0x4029,
+			0x0029,0x0002,0x0012,0x0022,0x000a,0x001a,0x002a
+		};
+		static const UINT16 source_ops[] = { 0x4011,0x4015,0x400a,0x401a,0x402a,0x400e };
+
+		if (rand_range(4))
+			return dest_ops[rand_range(ARRAY_LENGTH(dest_ops))] | (DEST_REG() << 8);
+		return source_ops[rand_range(ARRAY_LENGTH(source_ops))] | (SOURCE_REG() << 8);
+	}
+
+	/* no-operand ops: clrt, sett, clrmac, nop, div0u */
+	else if (kind < 58)
+	{
+		static const UINT16 ops[] = { 0x0008,0x0018,0x0028,0x0009,0x0019 };
+		return ops[rand_range(ARRAY_LENGTH(ops))];
+	}
+
+	/* mov #imm, add #imm, and the immediate forms that work on r0 */
+	else if (kind < 68)
+	{
+		switch (rand_range(3))
+		{
+			case 0:		return 0xe000 | (DEST_REG() << 8) | rand_range(0x100);
+			case 1:		return 0x7000 | (DEST_REG() << 8) | rand_range(0x100);
+			default:																	/* cmp/eq, tst, and, xor, or #imm,r0 */
+			{
+				static const UINT16 ops[] = { 0x8800,0xc800,0xc900,0xca00,0xcb00 };
+				return ops[rand_range(ARRAY_LENGTH(ops))] | rand_range(0x100);
+			}
+		}
+	}
+
+	/* loads and stores through the pointer registers */
+	else if (kind < 88)
+	{
+		int ptr = POINTER_REG(), src;
+
+		do src = SOURCE_REG(); while (src == ptr);
+		switch (rand_range(8))
+		{
+			case 0:		return 0x2000 | (ptr << 8) | (src << 4) | rand_range(3);				/* mov.x Rm,@Rn */
+			case 1:		return 0x2004 | (ptr << 8) | (src << 4) | rand_range(3);				/* mov.x Rm,@-Rn */
+			case 2:		return 0x6000 | (DEST_REG() << 8) | (ptr << 4) | rand_range(3);			/* mov.x @Rm,Rn */
+			case 3:		return 0x6004 | (DEST_REG() << 8) | (ptr << 4) | rand_range(3);			/* mov.x @Rm+,Rn */
+			case 4:		return 0x1000 | (ptr << 8) | (src << 4) | rand_range(16);				/* mov.l Rm,@(disp,Rn) */
+			case 5:		return 0x5000 | (DEST_REG() << 8) | (ptr << 4) | rand_range(16);		/* mov.l @(disp,Rm),Rn */
+			case 6:		return 0x8000 | (rand_range(2) << 8) | (ptr << 4) | rand_range(16);		/* mov.b/w r0,@(disp,Rn) */
+			default:	return 0x8400 | (rand_range(2) << 8) | (ptr << 4) | rand_range(16);		/* mov.b/w @(disp,Rm),r0 */
+		}
+	}
+
+	/* tas.b, mac.w, mac.l, and the memory forms of sts/stc/lds/ldc sr */
+	else if (kind < 94)
+	{
+		int ptr = POINTER_REG();
+
+		switch (rand_range(5))
+		{
+			case 0:		return 0x401b | (ptr << 8);												/* tas.b @Rn */
+			case 1:		return 0x400f | (ptr << 8) | (POINTER_REG() << 4);						/* mac.w @Rm+,@Rn+ */
+			case 2:		return 0x000f | (ptr << 8) | (POINTER_REG() << 4);						/* mac.l @Rm+,@Rn+ */
+			case 3:																				/* sts.l/stc.l x,@-Rn */
+			{
+				static const UINT16 ops[] = { 0x4002,0x4012,0x4022,0x4003,0x4013,0x4023 };
+				return ops[rand_range(ARRAY_LENGTH(ops))] | (ptr << 8);
+			}
+			default:																			/* lds.l/ldc.l @Rm+,x */
+			{
+				static const UINT16 ops[] = { 0x4006,0x4016,0x4026,0x4007 };
+				return ops[rand_range(ARRAY_LENGTH(ops))] | (ptr << 8);
+			}
+		}
+	}
+
+	/* gbr-relative loads and stores of r0 */
+	else
+		return 0xc000 | (rand_range(2) ? 0x0000 : 0x0400) | (rand_range(3) << 8) | rand_range(0x100);
+}
+
+
+/*-------------------------------------------------
+    emit_plain_op - append a random plain
+    instruction and mark it as replaceable
+-------------------------------------------------*/
+
+static void emit_plain_op(void)
+{
+	emit(random_plain_op());
+	plain[codeindex - 1] = TRUE;
+}
+
+
+/*-------------------------------------------------
+    add_pending - remember a branch whose target
+    is the start of a unit a few units ahead
+-------------------------------------------------*/
+
+static void add_pending(int fixup, int type, offs_t pc)
+{
+	pending_branch *branch = &pending[pending_count++];
+
+	branch->fixup = fixup;
+	branch->type = type;
+	branch->pc = pc;
+	branch->units = rand_range(6);
+}
+
+
+/*-------------------------------------------------
+    begin_unit - resolve the branches that land
+    on the unit about to be emitted; branches
+    only ever land on the first instruction of a
+    unit, never inside a pair or in a delay slot
+-------------------------------------------------*/
+
+static void begin_unit(void)
+{
+	int index, landing = FALSE, aligned = FALSE;
+
+	for (index = 0; index < pending_count; index++)
+		if (pending[index].units == 0)
+		{
+			landing = TRUE;
+			if (pending[index].type == FIX_MOVA)
+				aligned = TRUE;
+		}
+	if (!landing)
+	{
+		for (index = 0; index < pending_count; index++)
+			pending[index].units--;
+		return;
+	}
+
+	/* jumps through mova need a long-aligned target */
+	if (aligned && (PC_NOW & 2))
+		emit_plain_op();
+
+	for (index = 0; index < pending_count; )
+	{
+		pending_branch *branch = &pending[index];
+
+		if (branch->units == 0)
+		{
+			offs_t address = CODE_BASE + branch->fixup * 2;
+			UINT16 op = program_read_word_32be(address);
+			INT32 disp = PC_NOW - branch->pc;
+
+			switch (branch->type)
+			{
+				case FIX_DISP8:		op = (op & 0xff00) | ((disp / 2) & 0xff);		break;
+				case FIX_DISP12:	op = (op & 0xf000) | ((disp / 2) & 0xfff);		break;
+				case FIX_MOVIMM:	op = (op & 0xff00) | (disp & 0xff);				break;
+				case FIX_MOVA:		op = (op & 0xff00) | ((disp / 4) & 0xff);		break;
+			}
+			program_write_word_32be(address, op);
+			*branch = pending[--pending_count];
+		}
+		else
+		{
+			branch->units--;
+			index++;
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    emit_random_unit - append one random
+    instruction, or a short group that sets up
+    R0 or a jump target and then uses it
+-------------------------------------------------*/
+
+static void emit_random_unit(void)
+{
+	int kind = rand_range(100);
+	int reg;
+
+	begin_unit();
+
+	/* plain instructions */
+	if (kind < 60 || pending_count >= MAX_PENDING - 1)
+		emit_plain_op();
+
+	/* r0-indexed loads and stores, and the read-modify-write gbr ops */
+	else if (kind < 70)
+	{
+		emit(0xe000 | rand_range(0x100));												/* mov #imm,r0 */
+		switch (rand_range(3))
+		{
+			case 0:		emit(0x0004 | (POINTER_REG() << 8) | (SOURCE_REG() << 4) | rand_range(3));		break;	/* mov.x Rm,@(r0,Rn) */
+			case 1:		emit(0x000c | (DEST_REG() << 8) | (POINTER_REG() << 4) | rand_range(3));		break;	/* mov.x @(r0,Rm),Rn */
+			default:	emit(0xcc00 | (rand_range(4) << 8) | rand_range(0x100));						break;	/* tst/and/xor/or.b #imm,@(r0,gbr) */
+		}
+	}
+
+	/* pc-relative loads; never in a delay slot */
+	else if (kind < 74)
+	{
+		switch (rand_range(3))
+		{
+			case 0:		emit(0xc700 | rand_range(0x100));								break;	/* mova @(disp,pc),r0 */
+			case 1:		emit(0x9000 | (DEST_REG() << 8) | rand_range(0x100));			break;	/* mov.w @(disp,pc),Rn */
+			default:	emit(0xd000 | (DEST_REG() << 8) | rand_range(0x100));			break;	/* mov.l @(disp,pc),Rn */
+		}
+	}
+
+	/* conditional branches, with and without a delay slot */
+	else if (kind < 84)
+	{
+		static const UINT16 ops[] = { 0x8900,0x8b00,0x8d00,0x8f00 };
+		UINT16 op = ops[rand_range(ARRAY_LENGTH(ops))];
+
+		add_pending(codeindex, FIX_DISP8, PC_NOW + 4);
+		emit(op);
+		if (op & 0x0400)
+			emit_plain_op();
+	}
+
+	/* bra and bsr */
+	else if (kind < 88)
+	{
+		add_pending(codeindex, FIX_DISP12, PC_NOW + 4);
+		emit(rand_range(2) ? 0xa000 : 0xb000);
+		emit_plain_op();
+	}
+
+	/* braf and bsrf, with the offset loaded just before */
+	else if (kind < 92)
+	{
+		reg = DEST_REG();
+		add_pending(codeindex, FIX_MOVIMM, PC_NOW + 2 + 4);
+		emit(0xe000 | (reg << 8));														/* mov #imm,Rk */
+		emit((rand_range(2) ? 0x0023 : 0x0003) | (reg << 8));							/* braf/bsrf Rk */
+		emit_plain_op();
+	}
+
+	/* jmp, jsr and rts, with the target loaded through mova */
+	else if (kind < 97)
+	{
+		add_pending(codeindex, FIX_MOVA, (PC_NOW & ~3) + 4);
+		emit(0xc700);																	/* mova @(disp,pc),r0 */
+		switch (rand_range(3))
+		{
+			case 0:		emit(0x402b);										break;		/* jmp @r0 */
+			case 1:		emit(0x400b);										break;		/* jsr @r0 */
+			default:	emit(0x402a);	emit(0x000b);						break;		/* lds r0,pr; rts */
+		}
+		emit_plain_op();
+	}
+
+	/* traps to a handler that just returns */
+	else
+		emit(0xc300 | (32 + rand_range(32)));											/* trapa #imm */
+}
+
+
+/*-------------------------------------------------
+    generate_program - build a program out of
+    random units which ends in a sleep
+-------------------------------------------------*/
+
+static offs_t generate_program(int count)
+{
+	offs_t endpc;
+	int unitnum;
+
+	codeindex = 0;
+	pending_count = 0;
+	for (unitnum = 0; unitnum < count; unitnum++)
+		emit_random_unit();
+
+	/* nops until every branch has landed, then sleep, which loops in place */
+	while (pending_count > 0)
+	{
+		begin_unit();
+		if (pending_count > 0)
+			emit_plain_op();
+	}
+	endpc = PC_NOW;
+	emit(0x001b);																		/* sleep */
+	return endpc;
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+int CLIB_DECL main(int argc, char *argv[])
+{
+	int list = FALSE, count = DEFAULT_COUNT;
+	void (*set_info)(UINT32 state, cpuinfo *info);
+	int argnum, regnum, pass, slice, offset;
+	int patch_word[PASSES];
+	UINT16 patch_op[PASSES];
+	offs_t endpc;
+	cpuinfo info;
+
+	/* parse the command line */
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage:\n  sh2cmp <seed> [-count <n>] [-list]\n");
+		return 1;
+	}
+	rand_seed = atoi(argv[1]) * 7919 + 1;
+	for (argnum = 2; argnum < argc; argnum++)
+	{
+		if (strcmp(argv[argnum], "-list") == 0)
+			list = TRUE;
+		else if (strcmp(argv[argnum], "-count") == 0 && argnum + 1 < argc)
+			count = atoi(argv[++argnum]);
+		else
+			fatalerror("Unknown option %s", argv[argnum]);
+	}
+
+	/* set up the memory the cores see */
+	ram = malloc_or_die(RAM_SIZE);
+	opcode_base = opcode_arg_base = ram;
+	opcode_mask = RAM_SIZE - 1;
+	active_address_space[ADDRESS_SPACE_PROGRAM].addrmask = 0xffffffff;
+	active_address_space[ADDRESS_SPACE_PROGRAM].readlookup = malloc_or_die(1 << LEVEL1_BITS);
+
+	/* reset vectors, trap vectors, and a trap handler that just returns */
+	program_write_dword_32be(0, CODE_BASE);
+	program_write_dword_32be(4, STACK_TOP);
+	for (offset = 32; offset < 64; offset++)
+		program_write_dword_32be(VECTOR_BASE + offset * 4, TRAP_HANDLER);
+	program_write_word_32be(TRAP_HANDLER + 0, 0x002b);									/* rte */
+	program_write_word_32be(TRAP_HANDLER + 2, 0x0009);									/* nop */
+
+	/* the program, and random data for it to work on */
+	endpc = generate_program(count);
+	for (offset = 0; offset < DATA_SIZE; offset++)
+		ram[DATA_BASE + offset] = rand_range(0x100);
+
+	/* list it if asked, to help track down a mismatch */
+	if (list)
+		for (offset = 0; offset < codeindex; offset++)
+		{
+			char buffer[256];
+			UINT16 op = program_read_word_32be(CODE_BASE + offset * 2);
+			DasmSH2(buffer, CODE_BASE + offset * 2, op);
+			printf("%08X: %04X  %s\n", CODE_BASE + offset * 2, op, buffer);
+		}
+
+	/* start the core, with random values in everything but the pointer registers */
+	sh2_get_info(CPUINFO_PTR_SET_INFO, &info);
+	set_info = info.setinfo;
+	sh2_get_info(CPUINFO_PTR_INIT, &info);
+	(*info.init)(0, 28000000, NULL, NULL);
+	sh2_get_info(CPUINFO_PTR_RESET, &info);
+	(*info.reset)();
+	for (regnum = SH2_R0; regnum <= SH2_R14; regnum++)
+	{
+		info.i = (regnum >= SH2_R8 && regnum <= SH2_R13) ? DATA_BASE + 0xc00 + (regnum - SH2_R8) * 0x100 : (rand_range(0x10000) << 16) | rand_range(0x10000);
+		(*set_info)(CPUINFO_INT_REGISTER + regnum, &info);
+	}
+	info.i = 0x3f3 & rand_range(0x10000);	(*set_info)(CPUINFO_INT_REGISTER + SH2_SR, &info);
+	info.i = GBR_BASE;						(*set_info)(CPUINFO_INT_REGISTER + SH2_GBR, &info);
+	info.i = VECTOR_BASE;					(*set_info)(CPUINFO_INT_REGISTER + SH2_VBR, &info);
+	info.i = rand_range(0x10000);			(*set_info)(CPUINFO_INT_REGISTER + SH2_MACH, &info);
+	info.i = rand_range(0x10000) << 16;		(*set_info)(CPUINFO_INT_REGISTER + SH2_MACL, &info);
+
+	/* pick the instructions to swap between passes now, since how many slices */
+	/* each pass takes, and so how many random numbers they use, depends on the core */
+	for (pass = 1; pass < PASSES; pass++)
+	{
+		do patch_word[pass] = rand_range(codeindex); while (!plain[patch_word[pass]]);
+		patch_op[pass] = random_plain_op();
+	}
+
+	/* run each pass in random slices until the program reaches its sleep */
+	sh2_get_info(CPUINFO_PTR_EXECUTE, &info);
+	for (pass = 0; pass < PASSES; pass++)
+	{
+		cpuinfo pc;
+
+		/* from the second pass on, swap an instruction behind the core's back first */
+		if (pass > 0)
+		{
+			program_write_word_32be(CODE_BASE + patch_word[pass] * 2, patch_op[pass]);
+			sh2_notify_code_write(CODE_BASE + patch_word[pass] * 2);
+
+			pc.i = CODE_BASE;
+			(*set_info)(CPUINFO_INT_PC, &pc);
+		}
+
+		for (slice = 0; slice < 1000; slice++)
+		{
+			total_cycles += (*info.execute)(1 + rand_range(500));
+			sh2_get_info(CPUINFO_INT_PC, &pc);
+			if (pc.i == endpc)
+				break;
+		}
+		if (slice == 1000)
+			printf("pass %d did not finish\n", pass);
+	}
+
+	/* dump the state; cycle counts aren't compared */
+	for (regnum = SH2_PC; regnum <= SH2_R15; regnum++)
+	{
+		sh2_get_info(CPUINFO_INT_REGISTER + regnum, &info);
+		printf("%-3d %08X\n", regnum, (UINT32)info.i);
+	}
+	for (offset = 0; offset < DATA_SIZE; offset += 16)
+		printf("%04X %08X %08X %08X %08X\n", offset,
+				*(UINT32 *)&ram[DATA_BASE + offset + 0], *(UINT32 *)&ram[DATA_BASE + offset + 4],
+				*(UINT32 *)&ram[DATA_BASE + offset + 8], *(UINT32 *)&ram[DATA_BASE + offset + 12]);
+	return 0;
+}
@@ -0,0 +1,40 @@
+# Builds sh2cmp twice, once with the interpreter and once with the
+# recompiler, and compares their results on random programs.  Run from
+# this directory with "make -f sh2cmp.mak [PTR64=1]"; SEEDS sets how
+# many programs are tried.
+
+SRC = ../../..
+SEEDS = 2000
+
+CC = gcc
+CFLAGS = -O1 -std=gnu89 -DINLINE="static __inline__" -DCRLF=2 -DLSB_FIRST -DHAS_SH2=1 \
+	-I$(SRC)/emu -I$(SRC)/emu/cpu -I$(SRC)/lib/util -I$(SRC)/osd
+
+ifdef PTR64
+CFLAGS += -DPTR64
+DRCSRC = $(SRC)/emu/cpu/x64drc.c
+else
+DRCSRC = $(SRC)/emu/cpu/x86drc.c
+endif
+
+check: sh2cmp_int sh2cmp_drc
+	@fail=0; \
+	seed=1; \
+	while [ $$seed -le $(SEEDS) ]; do \
+		if ! ./sh2cmp_int $$seed > sh2cmp_int.txt || \
+		   ! ./sh2cmp_drc $$seed > sh2cmp_drc.txt || \
+		   ! cmp -s sh2cmp_int.txt sh2cmp_drc.txt; then echo "seed $$seed differs"; fail=$$((fail + 1)); fi; \
+		seed=$$((seed + 1)); \
+	done; \
+	rm -f sh2cmp_int.txt sh2cmp_drc.txt; \
+	echo "$$fail mismatches"; \
+	[ $$fail -eq 0 ]
+
+sh2cmp_int: sh2cmp.c sh2.c sh2dasm.c sh2.h
+	$(CC) $(CFLAGS) sh2cmp.c sh2.c sh2dasm.c -lm -o $@
+
+sh2cmp_drc: sh2cmp.c sh2drc.c sh2.c sh2dasm.c sh2.h $(DRCSRC) $(SRC)/emu/cpu/x86emit.h
+	$(CC) $(CFLAGS) sh2cmp.c sh2drc.c sh2dasm.c $(DRCSRC) -lm -o $@
+
+clean:
+	rm -f sh2cmp_int sh2cmp_drc
@@ -0,0 +1,1277 @@
+/***************************************************************************
+
+    sh2drc.c
+    x86 Dynamic recompiler for the Hitachi SH-2 emulator.
+
+    This is built on top of the interpreter in sh2.c, which is included
+    below with SH2_DRC defined. The common integer, load/store and branch
+    opcodes are translated directly; everything else (the divide step,
+    MAC, TAS, the read-modify-write GBR ops, SR loads, TRAPA, SLEEP, RTE)
+    is handed back to the interpreter one opcode at a time, so that both
+    cores share a single definition of the awkward cases.
+
+    Cycle counts and the observable PC during memory accesses match the
+    interpreter. Branches are compiled together with their delay slot.
+
+    Self-modifying code: every 4k page that has been compiled is flagged
+    in a bitmap shared by all SH-2s. Writes made by the SH-2s themselves
+    (including their on-chip DMA) to a flagged page bump a generation
+    count, which forces every SH-2 to flush its cache before running any
+    more compiled code. Other devices that write RAM the SH-2s run code
+    from must report it through sh2_notify_code_write(); the ST-V work
+    RAM handlers do this for the SCU DMA. sh2cmp.c and sh2cmp.mak check
+    the recompiler against the interpreter, including that path.
+
+***************************************************************************/
+
+#define SH2_DRC
+
+#include "sh2.c"
+
+
+
+/***************************************************************************
+    CONFIGURATION
+***************************************************************************/
+
+#define MAX_INSTRUCTIONS	512
+#define CACHE_SIZE			(8 * 1024 * 1024)
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* recompiler flags */
+#define RECOMPILE_SUCCESSFUL			0x0001
+#define RECOMPILE_SUCCESSFUL_CP(c,p)	(RECOMPILE_SUCCESSFUL | (((c) & 0xff) << 16) | (((p) & 0xff) << 24))
+#define RECOMPILE_END_OF_STRING			0x0002
+#define RECOMPILE_CHECK_IRQ				0x0004
+#define RECOMPILE_CHECK_SELFMOD			0x0008
+
+/* anything that calls out to memory handlers or the interpreter needs both checks */
+#define RECOMPILE_CALLED_OUT			(RECOMPILE_CHECK_IRQ | RECOMPILE_CHECK_SELFMOD)
+
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define REGADDR(n)			MABS(&sh2.r[n])
+#define SRADDR				MABS(&sh2.sr)
+
+#define RESULT_CYCLES(r)	(((r) >> 16) & 0xff)
+#define RESULT_FLAGS(r)		((r) & (RECOMPILE_CHECK_IRQ | RECOMPILE_CHECK_SELFMOD))
+
+#define SIMM8				((INT32)(INT8)opcode)
+#define UIMM8				(opcode & 0xff)
+#define DISP4				(opcode & 0x0f)
+#define DISP12				(((INT32)opcode << 20) >> 20)
+
+
+
+/***************************************************************************
+    STRUCTURES & TYPEDEFS
+***************************************************************************/
+
+/* per-instruction compile state */
+typedef struct _compile_state compile_state;
+struct _compile_state
+{
+	UINT32		pc;					/* address of the instruction */
+	UINT32		ipc;				/* value the interpreter holds in sh2.pc while executing it */
+	UINT8		ipc_dynamic;		/* if set, ipc is only known at runtime and lives in sh2drc_target */
+	UINT8		delay_slot;			/* set if the instruction sits in a delay slot */
+};
+
+
+
+/***************************************************************************
+    PRIVATE GLOBAL VARIABLES
+***************************************************************************/
+
+/* runtime target of the branch whose delay slot is executing */
+static UINT32 sh2drc_target;
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+static void sh2drc_reset(drc_core *drc);
+static void sh2drc_recompile(drc_core *drc);
+static UINT32 compile_one(drc_core *drc, UINT32 pc);
+static UINT32 recompile_instruction(drc_core *drc, const compile_state *cs, UINT16 opcode);
+static void append_check_selfmod(drc_core *drc);
+
+
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    sh2drc_init - allocate a cache for the SH-2
+    that is currently being initialized
+-------------------------------------------------*/
+
+static void sh2drc_init(void)
+{
+	drc_config drconfig;
+
+	/* fill in the config */
+	memset(&drconfig, 0, sizeof(drconfig));
+	drconfig.cache_size       = CACHE_SIZE;
+	drconfig.max_instructions = MAX_INSTRUCTIONS;
+	drconfig.address_bits     = 32;
+	drconfig.lsbs_to_ignore   = 1;
+	drconfig.uses_fp          = 0;
+	drconfig.uses_sse         = 0;
+	drconfig.pc_in_memory     = 0;
+	drconfig.icount_in_memory = 0;
+	drconfig.pcptr            = (UINT32 *)&sh2.pc;
+	drconfig.icountptr        = (UINT32 *)&sh2_icount;
+	drconfig.esiptr           = NULL;
+	drconfig.cb_reset         = sh2drc_reset;
+	drconfig.cb_recompile     = sh2drc_recompile;
+	drconfig.cb_entrygen      = NULL;
+
+	/* initialize the compiler */
+	sh2.drc = drc_init(cpu_getactivecpu(), &drconfig);
+}
+
+
+/*-------------------------------------------------
+    sh2drc_exit - release the cache
+-------------------------------------------------*/
+
+static void sh2drc_exit(void)
+{
+	drc_exit(sh2.drc);
+}
+
+
+/*-------------------------------------------------
+    sh2drc_execute - run compiled code for the
+    given number of cycles
+-------------------------------------------------*/
+
+static int sh2drc_execute(int cycles)
+{
+	sh2_icount = cycles;
+
+	if (sh2.cpu_off)
+		return 0;
+
+	/* flush if anyone overwrote compiled code since we last ran */
+	if (sh2.drc_generation != sh2drc_code_generation)
+		drc_cache_reset(sh2.drc);
+
+	/* take interrupts that were raised while we were not running */
+	if (sh2.test_irq && !sh2.delay)
+	{
+		CHECK_PENDING_IRQ("sh2drc_execute");
+		sh2.test_irq = 0;
+	}
+
+	drc_execute(sh2.drc);
+	return cycles - sh2_icount;
+}
+
+
+
+/***************************************************************************
+    HELPERS CALLED FROM GENERATED CODE
+***************************************************************************/
+
+/*-------------------------------------------------
+    sh2drc_code_modified - called when a write
+    hits a page holding compiled code
+-------------------------------------------------*/
+
+static void sh2drc_code_modified(void)
+{
+	/* every SH-2 flushes before running again, so start the tracking afresh */
+	memset(sh2drc_code_pages, 0, sizeof(sh2drc_code_pages));
+	sh2drc_code_generation++;
+}
+
+
+/*-------------------------------------------------
+    memory accessors; loads are returned sign-
+    extended, as every SH-2 load wants them
+-------------------------------------------------*/
+
+static UINT32 sh2drc_read8(UINT32 address)
+{
+	return (INT32)(INT8)RB(address);
+}
+
+static UINT32 sh2drc_read16(UINT32 address)
+{
+	return (INT32)(INT16)RW(address);
+}
+
+static UINT32 sh2drc_read32(UINT32 address)
+{
+	return RL(address);
+}
+
+static void sh2drc_write8(UINT32 address, UINT32 data)
+{
+	WB(address, data);
+}
+
+static void sh2drc_write16(UINT32 address, UINT32 data)
+{
+	WW(address, data);
+}
+
+static void sh2drc_write32(UINT32 address, UINT32 data)
+{
+	WL(address, data);
+}
+
+
+/*-------------------------------------------------
+    sh2drc_execute_one - run a single opcode
+    through the interpreter
+-------------------------------------------------*/
+
+static void sh2drc_execute_one(UINT32 opcode)
+{
+	switch (opcode & (15 << 12))
+	{
+	case  0<<12: op0000(opcode); break;
+	case  1<<12: op0001(opcode); break;
+	case  2<<12: op0010(opcode); break;
+	case  3<<12: op0011(opcode); break;
+	case  4<<12: op0100(opcode); break;
+	case  5<<12: op0101(opcode); break;
+	case  6<<12: op0110(opcode); break;
+	case  7<<12: op0111(opcode); break;
+	case  8<<12: op1000(opcode); break;
+	case  9<<12: op1001(opcode); break;
+	case 10<<12: op1010(opcode); break;
+	case 11<<12: op1011(opcode); break;
+	case 12<<12: op1100(opcode); break;
+	case 13<<12: op1101(opcode); break;
+	case 14<<12: op1110(opcode); break;
+	default: op1111(opcode); break;
+	}
+}
+
+
+/*-------------------------------------------------
+    sh2drc_check_irq - take any pending interrupt
+-------------------------------------------------*/
+
+static void sh2drc_check_irq(void)
+{
+	CHECK_PENDING_IRQ("sh2drc_check_irq");
+	sh2.test_irq = 0;
+}
+
+
+
+/***************************************************************************
+    RECOMPILER CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    sh2drc_reset - generate the common stubs
+    after the cache has been flushed
+-------------------------------------------------*/
+
+static void sh2drc_reset(drc_core *drc)
+{
+	/* the cache is now empty, so nothing in it can be stale */
+	sh2.drc_generation = sh2drc_code_generation;
+
+	/* jumped to with EDI pointing at the next instruction when test_irq is set */
+	sh2.check_irq = drc->cache_top;
+	drc_append_save_volatiles(drc);
+	drc_append_call_c(drc, (x86code *)sh2drc_check_irq, "");
+	drc_append_restore_volatiles(drc);
+	append_check_selfmod(drc);
+	drc_append_dispatcher(drc);
+}
+
+
+/*-------------------------------------------------
+    sh2drc_recompile - compile a sequence starting
+    at the current PC
+-------------------------------------------------*/
+
+static void sh2drc_recompile(drc_core *drc)
+{
+	int remaining = MAX_INSTRUCTIONS;
+	UINT32 pc = sh2.pc;
+
+	/* begin the sequence */
+	drc_begin_sequence(drc, pc);
+
+	/* loop until we hit an unconditional branch */
+	while (--remaining != 0)
+	{
+		UINT32 result;
+
+		/* compile one instruction */
+		result = compile_one(drc, pc);
+		pc += (INT8)(result >> 24);
+		if (result & RECOMPILE_END_OF_STRING)
+			break;
+	}
+
+	/* add dispatcher just in case */
+	if (remaining == 0)
+		drc_append_dispatcher(drc);
+
+	/* end the sequence */
+	drc_end_sequence(drc);
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION HELPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    fetch_opcode - read an opcode for compilation
+    and flag its page as holding code
+-------------------------------------------------*/
+
+static UINT16 fetch_opcode(UINT32 pc)
+{
+	UINT32 page = SH2DRC_PAGE(pc & AM);
+
+	sh2drc_code_pages[page >> 3] |= 1 << (page & 7);
+	change_pc(pc & AM);
+	return cpu_readop16(WORD_XOR_BE((UINT32)(pc & AM)));
+}
+
+
+/*-------------------------------------------------
+    is_branch_opcode - true for anything that
+    cannot live in a delay slot
+-------------------------------------------------*/
+
+static int is_branch_opcode(UINT16 opcode)
+{
+	switch (opcode >> 12)
+	{
+		case 0:
+			switch (opcode & 0x3f)
+			{
+				case 0x03:	/* BSRF */
+				case 0x0b:	/* RTS */
+				case 0x1b:	/* SLEEP */
+				case 0x23:	/* BRAF */
+				case 0x2b:	/* RTE */
+					return TRUE;
+			}
+			return FALSE;
+
+		case 4:
+			return ((opcode & 0x3f) == 0x0b || (opcode & 0x3f) == 0x2b);	/* JSR, JMP */
+
+		case 8:
+			return (opcode & 0x0900) == 0x0900;	/* BT, BF, BTS, BFS */
+
+		case 10:
+		case 11:
+			return TRUE;					/* BRA, BSR */
+
+		case 12:
+			return ((opcode >> 8) & 15) == 3;	/* TRAPA */
+	}
+	return FALSE;
+}
+
+
+/*-------------------------------------------------
+    append_set_t - set the T bit from an x86
+    condition
+-------------------------------------------------*/
+
+static void append_set_t(drc_core *drc, UINT8 cond)
+{
+	emit_setcc_r8(DRCTOP, cond, REG_AL);											// setcc al
+	emit_and_m32_imm(DRCTOP, SRADDR, ~T);											// and  [sr],~T
+	emit_movzx_r32_r8(DRCTOP, REG_EAX, REG_AL);										// movzx eax,al
+	emit_or_m32_r32(DRCTOP, SRADDR, REG_EAX);										// or   [sr],eax
+}
+
+
+/*-------------------------------------------------
+    append_set_interp_pc - store the PC the
+    interpreter would expose before calling out
+-------------------------------------------------*/
+
+static void append_set_interp_pc(drc_core *drc, const compile_state *cs)
+{
+	if (cs->ipc_dynamic)
+	{
+		emit_mov_r32_m32(DRCTOP, REG_ECX, MABS(&sh2drc_target));					// mov  ecx,[sh2drc_target]
+		emit_mov_m32_r32(DRCTOP, MABS(&sh2.pc), REG_ECX);							// mov  [sh2.pc],ecx
+		emit_mov_m32_r32(DRCTOP, MABS(&sh2.ppc), REG_ECX);							// mov  [sh2.ppc],ecx
+	}
+	else
+	{
+		emit_mov_m32_imm(DRCTOP, MABS(&sh2.pc), cs->ipc);							// mov  [sh2.pc],ipc
+		emit_mov_m32_imm(DRCTOP, MABS(&sh2.ppc), cs->ipc);							// mov  [sh2.ppc],ipc
+	}
+}
+
+
+/*-------------------------------------------------
+    append_read - read from the address in EAX;
+    the sign-extended result is left in EAX
+-------------------------------------------------*/
+
+static void append_read(drc_core *drc, const compile_state *cs, int size)
+{
+	x86code *handler = (size == 1) ? (x86code *)sh2drc_read8 : (size == 2) ? (x86code *)sh2drc_read16 : (x86code *)sh2drc_read32;
+
+	emit_mov_m32_r32(DRCTOP, MABS(&sh2_icount), REG_EBP);							// mov  [icount],ebp
+	emit_push_r32(DRCTOP, REG_EAX);													// push eax
+	append_set_interp_pc(drc, cs);
+	drc_append_call_c(drc, handler, "i");											// call handler
+	emit_stack_free(DRCTOP, 4);														// add  esp,4
+	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&sh2_icount));							// mov  ebp,[icount]
+}
+
+
+/*-------------------------------------------------
+    append_write - write ECX to the address in
+    EAX
+-------------------------------------------------*/
+
+static void append_write(drc_core *drc, const compile_state *cs, int size)
+{
+	x86code *handler = (size == 1) ? (x86code *)sh2drc_write8 : (size == 2) ? (x86code *)sh2drc_write16 : (x86code *)sh2drc_write32;
+
+	emit_mov_m32_r32(DRCTOP, MABS(&sh2_icount), REG_EBP);							// mov  [icount],ebp
+	emit_push_r32(DRCTOP, REG_ECX);													// push ecx
+	emit_push_r32(DRCTOP, REG_EAX);													// push eax
+	append_set_interp_pc(drc, cs);
+	drc_append_call_c(drc, handler, "ii");											// call handler
+	emit_stack_free(DRCTOP, 8);														// add  esp,8
+	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&sh2_icount));							// mov  ebp,[icount]
+}
+
+
+/*-------------------------------------------------
+    append_fallback - run one opcode through the
+    interpreter
+-------------------------------------------------*/
+
+static UINT32 append_fallback(drc_core *drc, const compile_state *cs, UINT16 opcode)
+{
+	emit_mov_m32_r32(DRCTOP, MABS(&sh2_icount), REG_EBP);							// mov  [icount],ebp
+	append_set_interp_pc(drc, cs);
+	emit_push_imm(DRCTOP, opcode);													// push opcode
+	drc_append_call_c(drc, (x86code *)sh2drc_execute_one, "i");						// call sh2drc_execute_one
+	emit_stack_free(DRCTOP, 4);														// add  esp,4
+	emit_mov_r32_m32(DRCTOP, REG_EBP, MABS(&sh2_icount));							// mov  ebp,[icount]
+	return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+}
+
+
+/*-------------------------------------------------
+    append_check_selfmod - flush if compiled code
+    has been overwritten
+-------------------------------------------------*/
+
+static void append_check_selfmod(drc_core *drc)
+{
+	emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&sh2drc_code_generation));				// mov  eax,[sh2drc_code_generation]
+	emit_cmp_r32_m32(DRCTOP, REG_EAX, MABS(&sh2.drc_generation));					// cmp  eax,[sh2.drc_generation]
+	emit_jcc(DRCTOP, COND_NE, drc->flush);											// jne  flush
+}
+
+
+/*-------------------------------------------------
+    append_check_results - once EDI holds the
+    next PC, handle whatever the instruction may
+    have triggered
+-------------------------------------------------*/
+
+static void append_check_results(drc_core *drc, UINT32 flags)
+{
+	if (flags & RECOMPILE_CHECK_IRQ)
+	{
+		emit_cmp_m32_imm(DRCTOP, MABS(&sh2.test_irq), 0);							// cmp  [sh2.test_irq],0
+		emit_jcc(DRCTOP, COND_NE, sh2.check_irq);									// jne  check_irq
+	}
+	if (flags & RECOMPILE_CHECK_SELFMOD)
+		append_check_selfmod(drc);
+}
+
+
+/*-------------------------------------------------
+    append_branch_exit - leave a branch once its
+    delay slot has run
+-------------------------------------------------*/
+
+static void append_branch_exit(drc_core *drc, UINT32 target, int dynamic, int cycles, UINT32 flags)
+{
+	if (dynamic)
+		emit_mov_r32_m32(DRCTOP, REG_EDI, MABS(&sh2drc_target));					// mov  edi,[sh2drc_target]
+	else
+		emit_mov_r32_imm(DRCTOP, REG_EDI, target);									// mov  edi,target
+	drc_append_standard_epilogue(drc, cycles, 0, 1);
+	append_check_results(drc, flags);
+
+	if (dynamic)
+		drc_append_dispatcher(drc);
+	else
+	{
+		void *code = drc_get_code_at_pc(drc, target);
+		if (code)
+			emit_jmp(DRCTOP, code);													// jmp  code
+		else
+			drc_append_tentative_fixed_dispatcher(drc, target);
+	}
+}
+
+
+/*-------------------------------------------------
+    recompile_delay_slot - compile the instruction
+    following a delayed branch at pc
+-------------------------------------------------*/
+
+static UINT32 recompile_delay_slot(drc_core *drc, UINT32 pc, UINT32 target, int dynamic)
+{
+	compile_state cs;
+	UINT16 opcode = fetch_opcode(pc + 2);
+
+	cs.pc = pc + 2;
+	cs.ipc = target;
+	cs.ipc_dynamic = dynamic;
+	cs.delay_slot = 1;
+
+	/* branches are illegal in a delay slot; treat them as NOPs */
+	if (is_branch_opcode(opcode))
+		return RECOMPILE_SUCCESSFUL_CP(1,2);
+	return recompile_instruction(drc, &cs, opcode);
+}
+
+
+/*-------------------------------------------------
+    recompile_delayed_branch - compile the delay
+    slot and exit of an unconditional branch; a
+    dynamic target must already be stored in
+    sh2drc_target
+-------------------------------------------------*/
+
+static UINT32 recompile_delayed_branch(drc_core *drc, const compile_state *cs, UINT32 target, int dynamic, int cycles)
+{
+	UINT32 slot = recompile_delay_slot(drc, cs->pc, target, dynamic);
+
+	append_branch_exit(drc, target, dynamic, cycles + RESULT_CYCLES(slot), RESULT_FLAGS(slot));
+	return RECOMPILE_SUCCESSFUL_CP(0,0) | RECOMPILE_END_OF_STRING;
+}
+
+
+/*-------------------------------------------------
+    recompile_conditional_branch - compile BT, BF,
+    BTS and BFS
+-------------------------------------------------*/
+
+static UINT32 recompile_conditional_branch(drc_core *drc, const compile_state *cs, UINT16 opcode, int delayed, int on_true)
+{
+	UINT32 target = cs->ipc + SIMM8 * 2 + 2;
+	emit_link link1;
+
+	emit_test_m32_imm(DRCTOP, SRADDR, T);											// test [sr],T
+	emit_jcc_near_link(DRCTOP, on_true ? COND_Z : COND_NZ, &link1);					// jz/jnz skip
+
+	if (delayed)
+	{
+		UINT32 slot = recompile_delay_slot(drc, cs->pc, target, FALSE);
+		append_branch_exit(drc, target, FALSE, 2 + RESULT_CYCLES(slot), RESULT_FLAGS(slot));
+	}
+	else
+		append_branch_exit(drc, target, FALSE, 3, 0);
+
+	/* not taken: for the delayed forms the slot simply runs as the next instruction */
+	resolve_link(DRCTOP, &link1);															// skip:
+	return RECOMPILE_SUCCESSFUL_CP(1,2);
+}
+
+
+/*-------------------------------------------------
+    recompile_flow_fallback - run TRAPA or SLEEP
+    through the interpreter and dispatch to
+    wherever it left the PC
+-------------------------------------------------*/
+
+static UINT32 recompile_flow_fallback(drc_core *drc, const compile_state *cs, UINT16 opcode)
+{
+	append_fallback(drc, cs, opcode);
+	emit_mov_r32_m32(DRCTOP, REG_EDI, MABS(&sh2.pc));								// mov  edi,[sh2.pc]
+	drc_append_standard_epilogue(drc, 1, 0, 1);
+	append_check_results(drc, RECOMPILE_CALLED_OUT);
+	drc_append_dispatcher(drc);
+	return RECOMPILE_SUCCESSFUL_CP(0,0) | RECOMPILE_END_OF_STRING;
+}
+
+
+
+/***************************************************************************
+    CORE RECOMPILATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    compile_one - compile a single instruction
+    (and the delay slot of a branch)
+-------------------------------------------------*/
+
+static UINT32 compile_one(drc_core *drc, UINT32 pc)
+{
+	compile_state cs;
+	UINT32 result;
+	UINT16 opcode;
+
+	/* register this instruction */
+	drc_register_code_at_cache_top(drc, pc);
+
+	/* emit debugging call */
+	drc_append_call_debugger(drc);
+
+	/* compile the instruction */
+	opcode = fetch_opcode(pc);
+	cs.pc = pc;
+	cs.ipc = pc + 2;
+	cs.ipc_dynamic = 0;
+	cs.delay_slot = 0;
+	result = recompile_instruction(drc, &cs, opcode);
+
+	/* epilogue */
+	drc_append_standard_epilogue(drc, RESULT_CYCLES(result), (INT8)(result >> 24), 1);
+	append_check_results(drc, result);
+	return result;
+}
+
+
+/*-------------------------------------------------
+    recompile_instruction - emit the body of one
+    instruction; returns cycles, PC delta and
+    flags
+-------------------------------------------------*/
+
+static UINT32 recompile_instruction(drc_core *drc, const compile_state *cs, UINT16 opcode)
+{
+	UINT32 m = Rm, n = Rn;
+	emit_link link1, link2;
+
+	switch (opcode >> 12)
+	{
+		case 0:
+			switch (opcode & 0x3f)
+			{
+				case 0x02:	/* STC SR,Rn */
+				case 0x12:	/* STC GBR,Rn */
+				case 0x22:	/* STC VBR,Rn */
+				case 0x0a:	/* STS MACH,Rn */
+				case 0x1a:	/* STS MACL,Rn */
+				case 0x2a:	/* STS PR,Rn */
+				{
+					UINT32 *source;
+					switch (opcode & 0x3f)
+					{
+						case 0x02:	source = &sh2.sr;	break;
+						case 0x12:	source = &sh2.gbr;	break;
+						case 0x22:	source = &sh2.vbr;	break;
+						case 0x0a:	source = &sh2.mach;	break;
+						case 0x1a:	source = &sh2.macl;	break;
+						default:	source = &sh2.pr;	break;
+					}
+					emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(source));						// mov  eax,[source]
+					emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// mov  [rn],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+				}
+
+				case 0x03:	/* BSRF Rm */
+				case 0x23:	/* BRAF Rm */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rm]
+					emit_add_r32_imm(DRCTOP, REG_EAX, cs->pc + 4);							// add  eax,pc+4
+					emit_mov_m32_r32(DRCTOP, MABS(&sh2drc_target), REG_EAX);				// mov  [sh2drc_target],eax
+					if ((opcode & 0x3f) == 0x03)
+						emit_mov_m32_imm(DRCTOP, MABS(&sh2.pr), cs->pc + 4);				// mov  [pr],pc+4
+					return recompile_delayed_branch(drc, cs, 0, TRUE, 2);
+
+				case 0x04: case 0x14: case 0x24: case 0x34:	/* MOV.B Rm,@(R0,Rn) */
+				case 0x05: case 0x15: case 0x25: case 0x35:	/* MOV.W Rm,@(R0,Rn) */
+				case 0x06: case 0x16: case 0x26: case 0x36:	/* MOV.L Rm,@(R0,Rn) */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rn]
+					emit_add_r32_m32(DRCTOP, REG_EAX, REGADDR(0));							// add  eax,[r0]
+					emit_mov_r32_m32(DRCTOP, REG_ECX, REGADDR(m));							// mov  ecx,[rm]
+					append_write(drc, cs, 1 << (opcode & 3));
+					return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+				case 0x07: case 0x17: case 0x27: case 0x37:	/* MUL.L Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rn]
+					emit_imul_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// imul eax,[rm]
+					emit_mov_m32_r32(DRCTOP, MABS(&sh2.macl), REG_EAX);						// mov  [macl],eax
+					return RECOMPILE_SUCCESSFUL_CP(2,2);
+
+				case 0x08:	/* CLRT */
+					emit_and_m32_imm(DRCTOP, SRADDR, ~T);									// and  [sr],~T
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x18:	/* SETT */
+					emit_or_m32_imm(DRCTOP, SRADDR, T);										// or   [sr],T
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x19:	/* DIV0U */
+					emit_and_m32_imm(DRCTOP, SRADDR, ~(M | Q | T));							// and  [sr],~(M|Q|T)
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x28:	/* CLRMAC */
+					emit_mov_m32_imm(DRCTOP, MABS(&sh2.mach), 0);							// mov  [mach],0
+					emit_mov_m32_imm(DRCTOP, MABS(&sh2.macl), 0);							// mov  [macl],0
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x29:	/* MOVT Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, SRADDR);								// mov  eax,[sr]
+					emit_and_r32_imm(DRCTOP, REG_EAX, T);									// and  eax,T
+					emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// mov  [rn],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x0b:	/* RTS */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&sh2.pr));						// mov  eax,[pr]
+					emit_mov_m32_r32(DRCTOP, MABS(&sh2drc_target), REG_EAX);				// mov  [sh2drc_target],eax
+					return recompile_delayed_branch(drc, cs, 0, TRUE, 2);
+
+				case 0x1b:	/* SLEEP */
+					return recompile_flow_fallback(drc, cs, opcode);
+
+				case 0x2b:	/* RTE */
+				{
+					UINT32 slot;
+
+					/* the interpreter pops PC and SR and arms its own delay slot; we run the slot ourselves */
+					append_fallback(drc, cs, opcode);
+					emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&sh2.pc));						// mov  eax,[sh2.pc]
+					emit_mov_m32_r32(DRCTOP, MABS(&sh2drc_target), REG_EAX);				// mov  [sh2drc_target],eax
+					emit_mov_m32_imm(DRCTOP, MABS(&sh2.delay), 0);							// mov  [sh2.delay],0
+					slot = recompile_delay_slot(drc, cs->pc, 0, TRUE);
+					append_branch_exit(drc, 0, TRUE, 1 + RESULT_CYCLES(slot), RECOMPILE_CALLED_OUT);
+					return RECOMPILE_SUCCESSFUL_CP(0,0) | RECOMPILE_END_OF_STRING;
+				}
+
+				case 0x0c: case 0x1c: case 0x2c: case 0x3c:	/* MOV.B @(R0,Rm),Rn */
+				case 0x0d: case 0x1d: case 0x2d: case 0x3d:	/* MOV.W @(R0,Rm),Rn */
+				case 0x0e: case 0x1e: case 0x2e: case 0x3e:	/* MOV.L @(R0,Rm),Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_add_r32_m32(DRCTOP, REG_EAX, REGADDR(0));							// add  eax,[r0]
+					append_read(drc, cs, 1 << (opcode & 3));
+					emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// mov  [rn],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+				case 0x0f: case 0x1f: case 0x2f: case 0x3f:	/* MAC.L @Rm+,@Rn+ */
+					return append_fallback(drc, cs, opcode);
+			}
+			return RECOMPILE_SUCCESSFUL_CP(1,2);	/* NOP and undefined */
+
+		case 1:		/* MOV.L Rm,@(disp4,Rn) */
+			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));									// mov  eax,[rn]
+			emit_add_r32_imm(DRCTOP, REG_EAX, DISP4 * 4);									// add  eax,disp*4
+			emit_mov_r32_m32(DRCTOP, REG_ECX, REGADDR(m));									// mov  ecx,[rm]
+			append_write(drc, cs, 4);
+			return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+		case 2:
+			switch (opcode & 15)
+			{
+				case 0:		/* MOV.B Rm,@Rn */
+				case 1:		/* MOV.W Rm,@Rn */
+				case 2:		/* MOV.L Rm,@Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rn]
+					emit_mov_r32_m32(DRCTOP, REG_ECX, REGADDR(m));							// mov  ecx,[rm]
+					append_write(drc, cs, 1 << (opcode & 3));
+					return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+				case 4:		/* MOV.B Rm,@-Rn */
+				case 5:		/* MOV.W Rm,@-Rn */
+				case 6:		/* MOV.L Rm,@-Rn */
+					emit_mov_r32_m32(DRCTOP, REG_ECX, REGADDR(m));							// mov  ecx,[rm]
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rn]
+					emit_sub_r32_imm(DRCTOP, REG_EAX, 1 << (opcode & 3));					// sub  eax,size
+					emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// mov  [rn],eax
+					append_write(drc, cs, 1 << (opcode & 3));
+					return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+				case 8:		/* TST Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rn]
+					emit_test_m32_r32(DRCTOP, REGADDR(m), REG_EAX);							// test [rm],eax
+					append_set_t(drc, COND_Z);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 9:		/* AND Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_and_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// and  [rn],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 10:	/* XOR Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_xor_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// xor  [rn],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 11:	/* OR Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_or_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// or   [rn],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 13:	/* XTRCT Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rn]
+					emit_mov_r32_m32(DRCTOP, REG_ECX, REGADDR(m));							// mov  ecx,[rm]
+					emit_shrd_r32_r32_imm(DRCTOP, REG_EAX, REG_ECX, 16);					// shrd eax,ecx,16
+					emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// mov  [rn],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 14:	/* MULU.W Rm,Rn */
+				case 15:	/* MULS.W Rm,Rn */
+					if (opcode & 1)
+					{
+						emit_movsx_r32_m16(DRCTOP, REG_EAX, REGADDR(n));					// movsx eax,word [rn]
+						emit_movsx_r32_m16(DRCTOP, REG_ECX, REGADDR(m));					// movsx ecx,word [rm]
+					}
+					else
+					{
+						emit_movzx_r32_m16(DRCTOP, REG_EAX, REGADDR(n));					// movzx eax,word [rn]
+						emit_movzx_r32_m16(DRCTOP, REG_ECX, REGADDR(m));					// movzx ecx,word [rm]
+					}
+					emit_imul_r32_r32(DRCTOP, REG_EAX, REG_ECX);							// imul eax,ecx
+					emit_mov_m32_r32(DRCTOP, MABS(&sh2.macl), REG_EAX);						// mov  [macl],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 7:		/* DIV0S Rm,Rn */
+				case 12:	/* CMP/STR Rm,Rn */
+					return append_fallback(drc, cs, opcode);
+			}
+			return RECOMPILE_SUCCESSFUL_CP(1,2);	/* NOP */
+
+		case 3:
+			switch (opcode & 15)
+			{
+				case 0:		/* CMP/EQ Rm,Rn */
+				case 2:		/* CMP/HS Rm,Rn */
+				case 3:		/* CMP/GE Rm,Rn */
+				case 6:		/* CMP/HI Rm,Rn */
+				case 7:		/* CMP/GT Rm,Rn */
+				{
+					static const UINT8 cond[8] = { COND_E, 0, COND_AE, COND_GE, 0, 0, COND_A, COND_G };
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rn]
+					emit_cmp_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// cmp  eax,[rm]
+					append_set_t(drc, cond[opcode & 7]);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+				}
+
+				case 5:		/* DMULU.L Rm,Rn */
+				case 13:	/* DMULS.L Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rn]
+					if (opcode & 8)
+						emit_imul_m32(DRCTOP, REGADDR(m));									// imul [rm]
+					else
+						emit_mul_m32(DRCTOP, REGADDR(m));									// mul  [rm]
+					emit_mov_m32_r32(DRCTOP, MABS(&sh2.mach), REG_EDX);						// mov  [mach],edx
+					emit_mov_m32_r32(DRCTOP, MABS(&sh2.macl), REG_EAX);						// mov  [macl],eax
+					return RECOMPILE_SUCCESSFUL_CP(2,2);
+
+				case 8:		/* SUB Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_sub_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// sub  [rn],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 10:	/* SUBC Rm,Rn */
+				case 14:	/* ADDC Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rn]
+					emit_bt_m32_imm(DRCTOP, SRADDR, 0);										// bt   [sr],0
+					if (opcode & 4)
+						emit_adc_r32_m32(DRCTOP, REG_EAX, REGADDR(m));						// adc  eax,[rm]
+					else
+						emit_sbb_r32_m32(DRCTOP, REG_EAX, REGADDR(m));						// sbb  eax,[rm]
+					emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// mov  [rn],eax
+					append_set_t(drc, COND_C);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 12:	/* ADD Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_add_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// add  [rn],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 4:		/* DIV1 Rm,Rn */
+				case 11:	/* SUBV Rm,Rn */
+				case 15:	/* ADDV Rm,Rn */
+					return append_fallback(drc, cs, opcode);
+			}
+			return RECOMPILE_SUCCESSFUL_CP(1,2);	/* NOP */
+
+		case 4:
+			switch (opcode & 0x3f)
+			{
+				case 0x00:	/* SHLL Rn */
+				case 0x20:	/* SHAL Rn */
+					emit_shl_m32_imm(DRCTOP, REGADDR(n), 1);								// shl  [rn],1
+					append_set_t(drc, COND_C);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x01:	/* SHLR Rn */
+					emit_shr_m32_imm(DRCTOP, REGADDR(n), 1);								// shr  [rn],1
+					append_set_t(drc, COND_C);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x21:	/* SHAR Rn */
+					emit_sar_m32_imm(DRCTOP, REGADDR(n), 1);								// sar  [rn],1
+					append_set_t(drc, COND_C);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x04:	/* ROTL Rn */
+					emit_rol_m32_imm(DRCTOP, REGADDR(n), 1);								// rol  [rn],1
+					append_set_t(drc, COND_C);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x05:	/* ROTR Rn */
+					emit_ror_m32_imm(DRCTOP, REGADDR(n), 1);								// ror  [rn],1
+					append_set_t(drc, COND_C);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x24:	/* ROTCL Rn */
+					emit_bt_m32_imm(DRCTOP, SRADDR, 0);										// bt   [sr],0
+					emit_rcl_m32_imm(DRCTOP, REGADDR(n), 1);								// rcl  [rn],1
+					append_set_t(drc, COND_C);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x25:	/* ROTCR Rn */
+					emit_bt_m32_imm(DRCTOP, SRADDR, 0);										// bt   [sr],0
+					emit_rcr_m32_imm(DRCTOP, REGADDR(n), 1);								// rcr  [rn],1
+					append_set_t(drc, COND_C);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x08:	/* SHLL2 Rn */
+				case 0x18:	/* SHLL8 Rn */
+				case 0x28:	/* SHLL16 Rn */
+					emit_shl_m32_imm(DRCTOP, REGADDR(n), (opcode & 0x20) ? 16 : (opcode & 0x10) ? 8 : 2);	// shl  [rn],count
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x09:	/* SHLR2 Rn */
+				case 0x19:	/* SHLR8 Rn */
+				case 0x29:	/* SHLR16 Rn */
+					emit_shr_m32_imm(DRCTOP, REGADDR(n), (opcode & 0x20) ? 16 : (opcode & 0x10) ? 8 : 2);	// shr  [rn],count
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x02:	/* STS.L MACH,@-Rn */
+				case 0x12:	/* STS.L MACL,@-Rn */
+				case 0x22:	/* STS.L PR,@-Rn */
+				case 0x03:	/* STC.L SR,@-Rn */
+				case 0x13:	/* STC.L GBR,@-Rn */
+				case 0x23:	/* STC.L VBR,@-Rn */
+				{
+					static UINT32 *const source[6] = { &sh2.mach, &sh2.sr, &sh2.macl, &sh2.gbr, &sh2.pr, &sh2.vbr };
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rn]
+					emit_sub_r32_imm(DRCTOP, REG_EAX, 4);									// sub  eax,4
+					emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// mov  [rn],eax
+					emit_mov_r32_m32(DRCTOP, REG_ECX, MABS(source[((opcode >> 3) & 6) | (opcode & 1)]));	// mov  ecx,[source]
+					append_write(drc, cs, 4);
+					return RECOMPILE_SUCCESSFUL_CP((opcode & 1) ? 2 : 1, 2) | RECOMPILE_CALLED_OUT;
+				}
+
+				case 0x06:	/* LDS.L @Rm+,MACH */
+				case 0x16:	/* LDS.L @Rm+,MACL */
+				case 0x26:	/* LDS.L @Rm+,PR */
+				case 0x17:	/* LDC.L @Rm+,GBR */
+				case 0x27:	/* LDC.L @Rm+,VBR */
+				{
+					static UINT32 *const dest[6] = { &sh2.mach, NULL, &sh2.macl, &sh2.gbr, &sh2.pr, &sh2.vbr };
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rm]
+					append_read(drc, cs, 4);
+					emit_mov_m32_r32(DRCTOP, MABS(dest[((opcode >> 3) & 6) | (opcode & 1)]), REG_EAX);	// mov  [dest],eax
+					emit_add_m32_imm(DRCTOP, REGADDR(n), 4);								// add  [rm],4
+					return RECOMPILE_SUCCESSFUL_CP((opcode & 1) ? 3 : 1, 2) | RECOMPILE_CALLED_OUT;
+				}
+
+				case 0x0a:	/* LDS Rm,MACH */
+				case 0x1a:	/* LDS Rm,MACL */
+				case 0x2a:	/* LDS Rm,PR */
+				case 0x1e:	/* LDC Rm,GBR */
+				case 0x2e:	/* LDC Rm,VBR */
+				{
+					UINT32 *dest;
+					switch (opcode & 0x3f)
+					{
+						case 0x0a:	dest = &sh2.mach;	break;
+						case 0x1a:	dest = &sh2.macl;	break;
+						case 0x2a:	dest = &sh2.pr;		break;
+						case 0x1e:	dest = &sh2.gbr;	break;
+						default:	dest = &sh2.vbr;	break;
+					}
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rm]
+					emit_mov_m32_r32(DRCTOP, MABS(dest), REG_EAX);							// mov  [dest],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+				}
+
+				case 0x0b:	/* JSR @Rm */
+				case 0x2b:	/* JMP @Rm */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(n));							// mov  eax,[rm]
+					emit_mov_m32_r32(DRCTOP, MABS(&sh2drc_target), REG_EAX);				// mov  [sh2drc_target],eax
+					if (!(opcode & 0x20))
+						emit_mov_m32_imm(DRCTOP, MABS(&sh2.pr), cs->pc + 4);				// mov  [pr],pc+4
+					return recompile_delayed_branch(drc, cs, 0, TRUE, (opcode & 0x20) ? 1 : 2);
+
+				case 0x10:	/* DT Rn */
+					emit_sub_m32_imm(DRCTOP, REGADDR(n), 1);								// sub  [rn],1
+					append_set_t(drc, COND_Z);
+#if BUSY_LOOP_HACKS
+					/* DT Rn / BF $-2: burn the loop down the same way the interpreter does */
+					if (!cs->ipc_dynamic && fetch_opcode(cs->ipc) == 0x8bfd)
+					{
+						x86code *loop = drc->cache_top;
+						emit_cmp_m32_imm(DRCTOP, REGADDR(n), 1);							// loop: cmp [rn],1
+						emit_jcc_short_link(DRCTOP, COND_BE, &link1);						// jbe  done
+						emit_cmp_r32_imm(DRCTOP, REG_EBP, 4);								// cmp  ebp,4
+						emit_jcc_short_link(DRCTOP, COND_LE, &link2);						// jle  done
+						emit_sub_m32_imm(DRCTOP, REGADDR(n), 1);							// sub  [rn],1
+						emit_sub_r32_imm(DRCTOP, REG_EBP, 4);								// sub  ebp,4
+						emit_jmp(DRCTOP, loop);												// jmp  loop
+						resolve_link(DRCTOP, &link1);										// done:
+						resolve_link(DRCTOP, &link2);
+					}
+#endif
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x11:	/* CMP/PZ Rn */
+				case 0x15:	/* CMP/PL Rn */
+					emit_cmp_m32_imm(DRCTOP, REGADDR(n), 0);								// cmp  [rn],0
+					append_set_t(drc, (opcode & 4) ? COND_G : COND_GE);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 0x07:	/* LDC.L @Rm+,SR */
+				case 0x0e:	/* LDC Rm,SR */
+				case 0x1b:	/* TAS.B @Rn */
+				case 0x0f: case 0x1f: case 0x2f: case 0x3f:	/* MAC.W @Rm+,@Rn+ */
+					return append_fallback(drc, cs, opcode);
+			}
+			return RECOMPILE_SUCCESSFUL_CP(1,2);	/* NOP */
+
+		case 5:		/* MOV.L @(disp4,Rm),Rn */
+			emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));									// mov  eax,[rm]
+			emit_add_r32_imm(DRCTOP, REG_EAX, DISP4 * 4);									// add  eax,disp*4
+			append_read(drc, cs, 4);
+			emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);									// mov  [rn],eax
+			return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+		case 6:
+			switch (opcode & 15)
+			{
+				case 0:		/* MOV.B @Rm,Rn */
+				case 1:		/* MOV.W @Rm,Rn */
+				case 2:		/* MOV.L @Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					append_read(drc, cs, 1 << (opcode & 3));
+					emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// mov  [rn],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+				case 4:		/* MOV.B @Rm+,Rn */
+				case 5:		/* MOV.W @Rm+,Rn */
+				case 6:		/* MOV.L @Rm+,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					append_read(drc, cs, 1 << (opcode & 3));
+					emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// mov  [rn],eax
+					if (n != m)
+						emit_add_m32_imm(DRCTOP, REGADDR(m), 1 << (opcode & 3));			// add  [rm],size
+					return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+				case 3:		/* MOV Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					break;
+
+				case 7:		/* NOT Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_not_r32(DRCTOP, REG_EAX);											// not  eax
+					break;
+
+				case 8:		/* SWAP.B Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_rol_r16_imm(DRCTOP, REG_AX, 8);									// rol  ax,8
+					break;
+
+				case 9:		/* SWAP.W Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_rol_r32_imm(DRCTOP, REG_EAX, 16);									// rol  eax,16
+					break;
+
+				case 10:	/* NEGC Rm,Rn */
+					emit_mov_r32_imm(DRCTOP, REG_EAX, 0);									// mov  eax,0
+					emit_bt_m32_imm(DRCTOP, SRADDR, 0);										// bt   [sr],0
+					emit_sbb_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// sbb  eax,[rm]
+					emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);							// mov  [rn],eax
+					append_set_t(drc, COND_C);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 11:	/* NEG Rm,Rn */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_neg_r32(DRCTOP, REG_EAX);											// neg  eax
+					break;
+
+				case 12:	/* EXTU.B Rm,Rn */
+					emit_movzx_r32_m8(DRCTOP, REG_EAX, REGADDR(m));							// movzx eax,byte [rm]
+					break;
+
+				case 13:	/* EXTU.W Rm,Rn */
+					emit_movzx_r32_m16(DRCTOP, REG_EAX, REGADDR(m));						// movzx eax,word [rm]
+					break;
+
+				case 14:	/* EXTS.B Rm,Rn */
+					emit_movsx_r32_m8(DRCTOP, REG_EAX, REGADDR(m));							// movsx eax,byte [rm]
+					break;
+
+				case 15:	/* EXTS.W Rm,Rn */
+					emit_movsx_r32_m16(DRCTOP, REG_EAX, REGADDR(m));						// movsx eax,word [rm]
+					break;
+			}
+			emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);									// mov  [rn],eax
+			return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+		case 7:		/* ADD #imm,Rn */
+			emit_add_m32_imm(DRCTOP, REGADDR(n), SIMM8);									// add  [rn],simm
+			return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+		case 8:
+			switch ((opcode >> 8) & 15)
+			{
+				case 0:		/* MOV.B R0,@(disp4,Rn) */
+				case 1:		/* MOV.W R0,@(disp4,Rn) */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rn]
+					emit_add_r32_imm(DRCTOP, REG_EAX, DISP4 << (opcode >> 8 & 1));			// add  eax,disp*size
+					emit_mov_r32_m32(DRCTOP, REG_ECX, REGADDR(0));							// mov  ecx,[r0]
+					append_write(drc, cs, 1 << (opcode >> 8 & 1));
+					return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+				case 4:		/* MOV.B @(disp4,Rm),R0 */
+				case 5:		/* MOV.W @(disp4,Rm),R0 */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, REGADDR(m));							// mov  eax,[rm]
+					emit_add_r32_imm(DRCTOP, REG_EAX, DISP4 << (opcode >> 8 & 1));			// add  eax,disp*size
+					append_read(drc, cs, 1 << (opcode >> 8 & 1));
+					emit_mov_m32_r32(DRCTOP, REGADDR(0), REG_EAX);							// mov  [r0],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+				case 8:		/* CMP/EQ #imm,R0 */
+					emit_cmp_m32_imm(DRCTOP, REGADDR(0), SIMM8);							// cmp  [r0],simm
+					append_set_t(drc, COND_E);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 9:		/* BT disp8 */
+					return recompile_conditional_branch(drc, cs, opcode, FALSE, TRUE);
+
+				case 11:	/* BF disp8 */
+					return recompile_conditional_branch(drc, cs, opcode, FALSE, FALSE);
+
+				case 13:	/* BT/S disp8 */
+					return recompile_conditional_branch(drc, cs, opcode, TRUE, TRUE);
+
+				case 15:	/* BF/S disp8 */
+					return recompile_conditional_branch(drc, cs, opcode, TRUE, FALSE);
+			}
+			return RECOMPILE_SUCCESSFUL_CP(1,2);	/* NOP */
+
+		case 9:		/* MOV.W @(disp8,PC),Rn */
+			if (cs->ipc_dynamic)
+				return append_fallback(drc, cs, opcode);
+			emit_mov_r32_imm(DRCTOP, REG_EAX, cs->ipc + UIMM8 * 2 + 2);					// mov  eax,address
+			append_read(drc, cs, 2);
+			emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);									// mov  [rn],eax
+			return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+		case 10:	/* BRA disp12 */
+		case 11:	/* BSR disp12 */
+		{
+			UINT32 target = cs->pc + 4 + DISP12 * 2;
+
+			if (opcode & 0x1000)
+				emit_mov_m32_imm(DRCTOP, MABS(&sh2.pr), cs->pc + 4);						// mov  [pr],pc+4
+#if BUSY_LOOP_HACKS
+			/* BRA $ / NOP: throw away all but the remainder of the timeslice, like the interpreter */
+			else if (target == cs->pc && fetch_opcode(cs->pc + 2) == 0x0009)
+			{
+				emit_mov_r32_r32(DRCTOP, REG_EAX, REG_EBP);								// mov  eax,ebp
+				emit_cdq(DRCTOP);														// cdq
+				emit_mov_r32_imm(DRCTOP, REG_ECX, 3);									// mov  ecx,3
+				emit_idiv_r32(DRCTOP, REG_ECX);											// idiv ecx
+				emit_mov_r32_r32(DRCTOP, REG_EBP, REG_EDX);								// mov  ebp,edx
+			}
+#endif
+			return recompile_delayed_branch(drc, cs, target, FALSE, 2);
+		}
+
+		case 12:
+			switch ((opcode >> 8) & 15)
+			{
+				case 0:		/* MOV.B R0,@(disp8,GBR) */
+				case 1:		/* MOV.W R0,@(disp8,GBR) */
+				case 2:		/* MOV.L R0,@(disp8,GBR) */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&sh2.gbr));						// mov  eax,[gbr]
+					emit_add_r32_imm(DRCTOP, REG_EAX, UIMM8 << (opcode >> 8 & 3));			// add  eax,disp*size
+					emit_mov_r32_m32(DRCTOP, REG_ECX, REGADDR(0));							// mov  ecx,[r0]
+					append_write(drc, cs, 1 << (opcode >> 8 & 3));
+					return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+				case 3:		/* TRAPA #imm */
+					return recompile_flow_fallback(drc, cs, opcode);
+
+				case 4:		/* MOV.B @(disp8,GBR),R0 */
+				case 5:		/* MOV.W @(disp8,GBR),R0 */
+				case 6:		/* MOV.L @(disp8,GBR),R0 */
+					emit_mov_r32_m32(DRCTOP, REG_EAX, MABS(&sh2.gbr));						// mov  eax,[gbr]
+					emit_add_r32_imm(DRCTOP, REG_EAX, UIMM8 << (opcode >> 8 & 3));			// add  eax,disp*size
+					append_read(drc, cs, 1 << (opcode >> 8 & 3));
+					emit_mov_m32_r32(DRCTOP, REGADDR(0), REG_EAX);							// mov  [r0],eax
+					return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+				case 7:		/* MOVA @(disp8,PC),R0 */
+					if (cs->ipc_dynamic)
+						return append_fallback(drc, cs, opcode);
+					emit_mov_m32_imm(DRCTOP, REGADDR(0), ((cs->ipc + 2) & ~3) + UIMM8 * 4);	// mov  [r0],address
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 8:		/* TST #imm,R0 */
+					emit_test_m32_imm(DRCTOP, REGADDR(0), UIMM8);							// test [r0],imm
+					append_set_t(drc, COND_Z);
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 9:		/* AND #imm,R0 */
+					emit_and_m32_imm(DRCTOP, REGADDR(0), UIMM8);							// and  [r0],imm
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 10:	/* XOR #imm,R0 */
+					emit_xor_m32_imm(DRCTOP, REGADDR(0), UIMM8);							// xor  [r0],imm
+					return RECOMPILE_SUCCESSFUL_CP(1,2);
+
+				case 11:	/* OR #imm,R0 */
+					emit_or_m32_imm(DRCTOP, REGADDR(0), UIMM8);								// or   [r0],imm
+					return RECOMPILE_SUCCESSFUL_CP(3,2);	/* the interpreter charges 3 */
+
+				default:	/* TST.B/AND.B/XOR.B/OR.B #imm,@(R0,GBR) */
+					return append_fallback(drc, cs, opcode);
+			}
+
+		case 13:	/* MOV.L @(disp8,PC),Rn */
+			if (cs->ipc_dynamic)
+				return append_fallback(drc, cs, opcode);
+			emit_mov_r32_imm(DRCTOP, REG_EAX, ((cs->ipc + 2) & ~3) + UIMM8 * 4);			// mov  eax,address
+			append_read(drc, cs, 4);
+			emit_mov_m32_r32(DRCTOP, REGADDR(n), REG_EAX);									// mov  [rn],eax
+			return RECOMPILE_SUCCESSFUL_CP(1,2) | RECOMPILE_CALLED_OUT;
+
+		case 14:	/* MOV #imm,Rn */
+			emit_mov_m32_imm(DRCTOP, REGADDR(n), SIMM8);									// mov  [rn],simm
+			return RECOMPILE_SUCCESSFUL_CP(1,2);
+	}
+	return RECOMPILE_SUCCESSFUL_CP(1,2);	/* NOP */
+}
@@ -127,6 +127,7 @@ typedef struct
 	UINT16 *internal_ram;
 	UINT16 *internal_ram_block0, *internal_ram_block1;
 	int internal_ram_size;
+	UINT64 *opcode_cache;
 
 	int (*irq_callback)(int irqline);
 	void (*opcode_handler)(void);
@@ -180,10 +181,43 @@ static void (* sharc_op[512])(void);
 
 
 
-#define ROPCODE(pc)		((UINT64)(sharc.internal_ram[((pc-0x20000) * 3) + 0]) << 32) | \
+#define ROPCODE_RAW(pc)	((UINT64)(sharc.internal_ram[((pc-0x20000) * 3) + 0]) << 32) | \
 						((UINT64)(sharc.internal_ram[((pc-0x20000) * 3) + 1]) << 16) | \
 						((UINT64)(sharc.internal_ram[((pc-0x20000) * 3) + 2]) << 0)
 
+/* Opcodes assembled from internal RAM are kept in a cache indexed by PC. Any write */
+/* to internal RAM (DM, PM or DMA) marks the entries it overlaps as invalid. */
+#define OPCODE_CACHE_SIZE		((2 * 0x10000) / 3)
+#define OPCODE_CACHE_INVALID	(~(UINT64)0)
+
+INLINE UINT64 ROPCODE(UINT32 pc)
+{
+	UINT32 index = pc - 0x20000;
+	UINT64 op;
+
+	if (index >= OPCODE_CACHE_SIZE)
+		return ROPCODE_RAW(pc);
+
+	op = sharc.opcode_cache[index];
+	if (op == OPCODE_CACHE_INVALID)
+	{
+		op = ROPCODE_RAW(pc);
+		sharc.opcode_cache[index] = op;
+	}
+	return op;
+}
+
+INLINE void invalidate_opcode_cache(const UINT16 *ram, UINT32 addr, int words)
+{
+	UINT32 first = (ram - sharc.internal_ram) + addr;
+	UINT32 last = first + words - 1;
+
+	if (first / 3 < OPCODE_CACHE_SIZE)
+		sharc.opcode_cache[first / 3] = OPCODE_CACHE_INVALID;
+	if (last / 3 < OPCODE_CACHE_SIZE)
+		sharc.opcode_cache[last / 3] = OPCODE_CACHE_INVALID;
+}
+
 INLINE void CHANGE_PC(UINT32 newpc)
 {
 	sharc.pc = newpc;
@@ -434,11 +468,14 @@ static void sharc_init(int index, int clock, const void *config, int (*irqcallba
 	sharc.internal_ram = auto_malloc(2 * 0x10000 * sizeof(UINT16));		// 2x 128KB
 	sharc.internal_ram_block0 = &sharc.internal_ram[0];
 	sharc.internal_ram_block1 = &sharc.internal_ram[0x20000/2];
+
+	sharc.opcode_cache = auto_malloc(OPCODE_CACHE_SIZE * sizeof(UINT64));
 }
 
 static void sharc_reset(void)
 {
 	memset(sharc.internal_ram, 0, 2 * 0x10000 * sizeof(UINT16));
+	memset(sharc.opcode_cache, 0xff, OPCODE_CACHE_SIZE * sizeof(UINT64));
 
 	switch(sharc.boot_mode)
 	{
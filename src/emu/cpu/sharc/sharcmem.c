@@ -30,6 +30,7 @@ static void pm_write32(UINT32 address, UINT32 data)
 
 		sharc.internal_ram_block0[addr + 0] = (UINT16)(data >> 16);
 		sharc.internal_ram_block0[addr + 1] = (UINT16)(data);
+		invalidate_opcode_cache(sharc.internal_ram_block0, addr, 2);
 		return;
 	}
 	else if (address >= 0x28000 && address < 0x40000)
@@ -39,6 +40,7 @@ static void pm_write32(UINT32 address, UINT32 data)
 
 		sharc.internal_ram_block1[addr + 0] = (UINT16)(data >> 16);
 		sharc.internal_ram_block1[addr + 1] = (UINT16)(data);
+		invalidate_opcode_cache(sharc.internal_ram_block1, addr, 2);
 		return;
 	}
 	else {
@@ -81,6 +83,7 @@ static void pm_write48(UINT32 address, UINT64 data)
 		sharc.internal_ram_block0[addr + 0] = (UINT16)(data >> 32);
 		sharc.internal_ram_block0[addr + 1] = (UINT16)(data >> 16);
 		sharc.internal_ram_block0[addr + 2] = (UINT16)(data);
+		invalidate_opcode_cache(sharc.internal_ram_block0, addr, 3);
 		return;
 	}
 	else if (address >= 0x28000 && address < 0x40000)
@@ -91,6 +94,7 @@ static void pm_write48(UINT32 address, UINT64 data)
 		sharc.internal_ram_block1[addr + 0] = (UINT16)(data >> 32);
 		sharc.internal_ram_block1[addr + 1] = (UINT16)(data >> 16);
 		sharc.internal_ram_block1[addr + 2] = (UINT16)(data);
+		invalidate_opcode_cache(sharc.internal_ram_block1, addr, 3);
 		return;
 	}
 	else {
@@ -169,6 +173,7 @@ static void dm_write32(UINT32 address, UINT32 data)
 
 		sharc.internal_ram_block0[addr + 0] = (UINT16)(data >> 16);
 		sharc.internal_ram_block0[addr + 1] = (UINT16)(data);
+		invalidate_opcode_cache(sharc.internal_ram_block0, addr, 2);
 		return;
 	}
 	else if (address >= 0x28000 && address < 0x40000)
@@ -178,6 +183,7 @@ static void dm_write32(UINT32 address, UINT32 data)
 
 		sharc.internal_ram_block1[addr + 0] = (UINT16)(data >> 16);
 		sharc.internal_ram_block1[addr + 1] = (UINT16)(data);
+		invalidate_opcode_cache(sharc.internal_ram_block1, addr, 2);
 		return;
 	}
 
@@ -187,6 +193,7 @@ static void dm_write32(UINT32 address, UINT32 data)
 		UINT32 addr = address & 0xffff;
 
 		sharc.internal_ram_block0[addr ^ 1] = data;
+		invalidate_opcode_cache(sharc.internal_ram_block0, addr ^ 1, 1);
 		return;
 	}
 	else if (address >= 0x50000 && address < 0x80000)
@@ -195,6 +202,7 @@ static void dm_write32(UINT32 address, UINT32 data)
 		UINT32 addr = address & 0xffff;
 
 		sharc.internal_ram_block1[addr ^ 1] = data;
+		invalidate_opcode_cache(sharc.internal_ram_block1, addr ^ 1, 1);
 		return;
 	}
 
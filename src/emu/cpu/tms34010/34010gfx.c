@@ -227,6 +227,83 @@ static UINT16 dummy_shiftreg_r(offs_t offset)
 
 
 
+/* Direct RAM access */
+static UINT16 *get_direct_rows(UINT32 bitaddr, INT32 step, int rows, int rowbits, int write, UINT32 *firstword)
+{
+	INT64 first = bitaddr, last = (INT64)bitaddr + (INT64)(rows - 1) * step;
+	offs_t start, end;
+	void *base;
+
+#ifdef MAME_DEBUG
+	/* go through the memory system so watchpoints still fire */
+	if (Machine->debug_mode)
+		return NULL;
+#endif
+
+	/* rows may be walked in either direction from the starting address, and */
+	/* the inner loops can touch a word on either side, so pad generously */
+	if (first > last)
+	{
+		INT64 temp = first;
+		first = last;
+		last = temp;
+	}
+	first -= rowbits + 32;
+	last += rowbits + 32;
+	if (first < 0 || last > 0xffffffff)
+		return NULL;
+
+	/* the whole span must be plain RAM, readable and writable if needed */
+	start = (offs_t)(first >> 4) << 1;
+	end = ((offs_t)(last >> 4) << 1) + 1;
+	base = memory_get_read_range_ptr(cpu_getactivecpu(), ADDRESS_SPACE_PROGRAM, start, end);
+	if (base == NULL || (write && memory_get_write_range_ptr(cpu_getactivecpu(), ADDRESS_SPACE_PROGRAM, start, end) != base))
+		return NULL;
+
+	*firstword = start >> 1;
+	return (UINT16 *)base;
+}
+
+/* Handler-mapped VRAM; drivers that map VRAM through handlers can name them */
+/* in the config so the blitters call them directly rather than looking up */
+/* every word in the memory system, which still serves anything outside */
+INLINE int use_vram_hooks(void)
+{
+#ifdef MAME_DEBUG
+	/* go through the memory system so watchpoints still fire */
+	if (Machine->debug_mode)
+		return FALSE;
+#endif
+	return (state.config->vram_read != NULL && state.config->vram_write != NULL);
+}
+
+static UINT16 vram_hook_r(offs_t address)
+{
+	offs_t start = TOBYTE(state.config->vram_start);
+
+	if (address >= start && address <= TOBYTE(state.config->vram_end))
+		return (*state.config->vram_read)((address - start) >> 1, 0);
+	return program_read_word_16le(address);
+}
+
+static void vram_hook_w(offs_t address, UINT16 data)
+{
+	offs_t start = TOBYTE(state.config->vram_start);
+
+	if (address >= start && address <= TOBYTE(state.config->vram_end))
+		(*state.config->vram_write)((address - start) >> 1, data, 0);
+	else
+		program_write_word_16le(address, data);
+}
+
+/* word accessors used by the blitters; these go straight to RAM when the */
+/* source or destination was resolved to a direct pointer up front */
+#define SRC_READ(a)			(srcdirect ? srcdirect[(a) - srcfirst] : (*word_read)((a) << 1))
+#define DST_READ(a)			(dstdirect ? dstdirect[(a) - dstfirst] : (*word_read)((a) << 1))
+#define DST_WRITE(a,d)		do { if (dstdirect) dstdirect[(a) - dstfirst] = (d); else (*word_write)((a) << 1, (d)); } while (0)
+
+
+
 /* Pixel operations */
 static UINT32 pixel_op00(UINT32 dstpix, UINT32 mask, UINT32 srcpix) { return srcpix; }
 static UINT32 pixel_op01(UINT32 dstpix, UINT32 mask, UINT32 srcpix) { return srcpix & dstpix; }
@@ -1032,6 +1109,8 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 		UINT32 readwrites = 0;
 		UINT32 saddr, daddr;
 		XY dstxy = { 0 };
+		UINT16 *srcdirect = NULL, *dstdirect = NULL;
+		UINT32 srcfirst = 0, dstfirst = 0;
 
 		/* determine read/write functions */
 		if (IOREG(REG_DPYCTL) & 0x0800)
@@ -1039,6 +1118,11 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 			word_write = shiftreg_w;
 			word_read = shiftreg_r;
 		}
+		else if (use_vram_hooks())
+		{
+			word_write = vram_hook_w;
+			word_read = vram_hook_r;
+		}
 		else
 		{
 			word_write = program_write_word_16le;
@@ -1092,6 +1176,13 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 
 		state.st |= STBIT_P;
 
+		/* resolve the source and destination to RAM if we can */
+		if (!(IOREG(REG_DPYCTL) & 0x0800))
+		{
+			srcdirect = get_direct_rows(saddr, yreverse ? -(INT32)SPTCH : (INT32)SPTCH, dy, dx * BITS_PER_PIXEL, FALSE, &srcfirst);
+			dstdirect = get_direct_rows(daddr, yreverse ? -(INT32)DPTCH : (INT32)DPTCH, dy, dx * BITS_PER_PIXEL, TRUE, &dstfirst);
+		}
+
 		/* loop over rows */
 		for (y = 0; y < dy; y++)
 		{
@@ -1102,13 +1193,13 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 			UINT32 srcword, dstword = 0;
 
 			/* fetch the initial source word */
-			srcword = (*word_read)(srcwordaddr++ << 1);
+			srcword = SRC_READ(srcwordaddr++);
 			readwrites++;
 
 			/* fetch the initial dest word */
 			if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY || (daddr & 0x0f) != 0)
 			{
-				dstword = (*word_read)(dstwordaddr << 1);
+				dstword = DST_READ(dstwordaddr);
 				readwrites++;
 			}
 
@@ -1121,7 +1212,7 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 				/* fetch more words if necessary */
 				if (srcbit + BITS_PER_PIXEL > 16)
 				{
-					srcword |= (*word_read)(srcwordaddr++ << 1) << 16;
+					srcword |= SRC_READ(srcwordaddr++) << 16;
 					readwrites++;
 				}
 
@@ -1138,7 +1229,7 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
 					if (dstbit + BITS_PER_PIXEL > 16)
 					{
-						dstword |= (*word_read)((dstwordaddr + 1) << 1) << 16;
+						dstword |= DST_READ(dstwordaddr + 1) << 16;
 						readwrites++;
 					}
 
@@ -1153,7 +1244,7 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 				dstbit += BITS_PER_PIXEL;
 				if (dstbit > 16)
 				{
-					(*word_write)(dstwordaddr++ << 1, dstword);
+					DST_WRITE(dstwordaddr++, dstword);
 					readwrites++;
 					dstbit -= 16;
 					dstword >>= 16;
@@ -1166,13 +1257,13 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 				/* if we're right-partial, read and mask the remaining bits */
 				if (dstbit != 16)
 				{
-					UINT16 origdst = (*word_read)(dstwordaddr << 1);
+					UINT16 origdst = DST_READ(dstwordaddr);
 					UINT16 mask = 0xffff << dstbit;
 					dstword = (dstword & ~mask) | (origdst & mask);
 					readwrites++;
 				}
 
-				(*word_write)(dstwordaddr++ << 1, dstword);
+				DST_WRITE(dstwordaddr++, dstword);
 				readwrites++;
 			}
 
@@ -1204,14 +1295,14 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 			dwordaddr = daddr >> 4;
 
 			/* fetch the initial source word */
-			srcword = (*word_read)(swordaddr++ << 1);
+			srcword = SRC_READ(swordaddr++);
 			srcmask = PIXEL_MASK << (saddr & 15);
 
 			/* handle the left partial word */
 			if (left_partials != 0)
 			{
 				/* fetch the destination word */
-				dstword = (*word_read)(dwordaddr << 1);
+				dstword = DST_READ(dwordaddr);
 				dstmask = PIXEL_MASK << (daddr & 15);
 
 				/* loop over partials */
@@ -1220,7 +1311,7 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 					/* fetch another word if necessary */
 					if (srcmask == 0)
 					{
-						srcword = (*word_read)(swordaddr++ << 1);
+						srcword = SRC_READ(swordaddr++);
 						srcmask = PIXEL_MASK;
 					}
 
@@ -1242,7 +1333,7 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr++ << 1, dstword);
+				DST_WRITE(dwordaddr++, dstword);
 			}
 
 			/* loop over full words */
@@ -1250,7 +1341,7 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 			{
 				/* fetch the destination word (if necessary) */
 				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
-					dstword = (*word_read)(dwordaddr << 1);
+					dstword = DST_READ(dwordaddr);
 				else
 					dstword = 0;
 				dstmask = PIXEL_MASK;
@@ -1261,7 +1352,7 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 					/* fetch another word if necessary */
 					if (srcmask == 0)
 					{
-						srcword = (*word_read)(swordaddr++ << 1);
+						srcword = SRC_READ(swordaddr++);
 						srcmask = PIXEL_MASK;
 					}
 
@@ -1283,14 +1374,14 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr++ << 1, dstword);
+				DST_WRITE(dwordaddr++, dstword);
 			}
 
 			/* handle the right partial word */
 			if (right_partials != 0)
 			{
 				/* fetch the destination word */
-				dstword = (*word_read)(dwordaddr << 1);
+				dstword = DST_READ(dwordaddr);
 				dstmask = PIXEL_MASK;
 
 				/* loop over partials */
@@ -1300,7 +1391,7 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 					if (srcmask == 0)
 					{
 		LOGGFX(("  right fetch @ %08x\n", swordaddr));
-						srcword = (*word_read)(swordaddr++ << 1);
+						srcword = SRC_READ(swordaddr++);
 						srcmask = PIXEL_MASK;
 					}
 
@@ -1322,7 +1413,7 @@ static void FUNCTION_NAME(pixblt)(int src_is_linear, int dst_is_linear)
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr++ << 1, dstword);
+				DST_WRITE(dwordaddr++, dstword);
 			}
 #endif
 
@@ -1378,6 +1469,8 @@ static void FUNCTION_NAME(pixblt_r)(int src_is_linear, int dst_is_linear)
 		UINT16 (*word_read)(offs_t address);
 		UINT32 saddr, daddr;
 		XY dstxy = { 0 };
+		UINT16 *srcdirect = NULL, *dstdirect = NULL;
+		UINT32 srcfirst = 0, dstfirst = 0;
 
 		/* determine read/write functions */
 		if (IOREG(REG_DPYCTL) & 0x0800)
@@ -1385,6 +1478,11 @@ static void FUNCTION_NAME(pixblt_r)(int src_is_linear, int dst_is_linear)
 			word_write = shiftreg_w;
 			word_read = shiftreg_r;
 		}
+		else if (use_vram_hooks())
+		{
+			word_write = vram_hook_w;
+			word_read = vram_hook_r;
+		}
 		else
 		{
 			word_write = program_write_word_16le;
@@ -1445,6 +1543,13 @@ if ((daddr & (BITS_PER_PIXEL - 1)) != 0) mame_printf_debug("PIXBLT_R%d with odd
 
 		state.st |= STBIT_P;
 
+		/* resolve the source and destination to RAM if we can */
+		if (!(IOREG(REG_DPYCTL) & 0x0800))
+		{
+			srcdirect = get_direct_rows(saddr, yreverse ? -(INT32)SPTCH : (INT32)SPTCH, dy, dx * BITS_PER_PIXEL, FALSE, &srcfirst);
+			dstdirect = get_direct_rows(daddr, yreverse ? -(INT32)DPTCH : (INT32)DPTCH, dy, dx * BITS_PER_PIXEL, TRUE, &dstfirst);
+		}
+
 		/* loop over rows */
 		for (y = 0; y < dy; y++)
 		{
@@ -1473,14 +1578,14 @@ if ((daddr & (BITS_PER_PIXEL - 1)) != 0) mame_printf_debug("PIXBLT_R%d with odd
 			dwordaddr = (daddr + 15) >> 4;
 
 			/* fetch the initial source word */
-			srcword = (*word_read)(--swordaddr << 1);
+			srcword = SRC_READ(--swordaddr);
 			srcmask = PIXEL_MASK << ((saddr - BITS_PER_PIXEL) & 15);
 
 			/* handle the right partial word */
 			if (right_partials != 0)
 			{
 				/* fetch the destination word */
-				dstword = (*word_read)(--dwordaddr << 1);
+				dstword = DST_READ(--dwordaddr);
 				dstmask = PIXEL_MASK << ((daddr - BITS_PER_PIXEL) & 15);
 
 				/* loop over partials */
@@ -1489,7 +1594,7 @@ if ((daddr & (BITS_PER_PIXEL - 1)) != 0) mame_printf_debug("PIXBLT_R%d with odd
 					/* fetch source pixel if necessary */
 					if (srcmask == 0)
 					{
-						srcword = (*word_read)(--swordaddr << 1);
+						srcword = SRC_READ(--swordaddr);
 						srcmask = PIXEL_MASK << (16 - BITS_PER_PIXEL);
 					}
 
@@ -1511,7 +1616,7 @@ if ((daddr & (BITS_PER_PIXEL - 1)) != 0) mame_printf_debug("PIXBLT_R%d with odd
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr << 1, dstword);
+				DST_WRITE(dwordaddr, dstword);
 			}
 
 			/* loop over full words */
@@ -1520,7 +1625,7 @@ if ((daddr & (BITS_PER_PIXEL - 1)) != 0) mame_printf_debug("PIXBLT_R%d with odd
 				/* fetch the destination word (if necessary) */
 				dwordaddr--;
 				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
-					dstword = (*word_read)(dwordaddr << 1);
+					dstword = DST_READ(dwordaddr);
 				else
 					dstword = 0;
 				dstmask = PIXEL_MASK << (16 - BITS_PER_PIXEL);
@@ -1531,7 +1636,7 @@ if ((daddr & (BITS_PER_PIXEL - 1)) != 0) mame_printf_debug("PIXBLT_R%d with odd
 					/* fetch source pixel if necessary */
 					if (srcmask == 0)
 					{
-						srcword = (*word_read)(--swordaddr << 1);
+						srcword = SRC_READ(--swordaddr);
 						srcmask = PIXEL_MASK << (16 - BITS_PER_PIXEL);
 					}
 
@@ -1553,14 +1658,14 @@ if ((daddr & (BITS_PER_PIXEL - 1)) != 0) mame_printf_debug("PIXBLT_R%d with odd
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr << 1, dstword);
+				DST_WRITE(dwordaddr, dstword);
 			}
 
 			/* handle the left partial word */
 			if (left_partials != 0)
 			{
 				/* fetch the destination word */
-				dstword = (*word_read)(--dwordaddr << 1);
+				dstword = DST_READ(--dwordaddr);
 				dstmask = PIXEL_MASK << (16 - BITS_PER_PIXEL);
 
 				/* loop over partials */
@@ -1569,7 +1674,7 @@ if ((daddr & (BITS_PER_PIXEL - 1)) != 0) mame_printf_debug("PIXBLT_R%d with odd
 					/* fetch the source pixel if necessary */
 					if (srcmask == 0)
 					{
-						srcword = (*word_read)(--swordaddr << 1);
+						srcword = SRC_READ(--swordaddr);
 						srcmask = PIXEL_MASK << (16 - BITS_PER_PIXEL);
 					}
 
@@ -1591,7 +1696,7 @@ if ((daddr & (BITS_PER_PIXEL - 1)) != 0) mame_printf_debug("PIXBLT_R%d with odd
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr << 1, dstword);
+				DST_WRITE(dwordaddr, dstword);
 			}
 
 			/* update for next row */
@@ -1643,6 +1748,8 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 		UINT16 (*word_read)(offs_t address);
 		UINT32 saddr, daddr;
 		XY dstxy = { 0 };
+		UINT16 *srcdirect = NULL, *dstdirect = NULL;
+		UINT32 srcfirst = 0, dstfirst = 0;
 
 		/* determine read/write functions */
 		if (IOREG(REG_DPYCTL) & 0x0800)
@@ -1650,6 +1757,11 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 			word_write = shiftreg_w;
 			word_read = shiftreg_r;
 		}
+		else if (use_vram_hooks())
+		{
+			word_write = vram_hook_w;
+			word_read = vram_hook_r;
+		}
 		else
 		{
 			word_write = program_write_word_16le;
@@ -1705,6 +1817,13 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 		state.gfxcycles += compute_pixblt_b_cycles(left_partials, right_partials, full_words, dy, PIXEL_OP_TIMING, BITS_PER_PIXEL);
 		state.st |= STBIT_P;
 
+		/* resolve the source and destination to RAM if we can */
+		if (!(IOREG(REG_DPYCTL) & 0x0800))
+		{
+			srcdirect = get_direct_rows(saddr, SPTCH, dy, dx, FALSE, &srcfirst);
+			dstdirect = get_direct_rows(daddr, DPTCH, dy, dx * BITS_PER_PIXEL, TRUE, &dstfirst);
+		}
+
 		/* loop over rows */
 		for (y = 0; y < dy; y++)
 		{
@@ -1716,14 +1835,14 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 			dwordaddr = daddr >> 4;
 
 			/* fetch the initial source word */
-			srcword = (*word_read)(swordaddr++ << 1);
+			srcword = SRC_READ(swordaddr++);
 			srcmask = 1 << (saddr & 15);
 
 			/* handle the left partial word */
 			if (left_partials != 0)
 			{
 				/* fetch the destination word */
-				dstword = (*word_read)(dwordaddr << 1);
+				dstword = DST_READ(dwordaddr);
 				dstmask = PIXEL_MASK << (daddr & 15);
 
 				/* loop over partials */
@@ -1740,7 +1859,7 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 					srcmask <<= 1;
 					if (srcmask == 0)
 					{
-						srcword = (*word_read)(swordaddr++ << 1);
+						srcword = SRC_READ(swordaddr++);
 						srcmask = 0x0001;
 					}
 
@@ -1749,7 +1868,7 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr++ << 1, dstword);
+				DST_WRITE(dwordaddr++, dstword);
 			}
 
 			/* loop over full words */
@@ -1757,7 +1876,7 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 			{
 				/* fetch the destination word (if necessary) */
 				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
-					dstword = (*word_read)(dwordaddr << 1);
+					dstword = DST_READ(dwordaddr);
 				else
 					dstword = 0;
 				dstmask = PIXEL_MASK;
@@ -1776,7 +1895,7 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 					srcmask <<= 1;
 					if (srcmask == 0)
 					{
-						srcword = (*word_read)(swordaddr++ << 1);
+						srcword = SRC_READ(swordaddr++);
 						srcmask = 0x0001;
 					}
 
@@ -1785,14 +1904,14 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr++ << 1, dstword);
+				DST_WRITE(dwordaddr++, dstword);
 			}
 
 			/* handle the right partial word */
 			if (right_partials != 0)
 			{
 				/* fetch the destination word */
-				dstword = (*word_read)(dwordaddr << 1);
+				dstword = DST_READ(dwordaddr);
 				dstmask = PIXEL_MASK;
 
 				/* loop over partials */
@@ -1809,7 +1928,7 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 					srcmask <<= 1;
 					if (srcmask == 0)
 					{
-						srcword = (*word_read)(swordaddr++ << 1);
+						srcword = SRC_READ(swordaddr++);
 						srcmask = 0x0001;
 					}
 
@@ -1818,7 +1937,7 @@ static void FUNCTION_NAME(pixblt_b)(int dst_is_linear)
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr++ << 1, dstword);
+				DST_WRITE(dwordaddr++, dstword);
 			}
 
 			/* update for next row */
@@ -1857,6 +1976,8 @@ static void FUNCTION_NAME(fill)(int dst_is_linear)
 		UINT16 (*word_read)(offs_t address);
 		UINT32 daddr;
 		XY dstxy = { 0 };
+		UINT16 *dstdirect = NULL;
+		UINT32 dstfirst = 0;
 
 		/* determine read/write functions */
 		if (IOREG(REG_DPYCTL) & 0x0800)
@@ -1864,6 +1985,11 @@ static void FUNCTION_NAME(fill)(int dst_is_linear)
 			word_write = shiftreg_w;
 			word_read = dummy_shiftreg_r;
 		}
+		else if (use_vram_hooks())
+		{
+			word_write = vram_hook_w;
+			word_read = vram_hook_r;
+		}
 		else
 		{
 			word_write = program_write_word_16le;
@@ -1916,6 +2042,10 @@ static void FUNCTION_NAME(fill)(int dst_is_linear)
 		state.gfxcycles += 2;
 		state.st |= STBIT_P;
 
+		/* resolve the destination to RAM if we can */
+		if (!(IOREG(REG_DPYCTL) & 0x0800))
+			dstdirect = get_direct_rows(daddr, DPTCH, dy, dx * BITS_PER_PIXEL, TRUE, &dstfirst);
+
 		/* loop over rows */
 		for (y = 0; y < dy; y++)
 		{
@@ -1932,7 +2062,7 @@ static void FUNCTION_NAME(fill)(int dst_is_linear)
 			if (left_partials != 0)
 			{
 				/* fetch the destination word */
-				dstword = (*word_read)(dwordaddr << 1);
+				dstword = DST_READ(dwordaddr);
 				dstmask = PIXEL_MASK << (daddr & 15);
 
 				/* loop over partials */
@@ -1949,7 +2079,7 @@ static void FUNCTION_NAME(fill)(int dst_is_linear)
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr++ << 1, dstword);
+				DST_WRITE(dwordaddr++, dstword);
 			}
 
 			/* loop over full words */
@@ -1957,7 +2087,7 @@ static void FUNCTION_NAME(fill)(int dst_is_linear)
 			{
 				/* fetch the destination word (if necessary) */
 				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
-					dstword = (*word_read)(dwordaddr << 1);
+					dstword = DST_READ(dwordaddr);
 				else
 					dstword = 0;
 				dstmask = PIXEL_MASK;
@@ -1976,14 +2106,14 @@ static void FUNCTION_NAME(fill)(int dst_is_linear)
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr++ << 1, dstword);
+				DST_WRITE(dwordaddr++, dstword);
 			}
 
 			/* handle the right partial word */
 			if (right_partials != 0)
 			{
 				/* fetch the destination word */
-				dstword = (*word_read)(dwordaddr << 1);
+				dstword = DST_READ(dwordaddr);
 				dstmask = PIXEL_MASK;
 
 				/* loop over partials */
@@ -2000,7 +2130,7 @@ static void FUNCTION_NAME(fill)(int dst_is_linear)
 				}
 
 				/* write the result */
-				(*word_write)(dwordaddr++ << 1, dstword);
+				DST_WRITE(dwordaddr++, dstword);
 			}
 
 			/* update for next row */
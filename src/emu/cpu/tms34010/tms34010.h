@@ -82,6 +82,9 @@ struct _tms34010_config
 	void	(*output_int)(int state);			/* output interrupt callback */
 	void	(*to_shiftreg)(offs_t, UINT16 *);	/* shift register write */
 	void	(*from_shiftreg)(offs_t, UINT16 *);	/* shift register read */
+	offs_t	vram_start, vram_end;				/* bit address range of VRAM mapped through handlers */
+	read16_handler	vram_read;					/* VRAM read handler, called directly by the blitters */
+	write16_handler	vram_write;					/* VRAM write handler, called directly by the blitters */
 };
 
 
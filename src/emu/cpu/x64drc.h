@@ -0,0 +1,317 @@
+/***************************************************************************
+
+    x64drc.h
+
+    x64 Dynamic recompiler support routines.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************
+
+    This is the 64-bit counterpart to x86drc.h, and exposes the same
+    interface so that the CPU-specific recompilers can share their
+    source between the two. Generated code is still written in terms
+    of the 32-bit registers, with the same conventions as on x86:
+
+        EDI = PC (unless pc_in_memory)
+        EBP = icount (unless icount_in_memory)
+        ESI = volatile pointer/data (if esiptr is provided)
+
+    In addition, two registers are reserved as anchors for reaching
+    data, since x64 has no 32-bit absolute addressing mode:
+
+        R15 = the drc_core, which lives at the start of the cache
+        R14 = an address in the executable image
+
+    MABS() picks whichever anchor is within 2GB of the target address.
+    Anything else (heap pointers, C functions) must be loaded into a
+    register first; R11 is reserved as a scratch register for this.
+
+    Stack slots are 8 bytes instead of 4. Code that describes its
+    stack layout in terms of pushed 32-bit values should use MSTACK(),
+    emit_stack_alloc() and emit_stack_free(), which scale accordingly.
+    Calls to C code must go through drc_append_call_c(), which moves
+    the pushed arguments into registers as the native ABI requires.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __X64DRC_H__
+#define __X64DRC_H__
+
+#include "cpuintrf.h"
+#include "x86emit.h"
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* PC and pointer pair */
+typedef struct _pc_ptr_pair pc_ptr_pair;
+struct _pc_ptr_pair
+{
+	UINT32		pc;
+	x86code *	target;
+};
+
+
+/* core interface structure for the drc common code */
+typedef struct _drc_core drc_core;
+struct _drc_core
+{
+	UINT8 *		cache_base;				/* base pointer to the compiler cache */
+	UINT8 *		cache_top;				/* current top of cache */
+	UINT8 *		cache_danger;			/* high water mark for the end */
+	UINT8 *		cache_end;				/* end of cache memory */
+	size_t		cache_size;				/* cache allocated size */
+	UINT8		cache_allocated;		/* did the DRC core allocate the cache? */
+
+	x86code ***	lookup_l1;				/* level 1 lookup */
+	x86code **	lookup_l2_recompile;	/* level 2 lookup populated with recompile pointers */
+	UINT8		l1bits;					/* number of bits in level 1 lookup */
+	UINT8		l2bits;					/* number of bits in level 2 lookup */
+	UINT8		l1shift;				/* shift to go from PC to level 1 lookup */
+	UINT32		l2mask;					/* mask to go from PC to level 2 lookup */
+	UINT8		l2scale;				/* scale to get from masked PC value to final level 2 lookup */
+
+	void 		(*entry_point)(void);	/* pointer to asm entry point */
+	x86code *	out_of_cycles;			/* pointer to out of cycles jump point */
+	x86code *	recompile;				/* pointer to recompile jump point */
+	x86code *	dispatch;				/* pointer to dispatch jump point */
+	x86code *	flush;					/* pointer to flush jump point */
+
+	UINT32 *	pcptr;					/* pointer to where the PC is stored */
+	UINT32 *	icountptr;				/* pointer to where the icount is stored */
+	FPTR *		esiptr;					/* pointer to where the volatile data in RSI is stored */
+	UINT8		pc_in_memory;			/* true if the PC is stored in memory */
+	UINT8		icount_in_memory;		/* true if the icount is stored in memory */
+
+	UINT8		uses_fp;				/* true if we need the FP unit */
+	UINT8		uses_sse;				/* true if we need the SSE unit */
+	UINT16		fpcw_curr;				/* current FPU control word */
+	UINT32		mxcsr_curr;				/* current SSE control word */
+	UINT16		fpcw_save;				/* saved FPU control word */
+	UINT32		mxcsr_save;				/* saved SSE control word */
+
+	pc_ptr_pair *sequence_list;			/* PC/pointer sets for the current instruction sequence */
+	UINT32		sequence_count;			/* number of instructions in the current sequence */
+	UINT32		sequence_count_max;		/* max number of instructions in the current sequence */
+	pc_ptr_pair *tentative_list;		/* PC/pointer sets for tentative branches */
+	UINT32		tentative_count;		/* number of tentative branches */
+	UINT32		tentative_count_max;	/* max number of tentative branches */
+
+	void 		(*cb_reset)(struct _drc_core *drc);		/* callback when the cache is reset */
+	void 		(*cb_recompile)(struct _drc_core *drc);	/* callback when code needs to be recompiled */
+	void 		(*cb_entrygen)(struct _drc_core *drc);	/* callback before generating the dispatcher on entry */
+};
+
+
+/* configuration structure for the drc common code */
+typedef struct _drc_config drc_config;
+struct _drc_config
+{
+	UINT8 *		cache_base;				/* base pointer to the compiler cache */
+	UINT32		cache_size;				/* size of cache to allocate */
+	UINT32		max_instructions;		/* maximum instructions per sequence */
+	UINT8		address_bits;			/* number of live address bits in the PC */
+	UINT8		lsbs_to_ignore;			/* number of LSBs to ignore on the PC */
+	UINT8		uses_fp;				/* true if we need the FP unit */
+	UINT8		uses_sse;				/* true if we need the SSE unit */
+	UINT8		pc_in_memory;			/* true if the PC is stored in memory */
+	UINT8		icount_in_memory;		/* true if the icount is stored in memory */
+
+	UINT32 *	pcptr;					/* pointer to where the PC is stored */
+	UINT32 *	icountptr;				/* pointer to where the icount is stored */
+	FPTR *		esiptr;					/* pointer to where the volatile data in RSI is stored */
+
+	void 		(*cb_reset)(drc_core *drc);		/* callback when the cache is reset */
+	void 		(*cb_recompile)(drc_core *drc);	/* callback when code needs to be recompiled */
+	void 		(*cb_entrygen)(drc_core *drc);	/* callback before generating the dispatcher on entry */
+};
+
+
+/* structure to hold link data to be filled in later */
+typedef struct _link_info link_info;
+struct _link_info
+{
+	UINT8 		size;
+	UINT8 *		target;
+};
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* anchor and scratch registers */
+#define REG_DRC_NEAR			REG_R15
+#define REG_DRC_IMAGE			REG_R14
+#define REG_DRC_TEMP			REG_R11
+
+/* first integer argument register, for code that is called from C */
+#ifdef _WIN64
+#define REG_PARAM1				REG_RCX
+#else
+#define REG_PARAM1				REG_RDI
+#endif
+
+/* features */
+#define CPUID_FEATURES_MMX		(1 << 23)
+#define CPUID_FEATURES_SSE		(1 << 26)
+#define CPUID_FEATURES_SSE2		(1 << 25)
+#define CPUID_FEATURES_CMOV		(1 << 15)
+#define CPUID_FEATURES_TSC		(1 << 4)
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* an address in the executable image, loaded into REG_DRC_IMAGE */
+extern UINT8 drc_image_anchor;
+
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+/* use this macro in emit_* instructions to make them shorter */
+#define DRCTOP					&drc->cache_top
+
+/* absolute and absolute-indexed addressing, relative to an anchor */
+#define MABS(addr)				drc_anchor_reg(drc, (const void *)(addr)), REG_NONE, 1, drc_anchor_disp(drc, (const void *)(addr))
+#define MABSI(index, scale, addr) drc_anchor_reg(drc, (const void *)(addr)), (index), (scale), drc_anchor_disp(drc, (const void *)(addr))
+
+/* stack offsets, expressed in terms of pushed 32-bit values */
+#define DRCSTACK(offs)			((offs) * 2)
+#define MSTACK(offs)			MBD(REG_RSP, DRCSTACK(offs))
+
+
+
+/***************************************************************************
+    HELPER MACROS
+***************************************************************************/
+
+/* useful macros for accessing hi/lo portions of 64-bit values */
+#define LO(x)		(&(((UINT32 *)(FPTR)(x))[0]))
+#define HI(x)		(&(((UINT32 *)(FPTR)(x))[1]))
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+/* init/shutdown */
+drc_core *drc_init(UINT8 cpunum, drc_config *config);
+void *drc_alloc(drc_core *drc, size_t amount);
+void drc_cache_reset(drc_core *drc);
+void drc_execute(drc_core *drc);
+void drc_exit(drc_core *drc);
+
+/* code management */
+void drc_begin_sequence(drc_core *drc, UINT32 pc);
+void drc_end_sequence(drc_core *drc);
+void drc_register_code_at_cache_top(drc_core *drc, UINT32 pc);
+void *drc_get_code_at_pc(drc_core *drc, UINT32 pc);
+
+/* standard appendages */
+void drc_append_dispatcher(drc_core *drc);
+void drc_append_fixed_dispatcher(drc_core *drc, UINT32 newpc);
+void drc_append_tentative_fixed_dispatcher(drc_core *drc, UINT32 newpc);
+void drc_append_call_debugger(drc_core *drc);
+void drc_append_standard_epilogue(drc_core *drc, INT32 cycles, INT32 pcdelta, int allow_exit);
+void drc_append_save_volatiles(drc_core *drc);
+void drc_append_restore_volatiles(drc_core *drc);
+void drc_append_save_call_restore(drc_core *drc, x86code *target, UINT32 stackadj);
+void drc_append_verify_code(drc_core *drc, void *code, UINT8 length);
+void drc_append_call_c(drc_core *drc, x86code *target, const char *args);
+void drc_append_tail_call_c(drc_core *drc, x86code *target, const char *args);
+
+void drc_append_set_fp_rounding(drc_core *drc, UINT8 regindex);
+void drc_append_set_temp_fp_rounding(drc_core *drc, UINT8 rounding);
+void drc_append_restore_fp_rounding(drc_core *drc);
+
+void drc_append_set_sse_rounding(drc_core *drc, UINT8 regindex);
+void drc_append_set_temp_sse_rounding(drc_core *drc, UINT8 rounding);
+void drc_append_restore_sse_rounding(drc_core *drc);
+
+/* disassembling drc code */
+void drc_dasm(FILE *f, const void *begin, const void *end);
+
+/* x86 CPU features */
+UINT32 drc_x86_get_features(void);
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_anchor_reg - return the anchor register
+    to use to reach the given address
+-------------------------------------------------*/
+
+INLINE UINT8 drc_anchor_reg(drc_core *drc, const void *addr)
+{
+	INT64 delta = (const UINT8 *)addr - (const UINT8 *)drc;
+	if ((INT32)delta == delta)
+		return REG_DRC_NEAR;
+	delta = (const UINT8 *)addr - &drc_image_anchor;
+	if ((INT32)delta == delta)
+		return REG_DRC_IMAGE;
+	fatalerror("drc_anchor_reg: address %p is out of range", addr);
+	return REG_NONE;
+}
+
+
+/*-------------------------------------------------
+    drc_anchor_disp - return the displacement
+    of the given address from its anchor
+-------------------------------------------------*/
+
+INLINE INT32 drc_anchor_disp(drc_core *drc, const void *addr)
+{
+	const UINT8 *anchor = (drc_anchor_reg(drc, addr) == REG_DRC_NEAR) ? (const UINT8 *)drc : &drc_image_anchor;
+	return (INT32)((const UINT8 *)addr - anchor);
+}
+
+
+/*-------------------------------------------------
+    pointer-sized moves; on x86 these are the
+    32-bit forms
+-------------------------------------------------*/
+
+INLINE void emit_mov_rp_imm(x86code **emitptr, UINT8 dreg, const void *ptr)	{ emit_mov_r64_imm(emitptr, dreg, (FPTR)ptr); }
+INLINE void emit_mov_rp_mp(x86code **emitptr, UINT8 dreg, DECLARE_MEMPARAMS)	{ emit_mov_r64_m64(emitptr, dreg, MEMPARAMS); }
+INLINE void emit_mov_mp_rp(x86code **emitptr, DECLARE_MEMPARAMS, UINT8 sreg)	{ emit_mov_m64_r64(emitptr, MEMPARAMS, sreg); }
+INLINE void emit_jmp_rp(x86code **emitptr, UINT8 dreg)						{ emit_jmp_r64(emitptr, dreg); }
+
+
+/*-------------------------------------------------
+    stack helpers; values pushed occupy a full
+    8-byte slot, and sizes are given in terms of
+    32-bit values
+-------------------------------------------------*/
+
+INLINE void emit_push_r32(x86code **emitptr, UINT8 reg)					{ emit_push_r64(emitptr, reg); }
+INLINE void emit_pop_r32(x86code **emitptr, UINT8 reg)					{ emit_pop_r64(emitptr, reg); }
+INLINE void emit_push_m32(x86code **emitptr, DECLARE_MEMPARAMS)			{ emit_push_m64(emitptr, MEMPARAMS); }
+INLINE void emit_stack_alloc(x86code **emitptr, UINT32 bytes)			{ emit_sub_r64_imm(emitptr, REG_RSP, DRCSTACK(bytes)); }
+INLINE void emit_stack_free(x86code **emitptr, UINT32 bytes)			{ emit_add_r64_imm(emitptr, REG_RSP, DRCSTACK(bytes)); }
+
+INLINE void emit_push_pointer(x86code **emitptr, const void *ptr)
+{
+	emit_mov_r64_imm(emitptr, REG_DRC_TEMP, (FPTR)ptr);
+	emit_push_r64(emitptr, REG_DRC_TEMP);
+}
+
+
+#endif	/* __X64DRC_H__ */
@@ -453,6 +453,30 @@ void drc_append_save_call_restore(drc_core *drc, x86code *target, UINT32 stackad
 }
 
 
+/*------------------------------------------------------------------
+    drc_append_call_c - call a C function whose
+    arguments have already been pushed; the
+    argument description is only needed on x64
+------------------------------------------------------------------*/
+
+void drc_append_call_c(drc_core *drc, x86code *target, const char *args)
+{
+	emit_call(DRCTOP, target);													// call target
+}
+
+
+/*------------------------------------------------------------------
+    drc_append_tail_call_c - jump to a C function
+    from a subroutine, passing along the
+    subroutine's own arguments
+------------------------------------------------------------------*/
+
+void drc_append_tail_call_c(drc_core *drc, x86code *target, const char *args)
+{
+	emit_jmp(DRCTOP, target);													// jmp  target
+}
+
+
 /*------------------------------------------------------------------
     drc_append_standard_epilogue
 ------------------------------------------------------------------*/
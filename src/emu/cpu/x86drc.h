@@ -123,6 +123,13 @@ struct _link_info
 /* use this macro in emit_* instructions to make them shorter */
 #define DRCTOP					&drc->cache_top
 
+/* absolute-indexed addressing; see x64drc.h */
+#define MABSI(index, scale, addr) MISD((index), (scale), (FPTR)(addr))
+
+/* stack offsets, expressed in terms of pushed 32-bit values */
+#define DRCSTACK(offs)			(offs)
+#define MSTACK(offs)			MBD(REG_ESP, DRCSTACK(offs))
+
 
 
 /***************************************************************************
@@ -175,6 +182,8 @@ void drc_append_save_volatiles(drc_core *drc);
 void drc_append_restore_volatiles(drc_core *drc);
 void drc_append_save_call_restore(drc_core *drc, x86code *target, UINT32 stackadj);
 void drc_append_verify_code(drc_core *drc, void *code, UINT8 length);
+void drc_append_call_c(drc_core *drc, x86code *target, const char *args);
+void drc_append_tail_call_c(drc_core *drc, x86code *target, const char *args);
 
 void drc_append_set_fp_rounding(drc_core *drc, UINT8 regindex);
 void drc_append_set_temp_fp_rounding(drc_core *drc, UINT8 rounding);
@@ -191,4 +200,30 @@ void drc_dasm(FILE *f, const void *begin, const void *end);
 UINT32 drc_x86_get_features(void);
 
 
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    pointer-sized moves; on x64 these are the
+    64-bit forms
+-------------------------------------------------*/
+
+INLINE void emit_mov_rp_imm(x86code **emitptr, UINT8 dreg, const void *ptr)	{ emit_mov_r32_imm(emitptr, dreg, (FPTR)ptr); }
+INLINE void emit_mov_rp_mp(x86code **emitptr, UINT8 dreg, DECLARE_MEMPARAMS)	{ emit_mov_r32_m32(emitptr, dreg, MEMPARAMS); }
+INLINE void emit_mov_mp_rp(x86code **emitptr, DECLARE_MEMPARAMS, UINT8 sreg)	{ emit_mov_m32_r32(emitptr, MEMPARAMS, sreg); }
+INLINE void emit_jmp_rp(x86code **emitptr, UINT8 dreg)						{ emit_jmp_r32(emitptr, dreg); }
+
+
+/*-------------------------------------------------
+    stack helpers; sizes are given in terms of
+    32-bit values so that x64 can scale them
+-------------------------------------------------*/
+
+INLINE void emit_stack_alloc(x86code **emitptr, UINT32 bytes)			{ emit_sub_r32_imm(emitptr, REG_ESP, DRCSTACK(bytes)); }
+INLINE void emit_stack_free(x86code **emitptr, UINT32 bytes)			{ emit_add_r32_imm(emitptr, REG_ESP, DRCSTACK(bytes)); }
+INLINE void emit_push_pointer(x86code **emitptr, const void *ptr)		{ emit_push_imm(emitptr, (FPTR)ptr); }
+
+
 #endif	/* __X86DRC_H__ */
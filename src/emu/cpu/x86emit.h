@@ -1131,9 +1131,23 @@ INLINE void emit_qword(x86code **emitptr, UINT64 qword)
 
 INLINE void emit_op(x86code **emitptr, UINT32 op, UINT8 opsize, UINT8 reg, UINT8 sib, UINT8 rm)
 {
+	UINT8 prefix = op >> 16;
 #ifdef PTR64
 	UINT8 rex;
+#endif
+
+	/* the operand size prefix must precede any REX prefix */
+	if (opsize == OP_16BIT)
+		emit_byte(emitptr, PREFIX_OPSIZE);
+
+	/* so must the mandatory prefix of an SSE opcode, or the CPU ignores the REX */
+	if (prefix == PREFIX_OPSIZE || prefix == PREFIX_REPNE || prefix == PREFIX_REPE)
+	{
+		emit_byte(emitptr, prefix);
+		op &= ~0xff0000;
+	}
 
+#ifdef PTR64
 	assert(opsize == OP_16BIT || opsize == OP_32BIT || opsize == OP_64BIT);
 
 	rex = (opsize & 8) | ((reg & 8) >> 1) | ((sib & 8) >> 2) | ((rm & 8) >> 3);
@@ -1143,8 +1157,6 @@ INLINE void emit_op(x86code **emitptr, UINT32 op, UINT8 opsize, UINT8 reg, UINT8
 	assert(opsize != OP_64BIT);
 #endif
 
-	if (opsize == OP_16BIT)
-		emit_byte(emitptr, PREFIX_OPSIZE);
 	if ((op & 0xff0000) != 0)
 		emit_byte(emitptr, op >> 16);
 	if ((op & 0xff00) != 0)
@@ -1455,11 +1467,13 @@ INLINE void emit_ret(x86code **emitptr)    { emit_op_simple(emitptr, OP_RETN, OP
 INLINE void emit_cdq(x86code **emitptr)    { emit_op_simple(emitptr, OP_CDQ, OP_32BIT); }
 INLINE void emit_cmc(x86code **emitptr)    { emit_op_simple(emitptr, OP_CMC, OP_32BIT); }
 
+/* note: LAHF/SAHF in 64-bit mode require CPUID 80000001h:ECX bit 0 */
+INLINE void emit_lahf(x86code **emitptr)   { emit_op_simple(emitptr, OP_LAHF, OP_32BIT); }
+INLINE void emit_sahf(x86code **emitptr)   { emit_op_simple(emitptr, OP_SAHF, OP_32BIT); }
+
 #ifndef PTR64
 INLINE void emit_pushad(x86code **emitptr) { emit_op_simple(emitptr, OP_PUSHA, OP_32BIT); }
 INLINE void emit_popad(x86code **emitptr)  { emit_op_simple(emitptr, OP_POPA, OP_32BIT); }
-INLINE void emit_lahf(x86code **emitptr)   { emit_op_simple(emitptr, OP_LAHF, OP_32BIT); }
-INLINE void emit_sahf(x86code **emitptr)   { emit_op_simple(emitptr, OP_SAHF, OP_32BIT); }
 #endif
 
 #ifdef PTR64
@@ -1996,17 +2010,17 @@ INLINE void emit_test_m64_r64(x86code **emitptr, DECLARE_MEMPARAMS, UINT8 sreg)
 INLINE void emit_shift_reg_imm(x86code **emitptr, UINT32 op1, UINT32 opn, UINT8 opsize, UINT8 opindex, UINT8 dreg, UINT8 imm)
 {
 	if (imm == 1)
-		emit_op_modrm_reg(emitptr, op1, OP_32BIT, opindex, dreg);
+		emit_op_modrm_reg(emitptr, op1, opsize, opindex, dreg);
 	else
-		emit_op_modrm_reg_imm8(emitptr, opn, OP_32BIT, opindex, dreg, imm);
+		emit_op_modrm_reg_imm8(emitptr, opn, opsize, opindex, dreg, imm);
 }
 
 INLINE void emit_shift_mem_imm(x86code **emitptr, UINT32 op1, UINT32 opn, UINT8 opsize, UINT8 opindex, DECLARE_MEMPARAMS, UINT8 imm)
 {
 	if (imm == 1)
-		emit_op_modrm_mem(emitptr, op1, OP_32BIT, opindex, MEMPARAMS);
+		emit_op_modrm_mem(emitptr, op1, opsize, opindex, MEMPARAMS);
 	else
-		emit_op_modrm_mem_imm8(emitptr, opn, OP_32BIT, opindex, MEMPARAMS, imm);
+		emit_op_modrm_mem_imm8(emitptr, opn, opsize, opindex, MEMPARAMS, imm);
 }
 
 
@@ -2468,8 +2482,6 @@ INLINE void emit_setcc_m8(x86code **emitptr, UINT8 cond, DECLARE_MEMPARAMS)		{ e
     SIMPLE FPU EMITTERS
 ***************************************************************************/
 
-#ifndef PTR64
-
 INLINE void emit_fnop(x86code **emitptr)     { emit_op_simple(emitptr, OP_FNOP, OP_32BIT); }
 INLINE void emit_fchs(x86code **emitptr)     { emit_op_simple(emitptr, OP_FCHS, OP_32BIT); }
 INLINE void emit_fabs(x86code **emitptr)     { emit_op_simple(emitptr, OP_FABS, OP_32BIT); }
@@ -2504,16 +2516,12 @@ INLINE void emit_finit(x86code **emitptr)    { emit_op_simple(emitptr, OP_FINIT,
 INLINE void emit_fcompp(x86code **emitptr)   { emit_op_simple(emitptr, OP_FCOMPP, OP_32BIT); }
 INLINE void emit_fstsw_ax(x86code **emitptr) { emit_op_simple(emitptr, OP_FSTSW_AX, OP_32BIT); }
 
-#endif
-
 
 
 /***************************************************************************
     REGISTER-BASED FPU EMITTERS
 ***************************************************************************/
 
-#ifndef PTR64
-
 INLINE void emit_ffree_stn(x86code **emitptr, UINT8 reg)		{ emit_op_simple(emitptr, OP_FFREE_STn + reg, OP_32BIT); }
 INLINE void emit_fst_stn(x86code **emitptr, UINT8 reg)			{ emit_op_simple(emitptr, OP_FST_STn + reg, OP_32BIT); }
 INLINE void emit_fstp_stn(x86code **emitptr, UINT8 reg)			{ emit_op_simple(emitptr, OP_FSTP_STn + reg, OP_32BIT); }
@@ -2562,16 +2570,12 @@ INLINE void emit_fsubp(x86code **emitptr)						{ emit_fsubp_stn_st0(emitptr, 1);
 INLINE void emit_fdivrp(x86code **emitptr)						{ emit_fdivrp_stn_st0(emitptr, 1); }
 INLINE void emit_fdivp(x86code **emitptr)						{ emit_fdivp_stn_st0(emitptr, 1); }
 
-#endif
-
 
 
 /***************************************************************************
     MEMORY FPU EMITTERS
 ***************************************************************************/
 
-#ifndef PTR64
-
 INLINE void emit_fadd_m32(x86code **emitptr, DECLARE_MEMPARAMS)		{ emit_op_modrm_mem(emitptr, OP_ESC_D8, OP_32BIT, 0, MEMPARAMS); }
 INLINE void emit_fmul_m32(x86code **emitptr, DECLARE_MEMPARAMS)		{ emit_op_modrm_mem(emitptr, OP_ESC_D8, OP_32BIT, 1, MEMPARAMS); }
 INLINE void emit_fcom_m32(x86code **emitptr, DECLARE_MEMPARAMS)		{ emit_op_modrm_mem(emitptr, OP_ESC_D8, OP_32BIT, 2, MEMPARAMS); }
@@ -2640,8 +2644,6 @@ INLINE void emit_fild_m64(x86code **emitptr, DECLARE_MEMPARAMS)		{ emit_op_modrm
 INLINE void emit_fbstp_m80(x86code **emitptr, DECLARE_MEMPARAMS)	{ emit_op_modrm_mem(emitptr, OP_ESC_DF, OP_32BIT, 6, MEMPARAMS); }
 INLINE void emit_fistp_m64(x86code **emitptr, DECLARE_MEMPARAMS)	{ emit_op_modrm_mem(emitptr, OP_ESC_DF, OP_32BIT, 7, MEMPARAMS); }
 
-#endif
-
 
 
 /***************************************************************************
@@ -110,6 +110,17 @@
 #define BIG_SWITCH			1
 #endif
 
+/* dispatch main opcodes through a computed goto table (GCC only) */
+#ifdef Z80_THREADED
+#define THREADED_DISPATCH	1
+#else
+#define THREADED_DISPATCH	0
+#endif
+
+#if THREADED_DISPATCH && !defined(__GNUC__)
+#error Z80_THREADED requires the GCC computed goto extension
+#endif
+
 /* big flags array for ADD/ADC/SUB/SBC/CP results */
 #define BIG_FLAGS_ARRAY		1
 
@@ -543,6 +554,134 @@ INLINE void BURNODD(int cycles, int opcodes, int cyclesum)
 #define EXEC_INLINE EXEC
 #endif
 
+#if THREADED_DISPATCH
+/***************************************************************
+ * Threaded dispatch: every main opcode gets its own copy of the
+ * fetch/dispatch sequence, so the indirect jump at the end of
+ * each one is predicted on its own
+ ***************************************************************/
+#define THREADED_NEXT											\
+{																\
+	if (Z80.irq_state != CLEAR_LINE && IFF1 && !Z80.after_ei)	\
+		take_interrupt();										\
+	Z80.after_ei = FALSE;										\
+																\
+	PRVPC = PCD;												\
+	CALL_MAME_DEBUG;											\
+	R++;														\
+	op = ROP();													\
+	CC(op,op);													\
+	goto *threaded_table[op];									\
+}
+
+#define THREADED_OP(opcode)										\
+	threaded_##opcode:											\
+	op_##opcode();												\
+	if (z80_ICount <= 0)										\
+		goto threaded_done;										\
+	THREADED_NEXT
+
+#define THREADED_TABLE											\
+	&&threaded_00, &&threaded_01, &&threaded_02, &&threaded_03, &&threaded_04, &&threaded_05, &&threaded_06, &&threaded_07, \
+	&&threaded_08, &&threaded_09, &&threaded_0a, &&threaded_0b, &&threaded_0c, &&threaded_0d, &&threaded_0e, &&threaded_0f, \
+	&&threaded_10, &&threaded_11, &&threaded_12, &&threaded_13, &&threaded_14, &&threaded_15, &&threaded_16, &&threaded_17, \
+	&&threaded_18, &&threaded_19, &&threaded_1a, &&threaded_1b, &&threaded_1c, &&threaded_1d, &&threaded_1e, &&threaded_1f, \
+	&&threaded_20, &&threaded_21, &&threaded_22, &&threaded_23, &&threaded_24, &&threaded_25, &&threaded_26, &&threaded_27, \
+	&&threaded_28, &&threaded_29, &&threaded_2a, &&threaded_2b, &&threaded_2c, &&threaded_2d, &&threaded_2e, &&threaded_2f, \
+	&&threaded_30, &&threaded_31, &&threaded_32, &&threaded_33, &&threaded_34, &&threaded_35, &&threaded_36, &&threaded_37, \
+	&&threaded_38, &&threaded_39, &&threaded_3a, &&threaded_3b, &&threaded_3c, &&threaded_3d, &&threaded_3e, &&threaded_3f, \
+	&&threaded_40, &&threaded_41, &&threaded_42, &&threaded_43, &&threaded_44, &&threaded_45, &&threaded_46, &&threaded_47, \
+	&&threaded_48, &&threaded_49, &&threaded_4a, &&threaded_4b, &&threaded_4c, &&threaded_4d, &&threaded_4e, &&threaded_4f, \
+	&&threaded_50, &&threaded_51, &&threaded_52, &&threaded_53, &&threaded_54, &&threaded_55, &&threaded_56, &&threaded_57, \
+	&&threaded_58, &&threaded_59, &&threaded_5a, &&threaded_5b, &&threaded_5c, &&threaded_5d, &&threaded_5e, &&threaded_5f, \
+	&&threaded_60, &&threaded_61, &&threaded_62, &&threaded_63, &&threaded_64, &&threaded_65, &&threaded_66, &&threaded_67, \
+	&&threaded_68, &&threaded_69, &&threaded_6a, &&threaded_6b, &&threaded_6c, &&threaded_6d, &&threaded_6e, &&threaded_6f, \
+	&&threaded_70, &&threaded_71, &&threaded_72, &&threaded_73, &&threaded_74, &&threaded_75, &&threaded_76, &&threaded_77, \
+	&&threaded_78, &&threaded_79, &&threaded_7a, &&threaded_7b, &&threaded_7c, &&threaded_7d, &&threaded_7e, &&threaded_7f, \
+	&&threaded_80, &&threaded_81, &&threaded_82, &&threaded_83, &&threaded_84, &&threaded_85, &&threaded_86, &&threaded_87, \
+	&&threaded_88, &&threaded_89, &&threaded_8a, &&threaded_8b, &&threaded_8c, &&threaded_8d, &&threaded_8e, &&threaded_8f, \
+	&&threaded_90, &&threaded_91, &&threaded_92, &&threaded_93, &&threaded_94, &&threaded_95, &&threaded_96, &&threaded_97, \
+	&&threaded_98, &&threaded_99, &&threaded_9a, &&threaded_9b, &&threaded_9c, &&threaded_9d, &&threaded_9e, &&threaded_9f, \
+	&&threaded_a0, &&threaded_a1, &&threaded_a2, &&threaded_a3, &&threaded_a4, &&threaded_a5, &&threaded_a6, &&threaded_a7, \
+	&&threaded_a8, &&threaded_a9, &&threaded_aa, &&threaded_ab, &&threaded_ac, &&threaded_ad, &&threaded_ae, &&threaded_af, \
+	&&threaded_b0, &&threaded_b1, &&threaded_b2, &&threaded_b3, &&threaded_b4, &&threaded_b5, &&threaded_b6, &&threaded_b7, \
+	&&threaded_b8, &&threaded_b9, &&threaded_ba, &&threaded_bb, &&threaded_bc, &&threaded_bd, &&threaded_be, &&threaded_bf, \
+	&&threaded_c0, &&threaded_c1, &&threaded_c2, &&threaded_c3, &&threaded_c4, &&threaded_c5, &&threaded_c6, &&threaded_c7, \
+	&&threaded_c8, &&threaded_c9, &&threaded_ca, &&threaded_cb, &&threaded_cc, &&threaded_cd, &&threaded_ce, &&threaded_cf, \
+	&&threaded_d0, &&threaded_d1, &&threaded_d2, &&threaded_d3, &&threaded_d4, &&threaded_d5, &&threaded_d6, &&threaded_d7, \
+	&&threaded_d8, &&threaded_d9, &&threaded_da, &&threaded_db, &&threaded_dc, &&threaded_dd, &&threaded_de, &&threaded_df, \
+	&&threaded_e0, &&threaded_e1, &&threaded_e2, &&threaded_e3, &&threaded_e4, &&threaded_e5, &&threaded_e6, &&threaded_e7, \
+	&&threaded_e8, &&threaded_e9, &&threaded_ea, &&threaded_eb, &&threaded_ec, &&threaded_ed, &&threaded_ee, &&threaded_ef, \
+	&&threaded_f0, &&threaded_f1, &&threaded_f2, &&threaded_f3, &&threaded_f4, &&threaded_f5, &&threaded_f6, &&threaded_f7, \
+	&&threaded_f8, &&threaded_f9, &&threaded_fa, &&threaded_fb, &&threaded_fc, &&threaded_fd, &&threaded_fe, &&threaded_ff
+
+#define THREADED_OPS											\
+	THREADED_OP(00) THREADED_OP(01) THREADED_OP(02) THREADED_OP(03) \
+	THREADED_OP(04) THREADED_OP(05) THREADED_OP(06) THREADED_OP(07) \
+	THREADED_OP(08) THREADED_OP(09) THREADED_OP(0a) THREADED_OP(0b) \
+	THREADED_OP(0c) THREADED_OP(0d) THREADED_OP(0e) THREADED_OP(0f) \
+	THREADED_OP(10) THREADED_OP(11) THREADED_OP(12) THREADED_OP(13) \
+	THREADED_OP(14) THREADED_OP(15) THREADED_OP(16) THREADED_OP(17) \
+	THREADED_OP(18) THREADED_OP(19) THREADED_OP(1a) THREADED_OP(1b) \
+	THREADED_OP(1c) THREADED_OP(1d) THREADED_OP(1e) THREADED_OP(1f) \
+	THREADED_OP(20) THREADED_OP(21) THREADED_OP(22) THREADED_OP(23) \
+	THREADED_OP(24) THREADED_OP(25) THREADED_OP(26) THREADED_OP(27) \
+	THREADED_OP(28) THREADED_OP(29) THREADED_OP(2a) THREADED_OP(2b) \
+	THREADED_OP(2c) THREADED_OP(2d) THREADED_OP(2e) THREADED_OP(2f) \
+	THREADED_OP(30) THREADED_OP(31) THREADED_OP(32) THREADED_OP(33) \
+	THREADED_OP(34) THREADED_OP(35) THREADED_OP(36) THREADED_OP(37) \
+	THREADED_OP(38) THREADED_OP(39) THREADED_OP(3a) THREADED_OP(3b) \
+	THREADED_OP(3c) THREADED_OP(3d) THREADED_OP(3e) THREADED_OP(3f) \
+	THREADED_OP(40) THREADED_OP(41) THREADED_OP(42) THREADED_OP(43) \
+	THREADED_OP(44) THREADED_OP(45) THREADED_OP(46) THREADED_OP(47) \
+	THREADED_OP(48) THREADED_OP(49) THREADED_OP(4a) THREADED_OP(4b) \
+	THREADED_OP(4c) THREADED_OP(4d) THREADED_OP(4e) THREADED_OP(4f) \
+	THREADED_OP(50) THREADED_OP(51) THREADED_OP(52) THREADED_OP(53) \
+	THREADED_OP(54) THREADED_OP(55) THREADED_OP(56) THREADED_OP(57) \
+	THREADED_OP(58) THREADED_OP(59) THREADED_OP(5a) THREADED_OP(5b) \
+	THREADED_OP(5c) THREADED_OP(5d) THREADED_OP(5e) THREADED_OP(5f) \
+	THREADED_OP(60) THREADED_OP(61) THREADED_OP(62) THREADED_OP(63) \
+	THREADED_OP(64) THREADED_OP(65) THREADED_OP(66) THREADED_OP(67) \
+	THREADED_OP(68) THREADED_OP(69) THREADED_OP(6a) THREADED_OP(6b) \
+	THREADED_OP(6c) THREADED_OP(6d) THREADED_OP(6e) THREADED_OP(6f) \
+	THREADED_OP(70) THREADED_OP(71) THREADED_OP(72) THREADED_OP(73) \
+	THREADED_OP(74) THREADED_OP(75) THREADED_OP(76) THREADED_OP(77) \
+	THREADED_OP(78) THREADED_OP(79) THREADED_OP(7a) THREADED_OP(7b) \
+	THREADED_OP(7c) THREADED_OP(7d) THREADED_OP(7e) THREADED_OP(7f) \
+	THREADED_OP(80) THREADED_OP(81) THREADED_OP(82) THREADED_OP(83) \
+	THREADED_OP(84) THREADED_OP(85) THREADED_OP(86) THREADED_OP(87) \
+	THREADED_OP(88) THREADED_OP(89) THREADED_OP(8a) THREADED_OP(8b) \
+	THREADED_OP(8c) THREADED_OP(8d) THREADED_OP(8e) THREADED_OP(8f) \
+	THREADED_OP(90) THREADED_OP(91) THREADED_OP(92) THREADED_OP(93) \
+	THREADED_OP(94) THREADED_OP(95) THREADED_OP(96) THREADED_OP(97) \
+	THREADED_OP(98) THREADED_OP(99) THREADED_OP(9a) THREADED_OP(9b) \
+	THREADED_OP(9c) THREADED_OP(9d) THREADED_OP(9e) THREADED_OP(9f) \
+	THREADED_OP(a0) THREADED_OP(a1) THREADED_OP(a2) THREADED_OP(a3) \
+	THREADED_OP(a4) THREADED_OP(a5) THREADED_OP(a6) THREADED_OP(a7) \
+	THREADED_OP(a8) THREADED_OP(a9) THREADED_OP(aa) THREADED_OP(ab) \
+	THREADED_OP(ac) THREADED_OP(ad) THREADED_OP(ae) THREADED_OP(af) \
+	THREADED_OP(b0) THREADED_OP(b1) THREADED_OP(b2) THREADED_OP(b3) \
+	THREADED_OP(b4) THREADED_OP(b5) THREADED_OP(b6) THREADED_OP(b7) \
+	THREADED_OP(b8) THREADED_OP(b9) THREADED_OP(ba) THREADED_OP(bb) \
+	THREADED_OP(bc) THREADED_OP(bd) THREADED_OP(be) THREADED_OP(bf) \
+	THREADED_OP(c0) THREADED_OP(c1) THREADED_OP(c2) THREADED_OP(c3) \
+	THREADED_OP(c4) THREADED_OP(c5) THREADED_OP(c6) THREADED_OP(c7) \
+	THREADED_OP(c8) THREADED_OP(c9) THREADED_OP(ca) THREADED_OP(cb) \
+	THREADED_OP(cc) THREADED_OP(cd) THREADED_OP(ce) THREADED_OP(cf) \
+	THREADED_OP(d0) THREADED_OP(d1) THREADED_OP(d2) THREADED_OP(d3) \
+	THREADED_OP(d4) THREADED_OP(d5) THREADED_OP(d6) THREADED_OP(d7) \
+	THREADED_OP(d8) THREADED_OP(d9) THREADED_OP(da) THREADED_OP(db) \
+	THREADED_OP(dc) THREADED_OP(dd) THREADED_OP(de) THREADED_OP(df) \
+	THREADED_OP(e0) THREADED_OP(e1) THREADED_OP(e2) THREADED_OP(e3) \
+	THREADED_OP(e4) THREADED_OP(e5) THREADED_OP(e6) THREADED_OP(e7) \
+	THREADED_OP(e8) THREADED_OP(e9) THREADED_OP(ea) THREADED_OP(eb) \
+	THREADED_OP(ec) THREADED_OP(ed) THREADED_OP(ee) THREADED_OP(ef) \
+	THREADED_OP(f0) THREADED_OP(f1) THREADED_OP(f2) THREADED_OP(f3) \
+	THREADED_OP(f4) THREADED_OP(f5) THREADED_OP(f6) THREADED_OP(f7) \
+	THREADED_OP(f8) THREADED_OP(f9) THREADED_OP(fa) THREADED_OP(fb) \
+	THREADED_OP(fc) THREADED_OP(fd) THREADED_OP(fe) THREADED_OP(ff)
+#endif
+
 
 /***************************************************************
  * Enter HALT state; write 1 to fake port on first execution
@@ -3561,6 +3700,17 @@ static int z80_execute(int cycles)
 		Z80.nmi_pending = FALSE;
 	}
 
+#if THREADED_DISPATCH
+	{
+		static const void *const threaded_table[0x100] = { THREADED_TABLE };
+		unsigned op;
+
+		/* check for IRQs before each instruction, then jump to the opcode */
+		THREADED_NEXT;
+		THREADED_OPS;
+	}
+threaded_done:
+#else
 	do
 	{
 		/* check for IRQs before each instruction */
@@ -3573,6 +3723,7 @@ static int z80_execute(int cycles)
 		R++;
 		EXEC_INLINE(op,ROP());
 	} while( z80_ICount > 0 );
+#endif
 
 	return cycles - z80_ICount;
 }
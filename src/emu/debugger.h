@@ -15,6 +15,9 @@
 #define __DEBUGGER_H__
 
 #include "mame.h"
+#ifdef MAME_PCPROFILE
+#include "pcprof.h"
+#endif
 
 
 /***************************************************************************
@@ -30,8 +33,12 @@
 
 
 /* handy macro for CPU cores */
-#ifdef MAME_DEBUG
+#if defined(MAME_DEBUG) && defined(MAME_PCPROFILE)
+#define CALL_MAME_DEBUG			do { if (Machine->debug_mode) mame_debug_hook(); if (pcprofile_active) pcprofile_hook(); } while (0)
+#elif defined(MAME_DEBUG)
 #define CALL_MAME_DEBUG			if (Machine->debug_mode) mame_debug_hook();
+#elif defined(MAME_PCPROFILE)
+#define CALL_MAME_DEBUG			if (pcprofile_active) pcprofile_hook();
 #else
 #define CALL_MAME_DEBUG
 #endif
@@ -3340,6 +3340,137 @@ void mdrawgfxzoom( mame_bitmap *dest_bmp,const gfx_element *gfx,
 }
 
 
+/***************************************************************************
+
+  Draw a list of graphic elements sharing the same gfx_element, clip and
+  transparency mode. The work common to all entries (clip against the
+  bitmap, depth dispatch, transparency setup, profiler bookkeeping) is done
+  once for the whole list; each entry is then rejected by its bounding box
+  and pen usage before being handed straight to the blitter core. Entries
+  are drawn in list order, so callers keep control of the overlap.
+
+  Entries whose scalex/scaley are not 0x10000 go through the zoom path.
+
+***************************************************************************/
+
+void drawgfx_list(mame_bitmap *dest,const gfx_element *gfx,
+		const gfx_sprite *list,int count,
+		const rectangle *clip,int transparency,int transparent_color,UINT32 flags)
+{
+	void (*core)(mame_bitmap *,const gfx_element *,unsigned int,unsigned int,int,int,int,int,
+			const rectangle *,int,int,mame_bitmap *,UINT32);
+	mame_bitmap *pri_buffer = NULL;
+	UINT32 pri_base = 0;
+	UINT32 transmask = 0;
+	int check_usage = FALSE;
+	rectangle bounds;
+	int width, height;
+	int index;
+
+	assert_always(gfx, "drawgfx_list() gfx == 0");
+
+	if (count <= 0)
+		return;
+
+	profiler_mark(PROFILER_DRAWGFX);
+
+	/* pick the blitter core for the destination depth */
+	if (dest->bpp == 8)
+		core = drawgfx_core8;
+	else if (dest->bpp == 16)
+		core = drawgfx_core16;
+	else if (dest->bpp == 32)
+		core = drawgfx_core32;
+	else
+	{
+		profiler_mark(PROFILER_END);
+		return;
+	}
+
+	/* clip once against the bitmap */
+	bounds.min_x = 0;
+	bounds.min_y = 0;
+	bounds.max_x = dest->width - 1;
+	bounds.max_y = dest->height - 1;
+	if (clip)
+		sect_rect(&bounds, clip);
+	if (bounds.min_x > bounds.max_x || bounds.min_y > bounds.max_y)
+	{
+		profiler_mark(PROFILER_END);
+		return;
+	}
+
+	/* palettized bitmaps can't do alpha */
+	if ((dest->format == BITMAP_FORMAT_INDEXED8 || dest->format == BITMAP_FORMAT_INDEXED16 || dest->format == BITMAP_FORMAT_INDEXED32) &&
+		(transparency == TRANSPARENCY_ALPHA || transparency == TRANSPARENCY_ALPHARANGE))
+	{
+		transparency = TRANSPARENCY_PEN;
+		transparent_color &= 0xff;
+	}
+
+	/* the pen usage test only depends on the transparency mode */
+	if (gfx->pen_usage && (transparency == TRANSPARENCY_PEN || transparency == TRANSPARENCY_PENS))
+	{
+		transmask = (transparency == TRANSPARENCY_PEN) ? (1 << (transparent_color & 0xff)) : transparent_color;
+		check_usage = TRUE;
+	}
+
+	/* select the priority behavior */
+	if (flags & (DRAWGFX_LIST_PRIORITY | DRAWGFX_LIST_MASK))
+		pri_buffer = priority_bitmap;
+	if (flags & DRAWGFX_LIST_PRIORITY)
+		pri_base = 1 << 31;
+
+	width = gfx->width;
+	height = gfx->height;
+
+	for (index = 0; index < count; index++)
+	{
+		const gfx_sprite *sprite = &list[index];
+		int sx = sprite->sx;
+		int sy = sprite->sy;
+		unsigned int code, color;
+		int trans = transparency;
+
+		/* scaled entries take the slow path */
+		if (sprite->scalex != 0x10000 || sprite->scaley != 0x10000)
+		{
+			common_drawgfxzoom(dest,gfx,sprite->code,sprite->color,sprite->flipx,sprite->flipy,sx,sy,
+					&bounds,transparency,transparent_color,sprite->scalex,sprite->scaley,
+					pri_buffer,sprite->priority_mask | pri_base);
+			continue;
+		}
+
+		/* trivially reject anything outside the clip */
+		if (sx > bounds.max_x || sy > bounds.max_y || sx + width <= bounds.min_x || sy + height <= bounds.min_y)
+			continue;
+
+		code = sprite->code % gfx->total_elements;
+		color = sprite->color;
+		if (!is_raw[trans])
+			color %= gfx->total_colors;
+
+		if (check_usage)
+		{
+			UINT32 usage = gfx->pen_usage[code];
+
+			/* character is totally transparent, no need to draw */
+			if ((usage & ~transmask) == 0)
+				continue;
+
+			/* character is totally opaque, can disable transparency */
+			if ((usage & transmask) == 0)
+				trans = TRANSPARENCY_NONE;
+		}
+
+		(*core)(dest,gfx,code,color,sprite->flipx,sprite->flipy,sx,sy,&bounds,trans,transparent_color,
+				pri_buffer,sprite->priority_mask | pri_base);
+	}
+
+	profiler_mark(PROFILER_END);
+}
+
+
 #else /* DECLARE */
 
 /* -------------------- included inline section --------------------- */
@@ -74,6 +74,10 @@ enum
 	DRAWMODE_SHADOW
 };
 
+/* flags for drawgfx_list() */
+#define DRAWGFX_LIST_PRIORITY	0x01	/* draw through priority_bitmap like pdrawgfx() */
+#define DRAWGFX_LIST_MASK		0x02	/* draw through priority_bitmap like mdrawgfx() */
+
 
 
 /***************************************************************************
@@ -155,6 +159,22 @@ struct _gfx_decode
 };
 
 
+/* describes a single element for drawgfx_list() */
+typedef struct _gfx_sprite gfx_sprite;
+struct _gfx_sprite
+{
+	UINT32			code;				/* element code */
+	UINT32			color;				/* color code */
+	INT32			sx;					/* left screen coordinate */
+	INT32			sy;					/* top screen coordinate */
+	UINT8			flipx;				/* non-zero to flip horizontally */
+	UINT8			flipy;				/* non-zero to flip vertically */
+	UINT32			scalex;				/* 16.16 horizontal scale; 0x10000 means 1x */
+	UINT32			scaley;				/* 16.16 vertical scale; 0x10000 means 1x */
+	UINT32			priority_mask;		/* priority mask for DRAWGFX_LIST_PRIORITY/MASK */
+};
+
+
 typedef struct _alpha_cache alpha_cache;
 struct _alpha_cache
 {
@@ -218,6 +238,10 @@ void mdrawgfxzoom( mame_bitmap *dest_bmp,const gfx_element *gfx,
 		const rectangle *clip,int transparency,int transparent_color,int scalex,int scaley,
 		UINT32 priority_mask);
 
+void drawgfx_list(mame_bitmap *dest,const gfx_element *gfx,
+		const gfx_sprite *list,int count,
+		const rectangle *clip,int transparency,int transparent_color,UINT32 flags);
+
 
 void draw_scanline8(mame_bitmap *bitmap,int x,int y,int length,const UINT8 *src,const pen_t *pens,int transparent_pen);
 void draw_scanline16(mame_bitmap *bitmap,int x,int y,int length,const UINT16 *src,const pen_t *pens,int transparent_pen);
@@ -276,6 +300,21 @@ void copyrozbitmap(mame_bitmap *dest,mame_bitmap *src,
     INLINE FUNCTIONS
 ***************************************************************************/
 
+/* fill in an unscaled gfx_sprite entry for drawgfx_list() */
+INLINE void gfx_sprite_set(gfx_sprite *sprite, UINT32 code, UINT32 color, int flipx, int flipy, int sx, int sy, UINT32 priority_mask)
+{
+	sprite->code = code;
+	sprite->color = color;
+	sprite->sx = sx;
+	sprite->sy = sy;
+	sprite->flipx = (flipx != 0);
+	sprite->flipy = (flipy != 0);
+	sprite->scalex = 0x10000;
+	sprite->scaley = 0x10000;
+	sprite->priority_mask = priority_mask;
+}
+
+
 /* Alpha blending functions */
 INLINE void alpha_set_level(int level)
 {
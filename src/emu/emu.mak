@@ -51,6 +51,7 @@ EMUOBJS = \
 	$(EMUOBJ)/mamecore.o \
 	$(EMUOBJ)/memory.o \
 	$(EMUOBJ)/output.o \
+	$(EMUOBJ)/pcprof.o \
 	$(EMUOBJ)/render.o \
 	$(EMUOBJ)/rendfont.o \
 	$(EMUOBJ)/rendlay.o \
@@ -78,12 +79,17 @@ EMUOBJS = \
 	$(EMUOBJ)/machine/eeprom.o \
 	$(EMUOBJ)/machine/generic.o \
 	$(EMUOBJ)/video/generic.o \
+	$(EMUOBJ)/video/polynew.o \
 	$(EMUOBJ)/video/resnet.o \
 	$(EMUOBJ)/video/vector.o \
 
+ifdef PROFILER
+EMUOBJS += \
+	$(EMUOBJ)/profiler.o
+endif
+
 ifdef DEBUG
 EMUOBJS += \
-	$(EMUOBJ)/profiler.o \
 	$(EMUOBJ)/debug/debugcmd.o \
 	$(EMUOBJ)/debug/debugcmt.o \
 	$(EMUOBJ)/debug/debugcon.o \
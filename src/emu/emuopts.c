@@ -66,12 +66,14 @@ const options_entry mame_core_options[] =
 	{ "record;rec",                  NULL,        0,                 "record an input file" },
 	{ "mngwrite",                    NULL,        0,                 "optional filename to write a MNG movie of the current session" },
 	{ "wavwrite",                    NULL,        0,                 "optional filename to write a WAV file of the current session" },
+	{ "soundlog",                    NULL,        0,                 "optional filename to log the sound chip register writes of the current session" },
 
 	/* performance options */
 	{ NULL,                          NULL,        OPTION_HEADER,     "CORE PERFORMANCE OPTIONS" },
 	{ "autoframeskip;afs",           "0",         OPTION_BOOLEAN,    "enable automatic frameskip selection" },
 	{ "frameskip;fs(0-10)",          "0",         0,                 "set frameskip to fixed value, 0-12 (autoframeskip must be disabled)" },
 	{ "seconds_to_run;str",          "0",         0,                 "number of emulated seconds to run before automatically exiting" },
+	{ "bench",                       "0",         0,                 "run unthrottled for this many emulated seconds, then print benchmark results as JSON" },
 	{ "throttle",                    "1",         OPTION_BOOLEAN,    "enable throttling to keep game running in sync with real time" },
 	{ "sleep",                       "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ "speed(0.01-100)",             "1.0",       0,                 "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
@@ -113,6 +115,8 @@ const options_entry mame_core_options[] =
 	{ "samplerate;sr(1000-1000000)", "48000",     0,                 "set sound output sample rate" },
 	{ "samples",                     "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
 	{ "volume;vol",                  "0",         0,                 "sound volume in decibels (-32 min, 0 max)" },
+	{ "soundslices(1-8)",            "1",         0,                 "split each sound update into this many smaller ones for lower output latency" },
+	{ "lazysound",                   "0",         OPTION_BOOLEAN,    "with -nosound, skip rendering sound chips that nothing but the speakers depends on" },
 
 	/* input options */
 	{ NULL,                          NULL,        OPTION_HEADER,     "CORE INPUT OPTIONS" },
@@ -143,6 +147,7 @@ const options_entry mame_core_options[] =
 	{ NULL,                          NULL,        OPTION_HEADER,     "CORE DEBUGGING OPTIONS" },
 	{ "log",                         "0",         OPTION_BOOLEAN,    "generate an error.log file" },
 	{ "verbose;v",                   "0",         OPTION_BOOLEAN,    "display additional diagnostic information" },
+	{ "pcprofile",                   "0",         OPTION_BOOLEAN,    "write a per-CPU instruction profile to pcprofile.txt on exit" },
 #ifdef MAME_DEBUG
 	{ "debug;d",                     "1",         OPTION_BOOLEAN,    "enable/disable debugger" },
 	{ "debugscript",                 NULL,        0,                 "script for debugger" },
@@ -150,6 +155,11 @@ const options_entry mame_core_options[] =
 	{ "debug;d",                     "1",         OPTION_DEPRECATED, "(debugger-only command)" },
 	{ "debugscript",                 NULL,        OPTION_DEPRECATED, "(debugger-only command)" },
 #endif
+#ifdef MAME_PROFILER
+	{ "profiler_trace",              NULL,        0,                 "write a Chrome trace of profiler scopes and frames to this file on exit" },
+#else
+	{ "profiler_trace",              NULL,        OPTION_DEPRECATED, "(profiler-only command)" },
+#endif
 
 	/* misc options */
 	{ NULL,                          NULL,        OPTION_HEADER,     "CORE MISC OPTIONS" },
@@ -65,11 +65,13 @@
 #define OPTION_RECORD				"record"
 #define OPTION_MNGWRITE				"mngwrite"
 #define OPTION_WAVWRITE				"wavwrite"
+#define OPTION_SOUNDLOG				"soundlog"
 
 /* core performance options */
 #define OPTION_AUTOFRAMESKIP		"autoframeskip"
 #define OPTION_FRAMESKIP			"frameskip"
 #define OPTION_SECONDS_TO_RUN		"seconds_to_run"
+#define OPTION_BENCH				"bench"
 #define OPTION_THROTTLE				"throttle"
 #define OPTION_SLEEP				"sleep"
 #define OPTION_SPEED				"speed"
@@ -106,6 +108,8 @@
 #define OPTION_SAMPLERATE			"samplerate"
 #define OPTION_SAMPLES				"samples"
 #define OPTION_VOLUME				"volume"
+#define OPTION_SOUNDSLICES			"soundslices"
+#define OPTION_LAZYSOUND			"lazysound"
 
 /* core input options */
 #define OPTION_CTRLR				"ctrlr"
@@ -131,8 +135,10 @@
 /* core debugging options */
 #define OPTION_VERBOSE				"verbose"
 #define OPTION_LOG					"log"
+#define OPTION_PCPROFILE			"pcprofile"
 #define OPTION_DEBUG				"debug"
 #define OPTION_DEBUGSCRIPT			"debugscript"
+#define OPTION_PROFILER_TRACE		"profiler_trace"
 
 /* core misc options */
 #define OPTION_BIOS					"bios"
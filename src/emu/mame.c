@@ -40,12 +40,14 @@
                 - calls generic_video_init() [video/generic.c] to initialize generic video structures
                 - calls timer_init() [timer.c] to reset the timer system
                 - calls osd_init() [osdepend.h] to do platform-specific initialization
+                - calls profiler_init() [profiler.c] to start the profiler trace
                 - calls code_init() [input.c] to initialize the input system
                 - calls input_port_init() [inptport.c] to set up the input ports
                 - calls rom_init() [romload.c] to load the game's ROMs
                 - calls memory_init() [memory.c] to process the game's memory maps
                 - calls cpuexec_init() [cpuexec.c] to initialize the CPUs
                 - calls cpuint_init() [cpuint.c] to initialize the CPU interrupts
+                - calls pcprofile_init() [pcprof.c] to set up the PC profiler
                 - calls the driver's DRIVER_INIT callback
                 - calls video_init() [video.c] to start the video system
                 - calls sound_init() [sound.c] to start the audio system
@@ -80,9 +82,11 @@
 #include "cheat.h"
 #include "debugger.h"
 #include "profiler.h"
+#include "pcprof.h"
 #include "render.h"
 #include "ui.h"
 #include "uimenu.h"
+#include "streams.h"
 
 #ifdef MAME_DEBUG
 #include "debug/debugcon.h"
@@ -167,6 +171,13 @@ struct _mame_private
 
 	/* base time */
 	time_t			base_time;
+
+	/* benchmarking */
+	osd_ticks_t		bench_start_ticks;
+	mame_time		bench_start_time;
+	UINT64			bench_start_timers;
+	osd_ticks_t		bench_start_sound_ticks;
+	osd_ticks_t		bench_start_video_ticks;
 };
 
 
@@ -262,6 +273,9 @@ static void handle_load(running_machine *machine);
 
 static void logfile_callback(running_machine *machine, const char *buffer);
 
+static void bench_start(running_machine *machine);
+static void bench_report(running_machine *machine);
+
 
 
 /***************************************************************************
@@ -367,6 +381,10 @@ int mame_execute(core_options *options)
 			/* perform a soft reset -- this takes us to the running phase */
 			soft_reset(machine, 0);
 
+			/* start the benchmark clock once everything is up */
+			if (options_get_int(mame_options(), OPTION_BENCH) > 0)
+				bench_start(machine);
+
 			/* run the CPUs until a reset or exit */
 			mame->hard_reset_pending = FALSE;
 			while ((!mame->hard_reset_pending && !mame->exit_pending) || mame->saveload_pending_file != NULL)
@@ -388,6 +406,11 @@ int mame_execute(core_options *options)
 				profiler_mark(PROFILER_END);
 			}
 
+			/* report the benchmark and write the PC profile while the CPUs and memory are still intact */
+			if (options_get_int(mame_options(), OPTION_BENCH) > 0)
+				bench_report(machine);
+			pcprofile_write_report(machine);
+
 			/* and out via the exit phase */
 			mame->current_phase = MAME_PHASE_EXIT;
 
@@ -1208,6 +1231,70 @@ static void logfile_callback(running_machine *machine, const char *buffer)
 }
 
 
+/*-------------------------------------------------
+    bench_start - snapshot the counters at the
+    start of a benchmark run
+-------------------------------------------------*/
+
+static void bench_start(running_machine *machine)
+{
+	mame_private *mame = machine->mame_data;
+
+	mame->bench_start_ticks = osd_ticks();
+	mame->bench_start_time = mame_timer_get_time();
+	mame->bench_start_timers = timer_get_fire_count();
+	mame->bench_start_sound_ticks = streams_get_callback_ticks(machine);
+	mame->bench_start_video_ticks = video_get_update_ticks();
+}
+
+
+/*-------------------------------------------------
+    bench_report - print the results of a
+    benchmark run as JSON
+-------------------------------------------------*/
+
+static void bench_report(running_machine *machine)
+{
+	mame_private *mame = machine->mame_data;
+	osd_ticks_t tps_ticks = osd_ticks_per_second();
+	double tps = (double)tps_ticks;
+	double real_seconds = (double)(osd_ticks() - mame->bench_start_ticks) / tps;
+	double emu_seconds = mame_time_to_double(sub_mame_times(mame_timer_get_time(), mame->bench_start_time));
+	sound_latency_stats latency;
+	int cpunum;
+
+	mame_printf_info("{\n");
+	mame_printf_info("  \"driver\": \"%s\",\n", machine->gamedrv->name);
+	mame_printf_info("  \"emulated_seconds\": %.6f,\n", emu_seconds);
+	mame_printf_info("  \"real_seconds\": %.6f,\n", real_seconds);
+	mame_printf_info("  \"speed_percent\": %.2f,\n", (real_seconds > 0) ? 100.0 * emu_seconds / real_seconds : 0.0);
+
+	/* cycles are counted since the last reset, which is where the benchmark starts */
+	mame_printf_info("  \"cpu\": [\n");
+	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+	{
+		UINT64 totalcycles = cpunum_gettotalcycles64(cpunum);
+		double cycles = (double)totalcycles;
+		mame_printf_info("    { \"index\": %d, \"name\": \"%s\", \"clock\": %d, \"totalcycles\": %.0f, \"cycles_per_real_second\": %.0f }%s\n",
+				cpunum, cpunum_name(cpunum), cpunum_get_clock(cpunum), cycles,
+				(real_seconds > 0) ? cycles / real_seconds : 0.0,
+				(cpunum < cpu_gettotalcpu() - 1) ? "," : "");
+	}
+	mame_printf_info("  ],\n");
+
+	mame_printf_info("  \"timer_fires\": %.0f,\n", (double)(timer_get_fire_count() - mame->bench_start_timers));
+	mame_printf_info("  \"sound_stream_seconds\": %.6f,\n", (double)(streams_get_callback_ticks(machine) - mame->bench_start_sound_ticks) / tps);
+	mame_printf_info("  \"video_update_seconds\": %.6f,\n", (double)(video_get_update_ticks() - mame->bench_start_video_ticks) / tps);
+
+	/* audio latency covers the whole run, as reported by the OSD queue */
+	sound_get_latency_stats(&latency);
+	mame_printf_info("  \"audio_underruns\": %d,\n", latency.underruns);
+	mame_printf_info("  \"audio_latency_average_ms\": %.3f,\n", latency.average_ms);
+	mame_printf_info("  \"audio_latency_max_ms\": %.3f\n", latency.max_ms);
+	mame_printf_info("}\n");
+}
+
+
 /*-------------------------------------------------
     mame_find_cpu_index - return the index of the
     given CPU, or -1 if not found
@@ -1477,6 +1564,9 @@ static void init_machine(running_machine *machine)
 	/* init the osd layer */
 	osd_init(machine);
 
+	/* start the profiler's trace, if requested */
+	profiler_init(machine);
+
 	/* initialize the input system and input ports for the game */
 	/* this must be done before memory_init in order to allow specifying */
 	/* callbacks based on input port tags */
@@ -1506,6 +1596,9 @@ static void init_machine(running_machine *machine)
 		mame_debug_init(machine);
 #endif
 
+	/* set up the PC profiler if requested */
+	pcprofile_init(machine);
+
 	/* call the game driver's init function */
 	/* this is where decryption is done and memory maps are altered */
 	/* so this location in the init order is important */
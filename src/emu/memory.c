@@ -717,6 +717,93 @@ void *memory_get_write_ptr(int cpunum, int spacenum, offs_t offset)
 }
 
 
+/*-------------------------------------------------
+    get_range_ptr - return a pointer to the RAM
+    backing a whole range of offsets, or NULL if
+    any part of it goes through a handler or does
+    not map linearly
+-------------------------------------------------*/
+
+static void *get_range_ptr(const table_data *tabledata, offs_t mask, offs_t start, offs_t end)
+{
+	const handler_data *handler;
+	offs_t offset;
+	UINT8 *base;
+	UINT8 entry;
+
+	/* reject ranges that wrap around the address space */
+	start &= mask;
+	end &= mask;
+	if (end < start)
+		return NULL;
+
+	/* the first entry must be RAM or a bank */
+	entry = tabledata->table[LEVEL1_INDEX(start)];
+	if (entry >= SUBTABLE_BASE)
+		entry = tabledata->table[LEVEL2_INDEX(entry, start)];
+	if (entry == STATIC_INVALID || entry >= STATIC_RAM || bank_ptr[entry] == NULL)
+		return NULL;
+
+	/* every other address in the range must resolve to the same entry */
+	for (offset = start; ; )
+	{
+		UINT8 l1entry = tabledata->table[LEVEL1_INDEX(offset)];
+		offs_t l1end = offset | ((1 << LEVEL2_BITS) - 1);
+
+		if (l1entry >= SUBTABLE_BASE)
+		{
+			offs_t last = MIN(l1end, end);
+			for ( ; ; offset++)
+			{
+				if (tabledata->table[LEVEL2_INDEX(l1entry, offset)] != entry)
+					return NULL;
+				if (offset == last)
+					break;
+			}
+		}
+		else if (l1entry != entry)
+			return NULL;
+
+		if (l1end >= end)
+			break;
+		offset = l1end + 1;
+	}
+
+	/* mirroring can still wrap the range inside the entry; make sure it doesn't */
+	handler = &tabledata->handlers[entry];
+	base = &bank_ptr[entry][(start - handler->offset) & handler->mask];
+	if (&bank_ptr[entry][(end - handler->offset) & handler->mask] != base + (end - start))
+		return NULL;
+	return base;
+}
+
+
+/*-------------------------------------------------
+    memory_get_read_range_ptr - return a pointer
+    to the RAM backing reads from an entire range
+    of offsets, or NULL if there isn't one
+-------------------------------------------------*/
+
+void *memory_get_read_range_ptr(int cpunum, int spacenum, offs_t start, offs_t end)
+{
+	addrspace_data *space = &cpudata[cpunum].space[spacenum];
+	return get_range_ptr(&space->read, space->mask, start, end);
+}
+
+
+/*-------------------------------------------------
+    memory_get_write_range_ptr - return a pointer
+    to the RAM backing writes to an entire range
+    of offsets, or NULL if there isn't one
+-------------------------------------------------*/
+
+void *memory_get_write_range_ptr(int cpunum, int spacenum, offs_t start, offs_t end)
+{
+	addrspace_data *space = &cpudata[cpunum].space[spacenum];
+	return get_range_ptr(&space->write, space->mask, start, end);
+}
+
+
 /*-------------------------------------------------
     memory_get_op_ptr - return a pointer to the
     base of opcode RAM associated with the given
@@ -943,6 +943,8 @@ void 		memory_set_decrypted_region(int cpunum, offs_t start, offs_t end, void *b
 void *		memory_get_read_ptr(int cpunum, int spacenum, offs_t offset);
 void *		memory_get_write_ptr(int cpunum, int spacenum, offs_t offset);
 void *		memory_get_op_ptr(int cpunum, offs_t offset, int arg);
+void *		memory_get_read_range_ptr(int cpunum, int spacenum, offs_t start, offs_t end);
+void *		memory_get_write_range_ptr(int cpunum, int spacenum, offs_t start, offs_t end);
 
 /* ----- memory banking ----- */
 void		memory_configure_bank(int banknum, int startentry, int numentries, void *base, offs_t stride);
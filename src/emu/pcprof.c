@@ -0,0 +1,484 @@
+/***************************************************************************
+
+    pcprof.c
+
+    Per-CPU instruction-level execution profiler.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************
+
+    When -pcprofile is given, this module keeps a count per program
+    counter value for every CPU in the running machine. When the
+    machine stops running, it writes pcprofile.txt with the hottest
+    basic blocks and the hottest individual instructions, disassembled.
+
+    There are two ways the counts are gathered:
+
+        * In builds with MAME_PCPROFILE defined (PCPROFILE=1 in the
+          makefile), CALL_MAME_DEBUG calls pcprofile_hook() once per
+          instruction, so every executed instruction is counted
+          exactly. Basic blocks are then recovered as runs of
+          contiguous instructions that share the same count.
+
+        * In all other builds a periodic timer samples the PC of each
+          CPU. Because the scheduler cuts the current timeslice at the
+          timer, each sample lands where the CPU was at that moment of
+          emulated time, so the counts are weighted by cycles rather
+          than by instructions. Blocks are runs of contiguous sampled
+          instructions.
+
+***************************************************************************/
+
+#include "driver.h"
+#include "pcprof.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define PCPROFILE_HASH_INITIAL	4096		/* must be a power of 2 */
+#define PCPROFILE_SAMPLE_HZ		4000
+#define PCPROFILE_TOP_BLOCKS	32
+#define PCPROFILE_TOP_PCS		64
+#define PCPROFILE_MAX_OPBYTES	64
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _pc_entry pc_entry;
+struct _pc_entry
+{
+	offs_t			pc;					/* program counter */
+	UINT32			length;				/* instruction length in address units */
+	UINT64			count;				/* hits; 0 means the slot is empty */
+};
+
+
+typedef struct _pc_block pc_block;
+struct _pc_block
+{
+	UINT32			first;				/* index of the first instruction */
+	UINT32			instructions;		/* number of instructions in the block */
+	UINT64			weight;				/* total hits over all instructions */
+};
+
+
+typedef struct _cpu_profile cpu_profile;
+struct _cpu_profile
+{
+	pc_entry *		table;				/* open-addressed hash of PCs */
+	UINT32			size;				/* number of slots (power of 2) */
+	UINT32			used;				/* number of occupied slots */
+	UINT64			total;				/* total hits recorded */
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+int pcprofile_active;
+
+static cpu_profile profile[MAX_CPU];
+static int counting;
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+#ifndef MAME_PCPROFILE
+static TIMER_CALLBACK( pcprofile_sample );
+#endif
+static void pcprofile_exit(running_machine *machine);
+
+
+
+/***************************************************************************
+    HASH TABLE
+***************************************************************************/
+
+/*-------------------------------------------------
+    hash_pc - compute the starting slot for a PC
+-------------------------------------------------*/
+
+INLINE UINT32 hash_pc(offs_t pc, UINT32 size)
+{
+	return ((pc ^ (pc >> 13)) * 2654435761U) & (size - 1);
+}
+
+
+/*-------------------------------------------------
+    table_grow - double the size of a CPU's
+    hash table and reinsert everything
+-------------------------------------------------*/
+
+static void table_grow(cpu_profile *prof)
+{
+	pc_entry *oldtable = prof->table;
+	UINT32 oldsize = prof->size;
+	UINT32 slot;
+
+	prof->size = oldsize * 2;
+	prof->table = malloc_or_die(prof->size * sizeof(prof->table[0]));
+	memset(prof->table, 0, prof->size * sizeof(prof->table[0]));
+
+	for (slot = 0; slot < oldsize; slot++)
+		if (oldtable[slot].count != 0)
+		{
+			UINT32 index = hash_pc(oldtable[slot].pc, prof->size);
+			while (prof->table[index].count != 0)
+				index = (index + 1) & (prof->size - 1);
+			prof->table[index] = oldtable[slot];
+		}
+
+	free(oldtable);
+}
+
+
+/*-------------------------------------------------
+    record_pc - add a hit for the given PC
+-------------------------------------------------*/
+
+INLINE void record_pc(cpu_profile *prof, offs_t pc)
+{
+	UINT32 index = hash_pc(pc, prof->size);
+
+	prof->total++;
+	while (prof->table[index].count != 0)
+	{
+		if (prof->table[index].pc == pc)
+		{
+			prof->table[index].count++;
+			return;
+		}
+		index = (index + 1) & (prof->size - 1);
+	}
+
+	/* new PC; keep the load factor at or below one half */
+	prof->table[index].pc = pc;
+	prof->table[index].count = 1;
+	if (++prof->used * 2 > prof->size)
+		table_grow(prof);
+}
+
+
+
+/***************************************************************************
+    INITIALIZATION AND COLLECTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    pcprofile_init - set up the profiler if it
+    was requested
+-------------------------------------------------*/
+
+void pcprofile_init(running_machine *machine)
+{
+	int cpunum;
+
+	pcprofile_active = FALSE;
+	if (!options_get_bool(mame_options(), OPTION_PCPROFILE))
+		return;
+
+	/* allocate a table for each CPU */
+	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+	{
+		cpu_profile *prof = &profile[cpunum];
+		prof->size = PCPROFILE_HASH_INITIAL;
+		prof->used = 0;
+		prof->total = 0;
+		prof->table = malloc_or_die(prof->size * sizeof(prof->table[0]));
+		memset(prof->table, 0, prof->size * sizeof(prof->table[0]));
+	}
+
+#ifdef MAME_PCPROFILE
+	/* exact counting through the per-instruction hook */
+	counting = TRUE;
+	pcprofile_active = TRUE;
+#else
+	/* no hook compiled in; fall back to sampling */
+	counting = FALSE;
+	mame_timer_pulse(MAME_TIME_IN_HZ(PCPROFILE_SAMPLE_HZ), 0, pcprofile_sample);
+#endif
+
+	add_exit_callback(machine, pcprofile_exit);
+}
+
+
+/*-------------------------------------------------
+    pcprofile_hook - count the instruction about
+    to be executed on the active CPU
+-------------------------------------------------*/
+
+void pcprofile_hook(void)
+{
+	record_pc(&profile[cpu_getactivecpu()], activecpu_get_pc());
+}
+
+
+/*-------------------------------------------------
+    pcprofile_sample - periodic timer that samples
+    the PC of every running CPU
+-------------------------------------------------*/
+
+#ifndef MAME_PCPROFILE
+static TIMER_CALLBACK( pcprofile_sample )
+{
+	int cpunum;
+
+	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+		if (!cpunum_is_suspended(cpunum, SUSPEND_ANY_REASON))
+			record_pc(&profile[cpunum], (offs_t)cpunum_get_reg(cpunum, REG_PC));
+}
+#endif
+
+
+
+/***************************************************************************
+    REPORTING
+***************************************************************************/
+
+/*-------------------------------------------------
+    read_opcode_bytes - fetch raw opcode and
+    argument bytes for the active CPU the same
+    way the debugger does
+-------------------------------------------------*/
+
+static void read_opcode_bytes(int cpunum, offs_t pc, UINT8 *opbuf, UINT8 *argbuf, int numbytes)
+{
+	int (*translate)(int, offs_t *) = (int (*)(int, offs_t *))activecpu_get_info_fct(CPUINFO_PTR_TRANSLATE);
+	int (*readop)(UINT32, int, UINT64 *) = (int (*)(UINT32, int, UINT64 *))activecpu_get_info_fct(CPUINFO_PTR_READOP);
+	int databytes = activecpu_databus_width(ADDRESS_SPACE_PROGRAM) / 8;
+	int shift = activecpu_addrbus_shift(ADDRESS_SPACE_PROGRAM);
+	int le = (activecpu_endianness() == CPU_IS_LE);
+	offs_t pcbyte = (shift < 0) ? (pc << -shift) : (pc >> shift);
+	int byte;
+
+	for (byte = 0; byte < numbytes; byte++)
+	{
+		offs_t address = pcbyte + byte;
+		const UINT8 *ptr;
+		UINT64 value;
+
+		opbuf[byte] = argbuf[byte] = 0xff;
+
+		/* shortcut if we have a custom routine */
+		if (readop != NULL && (*readop)(address, 1, &value))
+		{
+			opbuf[byte] = argbuf[byte] = value;
+			continue;
+		}
+
+		/* translate to physical and point the opcode base at it */
+		if (translate != NULL && !(*translate)(ADDRESS_SPACE_PROGRAM, &address))
+			continue;
+		memory_set_opbase(address);
+
+		/* bytes within a wider bus are stored in host order */
+		switch (databytes)
+		{
+			case 2:	address ^= le ? BYTE_XOR_LE(0) : BYTE_XOR_BE(0);	break;
+			case 4:	address ^= le ? BYTE4_XOR_LE(0) : BYTE4_XOR_BE(0);	break;
+			case 8:	address ^= le ? BYTE8_XOR_LE(0) : BYTE8_XOR_BE(0);	break;
+		}
+
+		ptr = memory_get_op_ptr(cpunum, address & ~(databytes - 1), FALSE);
+		if (ptr != NULL)
+			opbuf[byte] = ptr[address & (databytes - 1)];
+		ptr = memory_get_op_ptr(cpunum, address & ~(databytes - 1), TRUE);
+		if (ptr != NULL)
+			argbuf[byte] = ptr[address & (databytes - 1)];
+	}
+}
+
+
+/*-------------------------------------------------
+    disassemble - disassemble one instruction on
+    the given CPU, returning its length in
+    address units
+-------------------------------------------------*/
+
+static UINT32 disassemble(int cpunum, offs_t pc, char *buffer)
+{
+	UINT8 opbuf[PCPROFILE_MAX_OPBYTES], argbuf[PCPROFILE_MAX_OPBYTES];
+	int maxbytes;
+	UINT32 length;
+
+	cpuintrf_push_context(cpunum);
+	maxbytes = MIN(activecpu_max_instruction_bytes(), PCPROFILE_MAX_OPBYTES);
+	read_opcode_bytes(cpunum, pc, opbuf, argbuf, maxbytes);
+	length = activecpu_dasm(buffer, pc, opbuf, argbuf) & DASMFLAG_LENGTHMASK;
+	cpuintrf_pop_context();
+
+	return (length == 0) ? 1 : length;
+}
+
+
+/*-------------------------------------------------
+    compare_pc/compare_count/compare_weight -
+    qsort helpers
+-------------------------------------------------*/
+
+static int compare_pc(const void *p1, const void *p2)
+{
+	const pc_entry *e1 = p1, *e2 = p2;
+	return (e1->pc < e2->pc) ? -1 : (e1->pc > e2->pc);
+}
+
+static int compare_count(const void *p1, const void *p2)
+{
+	const pc_entry *e1 = p1, *e2 = p2;
+	return (e1->count > e2->count) ? -1 : (e1->count < e2->count);
+}
+
+static int compare_weight(const void *p1, const void *p2)
+{
+	const pc_block *b1 = p1, *b2 = p2;
+	return (b1->weight > b2->weight) ? -1 : (b1->weight < b2->weight);
+}
+
+
+/*-------------------------------------------------
+    write_cpu_report - write the report for a
+    single CPU
+-------------------------------------------------*/
+
+static void write_cpu_report(mame_file *file, int cpunum)
+{
+	cpu_profile *prof = &profile[cpunum];
+	int pcchars = (cpunum_logaddr_width(cpunum, ADDRESS_SPACE_PROGRAM) + 3) / 4;
+	const char *unit = counting ? "instructions" : "samples";
+	pc_entry *entries;
+	pc_block *blocks;
+	UINT32 numentries = 0, numblocks = 0;
+	UINT32 slot, index, instr;
+	char buffer[256];
+
+	mame_fprintf(file, "CPU #%d (%s): %.0f %s, %d unique PCs\n", cpunum, cpunum_name(cpunum), (double)prof->total, unit, prof->used);
+	if (prof->total == 0)
+	{
+		mame_fprintf(file, "\n");
+		return;
+	}
+
+	/* gather the occupied slots and sort them by address */
+	entries = malloc_or_die(prof->used * sizeof(entries[0]));
+	for (slot = 0; slot < prof->size; slot++)
+		if (prof->table[slot].count != 0)
+			entries[numentries++] = prof->table[slot];
+	qsort(entries, numentries, sizeof(entries[0]), compare_pc);
+
+	/* fetch instruction lengths so we can tell which PCs are contiguous */
+	for (index = 0; index < numentries; index++)
+		entries[index].length = disassemble(cpunum, entries[index].pc, buffer);
+
+	/* split into blocks: contiguous runs, and in counting mode equal counts */
+	blocks = malloc_or_die(numentries * sizeof(blocks[0]));
+	for (index = 0; index < numentries; index++)
+	{
+		pc_block *block = (numblocks > 0) ? &blocks[numblocks - 1] : NULL;
+		if (block == NULL ||
+			entries[index].pc != entries[index - 1].pc + entries[index - 1].length ||
+			(counting && entries[index].count != entries[block->first].count))
+		{
+			block = &blocks[numblocks++];
+			block->first = index;
+			block->instructions = 0;
+			block->weight = 0;
+		}
+		block->instructions++;
+		block->weight += entries[index].count;
+	}
+	qsort(blocks, numblocks, sizeof(blocks[0]), compare_weight);
+
+	/* hottest blocks, with every instruction in them */
+	mame_fprintf(file, "\n  Top basic blocks:\n");
+	for (index = 0; index < numblocks && index < PCPROFILE_TOP_BLOCKS; index++)
+	{
+		pc_block *block = &blocks[index];
+		mame_fprintf(file, "\n  %6.2f%%  %0*X-%0*X  %u instructions",
+				(double)block->weight * 100.0 / (double)prof->total,
+				pcchars, entries[block->first].pc,
+				pcchars, entries[block->first + block->instructions - 1].pc,
+				block->instructions);
+		if (counting)
+			mame_fprintf(file, ", executed %.0f times", (double)entries[block->first].count);
+		mame_fprintf(file, "\n");
+
+		for (instr = block->first; instr < block->first + block->instructions; instr++)
+		{
+			disassemble(cpunum, entries[instr].pc, buffer);
+			mame_fprintf(file, "    %0*X: %12.0f  %s\n", pcchars, entries[instr].pc, (double)entries[instr].count, buffer);
+		}
+	}
+
+	/* hottest individual PCs */
+	qsort(entries, numentries, sizeof(entries[0]), compare_count);
+	mame_fprintf(file, "\n  Top instructions:\n");
+	for (index = 0; index < numentries && index < PCPROFILE_TOP_PCS; index++)
+	{
+		disassemble(cpunum, entries[index].pc, buffer);
+		mame_fprintf(file, "  %6.2f%%  %0*X: %12.0f  %s\n",
+				(double)entries[index].count * 100.0 / (double)prof->total,
+				pcchars, entries[index].pc, (double)entries[index].count, buffer);
+	}
+	mame_fprintf(file, "\n");
+
+	free(blocks);
+	free(entries);
+}
+
+
+/*-------------------------------------------------
+    pcprofile_write_report - write pcprofile.txt;
+    this must be called while the CPU contexts and
+    memory are still intact, before the exit
+    callbacks run
+-------------------------------------------------*/
+
+void pcprofile_write_report(running_machine *machine)
+{
+	mame_file *file;
+	file_error filerr;
+	int cpunum;
+
+	if (profile[0].table == NULL)
+		return;
+	pcprofile_active = FALSE;
+
+	filerr = mame_fopen(SEARCHPATH_DEBUGLOG, "pcprofile.txt", OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, &file);
+	if (filerr == FILERR_NONE)
+	{
+		mame_fprintf(file, "PC profile for %s (%s)\n\n", machine->gamedrv->name, counting ? "exact instruction counts" : "sampled");
+		for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+			write_cpu_report(file, cpunum);
+		mame_fclose(file);
+	}
+}
+
+
+/*-------------------------------------------------
+    pcprofile_exit - free the tables
+-------------------------------------------------*/
+
+static void pcprofile_exit(running_machine *machine)
+{
+	int cpunum;
+
+	pcprofile_active = FALSE;
+	for (cpunum = 0; cpunum < cpu_gettotalcpu(); cpunum++)
+	{
+		free(profile[cpunum].table);
+		profile[cpunum].table = NULL;
+	}
+}
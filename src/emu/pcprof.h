@@ -0,0 +1,43 @@
+/***************************************************************************
+
+    pcprof.h
+
+    Per-CPU instruction-level execution profiler.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __PCPROF_H__
+#define __PCPROF_H__
+
+#include "mamecore.h"
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* non-zero when -pcprofile was given and per-instruction counting is live */
+extern int pcprofile_active;
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+/* initialize the profiler if -pcprofile was given */
+void pcprofile_init(running_machine *machine);
+
+/* write pcprofile.txt; called once the machine has stopped running */
+void pcprofile_write_report(running_machine *machine);
+
+/* call this once per instruction from CPU cores (via CALL_MAME_DEBUG) */
+void pcprofile_hook(void);
+
+
+#endif	/* __PCPROF_H__ */
@@ -7,211 +7,679 @@
     Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
     Visit http://mamedev.org for licensing and usage restrictions.
 
+****************************************************************************
+
+    Time is accumulated per call path: every distinct chain of nested
+    scopes gets its own node in a call tree, so a sound chip updated from
+    a CPU's write handler is counted separately from the same chip
+    updated at the end of the frame. The on-screen display walks this
+    tree.
+
+    When -profiler_trace is given, every completed scope (other than a
+    few very high-frequency ones) and every video frame is also recorded
+    in a ring buffer, which is written on exit as a Chrome trace JSON
+    file that can be loaded into chrome://tracing or Perfetto to look
+    for frame-time spikes.
+
 ***************************************************************************/
 
 #include "osdepend.h"
 #include "driver.h"
-#include "osinline.h"
 #include "profiler.h"
 
 
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define MEMORY				6			/* display windows averaged together */
+#define MAX_SCOPES			1024
+#define MAX_NODES			4096
+#define MAX_DEPTH			32
+#define SCOPE_HASH_SIZE		256
+#define TRACE_EVENTS		(1 << 18)	/* completed scopes kept for the trace */
+#define TRACE_FRAMES		256			/* frame times kept for the display */
+
+#define SCOPE_FRAME			(-1)		/* trace event marking a whole frame */
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _profile_scope profile_scope;
+struct _profile_scope
+{
+	const char *	name;				/* display name */
+	int				hashnext;			/* next scope in the same hash bucket */
+	UINT8			trace;				/* record individual events for the trace? */
+};
+
+
+typedef struct _profile_node profile_node;
+struct _profile_node
+{
+	int				scope;				/* scope this node counts */
+	int				parent;				/* parent node */
+	int				child;				/* first child node, or -1 */
+	int				sibling;			/* next sibling node, or -1 */
+	UINT64			ticks[MEMORY];		/* inclusive ticks per display window */
+	int				showdelay;			/* frames to keep showing an idle node */
+};
+
+
+typedef struct _profile_stack_entry profile_stack_entry;
+struct _profile_stack_entry
+{
+	int				node;				/* node being timed, or -1 if untracked */
+	int				scope;				/* scope that was entered */
+	osd_ticks_t		start;				/* ticks when it was entered */
+};
+
+
+typedef struct _trace_event trace_event;
+struct _trace_event
+{
+	osd_ticks_t		start;				/* start ticks */
+	osd_ticks_t		end;				/* end ticks */
+	int				scope;				/* scope, or SCOPE_FRAME */
+	UINT32			frame;				/* frame number for SCOPE_FRAME events */
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
 /* in usrintf.c */
 static int use_profiler;
+static int tracing;
+
+/* scopes */
+static profile_scope scope[MAX_SCOPES];
+static int scope_hash[SCOPE_HASH_SIZE];
+static int scope_count;
+
+/* call tree */
+static profile_node node[MAX_NODES];
+static int node_count;
 
+/* active scopes */
+static profile_stack_entry stack[MAX_DEPTH];
+static int stack_depth;
+static int stack_overflow;
 
-/*
- * Versions of GNU C earlier that 2.7 have big problems with the UINT64
- * so we make it into an unsigned long here.
- */
+/* display windows */
+static int memory;
+static unsigned int cpu_context_switches[MEMORY];
+
+/* frame timeline */
+static osd_ticks_t frame_start;
+static UINT32 frame_number;
+static osd_ticks_t frame_ticks[TRACE_FRAMES];
 
-#ifdef __GNUC__
-#if (__GNUC__ < 2) || ((__GNUC__ == 2) && (__GNUC_MINOR__ <= 7))
-#define UINT64		unsigned long
-#endif
-#endif
+/* trace ring buffer */
+static trace_event *trace;
+static UINT32 trace_next;
+static UINT32 trace_count;
+static const char *trace_filename;
 
-#define MEMORY 6
+/* calibration of profiling ticks against osd_ticks */
+static osd_ticks_t base_profiling_ticks;
+static osd_ticks_t base_osd_ticks;
 
-struct _profile_data
+static const char *const builtin_names[PROFILER_TOTAL] =
 {
-	UINT64 count[MEMORY][PROFILER_TOTAL];
-	unsigned int cpu_context_switches[MEMORY];
+	"CPU 1",
+	"CPU 2",
+	"CPU 3",
+	"CPU 4",
+	"CPU 5",
+	"CPU 6",
+	"CPU 7",
+	"CPU 8",
+	"Mem rd",
+	"Mem wr",
+	"Video",
+	"drawgfx",
+	"copybmp",
+	"tmdraw",
+	"tmdrroz",
+	"tmupdat",
+	"Artwork",
+	"Blit",
+	"Sound",
+	"Mixer",
+	"Callbck",
+	"Input",
+	"Movie",
+	"Logerr",
+	"Extra",
+	"User1",
+	"User2",
+	"User3",
+	"User4",
+	"Profilr",
+	"Idle",
 };
-typedef struct _profile_data profile_data;
 
-static profile_data profile;
-static int memory;
 
 
-static int FILO_type[10];
-static osd_ticks_t FILO_start[10];
-static int FILO_length;
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
 
-void profiler_start(void)
+static void profiler_exit(running_machine *machine);
+
+
+
+/***************************************************************************
+    SCOPES AND NODES
+***************************************************************************/
+
+/*-------------------------------------------------
+    hash_name - hash a scope name
+-------------------------------------------------*/
+
+static UINT32 hash_name(const char *name)
 {
-	use_profiler = 1;
-	FILO_length = 0;
+	UINT32 hash = 0;
+	while (*name != 0)
+		hash = hash * 31 + (UINT8)*name++;
+	return hash % SCOPE_HASH_SIZE;
 }
 
-void profiler_stop(void)
+
+/*-------------------------------------------------
+    add_scope - add a new scope without checking
+    for duplicates
+-------------------------------------------------*/
+
+static int add_scope(const char *name)
 {
-	use_profiler = 0;
+	UINT32 hash = hash_name(name);
+	profile_scope *newscope;
+
+	if (scope_count >= MAX_SCOPES)
+		return PROFILER_EXTRA;
+
+	newscope = &scope[scope_count];
+	newscope->name = name;
+	newscope->trace = TRUE;
+	newscope->hashnext = scope_hash[hash];
+	scope_hash[hash] = scope_count;
+	return scope_count++;
+}
+
+
+/*-------------------------------------------------
+    init_scopes - register the built-in scopes and
+    the root of the call tree, once
+-------------------------------------------------*/
+
+static void init_scopes(void)
+{
+	int hash, type;
+
+	if (scope_count != 0)
+		return;
+
+	for (hash = 0; hash < SCOPE_HASH_SIZE; hash++)
+		scope_hash[hash] = -1;
+	for (type = 0; type < PROFILER_TOTAL; type++)
+		add_scope(builtin_names[type]);
+
+	/* these fire far too often to be useful as individual trace events */
+	scope[PROFILER_MEMREAD].trace = FALSE;
+	scope[PROFILER_MEMWRITE].trace = FALSE;
+	scope[PROFILER_DRAWGFX].trace = FALSE;
+	scope[PROFILER_COPYBITMAP].trace = FALSE;
+	scope[PROFILER_LOGERROR].trace = FALSE;
+
+	/* node 0 is the root */
+	memset(&node[0], 0, sizeof(node[0]));
+	node[0].scope = PROFILER_END;
+	node[0].parent = -1;
+	node[0].child = -1;
+	node[0].sibling = -1;
+	node_count = 1;
+
+	base_profiling_ticks = osd_profiling_ticks();
+	base_osd_ticks = osd_ticks();
+}
+
+
+/*-------------------------------------------------
+    profiler_register_scope - return the scope
+    with the given name, creating it if needed
+-------------------------------------------------*/
+
+int profiler_register_scope(const char *name)
+{
+	char *copy;
+	int index;
+
+	init_scopes();
+
+	for (index = scope_hash[hash_name(name)]; index != -1; index = scope[index].hashnext)
+		if (strcmp(scope[index].name, name) == 0)
+			return index;
+
+	/* scopes live for the whole process, so names are copied */
+	copy = malloc_or_die(strlen(name) + 1);
+	strcpy(copy, name);
+	return add_scope(copy);
+}
+
+
+/*-------------------------------------------------
+    find_child - return the node for the given
+    scope under the given parent, creating it if
+    needed
+-------------------------------------------------*/
+
+INLINE int find_child(int parent, int type)
+{
+	profile_node *newnode;
+	int index;
+
+	if (parent < 0)
+		return -1;
+
+	for (index = node[parent].child; index != -1; index = node[index].sibling)
+		if (node[index].scope == type)
+			return index;
+
+	/* out of nodes: time the scope for the trace, but not for the display */
+	if (node_count >= MAX_NODES)
+		return -1;
+
+	index = node_count++;
+	newnode = &node[index];
+	memset(newnode, 0, sizeof(*newnode));
+	newnode->scope = type;
+	newnode->parent = parent;
+	newnode->child = -1;
+	newnode->sibling = node[parent].child;
+	node[parent].child = index;
+	return index;
+}
+
+
+
+/***************************************************************************
+    TIMING
+***************************************************************************/
+
+/*-------------------------------------------------
+    profiling_ticks_per_second - estimate the rate
+    of osd_profiling_ticks from osd_ticks
+-------------------------------------------------*/
+
+static double profiling_ticks_per_second(void)
+{
+	osd_ticks_t profdelta = osd_profiling_ticks() - base_profiling_ticks;
+	osd_ticks_t osddelta = osd_ticks() - base_osd_ticks;
+	osd_ticks_t tps = osd_ticks_per_second();
+
+	if (profdelta <= 0 || osddelta <= 0)
+		return (double)tps;
+	return (double)profdelta * (double)tps / (double)osddelta;
 }
 
+
+/*-------------------------------------------------
+    record_event - add a completed scope to the
+    trace ring buffer
+-------------------------------------------------*/
+
+INLINE void record_event(int type, osd_ticks_t start, osd_ticks_t end, UINT32 frame)
+{
+	trace_event *event = &trace[trace_next];
+
+	event->start = start;
+	event->end = end;
+	event->scope = type;
+	event->frame = frame;
+	trace_next = (trace_next + 1) % TRACE_EVENTS;
+	if (trace_count < TRACE_EVENTS)
+		trace_count++;
+}
+
+
+/*-------------------------------------------------
+    profiler_mark - enter a scope, or leave the
+    current one if type is PROFILER_END
+-------------------------------------------------*/
+
 void profiler_mark(int type)
 {
 	osd_ticks_t curr_ticks;
 
-
-	if (!use_profiler)
+	if (!use_profiler && !tracing)
 	{
-		FILO_length = 0;
+		stack_depth = 0;
+		stack_overflow = 0;
 		return;
 	}
 
 	if (type >= PROFILER_CPU1 && type <= PROFILER_CPU8)
-		profile.cpu_context_switches[memory]++;
+		cpu_context_switches[memory]++;
 
 	curr_ticks = osd_profiling_ticks();
 
 	if (type != PROFILER_END)
 	{
-		if (FILO_length > 0)
-		{
-			if (FILO_length >= 10)
-			{
-logerror("Profiler error: FILO buffer overflow\n");
-				return;
-			}
+		profile_stack_entry *entry;
 
-			/* handle nested calls */
-			profile.count[memory][FILO_type[FILO_length-1]] += curr_ticks - FILO_start[FILO_length-1];
+		assert(type >= 0 && type < scope_count);
+		if (stack_depth >= MAX_DEPTH)
+		{
+			if (stack_overflow++ == 0)
+				logerror("Profiler error: stack overflow\n");
+			return;
 		}
-		FILO_type[FILO_length] = type;
-		FILO_start[FILO_length] = curr_ticks;
-		FILO_length++;
+
+		entry = &stack[stack_depth];
+		entry->node = find_child((stack_depth > 0) ? stack[stack_depth - 1].node : 0, type);
+		entry->scope = type;
+		entry->start = curr_ticks;
+		stack_depth++;
 	}
 	else
 	{
-		if (FILO_length <= 0)
+		profile_stack_entry *entry;
+
+		/* ends that match a push we dropped */
+		if (stack_overflow > 0)
 		{
-logerror("Profiler error: FILO buffer underflow\n");
+			stack_overflow--;
 			return;
 		}
 
-		FILO_length--;
-		profile.count[memory][FILO_type[FILO_length]] += curr_ticks - FILO_start[FILO_length];
-		if (FILO_length > 0)
+		if (stack_depth <= 0)
 		{
-			/* handle nested calls */
-			FILO_start[FILO_length-1] = curr_ticks;
+logerror("Profiler error: stack underflow\n");
+			return;
 		}
+
+		entry = &stack[--stack_depth];
+		if (entry->node >= 0)
+			node[entry->node].ticks[memory] += curr_ticks - entry->start;
+		if (tracing && scope[entry->scope].trace)
+			record_event(entry->scope, entry->start, curr_ticks, 0);
 	}
 }
 
-const char *profiler_get_text(void)
-{
-	int i,j;
-	UINT64 total,normalize;
-	UINT64 computed;
-	static const char *names[PROFILER_TOTAL] =
-	{
-		"CPU 1  ",
-		"CPU 2  ",
-		"CPU 3  ",
-		"CPU 4  ",
-		"CPU 5  ",
-		"CPU 6  ",
-		"CPU 7  ",
-		"CPU 8  ",
-		"Mem rd ",
-		"Mem wr ",
-		"Video  ",
-		"drawgfx",
-		"copybmp",
-		"tmdraw ",
-		"tmdrroz",
-		"tmupdat",
-		"Artwork",
-		"Blit   ",
-		"Sound  ",
-		"Mixer  ",
-		"Callbck",
-		"Input  ",
-		"Movie  ",
-		"Logerr ",
-		"Extra  ",
-		"User1  ",
-		"User2  ",
-		"User3  ",
-		"User4  ",
-		"Profilr",
-		"Idle   ",
-	};
-	static int showdelay[PROFILER_TOTAL];
-	static char buf[50*40];
-	char *bufptr = buf;
 
+/*-------------------------------------------------
+    profiler_frame_update - close out the current
+    frame on the timeline
+-------------------------------------------------*/
 
-	if (!use_profiler) return "";
+void profiler_frame_update(void)
+{
+	osd_ticks_t curr_ticks;
 
-	profiler_mark(PROFILER_PROFILER);
+	if (!use_profiler && !tracing)
+		return;
 
-	computed = 0;
-	i = 0;
-	while (i < PROFILER_PROFILER)
+	curr_ticks = osd_profiling_ticks();
+	if (frame_start != 0)
 	{
-		for (j = 0;j < MEMORY;j++)
-			computed += profile.count[j][i];
-		i++;
+		frame_ticks[frame_number % TRACE_FRAMES] = curr_ticks - frame_start;
+		if (tracing)
+			record_event(SCOPE_FRAME, frame_start, curr_ticks, frame_number);
+		frame_number++;
 	}
-	normalize = computed;
-	while (i < PROFILER_TOTAL)
+	frame_start = curr_ticks;
+}
+
+
+
+/***************************************************************************
+    CONTROL
+***************************************************************************/
+
+/*-------------------------------------------------
+    profiler_init - start tracing if a trace file
+    was requested
+-------------------------------------------------*/
+
+void profiler_init(running_machine *machine)
+{
+	const char *filename = options_get_string(mame_options(), OPTION_PROFILER_TRACE);
+
+	init_scopes();
+	if (filename == NULL || filename[0] == 0)
+		return;
+
+	trace_filename = filename;
+	trace = malloc_or_die(TRACE_EVENTS * sizeof(trace[0]));
+	trace_next = 0;
+	trace_count = 0;
+	frame_start = 0;
+	frame_number = 0;
+	stack_depth = 0;
+	stack_overflow = 0;
+	tracing = TRUE;
+
+	add_exit_callback(machine, profiler_exit);
+}
+
+
+/*-------------------------------------------------
+    profiler_start/profiler_stop - show or hide
+    the on-screen display
+-------------------------------------------------*/
+
+void profiler_start(void)
+{
+	init_scopes();
+	if (!tracing)
 	{
-		for (j = 0;j < MEMORY;j++)
-			computed += profile.count[j][i];
-		i++;
+		frame_start = 0;
+		frame_number = 0;
+		stack_depth = 0;
 	}
-	total = computed;
+	use_profiler = 1;
+}
+
+void profiler_stop(void)
+{
+	use_profiler = 0;
+}
+
 
-	if (total == 0 || normalize == 0) return "";	/* we have been just reset */
 
-	for (i = 0;i < PROFILER_TOTAL;i++)
+/***************************************************************************
+    OUTPUT
+***************************************************************************/
+
+/*-------------------------------------------------
+    window_ticks - total ticks of a node over all
+    display windows
+-------------------------------------------------*/
+
+INLINE UINT64 window_ticks(const profile_node *pnode)
+{
+	UINT64 total = 0;
+	int j;
+
+	for (j = 0; j < MEMORY; j++)
+		total += pnode->ticks[j];
+	return total;
+}
+
+
+/*-------------------------------------------------
+    append_node_text - add a node and its children
+    to the display text
+-------------------------------------------------*/
+
+static char *append_node_text(char *bufptr, char *bufend, int index, int depth, UINT64 total, UINT64 normalize)
+{
+	int child;
+
+	for (child = node[index].child; child != -1; child = node[child].sibling)
 	{
-		computed = 0;
-		{
-			for (j = 0;j < MEMORY;j++)
-				computed += profile.count[j][i];
-		}
-		if (computed || showdelay[i])
+		profile_node *pnode = &node[child];
+		UINT64 computed = window_ticks(pnode);
+
+		if (bufend - bufptr < 80)
+			break;
+
+		if (computed || pnode->showdelay)
 		{
-			if (computed) showdelay[i] = SUBSECONDS_TO_HZ(Machine->screen[0].refresh);
-			showdelay[i]--;
+			if (computed) pnode->showdelay = SUBSECONDS_TO_HZ(Machine->screen[0].refresh);
+			pnode->showdelay--;
 
-			if (i < PROFILER_PROFILER)
-				bufptr += sprintf(bufptr,"%02d%% %02d%% %s\n",
+			if (pnode->scope != PROFILER_PROFILER && pnode->scope != PROFILER_IDLE)
+				bufptr += sprintf(bufptr, "%02d%% %02d%% %*s%.40s\n",
 						(int)((computed * 100 + total/2) / total),
 						(int)((computed * 100 + normalize/2) / normalize),
-						names[i]);
+						depth * 2, "", scope[pnode->scope].name);
 			else
-				bufptr += sprintf(bufptr,"%02d%% %s\n",
+				bufptr += sprintf(bufptr, "%02d%%     %*s%.40s\n",
 						(int)((computed * 100 + total/2) / total),
-						names[i]);
+						depth * 2, "", scope[pnode->scope].name);
+
+			bufptr = append_node_text(bufptr, bufend, child, depth + 1, total, normalize);
 		}
 	}
+	return bufptr;
+}
+
+
+/*-------------------------------------------------
+    profiler_get_text - return the text for the
+    on-screen display
+-------------------------------------------------*/
+
+const char *profiler_get_text(void)
+{
+	static char buf[8192];
+	char *bufptr = buf;
+	UINT64 total, normalize, worst, sum;
+	int i, j, frames;
+
+	if (!use_profiler) return "";
+
+	profiler_mark(PROFILER_PROFILER);
+
+	/* the total is everything at the top level; idle time and ourself are excluded from the normalized figure */
+	total = 0;
+	for (i = node[0].child; i != -1; i = node[i].sibling)
+		total += window_ticks(&node[i]);
+	normalize = total;
+	for (i = 1; i < node_count; i++)
+		if (node[i].scope == PROFILER_PROFILER || node[i].scope == PROFILER_IDLE)
+			normalize -= MIN(normalize, window_ticks(&node[i]));
+
+	if (total == 0 || normalize == 0)	/* we have been just reset */
+	{
+		profiler_mark(PROFILER_END);
+		return "";
+	}
+
+	bufptr = append_node_text(bufptr, buf + sizeof(buf), 0, 0, total, normalize);
 
 	i = 0;
 	for (j = 0;j < MEMORY;j++)
-		i += profile.cpu_context_switches[j];
+		i += cpu_context_switches[j];
 	bufptr += sprintf(bufptr,"%4d CPU switches\n",i / MEMORY);
 
+	/* summarize the recent frame times */
+	frames = MIN(frame_number, TRACE_FRAMES);
+	if (frames > 0)
+	{
+		double ms_per_tick = 1000.0 / profiling_ticks_per_second();
+		worst = sum = 0;
+		for (i = 0; i < frames; i++)
+		{
+			sum += frame_ticks[i];
+			worst = MAX(worst, (UINT64)frame_ticks[i]);
+		}
+		bufptr += sprintf(bufptr, "frame %.2fms avg %.2fms max\n", (double)sum * ms_per_tick / frames, (double)worst * ms_per_tick);
+	}
+
 	/* reset the counters */
 	memory = (memory + 1) % MEMORY;
-	profile.cpu_context_switches[memory] = 0;
-	for (i = 0;i < PROFILER_TOTAL;i++)
-		profile.count[memory][i] = 0;
+	cpu_context_switches[memory] = 0;
+	for (i = 0; i < node_count; i++)
+		node[i].ticks[memory] = 0;
 
 	profiler_mark(PROFILER_END);
 
 	return buf;
 }
+
+
+/*-------------------------------------------------
+    write_json_string - write a quoted, escaped
+    JSON string
+-------------------------------------------------*/
+
+static void write_json_string(mame_file *file, const char *string)
+{
+	mame_fputs(file, "\"");
+	for ( ; *string != 0; string++)
+	{
+		if (*string == '"' || *string == '\\')
+			mame_fprintf(file, "\\%c", *string);
+		else if ((UINT8)*string < 0x20)
+			mame_fprintf(file, "\\u%04x", (UINT8)*string);
+		else
+			mame_fprintf(file, "%c", *string);
+	}
+	mame_fputs(file, "\"");
+}
+
+
+/*-------------------------------------------------
+    profiler_exit - write the trace file
+-------------------------------------------------*/
+
+static void profiler_exit(running_machine *machine)
+{
+	double us_per_tick = 1000000.0 / profiling_ticks_per_second();
+	mame_file *file;
+	file_error filerr;
+	UINT32 index;
+
+	tracing = FALSE;
+
+	filerr = mame_fopen(SEARCHPATH_DEBUGLOG, trace_filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, &file);
+	if (filerr == FILERR_NONE)
+	{
+		mame_fputs(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+		mame_fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"%s\"}},\n", machine->gamedrv->name);
+		mame_fputs(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Emulation\"}},\n");
+		mame_fputs(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"Frames\"}}");
+
+		/* oldest event first */
+		for (index = 0; index < trace_count; index++)
+		{
+			trace_event *event = &trace[(trace_next + TRACE_EVENTS - trace_count + index) % TRACE_EVENTS];
+			double ts = (double)(event->start - base_profiling_ticks) * us_per_tick;
+			double dur = (double)(event->end - event->start) * us_per_tick;
+
+			if (event->scope == SCOPE_FRAME)
+				mame_fprintf(file, ",\n{\"name\":\"Frame %u\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":2}", event->frame, ts, dur);
+			else
+			{
+				mame_fputs(file, ",\n{\"name\":");
+				write_json_string(file, scope[event->scope].name);
+				mame_fprintf(file, ",\"cat\":\"scope\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}", ts, dur);
+			}
+		}
+		mame_fputs(file, "\n]}\n");
+		mame_fclose(file);
+	}
+
+	free(trace);
+	trace = NULL;
+}
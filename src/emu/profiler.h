@@ -14,7 +14,9 @@
 #ifndef __PROFILER_H__
 #define __PROFILER_H__
 
-/* profiling */
+#include "mamecore.h"
+
+/* built-in profiling scopes; further scopes are registered at runtime */
 enum
 {
 	PROFILER_END = -1,
@@ -64,18 +66,37 @@ profiler_mark(PROFILER_VIDEO);
 to end profiling the current section:
 profiler_mark(PROFILER_END);
 
-the profiler handles a FILO list so calls may be nested.
+the profiler keeps a stack of active scopes, so calls may be nested; time
+is accumulated per call path, so the same scope is reported separately
+under each parent it was entered from.
+
+To profile something that has no built-in type, register a named scope
+once and mark it like any other:
+scope = profiler_register_scope("YM2151 #0");
+profiler_mark(scope);
+...
+profiler_mark(PROFILER_END);
+
+registering the same name twice returns the same scope.
 */
 
-#ifdef MAME_DEBUG
+#ifdef MAME_PROFILER
+void profiler_init(running_machine *machine);
 void profiler_mark(int type);
+int profiler_register_scope(const char *name);
+
+/* call once per video frame to close out the frame timeline */
+void profiler_frame_update(void);
 
 /* functions called by usrintf.c */
 void profiler_start(void);
 void profiler_stop(void);
 const char *profiler_get_text(void);
 #else
+#define profiler_init(machine) do { } while (0)
 #define profiler_mark(type)
+#define profiler_register_scope(name) (0)
+#define profiler_frame_update() do { } while (0)
 
 #define profiler_start()
 #define profiler_stop()
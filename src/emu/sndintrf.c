@@ -59,6 +59,8 @@ struct _sndintrf_data
 	int				index; 			/* index of this sound chip */
 	int				clock; 			/* clock for this sound chip */
 	void *			token;			/* dynamically allocated token data */
+	const void *	logrom[SOUNDLOG_MAX_ROMS];		/* sample ROMs to include in a write log */
+	UINT32			logromlength[SOUNDLOG_MAX_ROMS];/* length of each sample ROM */
 };
 
 
@@ -476,6 +478,10 @@ static sndintrf_data *current_sound_start;
 static UINT8 sound_matrix[SOUND_COUNT][MAX_SOUND];
 static int totalsnd;
 
+static mame_file *soundlog;
+static UINT64 soundlog_time;
+static UINT8 soundlog_declared[MAX_SOUND];
+
 
 
 /***************************************************************************
@@ -645,6 +651,181 @@ int sndnum_to_sndti(int sndnum, int *index)
 
 
 
+/***************************************************************************
+    REGISTER WRITE LOGGING
+***************************************************************************/
+
+/*-------------------------------------------------
+    soundlog_varint - encode a value into a
+    buffer, returning the number of bytes used
+-------------------------------------------------*/
+
+static int soundlog_varint(UINT8 *dest, UINT64 value)
+{
+	int len = 0;
+
+	while (value >= 0x80)
+	{
+		dest[len++] = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+	dest[len++] = value;
+	return len;
+}
+
+
+/*-------------------------------------------------
+    soundlog_delta - encode the number of
+    nanoseconds since the previous record
+-------------------------------------------------*/
+
+static int soundlog_delta(UINT8 *dest)
+{
+	mame_time now = mame_timer_get_time();
+	UINT64 nsec = (UINT64)now.seconds * 1000000000 + now.subseconds / MAX_SUBSECONDS_SQRT;
+	UINT64 delta = (nsec > soundlog_time) ? nsec - soundlog_time : 0;
+
+	soundlog_time += delta;
+	return soundlog_varint(dest, delta);
+}
+
+
+/*-------------------------------------------------
+    sndintrf_log_open - start logging register
+    writes of the sound chips to a file
+-------------------------------------------------*/
+
+void sndintrf_log_open(const char *filename)
+{
+	UINT8 header[8];
+	file_error filerr;
+
+	/* if no file, nothing to do */
+	if (filename[0] == 0)
+		return;
+
+	filerr = mame_fopen(SEARCHPATH_RAW, filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, &soundlog);
+	if (filerr != FILERR_NONE)
+	{
+		mame_printf_warning("Unable to open sound log file %s\n", filename);
+		soundlog = NULL;
+		return;
+	}
+
+	memcpy(header, SOUNDLOG_MAGIC, 7);
+	header[7] = SOUNDLOG_VERSION;
+	mame_fwrite(soundlog, header, sizeof(header));
+
+	soundlog_time = 0;
+	memset(soundlog_declared, 0, sizeof(soundlog_declared));
+}
+
+
+/*-------------------------------------------------
+    sndintrf_log_close - finish off the register
+    write log
+-------------------------------------------------*/
+
+void sndintrf_log_close(void)
+{
+	UINT8 record[16];
+	int len;
+
+	if (soundlog == NULL)
+		return;
+
+	/* the end record tells the replay how long to keep rendering */
+	record[0] = SOUNDLOG_END;
+	len = 1 + soundlog_delta(&record[1]);
+	mame_fwrite(soundlog, record, len);
+
+	mame_fclose(soundlog);
+	soundlog = NULL;
+}
+
+
+/*-------------------------------------------------
+    sndti_log_write - log a register write to a
+    sound chip, declaring the chip the first
+    time it is seen
+-------------------------------------------------*/
+
+void sndti_log_write(int sndtype, int sndindex, offs_t offset, UINT32 data)
+{
+	UINT8 record[40];
+	int sndnum, romnum, len;
+
+	if (soundlog == NULL)
+		return;
+
+	VERIFY_SNDTI(sndti_log_write);
+	sndnum = sound_matrix[sndtype][sndindex] - 1;
+
+	if (!soundlog_declared[sndnum])
+	{
+		const char *name = sndtype_name(sound[sndnum].sndtype);
+		UINT8 namelen = strlen(name);
+		UINT32 clock = sound[sndnum].clock;
+
+		record[0] = SOUNDLOG_CHIP;
+		record[1] = sndnum;
+		record[2] = namelen;
+		mame_fwrite(soundlog, record, 3);
+		mame_fwrite(soundlog, name, namelen);
+		record[0] = clock >> 0;
+		record[1] = clock >> 8;
+		record[2] = clock >> 16;
+		record[3] = clock >> 24;
+		mame_fwrite(soundlog, record, 4);
+		soundlog_declared[sndnum] = TRUE;
+
+		/* follow it with any sample ROMs, so the replay needs nothing but the log */
+		for (romnum = 0; romnum < SOUNDLOG_MAX_ROMS; romnum++)
+			if (sound[sndnum].logromlength[romnum] != 0)
+			{
+				UINT32 length = sound[sndnum].logromlength[romnum];
+
+				record[0] = SOUNDLOG_ROM;
+				record[1] = sndnum;
+				record[2] = romnum;
+				record[3] = length >> 0;
+				record[4] = length >> 8;
+				record[5] = length >> 16;
+				record[6] = length >> 24;
+				mame_fwrite(soundlog, record, 7);
+				mame_fwrite(soundlog, sound[sndnum].logrom[romnum], length);
+			}
+	}
+
+	record[0] = SOUNDLOG_WRITE;
+	len = 1 + soundlog_delta(&record[1]);
+	record[len++] = sndnum;
+	len += soundlog_varint(&record[len], offset);
+	len += soundlog_varint(&record[len], data);
+	mame_fwrite(soundlog, record, len);
+}
+
+
+/*-------------------------------------------------
+    sndti_log_rom - register a sample ROM that a
+    write log needs for the chip to be replayed;
+    called from the chip's start routine
+-------------------------------------------------*/
+
+void sndti_log_rom(int sndtype, int sndindex, int romnum, const void *base, UINT32 length)
+{
+	int sndnum;
+
+	VERIFY_SNDTI(sndti_log_rom);
+	assert_always(romnum >= 0 && romnum < SOUNDLOG_MAX_ROMS, "sndti_log_rom() called with invalid ROM number!");
+	sndnum = sound_matrix[sndtype][sndindex] - 1;
+
+	sound[sndnum].logrom[romnum] = base;
+	sound[sndnum].logromlength[romnum] = (base != NULL) ? length : 0;
+}
+
+
+
 /***************************************************************************
     CHIP INTERFACES BY INDEX
 ***************************************************************************/
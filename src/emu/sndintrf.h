@@ -25,6 +25,18 @@
 
 #define MAX_SOUND 32
 
+/* register write log format (see sndintrf_log_open); all values are */
+/* little-endian and "varint" means 7 bits per byte, low bits first, */
+/* with the top bit set on every byte but the last */
+#define SOUNDLOG_MAGIC			"MSNDLOG"	/* 7 chars, followed by a version byte */
+#define SOUNDLOG_VERSION		2
+#define SOUNDLOG_MAX_ROMS		2			/* sample ROMs per chip */
+
+#define SOUNDLOG_CHIP			'C'			/* UINT8 sndnum, UINT8 namelen, name, UINT32 clock */
+#define SOUNDLOG_WRITE			'W'			/* varint delta ns, UINT8 sndnum, varint offset, varint data */
+#define SOUNDLOG_END			'E'			/* varint delta ns */
+#define SOUNDLOG_ROM			'R'			/* UINT8 sndnum, UINT8 romnum, UINT32 length, data; follows the chip's 'C' (version 2) */
+
 /* Enum listing all the sound chips */
 enum
 {
@@ -141,6 +153,8 @@ enum
 	SNDINFO_INT_FIRST = 0x00000,
 
 	SNDINFO_INT_ALIAS = SNDINFO_INT_FIRST,				/* R/O: alias to sound type for (type,index) identification */
+	SNDINFO_INT_STREAMS_THREADSAFE,						/* R/O: non-zero if stream callbacks touch only per-chip state */
+	SNDINFO_INT_STREAMS_OUTPUT_ONLY,					/* R/O: non-zero if skipping stream callbacks loses only audio (see stream_set_time_callback) */
 
 	SNDINFO_INT_CORE_SPECIFIC = 0x08000,				/* R/W: core-specific values start here */
 
@@ -245,6 +259,10 @@ void *sndti_token(int sndtype, int sndindex);
 /* driver gain controls on chip outputs */
 void sndti_set_output_gain(int type, int index, int output, float gain);
 
+/* register write logging */
+void sndti_log_write(int sndtype, int sndindex, offs_t offset, UINT32 data);
+void sndti_log_rom(int sndtype, int sndindex, int romnum, const void *base, UINT32 length);
+
 
 
 /***************************************************************************
@@ -275,6 +293,10 @@ int sndintrf_init_sound(int sndnum, int sndtype, int clock, const void *config);
 void sndintrf_exit_sound(int sndnum);
 void sndintrf_register_token(void *token);
 
+/* Register write logging */
+void sndintrf_log_open(const char *filename);
+void sndintrf_log_close(void);
+
 /* Misc helpers */
 int sndti_exists(int type, int index);
 int sndti_to_sndnum(int type, int index);
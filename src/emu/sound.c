@@ -37,7 +37,8 @@
 ***************************************************************************/
 
 #define MAX_MIXER_CHANNELS		100
-#define SOUND_UPDATE_FREQUENCY	MAME_TIME_IN_HZ(50)
+#define SOUND_UPDATE_HZ			50			/* sound updates per second, before slicing */
+#define SOUND_MAX_TRIM			328			/* largest output rate trim in 1/65536ths, about 0.5% */
 
 
 
@@ -100,8 +101,20 @@ static int totalspeakers;
 static speaker_info speaker[MAX_SPEAKER];
 
 static INT16 *finalmix;
-static UINT32 finalmix_leftover;
+static UINT32 finalmix_leftover;			/* resampler position into the next update, 16.16 */
+static INT32 finalmix_prev_left, finalmix_prev_right;	/* last clamped sample of the previous update */
 static INT32 *leftmix, *rightmix;
+static INT32 finalmix_trim;					/* output rate trim for the next update, 1/65536ths */
+
+static int sound_slices;					/* sound updates per 1/SOUND_UPDATE_HZ period */
+static int latency_slice;					/* samples in one update slice */
+static int latency_target;					/* OSD queue depth we steer towards, in samples */
+static int latency_stable;					/* updates since the target last changed */
+static int latency_resync;					/* next report follows a start or pause; don't count it */
+static int latency_updates;					/* OSD updates that reported a queue depth */
+static int latency_underruns;				/* ... and how many of those found it empty */
+static UINT64 latency_total;				/* sum of the reported queue depths */
+static int latency_max;						/* largest reported queue depth */
 
 static int sound_muted;
 static int sound_attenuation;
@@ -149,6 +162,31 @@ INLINE speaker_info *find_speaker_by_tag(const char *tag)
 }
 
 
+/*-------------------------------------------------
+    mix_add - accumulate one buffer into another;
+    kept as a plain unit-stride loop so that the
+    compiler can vectorize it
+-------------------------------------------------*/
+
+INLINE void mix_add(INT32 *dest, const stream_sample_t *src, int count)
+{
+	int sample;
+
+	for (sample = 0; sample < count; sample++)
+		dest[sample] += src[sample];
+}
+
+
+/*-------------------------------------------------
+    clamp_sample - clamp a mixed sample to 16 bits
+-------------------------------------------------*/
+
+INLINE INT32 clamp_sample(INT32 samp)
+{
+	return (samp < -32768) ? -32768 : (samp > 32767) ? 32767 : samp;
+}
+
+
 /*-------------------------------------------------
     find_sound_by_tag - find a tagged sound chip
 -------------------------------------------------*/
@@ -176,7 +214,7 @@ INLINE sound_info *find_sound_by_tag(const char *tag)
 
 void sound_init(running_machine *machine)
 {
-	mame_time update_frequency = SOUND_UPDATE_FREQUENCY;
+	mame_time update_frequency;
 	const char *filename;
 
 	/* handle -nosound */
@@ -184,6 +222,21 @@ void sound_init(running_machine *machine)
 	if (nosound_mode)
 		Machine->sample_rate = 11025;
 
+	/* split each update period into slices if lower latency was requested */
+	sound_slices = options_get_int(mame_options(), OPTION_SOUNDSLICES);
+	if (sound_slices < 1)
+		sound_slices = 1;
+	update_frequency = MAME_TIME_IN_HZ(SOUND_UPDATE_HZ * sound_slices);
+
+	/* start out asking the OSD to hold two slices' worth of samples */
+	latency_slice = Machine->sample_rate / (SOUND_UPDATE_HZ * sound_slices);
+	latency_target = 2 * latency_slice;
+	latency_stable = 0;
+	latency_resync = TRUE;
+	latency_updates = latency_underruns = latency_max = 0;
+	latency_total = 0;
+	finalmix_trim = 0;
+
 	/* count the speakers */
 	for (totalspeakers = 0; Machine->drv->speaker[totalspeakers].tag; totalspeakers++) ;
 	VPRINTF(("total speakers = %d\n", totalspeakers));
@@ -213,11 +266,17 @@ void sound_init(running_machine *machine)
 	VPRINTF(("route_sound\n"));
 	route_sound();
 
+	/* with nothing to hear, streams that only feed the speakers needn't be rendered */
+	streams_set_lazy(machine, nosound_mode && options_get_bool(mame_options(), OPTION_LAZYSOUND));
+
 	/* open the output WAV file if specified */
 	filename = options_get_string(mame_options(), OPTION_WAVWRITE);
 	if (filename[0] != 0)
 		wavfile = wav_open(filename, machine->sample_rate, 2);
 
+	/* open the register write log if specified */
+	sndintrf_log_open(options_get_string(mame_options(), OPTION_SOUNDLOG));
+
 	/* enable sound by default */
 	global_sound_enabled = TRUE;
 	sound_muted = FALSE;
@@ -243,6 +302,18 @@ static void sound_exit(running_machine *machine)
 	if (wavfile != NULL)
 		wav_close(wavfile);
 
+	/* and the register write log */
+	sndintrf_log_close();
+
+	/* report how well the OSD queue was kept fed */
+	if (latency_updates > 0)
+	{
+		sound_latency_stats stats;
+		sound_get_latency_stats(&stats);
+		mame_printf_verbose("Sound: %d updates, %d underruns, latency %.1f ms average, %.1f ms max, %.1f ms target\n",
+				stats.updates, stats.underruns, stats.average_ms, stats.max_ms, stats.target_ms);
+	}
+
 #ifdef MAME_DEBUG
 {
 	int spknum;
@@ -292,6 +363,8 @@ static void start_sound_chips(void)
 	{
 		const sound_config *msound = &Machine->drv->sound[sndnum];
 		sound_info *info;
+		char scopename[64];
+		int profiler_scope;
 		int num_regs;
 		int index;
 
@@ -323,13 +396,18 @@ static void start_sound_chips(void)
 				fatalerror("Sound chip #%d (%s) did not register any state to save!", sndnum, sndnum_name(sndnum));
 		}
 
-		/* now count the outputs */
+		/* now count the outputs, charging each stream to this chip in the profiler */
 		VPRINTF(("Counting outputs\n"));
+		sprintf(scopename, "%s #%d", sndnum_name(sndnum), sndnum);
+		profiler_scope = profiler_register_scope(scopename);
 		for (index = 0; ; index++)
 		{
 			sound_stream *stream = stream_find_by_tag(info, index);
 			if (!stream)
 				break;
+			stream_set_profiler_scope(stream, profiler_scope);
+			stream_set_threadsafe(stream, sndnum_get_info_int(sndnum, SNDINFO_INT_STREAMS_THREADSAFE));
+			stream_set_output_only(stream, sndnum_get_info_int(sndnum, SNDINFO_INT_STREAMS_OUTPUT_ONLY));
 			info->outputs += stream_get_outputs(stream);
 			VPRINTF(("  stream %p, %d outputs\n", stream, stream_get_outputs(stream)));
 		}
@@ -445,6 +523,8 @@ static void route_sound(void)
 		if (info->inputs != 0)
 		{
 			info->mixer_stream = stream_create(info->inputs, 1, Machine->sample_rate, info, mixer_update);
+			stream_set_threadsafe(info->mixer_stream, TRUE);
+			stream_set_output_only(info->mixer_stream, TRUE);
 			info->input = auto_malloc(info->inputs * sizeof(*info->input));
 			info->inputs = 0;
 		}
@@ -532,6 +612,9 @@ static void sound_pause(running_machine *machine, int pause)
 		sound_muted |= 0x02;
 	else
 		sound_muted &= ~0x02;
+
+	/* the OSD queue drains while we're paused, so that's not an underrun */
+	latency_resync = TRUE;
 	osd_set_mastervolume(sound_muted ? -32 : sound_attenuation);
 }
 
@@ -660,6 +743,57 @@ static void sound_save(int config_type, xml_data_node *parentnode)
     MIXING STAGE
 ***************************************************************************/
 
+/*-------------------------------------------------
+    latency_update - account for the OSD queue
+    depth reported by an update, adapt the target
+    depth and compute the output rate trim that
+    steers towards it
+-------------------------------------------------*/
+
+static void latency_update(int queued)
+{
+	INT32 error;
+
+	/* nothing to go on if the OSD can't measure its queue */
+	if (queued < 0)
+		return;
+
+	/* an empty queue means playback ran dry; ask for one more slice of buffering */
+	if (queued == 0 && !latency_resync)
+	{
+		latency_underruns++;
+		latency_stable = 0;
+		latency_target = MIN(latency_target + latency_slice, Machine->sample_rate / 5);
+	}
+
+	/* after five seconds without one, try to win back half a slice */
+	else if (++latency_stable >= SOUND_UPDATE_HZ * sound_slices * 5)
+	{
+		latency_stable = 0;
+		latency_target = MAX(latency_target - latency_slice / 2, 2 * latency_slice);
+	}
+	latency_resync = FALSE;
+
+	/* accumulate the statistics */
+	latency_updates++;
+	latency_total += queued;
+	if (queued > latency_max)
+		latency_max = queued;
+
+	/* only sliced updates steer the rate: produce a little more when the */
+	/* queue is short of the target, a little less when it's over */
+	if (sound_slices > 1 && !nosound_mode)
+	{
+		error = latency_target - queued;
+		if (error > latency_target)
+			error = latency_target;
+		else if (error < -latency_target)
+			error = -latency_target;
+		finalmix_trim = -(error * SOUND_MAX_TRIM) / latency_target;
+	}
+}
+
+
 /*-------------------------------------------------
     sound_update - mix everything down to
     its final form and send it to the OSD layer
@@ -675,6 +809,9 @@ static TIMER_CALLBACK( sound_update )
 
 	profiler_mark(PROFILER_SOUND);
 
+	/* bring every stream up to date, independent ones side by side */
+	streams_update_parallel(machine);
+
 	/* force all the speaker streams to generate the proper number of samples */
 	for (spknum = 0; spknum < totalspeakers; spknum++)
 	{
@@ -717,57 +854,64 @@ static TIMER_CALLBACK( sound_update )
 			/* mix if sound is enabled */
 			if (global_sound_enabled && !nosound_mode)
 			{
-				/* if the speaker is centered, send to both left and right */
-				if (spk->speaker->x == 0)
-					for (sample = 0; sample < samples_this_update; sample++)
-					{
-						leftmix[sample] += stream_buf[sample];
-						rightmix[sample] += stream_buf[sample];
-					}
-
-				/* if the speaker is to the left, send only to the left */
-				else if (spk->speaker->x < 0)
-					for (sample = 0; sample < samples_this_update; sample++)
-						leftmix[sample] += stream_buf[sample];
-
-				/* if the speaker is to the right, send only to the right */
-				else
-					for (sample = 0; sample < samples_this_update; sample++)
-						rightmix[sample] += stream_buf[sample];
+				/* centered speakers go to both sides, the others to their own side */
+				if (spk->speaker->x <= 0)
+					mix_add(leftmix, stream_buf, samples_this_update);
+				if (spk->speaker->x >= 0)
+					mix_add(rightmix, stream_buf, samples_this_update);
 			}
 		}
 	}
 
-	/* now downmix the final result */
-	finalmix_step = video_get_speed_factor();
+	/* now downmix the final result; at normal speed and untrimmed this is a straight clamp */
+	finalmix_step = (video_get_speed_factor() << 16) / 100;
+	finalmix_step += ((INT64)finalmix_step * finalmix_trim) >> 16;
 	finalmix_offset = 0;
-	for (sample = finalmix_leftover; sample < samples_this_update * 100; sample += finalmix_step)
+	if (finalmix_step == 0x10000)
+	{
+		for (sample = 0; sample < samples_this_update; sample++)
+		{
+			finalmix[finalmix_offset++] = clamp_sample(leftmix[sample]);
+			finalmix[finalmix_offset++] = clamp_sample(rightmix[sample]);
+		}
+		finalmix_leftover = 0;
+	}
+
+	/* otherwise, resample with linear interpolation in 16.16 fixed point; the */
+	/* previous update's last sample stands in ahead of the first one */
+	else
+	{
+		UINT32 end = (UINT32)samples_this_update << 16;
+		UINT32 pos;
+
+		for (pos = finalmix_leftover; pos < end; pos += finalmix_step)
+		{
+			int sampindex = pos >> 16;
+			INT32 frac = (pos & 0xffff) >> 4;
+			INT32 prev, next;
+
+			prev = (sampindex == 0) ? finalmix_prev_left : clamp_sample(leftmix[sampindex - 1]);
+			next = clamp_sample(leftmix[sampindex]);
+			finalmix[finalmix_offset++] = prev + (((next - prev) * frac) >> 12);
+
+			prev = (sampindex == 0) ? finalmix_prev_right : clamp_sample(rightmix[sampindex - 1]);
+			next = clamp_sample(rightmix[sampindex]);
+			finalmix[finalmix_offset++] = prev + (((next - prev) * frac) >> 12);
+		}
+		finalmix_leftover = pos - end;
+	}
+
+	/* remember where this update ended for the next interpolation */
+	if (samples_this_update > 0)
 	{
-		int sampindex = sample / 100;
-		INT32 samp;
-
-		/* clamp the left side */
-		samp = leftmix[sampindex];
-		if (samp < -32768)
-			samp = -32768;
-		else if (samp > 32767)
-			samp = 32767;
-		finalmix[finalmix_offset++] = samp;
-
-		/* clamp the right side */
-		samp = rightmix[sampindex];
-		if (samp < -32768)
-			samp = -32768;
-		else if (samp > 32767)
-			samp = 32767;
-		finalmix[finalmix_offset++] = samp;
+		finalmix_prev_left = clamp_sample(leftmix[samples_this_update - 1]);
+		finalmix_prev_right = clamp_sample(rightmix[samples_this_update - 1]);
 	}
-	finalmix_leftover = sample - samples_this_update * 100;
 
 	/* play the result */
 	if (finalmix_offset > 0)
 	{
-		osd_update_audio_stream(finalmix, finalmix_offset / 2);
+		latency_update(osd_update_audio_stream(finalmix, finalmix_offset / 2));
 		if (wavfile != NULL)
 			wav_add_data_16(wavfile, finalmix, finalmix_offset);
 	}
@@ -787,21 +931,14 @@ static void mixer_update(void *param, stream_sample_t **inputs, stream_sample_t
 {
 	speaker_info *speaker = param;
 	int numinputs = speaker->inputs;
-	int pos;
+	int inp;
 
 	VPRINTF(("Mixer_update(%d)\n", length));
 
-	/* loop over samples */
-	for (pos = 0; pos < length; pos++)
-	{
-		INT32 sample = inputs[0][pos];
-		int inp;
-
-		/* add up all the inputs */
-		for (inp = 1; inp < numinputs; inp++)
-			sample += inputs[inp][pos];
-		buffer[0][pos] = sample;
-	}
+	/* copy the first input, then add the others in one whole buffer at a time */
+	memcpy(buffer[0], inputs[0], length * sizeof(buffer[0][0]));
+	for (inp = 1; inp < numinputs; inp++)
+		mix_add(buffer[0], inputs[inp], length);
 }
 
 
@@ -953,3 +1090,20 @@ int sound_find_sndnum_by_tag(const char *tag)
 
 	return -1;
 }
+
+
+/*-------------------------------------------------
+    sound_get_latency_stats - return the output
+    latency statistics gathered so far
+-------------------------------------------------*/
+
+void sound_get_latency_stats(sound_latency_stats *stats)
+{
+	double ms_per_sample = 1000.0 / (double)Machine->sample_rate;
+
+	stats->updates = latency_updates;
+	stats->underruns = latency_underruns;
+	stats->target_ms = (double)latency_target * ms_per_sample;
+	stats->average_ms = (latency_updates > 0) ? (double)latency_total * ms_per_sample / (double)latency_updates : 0.0;
+	stats->max_ms = (double)latency_max * ms_per_sample;
+}
@@ -52,6 +52,18 @@ struct _sound_config
 };
 
 
+/* Output latency statistics, from the queue depths reported by the OSD */
+typedef struct _sound_latency_stats sound_latency_stats;
+struct _sound_latency_stats
+{
+	int			updates;				/* number of OSD updates that reported a queue depth */
+	int			underruns;				/* how many of those found playback had run dry */
+	double		target_ms;				/* queue depth currently being steered towards */
+	double		average_ms;				/* average audio queued ahead of playback */
+	double		max_ms;					/* most audio ever queued ahead of playback */
+};
+
+
 /* Speaker configuration for the machine driver */
 typedef struct _speaker_config speaker_config;
 struct _speaker_config
@@ -84,6 +96,7 @@ const char *sound_get_user_gain_name(int index);
 
 /* misc helpers */
 int sound_find_sndnum_by_tag(const char *tag);
+void sound_get_latency_stats(sound_latency_stats *stats);
 
 
 #endif	/* __SOUND_H__ */
@@ -117,6 +117,7 @@ WRITE8_HANDLER( YM2151_data_port_0_w )
 {
 	struct ym2151_info *token = sndti_token(SOUND_YM2151, 0);
 	stream_update(token->stream);
+	sndti_log_write(SOUND_YM2151, 0, lastreg0, data);
 	YM2151WriteReg(token->chip,lastreg0,data);
 }
 
@@ -124,6 +125,7 @@ WRITE8_HANDLER( YM2151_data_port_1_w )
 {
 	struct ym2151_info *token = sndti_token(SOUND_YM2151, 1);
 	stream_update(token->stream);
+	sndti_log_write(SOUND_YM2151, 1, lastreg1, data);
 	YM2151WriteReg(token->chip,lastreg1,data);
 }
 
@@ -131,6 +133,7 @@ WRITE8_HANDLER( YM2151_data_port_2_w )
 {
 	struct ym2151_info *token = sndti_token(SOUND_YM2151, 2);
 	stream_update(token->stream);
+	sndti_log_write(SOUND_YM2151, 2, lastreg2, data);
 	YM2151WriteReg(token->chip,lastreg2,data);
 }
 
@@ -221,6 +224,7 @@ void ym2151_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = ym2151_set_info;		break;
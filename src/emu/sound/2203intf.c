@@ -168,52 +168,62 @@ READ8_HANDLER( YM2203_read_port_4_r ) { struct ym2203_info *info = sndti_token(S
 WRITE8_HANDLER( YM2203_control_port_0_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 0);
+	sndti_log_write(SOUND_YM2203, 0, 0, data);
 	YM2203Write(info->chip,0,data);
 }
 WRITE8_HANDLER( YM2203_control_port_1_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 1);
+	sndti_log_write(SOUND_YM2203, 1, 0, data);
 	YM2203Write(info->chip,0,data);
 }
 WRITE8_HANDLER( YM2203_control_port_2_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 2);
+	sndti_log_write(SOUND_YM2203, 2, 0, data);
 	YM2203Write(info->chip,0,data);
 }
 WRITE8_HANDLER( YM2203_control_port_3_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 3);
+	sndti_log_write(SOUND_YM2203, 3, 0, data);
 	YM2203Write(info->chip,0,data);
 }
 WRITE8_HANDLER( YM2203_control_port_4_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 4);
+	sndti_log_write(SOUND_YM2203, 4, 0, data);
 	YM2203Write(info->chip,0,data);
 }
 
 WRITE8_HANDLER( YM2203_write_port_0_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 0);
+	sndti_log_write(SOUND_YM2203, 0, 1, data);
 	YM2203Write(info->chip,1,data);
 }
 WRITE8_HANDLER( YM2203_write_port_1_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 1);
+	sndti_log_write(SOUND_YM2203, 1, 1, data);
 	YM2203Write(info->chip,1,data);
 }
 WRITE8_HANDLER( YM2203_write_port_2_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 2);
+	sndti_log_write(SOUND_YM2203, 2, 1, data);
 	YM2203Write(info->chip,1,data);
 }
 WRITE8_HANDLER( YM2203_write_port_3_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 3);
+	sndti_log_write(SOUND_YM2203, 3, 1, data);
 	YM2203Write(info->chip,1,data);
 }
 WRITE8_HANDLER( YM2203_write_port_4_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 4);
+	sndti_log_write(SOUND_YM2203, 4, 1, data);
 	YM2203Write(info->chip,1,data);
 }
 
@@ -234,62 +244,92 @@ WRITE16_HANDLER( YM2203_control_port_0_lsb_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 0);
 	if (ACCESSING_LSB)
+	{
+		sndti_log_write(SOUND_YM2203, 0, 0, data & 0xff);
 		YM2203Write(info->chip,0,data);
+	}
 }
 WRITE16_HANDLER( YM2203_control_port_1_lsb_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 1);
 	if (ACCESSING_LSB)
+	{
+		sndti_log_write(SOUND_YM2203, 1, 0, data & 0xff);
 		YM2203Write(info->chip,0,data);
+	}
 }
 WRITE16_HANDLER( YM2203_control_port_2_lsb_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 2);
 	if (ACCESSING_LSB)
+	{
+		sndti_log_write(SOUND_YM2203, 2, 0, data & 0xff);
 		YM2203Write(info->chip,0,data);
+	}
 }
 WRITE16_HANDLER( YM2203_control_port_3_lsb_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 3);
 	if (ACCESSING_LSB)
+	{
+		sndti_log_write(SOUND_YM2203, 3, 0, data & 0xff);
 		YM2203Write(info->chip,0,data);
+	}
 }
 WRITE16_HANDLER( YM2203_control_port_4_lsb_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 4);
 	if (ACCESSING_LSB)
+	{
+		sndti_log_write(SOUND_YM2203, 4, 0, data & 0xff);
 		YM2203Write(info->chip,0,data);
+	}
 }
 
 WRITE16_HANDLER( YM2203_write_port_0_lsb_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 0);
 	if (ACCESSING_LSB)
+	{
+		sndti_log_write(SOUND_YM2203, 0, 1, data & 0xff);
 		YM2203Write(info->chip,1,data);
+	}
 }
 WRITE16_HANDLER( YM2203_write_port_1_lsb_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 1);
 	if (ACCESSING_LSB)
+	{
+		sndti_log_write(SOUND_YM2203, 1, 1, data & 0xff);
 		YM2203Write(info->chip,1,data);
+	}
 }
 WRITE16_HANDLER( YM2203_write_port_2_lsb_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 2);
 	if (ACCESSING_LSB)
+	{
+		sndti_log_write(SOUND_YM2203, 2, 1, data & 0xff);
 		YM2203Write(info->chip,1,data);
+	}
 }
 WRITE16_HANDLER( YM2203_write_port_3_lsb_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 3);
 	if (ACCESSING_LSB)
+	{
+		sndti_log_write(SOUND_YM2203, 3, 1, data & 0xff);
 		YM2203Write(info->chip,1,data);
+	}
 }
 WRITE16_HANDLER( YM2203_write_port_4_lsb_w )
 {
 	struct ym2203_info *info = sndti_token(SOUND_YM2203, 4);
 	if (ACCESSING_LSB)
+	{
+		sndti_log_write(SOUND_YM2203, 4, 1, data & 0xff);
 		YM2203Write(info->chip,1,data);
+	}
 }
 
 
@@ -331,6 +371,8 @@ void ym2203_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
+		case SNDINFO_INT_STREAMS_OUTPUT_ONLY:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = ym2203_set_info;		break;
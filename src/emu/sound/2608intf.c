@@ -145,6 +145,7 @@ static void *ym2608_start(int sndindex, int clock, const void *config)
 	/* setup adpcm buffers */
 	pcmbufa  = (void *)(memory_region(info->intf->pcmrom));
 	pcmsizea = memory_region_length(info->intf->pcmrom);
+	sndti_log_rom(SOUND_YM2608, sndindex, 0, pcmbufa, pcmsizea);
 
 	/* initialize YM2608 */
 	info->chip = YM2608Init(info,sndindex,clock,rate,
@@ -226,12 +227,14 @@ READ8_HANDLER( YM2608_read_port_1_r ){
 WRITE8_HANDLER( YM2608_control_port_0_A_w )
 {
 	struct ym2608_info *info = sndti_token(SOUND_YM2608, 0);
+	sndti_log_write(SOUND_YM2608, 0, 0, data);
 	YM2608Write(info->chip,0,data);
 }
 
 WRITE8_HANDLER( YM2608_control_port_0_B_w )
 {
 	struct ym2608_info *info = sndti_token(SOUND_YM2608, 0);
+	sndti_log_write(SOUND_YM2608, 0, 2, data);
 	YM2608Write(info->chip,2,data);
 }
 
@@ -241,11 +244,13 @@ WRITE8_HANDLER( YM2608_control_port_0_B_w )
 /************************************************/
 WRITE8_HANDLER( YM2608_control_port_1_A_w ){
 	struct ym2608_info *info = sndti_token(SOUND_YM2608, 1);
+	sndti_log_write(SOUND_YM2608, 1, 0, data);
 	YM2608Write(info->chip,0,data);
 }
 
 WRITE8_HANDLER( YM2608_control_port_1_B_w ){
 	struct ym2608_info *info = sndti_token(SOUND_YM2608, 1);
+	sndti_log_write(SOUND_YM2608, 1, 2, data);
 	YM2608Write(info->chip,2,data);
 }
 
@@ -256,12 +261,14 @@ WRITE8_HANDLER( YM2608_control_port_1_B_w ){
 WRITE8_HANDLER( YM2608_data_port_0_A_w )
 {
 	struct ym2608_info *info = sndti_token(SOUND_YM2608, 0);
+	sndti_log_write(SOUND_YM2608, 0, 1, data);
 	YM2608Write(info->chip,1,data);
 }
 
 WRITE8_HANDLER( YM2608_data_port_0_B_w )
 {
 	struct ym2608_info *info = sndti_token(SOUND_YM2608, 0);
+	sndti_log_write(SOUND_YM2608, 0, 3, data);
 	YM2608Write(info->chip,3,data);
 }
 
@@ -271,10 +278,12 @@ WRITE8_HANDLER( YM2608_data_port_0_B_w )
 /************************************************/
 WRITE8_HANDLER( YM2608_data_port_1_A_w ){
 	struct ym2608_info *info = sndti_token(SOUND_YM2608, 1);
+	sndti_log_write(SOUND_YM2608, 1, 1, data);
 	YM2608Write(info->chip,1,data);
 }
 WRITE8_HANDLER( YM2608_data_port_1_B_w ){
 	struct ym2608_info *info = sndti_token(SOUND_YM2608, 1);
+	sndti_log_write(SOUND_YM2608, 1, 3, data);
 	YM2608Write(info->chip,3,data);
 }
 
@@ -149,6 +149,8 @@ static void *ym2610_start(int sndindex, int clock, const void *config)
 	pcmsizea = memory_region_length(info->intf->pcmroma);
 	pcmbufb  = (void *)(memory_region(info->intf->pcmromb));
 	pcmsizeb = memory_region_length(info->intf->pcmromb);
+	sndti_log_rom(sound_type, sndindex, 0, pcmbufa, pcmsizea);
+	sndti_log_rom(sound_type, sndindex, 1, pcmbufb, pcmsizeb);
 
 	/**** initialize YM2610 ****/
 	info->chip = YM2610Init(info,sndindex,clock,rate,
@@ -200,6 +202,8 @@ static void *ym2610b_start(int sndindex, int clock, const void *config)
 	pcmsizea = memory_region_length(info->intf->pcmroma);
 	pcmbufb  = (void *)(memory_region(info->intf->pcmromb));
 	pcmsizeb = memory_region_length(info->intf->pcmromb);
+	sndti_log_rom(sound_type, sndindex, 0, pcmbufa, pcmsizea);
+	sndti_log_rom(sound_type, sndindex, 1, pcmbufb, pcmsizeb);
 
 	/**** initialize YM2610 ****/
 	info->chip = YM2610Init(info,sndindex,clock,rate,
@@ -314,6 +318,7 @@ WRITE8_HANDLER( YM2610_control_port_0_A_w )
 {
 //logerror("PC %04x: 2610 Reg A %02X",activecpu_get_pc(),data);
 	struct ym2610_info *info = sndti_token(sound_type,0);
+	sndti_log_write(sound_type, 0, 0, data);
 	YM2610Write(info->chip,0,data);
 }
 
@@ -323,6 +328,7 @@ WRITE16_HANDLER( YM2610_control_port_0_A_lsb_w )
 	if (ACCESSING_LSB)
 	{
 		struct ym2610_info *info = sndti_token(sound_type,0);
+		sndti_log_write(sound_type, 0, 0, data & 0xff);
 		YM2610Write(info->chip,0,data);
 	}
 }
@@ -331,6 +337,7 @@ WRITE8_HANDLER( YM2610_control_port_0_B_w )
 {
 //logerror("PC %04x: 2610 Reg B %02X",activecpu_get_pc(),data);
 	struct ym2610_info *info = sndti_token(sound_type,0);
+	sndti_log_write(sound_type, 0, 2, data);
 	YM2610Write(info->chip,2,data);
 }
 
@@ -340,6 +347,7 @@ WRITE16_HANDLER( YM2610_control_port_0_B_lsb_w )
 	if (ACCESSING_LSB)
 	{
 		struct ym2610_info *info = sndti_token(sound_type,0);
+		sndti_log_write(sound_type, 0, 2, data & 0xff);
 		YM2610Write(info->chip,2,data);
 	}
 }
@@ -350,6 +358,7 @@ WRITE16_HANDLER( YM2610_control_port_0_B_lsb_w )
 /************************************************/
 WRITE8_HANDLER( YM2610_control_port_1_A_w ){
 	struct ym2610_info *info = sndti_token(sound_type,1);
+	sndti_log_write(sound_type, 1, 0, data);
 	YM2610Write(info->chip,0,data);
 }
 
@@ -357,12 +366,14 @@ WRITE16_HANDLER( YM2610_control_port_1_A_lsb_w ){
 	if (ACCESSING_LSB)
 	{
 		struct ym2610_info *info = sndti_token(sound_type,1);
+		sndti_log_write(sound_type, 1, 0, data & 0xff);
 		YM2610Write(info->chip,0,data);
 	}
 }
 
 WRITE8_HANDLER( YM2610_control_port_1_B_w ){
 	struct ym2610_info *info = sndti_token(sound_type,1);
+	sndti_log_write(sound_type, 1, 2, data);
 	YM2610Write(info->chip,2,data);
 }
 
@@ -370,6 +381,7 @@ WRITE16_HANDLER( YM2610_control_port_1_B_lsb_w ){
 	if (ACCESSING_LSB)
 	{
 		struct ym2610_info *info = sndti_token(sound_type,1);
+		sndti_log_write(sound_type, 1, 2, data & 0xff);
 		YM2610Write(info->chip,2,data);
 	}
 }
@@ -382,6 +394,7 @@ WRITE8_HANDLER( YM2610_data_port_0_A_w )
 {
 //logerror(" =%02X\n",data);
 	struct ym2610_info *info = sndti_token(sound_type,0);
+	sndti_log_write(sound_type, 0, 1, data);
 	YM2610Write(info->chip,1,data);
 }
 
@@ -391,6 +404,7 @@ WRITE16_HANDLER( YM2610_data_port_0_A_lsb_w )
 	if (ACCESSING_LSB)
 	{
 		struct ym2610_info *info = sndti_token(sound_type,0);
+		sndti_log_write(sound_type, 0, 1, data & 0xff);
 		YM2610Write(info->chip,1,data);
 	}
 }
@@ -399,6 +413,7 @@ WRITE8_HANDLER( YM2610_data_port_0_B_w )
 {
 //logerror(" =%02X\n",data);
 	struct ym2610_info *info = sndti_token(sound_type,0);
+	sndti_log_write(sound_type, 0, 3, data);
 	YM2610Write(info->chip,3,data);
 }
 
@@ -408,6 +423,7 @@ WRITE16_HANDLER( YM2610_data_port_0_B_lsb_w )
 	if (ACCESSING_LSB)
 	{
 		struct ym2610_info *info = sndti_token(sound_type,0);
+		sndti_log_write(sound_type, 0, 3, data & 0xff);
 		YM2610Write(info->chip,3,data);
 	}
 }
@@ -418,6 +434,7 @@ WRITE16_HANDLER( YM2610_data_port_0_B_lsb_w )
 /************************************************/
 WRITE8_HANDLER( YM2610_data_port_1_A_w ){
 	struct ym2610_info *info = sndti_token(sound_type,1);
+	sndti_log_write(sound_type, 1, 1, data);
 	YM2610Write(info->chip,1,data);
 }
 
@@ -425,12 +442,14 @@ WRITE16_HANDLER( YM2610_data_port_1_A_lsb_w ){
 	if (ACCESSING_LSB)
 	{
 		struct ym2610_info *info = sndti_token(sound_type,1);
+		sndti_log_write(sound_type, 1, 1, data & 0xff);
 		YM2610Write(info->chip,1,data);
 	}
 }
 
 WRITE8_HANDLER( YM2610_data_port_1_B_w ){
 	struct ym2610_info *info = sndti_token(sound_type,1);
+	sndti_log_write(sound_type, 1, 3, data);
 	YM2610Write(info->chip,3,data);
 }
 
@@ -438,6 +457,7 @@ WRITE16_HANDLER( YM2610_data_port_1_B_lsb_w ){
 	if (ACCESSING_LSB)
 	{
 		struct ym2610_info *info = sndti_token(sound_type,1);
+		sndti_log_write(sound_type, 1, 3, data & 0xff);
 		YM2610Write(info->chip,3,data);
 	}
 }
@@ -465,6 +485,7 @@ void ym2610_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = ym2610_set_info;		break;
@@ -502,6 +523,7 @@ void ym2610b_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = ym2610b_set_info;		break;
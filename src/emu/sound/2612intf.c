@@ -183,12 +183,14 @@ READ8_HANDLER( YM2612_read_port_1_r ){
 WRITE8_HANDLER( YM2612_control_port_0_A_w )
 {
   struct ym2612_info *info = sndti_token(SOUND_YM2612,0);
+  sndti_log_write(SOUND_YM2612, 0, 0, data);
   YM2612Write(info->chip,0,data);
 }
 
 WRITE8_HANDLER( YM2612_control_port_0_B_w )
 {
   struct ym2612_info *info = sndti_token(SOUND_YM2612,0);
+  sndti_log_write(SOUND_YM2612, 0, 2, data);
   YM2612Write(info->chip,2,data);
 }
 
@@ -198,11 +200,13 @@ WRITE8_HANDLER( YM2612_control_port_0_B_w )
 /************************************************/
 WRITE8_HANDLER( YM2612_control_port_1_A_w ){
   struct ym2612_info *info = sndti_token(SOUND_YM2612,1);
+  sndti_log_write(SOUND_YM2612, 1, 0, data);
   YM2612Write(info->chip,0,data);
 }
 
 WRITE8_HANDLER( YM2612_control_port_1_B_w ){
   struct ym2612_info *info = sndti_token(SOUND_YM2612,1);
+  sndti_log_write(SOUND_YM2612, 1, 2, data);
   YM2612Write(info->chip,2,data);
 }
 
@@ -213,12 +217,14 @@ WRITE8_HANDLER( YM2612_control_port_1_B_w ){
 WRITE8_HANDLER( YM2612_data_port_0_A_w )
 {
   struct ym2612_info *info = sndti_token(SOUND_YM2612,0);
+  sndti_log_write(SOUND_YM2612, 0, 1, data);
   YM2612Write(info->chip,1,data);
 }
 
 WRITE8_HANDLER( YM2612_data_port_0_B_w )
 {
   struct ym2612_info *info = sndti_token(SOUND_YM2612,0);
+  sndti_log_write(SOUND_YM2612, 0, 3, data);
   YM2612Write(info->chip,3,data);
 }
 
@@ -228,10 +234,12 @@ WRITE8_HANDLER( YM2612_data_port_0_B_w )
 /************************************************/
 WRITE8_HANDLER( YM2612_data_port_1_A_w ){
   struct ym2612_info *info = sndti_token(SOUND_YM2612,1);
+  sndti_log_write(SOUND_YM2612, 1, 1, data);
   YM2612Write(info->chip,1,data);
 }
 WRITE8_HANDLER( YM2612_data_port_1_B_w ){
   struct ym2612_info *info = sndti_token(SOUND_YM2612,1);
+  sndti_log_write(SOUND_YM2612, 1, 3, data);
   YM2612Write(info->chip,3,data);
 }
 
@@ -287,12 +295,14 @@ READ8_HANDLER( YM3438_read_port_1_r ){
 WRITE8_HANDLER( YM3438_control_port_0_A_w )
 {
   struct ym2612_info *info = sndti_token(SOUND_YM3438,0);
+  sndti_log_write(SOUND_YM3438, 0, 0, data);
   YM2612Write(info->chip,0,data);
 }
 
 WRITE8_HANDLER( YM3438_control_port_0_B_w )
 {
   struct ym2612_info *info = sndti_token(SOUND_YM3438,0);
+  sndti_log_write(SOUND_YM3438, 0, 2, data);
   YM2612Write(info->chip,2,data);
 }
 
@@ -302,11 +312,13 @@ WRITE8_HANDLER( YM3438_control_port_0_B_w )
 /************************************************/
 WRITE8_HANDLER( YM3438_control_port_1_A_w ){
   struct ym2612_info *info = sndti_token(SOUND_YM3438,1);
+  sndti_log_write(SOUND_YM3438, 1, 0, data);
   YM2612Write(info->chip,0,data);
 }
 
 WRITE8_HANDLER( YM3438_control_port_1_B_w ){
   struct ym2612_info *info = sndti_token(SOUND_YM3438,1);
+  sndti_log_write(SOUND_YM3438, 1, 2, data);
   YM2612Write(info->chip,2,data);
 }
 
@@ -317,12 +329,14 @@ WRITE8_HANDLER( YM3438_control_port_1_B_w ){
 WRITE8_HANDLER( YM3438_data_port_0_A_w )
 {
   struct ym2612_info *info = sndti_token(SOUND_YM3438,0);
+  sndti_log_write(SOUND_YM3438, 0, 1, data);
   YM2612Write(info->chip,1,data);
 }
 
 WRITE8_HANDLER( YM3438_data_port_0_B_w )
 {
   struct ym2612_info *info = sndti_token(SOUND_YM3438,0);
+  sndti_log_write(SOUND_YM3438, 0, 3, data);
   YM2612Write(info->chip,3,data);
 }
 
@@ -332,10 +346,12 @@ WRITE8_HANDLER( YM3438_data_port_0_B_w )
 /************************************************/
 WRITE8_HANDLER( YM3438_data_port_1_A_w ){
   struct ym2612_info *info = sndti_token(SOUND_YM3438,1);
+  sndti_log_write(SOUND_YM3438, 1, 1, data);
   YM2612Write(info->chip,1,data);
 }
 WRITE8_HANDLER( YM3438_data_port_1_B_w ){
   struct ym2612_info *info = sndti_token(SOUND_YM3438,1);
+  sndti_log_write(SOUND_YM3438, 1, 3, data);
   YM2612Write(info->chip,3,data);
 }
 
@@ -359,6 +375,8 @@ void ym2612_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
+		case SNDINFO_INT_STREAMS_OUTPUT_ONLY:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = ym2612_set_info;		break;
@@ -393,6 +411,8 @@ void ym3438_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
+		case SNDINFO_INT_STREAMS_OUTPUT_ONLY:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = ym3438_set_info;		break;
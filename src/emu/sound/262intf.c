@@ -117,18 +117,22 @@ READ8_HANDLER( YMF262_status_0_r ) {
 }
 WRITE8_HANDLER( YMF262_register_A_0_w ) {
 	struct ymf262_info *info = sndti_token(SOUND_YMF262, 0);
+	sndti_log_write(SOUND_YMF262, 0, 0, data);
 	YMF262Write(info->chip, 0, data);
 }
 WRITE8_HANDLER( YMF262_data_A_0_w ) {
 	struct ymf262_info *info = sndti_token(SOUND_YMF262, 0);
+	sndti_log_write(SOUND_YMF262, 0, 1, data);
 	YMF262Write(info->chip, 1, data);
 }
 WRITE8_HANDLER( YMF262_register_B_0_w ) {
 	struct ymf262_info *info = sndti_token(SOUND_YMF262, 0);
+	sndti_log_write(SOUND_YMF262, 0, 2, data);
 	YMF262Write(info->chip, 2, data);
 }
 WRITE8_HANDLER( YMF262_data_B_0_w ) {
 	struct ymf262_info *info = sndti_token(SOUND_YMF262, 0);
+	sndti_log_write(SOUND_YMF262, 0, 3, data);
 	YMF262Write(info->chip, 3, data);
 }
 
@@ -139,18 +143,22 @@ READ8_HANDLER( YMF262_status_1_r ) {
 }
 WRITE8_HANDLER( YMF262_register_A_1_w ) {
 	struct ymf262_info *info = sndti_token(SOUND_YMF262, 1);
+	sndti_log_write(SOUND_YMF262, 1, 0, data);
 	YMF262Write(info->chip, 0, data);
 }
 WRITE8_HANDLER( YMF262_data_A_1_w ) {
 	struct ymf262_info *info = sndti_token(SOUND_YMF262, 1);
+	sndti_log_write(SOUND_YMF262, 1, 1, data);
 	YMF262Write(info->chip, 1, data);
 }
 WRITE8_HANDLER( YMF262_register_B_1_w ) {
 	struct ymf262_info *info = sndti_token(SOUND_YMF262, 1);
+	sndti_log_write(SOUND_YMF262, 1, 2, data);
 	YMF262Write(info->chip, 2, data);
 }
 WRITE8_HANDLER( YMF262_data_B_1_w ) {
 	struct ymf262_info *info = sndti_token(SOUND_YMF262, 1);
+	sndti_log_write(SOUND_YMF262, 1, 3, data);
 	YMF262Write(info->chip, 3, data);
 }
 
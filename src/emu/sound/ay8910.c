@@ -816,7 +816,9 @@ void ay8910_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
 		case SNDINFO_INT_ALIAS:							info->i = SOUND_AY8910;					break;
+		case SNDINFO_INT_STREAMS_OUTPUT_ONLY:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = ay8910_set_info;		break;
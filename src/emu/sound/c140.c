@@ -47,6 +47,7 @@ Unmapped registers:
 #include "sndintrf.h"
 #include "streams.h"
 #include "c140.h"
+#include "pcmvoice.h"
 
 #define MAX_VOICE 24
 
@@ -271,7 +272,7 @@ static void update_stereo(void *param, stream_sample_t **inputs, stream_sample_t
 
 	INT8	*pSampleData;
 	INT32	frequency,delta,offset,pos;
-	INT32	cnt, voicecnt;
+	INT32	cnt, voicecnt, span, flip;
 	INT32	lastdt,prevdt,dltdt;
 	float	pbase=(float)info->baserate*2.0 / (float)info->sample_rate;
 
@@ -330,8 +331,30 @@ static void update_stereo(void *param, stream_sample_t **inputs, stream_sample_t
 			{
 				//compressed PCM (maybe correct...)
 				/* Loop for enough to fill sample buffer as requested */
-				for(j=0;j<length;j++)
+				for(j=0;j<length;)
 				{
+					/* Render the run that cannot reach the end of the sample */
+					span = pcm_voice_span(pos, offset + delta, delta, sz, length - j);
+					for(j += span; span > 0; span--)
+					{
+						offset += delta;
+						pos += offset>>16;
+						offset &= 0xffff;
+
+						dt=pSampleData[pos];
+						sdt=dt>>3;
+						if(sdt<0)	sdt = (sdt<<(dt&7)) - info->pcmtbl[dt&7];
+						else		sdt = (sdt<<(dt&7)) + info->pcmtbl[dt&7];
+						prevdt=lastdt;
+						lastdt=sdt;
+						dltdt=(lastdt - prevdt);
+
+						dt=((dltdt*offset)>>16)+prevdt;
+						*lmix++ +=(dt*lvol)>>(5+5);
+						*rmix++ +=(dt*rvol)>>(5+5);
+					}
+					if(j>=length) break;
+
 					offset += delta;
 					cnt = (offset>>16)&0x7fff;
 					offset &= 0xffff;
@@ -372,13 +395,36 @@ static void update_stereo(void *param, stream_sample_t **inputs, stream_sample_t
 					/* Write the data to the sample buffers */
 					*lmix++ +=(dt*lvol)>>(5+5);
 					*rmix++ +=(dt*rvol)>>(5+5);
+					j++;
 				}
 			}
 			else
 			{
 				/* linear 8bit signed PCM */
-				for(j=0;j<length;j++)
+				flip = ((v->mode & 0x40) && (info->banking_type == C140_TYPE_ASIC219)) ? 0x80 : 0;
+				for(j=0;j<length;)
 				{
+					/* Render the run that cannot reach the end of the sample */
+					span = pcm_voice_span(pos, offset + delta, delta, sz, length - j);
+					for(j += span; span > 0; span--)
+					{
+						offset += delta;
+						cnt = offset>>16;
+						offset &= 0xffff;
+						if( cnt )
+						{
+							pos += cnt;
+							prevdt=lastdt;
+							lastdt=pSampleData[pos] ^ flip;
+							dltdt=(lastdt - prevdt);
+						}
+
+						dt=((dltdt*offset)>>16)+prevdt;
+						*lmix++ +=(dt*lvol)>>5;
+						*rmix++ +=(dt*rvol)>>5;
+					}
+					if(j>=length) break;
+
 					offset += delta;
 					cnt = (offset>>16)&0x7fff;
 					offset &= 0xffff;
@@ -401,11 +447,7 @@ static void update_stereo(void *param, stream_sample_t **inputs, stream_sample_t
 					if( cnt )
 					{
 						prevdt=lastdt;
-						lastdt=pSampleData[pos];
-						if ((v->mode & 0x40) && (info->banking_type == C140_TYPE_ASIC219))
-						{
-							lastdt ^= 0x80;	// flip signedness
-						}
+						lastdt=pSampleData[pos] ^ flip;	// flip signedness on ASIC219
 						dltdt=(lastdt - prevdt);
 					}
 
@@ -415,6 +457,7 @@ static void update_stereo(void *param, stream_sample_t **inputs, stream_sample_t
 					/* Write the data to the sample buffers */
 					*lmix++ +=(dt*lvol)>>5;
 					*rmix++ +=(dt*rvol)>>5;
+					j++;
 				}
 			}
 
@@ -502,6 +545,8 @@ void c140_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
+		case SNDINFO_INT_STREAMS_OUTPUT_ONLY:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = c140_set_info;			break;
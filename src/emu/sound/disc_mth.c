@@ -176,6 +176,58 @@ void dst_adder_step(node_description *node)
 }
 
 
+/************************************************************************
+ *
+ * DST_ADDER (fused) - Adder with DST_GAIN stages folded into its inputs
+ *
+ * Installed by the planner in discrete.c when a DST_GAIN feeds only
+ * this adder.  The gain stage is evaluated here, in the same order and
+ * precision as dst_gain_step, so the result is bit-identical.
+ *
+ ************************************************************************/
+struct dst_adder_fused_context
+{
+	node_description *gain[4];	/* fused DST_GAIN per channel, or NULL */
+};
+
+void dst_adder_fused_step(node_description *node)
+{
+	struct dst_adder_fused_context *context = node->context;
+	double in[4];
+	int chan;
+
+	if(DST_ADDER__ENABLE)
+	{
+		for (chan = 0; chan < 4; chan++)
+		{
+			node_description *gain = context->gain[chan];
+
+			if (gain == NULL)
+				in[chan] = *(node->input[chan + 1]);
+			else
+			{
+				/* same steps as dst_gain_step */
+				if (*(gain->input[0]))
+				{
+					gain->output = *(gain->input[1]) * *(gain->input[2]);
+					gain->output += *(gain->input[3]);
+				}
+				else
+				{
+					gain->output = 0;
+				}
+				in[chan] = gain->output;
+			}
+		}
+		node->output = in[0] + in[1] + in[2] + in[3];
+	}
+	else
+	{
+		node->output=0;
+	}
+}
+
+
 /************************************************************************
  *
  * DST_COMP_ADDER  - Selectable parallel component adder
@@ -1172,6 +1224,18 @@ void dst_mixer_reset(node_description *node)
 	node->output = 0;
 }
 
+/* the rNode outputs are read through pointers set up in reset, not as inputs */
+int dst_mixer_extra_inputs(node_description *node, int *nodes, int maxnodes)
+{
+	const discrete_mixer_desc *info = node->custom;
+	int bit, count = 0;
+
+	for (bit = 0; bit < DISC_MIXER_MAX_INPS && count < maxnodes; bit++)
+		if (info->rNode[bit] >= NODE_START && info->rNode[bit] <= NODE_END)
+			nodes[count++] = info->rNode[bit];
+	return count;
+}
+
 
 /************************************************************************
  *
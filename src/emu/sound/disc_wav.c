@@ -1004,6 +1004,19 @@ void dss_op_amp_osc_reset(node_description *node)
 	dss_op_amp_osc_step(node);
 }
 
+/* resistors given as nodes are read through pointers set up in reset, not as inputs */
+int dss_op_amp_osc_extra_inputs(node_description *node, int *nodes, int maxnodes)
+{
+	const discrete_op_amp_osc_info *info = node->custom;
+	const double *r_info_ptr = &info->r1;
+	int loop, count = 0;
+
+	for (loop = 0; loop < 8 && count < maxnodes; loop++, r_info_ptr++)
+		if IS_VALUE_A_NODE(*r_info_ptr)
+			nodes[count++] = (int)*r_info_ptr;
+	return count;
+}
+
 
 /************************************************************************
  *
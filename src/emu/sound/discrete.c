@@ -51,6 +51,12 @@
 
 #define DISCRETE_DEBUGLOG			(0)
 
+/* set to 0 to step every node every sample, for comparing wave logs */
+#define DISCRETE_PLAN				(1)
+
+/* updates shorter than this aren't worth handing to the work queue */
+#define DISCRETE_PARALLEL_MIN_SAMPLES	(64)
+
 
 
 /*************************************
@@ -59,6 +65,20 @@
  *
  *************************************/
 
+typedef struct _discrete_info discrete_info;
+
+/* one independent sub-graph, evaluated as a work item */
+struct _discrete_task
+{
+	discrete_info *info;
+	int samples;						/* samples to generate this update */
+	int step_count;
+	node_description **step_list;		/* this sub-graph's per-sample nodes */
+	int tap_count;
+	int *tap;							/* indexes of the taps it feeds */
+};
+typedef struct _discrete_task discrete_task;
+
 struct _discrete_info
 {
 	/* emulation info */
@@ -72,6 +92,21 @@ struct _discrete_info
 	node_description **indexed_node;
 	node_description *node_list;
 
+	/* execution plan, built by plan_nodes() */
+	int update_count;
+	node_description **update_list;		/* stepped once per stream update */
+	int step_count;
+	node_description **step_list;		/* stepped once per sample */
+
+	/* parallel evaluation of independent sub-graphs */
+	osd_work_queue *queue;
+	int task_count;
+	discrete_task *tasks;
+	int tap_count;
+	node_description **tap_node;		/* per-sample nodes read by output/log nodes */
+	double **tap_buffer;				/* their values over the current update */
+	int tap_length;
+
 	/* the input streams */
 	int discrete_input_streams;
 	stream_sample_t **input_stream_data[DISCRETE_MAX_OUTPUTS];
@@ -97,7 +132,6 @@ struct _discrete_info
 	wav_file *disc_wav_file[DISCRETE_MAX_WAVELOGS];
 	node_description *wavelog_node[DISCRETE_MAX_WAVELOGS];
 };
-typedef struct _discrete_info discrete_info;
 
 static discrete_info *discrete_current_context;
 
@@ -111,6 +145,8 @@ static discrete_info *discrete_current_context;
 
 static void init_nodes(discrete_info *info, discrete_sound_block *block_list);
 static void find_input_nodes(discrete_info *info, discrete_sound_block *block_list);
+static void plan_nodes(discrete_info *info);
+static void partition_nodes(discrete_info *info, const UINT8 *tier);
 static void setup_output_nodes(discrete_info *info);
 static void setup_disc_logs(discrete_info *info);
 static void discrete_reset(void *chip);
@@ -164,104 +200,104 @@ void CLIB_DECL discrete_log(const char *text, ...)
 
 static discrete_module module_list[] =
 {
-	{ DSO_OUTPUT      ,"DSO_OUTPUT"      ,0                                      ,NULL                  ,NULL                 },
-	{ DSO_CSVLOG      ,"DSO_CSVLOG"      ,0                                      ,NULL                  ,NULL                 },
-	{ DSO_WAVELOG     ,"DSO_WAVELOG"     ,0                                      ,NULL                  ,NULL                 },
+	{ DSO_OUTPUT      ,"DSO_OUTPUT"      ,0                                      ,NULL                  ,NULL                 ,NULL                        },
+	{ DSO_CSVLOG      ,"DSO_CSVLOG"      ,0                                      ,NULL                  ,NULL                 ,NULL                        },
+	{ DSO_WAVELOG     ,"DSO_WAVELOG"     ,0                                      ,NULL                  ,NULL                 ,NULL                        },
 
 	/* from disc_inp.c */
-	{ DSS_ADJUSTMENT  ,"DSS_ADJUSTMENT"  ,sizeof(struct dss_adjustment_context)  ,dss_adjustment_reset  ,dss_adjustment_step  },
-	{ DSS_CONSTANT    ,"DSS_CONSTANT"    ,0                                      ,NULL                  ,dss_constant_step    },
-	{ DSS_INPUT_DATA  ,"DSS_INPUT_DATA"  ,sizeof(UINT8)                          ,dss_input_reset       ,dss_input_step       },
-	{ DSS_INPUT_LOGIC ,"DSS_INPUT_LOGIC" ,sizeof(UINT8)                          ,dss_input_reset       ,dss_input_step       },
-	{ DSS_INPUT_NOT   ,"DSS_INPUT_NOT"   ,sizeof(UINT8)                          ,dss_input_reset       ,dss_input_step       },
-	{ DSS_INPUT_PULSE ,"DSS_INPUT_PULSE" ,sizeof(UINT8)                          ,dss_input_reset       ,dss_input_pulse_step },
-	{ DSS_INPUT_STREAM,"DSS_INPUT_STREAM",0                                      ,NULL                  ,dss_input_stream_step},
+	{ DSS_ADJUSTMENT  ,"DSS_ADJUSTMENT"  ,sizeof(struct dss_adjustment_context)  ,dss_adjustment_reset  ,dss_adjustment_step  ,NULL                        },
+	{ DSS_CONSTANT    ,"DSS_CONSTANT"    ,0                                      ,NULL                  ,dss_constant_step    ,NULL                        },
+	{ DSS_INPUT_DATA  ,"DSS_INPUT_DATA"  ,sizeof(UINT8)                          ,dss_input_reset       ,dss_input_step       ,NULL                        },
+	{ DSS_INPUT_LOGIC ,"DSS_INPUT_LOGIC" ,sizeof(UINT8)                          ,dss_input_reset       ,dss_input_step       ,NULL                        },
+	{ DSS_INPUT_NOT   ,"DSS_INPUT_NOT"   ,sizeof(UINT8)                          ,dss_input_reset       ,dss_input_step       ,NULL                        },
+	{ DSS_INPUT_PULSE ,"DSS_INPUT_PULSE" ,sizeof(UINT8)                          ,dss_input_reset       ,dss_input_pulse_step ,NULL                        },
+	{ DSS_INPUT_STREAM,"DSS_INPUT_STREAM",0                                      ,NULL                  ,dss_input_stream_step,NULL                        },
 
 	/* from disc_wav.c */
 	/* Generic modules */
-	{ DSS_COUNTER     ,"DSS_COUNTER"     ,sizeof(struct dss_counter_context)     ,dss_counter_reset     ,dss_counter_step     },
-	{ DSS_LFSR_NOISE  ,"DSS_LFSR_NOISE"  ,sizeof(struct dss_lfsr_context)        ,dss_lfsr_reset        ,dss_lfsr_step        },
-	{ DSS_NOISE       ,"DSS_NOISE"       ,sizeof(struct dss_noise_context)       ,dss_noise_reset       ,dss_noise_step       },
-	{ DSS_NOTE        ,"DSS_NOTE"        ,sizeof(struct dss_note_context)        ,dss_note_reset        ,dss_note_step        },
-	{ DSS_SAWTOOTHWAVE,"DSS_SAWTOOTHWAVE",sizeof(struct dss_sawtoothwave_context),dss_sawtoothwave_reset,dss_sawtoothwave_step},
-	{ DSS_SINEWAVE    ,"DSS_SINEWAVE"    ,sizeof(struct dss_sinewave_context)    ,dss_sinewave_reset    ,dss_sinewave_step    },
-	{ DSS_SQUAREWAVE  ,"DSS_SQUAREWAVE"  ,sizeof(struct dss_squarewave_context)  ,dss_squarewave_reset  ,dss_squarewave_step  },
-	{ DSS_SQUAREWFIX  ,"DSS_SQUAREWFIX"  ,sizeof(struct dss_squarewfix_context)  ,dss_squarewfix_reset  ,dss_squarewfix_step  },
-	{ DSS_SQUAREWAVE2 ,"DSS_SQUAREWAVE2" ,sizeof(struct dss_squarewave_context)  ,dss_squarewave2_reset ,dss_squarewave2_step },
-	{ DSS_TRIANGLEWAVE,"DSS_TRIANGLEWAVE",sizeof(struct dss_trianglewave_context),dss_trianglewave_reset,dss_trianglewave_step},
+	{ DSS_COUNTER     ,"DSS_COUNTER"     ,sizeof(struct dss_counter_context)     ,dss_counter_reset     ,dss_counter_step     ,NULL                        },
+	{ DSS_LFSR_NOISE  ,"DSS_LFSR_NOISE"  ,sizeof(struct dss_lfsr_context)        ,dss_lfsr_reset        ,dss_lfsr_step        ,NULL                        },
+	{ DSS_NOISE       ,"DSS_NOISE"       ,sizeof(struct dss_noise_context)       ,dss_noise_reset       ,dss_noise_step       ,NULL                        },
+	{ DSS_NOTE        ,"DSS_NOTE"        ,sizeof(struct dss_note_context)        ,dss_note_reset        ,dss_note_step        ,NULL                        },
+	{ DSS_SAWTOOTHWAVE,"DSS_SAWTOOTHWAVE",sizeof(struct dss_sawtoothwave_context),dss_sawtoothwave_reset,dss_sawtoothwave_step,NULL                        },
+	{ DSS_SINEWAVE    ,"DSS_SINEWAVE"    ,sizeof(struct dss_sinewave_context)    ,dss_sinewave_reset    ,dss_sinewave_step    ,NULL                        },
+	{ DSS_SQUAREWAVE  ,"DSS_SQUAREWAVE"  ,sizeof(struct dss_squarewave_context)  ,dss_squarewave_reset  ,dss_squarewave_step  ,NULL                        },
+	{ DSS_SQUAREWFIX  ,"DSS_SQUAREWFIX"  ,sizeof(struct dss_squarewfix_context)  ,dss_squarewfix_reset  ,dss_squarewfix_step  ,NULL                        },
+	{ DSS_SQUAREWAVE2 ,"DSS_SQUAREWAVE2" ,sizeof(struct dss_squarewave_context)  ,dss_squarewave2_reset ,dss_squarewave2_step ,NULL                        },
+	{ DSS_TRIANGLEWAVE,"DSS_TRIANGLEWAVE",sizeof(struct dss_trianglewave_context),dss_trianglewave_reset,dss_trianglewave_step,NULL                        },
 	/* Component specific modules */
-	{ DSS_INVERTER_OSC ,"DSS_INVERTER_OSC" ,sizeof(struct dss_inverter_osc_context) ,dss_inverter_osc_reset ,dss_inverter_osc_step },
-	{ DSS_OP_AMP_OSC  ,"DSS_OP_AMP_OSC"  ,sizeof(struct dss_op_amp_osc_context)  ,dss_op_amp_osc_reset  ,dss_op_amp_osc_step  },
-	{ DSS_SCHMITT_OSC ,"DSS_SCHMITT_OSC" ,sizeof(struct dss_schmitt_osc_context) ,dss_schmitt_osc_reset ,dss_schmitt_osc_step },
+	{ DSS_INVERTER_OSC ,"DSS_INVERTER_OSC" ,sizeof(struct dss_inverter_osc_context) ,dss_inverter_osc_reset ,dss_inverter_osc_step ,NULL                        },
+	{ DSS_OP_AMP_OSC  ,"DSS_OP_AMP_OSC"  ,sizeof(struct dss_op_amp_osc_context)  ,dss_op_amp_osc_reset  ,dss_op_amp_osc_step  ,dss_op_amp_osc_extra_inputs },
+	{ DSS_SCHMITT_OSC ,"DSS_SCHMITT_OSC" ,sizeof(struct dss_schmitt_osc_context) ,dss_schmitt_osc_reset ,dss_schmitt_osc_step ,NULL                        },
 	/* Not yet implemented */
-	{ DSS_ADSR        ,"DSS_ADSR"        ,sizeof(struct dss_adsr_context)        ,dss_adsrenv_reset     ,dss_adsrenv_step     },
+	{ DSS_ADSR        ,"DSS_ADSR"        ,sizeof(struct dss_adsr_context)        ,dss_adsrenv_reset     ,dss_adsrenv_step     ,NULL                        },
 
 	/* from disc_mth.c */
 	/* Generic modules */
-	{ DST_ADDER       ,"DST_ADDER"       ,0                                      ,NULL                  ,dst_adder_step       },
-	{ DST_CLAMP       ,"DST_CLAMP"       ,0                                      ,NULL                  ,dst_clamp_step       },
-	{ DST_DIVIDE      ,"DST_DIVIDE"      ,0                                      ,NULL                  ,dst_divide_step      },
-	{ DST_GAIN        ,"DST_GAIN"        ,0                                      ,NULL                  ,dst_gain_step        },
-	{ DST_LOGIC_INV   ,"DST_LOGIC_INV"   ,0                                      ,NULL                  ,dst_logic_inv_step   },
-	{ DST_LOGIC_AND   ,"DST_LOGIC_AND"   ,0                                      ,NULL                  ,dst_logic_and_step   },
-	{ DST_LOGIC_NAND  ,"DST_LOGIC_NAND"  ,0                                      ,NULL                  ,dst_logic_nand_step  },
-	{ DST_LOGIC_OR    ,"DST_LOGIC_OR"    ,0                                      ,NULL                  ,dst_logic_or_step    },
-	{ DST_LOGIC_NOR   ,"DST_LOGIC_NOR"   ,0                                      ,NULL                  ,dst_logic_nor_step   },
-	{ DST_LOGIC_XOR   ,"DST_LOGIC_XOR"   ,0                                      ,NULL                  ,dst_logic_xor_step   },
-	{ DST_LOGIC_NXOR  ,"DST_LOGIC_NXOR"  ,0                                      ,NULL                  ,dst_logic_nxor_step  },
-	{ DST_LOGIC_DFF   ,"DST_LOGIC_DFF"   ,sizeof(struct dst_flipflop_context)    ,dst_logic_ff_reset    ,dst_logic_dff_step   },
-	{ DST_LOGIC_JKFF  ,"DST_LOGIC_JKFF"  ,sizeof(struct dst_flipflop_context)    ,dst_logic_ff_reset    ,dst_logic_jkff_step  },
-	{ DST_LOOKUP_TABLE,"DST_LOOKUP_TABLE",0                                      ,NULL                  ,dst_lookup_table_step},
-	{ DST_MULTIPLEX   ,"DST_MULTIPLEX"   ,sizeof(struct dst_size_context)        ,dst_multiplex_reset   ,dst_multiplex_step   },
-	{ DST_ONESHOT     ,"DST_ONESHOT"     ,sizeof(struct dst_oneshot_context)     ,dst_oneshot_reset     ,dst_oneshot_step     },
-	{ DST_RAMP        ,"DST_RAMP"        ,sizeof(struct dss_ramp_context)        ,dst_ramp_reset        ,dst_ramp_step        },
-	{ DST_SAMPHOLD    ,"DST_SAMPHOLD"    ,sizeof(struct dst_samphold_context)    ,dst_samphold_reset    ,dst_samphold_step    },
-	{ DST_SWITCH      ,"DST_SWITCH"      ,0                                      ,NULL                  ,dst_switch_step      },
-	{ DST_ASWITCH     ,"DST_ASWITCH"     ,0                                      ,NULL                  ,dst_aswitch_step     },
-	{ DST_TRANSFORM   ,"DST_TRANSFORM"   ,0                                      ,NULL                  ,dst_transform_step   },
+	{ DST_ADDER       ,"DST_ADDER"       ,0                                      ,NULL                  ,dst_adder_step       ,NULL                        },
+	{ DST_CLAMP       ,"DST_CLAMP"       ,0                                      ,NULL                  ,dst_clamp_step       ,NULL                        },
+	{ DST_DIVIDE      ,"DST_DIVIDE"      ,0                                      ,NULL                  ,dst_divide_step      ,NULL                        },
+	{ DST_GAIN        ,"DST_GAIN"        ,0                                      ,NULL                  ,dst_gain_step        ,NULL                        },
+	{ DST_LOGIC_INV   ,"DST_LOGIC_INV"   ,0                                      ,NULL                  ,dst_logic_inv_step   ,NULL                        },
+	{ DST_LOGIC_AND   ,"DST_LOGIC_AND"   ,0                                      ,NULL                  ,dst_logic_and_step   ,NULL                        },
+	{ DST_LOGIC_NAND  ,"DST_LOGIC_NAND"  ,0                                      ,NULL                  ,dst_logic_nand_step  ,NULL                        },
+	{ DST_LOGIC_OR    ,"DST_LOGIC_OR"    ,0                                      ,NULL                  ,dst_logic_or_step    ,NULL                        },
+	{ DST_LOGIC_NOR   ,"DST_LOGIC_NOR"   ,0                                      ,NULL                  ,dst_logic_nor_step   ,NULL                        },
+	{ DST_LOGIC_XOR   ,"DST_LOGIC_XOR"   ,0                                      ,NULL                  ,dst_logic_xor_step   ,NULL                        },
+	{ DST_LOGIC_NXOR  ,"DST_LOGIC_NXOR"  ,0                                      ,NULL                  ,dst_logic_nxor_step  ,NULL                        },
+	{ DST_LOGIC_DFF   ,"DST_LOGIC_DFF"   ,sizeof(struct dst_flipflop_context)    ,dst_logic_ff_reset    ,dst_logic_dff_step   ,NULL                        },
+	{ DST_LOGIC_JKFF  ,"DST_LOGIC_JKFF"  ,sizeof(struct dst_flipflop_context)    ,dst_logic_ff_reset    ,dst_logic_jkff_step  ,NULL                        },
+	{ DST_LOOKUP_TABLE,"DST_LOOKUP_TABLE",0                                      ,NULL                  ,dst_lookup_table_step,NULL                        },
+	{ DST_MULTIPLEX   ,"DST_MULTIPLEX"   ,sizeof(struct dst_size_context)        ,dst_multiplex_reset   ,dst_multiplex_step   ,NULL                        },
+	{ DST_ONESHOT     ,"DST_ONESHOT"     ,sizeof(struct dst_oneshot_context)     ,dst_oneshot_reset     ,dst_oneshot_step     ,NULL                        },
+	{ DST_RAMP        ,"DST_RAMP"        ,sizeof(struct dss_ramp_context)        ,dst_ramp_reset        ,dst_ramp_step        ,NULL                        },
+	{ DST_SAMPHOLD    ,"DST_SAMPHOLD"    ,sizeof(struct dst_samphold_context)    ,dst_samphold_reset    ,dst_samphold_step    ,NULL                        },
+	{ DST_SWITCH      ,"DST_SWITCH"      ,0                                      ,NULL                  ,dst_switch_step      ,NULL                        },
+	{ DST_ASWITCH     ,"DST_ASWITCH"     ,0                                      ,NULL                  ,dst_aswitch_step     ,NULL                        },
+	{ DST_TRANSFORM   ,"DST_TRANSFORM"   ,0                                      ,NULL                  ,dst_transform_step   ,NULL                        },
 	/* Component specific */
-	{ DST_COMP_ADDER  ,"DST_COMP_ADDER"  ,0                                      ,NULL                  ,dst_comp_adder_step  },
-	{ DST_DAC_R1      ,"DST_DAC_R1"      ,sizeof(struct dst_dac_r1_context)      ,dst_dac_r1_reset      ,dst_dac_r1_step      },
-	{ DST_DIODE_MIX   ,"DST_DIODE_MIX"   ,sizeof(struct dst_size_context)        ,dst_diode_mix_reset   ,dst_diode_mix_step   },
-	{ DST_INTEGRATE   ,"DST_INTEGRATE"   ,sizeof(struct dst_integrate_context)   ,dst_integrate_reset   ,dst_integrate_step   },
-	{ DST_MIXER       ,"DST_MIXER"       ,sizeof(struct dst_mixer_context)       ,dst_mixer_reset       ,dst_mixer_step       },
-	{ DST_OP_AMP      ,"DST_OP_AMP"      ,sizeof(struct dst_op_amp_context)      ,dst_op_amp_reset      ,dst_op_amp_step      },
-	{ DST_OP_AMP_1SHT ,"DST_OP_AMP_1SHT" ,sizeof(struct dst_op_amp_1sht_context) ,dst_op_amp_1sht_reset ,dst_op_amp_1sht_step },
-	{ DST_TVCA_OP_AMP ,"DST_TVCA_OP_AMP" ,sizeof(struct dst_tvca_op_amp_context) ,dst_tvca_op_amp_reset ,dst_tvca_op_amp_step },
-	{ DST_VCA         ,"DST_VCA"         ,0                                      ,NULL                  ,NULL                 },
+	{ DST_COMP_ADDER  ,"DST_COMP_ADDER"  ,0                                      ,NULL                  ,dst_comp_adder_step  ,NULL                        },
+	{ DST_DAC_R1      ,"DST_DAC_R1"      ,sizeof(struct dst_dac_r1_context)      ,dst_dac_r1_reset      ,dst_dac_r1_step      ,NULL                        },
+	{ DST_DIODE_MIX   ,"DST_DIODE_MIX"   ,sizeof(struct dst_size_context)        ,dst_diode_mix_reset   ,dst_diode_mix_step   ,NULL                        },
+	{ DST_INTEGRATE   ,"DST_INTEGRATE"   ,sizeof(struct dst_integrate_context)   ,dst_integrate_reset   ,dst_integrate_step   ,NULL                        },
+	{ DST_MIXER       ,"DST_MIXER"       ,sizeof(struct dst_mixer_context)       ,dst_mixer_reset       ,dst_mixer_step       ,dst_mixer_extra_inputs      },
+	{ DST_OP_AMP      ,"DST_OP_AMP"      ,sizeof(struct dst_op_amp_context)      ,dst_op_amp_reset      ,dst_op_amp_step      ,NULL                        },
+	{ DST_OP_AMP_1SHT ,"DST_OP_AMP_1SHT" ,sizeof(struct dst_op_amp_1sht_context) ,dst_op_amp_1sht_reset ,dst_op_amp_1sht_step ,NULL                        },
+	{ DST_TVCA_OP_AMP ,"DST_TVCA_OP_AMP" ,sizeof(struct dst_tvca_op_amp_context) ,dst_tvca_op_amp_reset ,dst_tvca_op_amp_step ,NULL                        },
+	{ DST_VCA         ,"DST_VCA"         ,0                                      ,NULL                  ,NULL                 ,NULL                        },
 
 	/* from disc_flt.c */
 	/* Generic modules */
-	{ DST_FILTER1     ,"DST_FILTER1"     ,sizeof(struct dss_filter1_context)     ,dst_filter1_reset     ,dst_filter1_step     },
-	{ DST_FILTER2     ,"DST_FILTER2"     ,sizeof(struct dss_filter2_context)     ,dst_filter2_reset     ,dst_filter2_step     },
+	{ DST_FILTER1     ,"DST_FILTER1"     ,sizeof(struct dss_filter1_context)     ,dst_filter1_reset     ,dst_filter1_step     ,NULL                        },
+	{ DST_FILTER2     ,"DST_FILTER2"     ,sizeof(struct dss_filter2_context)     ,dst_filter2_reset     ,dst_filter2_step     ,NULL                        },
 	/* Component specific modules */
-	{ DST_CRFILTER    ,"DST_CRFILTER"    ,sizeof(struct dst_rcfilter_context)    ,dst_crfilter_reset    ,dst_crfilter_step    },
-	{ DST_OP_AMP_FILT ,"DST_OP_AMP_FILT" ,sizeof(struct dst_op_amp_filt_context) ,dst_op_amp_filt_reset ,dst_op_amp_filt_step },
-	{ DST_RCDISC      ,"DST_RCDISC"      ,sizeof(struct dst_rcdisc_context)      ,dst_rcdisc_reset      ,dst_rcdisc_step      },
-	{ DST_RCDISC2     ,"DST_RCDISC2"     ,sizeof(struct dst_rcdisc_context)      ,dst_rcdisc2_reset     ,dst_rcdisc2_step     },
-	{ DST_RCDISC3     ,"DST_RCDISC3"     ,sizeof(struct dst_rcdisc_context)      ,dst_rcdisc3_reset     ,dst_rcdisc3_step     },
-	{ DST_RCDISC4     ,"DST_RCDISC4"     ,sizeof(struct dst_rcdisc4_context)     ,dst_rcdisc4_reset     ,dst_rcdisc4_step     },
-	{ DST_RCDISC5     ,"DST_RCDISC5"     ,sizeof(struct dst_rcdisc_context)      ,dst_rcdisc5_reset     ,dst_rcdisc5_step     },
-	{ DST_RCINTEGRATE ,"DST_RCINTEGRATE" ,sizeof(struct dst_rcdisc_context)      ,dst_rcintegrate_reset ,dst_rcintegrate_step   },
-	{ DST_RCDISC_MOD  ,"DST_RCDISC_MOD"  ,sizeof(struct dst_rcdisc_context)      ,dst_rcdisc_mod_reset  ,dst_rcdisc_mod_step },
-	{ DST_RCFILTER    ,"DST_RCFILTER"    ,sizeof(struct dst_rcfilter_context)    ,dst_rcfilter_reset    ,dst_rcfilter_step    },
+	{ DST_CRFILTER    ,"DST_CRFILTER"    ,sizeof(struct dst_rcfilter_context)    ,dst_crfilter_reset    ,dst_crfilter_step    ,NULL                        },
+	{ DST_OP_AMP_FILT ,"DST_OP_AMP_FILT" ,sizeof(struct dst_op_amp_filt_context) ,dst_op_amp_filt_reset ,dst_op_amp_filt_step ,NULL                        },
+	{ DST_RCDISC      ,"DST_RCDISC"      ,sizeof(struct dst_rcdisc_context)      ,dst_rcdisc_reset      ,dst_rcdisc_step      ,NULL                        },
+	{ DST_RCDISC2     ,"DST_RCDISC2"     ,sizeof(struct dst_rcdisc_context)      ,dst_rcdisc2_reset     ,dst_rcdisc2_step     ,NULL                        },
+	{ DST_RCDISC3     ,"DST_RCDISC3"     ,sizeof(struct dst_rcdisc_context)      ,dst_rcdisc3_reset     ,dst_rcdisc3_step     ,NULL                        },
+	{ DST_RCDISC4     ,"DST_RCDISC4"     ,sizeof(struct dst_rcdisc4_context)     ,dst_rcdisc4_reset     ,dst_rcdisc4_step     ,NULL                        },
+	{ DST_RCDISC5     ,"DST_RCDISC5"     ,sizeof(struct dst_rcdisc_context)      ,dst_rcdisc5_reset     ,dst_rcdisc5_step     ,NULL                        },
+	{ DST_RCINTEGRATE ,"DST_RCINTEGRATE" ,sizeof(struct dst_rcdisc_context)      ,dst_rcintegrate_reset ,dst_rcintegrate_step   ,NULL                        },
+	{ DST_RCDISC_MOD  ,"DST_RCDISC_MOD"  ,sizeof(struct dst_rcdisc_context)      ,dst_rcdisc_mod_reset  ,dst_rcdisc_mod_step ,NULL                        },
+	{ DST_RCFILTER    ,"DST_RCFILTER"    ,sizeof(struct dst_rcfilter_context)    ,dst_rcfilter_reset    ,dst_rcfilter_step    ,NULL                        },
 	/* For testing - seem to be buggered.  Use versions not ending in N. */
-	{ DST_RCFILTERN   ,"DST_RCFILTERN"   ,sizeof(struct dss_filter1_context)     ,dst_rcfilterN_reset   ,dst_filter1_step     },
-	{ DST_RCDISCN     ,"DST_RCDISCN"     ,sizeof(struct dss_filter1_context)     ,dst_rcdiscN_reset     ,dst_rcdiscN_step     },
-	{ DST_RCDISC2N    ,"DST_RCDISC2N"    ,sizeof(struct dss_rcdisc2_context)     ,dst_rcdisc2N_reset    ,dst_rcdisc2N_step    },
+	{ DST_RCFILTERN   ,"DST_RCFILTERN"   ,sizeof(struct dss_filter1_context)     ,dst_rcfilterN_reset   ,dst_filter1_step     ,NULL                        },
+	{ DST_RCDISCN     ,"DST_RCDISCN"     ,sizeof(struct dss_filter1_context)     ,dst_rcdiscN_reset     ,dst_rcdiscN_step     ,NULL                        },
+	{ DST_RCDISC2N    ,"DST_RCDISC2N"    ,sizeof(struct dss_rcdisc2_context)     ,dst_rcdisc2N_reset    ,dst_rcdisc2N_step    ,NULL                        },
 
 	/* from disc_dev.c */
 	/* generic modules */
-	{ DST_CUSTOM      ,"DST_CUSTOM"      ,0                                      ,NULL                  ,NULL                 },
+	{ DST_CUSTOM      ,"DST_CUSTOM"      ,0                                      ,NULL                  ,NULL                 ,NULL                        },
 	/* Component specific modules */
-	{ DSD_555_ASTBL   ,"DSD_555_ASTBL"   ,sizeof(struct dsd_555_astbl_context)   ,dsd_555_astbl_reset   ,dsd_555_astbl_step   },
-	{ DSD_555_MSTBL   ,"DSD_555_MSTBL"   ,sizeof(struct dsd_555_mstbl_context)   ,dsd_555_mstbl_reset   ,dsd_555_mstbl_step   },
-	{ DSD_555_CC      ,"DSD_555_CC"      ,sizeof(struct dsd_555_cc_context)      ,dsd_555_cc_reset      ,dsd_555_cc_step      },
-	{ DSD_555_VCO1    ,"DSD_555_VCO1"    ,sizeof(struct dsd_555_vco1_context)    ,dsd_555_vco1_reset    ,dsd_555_vco1_step    },
-	{ DSD_566         ,"DSD_566"         ,sizeof(struct dsd_566_context)         ,dsd_566_reset         ,dsd_566_step         },
+	{ DSD_555_ASTBL   ,"DSD_555_ASTBL"   ,sizeof(struct dsd_555_astbl_context)   ,dsd_555_astbl_reset   ,dsd_555_astbl_step   ,NULL                        },
+	{ DSD_555_MSTBL   ,"DSD_555_MSTBL"   ,sizeof(struct dsd_555_mstbl_context)   ,dsd_555_mstbl_reset   ,dsd_555_mstbl_step   ,NULL                        },
+	{ DSD_555_CC      ,"DSD_555_CC"      ,sizeof(struct dsd_555_cc_context)      ,dsd_555_cc_reset      ,dsd_555_cc_step      ,NULL                        },
+	{ DSD_555_VCO1    ,"DSD_555_VCO1"    ,sizeof(struct dsd_555_vco1_context)    ,dsd_555_vco1_reset    ,dsd_555_vco1_step    ,NULL                        },
+	{ DSD_566         ,"DSD_566"         ,sizeof(struct dsd_566_context)         ,dsd_566_reset         ,dsd_566_step         ,NULL                        },
 
 	/* must be the last one */
-	{ DSS_NULL        ,"DSS_NULL"        ,0                                      ,NULL                  ,NULL                 }
+	{ DSS_NULL        ,"DSS_NULL"        ,0                                      ,NULL                  ,NULL                 ,NULL                        }
 };
 
 
@@ -347,6 +383,9 @@ static void *discrete_start(int sndindex, int clock, const void *config)
 	/* now go back and find pointers to all input nodes */
 	find_input_nodes(info, intf);
 
+	/* work out which nodes really need stepping every sample */
+	plan_nodes(info);
+
 	/* then set up the output nodes */
 	setup_output_nodes(info);
 
@@ -380,6 +419,14 @@ static void discrete_stop(void *chip)
 		if (info->disc_wav_file[log_num])
 			wav_close(info->disc_wav_file[log_num]);
 
+	/* shut down the sub-graph workers */
+	if (info->queue != NULL)
+	{
+		osd_work_queue_free(info->queue);
+		for (log_num = 0; log_num < info->tap_count; log_num++)
+			free(info->tap_buffer[log_num]);
+	}
+
 	if (DISCRETE_DEBUGLOG)
 	{
 		/* close the debug log */
@@ -431,13 +478,87 @@ static void discrete_reset(void *chip)
  *
  *************************************/
 
-static void discrete_stream_update(void *param, stream_sample_t **inputs, stream_sample_t **buffer, int length)
+INLINE void discrete_write_sample(discrete_info *info, stream_sample_t **buffer, int samplenum)
 {
-	discrete_info *info = param;
-	int samplenum, nodenum, outputnum;
+	int outputnum, nodenum;
 	double val;
 	INT16 wave_data_l, wave_data_r;
 
+	/* Add gain to the output and put into the buffers */
+	/* Clipping will be handled by the main sound system */
+	for (outputnum = 0; outputnum < info->discrete_outputs; outputnum++)
+	{
+		val = (*info->output_node[outputnum]->input[0]) * (*info->output_node[outputnum]->input[1]);
+		buffer[outputnum][samplenum] = val;
+	}
+
+	/* Dump any csv logs */
+	for (outputnum = 0; outputnum < info->num_csvlogs; outputnum++)
+	{
+		fprintf(info->disc_csv_file[outputnum], "%lld", ++info->sample_num);
+		for (nodenum = 0; nodenum < info->csvlog_node[outputnum]->active_inputs; nodenum++)
+		{
+			fprintf(info->disc_csv_file[outputnum], ", %f", *info->csvlog_node[outputnum]->input[nodenum]);
+		}
+		fprintf(info->disc_csv_file[outputnum], "\n");
+	}
+
+	/* Dump any wave logs */
+	for (outputnum = 0; outputnum < info->num_wavelogs; outputnum++)
+	{
+		/* get nodes to be logged and apply gain, then clip to 16 bit */
+		val = (*info->wavelog_node[outputnum]->input[0]) * (*info->wavelog_node[outputnum]->input[1]);
+		val = (val < -32768) ? -32768 : (val > 32767) ? 32767 : val;
+		wave_data_l = (INT16)val;
+		if (info->wavelog_node[outputnum]->active_inputs == 2)
+		{
+			/* DISCRETE_WAVELOG1 */
+			wav_add_data_16(info->disc_wav_file[outputnum], &wave_data_l, 1);
+		}
+		else
+		{
+			/* DISCRETE_WAVELOG2 */
+			val = (*info->wavelog_node[outputnum]->input[2]) * (*info->wavelog_node[outputnum]->input[3]);
+			val = (val < -32768) ? -32768 : (val > 32767) ? 32767 : val;
+			wave_data_r = (INT16)val;
+
+			wav_add_data_16lr(info->disc_wav_file[outputnum], &wave_data_l, &wave_data_r, 1);
+		}
+	}
+}
+
+
+static void *discrete_task_callback(void *param)
+{
+	discrete_task *task = param;
+	discrete_info *info = task->info;
+	int samplenum, nodenum, tapnum;
+
+	/* run one independent sub-graph over the whole update */
+	for (samplenum = 0; samplenum < task->samples; samplenum++)
+	{
+		for (nodenum = 0; nodenum < task->step_count; nodenum++)
+		{
+			node_description *node = task->step_list[nodenum];
+			(*node->module.step)(node);
+		}
+
+		/* record the values the output and log nodes will want */
+		for (tapnum = 0; tapnum < task->tap_count; tapnum++)
+		{
+			int tap = task->tap[tapnum];
+			info->tap_buffer[tap][samplenum] = info->tap_node[tap]->output;
+		}
+	}
+	return NULL;
+}
+
+
+static void discrete_stream_update(void *param, stream_sample_t **inputs, stream_sample_t **buffer, int length)
+{
+	discrete_info *info = param;
+	int samplenum, nodenum, tapnum;
+
 	discrete_current_context = info;
 
 	/* Setup any input streams */
@@ -446,59 +567,58 @@ static void discrete_stream_update(void *param, stream_sample_t **inputs, stream
 		*info->input_stream_data[nodenum] = inputs[nodenum];
 	}
 
-	/* Now we must do length iterations of the node list, one output for each step */
-	for (samplenum = 0; samplenum < length; samplenum++)
+	/* Nodes fed only by constants and CPU-written inputs can't change within an update */
+	for (nodenum = 0; nodenum < info->update_count; nodenum++)
 	{
-		/* loop over all nodes */
-		for (nodenum = 0; nodenum < info->node_count; nodenum++)
-		{
-			node_description *node = info->running_order[nodenum];
+		node_description *node = info->update_list[nodenum];
+		(*node->module.step)(node);
+	}
 
-			/* Now step the node */
-			if (node->module.step)
-				(*node->module.step)(node);
+	/* Independent sub-graphs run concurrently; the outputs are then built serially */
+	if (info->queue != NULL && length >= DISCRETE_PARALLEL_MIN_SAMPLES)
+	{
+		/* make sure the tap buffers can hold this update */
+		if (length > info->tap_length)
+		{
+			for (tapnum = 0; tapnum < info->tap_count; tapnum++)
+			{
+				free(info->tap_buffer[tapnum]);
+				info->tap_buffer[tapnum] = malloc_or_die(length * sizeof(info->tap_buffer[tapnum][0]));
+			}
+			info->tap_length = length;
 		}
 
-		/* Add gain to the output and put into the buffers */
-		/* Clipping will be handled by the main sound system */
-		for (outputnum = 0; outputnum < info->discrete_outputs; outputnum++)
+		for (nodenum = 0; nodenum < info->task_count; nodenum++)
 		{
-			val = (*info->output_node[outputnum]->input[0]) * (*info->output_node[outputnum]->input[1]);
-			buffer[outputnum][samplenum] = val;
+			info->tasks[nodenum].samples = length;
+			osd_work_item_queue(info->queue, discrete_task_callback, &info->tasks[nodenum], WORK_ITEM_FLAG_AUTO_RELEASE);
 		}
+		/* the workers write the tap buffers and node state until they finish, so we can't go on without them */
+		if (!osd_work_queue_wait(info->queue, 100 * osd_ticks_per_second()))
+			fatalerror("discrete_stream_update() - Sub-graph evaluation timed out");
 
-		/* Dump any csv logs */
-		for (outputnum = 0; outputnum < info->num_csvlogs; outputnum++)
+		for (samplenum = 0; samplenum < length; samplenum++)
 		{
-			fprintf(info->disc_csv_file[outputnum], "%lld", ++info->sample_num);
-			for (nodenum = 0; nodenum < info->csvlog_node[outputnum]->active_inputs; nodenum++)
-			{
-				fprintf(info->disc_csv_file[outputnum], ", %f", *info->csvlog_node[outputnum]->input[nodenum]);
-			}
-			fprintf(info->disc_csv_file[outputnum], "\n");
+			/* put each tapped node back the way it was at this sample */
+			for (tapnum = 0; tapnum < info->tap_count; tapnum++)
+				info->tap_node[tapnum]->output = info->tap_buffer[tapnum][samplenum];
+			discrete_write_sample(info, buffer, samplenum);
 		}
+	}
 
-		/* Dump any wave logs */
-		for (outputnum = 0; outputnum < info->num_wavelogs; outputnum++)
+	/* Now we must do length iterations of the node list, one output for each step */
+	else
+	{
+		for (samplenum = 0; samplenum < length; samplenum++)
 		{
-			/* get nodes to be logged and apply gain, then clip to 16 bit */
-			val = (*info->wavelog_node[outputnum]->input[0]) * (*info->wavelog_node[outputnum]->input[1]);
-			val = (val < -32768) ? -32768 : (val > 32767) ? 32767 : val;
-			wave_data_l = (INT16)val;
-			if (info->wavelog_node[outputnum]->active_inputs == 2)
+			/* loop over the nodes that change every sample */
+			for (nodenum = 0; nodenum < info->step_count; nodenum++)
 			{
-				/* DISCRETE_WAVELOG1 */
-				wav_add_data_16(info->disc_wav_file[outputnum], &wave_data_l, 1);
+				node_description *node = info->step_list[nodenum];
+				(*node->module.step)(node);
 			}
-			else
-			{
-				/* DISCRETE_WAVELOG2 */
-				val = (*info->wavelog_node[outputnum]->input[2]) * (*info->wavelog_node[outputnum]->input[3]);
-				val = (val < -32768) ? -32768 : (val > 32767) ? 32767 : val;
-				wave_data_r = (INT16)val;
 
-				wav_add_data_16lr(info->disc_wav_file[outputnum], &wave_data_l, &wave_data_r, 1);
-			}
+			discrete_write_sample(info, buffer, samplenum);
 		}
 	}
 
@@ -664,6 +784,398 @@ static void find_input_nodes(discrete_info *info, discrete_sound_block *block_li
 
 
 
+/*************************************
+ *
+ *  Plan node execution
+ *
+ *  Every node lands in one of these tiers:
+ *
+ *  constant   - pure nodes fed only by constants; discrete_reset()
+ *               leaves their value in place and they are never
+ *               stepped again
+ *  per-update - pure nodes fed by DSS_INPUT_DATA/LOGIC/NOT and
+ *               constants; those inputs only change in
+ *               discrete_sound_w(), between stream updates, so one
+ *               step per update gives the same result
+ *  per-sample - everything else, in the original running order
+ *
+ *  A DST_GAIN whose only reader is a later DST_ADDER is also folded
+ *  into that adder.  None of this changes the order or precision of
+ *  any calculation, so the output is bit-identical to stepping every
+ *  node every sample (DISCRETE_PLAN 0).
+ *
+ *  Some modules also read other nodes through pointers they set up in
+ *  their reset function (mixer rNode resistors, op-amp oscillator
+ *  resistor nodes).  Their extra_inputs hook lists those nodes, and
+ *  they count as sources everywhere a regular input does.
+ *
+ *************************************/
+
+#define DISCRETE_MAX_EXTRA_INPUTS	(8)
+#define DISCRETE_MAX_SOURCES		(DISCRETE_MAX_INPUTS + DISCRETE_MAX_EXTRA_INPUTS)
+
+enum
+{
+	TIER_CONSTANT = 0,
+	TIER_UPDATE,
+	TIER_SAMPLE,
+	TIER_FUSED
+};
+
+static int is_pure_module(int type)
+{
+	/* modules whose output depends only on their inputs */
+	switch (type)
+	{
+		case DSS_CONSTANT:
+		case DST_ADDER:
+		case DST_CLAMP:
+		case DST_DIVIDE:
+		case DST_GAIN:
+		case DST_LOGIC_INV:
+		case DST_LOGIC_AND:
+		case DST_LOGIC_NAND:
+		case DST_LOGIC_OR:
+		case DST_LOGIC_NOR:
+		case DST_LOGIC_XOR:
+		case DST_LOGIC_NXOR:
+		case DST_LOOKUP_TABLE:
+		case DST_SWITCH:
+		case DST_ASWITCH:
+		case DST_TRANSFORM:
+		case DST_COMP_ADDER:
+			return TRUE;
+	}
+	return FALSE;
+}
+
+static int input_source(discrete_info *info, node_description *node, int inputnum)
+{
+	/* returns the running order index of the node feeding an input, or -1 for a plain value */
+	if (!(node->input_is_node & (1 << inputnum)))
+		return -1;
+	return info->indexed_node[node->block->input_node[inputnum] - NODE_START] - info->node_list;
+}
+
+static int node_sources(discrete_info *info, node_description *node, int *src)
+{
+	/* fills in the running order indexes of every node this one reads, */
+	/* through its inputs or its extra_inputs hook; returns the count */
+	int extra[DISCRETE_MAX_EXTRA_INPUTS];
+	int inputnum, extracount, count = 0;
+
+	for (inputnum = 0; inputnum < node->active_inputs; inputnum++)
+	{
+		int index = input_source(info, node, inputnum);
+		if (index >= 0)
+			src[count++] = index;
+	}
+
+	if (node->module.extra_inputs != NULL)
+	{
+		extracount = (*node->module.extra_inputs)(node, extra, DISCRETE_MAX_EXTRA_INPUTS);
+		for (inputnum = 0; inputnum < extracount; inputnum++)
+		{
+			node_description *source = discrete_find_node(info, extra[inputnum]);
+			if (source != NULL)
+				src[count++] = source - info->node_list;
+		}
+	}
+	return count;
+}
+
+static void plan_nodes(discrete_info *info)
+{
+	size_t count = info->node_count;
+	UINT8 *tier = malloc_or_die(count * sizeof(*tier));
+	UINT8 *demoted = malloc_or_die(count * sizeof(*demoted));
+	int *readers = malloc_or_die(count * sizeof(*readers));
+	int src[DISCRETE_MAX_SOURCES];
+	int plan = DISCRETE_PLAN, hoist = DISCRETE_PLAN;
+	int nodenum, inputnum, srccount, changed;
+	int constants = 0, fused = 0;
+
+	memset(demoted, 0, count * sizeof(*demoted));
+	memset(readers, 0, count * sizeof(*readers));
+
+	for (nodenum = 0; nodenum < count; nodenum++)
+	{
+		node_description *node = &info->node_list[nodenum];
+
+		/* custom steps may read any node through discrete_find_node(), so */
+		/* only fold constants in circuits that contain them */
+		if (node->module.type == DST_CUSTOM)
+			hoist = FALSE;
+
+		/* count how many inputs each node feeds */
+		srccount = node_sources(info, node, src);
+		for (inputnum = 0; inputnum < srccount; inputnum++)
+			readers[src[inputnum]]++;
+	}
+
+	do
+	{
+		/* classify in running order; an input fed by this node or a later */
+		/* one sees the previous sample's value, so it forces per-sample */
+		for (nodenum = 0; nodenum < count; nodenum++)
+		{
+			node_description *node = &info->node_list[nodenum];
+			int type = node->module.type;
+			int level;
+
+			if (node->module.step == NULL)
+			{
+				tier[nodenum] = TIER_CONSTANT;
+				continue;
+			}
+
+			if (!plan || demoted[nodenum])
+				level = TIER_SAMPLE;
+			else if (type == DSS_INPUT_DATA || type == DSS_INPUT_LOGIC || type == DSS_INPUT_NOT)
+				level = hoist ? TIER_UPDATE : TIER_SAMPLE;
+			else if (is_pure_module(type))
+				level = TIER_CONSTANT;
+			else
+				level = TIER_SAMPLE;
+
+			srccount = node_sources(info, node, src);
+			for (inputnum = 0; inputnum < srccount && level != TIER_SAMPLE; inputnum++)
+			{
+				if (src[inputnum] >= nodenum)
+					level = TIER_SAMPLE;
+				else if (tier[src[inputnum]] > level)
+					level = tier[src[inputnum]];
+			}
+			tier[nodenum] = level;
+		}
+
+		/* a per-update node read by an earlier node would hand it the new */
+		/* value a sample too soon; step those per sample instead */
+		changed = FALSE;
+		for (nodenum = 0; nodenum < count; nodenum++)
+		{
+			node_description *node = &info->node_list[nodenum];
+
+			if (node->module.step == NULL)
+				continue;
+			srccount = node_sources(info, node, src);
+			for (inputnum = 0; inputnum < srccount; inputnum++)
+				if (src[inputnum] >= nodenum && tier[src[inputnum]] == TIER_UPDATE)
+				{
+					demoted[src[inputnum]] = TRUE;
+					changed = TRUE;
+				}
+		}
+	} while (changed);
+
+	/* fold gain stages that feed nothing but a later adder into it */
+	for (nodenum = 0; hoist && nodenum < count; nodenum++)
+	{
+		node_description *node = &info->node_list[nodenum];
+		struct dst_adder_fused_context *context = NULL;
+
+		if (node->module.type != DST_ADDER || tier[nodenum] != TIER_SAMPLE)
+			continue;
+
+		for (inputnum = 1; inputnum <= 4; inputnum++)
+		{
+			int gainnum = input_source(info, node, inputnum);
+			node_description *gain;
+			int gaininput;
+
+			if (gainnum < 0 || gainnum >= nodenum || readers[gainnum] != 1 || tier[gainnum] != TIER_SAMPLE)
+				continue;
+			gain = &info->node_list[gainnum];
+			if (gain->module.type != DST_GAIN)
+				continue;
+
+			/* the gain now runs in the adder's slot, so everything it */
+			/* reads must already be final by the gain's own slot */
+			srccount = node_sources(info, gain, src);
+			for (gaininput = 0; gaininput < srccount; gaininput++)
+				if (src[gaininput] >= gainnum)
+					break;
+			if (gaininput < srccount)
+				continue;
+
+			if (context == NULL)
+			{
+				context = auto_malloc(sizeof(*context));
+				memset(context, 0, sizeof(*context));
+			}
+			context->gain[inputnum - 1] = gain;
+			tier[gainnum] = TIER_FUSED;
+			fused++;
+		}
+
+		if (context != NULL)
+		{
+			node->context = context;
+			node->module.step = dst_adder_fused_step;
+		}
+	}
+
+	/* build the per-update and per-sample lists in running order */
+	info->update_list = auto_malloc(count * sizeof(info->update_list[0]));
+	info->step_list = auto_malloc(count * sizeof(info->step_list[0]));
+	info->update_count = info->step_count = 0;
+	for (nodenum = 0; nodenum < count; nodenum++)
+	{
+		node_description *node = info->running_order[nodenum];
+		int index = node - info->node_list;
+
+		if (node->module.step == NULL)
+			continue;
+		switch (tier[index])
+		{
+			case TIER_CONSTANT:	constants++;								break;
+			case TIER_UPDATE:	info->update_list[info->update_count++] = node;	break;
+			case TIER_SAMPLE:	info->step_list[info->step_count++] = node;		break;
+		}
+	}
+
+	discrete_log("plan_nodes() - %d nodes: %d constant, %d per update, %d per sample, %d gains fused",
+			(int)count, constants, info->update_count, info->step_count, fused);
+
+	/* split what's left into sub-graphs that can run side by side */
+	if (hoist)
+		partition_nodes(info, tier);
+
+	free(readers);
+	free(demoted);
+	free(tier);
+}
+
+
+
+/*************************************
+ *
+ *  Partition into independent sub-graphs
+ *
+ *  Per-sample nodes joined by an input, in either direction, share a
+ *  sub-graph; extra_inputs links count the same way.  Constant and per-update nodes don't change during the
+ *  sample loop, so reading one doesn't tie sub-graphs together.  All
+ *  DSS_NOISE nodes draw from mame_rand(), so they are kept in a single
+ *  sub-graph to preserve the draw order; each sub-graph then runs
+ *  exactly as the serial loop would and the output is identical.
+ *
+ *************************************/
+
+static int find_root(int *parent, int index)
+{
+	while (parent[index] != index)
+		index = parent[index] = parent[parent[index]];
+	return index;
+}
+
+static void join_nodes(int *parent, int a, int b)
+{
+	parent[find_root(parent, a)] = find_root(parent, b);
+}
+
+static void partition_nodes(discrete_info *info, const UINT8 *tier)
+{
+	int count = info->node_count;
+	int *parent = malloc_or_die(count * sizeof(parent[0]));
+	int *task_of = malloc_or_die(count * sizeof(task_of[0]));
+	int *tap_of = malloc_or_die(count * sizeof(tap_of[0]));
+	int src[DISCRETE_MAX_SOURCES];
+	int nodenum, inputnum, srccount, tasknum, noise = -1;
+
+	for (nodenum = 0; nodenum < count; nodenum++)
+	{
+		parent[nodenum] = nodenum;
+		task_of[nodenum] = -1;
+		tap_of[nodenum] = -1;
+	}
+
+	/* join each per-sample node to the per-sample nodes feeding it */
+	for (nodenum = 0; nodenum < count; nodenum++)
+	{
+		node_description *node = &info->node_list[nodenum];
+
+		if (tier[nodenum] != TIER_SAMPLE && tier[nodenum] != TIER_FUSED)
+			continue;
+
+		if (node->module.type == DSS_NOISE)
+		{
+			if (noise < 0)
+				noise = nodenum;
+			else
+				join_nodes(parent, nodenum, noise);
+		}
+
+		srccount = node_sources(info, node, src);
+		for (inputnum = 0; inputnum < srccount; inputnum++)
+			if (tier[src[inputnum]] == TIER_SAMPLE || tier[src[inputnum]] == TIER_FUSED)
+				join_nodes(parent, nodenum, src[inputnum]);
+	}
+
+	/* number the sub-graphs in order of first appearance */
+	info->task_count = 0;
+	for (nodenum = 0; nodenum < info->step_count; nodenum++)
+	{
+		int root = find_root(parent, info->step_list[nodenum] - info->node_list);
+		if (task_of[root] < 0)
+			task_of[root] = info->task_count++;
+	}
+
+	/* a single sub-graph just runs in the serial loop */
+	if (info->task_count > 1)
+	{
+		info->tasks = auto_malloc(info->task_count * sizeof(info->tasks[0]));
+		memset(info->tasks, 0, info->task_count * sizeof(info->tasks[0]));
+		for (tasknum = 0; tasknum < info->task_count; tasknum++)
+		{
+			info->tasks[tasknum].info = info;
+			info->tasks[tasknum].step_list = auto_malloc(info->step_count * sizeof(info->tasks[tasknum].step_list[0]));
+			info->tasks[tasknum].tap = auto_malloc(count * sizeof(info->tasks[tasknum].tap[0]));
+		}
+
+		/* hand out the per-sample nodes, keeping running order within each */
+		for (nodenum = 0; nodenum < info->step_count; nodenum++)
+		{
+			node_description *node = info->step_list[nodenum];
+			discrete_task *task = &info->tasks[task_of[find_root(parent, node - info->node_list)]];
+			task->step_list[task->step_count++] = node;
+		}
+
+		/* tap every per-sample node that an output or log node reads */
+		info->tap_node = auto_malloc(count * sizeof(info->tap_node[0]));
+		info->tap_buffer = auto_malloc(count * sizeof(info->tap_buffer[0]));
+		memset(info->tap_buffer, 0, count * sizeof(info->tap_buffer[0]));
+		for (nodenum = 0; nodenum < count; nodenum++)
+		{
+			node_description *node = &info->node_list[nodenum];
+
+			if (node->node != NODE_SPECIAL)
+				continue;
+			for (inputnum = 0; inputnum < node->active_inputs; inputnum++)
+			{
+				int src = input_source(info, node, inputnum);
+				discrete_task *task;
+
+				if (src < 0 || tier[src] != TIER_SAMPLE || tap_of[src] >= 0)
+					continue;
+				task = &info->tasks[task_of[find_root(parent, src)]];
+				tap_of[src] = info->tap_count;
+				task->tap[task->tap_count++] = info->tap_count;
+				info->tap_node[info->tap_count++] = &info->node_list[src];
+			}
+		}
+
+		info->queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	}
+
+	discrete_log("partition_nodes() - %d independent sub-graphs, %d tapped nodes", info->task_count, info->tap_count);
+
+	free(tap_of);
+	free(task_of);
+	free(parent);
+}
+
+
+
 /*************************************
  *
  *  Set up the output nodes
@@ -3261,6 +3261,7 @@ struct _discrete_module
 	size_t			contextsize;
 	void (*reset)(node_description *node);	/* Called to reset a node after creation or system reset */
 	void (*step)(node_description *node);	/* Called to execute one time delta of output update */
+	int (*extra_inputs)(node_description *node, int *nodes, int maxnodes);	/* Lists nodes read through discrete_find_node() instead of inputs */
 };
 typedef struct _discrete_module discrete_module;
 
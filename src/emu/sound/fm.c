@@ -571,12 +571,6 @@ typedef struct
 	UINT8	FB;			/* feedback shift */
 	INT32	op1_out[2];	/* op1 output for feedback */
 
-	INT32	*connect1;	/* SLOT1 output pointer */
-	INT32	*connect3;	/* SLOT3 output pointer */
-	INT32	*connect2;	/* SLOT2 output pointer */
-	INT32	*connect4;	/* SLOT4 output pointer */
-
-	INT32	*mem_connect;/* where to put the delayed sample (MEM) */
 	INT32	mem_value;	/* delayed sample (MEM) value */
 
 	INT32	pms;		/* channel PMS */
@@ -658,23 +652,10 @@ typedef struct
 	UINT32	lfo_inc;
 
 	UINT32	lfo_freq[8];	/* LFO FREQ table */
-} FM_OPN;
-
-
 
-/* current chip state */
-static INT32	m2,c1,c2;		/* Phase Modulation input for operators 2,3,4 */
-static INT32	mem;			/* one sample delay memory */
-
-static INT32	out_fm[8];		/* outputs of working channels */
-
-#if (BUILD_YM2608||BUILD_YM2610||BUILD_YM2610B)
-static INT32	out_adpcm[4];	/* channel output NONE,LEFT,RIGHT or CENTER for YM2608/YM2610 ADPCM */
-static INT32	out_delta[4];	/* channel output NONE,LEFT,RIGHT or CENTER for YM2608/YM2610 DELTAT*/
-#endif
-
-static UINT32	LFO_AM;			/* runtime LFO calculations helper */
-static INT32	LFO_PM;			/* runtime LFO calculations helper */
+	UINT32	lfo_am;			/* runtime LFO calculations helper */
+	INT32	lfo_pm;			/* runtime LFO calculations helper */
+} FM_OPN;
 
 
 /* log output level */
@@ -886,93 +867,6 @@ INLINE void FM_KEYOFF(FM_CH *CH , int s )
 	}
 }
 
-/* set algorithm connection */
-static void setup_connection( FM_CH *CH, int ch )
-{
-	INT32 *carrier = &out_fm[ch];
-
-	INT32 **om1 = &CH->connect1;
-	INT32 **om2 = &CH->connect3;
-	INT32 **oc1 = &CH->connect2;
-
-	INT32 **memc = &CH->mem_connect;
-
-	switch( CH->ALGO ){
-	case 0:
-		/* M1---C1---MEM---M2---C2---OUT */
-		*om1 = &c1;
-		*oc1 = &mem;
-		*om2 = &c2;
-		*memc= &m2;
-		break;
-	case 1:
-		/* M1------+-MEM---M2---C2---OUT */
-		/*      C1-+                     */
-		*om1 = &mem;
-		*oc1 = &mem;
-		*om2 = &c2;
-		*memc= &m2;
-		break;
-	case 2:
-		/* M1-----------------+-C2---OUT */
-		/*      C1---MEM---M2-+          */
-		*om1 = &c2;
-		*oc1 = &mem;
-		*om2 = &c2;
-		*memc= &m2;
-		break;
-	case 3:
-		/* M1---C1---MEM------+-C2---OUT */
-		/*                 M2-+          */
-		*om1 = &c1;
-		*oc1 = &mem;
-		*om2 = &c2;
-		*memc= &c2;
-		break;
-	case 4:
-		/* M1---C1-+-OUT */
-		/* M2---C2-+     */
-		/* MEM: not used */
-		*om1 = &c1;
-		*oc1 = carrier;
-		*om2 = &c2;
-		*memc= &mem;	/* store it anywhere where it will not be used */
-		break;
-	case 5:
-		/*    +----C1----+     */
-		/* M1-+-MEM---M2-+-OUT */
-		/*    +----C2----+     */
-		*om1 = 0;	/* special mark */
-		*oc1 = carrier;
-		*om2 = carrier;
-		*memc= &m2;
-		break;
-	case 6:
-		/* M1---C1-+     */
-		/*      M2-+-OUT */
-		/*      C2-+     */
-		/* MEM: not used */
-		*om1 = &c1;
-		*oc1 = carrier;
-		*om2 = carrier;
-		*memc= &mem;	/* store it anywhere where it will not be used */
-		break;
-	case 7:
-		/* M1-+     */
-		/* C1-+-OUT */
-		/* M2-+     */
-		/* C2-+     */
-		/* MEM: not used*/
-		*om1 = carrier;
-		*oc1 = carrier;
-		*om2 = carrier;
-		*memc= &mem;	/* store it anywhere where it will not be used */
-		break;
-	}
-
-	CH->connect4 = carrier;
-}
-
 /* set detune & multiple */
 INLINE void set_det_mul(FM_ST *ST,FM_CH *CH,FM_SLOT *SLOT,int v)
 {
@@ -1087,32 +981,30 @@ INLINE void advance_lfo(FM_OPN *OPN)
 		/* update AM when LFO output changes */
 
 		/*if (prev_pos != pos)*/
-		/* actually I can't optimize is this way without rewritting chan_calc()
-        to use chip->lfo_am instead of global lfo_am */
 		{
 
 			/* triangle */
 			/* AM: 0 to 126 step +2, 126 to 0 step -2 */
 			if (pos<64)
-				LFO_AM = (pos&63) * 2;
+				OPN->lfo_am = (pos&63) * 2;
 			else
-				LFO_AM = 126 - ((pos&63) * 2);
+				OPN->lfo_am = 126 - ((pos&63) * 2);
 		}
 
 		/* PM works with 4 times slower clock */
 		prev_pos >>= 2;
 		pos >>= 2;
 		/* update PM when LFO output changes */
-		/*if (prev_pos != pos)*/ /* can't use global lfo_pm for this optimization, must be chip->lfo_pm instead*/
+		/*if (prev_pos != pos)*/
 		{
-			LFO_PM = pos;
+			OPN->lfo_pm = pos;
 		}
 
 	}
 	else
 	{
-		LFO_AM = 0;
-		LFO_PM = 0;
+		OPN->lfo_am = 0;
+		OPN->lfo_pm = 0;
 	}
 }
 
@@ -1256,55 +1148,110 @@ static void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
 
 #define volume_calc(OP) ((OP)->vol_out + (AM & (OP)->AMmask))
 
-INLINE void chan_calc(FM_OPN *OPN, FM_CH *CH)
+/* output of one of SLOT2..SLOT4 with phase modulation input pm */
+INLINE INT32 slot_calc(FM_SLOT *SLOT, UINT32 AM, INT32 pm)
 {
-	unsigned int eg_out;
-
-	UINT32 AM = LFO_AM >> CH->ams;
+	unsigned int eg_out = volume_calc(SLOT);
 
+	if( eg_out < ENV_QUIET )
+		return op_calc(SLOT->phase, eg_out, pm);
+	return 0;
+}
 
-	m2 = c1 = c2 = mem = 0;
-
-	*CH->mem_connect = CH->mem_value;	/* restore delayed sample (MEM) value to m2 or c2 */
+/* calculate one channel and return its output; forced inline since it is
+   the inner loop of every update routine */
+INLINE ATTR_FORCE_INLINE INT32 chan_calc(FM_OPN *OPN, FM_CH *CH)
+{
+	FM_SLOT *SLOT = CH->SLOT;
+	UINT32 AM = OPN->lfo_am >> CH->ams;
+	unsigned int eg_out;
+	INT32 m1, c2, out;
 
-	eg_out = volume_calc(&CH->SLOT[SLOT1]);
+	eg_out = volume_calc(&SLOT[SLOT1]);
 	{
-		INT32 out = CH->op1_out[0] + CH->op1_out[1];
+		INT32 fb = CH->op1_out[0] + CH->op1_out[1];
 		CH->op1_out[0] = CH->op1_out[1];
 
-		if( !CH->connect1 ){
-			/* algorithm 5  */
-			mem = c1 = c2 = CH->op1_out[0];
-		}else{
-			/* other algorithms */
-			*CH->connect1 += CH->op1_out[0];
-		}
-
 		CH->op1_out[1] = 0;
 		if( eg_out < ENV_QUIET )	/* SLOT 1 */
 		{
 			if (!CH->FB)
-				out=0;
+				fb=0;
 
-			CH->op1_out[1] = op_calc1(CH->SLOT[SLOT1].phase, eg_out, (out<<CH->FB) );
+			CH->op1_out[1] = op_calc1(SLOT[SLOT1].phase, eg_out, (fb<<CH->FB) );
 		}
 	}
+	m1 = CH->op1_out[0];
 
-	eg_out = volume_calc(&CH->SLOT[SLOT3]);
-	if( eg_out < ENV_QUIET )		/* SLOT 3 */
-		*CH->connect3 += op_calc(CH->SLOT[SLOT3].phase, eg_out, m2);
-
-	eg_out = volume_calc(&CH->SLOT[SLOT2]);
-	if( eg_out < ENV_QUIET )		/* SLOT 2 */
-		*CH->connect2 += op_calc(CH->SLOT[SLOT2].phase, eg_out, c1);
-
-	eg_out = volume_calc(&CH->SLOT[SLOT4]);
-	if( eg_out < ENV_QUIET )		/* SLOT 4 */
-		*CH->connect4 += op_calc(CH->SLOT[SLOT4].phase, eg_out, c2);
-
-
-	/* store current MEM */
-	CH->mem_value = mem;
+	/* operators are evaluated in the order SLOT1 (M1), SLOT3 (M2), SLOT2 (C1), SLOT4 (C2);
+       MEM delays its input by one sample */
+	switch( CH->ALGO )
+	{
+	case 0:
+		/* M1---C1---MEM---M2---C2---OUT */
+		c2  = slot_calc(&SLOT[SLOT3], AM, CH->mem_value);
+		CH->mem_value = slot_calc(&SLOT[SLOT2], AM, m1);
+		out = slot_calc(&SLOT[SLOT4], AM, c2);
+		break;
+	case 1:
+		/* M1------+-MEM---M2---C2---OUT */
+		/*      C1-+                     */
+		c2  = slot_calc(&SLOT[SLOT3], AM, CH->mem_value);
+		CH->mem_value = m1 + slot_calc(&SLOT[SLOT2], AM, 0);
+		out = slot_calc(&SLOT[SLOT4], AM, c2);
+		break;
+	case 2:
+		/* M1-----------------+-C2---OUT */
+		/*      C1---MEM---M2-+          */
+		c2  = m1 + slot_calc(&SLOT[SLOT3], AM, CH->mem_value);
+		CH->mem_value = slot_calc(&SLOT[SLOT2], AM, 0);
+		out = slot_calc(&SLOT[SLOT4], AM, c2);
+		break;
+	case 3:
+		/* M1---C1---MEM------+-C2---OUT */
+		/*                 M2-+          */
+		c2  = CH->mem_value + slot_calc(&SLOT[SLOT3], AM, 0);
+		CH->mem_value = slot_calc(&SLOT[SLOT2], AM, m1);
+		out = slot_calc(&SLOT[SLOT4], AM, c2);
+		break;
+	case 4:
+		/* M1---C1-+-OUT */
+		/* M2---C2-+     */
+		/* MEM: not used */
+		c2  = slot_calc(&SLOT[SLOT3], AM, 0);
+		out = slot_calc(&SLOT[SLOT2], AM, m1);
+		out += slot_calc(&SLOT[SLOT4], AM, c2);
+		break;
+	case 5:
+		/*    +----C1----+     */
+		/* M1-+-MEM---M2-+-OUT */
+		/*    +----C2----+     */
+		out = slot_calc(&SLOT[SLOT3], AM, CH->mem_value);
+		out += slot_calc(&SLOT[SLOT2], AM, m1);
+		out += slot_calc(&SLOT[SLOT4], AM, m1);
+		CH->mem_value = m1;
+		break;
+	case 6:
+		/* M1---C1-+     */
+		/*      M2-+-OUT */
+		/*      C2-+     */
+		/* MEM: not used */
+		out = slot_calc(&SLOT[SLOT3], AM, 0);
+		out += slot_calc(&SLOT[SLOT2], AM, m1);
+		out += slot_calc(&SLOT[SLOT4], AM, 0);
+		break;
+	default:
+		/* M1-+     */
+		/* C1-+-OUT */
+		/* M2-+     */
+		/* C2-+     */
+		/* MEM: not used*/
+		out = m1;
+		out += slot_calc(&SLOT[SLOT3], AM, 0);
+		out += slot_calc(&SLOT[SLOT2], AM, 0);
+		out += slot_calc(&SLOT[SLOT4], AM, 0);
+		break;
+	}
 
 	/* update phase counters AFTER output calculations */
 	if(CH->pms)
@@ -1317,7 +1264,7 @@ INLINE void chan_calc(FM_OPN *OPN, FM_CH *CH)
 		UINT32 block_fnum = CH->block_fnum;
 
 		UINT32 fnum_lfo   = ((block_fnum & 0x7f0) >> 4) * 32 * 8;
-		INT32  lfo_fn_table_index_offset = lfo_pm_table[ fnum_lfo + CH->pms + LFO_PM ];
+		INT32  lfo_fn_table_index_offset = lfo_pm_table[ fnum_lfo + CH->pms + OPN->lfo_pm ];
 
 		if (lfo_fn_table_index_offset)	/* LFO phase modulation active */
 		{
@@ -1355,6 +1302,8 @@ INLINE void chan_calc(FM_OPN *OPN, FM_CH *CH)
 		CH->SLOT[SLOT3].phase += CH->SLOT[SLOT3].Incr;
 		CH->SLOT[SLOT4].phase += CH->SLOT[SLOT4].Incr;
 	}
+
+	return out;
 }
 
 /* update phase increment and envelope generator */
@@ -1926,7 +1875,6 @@ static void OPNWriteReg(FM_OPN *OPN, int r, int v)
 				int feedback = (v>>3)&7;
 				CH->ALGO = v&7;
 				CH->FB   = feedback ? feedback+6 : 0;
-				setup_connection( CH, c );
 			}
 			break;
 		case 1:		/* 0xb4-0xb6 : L , R , AMS , PMS (YM2612/YM2610B/YM2610/YM2608) */
@@ -2021,6 +1969,7 @@ void YM2203UpdateOne(void *chip, FMSAMPLE *buffer, int length)
 	int i;
 	FMSAMPLE *buf = buffer;
 	FM_CH	*cch[3];
+	INT32	out_fm[3];		/* outputs of working channels */
 
 	cch[0]   = &F2203->CH[0];
 	cch[1]   = &F2203->CH[1];
@@ -2043,18 +1992,13 @@ void YM2203UpdateOne(void *chip, FMSAMPLE *buffer, int length)
 	}else refresh_fc_eg_chan( cch[2] );
 
 
-	/* YM2203 doesn't have LFO so we must keep these globals at 0 level */
-	LFO_AM = 0;
-	LFO_PM = 0;
+	/* YM2203 doesn't have LFO so we must keep these at 0 level */
+	OPN->lfo_am = 0;
+	OPN->lfo_pm = 0;
 
 	/* buffering */
 	for (i=0; i < length ; i++)
 	{
-		/* clear outputs */
-		out_fm[0] = 0;
-		out_fm[1] = 0;
-		out_fm[2] = 0;
-
 		/* advance envelope generator */
 		OPN->eg_timer += OPN->eg_timer_add;
 		while (OPN->eg_timer >= OPN->eg_timer_overflow)
@@ -2068,9 +2012,9 @@ void YM2203UpdateOne(void *chip, FMSAMPLE *buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0] );
-		chan_calc(OPN, cch[1] );
-		chan_calc(OPN, cch[2] );
+		out_fm[0] = chan_calc(OPN, cch[0] );
+		out_fm[1] = chan_calc(OPN, cch[1] );
+		out_fm[2] = chan_calc(OPN, cch[2] );
 
 		/* buffering */
 		{
@@ -2341,6 +2285,9 @@ typedef struct
 	UINT8		adpcm_arrivedEndAddress;
 	YM_DELTAT 	deltaT;				/* Delta-T ADPCM unit   */
 
+	INT32		out_adpcm[4];		/* channel output NONE,LEFT,RIGHT or CENTER for ADPCM */
+	INT32		out_delta[4];		/* channel output NONE,LEFT,RIGHT or CENTER for DELTAT */
+
     UINT8		flagmask;			/* YM2608 only */
     UINT8		irqmask;			/* YM2608 only */
 } YM2610;
@@ -2353,9 +2300,6 @@ typedef YM2610 YM2608;
 #define ADPCM_SHIFT    (16)      /* frequency step rate   */
 #define ADPCMA_ADDRESS_SHIFT 8   /* adpcm A address shift */
 
-static UINT8 *pcmbufA;
-static UINT32 pcmsizeA;
-
 
 /* Algorithm and tables verified on real YM2608 and YM2610 */
 
@@ -2418,7 +2362,7 @@ INLINE void ADPCMA_calc_chan( YM2610 *F2610, ADPCM_CH *ch )
 				return;
 			}
 #if 0
-			if ( ch->now_addr > (pcmsizeA<<1) ) {
+			if ( ch->now_addr > (F2610->pcm_size<<1) ) {
 				LOG(LOG_WAR,("YM2610: Attempting to play past adpcm rom size!\n" ));
 				return;
 			}
@@ -2427,7 +2371,7 @@ INLINE void ADPCMA_calc_chan( YM2610 *F2610, ADPCM_CH *ch )
 				data = ch->now_data & 0x0f;
 			else
 			{
-				ch->now_data = *(pcmbufA+(ch->now_addr>>1));
+				ch->now_data = *(F2610->pcmbuf+(ch->now_addr>>1));
 				data = (ch->now_data >> 4) & 0x0f;
 			}
 
@@ -2548,7 +2492,7 @@ static void FM_ADPCMAWrite(YM2610 *F2610,int r,int v)
 				adpcm[c].vol_shift =  1 + (volume >> 3);	/* Yamaha engineers used the approximation: each -6 dB is close to divide by two (shift right) */
 			}
 
-			adpcm[c].pan    = &out_adpcm[(v>>6)&0x03];
+			adpcm[c].pan    = &F2610->out_adpcm[(v>>6)&0x03];
 
 			/* calc pcm * volume data */
 			adpcm[c].adpcm_out = ((adpcm[c].adpcm_acc * adpcm[c].vol_mul) >> adpcm[c].vol_shift) & ~3;	/* multiply, shift and mask out low 2 bits */
@@ -3191,9 +3135,12 @@ void YM2608UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 	YM2608 *F2608 = chip;
 	FM_OPN *OPN   = &F2608->OPN;
 	YM_DELTAT *DELTAT = &F2608->deltaT;
+	INT32 *out_adpcm = F2608->out_adpcm;
+	INT32 *out_delta = F2608->out_delta;
 	int i,j;
 	FMSAMPLE  *bufL,*bufR;
 	FM_CH	*cch[6];
+	INT32	out_fm[6];		/* outputs of working channels */
 
 	/* set bufer */
 	bufL = buffer[0];
@@ -3205,9 +3152,6 @@ void YM2608UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 	cch[3]   = &F2608->CH[3];
 	cch[4]   = &F2608->CH[4];
 	cch[5]   = &F2608->CH[5];
-	/* setup adpcm rom address */
-	pcmbufA  = F2608->pcmbuf;
-	pcmsizeA = F2608->pcm_size;
 
 	/* refresh PG and EG */
 	refresh_fc_eg_chan( cch[0] );
@@ -3237,13 +3181,6 @@ void YM2608UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 		/* clear output acc. */
 		out_adpcm[OUTD_LEFT] = out_adpcm[OUTD_RIGHT]= out_adpcm[OUTD_CENTER] = 0;
 		out_delta[OUTD_LEFT] = out_delta[OUTD_RIGHT]= out_delta[OUTD_CENTER] = 0;
-		/* clear outputs */
-		out_fm[0] = 0;
-		out_fm[1] = 0;
-		out_fm[2] = 0;
-		out_fm[3] = 0;
-		out_fm[4] = 0;
-		out_fm[5] = 0;
 
 		/* advance envelope generator */
 		OPN->eg_timer += OPN->eg_timer_add;
@@ -3261,12 +3198,12 @@ void YM2608UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0] );
-		chan_calc(OPN, cch[1] );
-		chan_calc(OPN, cch[2] );
-		chan_calc(OPN, cch[3] );
-		chan_calc(OPN, cch[4] );
-		chan_calc(OPN, cch[5] );
+		out_fm[0] = chan_calc(OPN, cch[0] );
+		out_fm[1] = chan_calc(OPN, cch[1] );
+		out_fm[2] = chan_calc(OPN, cch[2] );
+		out_fm[3] = chan_calc(OPN, cch[3] );
+		out_fm[4] = chan_calc(OPN, cch[4] );
+		out_fm[5] = chan_calc(OPN, cch[5] );
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
@@ -3528,7 +3465,7 @@ void YM2608ResetChip(void *chip)
 		F2608->adpcm[i].now_step  = 0;
 		/* F2608->adpcm[i].delta     = 21866; */
 		F2608->adpcm[i].vol_mul   = 0;
-		F2608->adpcm[i].pan       = &out_adpcm[OUTD_CENTER]; /* default center */
+		F2608->adpcm[i].pan       = &F2608->out_adpcm[OUTD_CENTER]; /* default center */
 		F2608->adpcm[i].flagMask  = 0;
 		F2608->adpcm[i].flag      = 0;
 		F2608->adpcm[i].adpcm_acc = 0;
@@ -3541,7 +3478,7 @@ void YM2608ResetChip(void *chip)
 
 	/* DELTA-T unit */
 	DELTAT->freqbase = OPN->ST.freqbase;
-	DELTAT->output_pointer = out_delta;
+	DELTAT->output_pointer = F2608->out_delta;
 	DELTAT->portshift = 5;		/* always 5bits shift */ /* ASG */
 	DELTAT->output_range = 1<<23;
 	YM_DELTAT_ADPCM_Reset(DELTAT,OUTD_CENTER,YM_DELTAT_EMULATION_MODE_NORMAL);
@@ -3737,9 +3674,12 @@ void YM2610UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 	YM2610 *F2610 = chip;
 	FM_OPN *OPN   = &F2610->OPN;
 	YM_DELTAT *DELTAT = &F2610->deltaT;
+	INT32 *out_adpcm = F2610->out_adpcm;
+	INT32 *out_delta = F2610->out_delta;
 	int i,j;
 	FMSAMPLE  *bufL,*bufR;
 	FM_CH	*cch[4];
+	INT32	out_fm[6];		/* outputs of working channels */
 
 	/* buffer setup */
 	bufL = buffer[0];
@@ -3749,9 +3689,6 @@ void YM2610UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 	cch[1] = &F2610->CH[2];
 	cch[2] = &F2610->CH[4];
 	cch[3] = &F2610->CH[5];
-	/* setup adpcm rom address */
-	pcmbufA  = F2610->pcmbuf;
-	pcmsizeA = F2610->pcm_size;
 
 #ifdef YM2610B_WARNING
 #define FM_KEY_IS(SLOT) ((SLOT)->key)
@@ -3788,11 +3725,6 @@ void YM2610UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 		/* clear output acc. */
 		out_adpcm[OUTD_LEFT] = out_adpcm[OUTD_RIGHT]= out_adpcm[OUTD_CENTER] = 0;
 		out_delta[OUTD_LEFT] = out_delta[OUTD_RIGHT]= out_delta[OUTD_CENTER] = 0;
-		/* clear outputs */
-		out_fm[1] = 0;
-		out_fm[2] = 0;
-		out_fm[4] = 0;
-		out_fm[5] = 0;
 
 		/* advance envelope generator */
 		OPN->eg_timer += OPN->eg_timer_add;
@@ -3808,10 +3740,10 @@ void YM2610UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0] );	/*remapped to 1*/
-		chan_calc(OPN, cch[1] );	/*remapped to 2*/
-		chan_calc(OPN, cch[2] );	/*remapped to 4*/
-		chan_calc(OPN, cch[3] );	/*remapped to 5*/
+		out_fm[1] = chan_calc(OPN, cch[0] );	/*remapped to 1*/
+		out_fm[2] = chan_calc(OPN, cch[1] );	/*remapped to 2*/
+		out_fm[4] = chan_calc(OPN, cch[2] );	/*remapped to 4*/
+		out_fm[5] = chan_calc(OPN, cch[3] );	/*remapped to 5*/
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
@@ -3874,9 +3806,12 @@ void YM2610BUpdateOne(void *chip, FMSAMPLE **buffer, int length)
 	YM2610 *F2610 = chip;
 	FM_OPN *OPN   = &F2610->OPN;
 	YM_DELTAT *DELTAT = &F2610->deltaT;
+	INT32 *out_adpcm = F2610->out_adpcm;
+	INT32 *out_delta = F2610->out_delta;
 	int i,j;
 	FMSAMPLE  *bufL,*bufR;
 	FM_CH	*cch[6];
+	INT32	out_fm[6];		/* outputs of working channels */
 
 	/* buffer setup */
 	bufL = buffer[0];
@@ -3888,9 +3823,6 @@ void YM2610BUpdateOne(void *chip, FMSAMPLE **buffer, int length)
 	cch[3] = &F2610->CH[3];
 	cch[4] = &F2610->CH[4];
 	cch[5] = &F2610->CH[5];
-	/* setup adpcm rom address */
-	pcmbufA  = F2610->pcmbuf;
-	pcmsizeA = F2610->pcm_size;
 
 	/* refresh PG and EG */
 	refresh_fc_eg_chan( cch[0] );
@@ -3919,13 +3851,6 @@ void YM2610BUpdateOne(void *chip, FMSAMPLE **buffer, int length)
 		/* clear output acc. */
 		out_adpcm[OUTD_LEFT] = out_adpcm[OUTD_RIGHT]= out_adpcm[OUTD_CENTER] = 0;
 		out_delta[OUTD_LEFT] = out_delta[OUTD_RIGHT]= out_delta[OUTD_CENTER] = 0;
-		/* clear outputs */
-		out_fm[0] = 0;
-		out_fm[1] = 0;
-		out_fm[2] = 0;
-		out_fm[3] = 0;
-		out_fm[4] = 0;
-		out_fm[5] = 0;
 
 		/* advance envelope generator */
 		OPN->eg_timer += OPN->eg_timer_add;
@@ -3943,12 +3868,12 @@ void YM2610BUpdateOne(void *chip, FMSAMPLE **buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0] );
-		chan_calc(OPN, cch[1] );
-		chan_calc(OPN, cch[2] );
-		chan_calc(OPN, cch[3] );
-		chan_calc(OPN, cch[4] );
-		chan_calc(OPN, cch[5] );
+		out_fm[0] = chan_calc(OPN, cch[0] );
+		out_fm[1] = chan_calc(OPN, cch[1] );
+		out_fm[2] = chan_calc(OPN, cch[2] );
+		out_fm[3] = chan_calc(OPN, cch[3] );
+		out_fm[4] = chan_calc(OPN, cch[4] );
+		out_fm[5] = chan_calc(OPN, cch[5] );
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
@@ -4192,7 +4117,7 @@ void YM2610ResetChip(void *chip)
 		F2610->adpcm[i].end       = 0;
 		/* F2610->adpcm[i].delta     = 21866; */
 		F2610->adpcm[i].vol_mul   = 0;
-		F2610->adpcm[i].pan       = &out_adpcm[OUTD_CENTER]; /* default center */
+		F2610->adpcm[i].pan       = &F2610->out_adpcm[OUTD_CENTER]; /* default center */
 		F2610->adpcm[i].flagMask  = 1<<i;
 		F2610->adpcm[i].flag      = 0;
 		F2610->adpcm[i].adpcm_acc = 0;
@@ -4205,7 +4130,7 @@ void YM2610ResetChip(void *chip)
 
 	/* DELTA-T unit */
 	DELTAT->freqbase = OPN->ST.freqbase;
-	DELTAT->output_pointer = out_delta;
+	DELTAT->output_pointer = F2610->out_delta;
 	DELTAT->portshift = 8;		/* allways 8bits shift */
 	DELTAT->output_range = 1<<23;
 	YM_DELTAT_ADPCM_Reset(DELTAT,OUTD_CENTER,YM_DELTAT_EMULATION_MODE_YM2610);
@@ -4388,8 +4313,6 @@ typedef struct
 	INT32		dacout;
 } YM2612;
 
-static int dacen;
-
 /* Generate samples for one of the YM2612s */
 void YM2612UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 {
@@ -4398,7 +4321,9 @@ void YM2612UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 	int i;
 	FMSAMPLE  *bufL,*bufR;
 	INT32 dacout  = F2612->dacout;
+	int dacen;
 	FM_CH	*cch[6];
+	INT32	out_fm[6];		/* outputs of working channels */
 
 	/* set bufer */
 	bufL = buffer[0];
@@ -4437,14 +4362,6 @@ void YM2612UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 
 		advance_lfo(OPN);
 
-		/* clear outputs */
-		out_fm[0] = 0;
-		out_fm[1] = 0;
-		out_fm[2] = 0;
-		out_fm[3] = 0;
-		out_fm[4] = 0;
-		out_fm[5] = 0;
-
 		/* advance envelope generator */
 		OPN->eg_timer += OPN->eg_timer_add;
 		while (OPN->eg_timer >= OPN->eg_timer_overflow)
@@ -4461,15 +4378,15 @@ void YM2612UpdateOne(void *chip, FMSAMPLE **buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(OPN, cch[0] );
-		chan_calc(OPN, cch[1] );
-		chan_calc(OPN, cch[2] );
-		chan_calc(OPN, cch[3] );
-		chan_calc(OPN, cch[4] );
+		out_fm[0] = chan_calc(OPN, cch[0] );
+		out_fm[1] = chan_calc(OPN, cch[1] );
+		out_fm[2] = chan_calc(OPN, cch[2] );
+		out_fm[3] = chan_calc(OPN, cch[3] );
+		out_fm[4] = chan_calc(OPN, cch[4] );
 		if( dacen )
-			*cch[5]->connect4 += dacout;
+			out_fm[5] = dacout;
 		else
-			chan_calc(OPN, cch[5] );
+			out_fm[5] = chan_calc(OPN, cch[5] );
 
 		{
 			int lt,rt;
@@ -23,6 +23,7 @@ CHANNEL_DEBUG enables the following keys:
 #include "sndintrf.h"
 #include "streams.h"
 #include "k054539.h"
+#include "pcmvoice.h"
 #include <math.h>
 
 /* Registers:
@@ -118,6 +119,25 @@ static void K054539_keyoff(struct k054539_info *info, int channel)
 		info->regs[0x22c] &= ~(1 << channel);
 }
 
+/*
+    First position after 'pos' that an 8-bit forward voice may not read
+    without checking: the next 0x80 end marker within the bytes 'length'
+    output samples can reach, or the end of that window / the rom.
+*/
+static int K054539_marker_limit(struct k054539_info *info, int pos, int pfrac, int delta, int length)
+{
+	UINT64 last = (UINT64)pos + (((UINT64)pfrac + (UINT64)delta * length) >> 16) + 1;
+	const unsigned char *marker;
+
+	if(pos < 0 || (UINT32)pos >= info->rom_size)
+		return pos;
+	if(last > info->rom_size)
+		last = info->rom_size;
+
+	marker = memchr(info->rom + pos + 1, 0x80, (size_t)last - pos - 1);
+	return marker ? marker - info->rom : (int)last;
+}
+
 static void K054539_update(void *param, stream_sample_t **inputs, stream_sample_t **buffer, int length)
 {
 	struct k054539_info *info = param;
@@ -236,7 +256,26 @@ else
 
 			switch(base2[0] & 0xc) {
 			case 0x0: { // 8bit pcm
-				for(i=0; i<length; i++) {
+				/* forward voices can skip the marker check up to the next 0x80 byte */
+				int span = 0;
+				if(pdelta > 0)
+					span = pcm_voice_span(cur_pos, cur_pfrac + delta, delta,
+						K054539_marker_limit(info, cur_pos, cur_pfrac, delta, length), length);
+
+				for(i=0; i<span; i++) {
+					cur_pfrac += delta;
+					while(cur_pfrac & ~0xffff) {
+						cur_pfrac += fdelta;
+						cur_pos += pdelta;
+
+						cur_pval = cur_val;
+						cur_val = (INT16)(samples[cur_pos] << 8);
+					}
+
+					UPDATE_CHANNELS;
+				}
+
+				for(; i<length; i++) {
 					cur_pfrac += delta;
 					while(cur_pfrac & ~0xffff) {
 						cur_pfrac += fdelta;
@@ -723,6 +762,7 @@ void k054539_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = k054539_set_info;		break;
@@ -278,6 +278,37 @@ static void okim6295_update(void *param, stream_sample_t **inputs, stream_sample
 
 
 
+/**********************************************************************************************
+
+     okim6295_advance -- move the voices along without decoding anything, for when nobody is
+     listening; the status register only needs to know when each voice stops
+
+***********************************************************************************************/
+
+static void okim6295_advance(void *param, int samples)
+{
+	struct okim6295 *chip = param;
+	int i;
+
+	for (i = 0; i < OKIM6295_VOICES; i++)
+	{
+		struct ADPCMVoice *voice = &chip->voice[i];
+
+		if (voice->playing)
+		{
+			if (voice->count - voice->sample <= samples)
+			{
+				voice->sample = voice->count;
+				voice->playing = 0;
+			}
+			else
+				voice->sample += samples;
+		}
+	}
+}
+
+
+
 /**********************************************************************************************
 
      state save support for MAME
@@ -340,6 +371,7 @@ static void *okim6295_start(int sndindex, int clock, const void *config)
 
 	/* generate the name and create the stream */
 	info->stream = stream_create(0, 1, clock/divisor, info, okim6295_update);
+	stream_set_time_callback(info->stream, okim6295_advance);
 
 	/* initialize the voices */
 	for (voice = 0; voice < OKIM6295_VOICES; voice++)
@@ -658,6 +690,8 @@ void okim6295_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
+		case SNDINFO_INT_STREAMS_OUTPUT_ONLY:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = okim6295_set_info;		break;
@@ -0,0 +1,52 @@
+/***************************************************************************
+
+    pcmvoice.h
+
+    Shared helpers for the ROM sample players (QSound, C140, K054539...).
+
+    These chips all walk a voice through sample ROM with a 16.16 fixed
+    point position and only need to look at the end/loop points when the
+    integer part of that position crosses them.  pcm_voice_span() works
+    out in advance how many output samples can be produced before that
+    happens, so the update loops can render that run without any per
+    sample bounds checks and only take the slow path for the event itself.
+
+***************************************************************************/
+
+#ifndef __PCMVOICE_H__
+#define __PCMVOICE_H__
+
+
+/*-------------------------------------------------
+    pcm_voice_span - return how many output samples
+    a voice can render before its position reaches
+    'limit'
+
+    The voice sits at integer position 'pos', and
+    output sample n (counting from 0) moves it to
+    pos + ((frac + n * step) >> 16).  The result is
+    the number of leading samples whose position
+    stays below 'limit', clamped to 'maxcount'.
+-------------------------------------------------*/
+
+INLINE int pcm_voice_span(INT32 pos, UINT32 frac, UINT32 step, INT32 limit, int maxcount)
+{
+	UINT64 room, count;
+
+	if (pos >= limit || maxcount <= 0)
+		return 0;
+
+	/* distance to the limit in 16.16 units */
+	room = (UINT64)(UINT32)(limit - pos) << 16;
+	if (frac >= room)
+		return 0;
+	if (step == 0)
+		return maxcount;
+
+	/* number of n >= 0 with frac + n * step < room */
+	count = (room - frac - 1) / step + 1;
+	return (count < (UINT64)maxcount) ? (int)count : maxcount;
+}
+
+
+#endif	/* __PCMVOICE_H__ */
@@ -35,6 +35,7 @@
 #include "sndintrf.h"
 #include "streams.h"
 #include "qsound.h"
+#include "pcmvoice.h"
 
 /*
 Debug defines
@@ -317,7 +318,7 @@ void qsound_update( void *param, stream_sample_t **inputs, stream_sample_t **buf
 {
 	struct qsound_info *chip = param;
 	int i,j;
-	int rvol, lvol, count;
+	int rvol, lvol, count, span;
 	struct QSOUND_CHANNEL *pC=&chip->channel[0];
 	stream_sample_t  *datap[2];
 
@@ -335,8 +336,44 @@ void qsound_update( void *param, stream_sample_t **inputs, stream_sample_t **buf
 			rvol=(pC->rvol*pC->vol)>>8;
 			lvol=(pC->lvol*pC->vol)>>8;
 
-			for (j=length-1; j>=0; j--)
+			j = 0;
+			while (j < length)
 			{
+				/* samples that can be played before the end address is reached; */
+				/* the ROM offset only needs wrapping when bank+end runs past it */
+				span = 0;
+				if ((UINT32)(pC->bank + pC->end) <= chip->sample_rom_length)
+					span = pcm_voice_span(pC->address, pC->offset, pC->pitch, pC->end, length - j);
+
+				if (span > 0)
+				{
+					const QSOUND_SRC_SAMPLE *rom = chip->sample_rom + pC->bank;
+					INT32 address = pC->address;
+					INT32 offset = pC->offset;
+					INT32 lastdt = pC->lastdt;
+					INT32 pitch = pC->pitch;
+
+					for (j += span; span > 0; span--)
+					{
+						count = offset >> 16;
+						offset &= 0xffff;
+						if (count)
+						{
+							address += count;
+							lastdt = rom[address];
+						}
+
+						(*pOutL++) += ((lastdt * lvol) >> 6);
+						(*pOutR++) += ((lastdt * rvol) >> 6);
+						offset += pitch;
+					}
+
+					pC->address = address;
+					pC->offset = offset;
+					pC->lastdt = lastdt;
+					continue;
+				}
+
 				count=(pC->offset)>>16;
 				pC->offset &= 0xffff;
 				if (count)
@@ -361,6 +398,7 @@ void qsound_update( void *param, stream_sample_t **inputs, stream_sample_t **buf
 				pOutL++;
 				pOutR++;
 				pC->offset += pC->pitch;
+				j++;
 			}
 		}
 		pC++;
@@ -392,6 +430,8 @@ void qsound_get_info(void *token, UINT32 state, sndinfo *info)
 	switch (state)
 	{
 		/* --- the following bits of info are returned as 64-bit signed integers --- */
+		case SNDINFO_INT_STREAMS_THREADSAFE:			info->i = 1;							break;
+		case SNDINFO_INT_STREAMS_OUTPUT_ONLY:			info->i = 1;							break;
 
 		/* --- the following bits of info are returned as pointers to data or functions --- */
 		case SNDINFO_PTR_SET_INFO:						info->set_info = qsound_set_info;		break;
@@ -756,7 +756,10 @@ static void SCSP_w16(struct _SCSP *SCSP,unsigned int addr,unsigned short val)
 		else if(addr<0x800)
 			*((unsigned short *) (SCSP->DSP.MADRS+(addr-0x780)/2))=val;
 		else if(addr<0xC00)
+		{
 			*((unsigned short *) (SCSP->DSP.MPRO+(addr-0x800)/2))=val;
+			SCSPDSP_Decode(&SCSP->DSP,(addr-0x800)/8);
+		}
 
 		if(addr==0xBF0)
 			SCSPDSP_Start(&SCSP->DSP);
@@ -1146,38 +1149,44 @@ INLINE INT32 SCSP_UpdateSlot(struct _SCSP *SCSP, struct _SLOT *slot)
 static void SCSP_DoMasterSamples(struct _SCSP *SCSP, int nsamples)
 {
 	stream_sample_t *bufr,*bufl;
+	UINT8 list[32];
+	int count=0;
 	int sl, s, i;
 
 	bufr=bufferr;
 	bufl=bufferl;
 
+	//only register writes can start a slot, so gather the active ones once
+	for(sl=0;sl<32;++sl)
+		if(SCSP->Slots[sl].active)
+			list[count++]=sl;
+
 	for(s=0;s<nsamples;++s)
 	{
 		INT32 smpl, smpr;
 
 		smpl = smpr = 0;
 
-		for(sl=0;sl<32;++sl)
+		for(i=0;i<count;++i)
 		{
-			if(SCSP->Slots[sl].active)
-			{
-				struct _SLOT *slot=SCSP->Slots+sl;
-				unsigned short Enc;
-				signed int sample;
+			struct _SLOT *slot=SCSP->Slots+list[i];
+			unsigned short Enc;
+			signed int sample;
 
-				RBUFDST=SCSP->RINGBUF+SCSP->BUFPTR;
-				sample=SCSP_UpdateSlot(SCSP, slot);
-				++SCSP->BUFPTR;
-				SCSP->BUFPTR&=63;
-				SCSPDSP_SetSample(&SCSP->DSP,sample>>SHIFT,ISEL(slot),IMXL(slot));
+			if(!slot->active)
+				continue;
 
-				Enc=((TL(slot))<<0x0)|((DIPAN(slot))<<0x8)|((DISDL(slot))<<0xd);
-				{
-					smpl+=(sample*SCSP->LPANTABLE[Enc])>>SHIFT;
-					smpr+=(sample*SCSP->RPANTABLE[Enc])>>SHIFT;
-				}
-			}
+			RBUFDST=SCSP->RINGBUF+SCSP->BUFPTR;
+			sample=SCSP_UpdateSlot(SCSP, slot);
+			++SCSP->BUFPTR;
+			SCSP->BUFPTR&=63;
+			SCSPDSP_SetSample(&SCSP->DSP,sample>>SHIFT,ISEL(slot),IMXL(slot));
 
+			Enc=((TL(slot))<<0x0)|((DIPAN(slot))<<0x8)|((DISDL(slot))<<0xd);
+			{
+				smpl+=(sample*SCSP->LPANTABLE[Enc])>>SHIFT;
+				smpr+=(sample*SCSP->RPANTABLE[Enc])>>SHIFT;
+			}
 		}
 
 		SCSPDSP_Step(&SCSP->DSP);
@@ -55,48 +55,15 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 #endif
 	for(step=0;step</*128*/DSP->LastStep;++step)
 	{
-		UINT16 *IPtr=DSP->MPRO+step*4;
-
-//      if(IPtr[0]==0 && IPtr[1]==0 && IPtr[2]==0 && IPtr[3]==0)
-//          break;
-
-		UINT32 TRA=(IPtr[0]>>8)&0x7F;
-		UINT32 TWT=(IPtr[0]>>7)&0x01;
-		UINT32 TWA=(IPtr[0]>>0)&0x7F;
-
-		UINT32 XSEL=(IPtr[1]>>15)&0x01;
-		UINT32 YSEL=(IPtr[1]>>13)&0x03;
-		UINT32 IRA=(IPtr[1]>>6)&0x3F;
-		UINT32 IWT=(IPtr[1]>>5)&0x01;
-		UINT32 IWA=(IPtr[1]>>0)&0x1F;
-
-		UINT32 TABLE=(IPtr[2]>>15)&0x01;
-		UINT32 MWT=(IPtr[2]>>14)&0x01;
-		UINT32 MRD=(IPtr[2]>>13)&0x01;
-		UINT32 EWT=(IPtr[2]>>12)&0x01;
-		UINT32 EWA=(IPtr[2]>>8)&0x0F;
-		UINT32 ADRL=(IPtr[2]>>7)&0x01;
-		UINT32 FRCL=(IPtr[2]>>6)&0x01;
-		UINT32 SHIFT=(IPtr[2]>>4)&0x03;
-		UINT32 YRL=(IPtr[2]>>3)&0x01;
-		UINT32 NEGB=(IPtr[2]>>2)&0x01;
-		UINT32 ZERO=(IPtr[2]>>1)&0x01;
-		UINT32 BSEL=(IPtr[2]>>0)&0x01;
-
-		UINT32 NOFL=(IPtr[3]>>15)&1;		//????
-		UINT32 COEF=(IPtr[3]>>9)&0x3f;
-
-		UINT32 MASA=(IPtr[3]>>2)&0x1f;	//???
-		UINT32 ADREB=(IPtr[3]>>1)&0x1;
-		UINT32 NXADR=(IPtr[3]>>0)&0x1;
+		const struct _SCSPDSPINST *I=DSP->INST+step;
 
 		INT64 v;
 
 		//operations are done at 24 bit precision
 #if 0
-		if(MASA)
+		if(I->MASA)
 			int a=1;
-		if(NOFL)
+		if(I->NOFL)
 			int a=1;
 
 //      int dump=0;
@@ -121,12 +88,12 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 		}
 #endif
 		//INPUTS RW
-		assert(IRA<0x32);
-		if(IRA<=0x1f)
-			INPUTS=DSP->MEMS[IRA];
-		else if(IRA<=0x2F)
-			INPUTS=DSP->MIXS[IRA-0x20]<<8;	//MIXS is 16 bit
-		else if(IRA<=0x31)
+		assert(I->IRA<0x32);
+		if(I->IRA<=0x1f)
+			INPUTS=DSP->MEMS[I->IRA];
+		else if(I->IRA<=0x2F)
+			INPUTS=DSP->MIXS[I->IRA-0x20]<<8;	//MIXS is 16 bit
+		else if(I->IRA<=0x31)
 			INPUTS=0;
 
 		INPUTS<<=8;
@@ -134,39 +101,39 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 		//if(INPUTS&0x00800000)
 		//  INPUTS|=0xFF000000;
 
-		if(IWT)
+		if(I->IWT)
 		{
-			DSP->MEMS[IWA]=MEMVAL;	//MEMVAL was selected in previous MRD
-			if(IRA==IWA)
+			DSP->MEMS[I->IWA]=MEMVAL;	//MEMVAL was selected in previous MRD
+			if(I->IRA==I->IWA)
 				INPUTS=MEMVAL;
 		}
 
 		//Operand sel
 		//B
-		if(!ZERO)
+		if(!I->ZERO)
 		{
-			if(BSEL)
+			if(I->BSEL)
 				B=ACC;
 			else
 			{
-				B=DSP->TEMP[(TRA+DSP->DEC)&0x7F];
+				B=DSP->TEMP[(I->TRA+DSP->DEC)&0x7F];
 				B<<=8;
 				B>>=8;
 				//if(B&0x00800000)
 				//  B|=0xFF000000;  //Sign extend
 			}
-			if(NEGB)
+			if(I->NEGB)
 				B=0-B;
 		}
 		else
 			B=0;
 
 		//X
-		if(XSEL)
+		if(I->XSEL)
 			X=INPUTS;
 		else
 		{
-			X=DSP->TEMP[(TRA+DSP->DEC)&0x7F];
+			X=DSP->TEMP[(I->TRA+DSP->DEC)&0x7F];
 			X<<=8;
 			X>>=8;
 			//if(X&0x00800000)
@@ -174,20 +141,20 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 		}
 
 		//Y
-		if(YSEL==0)
+		if(I->YSEL==0)
 			Y=FRC_REG;
-		else if(YSEL==1)
-			Y=DSP->COEF[COEF]>>3;	//COEF is 16 bits
-		else if(YSEL==2)
+		else if(I->YSEL==1)
+			Y=DSP->COEF[I->COEF]>>3;	//COEF is 16 bits
+		else if(I->YSEL==2)
 			Y=(Y_REG>>11)&0x1FFF;
-		else if(YSEL==3)
+		else if(I->YSEL==3)
 			Y=(Y_REG>>4)&0x0FFF;
 
-		if(YRL)
+		if(I->YRL)
 			Y_REG=INPUTS;
 
 		//Shifter
-		if(SHIFT==0)
+		if(I->SHIFT==0)
 		{
 			SHIFTED=ACC;
 			if(SHIFTED>0x007FFFFF)
@@ -195,7 +162,7 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 			if(SHIFTED<(-0x00800000))
 				SHIFTED=-0x00800000;
 		}
-		else if(SHIFT==1)
+		else if(I->SHIFT==1)
 		{
 			SHIFTED=ACC*2;
 			if(SHIFTED>0x007FFFFF)
@@ -203,7 +170,7 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 			if(SHIFTED<(-0x00800000))
 				SHIFTED=-0x00800000;
 		}
-		else if(SHIFT==2)
+		else if(I->SHIFT==2)
 		{
 			SHIFTED=ACC*2;
 			SHIFTED<<=8;
@@ -212,7 +179,7 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 			//if(SHIFTED&0x00800000)
 			//  SHIFTED|=0xFF000000;
 		}
-		else if(SHIFT==3)
+		else if(I->SHIFT==3)
 		{
 			SHIFTED=ACC;
 			SHIFTED<<=8;
@@ -231,28 +198,28 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 		v=(((INT64) X*(INT64) Y)>>12);
 		ACC=(int) v+B;
 
-		if(TWT)
-			DSP->TEMP[(TWA+DSP->DEC)&0x7F]=SHIFTED;
+		if(I->TWT)
+			DSP->TEMP[(I->TWA+DSP->DEC)&0x7F]=SHIFTED;
 
-		if(FRCL)
+		if(I->FRCL)
 		{
-			if(SHIFT==3)
+			if(I->SHIFT==3)
 				FRC_REG=SHIFTED&0x0FFF;
 			else
 				FRC_REG=(SHIFTED>>11)&0x1FFF;
 		}
 
-		if(MRD || MWT)
+		if(I->MRD || I->MWT)
 		//if(0)
 		{
-			ADDR=DSP->MADRS[MASA];
-			if(!TABLE)
+			ADDR=DSP->MADRS[I->MASA];
+			if(!I->TABLE)
 				ADDR+=DSP->DEC;
-			if(ADREB)
+			if(I->ADREB)
 				ADDR+=ADRS_REG&0x0FFF;
-			if(NXADR)
+			if(I->NXADR)
 				ADDR++;
-			if(!TABLE)
+			if(!I->TABLE)
 				ADDR&=DSP->RBL-1;
 			else
 				ADDR&=0xFFFF;
@@ -260,32 +227,32 @@ void SCSPDSP_Step(struct _SCSPDSP *DSP)
 			//ADDR+=DSP->RBP<<13;
 			//MEMVAL=DSP->SCSPRAM[ADDR>>1];
 			ADDR+=DSP->RBP<<12;
-			if(MRD && (step&1))	//memory only allowed on odd? DoA inserts NOPs on even
+			if(I->MRD)
 			{
-				if(NOFL)
+				if(I->NOFL)
 					MEMVAL=DSP->SCSPRAM[ADDR]<<8;
 				else
 					MEMVAL=UNPACK(DSP->SCSPRAM[ADDR%DSP->SCSPRAM_LENGTH]);
 			}
-			if(MWT && (step&1))
+			if(I->MWT)
 			{
-				if(NOFL)
+				if(I->NOFL)
 					DSP->SCSPRAM[ADDR]=SHIFTED>>8;
 				else
 					DSP->SCSPRAM[ADDR%DSP->SCSPRAM_LENGTH]=PACK(SHIFTED);
 			}
 		}
 
-		if(ADRL)
+		if(I->ADRL)
 		{
-			if(SHIFT==3)
+			if(I->SHIFT==3)
 				ADRS_REG=(SHIFTED>>12)&0xFFF;
 			else
 				ADRS_REG=(INPUTS>>16);
 		}
 
-		if(EWT)
-			DSP->EFREG[EWA]+=SHIFTED>>8;
+		if(I->EWT)
+			DSP->EFREG[I->EWA]+=SHIFTED>>8;
 
 	}
 	--DSP->DEC;
@@ -302,10 +269,52 @@ void SCSPDSP_SetSample(struct _SCSPDSP *DSP,INT32 sample,int SEL,int MXL)
 //      int a=1;
 }
 
+void SCSPDSP_Decode(struct _SCSPDSP *DSP, int step)
+{
+	UINT16 *IPtr=DSP->MPRO+step*4;
+	struct _SCSPDSPINST *I=DSP->INST+step;
+
+	I->TRA=(IPtr[0]>>8)&0x7F;
+	I->TWT=(IPtr[0]>>7)&0x01;
+	I->TWA=(IPtr[0]>>0)&0x7F;
+
+	I->XSEL=(IPtr[1]>>15)&0x01;
+	I->YSEL=(IPtr[1]>>13)&0x03;
+	I->IRA=(IPtr[1]>>6)&0x3F;
+	I->IWT=(IPtr[1]>>5)&0x01;
+	I->IWA=(IPtr[1]>>0)&0x1F;
+
+	I->TABLE=(IPtr[2]>>15)&0x01;
+	I->MWT=(IPtr[2]>>14)&0x01;
+	I->MRD=(IPtr[2]>>13)&0x01;
+	I->EWT=(IPtr[2]>>12)&0x01;
+	I->EWA=(IPtr[2]>>8)&0x0F;
+	I->ADRL=(IPtr[2]>>7)&0x01;
+	I->FRCL=(IPtr[2]>>6)&0x01;
+	I->SHIFT=(IPtr[2]>>4)&0x03;
+	I->YRL=(IPtr[2]>>3)&0x01;
+	I->NEGB=(IPtr[2]>>2)&0x01;
+	I->ZERO=(IPtr[2]>>1)&0x01;
+	I->BSEL=(IPtr[2]>>0)&0x01;
+
+	I->NOFL=(IPtr[3]>>15)&1;		//????
+	I->COEF=(IPtr[3]>>9)&0x3f;
+
+	I->MASA=(IPtr[3]>>2)&0x1f;	//???
+	I->ADREB=(IPtr[3]>>1)&0x1;
+	I->NXADR=(IPtr[3]>>0)&0x1;
+
+	//memory only allowed on odd? DoA inserts NOPs on even
+	if(!(step&1))
+		I->MRD=I->MWT=0;
+}
+
 void SCSPDSP_Start(struct _SCSPDSP *DSP)
 {
 	int i;
 	DSP->Stopped=0;
+	for(i=0;i<128;++i)
+		SCSPDSP_Decode(DSP,i);
 	for(i=127;i>=0;--i)
 	{
 		UINT16 *IPtr=DSP->MPRO+i*4;
@@ -1,6 +1,15 @@
 #ifndef SCSPDSP_H
 #define SCSPDSP_H
 
+//a DSP step, decoded from its 64 bit MPRO word
+struct _SCSPDSPINST
+{
+	UINT8 TRA, TWT, TWA;
+	UINT8 XSEL, YSEL, IRA, IWT, IWA;
+	UINT8 TABLE, MWT, MRD, EWT, EWA, ADRL, FRCL, SHIFT, YRL, NEGB, ZERO, BSEL;
+	UINT8 NOFL, COEF, MASA, ADREB, NXADR;
+};
+
 //the DSP Context
 struct _SCSPDSP
 {
@@ -15,6 +24,7 @@ struct _SCSPDSP
 	INT16 COEF[64];		//16 bit signed
 	UINT16 MADRS[32];	//offsets (in words), 16 bit
 	UINT16 MPRO[128*4];	//128 steps 64 bit
+	struct _SCSPDSPINST INST[128];	//MPRO decoded, kept in step by SCSPDSP_Decode
 	INT32 TEMP[128];	//TEMP regs,24 bit signed
 	INT32 MEMS[32];	//MEMS regs,24 bit signed
 	UINT32 DEC;
@@ -34,4 +44,5 @@ void SCSPDSP_Init(struct _SCSPDSP *DSP);
 void SCSPDSP_SetSample(struct _SCSPDSP *DSP, INT32 sample, INT32 SEL, INT32 MXL);
 void SCSPDSP_Step(struct _SCSPDSP *DSP);
 void SCSPDSP_Start(struct _SCSPDSP *DSP);
+void SCSPDSP_Decode(struct _SCSPDSP *DSP, int step);
 #endif
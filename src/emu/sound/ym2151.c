@@ -38,10 +38,7 @@ typedef struct{
 	UINT32		dt1_i;					/* DT1 index * 32 */
 	UINT32		dt2;					/* current DT2 (detune 2) value */
 
-	signed int *connect;				/* operator output 'direction' */
-
 	/* only M1 (operator 0) is filled with this data: */
-	signed int *mem_connect;			/* where to put the delayed sample (MEM) */
 	INT32		mem_value;				/* delayed sample (MEM) value */
 
 	/* channel specific data; note: each operator number 0 contains channel specific data */
@@ -481,13 +478,6 @@ static UINT8 lfo_noise_waveform[256] = {
 
 
 
-/* these variables stay here for speedup purposes only */
-static YM2151 * PSG;
-static signed int chanout[8];
-static signed int m2,c1,c2; /* Phase Modulation input for operators 2,3,4 */
-static signed int mem;		/* one sample delay memory */
-
-
 /* save output as raw 16-bit sample */
 /* #define SAVE_SAMPLE */
 /* #define SAVE_SEPARATE_CHANNELS */
@@ -757,7 +747,7 @@ static void init_chip_tables(YM2151 *chip)
 		}														\
 }
 
-INLINE void envelope_KONKOFF(YM2151Operator * op, int v)
+INLINE void envelope_KONKOFF(YM2151 *PSG, YM2151Operator * op, int v)
 {
 	if (v&0x08)	/* M1 */
 		KEY_ON (op+0, 1)
@@ -861,98 +851,6 @@ static TIMER_CALLBACK_PTR( timer_callback_chip_busy )
 
 
 
-INLINE void set_connect( YM2151Operator *om1, int cha, int v)
-{
-	YM2151Operator *om2 = om1+1;
-	YM2151Operator *oc1 = om1+2;
-
-	/* set connect algorithm */
-
-	/* MEM is simply one sample delay */
-
-	switch( v&7 )
-	{
-	case 0:
-		/* M1---C1---MEM---M2---C2---OUT */
-		om1->connect = &c1;
-		oc1->connect = &mem;
-		om2->connect = &c2;
-		om1->mem_connect = &m2;
-		break;
-
-	case 1:
-		/* M1------+-MEM---M2---C2---OUT */
-		/*      C1-+                     */
-		om1->connect = &mem;
-		oc1->connect = &mem;
-		om2->connect = &c2;
-		om1->mem_connect = &m2;
-		break;
-
-	case 2:
-		/* M1-----------------+-C2---OUT */
-		/*      C1---MEM---M2-+          */
-		om1->connect = &c2;
-		oc1->connect = &mem;
-		om2->connect = &c2;
-		om1->mem_connect = &m2;
-		break;
-
-	case 3:
-		/* M1---C1---MEM------+-C2---OUT */
-		/*                 M2-+          */
-		om1->connect = &c1;
-		oc1->connect = &mem;
-		om2->connect = &c2;
-		om1->mem_connect = &c2;
-		break;
-
-	case 4:
-		/* M1---C1-+-OUT */
-		/* M2---C2-+     */
-		/* MEM: not used */
-		om1->connect = &c1;
-		oc1->connect = &chanout[cha];
-		om2->connect = &c2;
-		om1->mem_connect = &mem;	/* store it anywhere where it will not be used */
-		break;
-
-	case 5:
-		/*    +----C1----+     */
-		/* M1-+-MEM---M2-+-OUT */
-		/*    +----C2----+     */
-		om1->connect = 0;	/* special mark */
-		oc1->connect = &chanout[cha];
-		om2->connect = &chanout[cha];
-		om1->mem_connect = &m2;
-		break;
-
-	case 6:
-		/* M1---C1-+     */
-		/*      M2-+-OUT */
-		/*      C2-+     */
-		/* MEM: not used */
-		om1->connect = &c1;
-		oc1->connect = &chanout[cha];
-		om2->connect = &chanout[cha];
-		om1->mem_connect = &mem;	/* store it anywhere where it will not be used */
-		break;
-
-	case 7:
-		/* M1-+     */
-		/* C1-+-OUT */
-		/* M2-+     */
-		/* C2-+     */
-		/* MEM: not used*/
-		om1->connect = &chanout[cha];
-		oc1->connect = &chanout[cha];
-		om2->connect = &chanout[cha];
-		om1->mem_connect = &mem;	/* store it anywhere where it will not be used */
-		break;
-	}
-}
-
-
 INLINE void refresh_EG(YM2151Operator * op)
 {
 	UINT32 kc;
@@ -1078,8 +976,7 @@ void YM2151WriteReg(void *_chip, int r, int v)
 			break;
 
 		case 0x08:
-			PSG = chip; /* PSG is used in KEY_ON macro */
-			envelope_KONKOFF(&chip->oper[ (v&7)*4 ], v );
+			envelope_KONKOFF(chip, &chip->oper[ (v&7)*4 ], v );
 			break;
 
 		case 0x0f:	/* noise mode enable, noise period */
@@ -1212,7 +1109,6 @@ void YM2151WriteReg(void *_chip, int r, int v)
 			chip->pan[ (r&7)*2    ] = (v & 0x40) ? ~0 : 0;
 			chip->pan[ (r&7)*2 +1 ] = (v & 0x80) ? ~0 : 0;
 			chip->connect[r&7] = v&7;
-			set_connect(op, r&7, v&7);
 			break;
 
 		case 0x08:	/* Key Code */
@@ -1387,11 +1283,7 @@ int YM2151ReadStatus( void *_chip )
 */
 void YM2151Postload(void *chip)
 {
-	YM2151 *YM2151_chip = (YM2151 *)chip;
-	int j;
-
-	for (j=0; j<8; j++)
-		set_connect(&YM2151_chip->oper[j*4], j, YM2151_chip->connect[j]);
+	/* nothing to rebuild: chan_calc() reads the algorithm from chip->connect */
 }
 
 static void ym2151_state_save_register( YM2151 *chip, int sndindex )
@@ -1492,8 +1384,6 @@ static void ym2151_state_save_register( YM2151 *chip, int sndindex )
 #endif
 
 	state_save_register_item_array(buf1, sndindex, chip->connect);
-
-	state_save_register_func_postload_ptr(YM2151Postload, chip);
 }
 #else
 void YM2151Postload(void *chip)
@@ -1694,114 +1584,148 @@ INLINE signed int op_calc1(YM2151Operator * OP, unsigned int env, signed int pm)
 
 #define volume_calc(OP) ((OP)->tl + ((UINT32)(OP)->volume) + (AM & (OP)->AMmask))
 
-INLINE void chan_calc(unsigned int chan)
+/* output of M2, C1 or C2 with phase modulation input pm */
+INLINE signed int op_out(YM2151Operator * OP, UINT32 AM, signed int pm)
 {
-	YM2151Operator *op;
-	unsigned int env;
-	UINT32 AM = 0;
-
-	m2 = c1 = c2 = mem = 0;
-	op = &PSG->oper[chan*4];	/* M1 */
+	unsigned int env = volume_calc(OP);
 
-	*op->mem_connect = op->mem_value;	/* restore delayed sample (MEM) value to m2 or c2 */
+	if (env < ENV_QUIET)
+		return op_calc(OP, env, pm);
+	return 0;
+}
 
-	if (op->ams)
-		AM = PSG->lfa << (op->ams-1);
-	env = volume_calc(op);
+/* output of C2; on channel 7 it can be replaced by the noise generator */
+INLINE signed int c2_out(YM2151 *PSG, unsigned int chan, YM2151Operator * OP, UINT32 AM, signed int pm)
+{
+	if (chan == 7 && (PSG->noise & 0x80))
 	{
-		INT32 out = op->fb_out_prev + op->fb_out_curr;
-		op->fb_out_prev = op->fb_out_curr;
-
-		if (!op->connect)
-			/* algorithm 5 */
-			mem = c1 = c2 = op->fb_out_prev;
-		else
-			/* other algorithms */
-			*op->connect = op->fb_out_prev;
+		unsigned int env = volume_calc(OP);
+		UINT32 noiseout;
 
-		op->fb_out_curr = 0;
-		if (env < ENV_QUIET)
-		{
-			if (!op->fb_shift)
-				out=0;
-			op->fb_out_curr = op_calc1(op, env, (out<<op->fb_shift) );
-		}
+		noiseout = 0;
+		if (env < 0x3ff)
+			noiseout = (env ^ 0x3ff) * 2;	/* range of the YM2151 noise output is -2044 to 2040 */
+		return (PSG->noise_rng&0x10000) ? noiseout: -noiseout; /* bit 16 -> output */
 	}
-
-	env = volume_calc(op+1);	/* M2 */
-	if (env < ENV_QUIET)
-		*(op+1)->connect += op_calc(op+1, env, m2);
-
-	env = volume_calc(op+2);	/* C1 */
-	if (env < ENV_QUIET)
-		*(op+2)->connect += op_calc(op+2, env, c1);
-
-	env = volume_calc(op+3);	/* C2 */
-	if (env < ENV_QUIET)
-		chanout[chan]    += op_calc(op+3, env, c2);
-
-	/* M1 */
-	op->mem_value = mem;
+	return op_out(OP, AM, pm);
 }
-INLINE void chan7_calc(void)
+
+/* calculate one channel and return its output; forced inline so that the
+   channel 7 noise test folds away for the other channels */
+INLINE ATTR_FORCE_INLINE signed int chan_calc(YM2151 *PSG, unsigned int chan)
 {
-	YM2151Operator *op;
+	YM2151Operator *op = &PSG->oper[chan*4];	/* M1 */
 	unsigned int env;
 	UINT32 AM = 0;
+	signed int m1, c2, out;
 
-	m2 = c1 = c2 = mem = 0;
-	op = &PSG->oper[7*4];		/* M1 */
-
-	*op->mem_connect = op->mem_value;	/* restore delayed sample (MEM) value to m2 or c2 */
+	/* all four operators have finished their release and the feedback is
+       drained: the output is silent (an EG_OFF operator is at MAX_ATT_INDEX,
+       which also mutes the noise generator) */
+	if ((op->state | (op+1)->state | (op+2)->state | (op+3)->state) == EG_OFF &&
+		(op->fb_out_prev | op->fb_out_curr) == 0)
+	{
+		/* MEM is fed by silent operators in algorithms 0-3 and 5 */
+		if (PSG->connect[chan] < 4 || PSG->connect[chan] == 5)
+			op->mem_value = 0;
+		return 0;
+	}
 
 	if (op->ams)
 		AM = PSG->lfa << (op->ams-1);
 	env = volume_calc(op);
 	{
-		INT32 out = op->fb_out_prev + op->fb_out_curr;
+		INT32 fb = op->fb_out_prev + op->fb_out_curr;
 		op->fb_out_prev = op->fb_out_curr;
 
-		if (!op->connect)
-			/* algorithm 5 */
-			mem = c1 = c2 = op->fb_out_prev;
-		else
-			/* other algorithms */
-			*op->connect = op->fb_out_prev;
-
 		op->fb_out_curr = 0;
 		if (env < ENV_QUIET)
 		{
 			if (!op->fb_shift)
-				out=0;
-			op->fb_out_curr = op_calc1(op, env, (out<<op->fb_shift) );
+				fb=0;
+			op->fb_out_curr = op_calc1(op, env, (fb<<op->fb_shift) );
 		}
 	}
+	m1 = op->fb_out_prev;
 
-	env = volume_calc(op+1);	/* M2 */
-	if (env < ENV_QUIET)
-		*(op+1)->connect += op_calc(op+1, env, m2);
+	/* operators are evaluated in the order M1, M2, C1, C2;
+       MEM delays its input by one sample */
+	switch (PSG->connect[chan])
+	{
+	case 0:
+		/* M1---C1---MEM---M2---C2---OUT */
+		c2  = op_out(op+1, AM, op->mem_value);
+		op->mem_value = op_out(op+2, AM, m1);
+		out = c2_out(PSG, chan, op+3, AM, c2);
+		break;
 
-	env = volume_calc(op+2);	/* C1 */
-	if (env < ENV_QUIET)
-		*(op+2)->connect += op_calc(op+2, env, c1);
+	case 1:
+		/* M1------+-MEM---M2---C2---OUT */
+		/*      C1-+                     */
+		c2  = op_out(op+1, AM, op->mem_value);
+		op->mem_value = m1 + op_out(op+2, AM, 0);
+		out = c2_out(PSG, chan, op+3, AM, c2);
+		break;
 
-	env = volume_calc(op+3);	/* C2 */
-	if (PSG->noise & 0x80)
-	{
-		UINT32 noiseout;
+	case 2:
+		/* M1-----------------+-C2---OUT */
+		/*      C1---MEM---M2-+          */
+		c2  = m1 + op_out(op+1, AM, op->mem_value);
+		op->mem_value = op_out(op+2, AM, 0);
+		out = c2_out(PSG, chan, op+3, AM, c2);
+		break;
 
-		noiseout = 0;
-		if (env < 0x3ff)
-			noiseout = (env ^ 0x3ff) * 2;	/* range of the YM2151 noise output is -2044 to 2040 */
-		chanout[7] += ((PSG->noise_rng&0x10000) ? noiseout: -noiseout); /* bit 16 -> output */
-	}
-	else
-	{
-		if (env < ENV_QUIET)
-			chanout[7] += op_calc(op+3, env, c2);
+	case 3:
+		/* M1---C1---MEM------+-C2---OUT */
+		/*                 M2-+          */
+		c2  = op->mem_value + op_out(op+1, AM, 0);
+		op->mem_value = op_out(op+2, AM, m1);
+		out = c2_out(PSG, chan, op+3, AM, c2);
+		break;
+
+	case 4:
+		/* M1---C1-+-OUT */
+		/* M2---C2-+     */
+		/* MEM: not used */
+		c2  = op_out(op+1, AM, 0);
+		out = op_out(op+2, AM, m1);
+		out += c2_out(PSG, chan, op+3, AM, c2);
+		break;
+
+	case 5:
+		/*    +----C1----+     */
+		/* M1-+-MEM---M2-+-OUT */
+		/*    +----C2----+     */
+		out = op_out(op+1, AM, op->mem_value);
+		out += op_out(op+2, AM, m1);
+		out += c2_out(PSG, chan, op+3, AM, m1);
+		op->mem_value = m1;
+		break;
+
+	case 6:
+		/* M1---C1-+     */
+		/*      M2-+-OUT */
+		/*      C2-+     */
+		/* MEM: not used */
+		out = op_out(op+1, AM, 0);
+		out += op_out(op+2, AM, m1);
+		out += c2_out(PSG, chan, op+3, AM, 0);
+		break;
+
+	default:
+		/* M1-+     */
+		/* C1-+-OUT */
+		/* M2-+     */
+		/* C2-+     */
+		/* MEM: not used*/
+		out = m1;
+		out += op_out(op+1, AM, 0);
+		out += op_out(op+2, AM, 0);
+		out += c2_out(PSG, chan, op+3, AM, 0);
+		break;
 	}
-	/* M1 */
-	op->mem_value = mem;
+
+	return out;
 }
 
 
@@ -2013,7 +1937,7 @@ rate 11 1         |
                                  --
 */
 
-INLINE void advance_eg(void)
+INLINE void advance_eg(YM2151 *PSG)
 {
 	YM2151Operator *op;
 	unsigned int i;
@@ -2097,7 +2021,7 @@ INLINE void advance_eg(void)
 }
 
 
-INLINE void advance(void)
+INLINE void advance(YM2151 *PSG)
 {
 	YM2151Operator *op;
 	unsigned int i;
@@ -2380,15 +2304,15 @@ INLINE signed int acc_calc(signed int value)
 */
 void YM2151UpdateOne(void *chip, SAMP **buffers, int length)
 {
+	YM2151 *PSG = chip;
 	int i;
+	signed int chanout[8];
 	signed int outl,outr;
 	SAMP *bufL, *bufR;
 
 	bufL = buffers[0];
 	bufR = buffers[1];
 
-	PSG = chip;
-
 #ifdef USE_MAME_TIMERS
 		/* ASG 980324 - handled by real timers now */
 #else
@@ -2410,32 +2334,23 @@ void YM2151UpdateOne(void *chip, SAMP **buffers, int length)
 
 	for (i=0; i<length; i++)
 	{
-		advance_eg();
-
-		chanout[0] = 0;
-		chanout[1] = 0;
-		chanout[2] = 0;
-		chanout[3] = 0;
-		chanout[4] = 0;
-		chanout[5] = 0;
-		chanout[6] = 0;
-		chanout[7] = 0;
-
-		chan_calc(0);
+		advance_eg(PSG);
+
+		chanout[0] = chan_calc(PSG, 0);
 		SAVE_SINGLE_CHANNEL(0)
-		chan_calc(1);
+		chanout[1] = chan_calc(PSG, 1);
 		SAVE_SINGLE_CHANNEL(1)
-		chan_calc(2);
+		chanout[2] = chan_calc(PSG, 2);
 		SAVE_SINGLE_CHANNEL(2)
-		chan_calc(3);
+		chanout[3] = chan_calc(PSG, 3);
 		SAVE_SINGLE_CHANNEL(3)
-		chan_calc(4);
+		chanout[4] = chan_calc(PSG, 4);
 		SAVE_SINGLE_CHANNEL(4)
-		chan_calc(5);
+		chanout[5] = chan_calc(PSG, 5);
 		SAVE_SINGLE_CHANNEL(5)
-		chan_calc(6);
+		chanout[6] = chan_calc(PSG, 6);
 		SAVE_SINGLE_CHANNEL(6)
-		chan7_calc();
+		chanout[7] = chan_calc(PSG, 7);
 		SAVE_SINGLE_CHANNEL(7)
 
 		outl = chanout[0] & PSG->pan[0];
@@ -2487,7 +2402,7 @@ void YM2151UpdateOne(void *chip, SAMP **buffers, int length)
 			}
 		}
 #endif
-		advance();
+		advance(PSG);
 	}
 }
 
@@ -45,6 +45,7 @@
 
 #include "driver.h"
 #include "streams.h"
+#include "profiler.h"
 #include <math.h>
 
 
@@ -141,6 +142,20 @@ struct _sound_stream
 	stream_output *		output;					/* list of streams which directly depend upon us */
 	stream_sample_t **	output_array;			/* array of outputs for passing to the callback */
 
+	/* profiling */
+	int					profiler_scope;			/* profiler scope charged for the callback */
+	osd_ticks_t			callback_ticks;			/* real time spent in the callback */
+
+	/* parallel update information */
+	UINT8				threadsafe;				/* callback only touches its own chip's state */
+	UINT8				threaded;				/* currently being updated on a worker thread */
+	int					depth;					/* longest chain of inputs below this stream */
+
+	/* lazy evaluation information */
+	UINT8				output_only;			/* skipping the callback loses nothing but audio */
+	UINT8				skip;					/* callback is skipped since nobody listens */
+	stream_time_callback time_callback;			/* optional callback to keep time while skipped */
+
 	/* output buffer information */
 	UINT32				output_bufalloc;		/* allocated size of each output buffer */
 	INT32				output_sampindex;		/* current position within each output buffer */
@@ -161,6 +176,7 @@ struct _streams_private
 	int					stream_index;			/* index of the current stream */
 	subseconds_t		update_subseconds;		/* subseconds between global updates */
 	mame_time			last_update;			/* last update time */
+	osd_work_queue *	work_queue;				/* queue for the parallel end-of-update pass */
 };
 
 
@@ -169,7 +185,10 @@ struct _streams_private
     FUNCTION PROTOTYPES
 ***************************************************************************/
 
+static void streams_exit(running_machine *machine);
 static void stream_postload(void *param);
+static int compute_stream_depth(sound_stream *stream);
+static void *stream_update_callback(void *param);
 static void allocate_resample_buffers(streams_private *strdata, sound_stream *stream);
 static void allocate_output_buffers(streams_private *strdata, sound_stream *stream);
 static void recompute_sample_rate_data(streams_private *strdata, sound_stream *stream);
@@ -233,12 +252,162 @@ void streams_init(running_machine *machine, subseconds_t update_subseconds)
 	/* set the global pointer */
 	machine->streams_data = strdata;
 
+	/* the final update of each frame can spread independent streams over the CPUs */
+	strdata->work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	add_exit_callback(machine, streams_exit);
+
 	/* register global states */
 	state_save_register_global(strdata->last_update.seconds);
 	state_save_register_global(strdata->last_update.subseconds);
 }
 
 
+/*-------------------------------------------------
+    streams_get_callback_ticks - return the real
+    time spent in stream callbacks so far
+-------------------------------------------------*/
+
+osd_ticks_t streams_get_callback_ticks(running_machine *machine)
+{
+	streams_private *strdata = machine->streams_data;
+	osd_ticks_t total = 0;
+	sound_stream *stream;
+
+	for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+		total += stream->callback_ticks;
+	return total;
+}
+
+
+/*-------------------------------------------------
+    streams_set_lazy - turn skipping of streams
+    that nobody listens to on or off; call once
+    all the routing is in place
+-------------------------------------------------*/
+
+void streams_set_lazy(running_machine *machine, int lazy)
+{
+	streams_private *strdata = machine->streams_data;
+	sound_stream *stream;
+	int changed;
+
+	/* start from every stream that says it can be skipped */
+	for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+		stream->skip = (lazy && stream->output_only);
+
+	/* anything feeding a stream that still renders has to render as well */
+	do
+	{
+		changed = FALSE;
+		for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+			if (!stream->skip)
+			{
+				int inputnum;
+
+				for (inputnum = 0; inputnum < stream->inputs; inputnum++)
+					if (stream->input[inputnum].source != NULL && stream->input[inputnum].source->owner->skip)
+					{
+						stream->input[inputnum].source->owner->skip = FALSE;
+						changed = TRUE;
+					}
+			}
+	} while (changed);
+}
+
+
+/*-------------------------------------------------
+    streams_exit - clean up the streams engine
+-------------------------------------------------*/
+
+static void streams_exit(running_machine *machine)
+{
+	streams_private *strdata = machine->streams_data;
+
+	if (strdata->work_queue != NULL)
+		osd_work_queue_free(strdata->work_queue);
+	strdata->work_queue = NULL;
+}
+
+
+/*-------------------------------------------------
+    streams_update_parallel - bring every stream
+    up to the current time, running streams that
+    don't depend on each other concurrently
+-------------------------------------------------*/
+
+void streams_update_parallel(running_machine *machine)
+{
+	streams_private *strdata = machine->streams_data;
+	sound_stream *stream;
+	int depth, maxdepth = 0;
+
+	/* a stream's inputs always sit at a lower depth than the stream itself */
+	for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+		stream->depth = -1;
+	for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+		maxdepth = MAX(maxdepth, compute_stream_depth(stream));
+
+	/* so each depth can be generated in one go once the one below is done */
+	for (depth = 0; depth <= maxdepth; depth++)
+	{
+		int queued = 0;
+
+		/* hand the thread-safe streams at this depth to the work queue */
+		for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+			if (stream->depth == depth && stream->threadsafe && !stream->skip)
+			{
+				stream->threaded = TRUE;
+				osd_work_item_queue(strdata->work_queue, stream_update_callback, stream, WORK_ITEM_FLAG_AUTO_RELEASE);
+				queued++;
+			}
+
+		/* the rest run here, one at a time, meanwhile */
+		for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+			if (stream->depth == depth && (!stream->threadsafe || stream->skip))
+				stream_update(stream);
+
+		if (queued > 0)
+		{
+			osd_work_queue_wait(strdata->work_queue, 100 * osd_ticks_per_second());
+			for (stream = strdata->stream_head; stream != NULL; stream = stream->next)
+				stream->threaded = FALSE;
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    compute_stream_depth - return the length of
+    the longest input chain feeding a stream
+-------------------------------------------------*/
+
+static int compute_stream_depth(sound_stream *stream)
+{
+	int inputnum;
+
+	if (stream->depth < 0)
+	{
+		stream->depth = 0;
+		for (inputnum = 0; inputnum < stream->inputs; inputnum++)
+			if (stream->input[inputnum].source != NULL)
+				stream->depth = MAX(stream->depth, compute_stream_depth(stream->input[inputnum].source->owner) + 1);
+	}
+	return stream->depth;
+}
+
+
+/*-------------------------------------------------
+    stream_update_callback - work queue callback
+    for streams_update_parallel
+-------------------------------------------------*/
+
+static void *stream_update_callback(void *param)
+{
+	stream_update(param);
+	return NULL;
+}
+
+
 /*-------------------------------------------------
     streams_update - update all the streams
     periodically
@@ -367,6 +536,7 @@ sound_stream *stream_create(int inputs, int outputs, int sample_rate, void *para
 	stream->outputs = outputs;
 	stream->callback = callback;
 	stream->param = param;
+	stream->profiler_scope = PROFILER_MIXER;
 
 	/* create a unique tag for saving */
 	sprintf(statetag, "stream.%d", stream->index);
@@ -555,6 +725,53 @@ void stream_set_sample_rate(sound_stream *stream, int sample_rate)
 }
 
 
+/*-------------------------------------------------
+    stream_set_profiler_scope - set the profiler
+    scope charged for a stream's callback
+-------------------------------------------------*/
+
+void stream_set_profiler_scope(sound_stream *stream, int scope)
+{
+	stream->profiler_scope = scope;
+}
+
+
+/*-------------------------------------------------
+    stream_set_threadsafe - mark whether a
+    stream's callback may run on another thread
+    alongside other streams
+-------------------------------------------------*/
+
+void stream_set_threadsafe(sound_stream *stream, int threadsafe)
+{
+	stream->threadsafe = (threadsafe != 0);
+}
+
+
+/*-------------------------------------------------
+    stream_set_output_only - mark whether only
+    the audio output depends on running a
+    stream's callback
+-------------------------------------------------*/
+
+void stream_set_output_only(sound_stream *stream, int output_only)
+{
+	stream->output_only = (output_only != 0);
+}
+
+
+/*-------------------------------------------------
+    stream_set_time_callback - set a cheap
+    callback that advances a skipped stream's
+    state without generating any samples
+-------------------------------------------------*/
+
+void stream_set_time_callback(sound_stream *stream, stream_time_callback callback)
+{
+	stream->time_callback = callback;
+}
+
+
 /*-------------------------------------------------
     stream_get_output_since_last_update - return a
     pointer to the output buffer and the number of
@@ -728,6 +945,7 @@ static void recompute_sample_rate_data(streams_private *strdata, sound_stream *s
 
 static void generate_samples(sound_stream *stream, int samples)
 {
+	osd_ticks_t start_ticks;
 	int inputnum, outputnum;
 
 	/* if we're already there, skip it */
@@ -736,6 +954,19 @@ static void generate_samples(sound_stream *stream, int samples)
 
 	VPRINTF(("generate_samples(%p, %d)\n", stream, samples));
 
+	/* nobody listens to a skipped stream; output silence and only keep time, if asked */
+	if (stream->skip)
+	{
+		for (outputnum = 0; outputnum < stream->outputs; outputnum++)
+		{
+			stream_output *output = &stream->output[outputnum];
+			memset(output->buffer + (stream->output_sampindex - stream->output_base_sampindex), 0, samples * sizeof(output->buffer[0]));
+		}
+		if (stream->time_callback != NULL)
+			(*stream->time_callback)(stream->param, samples);
+		return;
+	}
+
 	/* ensure all inputs are up to date and generate resampled data */
 	for (inputnum = 0; inputnum < stream->inputs; inputnum++)
 	{
@@ -758,7 +989,14 @@ static void generate_samples(sound_stream *stream, int samples)
 
 	/* run the callback */
 	VPRINTF(("  callback(%p, %d)\n", stream, samples));
+	/* the profiler only follows the main thread */
+	if (!stream->threaded)
+		profiler_mark(stream->profiler_scope);
+	start_ticks = osd_ticks();
 	(*stream->callback)(stream->param, stream->input_array, stream->output_array, samples);
+	stream->callback_ticks += osd_ticks() - start_ticks;
+	if (!stream->threaded)
+		profiler_mark(PROFILER_END);
 	VPRINTF(("  callback done\n"));
 }
 
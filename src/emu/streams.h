@@ -22,6 +22,7 @@
 typedef struct _sound_stream sound_stream;
 
 typedef void (*stream_callback)(void *param, stream_sample_t **inputs, stream_sample_t **outputs, int samples);
+typedef void (*stream_time_callback)(void *param, int samples);
 
 
 
@@ -32,6 +33,9 @@ typedef void (*stream_callback)(void *param, stream_sample_t **inputs, stream_sa
 void streams_init(running_machine *machine, subseconds_t update_subseconds);
 void streams_set_tag(running_machine *machine, void *streamtag);
 void streams_update(running_machine *machine);
+void streams_update_parallel(running_machine *machine);
+osd_ticks_t streams_get_callback_ticks(running_machine *machine);
+void streams_set_lazy(running_machine *machine, int lazy);
 
 /* core stream configuration and operation */
 sound_stream *stream_create(int inputs, int outputs, int sample_rate, void *param, stream_callback callback);
@@ -46,5 +50,9 @@ int stream_get_outputs(sound_stream *stream);
 void stream_set_input_gain(sound_stream *stream, int input, float gain);
 void stream_set_output_gain(sound_stream *stream, int output, float gain);
 void stream_set_sample_rate(sound_stream *stream, int sample_rate);
+void stream_set_profiler_scope(sound_stream *stream, int scope);
+void stream_set_threadsafe(sound_stream *stream, int threadsafe);
+void stream_set_output_only(sound_stream *stream, int output_only);
+void stream_set_time_callback(sound_stream *stream, stream_time_callback callback);
 
 #endif
@@ -25,6 +25,9 @@
 /* invalid logical index */
 #define INVALID_LOGICAL_INDEX			((tilemap_logical_index)~0)
 
+/* number of dirty tiles rendered by each work item in tilemap_prerender */
+#define PRERENDER_BAND_TILES			128
+
 
 
 /***************************************************************************
@@ -63,6 +66,27 @@ struct _blit_parameters
 };
 
 
+/* a dirty tile whose info has been fetched, waiting to be rendered */
+typedef struct _prerender_tile prerender_tile;
+struct _prerender_tile
+{
+	tilemap_logical_index		logindex;			/* logical index of the tile */
+	UINT32						col;				/* tile column */
+	UINT32						row;				/* tile row */
+	tile_data					tileinfo;			/* tile info captured from the callback */
+};
+
+
+/* a run of dirty tiles rendered by a single work item */
+typedef struct _prerender_band prerender_band;
+struct _prerender_band
+{
+	tilemap *					tmap;				/* tilemap being rendered */
+	const prerender_tile *		tiles;				/* first tile in the run */
+	int							count;				/* number of tiles in the run */
+};
+
+
 /* core tilemap structure */
 struct _tilemap
 {
@@ -114,6 +138,10 @@ struct _tilemap
 	UINT8 *						tileflags;			/* per-tile flags */
 	UINT8 *						pen_to_flags; 		/* mapping of pens to flags */
 	UINT32						max_pen_to_flags;	/* maximum index in each array */
+
+	/* parallel prerendering */
+	prerender_tile *			prerender_tiles;	/* dirty tiles queued for rendering */
+	prerender_band *			prerender_bands;	/* work item parameters */
 };
 
 
@@ -130,6 +158,8 @@ static int				tilemap_instance;
 
 static UINT32			screen_width, screen_height;
 
+static osd_work_queue *	tilemap_work_queue;
+
 
 
 /***************************************************************************
@@ -148,6 +178,9 @@ static void mappings_update(tilemap *tmap);
 /* tile rendering */
 static void pixmap_update(tilemap *tmap, const rectangle *cliprect);
 static void tile_update(tilemap *tmap, tilemap_logical_index logindex, UINT32 cached_col, UINT32 cached_row);
+static void tile_render(tilemap *tmap, const tile_data *tileinfo, tilemap_logical_index logindex, UINT32 col, UINT32 row);
+static void prerender_queue(tilemap *tmap);
+static void *prerender_band_callback(void *param);
 static UINT8 tile_draw(tilemap *tmap, const UINT8 *pendata, UINT32 x0, UINT32 y0, UINT32 palette_base, UINT8 category, UINT8 group, UINT8 flags);
 static UINT8 tile_draw_colortable(tilemap *tmap, const UINT8 *pendata, UINT32 x0, UINT32 y0, UINT32 palette_base, UINT8 category, UINT8 group, UINT8 flags);
 static UINT8 tile_draw_colortrans(tilemap *tmap, const UINT8 *pendata, UINT32 x0, UINT32 y0, UINT32 palette_base, UINT8 category, UINT8 group, UINT8 flags);
@@ -273,6 +306,7 @@ void tilemap_init(running_machine *machine)
 	tilemap_instance = 0;
 
 	priority_bitmap = auto_bitmap_alloc(screen_width, screen_height, BITMAP_FORMAT_INDEXED8);
+	tilemap_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 	add_exit_callback(machine, tilemap_exit);
 }
 
@@ -705,6 +739,31 @@ UINT8 *tilemap_get_tile_flags(tilemap *tmap)
     TILEMAP RENDERING
 ***************************************************************************/
 
+/*-------------------------------------------------
+    tilemap_prerender - bring the pixmaps of one
+    or all enabled tilemaps up to date, fetching
+    tile info on this thread and rendering the
+    dirty tiles on the work queue
+-------------------------------------------------*/
+
+void tilemap_prerender(tilemap *tmap)
+{
+profiler_mark(PROFILER_TILEMAP_UPDATE);
+	/* handle ALL_TILEMAPS */
+	if (tmap == ALL_TILEMAPS)
+	{
+		for (tmap = tilemap_list; tmap != NULL; tmap = tmap->next)
+			prerender_queue(tmap);
+	}
+	else
+		prerender_queue(tmap);
+
+	/* wait for all the bands to finish before anyone composites */
+	osd_work_queue_wait(tilemap_work_queue, 100 * osd_ticks_per_second());
+profiler_mark(PROFILER_END);
+}
+
+
 /*-------------------------------------------------
     tilemap_draw_primask - draw a tilemap to the
     destination with clipping; pixels apply
@@ -1016,6 +1075,11 @@ static void tilemap_exit(running_machine *machine)
 		tilemap_list = next;
 	}
 	tilemap_tailptr = NULL;
+
+	/* free the work queue */
+	if (tilemap_work_queue != NULL)
+		osd_work_queue_free(tilemap_work_queue);
+	tilemap_work_queue = NULL;
 }
 
 
@@ -1049,6 +1113,10 @@ static void tilemap_dispose(tilemap *tmap)
 		}
 
 	/* free allocated memory */
+	if (tmap->prerender_bands != NULL)
+		free(tmap->prerender_bands);
+	if (tmap->prerender_tiles != NULL)
+		free(tmap->prerender_tiles);
 	free(tmap->pen_to_flags);
 	free(tmap->tileflags);
 	bitmap_free(tmap->flagsmap);
@@ -1204,10 +1272,7 @@ profiler_mark(PROFILER_END);
 
 static void tile_update(tilemap *tmap, tilemap_logical_index logindex, UINT32 col, UINT32 row)
 {
-	UINT32 x0 = tmap->tilewidth * col;
-	UINT32 y0 = tmap->tileheight * row;
 	tilemap_memory_index memindex;
-	UINT32 flags;
 
 profiler_mark(PROFILER_TILEMAP_UPDATE);
 
@@ -1215,25 +1280,121 @@ profiler_mark(PROFILER_TILEMAP_UPDATE);
 	memindex = tmap->logical_to_memory[logindex];
 	(*tmap->tile_get_info)(Machine, &tmap->tileinfo, memindex, tmap->user_data);
 
+	/* render it */
+	tile_render(tmap, &tmap->tileinfo, logindex, col, row);
+
+profiler_mark(PROFILER_END);
+}
+
+
+/*-------------------------------------------------
+    tile_render - render a tile into the pixmap
+    and flagsmap from previously fetched tile
+    info; touches nothing outside the tile, so it
+    is safe to call from a work item
+-------------------------------------------------*/
+
+static void tile_render(tilemap *tmap, const tile_data *tileinfo, tilemap_logical_index logindex, UINT32 col, UINT32 row)
+{
+	UINT32 x0 = tmap->tilewidth * col;
+	UINT32 y0 = tmap->tileheight * row;
+	UINT32 flags;
+
 	/* apply the global tilemap flip to the returned flip flags */
-	flags = tmap->tileinfo.flags ^ (tmap->attributes & 0x03);
+	flags = tileinfo->flags ^ (tmap->attributes & 0x03);
 
 	/* draw the tile, using either direct or transparent */
 	if (Machine->game_colortable != NULL)
 	{
 		if (tmap->type != TILEMAP_TYPE_COLORTABLE)
-			tmap->tileflags[logindex] = tile_draw_colortable(tmap, tmap->tileinfo.pen_data, x0, y0, tmap->tileinfo.palette_base, tmap->tileinfo.category, tmap->tileinfo.group, flags);
+			tmap->tileflags[logindex] = tile_draw_colortable(tmap, tileinfo->pen_data, x0, y0, tileinfo->palette_base, tileinfo->category, tileinfo->group, flags);
 		else
-			tmap->tileflags[logindex] = tile_draw_colortrans(tmap, tmap->tileinfo.pen_data, x0, y0, tmap->tileinfo.palette_base, tmap->tileinfo.category, tmap->tileinfo.group, flags);
+			tmap->tileflags[logindex] = tile_draw_colortrans(tmap, tileinfo->pen_data, x0, y0, tileinfo->palette_base, tileinfo->category, tileinfo->group, flags);
 	}
 	else
-		tmap->tileflags[logindex] = tile_draw(tmap, tmap->tileinfo.pen_data, x0, y0, tmap->tileinfo.palette_base, tmap->tileinfo.category, tmap->tileinfo.group, flags);
+		tmap->tileflags[logindex] = tile_draw(tmap, tileinfo->pen_data, x0, y0, tileinfo->palette_base, tileinfo->category, tileinfo->group, flags);
 
 	/* if mask data is specified, apply it */
-	if ((flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && tmap->tileinfo.mask_data != NULL)
-		tmap->tileflags[logindex] = tile_apply_bitmask(tmap, tmap->tileinfo.mask_data, x0, y0, tmap->tileinfo.category, flags);
+	if ((flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && tileinfo->mask_data != NULL)
+		tmap->tileflags[logindex] = tile_apply_bitmask(tmap, tileinfo->mask_data, x0, y0, tileinfo->category, flags);
+}
 
-profiler_mark(PROFILER_END);
+
+/*-------------------------------------------------
+    prerender_queue - fetch the info for every
+    dirty tile in an enabled tilemap and queue
+    the rendering in bands on the work queue
+-------------------------------------------------*/
+
+static void prerender_queue(tilemap *tmap)
+{
+	tilemap_logical_index logindex;
+	prerender_band *band;
+	int count = 0;
+	int first;
+
+	/* skip if disabled or nothing to do */
+	if (!tmap->enable || tmap->all_tiles_clean)
+		return;
+
+	/* allocate the queues the first time through */
+	if (tmap->prerender_tiles == NULL)
+	{
+		tmap->prerender_tiles = malloc_or_die(tmap->max_logical_index * sizeof(tmap->prerender_tiles[0]));
+		tmap->prerender_bands = malloc_or_die((tmap->max_logical_index + PRERENDER_BAND_TILES - 1) / PRERENDER_BAND_TILES * sizeof(tmap->prerender_bands[0]));
+	}
+
+	/* if the whole map is dirty, mark it as such */
+	if (tmap->all_tiles_dirty)
+	{
+		memset(tmap->tileflags, TILE_FLAG_DIRTY, tmap->max_logical_index);
+		tmap->all_tiles_dirty = FALSE;
+	}
+
+	/* fetch the tile info in the same order pixmap_update would; the callbacks */
+	/* are driver code and are never called from the work queue */
+	for (logindex = 0; logindex < tmap->max_logical_index; logindex++)
+		if (tmap->tileflags[logindex] == TILE_FLAG_DIRTY)
+		{
+			prerender_tile *tile = &tmap->prerender_tiles[count++];
+			tile->logindex = logindex;
+			tile->col = logindex % tmap->cols;
+			tile->row = logindex / tmap->cols;
+			(*tmap->tile_get_info)(Machine, &tmap->tileinfo, tmap->logical_to_memory[logindex], tmap->user_data);
+			tile->tileinfo = tmap->tileinfo;
+		}
+
+	/* tiles never overlap, so each band can be rendered independently */
+	band = tmap->prerender_bands;
+	for (first = 0; first < count; first += PRERENDER_BAND_TILES)
+	{
+		band->tmap = tmap;
+		band->tiles = &tmap->prerender_tiles[first];
+		band->count = MIN(count - first, PRERENDER_BAND_TILES);
+		osd_work_item_queue(tilemap_work_queue, prerender_band_callback, band, WORK_ITEM_FLAG_AUTO_RELEASE);
+		band++;
+	}
+
+	tmap->all_tiles_clean = TRUE;
+}
+
+
+/*-------------------------------------------------
+    prerender_band_callback - work item that
+    renders one band of queued dirty tiles
+-------------------------------------------------*/
+
+static void *prerender_band_callback(void *param)
+{
+	prerender_band *band = param;
+	int index;
+
+	for (index = 0; index < band->count; index++)
+	{
+		const prerender_tile *tile = &band->tiles[index];
+		tile_render(band->tmap, &tile->tileinfo, tile->logindex, tile->col, tile->row);
+	}
+	return NULL;
 }
 
 
@@ -2090,8 +2251,10 @@ static void scanline_draw_masked_null(void *dest, const UINT16 *source, const UI
 	if (pcode != 0xff00)
 	{
 		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+		{
+			UINT8 newpri = (pri[i] & (pcode >> 8)) | pcode;
+			pri[i] = ((maskptr[i] & mask) == value) ? newpri : pri[i];
+		}
 	}
 }
 
@@ -2142,7 +2305,10 @@ static void scanline_draw_opaque_ind16(void *_dest, const UINT16 *source, int co
 
 /*-------------------------------------------------
     scanline_draw_masked_ind16 - draw to a 16bpp
-    indexed bitmap using a mask
+    indexed bitmap using a mask; the masked
+    renderers store every pixel and select the
+    old value where the mask fails, so the loops
+    have no per-pixel branch and vectorize
 -------------------------------------------------*/
 
 static void scanline_draw_masked_ind16(void *_dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
@@ -2155,19 +2321,23 @@ static void scanline_draw_masked_ind16(void *_dest, const UINT16 *source, const
 	if ((pcode & 0xffff) != 0xff00)
 	{
 		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = source[i] + pal;
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
+		{
+			int draw = ((maskptr[i] & mask) == value);
+			UINT16 pix = source[i] + pal;
+			UINT8 newpri = (pri[i] & (pcode >> 8)) | pcode;
+			dest[i] = draw ? pix : dest[i];
+			pri[i] = draw ? newpri : pri[i];
+		}
 	}
 
 	/* no priority case */
 	else
 	{
 		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = source[i] + pal;
+		{
+			UINT16 pix = source[i] + pal;
+			dest[i] = ((maskptr[i] & mask) == value) ? pix : dest[i];
+		}
 	}
 }
 
@@ -2218,19 +2388,23 @@ static void scanline_draw_masked_rgb16(void *_dest, const UINT16 *source, const
 	if ((pcode & 0xffff) != 0xff00)
 	{
 		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = clut[source[i]];
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
+		{
+			int draw = ((maskptr[i] & mask) == value);
+			pen_t pix = clut[source[i]];
+			UINT8 newpri = (pri[i] & (pcode >> 8)) | pcode;
+			dest[i] = draw ? pix : dest[i];
+			pri[i] = draw ? newpri : pri[i];
+		}
 	}
 
 	/* no priority case */
 	else
 	{
 		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = clut[source[i]];
+		{
+			pen_t pix = clut[source[i]];
+			dest[i] = ((maskptr[i] & mask) == value) ? pix : dest[i];
+		}
 	}
 }
 
@@ -2343,19 +2517,23 @@ static void scanline_draw_masked_rgb32(void *_dest, const UINT16 *source, const
 	if ((pcode & 0xffff) != 0xff00)
 	{
 		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = clut[source[i]];
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
+		{
+			int draw = ((maskptr[i] & mask) == value);
+			pen_t pix = clut[source[i]];
+			UINT8 newpri = (pri[i] & (pcode >> 8)) | pcode;
+			dest[i] = draw ? pix : dest[i];
+			pri[i] = draw ? newpri : pri[i];
+		}
 	}
 
 	/* no priority case */
 	else
 	{
 		for (i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = clut[source[i]];
+		{
+			pen_t pix = clut[source[i]];
+			dest[i] = ((maskptr[i] & mask) == value) ? pix : dest[i];
+		}
 	}
 }
 
@@ -314,6 +314,14 @@
         a group, pass a mask of ~0. The helper function
         tilemap_map_pen_to_layer() does this for you.
 
+    * Drivers with several large tilemaps can call tilemap_prerender()
+        at the top of their VIDEO_UPDATE, after any dirty marking, to
+        render all dirty tiles in parallel before compositing. The
+        tile_get_info callbacks are still called on the main thread, but
+        the pen_data and mask_data they return must stay valid until
+        tilemap_prerender() returns, so callbacks that build mask data
+        in a shared scratch buffer must not use it.
+
 ***************************************************************************/
 
 #pragma once
@@ -535,6 +543,9 @@ UINT8 *tilemap_get_tile_flags(tilemap *tmap);
 
 /* ----- tilemap rendering ----- */
 
+/* render all dirty tiles of one or all (ALL_TILEMAPS) enabled tilemaps on the work queue */
+void tilemap_prerender(tilemap *tmap);
+
 /* draw a tilemap to the destination with clipping; pixels apply priority/priority_mask to the priority bitmap */
 void tilemap_draw_primask(mame_bitmap *dest, const rectangle *cliprect, tilemap *tmap, UINT32 flags, UINT8 priority, UINT8 priority_mask);
 
@@ -36,6 +36,8 @@
 
 #define MAX_TIMERS		256
 
+#define SCOPE_CACHE_SIZE	256
+
 
 
 /***************************************************************************
@@ -54,6 +56,7 @@ struct _mame_timer
 	const char *	file;
 	int 			line;
 	const char *	func;
+	int				profiler_scope;
 	UINT8 			enabled;
 	UINT8 			temporary;
 	UINT8			ptr;
@@ -63,6 +66,15 @@ struct _mame_timer
 };
 
 
+/* profiler scope registered for a timer callback */
+typedef struct _timer_scope_entry timer_scope_entry;
+struct _timer_scope_entry
+{
+	FPTR			callback;
+	int				scope;
+};
+
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -83,6 +95,12 @@ static mame_time global_basetime;
 static mame_timer *callback_timer;
 static int callback_timer_modified;
 static mame_time callback_timer_expire_time;
+static UINT64 callback_count;
+
+#ifdef MAME_PROFILER
+/* profiler scopes by callback, so allocating a timer doesn't look up its name */
+static timer_scope_entry scope_cache[SCOPE_CACHE_SIZE];
+#endif
 
 /* other constant times */
 mame_time time_zero;
@@ -255,6 +273,7 @@ void timer_init(running_machine *machine)
 	global_basetime = time_zero;
 	callback_timer = NULL;
 	callback_timer_modified = FALSE;
+	callback_count = 0;
 
 	/* register with the save state system */
 	state_save_push_tag(0);
@@ -335,19 +354,24 @@ void mame_timer_set_global_time(mame_time newbase)
 		/* call the callback */
 		if (was_enabled)
 		{
+			callback_count++;
 			if (!timer->ptr && timer->callback)
 			{
 				LOG(("Timer %s:%d[%s] fired (expire=%.9f)\n", timer->file, timer->line, timer->func, mame_time_to_double(timer->expire)));
 				profiler_mark(PROFILER_TIMER_CALLBACK);
+				profiler_mark(timer->profiler_scope);
 				(*timer->callback)(Machine, timer->callback_param);
 				profiler_mark(PROFILER_END);
+				profiler_mark(PROFILER_END);
 			}
 			else if (timer->ptr && timer->callback_ptr)
 			{
 				LOG(("Timer %s:%d[%s] fired (expire=%.9f)\n", timer->file, timer->line, timer->func, mame_time_to_double(timer->expire)));
 				profiler_mark(PROFILER_TIMER_CALLBACK);
+				profiler_mark(timer->profiler_scope);
 				(*timer->callback_ptr)(Machine, timer->callback_ptr_param);
 				profiler_mark(PROFILER_END);
+				profiler_mark(PROFILER_END);
 			}
 		}
 
@@ -450,6 +474,17 @@ static void timer_postload(void)
 }
 
 
+/*-------------------------------------------------
+    timer_get_fire_count - return the number of
+    timer callbacks fired since timer_init
+-------------------------------------------------*/
+
+UINT64 timer_get_fire_count(void)
+{
+	return callback_count;
+}
+
+
 /*-------------------------------------------------
     timer_count_anonymous - count the number of
     anonymous (non-saveable) timers
@@ -478,6 +513,29 @@ int timer_count_anonymous(void)
     CORE TIMER ALLOCATION
 ***************************************************************************/
 
+/*-------------------------------------------------
+    timer_profiler_scope - return the profiler
+    scope for a timer callback, registering it
+    the first time the callback is seen
+-------------------------------------------------*/
+
+#ifdef MAME_PROFILER
+INLINE int timer_profiler_scope(FPTR callback, const char *func)
+{
+	timer_scope_entry *entry = &scope_cache[(callback >> 2) % SCOPE_CACHE_SIZE];
+
+	if (entry->callback != callback)
+	{
+		entry->callback = callback;
+		entry->scope = profiler_register_scope(func);
+	}
+	return entry->scope;
+}
+#else
+#define timer_profiler_scope(callback, func)	(0)
+#endif
+
+
 /*-------------------------------------------------
     timer_alloc - allocate a permament timer that
     isn't primed yet
@@ -500,6 +558,7 @@ INLINE mame_timer *_mame_timer_alloc_common(void (*callback)(running_machine *,
 	timer->file = file;
 	timer->line = line;
 	timer->func = func;
+	timer->profiler_scope = timer_profiler_scope((callback != NULL) ? (FPTR)callback : (FPTR)callback_ptr, func);
 
 	/* compute the time of the next firing and insert into the list */
 	timer->start = time;
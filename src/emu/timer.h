@@ -118,6 +118,7 @@ extern UINT32 cycles_per_second[];
 void timer_init(running_machine *machine);
 void timer_destructor(void *ptr, size_t size);
 int timer_count_anonymous(void);
+UINT64 timer_get_fire_count(void);
 
 mame_time mame_timer_next_fire_time(void);
 void mame_timer_set_global_time(mame_time newbase);
@@ -105,6 +105,7 @@ struct _video_global
 	mame_time 				speed_last_emutime;	/* emulated time at the last speed calculation */
 	double 					speed_percent;		/* most recent speed percentage */
 	UINT32 					partial_updates_this_frame;/* partial update counter this frame */
+	osd_ticks_t				update_ticks;		/* real time spent in the driver's video update */
 
 	/* overall speed computation */
 	UINT32					overall_real_seconds;/* accumulated real seconds at normal speed */
@@ -844,7 +845,11 @@ void video_screen_update_partial(int scrnum, int scanline)
 		LOG_PARTIAL_UPDATES(("updating %d-%d\n", clip.min_y, clip.max_y));
 
 		if (Machine->drv->video_update != NULL)
+		{
+			osd_ticks_t start_ticks = osd_ticks();
 			flags = (*Machine->drv->video_update)(Machine, scrnum, info->bitmap[info->curbitmap], &clip);
+			global.update_ticks += osd_ticks() - start_ticks;
+		}
 		global.partial_updates_this_frame++;
 		profiler_mark(PROFILER_END);
 
@@ -1054,6 +1059,7 @@ void video_frame_update(void)
 
 	/* perform tasks for this frame */
 	mame_frame_update(Machine);
+	profiler_frame_update();
 
 	/* update frameskipping */
 	update_frameskip();
@@ -1181,6 +1187,17 @@ void video_set_speed_factor(int speed)
 }
 
 
+/*-------------------------------------------------
+    video_get_update_ticks - return the real time
+    spent in the driver's video update so far
+-------------------------------------------------*/
+
+osd_ticks_t video_get_update_ticks(void)
+{
+	return global.update_ticks;
+}
+
+
 /*-------------------------------------------------
     video_get_speed_text - print the text to
     be displayed in the upper-right corner
@@ -1520,6 +1537,7 @@ static osd_ticks_t throttle_until_ticks(osd_ticks_t target_ticks)
 		}
 		current_ticks = new_ticks;
 	}
+	profiler_mark(PROFILER_END);
 
 	return current_ticks;
 }
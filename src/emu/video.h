@@ -132,6 +132,9 @@ void video_set_speed_factor(int speed);
 /* return text to display about the current speed */
 const char *video_get_speed_text(void);
 
+/* return the real time spent in the driver's video update so far */
+osd_ticks_t video_get_update_ticks(void);
+
 /* get/set the current frameskip (-1 means auto) */
 int video_get_frameskip(void);
 void video_set_frameskip(int frameskip);
@@ -0,0 +1,703 @@
+/***************************************************************************
+
+    polynew.c
+
+    Helper routines for polygon rendering.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include "driver.h"
+#include "profiler.h"
+#include "polynew.h"
+#include <math.h>
+
+
+/***************************************************************************
+    DEBUGGING
+***************************************************************************/
+
+/* keep statistics */
+#define KEEP_STATISTICS					0
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define SCANLINES_PER_BUCKET			8
+#define TOTAL_BUCKETS					(1024 / SCANLINES_PER_BUCKET)
+#define MAX_SCANLINES					(TOTAL_BUCKETS * SCANLINES_PER_BUCKET)
+#define MAX_WORK_UNITS					8192
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* polygon_info describes a single polygon, which includes the poly_params */
+typedef struct _polygon_info polygon_info;
+struct _polygon_info
+{
+	void *					dest;				/* destination to draw to */
+	void *					extra;				/* extra data pointer */
+	poly_draw_scanline_func	callback;			/* callback to handle a scanline's worth of work */
+};
+
+
+/* work_unit describes up to SCANLINES_PER_BUCKET consecutive scanlines of one polygon */
+typedef struct _work_unit work_unit;
+struct _work_unit
+{
+	work_unit *				next;				/* next unit in the same bucket */
+	const polygon_info *	polygon;			/* pointer to polygon */
+	INT32					scanline;			/* first scanline */
+	INT32					count;				/* number of scanlines */
+	poly_extent				extent[SCANLINES_PER_BUCKET]; /* array of scanline extents */
+};
+
+
+/* poly_bucket is the list of work for a band of scanlines; it is the unit handed to the work queue */
+typedef struct _poly_bucket poly_bucket;
+struct _poly_bucket
+{
+	work_unit *				head;				/* first unit, in submission order */
+	work_unit *				tail;				/* last unit */
+};
+
+
+/* poly_manager is an opaque object that manages polygon rendering */
+struct _poly_manager
+{
+	osd_work_queue *		queue;				/* work queue, or NULL to draw on the calling thread */
+	UINT8					flags;				/* flags */
+
+	/* polygons */
+	polygon_info *			polygon;			/* array of polygons */
+	UINT32					polygon_count;		/* number of polygons allocated */
+	UINT32					polygon_next;		/* index of the next free polygon */
+
+	/* extra data */
+	UINT8 *					extra;				/* extra data, one block per polygon */
+	size_t					extra_size;			/* size of each extra data block */
+
+	/* work units */
+	work_unit *				unit;				/* array of work units */
+	UINT32					unit_count;			/* number of work units allocated */
+	UINT32					unit_next;			/* index of the next free unit */
+
+	/* scanline buckets */
+	poly_bucket				bucket[TOTAL_BUCKETS];
+
+	/* statistics */
+	UINT32					triangles;			/* number of triangles queued */
+	UINT64					pixels;				/* number of pixels drawn */
+	UINT32					units;				/* number of work units queued */
+	UINT32					flushes;			/* number of times we flushed */
+	UINT32					full_flushes;		/* number of flushes forced by running out of space */
+};
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+static void *poly_item_callback(void *param);
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    flush_for_space - flush the queue to make room,
+    keeping the extra data for the polygon that
+    is currently being set up
+-------------------------------------------------*/
+
+INLINE void flush_for_space(poly_manager *poly)
+{
+	UINT32 current = poly->polygon_next;
+
+	poly_wait(poly, "Out of space");
+	poly->full_flushes++;
+
+	/* the driver may already have filled in the extra data */
+	if (current != 0 && poly->extra_size != 0)
+		memcpy(poly->extra, poly->extra + current * poly->extra_size, poly->extra_size);
+}
+
+
+/*-------------------------------------------------
+    allocate_polygon - reserve the next polygon
+    along with 'units' work units
+-------------------------------------------------*/
+
+INLINE polygon_info *allocate_polygon(poly_manager *poly, void *dest, poly_draw_scanline_func callback, UINT32 units)
+{
+	polygon_info *polygon;
+
+	/* if we don't have room for the worst case, flush what we have */
+	if (poly->polygon_next >= poly->polygon_count || poly->unit_next + units > poly->unit_count)
+		flush_for_space(poly);
+
+	polygon = &poly->polygon[poly->polygon_next];
+	polygon->dest = dest;
+	polygon->callback = callback;
+	polygon->extra = poly->extra + poly->polygon_next * poly->extra_size;
+	return polygon;
+}
+
+
+/*-------------------------------------------------
+    allocate_unit - start a new work unit for
+    'polygon' at 'scanline' and append it to the
+    bucket holding that scanline
+-------------------------------------------------*/
+
+INLINE work_unit *allocate_unit(poly_manager *poly, const polygon_info *polygon, INT32 scanline)
+{
+	poly_bucket *bucket = &poly->bucket[scanline / SCANLINES_PER_BUCKET];
+	work_unit *unit = &poly->unit[poly->unit_next++];
+
+	unit->next = NULL;
+	unit->polygon = polygon;
+	unit->scanline = scanline;
+	unit->count = 0;
+	if (bucket->tail != NULL)
+		bucket->tail->next = unit;
+	else
+		bucket->head = unit;
+	bucket->tail = unit;
+	poly->units++;
+	return unit;
+}
+
+
+/*-------------------------------------------------
+    units_for_rows - return the worst-case number
+    of work units a triangle spanning miny..maxy
+    can need after clipping
+-------------------------------------------------*/
+
+INLINE UINT32 units_for_rows(const rectangle *cliprect, float miny, float maxy)
+{
+	float rows = MIN(maxy, (float)cliprect->max_y + 1.0f) - MAX(miny, (float)cliprect->min_y);
+	return ((rows > 0.0f) ? (UINT32)rows : 0) / SCANLINES_PER_BUCKET + 2;
+}
+
+
+/*-------------------------------------------------
+    round_coordinate - return the first pixel
+    whose center lies at or beyond 'value'
+-------------------------------------------------*/
+
+INLINE INT32 round_coordinate(float value)
+{
+	double result = ceil(value - 0.5f);
+	return (INT32)result;
+}
+
+
+/*-------------------------------------------------
+    round_coordinate_inclusive - return one past
+    the last pixel whose center lies at or before
+    'value'
+-------------------------------------------------*/
+
+INLINE INT32 round_coordinate_inclusive(float value)
+{
+	double result = floor(value - 0.5f);
+	return (INT32)result + 1;
+}
+
+
+
+/***************************************************************************
+    INITIALIZATION/TEARDOWN
+***************************************************************************/
+
+/*-------------------------------------------------
+    poly_alloc - initialize a new polygon
+    manager
+-------------------------------------------------*/
+
+poly_manager *poly_alloc(int max_polys, size_t extra_data_size, UINT8 flags)
+{
+	poly_manager *poly;
+
+	/* allocate the manager itself */
+	poly = malloc_or_die(sizeof(*poly));
+	memset(poly, 0, sizeof(*poly));
+	poly->flags = flags;
+
+	/* allocate polygons and their extra data */
+	poly->polygon_count = MAX(max_polys, 1);
+	poly->polygon = malloc_or_die(poly->polygon_count * sizeof(poly->polygon[0]));
+	poly->extra_size = extra_data_size;
+	poly->extra = malloc_or_die(poly->polygon_count * extra_data_size + 1);
+
+	/* allocate work units; we need at least enough for one full-screen polygon */
+	poly->unit_count = MAX_WORK_UNITS;
+	poly->unit = malloc_or_die(poly->unit_count * sizeof(poly->unit[0]));
+
+	/* create the work queue */
+	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
+		poly->queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
+	return poly;
+}
+
+
+/*-------------------------------------------------
+    poly_free - free a polygon manager
+-------------------------------------------------*/
+
+void poly_free(poly_manager *poly)
+{
+#if KEEP_STATISTICS
+	mame_printf_verbose("Total triangles = %d\n", poly->triangles);
+	mame_printf_verbose("Total pixels    = %d\n", (UINT32)poly->pixels);
+	mame_printf_verbose("Total units     = %d\n", poly->units);
+	mame_printf_verbose("Flushes         = %d (%d out of space)\n", poly->flushes, poly->full_flushes);
+#endif
+
+	/* make sure nothing is still using our memory */
+	poly_wait(poly, "Free");
+	if (poly->queue != NULL)
+		osd_work_queue_free(poly->queue);
+
+	free(poly->unit);
+	free(poly->extra);
+	free(poly->polygon);
+	free(poly);
+}
+
+
+
+/***************************************************************************
+    COMMON FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    poly_wait - hand all queued polygons to the
+    work queue and wait for them to be drawn
+-------------------------------------------------*/
+
+void poly_wait(poly_manager *poly, const char *debug_reason)
+{
+	int bucketnum;
+
+	/* nothing to do if nothing is queued */
+	if (poly->unit_next == 0)
+	{
+		poly->polygon_next = 0;
+		return;
+	}
+
+	profiler_mark(PROFILER_VIDEO);
+
+	/* each non-empty bucket becomes one work item */
+	for (bucketnum = 0; bucketnum < TOTAL_BUCKETS; bucketnum++)
+		if (poly->bucket[bucketnum].head != NULL)
+		{
+			if (poly->queue != NULL)
+				osd_work_item_queue(poly->queue, poly_item_callback, &poly->bucket[bucketnum], WORK_ITEM_FLAG_AUTO_RELEASE);
+			else
+				poly_item_callback(&poly->bucket[bucketnum]);
+		}
+
+	/* wait for all of them to finish */
+	if (poly->queue != NULL)
+		osd_work_queue_wait(poly->queue, 100 * osd_ticks_per_second());
+
+	/* reset the buckets and allocators */
+	memset(poly->bucket, 0, sizeof(poly->bucket));
+	poly->polygon_next = 0;
+	poly->unit_next = 0;
+	poly->flushes++;
+
+	profiler_mark(PROFILER_END);
+}
+
+
+/*-------------------------------------------------
+    poly_get_extra_data - get a pointer to the
+    extra data for the next polygon
+-------------------------------------------------*/
+
+void *poly_get_extra_data(poly_manager *poly)
+{
+	/* out of polygons? flush */
+	if (poly->polygon_next >= poly->polygon_count)
+	{
+		poly_wait(poly, "Out of polygons");
+		poly->full_flushes++;
+	}
+
+	return poly->extra + poly->polygon_next * poly->extra_size;
+}
+
+
+
+/***************************************************************************
+    CORE TRIANGLE RENDERING
+***************************************************************************/
+
+/*-------------------------------------------------
+    setup_triangle - walk the edges of a single
+    triangle, binning its extents into work units
+-------------------------------------------------*/
+
+static UINT32 setup_triangle(poly_manager *poly, const polygon_info *polygon, const rectangle *cliprect, int paramcount, const poly_vertex *v1, const poly_vertex *v2, const poly_vertex *v3)
+{
+	float dxdy_v1v2, dxdy_v1v3, dxdy_v2v3;
+	float dpdx[MAX_VERTEX_PARAMS], dpdy[MAX_VERTEX_PARAMS], porigin[MAX_VERTEX_PARAMS];
+	const poly_vertex *tv;
+	INT32 starty, stopy, curscan;
+	INT32 minx, maxx;
+	work_unit *unit = NULL;
+	UINT32 pixels = 0;
+	float area, ooarea;
+	int paramnum;
+
+	/* first sort by Y */
+	if (v2->y < v1->y) { tv = v1; v1 = v2; v2 = tv; }
+	if (v3->y < v2->y)
+	{
+		tv = v2; v2 = v3; v3 = tv;
+		if (v2->y < v1->y) { tv = v1; v1 = v2; v2 = tv; }
+	}
+
+	/* compute the covered scanlines, clipped to the cliprect */
+	if (v1->y - 0.5f > (float)cliprect->max_y || v3->y + 0.5f < (float)cliprect->min_y)
+		return 0;
+	starty = round_coordinate(MAX(v1->y, (float)cliprect->min_y));
+	if (poly->flags & POLYFLAG_INCLUDE_BOTTOM_EDGE)
+		stopy = round_coordinate_inclusive(MIN(v3->y, (float)cliprect->max_y + 1.0f));
+	else
+		stopy = round_coordinate(MIN(v3->y, (float)cliprect->max_y + 1.0f));
+	if (stopy > cliprect->max_y + 1)
+		stopy = cliprect->max_y + 1;
+	if (stopy > MAX_SCANLINES)
+		stopy = MAX_SCANLINES;
+	if (starty >= stopy)
+		return 0;
+
+	/* compute the parameter gradients; degenerate triangles draw nothing */
+	area = (v2->x - v1->x) * (v3->y - v1->y) - (v3->x - v1->x) * (v2->y - v1->y);
+	if (area == 0.0f)
+		return 0;
+	ooarea = 1.0f / area;
+	for (paramnum = 0; paramnum < paramcount; paramnum++)
+	{
+		float dp12 = v2->p[paramnum] - v1->p[paramnum];
+		float dp13 = v3->p[paramnum] - v1->p[paramnum];
+
+		dpdx[paramnum] = (dp12 * (v3->y - v1->y) - dp13 * (v2->y - v1->y)) * ooarea;
+		dpdy[paramnum] = (dp13 * (v2->x - v1->x) - dp12 * (v3->x - v1->x)) * ooarea;
+
+		/* parameter value at the center of pixel (0,0) */
+		porigin[paramnum] = v1->p[paramnum] + (0.5f - v1->x) * dpdx[paramnum] + (0.5f - v1->y) * dpdy[paramnum];
+	}
+
+	/* compute the edge slopes */
+	dxdy_v1v2 = (v2->y == v1->y) ? 0.0f : (v2->x - v1->x) / (v2->y - v1->y);
+	dxdy_v1v3 = (v3->y == v1->y) ? 0.0f : (v3->x - v1->x) / (v3->y - v1->y);
+	dxdy_v2v3 = (v3->y == v2->y) ? 0.0f : (v3->x - v2->x) / (v3->y - v2->y);
+
+	/* walk the scanlines */
+	minx = cliprect->min_x;
+	maxx = cliprect->max_x + 1;
+	for (curscan = starty; curscan < stopy; curscan++)
+	{
+		float fully = (float)curscan + 0.5f;
+		float startx = v1->x + (fully - v1->y) * dxdy_v1v3;
+		float stopx;
+		INT32 istartx, istopx;
+		poly_extent *extent;
+
+		/* start a new work unit at each bucket boundary */
+		if (unit == NULL || (curscan % SCANLINES_PER_BUCKET) == 0)
+			unit = allocate_unit(poly, polygon, curscan);
+		extent = &unit->extent[unit->count++];
+
+		/* compute the X extents; the long edge is always v1->v3 */
+		if (fully < v2->y)
+			stopx = v1->x + (fully - v1->y) * dxdy_v1v2;
+		else
+			stopx = v2->x + (fully - v2->y) * dxdy_v2v3;
+		if (startx > stopx)
+		{
+			float temp = startx;
+			startx = stopx;
+			stopx = temp;
+		}
+
+		/* convert to pixels and clip */
+		if (startx >= (float)maxx || stopx <= (float)minx)
+		{
+			extent->startx = extent->stopx = 0;
+			continue;
+		}
+		istartx = (startx < (float)minx) ? minx : round_coordinate(startx);
+		if (stopx > (float)maxx)
+			istopx = maxx;
+		else if (poly->flags & POLYFLAG_INCLUDE_RIGHT_EDGE)
+			istopx = round_coordinate_inclusive(stopx);
+		else
+			istopx = round_coordinate(stopx);
+		if (istopx > maxx)
+			istopx = maxx;
+		if (istartx >= istopx)
+		{
+			extent->startx = extent->stopx = 0;
+			continue;
+		}
+
+		/* fill in the extent */
+		extent->startx = istartx;
+		extent->stopx = istopx;
+		for (paramnum = 0; paramnum < paramcount; paramnum++)
+		{
+			extent->param[paramnum].start = porigin[paramnum] + (float)istartx * dpdx[paramnum] + (float)curscan * dpdy[paramnum];
+			extent->param[paramnum].dpdx = dpdx[paramnum];
+		}
+		pixels += istopx - istartx;
+	}
+
+	poly->triangles++;
+	poly->pixels += pixels;
+	return pixels;
+}
+
+
+/*-------------------------------------------------
+    poly_render_triangle - render a single
+    triangle given 3 vertexes
+-------------------------------------------------*/
+
+UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int paramcount, const poly_vertex *v1, const poly_vertex *v2, const poly_vertex *v3)
+{
+	float miny = MIN(v1->y, MIN(v2->y, v3->y));
+	float maxy = MAX(v1->y, MAX(v2->y, v3->y));
+	polygon_info *polygon;
+	UINT32 pixels;
+
+	/* reject anything entirely outside the clip */
+	if (maxy < (float)cliprect->min_y || miny > (float)cliprect->max_y + 1.0f)
+		return 0;
+
+	/* set up the polygon and walk it */
+	polygon = allocate_polygon(poly, dest, callback, units_for_rows(cliprect, miny, maxy));
+	pixels = setup_triangle(poly, polygon, cliprect, paramcount, v1, v2, v3);
+
+	/* only consume the polygon if it produced work */
+	if (pixels != 0)
+		poly->polygon_next++;
+	return pixels;
+}
+
+
+/*-------------------------------------------------
+    poly_render_triangle_custom - render an
+    object whose scanline extents were computed
+    by the caller
+-------------------------------------------------*/
+
+UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int startscanline, int numscanlines, const poly_extent *extents)
+{
+	INT32 starty = MAX(startscanline, cliprect->min_y);
+	INT32 stopy = MIN(startscanline + numscanlines, cliprect->max_y + 1);
+	INT32 minx = cliprect->min_x, maxx = cliprect->max_x + 1;
+	polygon_info *polygon;
+	work_unit *unit = NULL;
+	UINT32 pixels = 0;
+	INT32 curscan;
+
+	if (stopy > MAX_SCANLINES)
+		stopy = MAX_SCANLINES;
+	if (starty >= stopy)
+		return 0;
+
+	/* copy the extents into work units, clipping X; the parameters are passed through as-is */
+	polygon = allocate_polygon(poly, dest, callback, (stopy - starty) / SCANLINES_PER_BUCKET + 2);
+	for (curscan = starty; curscan < stopy; curscan++)
+	{
+		const poly_extent *srcextent = &extents[curscan - startscanline];
+		INT32 istartx = MAX(srcextent->startx, minx);
+		INT32 istopx = MIN(srcextent->stopx, maxx);
+		poly_extent *extent;
+
+		if (unit == NULL || (curscan % SCANLINES_PER_BUCKET) == 0)
+			unit = allocate_unit(poly, polygon, curscan);
+		extent = &unit->extent[unit->count++];
+
+		*extent = *srcextent;
+		if (istartx >= istopx)
+			extent->startx = extent->stopx = 0;
+		else
+		{
+			extent->startx = istartx;
+			extent->stopx = istopx;
+			pixels += istopx - istartx;
+		}
+	}
+
+	poly->triangles++;
+	poly->pixels += pixels;
+	if (pixels != 0)
+		poly->polygon_next++;
+	return pixels;
+}
+
+
+/*-------------------------------------------------
+    poly_render_triangle_fan - render a set of
+    triangles in a fan
+-------------------------------------------------*/
+
+UINT32 poly_render_triangle_fan(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int paramcount, int numverts, const poly_vertex *v)
+{
+	return poly_render_polygon(poly, dest, cliprect, callback, paramcount, numverts, v);
+}
+
+
+
+/***************************************************************************
+    CORE QUAD/POLYGON RENDERING
+***************************************************************************/
+
+/*-------------------------------------------------
+    poly_render_quad - render a single quad
+    given 4 vertexes
+-------------------------------------------------*/
+
+UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int paramcount, const poly_vertex *v1, const poly_vertex *v2, const poly_vertex *v3, const poly_vertex *v4)
+{
+	poly_vertex v[4];
+
+	v[0] = *v1;
+	v[1] = *v2;
+	v[2] = *v3;
+	v[3] = *v4;
+	return poly_render_polygon(poly, dest, cliprect, callback, paramcount, 4, v);
+}
+
+
+/*-------------------------------------------------
+    poly_render_polygon - render a convex polygon
+    as a fan of triangles sharing one polygon
+-------------------------------------------------*/
+
+UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int paramcount, int numverts, const poly_vertex *v)
+{
+	float miny, maxy;
+	polygon_info *polygon;
+	UINT32 pixels = 0;
+	int vertnum;
+
+	assert_always(numverts <= MAX_POLYGON_VERTS, "Too many vertices in poly_render_polygon");
+	if (numverts < 3)
+		return 0;
+
+	/* compute the Y range of the whole polygon */
+	miny = maxy = v[0].y;
+	for (vertnum = 1; vertnum < numverts; vertnum++)
+	{
+		if (v[vertnum].y < miny) miny = v[vertnum].y;
+		if (v[vertnum].y > maxy) maxy = v[vertnum].y;
+	}
+	if (maxy < (float)cliprect->min_y || miny > (float)cliprect->max_y + 1.0f)
+		return 0;
+
+	/* each triangle in the fan may need its own units in every bucket */
+	polygon = allocate_polygon(poly, dest, callback, (numverts - 2) * units_for_rows(cliprect, miny, maxy));
+	for (vertnum = 2; vertnum < numverts; vertnum++)
+		pixels += setup_triangle(poly, polygon, cliprect, paramcount, &v[0], &v[vertnum - 1], &v[vertnum]);
+
+	if (pixels != 0)
+		poly->polygon_next++;
+	return pixels;
+}
+
+
+
+/***************************************************************************
+    CLIPPING
+***************************************************************************/
+
+/*-------------------------------------------------
+    poly_zclip_if_less - clip a polygon using p[0]
+    as a Z coordinate
+-------------------------------------------------*/
+
+int poly_zclip_if_less(int numverts, const poly_vertex *v, poly_vertex *outv, int paramcount, float clipval)
+{
+	int prevclipped = (v[numverts - 1].p[0] < clipval);
+	poly_vertex *nextout = outv;
+	int vertnum;
+
+	/* iterate over vertices */
+	for (vertnum = 0; vertnum < numverts; vertnum++)
+	{
+		int thisclipped = (v[vertnum].p[0] < clipval);
+
+		/* if we switched from clipped to non-clipped, interpolate a vertex */
+		if (thisclipped != prevclipped)
+		{
+			const poly_vertex *v1 = &v[(vertnum == 0) ? (numverts - 1) : (vertnum - 1)];
+			const poly_vertex *v2 = &v[vertnum];
+			float frac = (clipval - v1->p[0]) / (v2->p[0] - v1->p[0]);
+			int paramnum;
+
+			nextout->x = v1->x + frac * (v2->x - v1->x);
+			nextout->y = v1->y + frac * (v2->y - v1->y);
+			for (paramnum = 0; paramnum < paramcount; paramnum++)
+				nextout->p[paramnum] = v1->p[paramnum] + frac * (v2->p[paramnum] - v1->p[paramnum]);
+			nextout++;
+		}
+
+		/* if this vertex is not clipped, copy it in */
+		if (!thisclipped)
+			*nextout++ = v[vertnum];
+
+		/* remember the last state */
+		prevclipped = thisclipped;
+	}
+	return nextout - outv;
+}
+
+
+
+/***************************************************************************
+    WORK ITEM CALLBACK
+***************************************************************************/
+
+/*-------------------------------------------------
+    poly_item_callback - draw all the work units
+    in one bucket, in submission order
+-------------------------------------------------*/
+
+static void *poly_item_callback(void *param)
+{
+	const poly_bucket *bucket = param;
+	const work_unit *unit;
+
+	for (unit = bucket->head; unit != NULL; unit = unit->next)
+	{
+		const polygon_info *polygon = unit->polygon;
+		int linenum;
+
+		for (linenum = 0; linenum < unit->count; linenum++)
+			if (unit->extent[linenum].startx < unit->extent[linenum].stopx)
+				(*polygon->callback)(polygon->dest, unit->scanline + linenum, &unit->extent[linenum], polygon->extra);
+	}
+	return NULL;
+}
@@ -0,0 +1,154 @@
+/***************************************************************************
+
+    polynew.h
+
+    Helper routines for polygon rendering.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************
+
+    This module performs the setup side of polygon rendering: it walks
+    the edges of triangles, quads and convex polygons, computes the
+    horizontal extent of each covered scanline, and computes the start
+    value and per-pixel delta of up to MAX_VERTEX_PARAMS interpolated
+    parameters at the left edge of each extent. The actual pixel work is
+    done by a driver-provided scanline callback.
+
+    Rendering is deferred: each call to poly_render_*() bins the
+    scanlines of the polygon into buckets of SCANLINES_PER_BUCKET rows.
+    When poly_wait() is called (or internal storage fills up), each
+    bucket is handed to the OSD work queue as a separate work item.
+    Polygons within a bucket are always drawn in the order they were
+    submitted, and no two work items ever touch the same scanline, so
+    drivers get the same results as drawing serially.
+
+    Because the callbacks run later and on other threads, anything they
+    read must stay put until poly_wait() returns. Per-polygon state such
+    as texture bases or colors belongs in the extra data block, which is
+    obtained via poly_get_extra_data() before each poly_render_*() call.
+
+    Drivers with their own edge rules can compute the extents themselves
+    and submit them with poly_render_triangle_custom(); they still get
+    the bucketing and the work queue.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __POLYNEW_H__
+#define __POLYNEW_H__
+
+#include "mamecore.h"
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define MAX_VERTEX_PARAMS					6
+#define MAX_POLYGON_VERTS					32
+
+#define POLYFLAG_INCLUDE_BOTTOM_EDGE		0x01
+#define POLYFLAG_INCLUDE_RIGHT_EDGE			0x02
+#define POLYFLAG_NO_WORK_QUEUE				0x04
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* opaque reference to the poly manager */
+typedef struct _poly_manager poly_manager;
+
+
+/* input vertex data */
+typedef struct _poly_vertex poly_vertex;
+struct _poly_vertex
+{
+	float		x;							/* X coordinate */
+	float		y;							/* Y coordinate */
+	float		p[MAX_VERTEX_PARAMS];		/* interpolated parameter values */
+};
+
+
+/* poly_param_extent describes information for a single parameter in an extent */
+typedef struct _poly_param_extent poly_param_extent;
+struct _poly_param_extent
+{
+	float		start;						/* parameter value at starting X,Y */
+	float		dpdx;						/* dp/dx relative to starting X */
+};
+
+
+/* poly_extent describes start/end points for a scanline, along with per-scanline parameters */
+typedef struct _poly_extent poly_extent;
+struct _poly_extent
+{
+	INT16		startx;						/* starting X coordinate (inclusive) */
+	INT16		stopx;						/* ending X coordinate (exclusive) */
+	poly_param_extent param[MAX_VERTEX_PARAMS]; /* starting and dx values for each parameter */
+};
+
+
+/* callback routine to process a batch of scanlines in a triangle */
+typedef void (*poly_draw_scanline_func)(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata);
+
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+/* ----- initialization/teardown ----- */
+
+/* allocate a new poly manager that can render polygons */
+poly_manager *poly_alloc(int max_polys, size_t extra_data_size, UINT8 flags);
+
+/* free a poly manager */
+void poly_free(poly_manager *poly);
+
+
+
+/* ----- common functions ----- */
+
+/* flush all queued polygons and wait for them to be drawn */
+void poly_wait(poly_manager *poly, const char *debug_reason);
+
+/* get a pointer to the extra data for the next polygon */
+void *poly_get_extra_data(poly_manager *poly);
+
+
+
+/* ----- core triangle rendering ----- */
+
+/* render a single triangle given 3 vertexes */
+UINT32 poly_render_triangle(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int paramcount, const poly_vertex *v1, const poly_vertex *v2, const poly_vertex *v3);
+
+/* render an object whose scanline extents were computed by the caller */
+UINT32 poly_render_triangle_custom(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int startscanline, int numscanlines, const poly_extent *extents);
+
+/* render a set of triangles in a fan */
+UINT32 poly_render_triangle_fan(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int paramcount, int numverts, const poly_vertex *v);
+
+
+
+/* ----- core quad/polygon rendering ----- */
+
+/* render a single quad given 4 vertexes */
+UINT32 poly_render_quad(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int paramcount, const poly_vertex *v1, const poly_vertex *v2, const poly_vertex *v3, const poly_vertex *v4);
+
+/* render a convex polygon of up to MAX_POLYGON_VERTS vertexes */
+UINT32 poly_render_polygon(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int paramcount, int numverts, const poly_vertex *v);
+
+
+
+/* ----- clipping ----- */
+
+/* zclip (assumes p[0] == z) a polygon; returns the number of output vertexes */
+int poly_zclip_if_less(int numverts, const poly_vertex *v, poly_vertex *outv, int paramcount, float clipval);
+
+
+#endif	/* __POLYNEW_H__ */
@@ -178,7 +178,10 @@ static tms34010_config tms_config =
 	midxunit_scanline_update,		/* scanline updater */
 	NULL,							/* generate interrupt */
 	midtunit_to_shiftreg,			/* write to shiftreg function */
-	midtunit_from_shiftreg			/* read from shiftreg function */
+	midtunit_from_shiftreg,			/* read from shiftreg function */
+	0x00000000, 0x003fffff,			/* VRAM mapped through handlers */
+	midtunit_vram_data_r,			/* VRAM read handler */
+	midtunit_vram_data_w			/* VRAM write handler */
 };
 
 
@@ -861,7 +861,10 @@ static tms34010_config zunit_tms_config =
 	midyunit_scanline_update,		/* scanline updater */
 	NULL,							/* generate interrupt */
 	midyunit_to_shiftreg,			/* write to shiftreg function */
-	midyunit_from_shiftreg			/* read from shiftreg function */
+	midyunit_from_shiftreg,			/* read from shiftreg function */
+	0x00000000, 0x001fffff,			/* VRAM mapped through handlers */
+	midyunit_vram_r,				/* VRAM read handler */
+	midyunit_vram_w					/* VRAM write handler */
 };
 
 static tms34010_config yunit_tms_config =
@@ -873,7 +876,10 @@ static tms34010_config yunit_tms_config =
 	midyunit_scanline_update,		/* scanline updater */
 	NULL,							/* generate interrupt */
 	midyunit_to_shiftreg,			/* write to shiftreg function */
-	midyunit_from_shiftreg			/* read from shiftreg function */
+	midyunit_from_shiftreg,			/* read from shiftreg function */
+	0x00000000, 0x001fffff,			/* VRAM mapped through handlers */
+	midyunit_vram_r,				/* VRAM read handler */
+	midyunit_vram_w					/* VRAM write handler */
 };
 
 
@@ -2090,11 +2090,24 @@ static READ32_HANDLER( stv_sh2_random_r )
 	return 0xffffffff;
 }
 
+/* the work RAMs are written by the SCU DMA as well as the SH-2s, so tell the SH-2 core about every write */
+static WRITE32_HANDLER( stv_workram_l_w )
+{
+	COMBINE_DATA(&stv_workram_l[offset]);
+	sh2_notify_code_write(0x00200000 + offset * 4);
+}
+
+static WRITE32_HANDLER( stv_workram_h_w )
+{
+	COMBINE_DATA(&stv_workram_h[offset]);
+	sh2_notify_code_write(0x06000000 + offset * 4);
+}
+
 static ADDRESS_MAP_START( stv_mem, ADDRESS_SPACE_PROGRAM, 32 )
 	AM_RANGE(0x00000000, 0x0007ffff) AM_ROM   // bios
 	AM_RANGE(0x00100000, 0x0010007f) AM_READWRITE(stv_SMPC_r32, stv_SMPC_w32)
 	AM_RANGE(0x00180000, 0x0018ffff) AM_RAM AM_SHARE(1) AM_BASE(&stv_backupram)
-	AM_RANGE(0x00200000, 0x002fffff) AM_RAM AM_MIRROR(0x100000) AM_SHARE(2) AM_BASE(&stv_workram_l)
+	AM_RANGE(0x00200000, 0x002fffff) AM_READWRITE(MRA32_RAM, stv_workram_l_w) AM_MIRROR(0x100000) AM_SHARE(2) AM_BASE(&stv_workram_l)
 	AM_RANGE(0x00400000, 0x0040001f) AM_READWRITE(stv_io_r32, stv_io_w32) AM_BASE(&ioga) AM_SHARE(4) AM_MIRROR(0x20)
 	AM_RANGE(0x01000000, 0x01000003) AM_WRITE(minit_w)
 	AM_RANGE(0x01406f40, 0x01406f43) AM_WRITE(minit_w) // prikura seems to write here ..
@@ -2118,7 +2131,7 @@ static ADDRESS_MAP_START( stv_mem, ADDRESS_SPACE_PROGRAM, 32 )
 	AM_RANGE(0x05f00000, 0x05f7ffff) AM_READWRITE(stv_vdp2_cram_r, stv_vdp2_cram_w)
 	AM_RANGE(0x05f80000, 0x05fbffff) AM_READWRITE(stv_vdp2_regs_r, stv_vdp2_regs_w)
 	AM_RANGE(0x05fe0000, 0x05fe00cf) AM_READWRITE(stv_scu_r32, stv_scu_w32)
-	AM_RANGE(0x06000000, 0x060fffff) AM_RAM AM_MIRROR(0x01f00000) AM_SHARE(3) AM_BASE(&stv_workram_h)
+	AM_RANGE(0x06000000, 0x060fffff) AM_READWRITE(MRA32_RAM, stv_workram_h_w) AM_MIRROR(0x01f00000) AM_SHARE(3) AM_BASE(&stv_workram_h)
 ADDRESS_MAP_END
 
 static ADDRESS_MAP_START( sound_mem, ADDRESS_SPACE_PROGRAM, 16 )
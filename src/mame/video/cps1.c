@@ -616,6 +616,8 @@ static UINT16 *cps1_old_palette;
 
 /* Working variables */
 static int cps1_last_sprite_offset;     /* Offset of the last sprite */
+static gfx_sprite cps1_sprite_batch[0x400];	/* sprite tiles waiting for drawgfx_list() */
+static int cps1_sprite_batch_count;
 static int cps1_stars_enabled[2];          /* Layer enabled [Y/N] */
 
 tilemap *cps1_bg_tilemap[3];
@@ -1299,24 +1301,34 @@ static void cps1_find_last_sprite(void)    /* Find the offset of last sprite */
 }
 
 
+static void cps1_flush_sprites(running_machine *machine, mame_bitmap *bitmap, const rectangle *cliprect)
+{
+	drawgfx_list(bitmap,machine->gfx[2],cps1_sprite_batch,cps1_sprite_batch_count,
+			cliprect,TRANSPARENCY_PEN,15,DRAWGFX_LIST_PRIORITY);
+	cps1_sprite_batch_count = 0;
+}
+
+
 static void cps1_render_sprites(running_machine *machine, mame_bitmap *bitmap, const rectangle *cliprect)
 {
 #define DRAWSPRITE(CODE,COLOR,FLIPX,FLIPY,SX,SY)					\
 {																	\
+	if (cps1_sprite_batch_count == ARRAY_LENGTH(cps1_sprite_batch))	\
+		cps1_flush_sprites(machine,bitmap,cliprect);				\
 	if (flip_screen)												\
-		pdrawgfx(bitmap,machine->gfx[2],							\
+		gfx_sprite_set(&cps1_sprite_batch[cps1_sprite_batch_count++],	\
 				CODE,												\
 				COLOR,												\
 				!(FLIPX),!(FLIPY),									\
 				511-16-(SX),255-16-(SY),							\
-				cliprect,TRANSPARENCY_PEN,15,0x02);					\
+				0x02);												\
 	else															\
-		pdrawgfx(bitmap,machine->gfx[2],							\
+		gfx_sprite_set(&cps1_sprite_batch[cps1_sprite_batch_count++],	\
 				CODE,												\
 				COLOR,												\
 				FLIPX,FLIPY,										\
 				SX,SY,												\
-				cliprect,TRANSPARENCY_PEN,15,0x02);					\
+				0x02);												\
 }
 
 
@@ -1457,6 +1469,7 @@ static void cps1_render_sprites(running_machine *machine, mame_bitmap *bitmap, c
 		}
 		base += baseadd;
 	}
+	cps1_flush_sprites(machine,bitmap,cliprect);
 #undef DRAWSPRITE
 }
 
@@ -1546,20 +1559,22 @@ static void cps2_render_sprites(running_machine *machine, mame_bitmap *bitmap,co
 {
 #define DRAWSPRITE(CODE,COLOR,FLIPX,FLIPY,SX,SY)									\
 {																					\
+	if (cps1_sprite_batch_count == ARRAY_LENGTH(cps1_sprite_batch))					\
+		cps1_flush_sprites(machine,bitmap,cliprect);								\
 	if (flip_screen)																\
-		pdrawgfx(bitmap,machine->gfx[2],											\
+		gfx_sprite_set(&cps1_sprite_batch[cps1_sprite_batch_count++],				\
 				CODE,																\
 				COLOR,																\
 				!(FLIPX),!(FLIPY),													\
 				511-16-(SX),255-16-(SY),											\
-				cliprect,TRANSPARENCY_PEN,15,primasks[priority]);					\
+				primasks[priority]);												\
 	else																			\
-		pdrawgfx(bitmap,machine->gfx[2],											\
+		gfx_sprite_set(&cps1_sprite_batch[cps1_sprite_batch_count++],				\
 				CODE,																\
 				COLOR,																\
 				FLIPX,FLIPY,														\
 				SX,SY,																\
-				cliprect,TRANSPARENCY_PEN,15,primasks[priority]);					\
+				primasks[priority]);												\
 }
 
 	int i;
@@ -1684,6 +1699,7 @@ static void cps2_render_sprites(running_machine *machine, mame_bitmap *bitmap,co
 					(x+xoffs) & 0x3ff,(y+yoffs) & 0x3ff);
 		}
 	}
+	cps1_flush_sprites(machine,bitmap,cliprect);
 }
 
 
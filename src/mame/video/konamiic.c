@@ -4131,9 +4131,10 @@ void K053247_sprites_draw(running_machine *machine, mame_bitmap *bitmap,const re
 	static int yoffset[8] = { 0, 2, 8, 10, 32, 34, 40, 42 };
 
 	int sortedlist[NUM_SPRITES];
+	gfx_sprite tiles[8*8*2];
 	int offs,zcode;
 	int ox,oy,color,code,size,w,h,x,y,xa,ya,flipx,flipy,mirrorx,mirrory,shadow,zoomx,zoomy,primask;
-	int shdmask,nozoom,count,temp;
+	int shdmask,nozoom,count,temp,tilecount;
 
 	int flipscreenx = K053246_regs[5] & 0x01;
 	int flipscreeny = K053246_regs[5] & 0x02;
@@ -4367,6 +4368,7 @@ void K053247_sprites_draw(running_machine *machine, mame_bitmap *bitmap,const re
 		ox -= (zoomx * w) >> 13;
 		oy -= (zoomy * h) >> 13;
 
+		tilecount = 0;
 		for (y = 0;y < h;y++)
 		{
 			int sx,sy,zw,zh;
@@ -4376,6 +4378,7 @@ void K053247_sprites_draw(running_machine *machine, mame_bitmap *bitmap,const re
 
 			for (x = 0;x < w;x++)
 			{
+				gfx_sprite *tile;
 				int c,fx,fy;
 
 				sx = ox + ((zoomx * x + (1<<11)) >> 12);
@@ -4422,51 +4425,28 @@ void K053247_sprites_draw(running_machine *machine, mame_bitmap *bitmap,const re
 					fy = flipy;
 				}
 
-				if (nozoom)
-				{
-					pdrawgfx(bitmap,K053247_gfx,
-							c,
-							color,
-							fx,fy,
-							sx,sy,
-							cliprect,shadow ? TRANSPARENCY_PEN_TABLE : TRANSPARENCY_PEN,0,primask);
-				}
-				else
-				{
-					pdrawgfxzoom(bitmap,K053247_gfx,
-							c,
-							color,
-							fx,fy,
-							sx,sy,
-							cliprect,shadow ? TRANSPARENCY_PEN_TABLE : TRANSPARENCY_PEN,0,
-							(zw << 16) >> 4,(zh << 16) >> 4,primask);
-				}
+				tile = &tiles[tilecount++];
+				tile->code = c;
+				tile->color = color;
+				tile->sx = sx;
+				tile->sy = sy;
+				tile->flipx = (fx != 0);
+				tile->flipy = (fy != 0);
+				tile->scalex = nozoom ? 0x10000 : (zw << 16) >> 4;
+				tile->scaley = nozoom ? 0x10000 : (zh << 16) >> 4;
+				tile->priority_mask = primask;
 
 				if (mirrory && h == 1)  /* Simpsons shadows */
 				{
-					if (nozoom)
-					{
-						pdrawgfx(bitmap,K053247_gfx,
-								c,
-								color,
-								fx,!fy,
-								sx,sy,
-								cliprect,shadow ? TRANSPARENCY_PEN_TABLE : TRANSPARENCY_PEN,0,primask);
-					}
-					else
-					{
-						pdrawgfxzoom(bitmap,K053247_gfx,
-								c,
-								color,
-								fx,!fy,
-								sx,sy,
-								cliprect,shadow ? TRANSPARENCY_PEN_TABLE : TRANSPARENCY_PEN,0,
-								(zw << 16) >> 4,(zh << 16) >> 4,primask);
-					}
+					tiles[tilecount] = *tile;
+					tiles[tilecount++].flipy = !tile->flipy;
 				}
 			} // end of X loop
 		} // end of Y loop
 
+		drawgfx_list(bitmap,K053247_gfx,tiles,tilecount,
+				cliprect,shadow ? TRANSPARENCY_PEN_TABLE : TRANSPARENCY_PEN,0,DRAWGFX_LIST_PRIORITY);
+
 		// reset drawmode_table
 		if (shadow == -1) for (temp=1; temp<solidpens; temp++) gfx_drawmode_table[temp] = DRAWMODE_SOURCE;
 
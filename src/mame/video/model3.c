@@ -1,5 +1,6 @@
 #include "driver.h"
 #include "video/poly.h"
+#include "video/polynew.h"
 #include <math.h>
 
 
@@ -38,6 +39,25 @@ typedef struct
 #define TRI_PARAM_TEXTURE_ENABLE		0x8
 
 #define MAX_TRIANGLES		131072
+#define MAX_SCANLINES		65536
+
+/* per-polygon state handed to the scanline renderers */
+typedef struct
+{
+	const struct poly_scanline *scanline;	/* fixed-point start values, from row sy on */
+	INT32 sy;
+	INT64 dp[3];
+	const UINT16 *texture;
+	int texture_x, texture_y;
+	UINT32 texture_width_mask, texture_height_mask;
+	const int *texture_u_table;
+	const int *texture_v_table;
+	int texture_coord_shift;
+	int transparency;
+	int intensity;
+	UINT32 viewport_priority;
+	UINT16 color;
+} m3_poly_extra_data;
 
 
 /* forward declarations */
@@ -90,6 +110,9 @@ static mame_bitmap *bitmap3d;
 static mame_bitmap *zbuffer;
 static rectangle clip3d;
 static rectangle *screen_clip;
+static poly_manager *poly;
+static struct poly_scanline *scanline_buffer;
+static int scanline_buffer_ptr;
 
 
 static TRIANGLE* triangle_buffer;
@@ -118,10 +141,19 @@ static int list_depth = 0;
 
 
 
+static void model3_exit(running_machine *machine)
+{
+	poly_free(poly);
+}
+
 VIDEO_START( model3 )
 {
 	int j,t;
 
+	poly = poly_alloc(4000, sizeof(m3_poly_extra_data), 0);
+	add_exit_callback(machine, model3_exit);
+	scanline_buffer = auto_malloc(MAX_SCANLINES * sizeof(scanline_buffer[0]));
+
 	bitmap3d = auto_bitmap_alloc(machine->screen[0].width, machine->screen[0].height, machine->screen[0].format);
 	zbuffer = auto_bitmap_alloc(machine->screen[0].width, machine->screen[0].height, BITMAP_FORMAT_INDEXED32);
 
@@ -867,19 +899,8 @@ INLINE void push_triangle(int alpha, TRIANGLE *tri)
 	}
 }
 
-static int texture_x;
-static int texture_y;
-static int texture_width;
-static int texture_height;
-static UINT32 texture_width_mask;
-static UINT32 texture_height_mask;
-static int texture_page;
 static int texture_coord_shift = 16;
 static int polygon_transparency = 0;
-static int polygon_intensity = 0;
-
-static int* texture_u_table;
-static int* texture_v_table;
 
 static UINT32 viewport_priority;
 
@@ -1178,6 +1199,103 @@ static void draw_model(UINT32 *model)
 	};
 }
 
+static m3_poly_extra_data *setup_poly_extra(const TRIANGLE *tri)
+{
+	m3_poly_extra_data *extra = poly_get_extra_data(poly);
+
+	extra->transparency			= tri->transparency;
+	extra->intensity			= tri->intensity;
+	extra->viewport_priority	= tri->viewport_priority;
+	extra->texture_coord_shift	= tri->texture_coord_shift;
+	extra->color				= tri->color;
+
+	if (tri->param & TRI_PARAM_TEXTURE_ENABLE)
+	{
+		extra->texture				= texture_ram[(tri->param & TRI_PARAM_TEXTURE_PAGE) ? 1 : 0];
+		extra->texture_x			= tri->texture_x * 32;
+		extra->texture_y			= tri->texture_y * 32;
+		extra->texture_width_mask	= ((32 << tri->texture_width) << 1) - 1;
+		extra->texture_height_mask	= ((32 << tri->texture_height) << 1) - 1;
+
+		if (tri->param & TRI_PARAM_TEXTURE_MIRROR_U)
+			extra->texture_u_table = texture_mirror_table[tri->texture_width];
+		else
+			extra->texture_u_table = texture_wrap_table[tri->texture_width];
+
+		if (tri->param & TRI_PARAM_TEXTURE_MIRROR_V)
+			extra->texture_v_table = texture_mirror_table[tri->texture_height];
+		else
+			extra->texture_v_table = texture_wrap_table[tri->texture_height];
+	}
+	return extra;
+}
+
+static void render_triangle(const TRIANGLE *tri, poly_draw_scanline_func callback)
+{
+	static poly_extent extents[MAX_POLY_SCANLINES];
+	struct poly_vertex vert[3];
+	const struct poly_scanline_data *scans;
+	m3_poly_extra_data *extra;
+	int i, numscans;
+
+	/* interpolate 1/z, u/z and v/z in fixed point; the renderers divide back per pixel */
+	for (i = 0; i < 3; i++)
+	{
+		VERTEX v = tri->v[i];
+
+		v.z = (1.0 / v.z) * ZBUFFER_SCALE;
+		vert[i].x = v.x;
+		vert[i].y = v.y;
+		vert[i].p[0] = (UINT32)v.z;
+		if (tri->param & TRI_PARAM_TEXTURE_ENABLE)
+		{
+			vert[i].p[1] = (UINT32)((UINT64)(v.u * v.z) >> ZDIVIDE_SHIFT);
+			vert[i].p[2] = (UINT32)((UINT64)(v.v * v.z) >> ZDIVIDE_SHIFT);
+		}
+		else
+			vert[i].p[1] = vert[i].p[2] = 0;
+	}
+
+	if (tri->param & TRI_PARAM_TEXTURE_ENABLE)
+		scans = setup_triangle_3(&vert[0], &vert[1], &vert[2], &clip3d);
+	else
+		scans = setup_triangle_1(&vert[0], &vert[1], &vert[2], &clip3d);
+	if (scans == NULL || scans->ey < scans->sy)
+		return;
+	numscans = scans->ey - scans->sy + 1;
+
+	/* the scanline data must stay put until the renderers are done with it */
+	if (scanline_buffer_ptr + numscans > MAX_SCANLINES)
+	{
+		poly_wait(poly, "Out of scanlines");
+		scanline_buffer_ptr = 0;
+	}
+
+	extra = setup_poly_extra(tri);
+	extra->scanline = &scanline_buffer[scanline_buffer_ptr];
+	extra->sy = scans->sy;
+	extra->dp[0] = scans->dp[0];
+	extra->dp[1] = scans->dp[1];
+	extra->dp[2] = scans->dp[2];
+
+	for (i = 0; i < numscans; i++)
+	{
+		const struct poly_scanline *scan = &scans->scanline[i];
+
+		scanline_buffer[scanline_buffer_ptr + i] = *scan;
+		if (scan->sx > scan->ex)
+			extents[i].startx = extents[i].stopx = 0;
+		else
+		{
+			extents[i].startx = scan->sx;
+			extents[i].stopx = scan->ex + 1;
+		}
+	}
+	scanline_buffer_ptr += numscans;
+
+	poly_render_triangle_custom(poly, bitmap3d, &clip3d, callback, scans->sy, numscans, extents);
+}
+
 static void render_triangles(void)
 {
 	int i;
@@ -1188,48 +1306,15 @@ static void render_triangles(void)
 
 		if (tri->param & TRI_PARAM_TEXTURE_ENABLE)
 		{
-			texture_x			= tri->texture_x * 32;
-			texture_y 			= tri->texture_y * 32;
-			texture_page		= (tri->param & TRI_PARAM_TEXTURE_PAGE) ? 1 : 0;
-			texture_width		= 32 << tri->texture_width;
-			texture_height		= 32 << tri->texture_height;
-			texture_width_mask	= (texture_width << 1) - 1;
-			texture_height_mask	= (texture_height << 1) - 1;
-			polygon_intensity	= tri->intensity;
-			viewport_priority	= tri->viewport_priority;
-			texture_coord_shift	= tri->texture_coord_shift;
-
-			if (tri->param & TRI_PARAM_TEXTURE_MIRROR_U)
-			{
-				texture_u_table = texture_mirror_table[tri->texture_width];
-			}
-			else
-			{
-				texture_u_table = texture_wrap_table[tri->texture_width];
-			}
-
-			if (tri->param & TRI_PARAM_TEXTURE_MIRROR_V)
-			{
-				texture_v_table = texture_mirror_table[tri->texture_height];
-			}
-			else
-			{
-				texture_v_table = texture_wrap_table[tri->texture_height];
-			}
-
 			switch (tri->texture_format)
 			{
-				case 0:	draw_triangle_tex1555(tri->v[0], tri->v[1], tri->v[2]); break;	/* ARGB1555 */
-				case 7:	draw_triangle_tex4444(tri->v[0], tri->v[1], tri->v[2]); break;	/* ARGB4444 */
+				case 0:	render_triangle(tri, draw_scanline_tex1555); break;	/* ARGB1555 */
+				case 7:	render_triangle(tri, draw_scanline_tex4444); break;	/* ARGB4444 */
 			}
 		}
 		else
 		{
-			polygon_intensity	= tri->intensity;
-			viewport_priority	= tri->viewport_priority;
-			texture_coord_shift	= tri->texture_coord_shift;
-
-			draw_triangle_color(tri->v[0], tri->v[1], tri->v[2], tri->color);
+			render_triangle(tri, draw_scanline_color);
 		}
 	}
 
@@ -1240,68 +1325,36 @@ static void render_triangles(void)
 
 		if (tri->param & TRI_PARAM_TEXTURE_ENABLE)
 		{
-			texture_x			= tri->texture_x * 32;
-			texture_y 			= tri->texture_y * 32;
-			texture_page		= (tri->param & TRI_PARAM_TEXTURE_PAGE) ? 1 : 0;
-			texture_width		= 32 << tri->texture_width;
-			texture_height		= 32 << tri->texture_height;
-			texture_width_mask	= (texture_width << 1) - 1;
-			texture_height_mask	= (texture_height << 1) - 1;
-			polygon_transparency = tri->transparency;
-			polygon_intensity	= tri->intensity;
-			viewport_priority	= tri->viewport_priority;
-			texture_coord_shift	= tri->texture_coord_shift;
-
-			if (tri->param & TRI_PARAM_TEXTURE_MIRROR_U)
-			{
-				texture_u_table = texture_mirror_table[tri->texture_width];
-			}
-			else
-			{
-				texture_u_table = texture_wrap_table[tri->texture_width];
-			}
-
-			if (tri->param & TRI_PARAM_TEXTURE_MIRROR_V)
-			{
-				texture_v_table = texture_mirror_table[tri->texture_height];
-			}
-			else
-			{
-				texture_v_table = texture_wrap_table[tri->texture_height];
-			}
-
 			switch (tri->texture_format)
 			{
 				case 0:		/* ARGB1555 */
 				{
 					if (tri->transparency < 32)
 					{
-						draw_triangle_tex1555_trans(tri->v[0], tri->v[1], tri->v[2]);
+						render_triangle(tri, draw_scanline_tex1555_trans);
 					}
 					else
 					{
-						draw_triangle_tex1555_alpha(tri->v[0], tri->v[1], tri->v[2]);
+						render_triangle(tri, draw_scanline_tex1555_alpha);
 					}
 					break;
 				}
 
 				case 7:		/* ARGB4444 */
 				{
-					draw_triangle_tex4444_alpha(tri->v[0], tri->v[1], tri->v[2]);
+					render_triangle(tri, draw_scanline_tex4444_alpha);
 					break;
 				}
 			}
 		}
 		else
 		{
-			polygon_transparency = tri->transparency;
-			polygon_intensity	= tri->intensity;
-			viewport_priority	= tri->viewport_priority;
-			texture_coord_shift	= tri->texture_coord_shift;
-
-			draw_triangle_color_trans(tri->v[0], tri->v[1], tri->v[2], tri->color);
+			render_triangle(tri, draw_scanline_color_trans);
 		}
 	}
+
+	poly_wait(poly, "render_triangles");
+	scanline_buffer_ptr = 0;
 }
 
 /*****************************************************************************/
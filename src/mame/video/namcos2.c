@@ -352,6 +352,7 @@ VIDEO_UPDATE( namcos2_default )
 
 	/* HACK: enable ROZ layer only if it has priority > 0 */
 	tilemap_set_enable(tilemap_roz,(namcos2_gfx_ctrl & 0x7000) ? 1 : 0);
+	tilemap_prerender(ALL_TILEMAPS);
 
 	for( pri=0; pri<16; pri++ )
 	{
@@ -384,6 +385,7 @@ VIDEO_UPDATE( finallap )
 	int pri;
 
 	UpdatePalette();
+	tilemap_prerender(ALL_TILEMAPS);
 	fillbitmap( bitmap, get_black_pen(machine), cliprect );
 	ApplyClip( &clip, cliprect );
 
@@ -421,6 +423,7 @@ VIDEO_UPDATE( luckywld )
 	int pri;
 
 	UpdatePalette();
+	tilemap_prerender(ALL_TILEMAPS);
 	fillbitmap( bitmap, get_black_pen(machine), cliprect );
 	ApplyClip( &clip, cliprect );
 
@@ -454,6 +457,7 @@ VIDEO_UPDATE( sgunner )
 	int pri;
 
 	UpdatePalette();
+	tilemap_prerender(ALL_TILEMAPS);
 	fillbitmap( bitmap, get_black_pen(machine), cliprect );
 	ApplyClip( &clip, cliprect );
 
@@ -480,6 +484,7 @@ VIDEO_UPDATE( metlhawk )
 	int pri;
 
 	UpdatePalette();
+	tilemap_prerender(ALL_TILEMAPS);
 	fillbitmap( bitmap, get_black_pen(machine), cliprect );
 	ApplyClip( &clip, cliprect );
 
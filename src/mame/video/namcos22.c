@@ -35,6 +35,7 @@ SPOT TABLE test
 
 #include "driver.h"
 #include "namcos22.h"
+#include "video/polynew.h"
 #include <math.h>
 
 static int mbSuperSystem22; /* used to conditionally support Super System22-specific features */
@@ -217,13 +218,19 @@ typedef struct
 	float u,v,i,z;
 } vertex;
 
+/* per-polygon state handed to renderscanline_uvi_full */
 typedef struct
 {
-	float x;
-	float u,v,i,z;
-} edge;
+	const pen_t *pens;
+	int bn;
+	int cmode;
+	int prioverchar;
+	int fogDisable;
+	int fogDensity;
+	int fadeEnable;
+} poly_extra_data;
 
-#define SWAP(A,B) { const void *temp = A; A = B; B = temp; }
+static poly_manager *poly;
 
 static UINT16 *mpTextureTileMap16;
 static UINT8 *mpTextureTileMapAttr;
@@ -237,184 +244,123 @@ INLINE unsigned texel( unsigned x, unsigned y )
 	return mpTextureTileData[(tile<<8)|mXYAttrToPixel[mpTextureTileMapAttr[offs]][x&0xf][y&0xf]];
 } /* texel */
 
-typedef void drawscanline_t(
-	mame_bitmap *bitmap,
-	const rectangle *clip,
-	const edge *e1,
-	const edge *e2,
-	int sy );
-
-static void renderscanline_uvi_full(running_machine *machine, mame_bitmap *bitmap, const rectangle *clip, const edge *e1, const edge *e2, int sy, int color, int bn, UINT16 flags, int cmode )
-{
-	int fadeEnable = (mixer.target&1) && mixer.fadeFactor;
-	int fogDisable = color&0x80;
-	const pen_t *pens = &machine->pens[(color&0x7f)<<8];
-   int fogDensity = 0;
-	int prioverchar = (cmode&7)==1;
-
-	if( e1->x > e2->x )
+/* called back from the poly manager; mixer and priority_bitmap stay put until poly_wait() */
+static void renderscanline_uvi_full(void *destbase, INT32 scanline, const poly_extent *extent, const void *extradata)
+{
+	const poly_extra_data *extra = extradata;
+	const pen_t *pens = extra->pens;
+	int bn = extra->bn;
+	int cmode = extra->cmode;
+	int prioverchar = extra->prioverchar;
+	int fogDisable = extra->fogDisable;
+	int fogDensity = extra->fogDensity;
+	int fadeEnable = extra->fadeEnable;
+	const UINT8 *pCharPri = BITMAP_ADDR8(priority_bitmap, scanline, 0);
+	UINT32 *pDest = BITMAP_ADDR32((mame_bitmap *)destbase, scanline, 0);
+	float z = extent->param[0].start; /* 1/z */
+	float u = extent->param[1].start; /* u/z */
+	float v = extent->param[2].start; /* v/z */
+	float i = extent->param[3].start; /* i/z */
+	float dz = extent->param[0].dpdx;
+	float du = extent->param[1].dpdx;
+	float dv = extent->param[2].dpdx;
+	float di = extent->param[3].dpdx;
+	int x;
+
+	for( x=extent->startx; x<extent->stopx; x++ )
 	{
-		SWAP(e1,e2);
-	}
-
-	{
-		const UINT8 *pCharPri = BITMAP_ADDR8(priority_bitmap, sy, 0);
-		UINT32 *pDest = BITMAP_ADDR32(bitmap, sy, 0);
-		int x0 = (int)e1->x;
-		int x1 = (int)e2->x;
-		int w = x1-x0;
-		if( w )
+		if( pCharPri[x]==0 || prioverchar )
 		{
-			float u = e1->u; /* u/z */
-			float v = e1->v; /* v/z */
-			float i = e1->i; /* i/z */
-			float z = e1->z; /* 1/z */
-			float oow = 1.0f / w;
-			float du = (e2->u - e1->u)*oow;
-			float dv = (e2->v - e1->v)*oow;
-			float dz = (e2->z - e1->z)*oow;
-			float di = (e2->i - e1->i)*oow;
-			int x, crop;
-			crop = clip->min_x - x0;
-			if( crop>0 )
-			{
-				u += crop*du;
-				v += crop*dv;
-				i += crop*di;
-				z += crop*dz;
-				x0 = clip->min_x;
-			}
-			if( x1>clip->max_x )
+			float ooz = 1.0f/z;
+			int pen = texel((int)(u * ooz),bn+(int)(v*ooz));
+			switch( cmode )
 			{
-				x1 = clip->max_x;
+			case 0x2:
+				 pen = 0xe0|(pen>>4);
+				 break;
+			case 0x3:
+				pen = 0xe0|(pen&0xf);
+				break;
+			case 0x4:
+				pen = 0xec|(pen>>6);
+				break;
+			case 0x5:
+				pen = 0xec|((pen>>4)&3);
+				break;
+			case 0x6:
+				pen = 0xec|((pen>>2)&3);
+				break;
+			case 0x7:
+				pen = 0xec|(pen&3);
+				break;
+			case 0xa:
+				pen = 0xf0|(pen>>4);
+				break;
+			case 0xb:
+				pen = 0xf0|(pen&0xf);
+				break;
+			case 0xc:
+				pen = 0xfc|(pen>>6);
+				break;
+			case 0xd:
+				pen = 0xfc|((pen>>4)&3);
+				break;
+			case 0xe:
+				pen = 0xfc|((pen>>2)&3);
+				break;
+			case 0xf:
+				pen = 0xfc|(pen&3);
+				break;
+			default:
+				break;
 			}
-         bn *= 0x1000;
 
-         if( mbSuperSystem22 )
-         {
+			{
+				UINT32 rgb = pens[pen];
+				int shade = i*ooz;
+				int r = rgb>>16;
+				int g = (rgb>>8)&0xff;
+				int b = rgb&0xff;
+				r = r*shade/0x40;
+				if( r>0xff ) r = 0xff;
+				g = g*shade/0x40;
+				if( g>0xff ) g = 0xff;
+				b = b*shade/0x40;
+				if( b>0xff ) b = 0xff;
 				if( !fogDisable )
 				{
-					int cz = flags>>8;
-					static const int cztype_remap[4] = { 3,1,2,0 };
-	            int cztype = flags&3;
-	            if( nthword(namcos22_czattr,4)&(0x4000>>(cztype*4)) )
-	            {
-	               int fogDelta = (INT16)nthword(namcos22_czattr, cztype);
-			//          if( fogDelta == 0x8000 ) fogDelta = -0x7fff;
-	               //cz = Clamp256(cz+fogDelta);
-	               fogDensity = fogDelta + namcos22_czram[cztype_remap[cztype]][cz];
-						if( fogDensity<0x0000 )
-						{
-							fogDensity = 0x0000;
-						}
-						else if( fogDensity>0x1fff )
-						{
-							fogDensity = 0x1fff;
-						}
-					}
+				   int fogDensity2 = 0x2000 - fogDensity;
+				   r = (r*fogDensity2 + fogDensity*mixer.rFogColor)>>13;
+				   g = (g*fogDensity2 + fogDensity*mixer.gFogColor)>>13;
+				   b = (b*fogDensity2 + fogDensity*mixer.bFogColor)>>13;
 				}
-         }
-			else
-			{
-				fogDisable = 1;
-			}
-
-         for( x=x0; x<x1; x++ )
-			{
-				if( pCharPri[x]==0 || prioverchar )
+				if( fadeEnable )
 				{
-					float ooz = 1.0f/z;
-					int pen = texel((int)(u * ooz),bn+(int)(v*ooz));
-					switch( cmode )
-					{
-					case 0x2:
-						 pen = 0xe0|(pen>>4);
-						 break;
-					case 0x3:
-						pen = 0xe0|(pen&0xf);
-						break;
-					case 0x4:
-						pen = 0xec|(pen>>6);
-						break;
-					case 0x5:
-						pen = 0xec|((pen>>4)&3);
-						break;
-					case 0x6:
-						pen = 0xec|((pen>>2)&3);
-						break;
-					case 0x7:
-						pen = 0xec|(pen&3);
-						break;
-					case 0xa:
-						pen = 0xf0|(pen>>4);
-						break;
-					case 0xb:
-						pen = 0xf0|(pen&0xf);
-						break;
-					case 0xc:
-						pen = 0xfc|(pen>>6);
-						break;
-					case 0xd:
-						pen = 0xfc|((pen>>4)&3);
-						break;
-					case 0xe:
-						pen = 0xfc|((pen>>2)&3);
-						break;
-					case 0xf:
-						pen = 0xfc|(pen&3);
-						break;
-					default:
-						break;
-					}
-
-					{
-						UINT32 rgb = pens[pen];
-						int shade = i*ooz;
-	   				int r = rgb>>16;
-						int g = (rgb>>8)&0xff;
-						int b = rgb&0xff;
-		            r = r*shade/0x40;
-		            if( r>0xff ) r = 0xff;
-			         g = g*shade/0x40;
-				      if( g>0xff ) g = 0xff;
-					   b = b*shade/0x40;
-		   			if( b>0xff ) b = 0xff;
-						if( !fogDisable )
-						{
-						   int fogDensity2 = 0x2000 - fogDensity;
-						   r = (r*fogDensity2 + fogDensity*mixer.rFogColor)>>13;
-						   g = (g*fogDensity2 + fogDensity*mixer.gFogColor)>>13;
-						   b = (b*fogDensity2 + fogDensity*mixer.bFogColor)>>13;
-						}
-						if( fadeEnable )
-						{
-							int fade2 = 0x100-mixer.fadeFactor;
-							r = (r*fade2+mixer.fadeFactor*mixer.rFadeColor)>>8;
-							g = (g*fade2+mixer.fadeFactor*mixer.gFadeColor)>>8;
-							b = (b*fade2+mixer.fadeFactor*mixer.bFadeColor)>>8;
-						}
-						if( prioverchar )
-						{
-							UINT32 color = pDest[x];
-							int tr = color>>16;
-							int tg = (color>>8)&0xff;
-							int tb = color&0xff;
-							int trans1 = 0x100 - mixer.poly_translucency;
-							r = (tr*mixer.poly_translucency + r*trans1)/0x100;
-							g = (tg*mixer.poly_translucency + g*trans1)/0x100;
-							b = (tb*mixer.poly_translucency + b*trans1)/0x100;
-						}
-						rgb = (r<<16)|(g<<8)|b;
-						pDest[x] = rgb;
-					}
+					int fade2 = 0x100-mixer.fadeFactor;
+					r = (r*fade2+mixer.fadeFactor*mixer.rFadeColor)>>8;
+					g = (g*fade2+mixer.fadeFactor*mixer.gFadeColor)>>8;
+					b = (b*fade2+mixer.fadeFactor*mixer.bFadeColor)>>8;
 				}
-
-            u += du;
-				v += dv;
-				i += di;
-				z += dz;
+				if( prioverchar )
+				{
+					UINT32 color = pDest[x];
+					int tr = color>>16;
+					int tg = (color>>8)&0xff;
+					int tb = color&0xff;
+					int trans1 = 0x100 - mixer.poly_translucency;
+					r = (tr*mixer.poly_translucency + r*trans1)/0x100;
+					g = (tg*mixer.poly_translucency + g*trans1)/0x100;
+					b = (tb*mixer.poly_translucency + b*trans1)/0x100;
+				}
+				rgb = (r<<16)|(g<<8)|b;
+				pDest[x] = rgb;
 			}
 		}
+
+		u += du;
+		v += dv;
+		i += di;
+		z += dz;
 	}
 } /* renderscanline_uvi_full */
 
@@ -429,160 +375,61 @@ static void rendertri(running_machine *machine,
       UINT16 flags,
 		int cmode )
 {
-	int dy,ystart,yend,crop;
+	poly_extra_data *extra = poly_get_extra_data(poly);
+	poly_vertex pv[3];
+	const vertex *v[3];
+	int n;
 
-	/* first, sort so that v0->y <= v1->y <= v2->y */
-	for(;;)
-	{
-		if( v0->y > v1->y )
-		{
-			SWAP(v0,v1);
-		}
-		else if( v1->y > v2->y )
-		{
-			SWAP(v1,v2);
-		}
-		else
-		{
-			break;
-		}
-	}
+	extra->pens = &machine->pens[(color&0x7f)<<8];
+	extra->bn = bn * 0x1000;
+	extra->cmode = cmode;
+	extra->prioverchar = (cmode&7)==1;
+	extra->fogDisable = color&0x80;
+	extra->fogDensity = 0;
+	extra->fadeEnable = (mixer.target&1) && mixer.fadeFactor;
 
-	ystart = v0->y;
-	yend   = v2->y;
-	dy = yend-ystart;
-	if( dy )
+	if( mbSuperSystem22 )
 	{
-		int y;
-		edge e1; /* short edge (top and bottom) */
-		edge e2; /* long (common) edge */
-
-		float oody = 1.0f / (float)dy;
-
-		float dx2dy = (v2->x - v0->x)*oody;
-		float du2dy = (v2->u - v0->u)*oody;
-		float dv2dy = (v2->v - v0->v)*oody;
-		float di2dy = (v2->i - v0->i)*oody;
-		float dz2dy = (v2->z - v0->z)*oody;
-
-		float dx1dy;
-		float du1dy;
-		float dv1dy;
-		float di1dy;
-		float dz1dy;
-
-		e2.x = v0->x;
-		e2.u = v0->u;
-		e2.v = v0->v;
-		e2.i = v0->i;
-		e2.z = v0->z;
-		crop = clip->min_y - ystart;
-		if( crop>0 )
-		{
-			e2.x += dx2dy*crop;
-			e2.u += du2dy*crop;
-			e2.v += dv2dy*crop;
-			e2.i += di2dy*crop;
-			e2.z += dz2dy*crop;
-		}
-
-		ystart = v0->y;
-		yend = v1->y;
-		dy = yend-ystart;
-
-		if( dy )
+		if( !extra->fogDisable )
 		{
-			e1.x = v0->x;
-			e1.u = v0->u;
-			e1.v = v0->v;
-			e1.i = v0->i;
-			e1.z = v0->z;
-
-			oody = 1.0f / (float)dy;
-			dx1dy = (v1->x - v0->x)*oody;
-			du1dy = (v1->u - v0->u)*oody;
-			dv1dy = (v1->v - v0->v)*oody;
-			di1dy = (v1->i - v0->i)*oody;
-			dz1dy = (v1->z - v0->z)*oody;
-
-			crop = clip->min_y - ystart;
-			if( crop>0 )
+			int cz = flags>>8;
+			static const int cztype_remap[4] = { 3,1,2,0 };
+			int cztype = flags&3;
+			if( nthword(namcos22_czattr,4)&(0x4000>>(cztype*4)) )
 			{
-				e1.x += dx1dy*crop;
-				e1.u += du1dy*crop;
-				e1.v += dv1dy*crop;
-				e1.i += di1dy*crop;
-				e1.z += dz1dy*crop;
-				ystart = clip->min_y;
-			}
-			if( yend>clip->max_y ) yend = clip->max_y;
-
-			for( y=ystart; y<yend; y++ )
-			{
-				renderscanline_uvi_full(machine, bitmap, clip, &e1, &e2, y, color, bn, flags, cmode );
-
-				e2.x += dx2dy;
-				e2.u += du2dy;
-				e2.v += dv2dy;
-				e2.i += di2dy;
-				e2.z += dz2dy;
-
-				e1.x += dx1dy;
-				e1.u += du1dy;
-				e1.v += dv1dy;
-				e1.i += di1dy;
-				e1.z += dz1dy;
+				int fogDelta = (INT16)nthword(namcos22_czattr, cztype);
+				int fogDensity = fogDelta + namcos22_czram[cztype_remap[cztype]][cz];
+				if( fogDensity<0x0000 )
+				{
+					fogDensity = 0x0000;
+				}
+				else if( fogDensity>0x1fff )
+				{
+					fogDensity = 0x1fff;
+				}
+				extra->fogDensity = fogDensity;
 			}
 		}
+	}
+	else
+	{
+		extra->fogDisable = 1;
+	}
 
-		ystart = v1->y;
-		yend = v2->y;
-		dy = yend-ystart;
-		if( dy )
-		{
-			e1.x = v1->x;
-			e1.u = v1->u;
-			e1.v = v1->v;
-			e1.i = v1->i;
-			e1.z = v1->z;
-
-			oody = 1.0f / (float)dy;
-			dx1dy = (v2->x - v1->x)*oody;
-			du1dy = (v2->u - v1->u)*oody;
-			dv1dy = (v2->v - v1->v)*oody;
-			di1dy = (v2->i - v1->i)*oody;
-			dz1dy = (v2->z - v1->z)*oody;
-
-			crop = clip->min_y - ystart;
-			if( crop>0 )
-			{
-				e1.x += dx1dy*crop;
-				e1.u += du1dy*crop;
-				e1.v += dv1dy*crop;
-				e1.i += di1dy*crop;
-				e1.z += dz1dy*crop;
-				ystart = clip->min_y;
-			}
-			if( yend>clip->max_y ) yend = clip->max_y;
-
-			for( y=ystart; y<yend; y++ )
-			{
-				renderscanline_uvi_full(machine, bitmap, clip, &e1,&e2,y, color, bn, flags, cmode );
-
-				e2.x += dx2dy;
-				e2.u += du2dy;
-				e2.v += dv2dy;
-				e2.i += di2dy;
-				e2.z += dz2dy;
-
-				e1.x += dx1dy;
-				e1.u += du1dy;
-				e1.v += dv1dy;
-				e1.i += di1dy;
-				e1.z += dz1dy;
-			}
-		}
+	v[0] = v0;
+	v[1] = v1;
+	v[2] = v2;
+	for( n=0; n<3; n++ )
+	{
+		pv[n].x = v[n]->x;
+		pv[n].y = v[n]->y;
+		pv[n].p[0] = v[n]->z;
+		pv[n].p[1] = v[n]->u;
+		pv[n].p[2] = v[n]->v;
+		pv[n].p[3] = v[n]->i;
 	}
+
+	poly_render_triangle(poly, bitmap, clip, renderscanline_uvi_full, 4, &pv[0], &pv[1], &pv[2]);
 } /* rendertri */
 
 static void
@@ -1272,6 +1119,8 @@ static void RenderSceneHelper(running_machine *machine, mame_bitmap *bitmap, str
                break;
 
             case eSCENENODE_SPRITE:
+               /* sprites are drawn immediately, so let pending polygons catch up */
+               poly_wait( poly, "RenderSprite" );
                poly3d_NoClip();
                RenderSprite(machine, bitmap,node );
                break;
@@ -1297,6 +1146,7 @@ static void RenderScene(running_machine *machine, mame_bitmap *bitmap )
       node->data.nonleaf.next[i] = NULL;
    }
    poly3d_NoClip();
+   poly_wait( poly, "RenderScene" );
 } /* RenderScene */
 
 static float
@@ -2540,6 +2390,11 @@ WRITE32_HANDLER( namcos22_paletteram_w )
 	dirtypal[offset&(0x7fff/4)] = 1;
 }
 
+static void namcos22_exit(running_machine *machine)
+{
+	poly_free(poly);
+}
+
 static void video_start_common(running_machine *machine)
 {
 	bgtilemap = tilemap_create( TextTilemapGetInfo,tilemap_scan_rows,TILEMAP_TYPE_PEN,16,16,64,64 );
@@ -2555,6 +2410,9 @@ static void video_start_common(running_machine *machine)
 	mpPolyL = memory_region(REGION_POINTROM);
 	mpPolyM = mpPolyL + mPtRomSize;
 	mpPolyH = mpPolyM + mPtRomSize;
+
+	poly = poly_alloc(4000, sizeof(poly_extra_data), 0);
+	add_exit_callback(machine, namcos22_exit);
 }
 
 VIDEO_START( namcos22 )
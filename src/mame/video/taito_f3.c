@@ -3292,6 +3292,9 @@ VIDEO_UPDATE( f3 )
 		sy_fix[4]=-sy_fix[4];
 	}
 
+	/* bring all the playfields up to date in parallel */
+	tilemap_prerender(ALL_TILEMAPS);
+
 	fillbitmap(pri_alp_bitmap,0,cliprect);
 
 	/* sprites */
@@ -36,6 +36,18 @@ enum
 /* size of the rasterizer hash table */
 #define RASTER_HASH_SIZE		97
 
+/* maximum number of scanline bands a batch of triangles is split into */
+#define MAX_RASTER_BANDS		16
+
+/* minimum number of scanlines per band */
+#define RASTER_BAND_MIN_ROWS	8
+
+/* batches with fewer pixels than this are drawn directly */
+#define RASTER_BAND_THRESHOLD	2048
+
+/* maximum number of triangles queued in a batch */
+#define RASTER_BATCH_POLYS		128
+
 /* flags for LFB writes */
 #define LFB_RGB_PRESENT			1
 #define LFB_ALPHA_PRESENT		2
@@ -1549,6 +1561,8 @@ struct _voodoo_stats
 	INT32		total_afunc_fail;		/* total a func fail */
 	INT32		total_clipped;			/* total clipped */
 	INT32		total_stippled;			/* total stippled */
+	INT32		total_bands;			/* total bands queued */
+	INT32		total_waits;			/* total waits for queued bands */
 	INT32		lfb_writes;				/* LFB writes */
 	INT32		lfb_reads;				/* LFB reads */
 	INT32		reg_writes;				/* register writes */
@@ -1560,10 +1574,29 @@ struct _voodoo_stats
 typedef struct _voodoo_stats voodoo_stats;
 
 
+struct _stats_block
+{
+	INT32		pixels_in;				/* pixels in statistic */
+	INT32		pixels_out;				/* pixels out statistic */
+	INT32		chroma_fail;			/* chroma test fail statistic */
+	INT32		zfunc_fail;				/* z function test fail statistic */
+	INT32		afunc_fail;				/* alpha function test fail statistic */
+	INT32		clip_fail;				/* clipping fail statistic */
+	INT32		stipple_fail;			/* stipple fail statistic */
+	UINT32		stipple_pattern;		/* running stipple pattern */
+};
+typedef struct _stats_block stats_block;
+
+
+typedef struct _raster_poly raster_poly;
+typedef struct _raster_band raster_band;
+typedef struct _raster_batch raster_batch;
+
+
 struct _raster_info
 {
 	struct _raster_info *next;			/* pointer to next entry with the same hash */
-	void		(*callback)(voodoo_state *, UINT16 *); /* callback pointer */
+	void		(*callback)(const raster_poly *, raster_band *); /* callback pointer */
 	UINT8		is_generic;				/* TRUE if this is one of the generic rasterizers */
 	UINT32		hits;					/* how many hits (pixels) we've used this for */
 	UINT32		polys;					/* how many polys we've used this for */
@@ -1573,10 +1606,111 @@ struct _raster_info
 	UINT32		eff_fbz_mode;			/* effective fbzMode value */
 	UINT32		eff_tex_mode_0;			/* effective textureMode value for TMU #0 */
 	UINT32		eff_tex_mode_1;			/* effective textureMode value for TMU #1 */
+#ifdef VOODOO_DRC
+	void *		drc_span;				/* compiled span function, or NULL */
+#endif
 };
 typedef struct _raster_info raster_info;
 
 
+/* the parts of fbi_state the rasterizers read, copied per triangle */
+struct _raster_fbi
+{
+	UINT16 *	aux;					/* pointer to the aux buffer */
+	UINT32		yorigin;				/* Y origin subtract value */
+	UINT32		rowpixels;				/* pixels per row */
+
+	UINT8		fogblend[64];			/* 64-entry fog table */
+	UINT8		fogdelta[64];			/* 64-entry fog table */
+	UINT8		fogdelta_mask;			/* mask for for delta (0xff for V1, 0xfc for V2) */
+
+	INT16		ax, ay;					/* vertex A x,y (12.4) */
+	INT16		bx, by;					/* vertex B x,y (12.4) */
+	INT16		cx, cy;					/* vertex C x,y (12.4) */
+	INT32		startr, startg, startb, starta; /* starting R,G,B,A (12.12) */
+	INT32		startz;					/* starting Z (20.12) */
+	INT64		startw;					/* starting W (16.32) */
+	INT32		drdx, dgdx, dbdx, dadx;	/* delta R,G,B,A per X */
+	INT32		dzdx;					/* delta Z per X */
+	INT64		dwdx;					/* delta W per X */
+	INT32		drdy, dgdy, dbdy, dady;	/* delta R,G,B,A per Y */
+	INT32		dzdy;					/* delta Z per Y */
+	INT64		dwdy;					/* delta W per Y */
+};
+typedef struct _raster_fbi raster_fbi;
+
+
+/* the parts of tmu_state the rasterizers read, copied per triangle */
+struct _raster_tmu
+{
+	UINT8 *		ram;					/* pointer to our RAM */
+	UINT32		mask;					/* mask to apply to pointers */
+	UINT32		texmode;				/* textureMode register */
+
+	INT64		starts, startt;			/* starting S,T (14.18) */
+	INT64		startw;					/* starting W (2.30) */
+	INT64		dsdx, dtdx;				/* delta S,T per X */
+	INT64		dwdx;					/* delta W per X */
+	INT64		dsdy, dtdy;				/* delta S,T per Y */
+	INT64		dwdy;					/* delta W per Y */
+
+	INT32		lodmin, lodmax;			/* min, max LOD values */
+	INT32		lodbias;				/* LOD bias */
+	UINT32		lodmask;				/* mask of available LODs */
+	UINT32		lodoffset[9];			/* offset of texture base for each LOD */
+	INT32		lodbase;				/* used during rasterization */
+	INT32		detailmax;				/* detail clamp */
+	INT32		detailbias;				/* detail bias */
+	UINT8		detailscale;			/* detail scale */
+
+	UINT32		wmask;					/* mask for the current texture width */
+	UINT32		hmask;					/* mask for the current texture height */
+
+	UINT32		bilinear_mask;			/* mask for bilinear resolution (0xf0 for V1, 0xff for V2) */
+
+	rgb_t *		lookup;					/* currently selected lookup */
+};
+typedef struct _raster_tmu raster_tmu;
+
+
+/* a queued triangle; the chip state can move on while it waits, so it */
+/* carries a copy of everything its rasterizer looks at */
+struct _raster_poly
+{
+	raster_info *info;					/* rasterizer to use */
+	UINT16 *	drawbuf;				/* target buffer */
+	INT32		starty, stopy;			/* range of scanlines covered */
+	UINT32		stipplereg;				/* stipple register when queued */
+	voodoo_reg	reg[color1 + 1];		/* FBI registers; only fbzColorPath-color1 are copied */
+	raster_fbi	fbi;					/* FBI iterators and tables */
+	raster_tmu	tmu[MAX_TMU];			/* TMU iterators and parameters */
+};
+
+
+struct _raster_band
+{
+	raster_batch *batch;				/* batch of triangles to draw */
+	INT32		starty, stopy;			/* range of scanlines to draw */
+	stats_block stats;					/* statistics gathered while drawing */
+	UINT32		rotate;					/* unclipped pixels drawn with a rotating stipple */
+};
+
+
+/* triangles are drawn in batches; each band of a batch draws its rows of */
+/* every triangle in the order they were queued */
+struct _raster_batch
+{
+	int			polys;					/* number of triangles queued */
+	int			bands;					/* number of bands drawn or queued */
+	UINT8		queued;					/* TRUE if the bands went to the work queue */
+	UINT8		single;					/* TRUE if the batch must be drawn as one band */
+	INT32		starty, stopy;			/* range of scanlines covered */
+	INT32		pixels;					/* number of pixels covered */
+	raster_band	band[MAX_RASTER_BANDS];	/* the bands */
+	raster_poly	poly[RASTER_BATCH_POLYS]; /* the triangles */
+};
+
+
 struct _banshee_info
 {
 	UINT32		io[0x40];				/* I/O registers */
@@ -1623,6 +1757,16 @@ struct _voodoo_state
 	int			next_rasterizer;		/* next rasterizer index */
 	raster_info	rasterizer[MAX_RASTERIZERS]; /* array of rasterizers */
 	raster_info *raster_hash[RASTER_HASH_SIZE]; /* hash table of rasterizers */
+
+	osd_work_queue *raster_queue;		/* work queue for scanline bands */
+	int			curbatch;				/* batch new triangles are added to */
+	raster_batch batch[2];				/* batches being filled and drawn */
+
+#ifdef VOODOO_DRC
+	UINT8 *		drc_cache;				/* base of the compiled rasterizer cache */
+	UINT8 *		drc_top;				/* next free byte in the cache */
+	UINT8 *		drc_end;				/* end of the cache */
+#endif
 };
 /* typedef struct _voodoo_state voodoo_state; -- declared above */
 
@@ -2105,7 +2249,7 @@ do 																				\
 		{																		\
 			if ((((COLOR) ^ (VV)->reg[chromaKey].u) & 0xffffff) == 0)			\
 			{																	\
-				(VV)->reg[fbiChromaFail].u++;									\
+				stats->chroma_fail++;											\
 				goto skipdrawdepth;												\
 			}																	\
 		}																		\
@@ -2145,7 +2289,7 @@ do 																				\
 			{																	\
 				if (results != 0)												\
 				{																\
-					(VV)->reg[fbiChromaFail].u++;								\
+					stats->chroma_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 			}																	\
@@ -2153,7 +2297,7 @@ do 																				\
 			{																	\
 				if (results == 7)												\
 				{																\
-					(VV)->reg[fbiChromaFail].u++;								\
+					stats->chroma_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 			}																	\
@@ -2177,7 +2321,7 @@ do 																				\
 	{																			\
 		if (((AA) & 1) == 0)													\
 		{																		\
-			(VV)->reg[fbiAfuncFail].u++;										\
+			stats->afunc_fail++;												\
 			goto skipdrawdepth;													\
 		}																		\
 	}																			\
@@ -2200,13 +2344,13 @@ do 																				\
 		switch (ALPHAMODE_ALPHAFUNCTION(ALPHAMODE))								\
 		{																		\
 			case 0:		/* alphaOP = never */									\
-				(VV)->reg[fbiAfuncFail].u++;									\
+				stats->afunc_fail++;											\
 				goto skipdrawdepth;												\
 																				\
 			case 1:		/* alphaOP = less than */								\
 				if ((AA) >= ALPHAMODE_ALPHAREF(ALPHAMODE))						\
 				{																\
-					(VV)->reg[fbiAfuncFail].u++;								\
+					stats->afunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -2214,7 +2358,7 @@ do 																				\
 			case 2:		/* alphaOP = equal */									\
 				if ((AA) != ALPHAMODE_ALPHAREF(ALPHAMODE))						\
 				{																\
-					(VV)->reg[fbiAfuncFail].u++;								\
+					stats->afunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -2222,7 +2366,7 @@ do 																				\
 			case 3:		/* alphaOP = less than or equal */						\
 				if ((AA) > ALPHAMODE_ALPHAREF(ALPHAMODE))						\
 				{																\
-					(VV)->reg[fbiAfuncFail].u++;								\
+					stats->afunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -2230,7 +2374,7 @@ do 																				\
 			case 4:		/* alphaOP = greater than */							\
 				if ((AA) <= ALPHAMODE_ALPHAREF(ALPHAMODE))						\
 				{																\
-					(VV)->reg[fbiAfuncFail].u++;								\
+					stats->afunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -2238,7 +2382,7 @@ do 																				\
 			case 5:		/* alphaOP = not equal */								\
 				if ((AA) == ALPHAMODE_ALPHAREF(ALPHAMODE))						\
 				{																\
-					(VV)->reg[fbiAfuncFail].u++;								\
+					stats->afunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -2246,7 +2390,7 @@ do 																				\
 			case 6:		/* alphaOP = greater than or equal */					\
 				if ((AA) < ALPHAMODE_ALPHAREF(ALPHAMODE))						\
 				{																\
-					(VV)->reg[fbiAfuncFail].u++;								\
+					stats->afunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -2922,7 +3066,7 @@ do 																				\
 	INT32 prefogr, prefogg, prefogb;											\
 	INT32 r, g, b, a;															\
 																				\
-	(VV)->reg[fbiPixelsIn].u++;													\
+	stats->pixels_in++;															\
 																				\
 	/* apply clipping */														\
 	if (FBZMODE_ENABLE_CLIPPING(FBZMODE))										\
@@ -2932,14 +3076,14 @@ do 																				\
 			(SCRY) < (((VV)->reg[clipLowYHighY].u >> 16) & 0x3ff) ||			\
 			(SCRY) >= ((VV)->reg[clipLowYHighY].u & 0x3ff))						\
 		{																		\
-			v->stats.total_clipped++;											\
+			stats->clip_fail++;													\
 			goto skipdrawdepth;													\
 		}																		\
 	}																			\
 																				\
 	/* rotate stipple pattern */												\
 	if (FBZMODE_STIPPLE_PATTERN(FBZMODE) == 0)									\
-		(VV)->reg[stipple].u = ((VV)->reg[stipple].u << 1) | ((VV)->reg[stipple].u >> 31);\
+		stats->stipple_pattern = (stats->stipple_pattern << 1) | (stats->stipple_pattern >> 31);	\
 																				\
 	/* handle stippling */														\
 	if (FBZMODE_ENABLE_STIPPLE(FBZMODE))										\
@@ -2947,9 +3091,9 @@ do 																				\
 		/* rotate mode */														\
 		if (FBZMODE_STIPPLE_PATTERN(FBZMODE) == 0)								\
 		{																		\
-			if (((VV)->reg[stipple].u & 0x80000000) == 0)						\
+			if ((stats->stipple_pattern & 0x80000000) == 0)						\
 			{																	\
-				v->stats.total_stippled++;										\
+				stats->stipple_fail++;											\
 				goto skipdrawdepth;												\
 			}																	\
 		}																		\
@@ -2958,9 +3102,9 @@ do 																				\
 		else																	\
 		{																		\
 			int stipple_index = (((YY) & 3) << 3) | (~(XX) & 7);				\
-			if ((((VV)->reg[stipple].u >> stipple_index) & 1) == 0)				\
+			if (((stats->stipple_pattern >> stipple_index) & 1) == 0)			\
 			{																	\
-				v->stats.total_stippled++;										\
+				stats->stipple_fail++;											\
 				goto skipdrawdepth;												\
 			}																	\
 		}																		\
@@ -3006,7 +3150,7 @@ do 																				\
 	/* add the bias */															\
 	if (FBZMODE_ENABLE_DEPTH_BIAS(FBZMODE))										\
 	{																			\
-		depthval += (INT16)v->reg[zaColor].u;									\
+		depthval += (INT16)(VV)->reg[zaColor].u;								\
 		CLAMP(depthval, 0, 0xffff);												\
 	}																			\
 																				\
@@ -3020,19 +3164,19 @@ do 																				\
 		if (FBZMODE_DEPTH_SOURCE_COMPARE(FBZMODE) == 0)							\
 			depthsource = depthval;												\
 		else																	\
-			depthsource = v->reg[zaColor].u & 0xffff;							\
+			depthsource = (VV)->reg[zaColor].u & 0xffff;						\
 																				\
 		/* test against the depth buffer */										\
 		switch (FBZMODE_DEPTH_FUNCTION(FBZMODE))								\
 		{																		\
 			case 0:		/* depthOP = never */									\
-				(VV)->reg[fbiZfuncFail].u++;									\
+				stats->zfunc_fail++;											\
 				goto skipdrawdepth;												\
 																				\
 			case 1:		/* depthOP = less than */								\
 				if (depthsource >= depth[XX])									\
 				{																\
-					(VV)->reg[fbiZfuncFail].u++;								\
+					stats->zfunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -3040,7 +3184,7 @@ do 																				\
 			case 2:		/* depthOP = equal */									\
 				if (depthsource != depth[XX])									\
 				{																\
-					(VV)->reg[fbiZfuncFail].u++;								\
+					stats->zfunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -3048,7 +3192,7 @@ do 																				\
 			case 3:		/* depthOP = less than or equal */						\
 				if (depthsource > depth[XX])									\
 				{																\
-					(VV)->reg[fbiZfuncFail].u++;								\
+					stats->zfunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -3056,7 +3200,7 @@ do 																				\
 			case 4:		/* depthOP = greater than */							\
 				if (depthsource <= depth[XX])									\
 				{																\
-					(VV)->reg[fbiZfuncFail].u++;								\
+					stats->zfunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -3064,7 +3208,7 @@ do 																				\
 			case 5:		/* depthOP = not equal */								\
 				if (depthsource == depth[XX])									\
 				{																\
-					(VV)->reg[fbiZfuncFail].u++;								\
+					stats->zfunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -3072,7 +3216,7 @@ do 																				\
 			case 6:		/* depthOP = greater than or equal */					\
 				if (depthsource < depth[XX])									\
 				{																\
-					(VV)->reg[fbiZfuncFail].u++;								\
+					stats->zfunc_fail++;										\
 					goto skipdrawdepth;											\
 				}																\
 				break;															\
@@ -3116,7 +3260,7 @@ do 																				\
 	}																			\
 																				\
 	/* track pixel writes to the frame buffer regardless of mask */				\
-	(VV)->reg[fbiPixelsOut].u++;												\
+	stats->pixels_out++;														\
 																				\
 skipdrawdepth:																	\
 	;																			\
@@ -3421,54 +3565,56 @@ while (0)
 
 #define RASTERIZER(name, TMUS, FBZCOLORPATH, FBZMODE, ALPHAMODE, FOGMODE, TEXMODE0, TEXMODE1) \
 																				\
-static void raster_##name(voodoo_state *v, UINT16 *drawbuf)						\
+static void raster_##name(const raster_poly *poly, raster_band *band)		\
 {																				\
+	UINT16 *drawbuf = poly->drawbuf;											\
+	stats_block *stats = &band->stats;											\
 	INT32 dxdy_minmid, dxdy_minmax, dxdy_midmax;								\
 	INT32 minx, miny, midx, midy, maxx, maxy;									\
 	INT32 starty, stopy;														\
 	INT32 x, y;																	\
 																				\
 	/* sort the vertices */														\
-	if (v->fbi.ay <= v->fbi.by)													\
+	if (poly->fbi.ay <= poly->fbi.by)											\
 	{																			\
-		if (v->fbi.by <= v->fbi.cy)												\
+		if (poly->fbi.by <= poly->fbi.cy)										\
 		{																		\
-			minx = v->fbi.ax;	miny = v->fbi.ay;								\
-			midx = v->fbi.bx;	midy = v->fbi.by;								\
-			maxx = v->fbi.cx;	maxy = v->fbi.cy;								\
+			minx = poly->fbi.ax;	miny = poly->fbi.ay;						\
+			midx = poly->fbi.bx;	midy = poly->fbi.by;						\
+			maxx = poly->fbi.cx;	maxy = poly->fbi.cy;						\
 		}																		\
-		else if (v->fbi.ay <= v->fbi.cy)										\
+		else if (poly->fbi.ay <= poly->fbi.cy)									\
 		{																		\
-			minx = v->fbi.ax;	miny = v->fbi.ay;								\
-			midx = v->fbi.cx;	midy = v->fbi.cy;								\
-			maxx = v->fbi.bx;	maxy = v->fbi.by;								\
+			minx = poly->fbi.ax;	miny = poly->fbi.ay;						\
+			midx = poly->fbi.cx;	midy = poly->fbi.cy;						\
+			maxx = poly->fbi.bx;	maxy = poly->fbi.by;						\
 		}																		\
 		else																	\
 		{																		\
-			minx = v->fbi.cx;	miny = v->fbi.cy;								\
-			midx = v->fbi.ax;	midy = v->fbi.ay;								\
-			maxx = v->fbi.bx;	maxy = v->fbi.by;								\
+			minx = poly->fbi.cx;	miny = poly->fbi.cy;						\
+			midx = poly->fbi.ax;	midy = poly->fbi.ay;						\
+			maxx = poly->fbi.bx;	maxy = poly->fbi.by;						\
 		}																		\
 	}																			\
 	else																		\
 	{																			\
-		if (v->fbi.ay <= v->fbi.cy)												\
+		if (poly->fbi.ay <= poly->fbi.cy)										\
 		{																		\
-			minx = v->fbi.bx;	miny = v->fbi.by;								\
-			midx = v->fbi.ax;	midy = v->fbi.ay;								\
-			maxx = v->fbi.cx;	maxy = v->fbi.cy;								\
+			minx = poly->fbi.bx;	miny = poly->fbi.by;						\
+			midx = poly->fbi.ax;	midy = poly->fbi.ay;						\
+			maxx = poly->fbi.cx;	maxy = poly->fbi.cy;						\
 		}																		\
-		else if (v->fbi.by <= v->fbi.cy)										\
+		else if (poly->fbi.by <= poly->fbi.cy)									\
 		{																		\
-			minx = v->fbi.bx;	miny = v->fbi.by;								\
-			midx = v->fbi.cx;	midy = v->fbi.cy;								\
-			maxx = v->fbi.ax;	maxy = v->fbi.ay;								\
+			minx = poly->fbi.bx;	miny = poly->fbi.by;						\
+			midx = poly->fbi.cx;	midy = poly->fbi.cy;						\
+			maxx = poly->fbi.ax;	maxy = poly->fbi.ay;						\
 		}																		\
 		else																	\
 		{																		\
-			minx = v->fbi.cx;	miny = v->fbi.cy;								\
-			midx = v->fbi.bx;	midy = v->fbi.by;								\
-			maxx = v->fbi.ax;	maxy = v->fbi.ay;								\
+			minx = poly->fbi.cx;	miny = poly->fbi.cy;						\
+			midx = poly->fbi.bx;	midy = poly->fbi.by;						\
+			maxx = poly->fbi.ax;	maxy = poly->fbi.ay;						\
 		}																		\
 	}																			\
 																				\
@@ -3477,9 +3623,13 @@ static void raster_##name(voodoo_state *v, UINT16 *drawbuf)						\
 	dxdy_minmax = (miny == maxy) ? 0 : ((maxx - minx) << 16) / (maxy - miny);	\
 	dxdy_midmax = (midy == maxy) ? 0 : ((maxx - midx) << 16) / (maxy - midy);	\
 																				\
-	/* clamp to full pixels */													\
+	/* clamp to full pixels, then to our band */								\
 	starty = (miny + 7) >> 4;													\
 	stopy = (maxy + 7) >> 4;													\
+	if (starty < band->starty)													\
+		starty = band->starty;													\
+	if (stopy > band->stopy)													\
+		stopy = band->stopy;													\
 																				\
 	/* loop in Y */																\
 	for (y = starty; y < stopy; y++)											\
@@ -3519,38 +3669,38 @@ static void raster_##name(voodoo_state *v, UINT16 *drawbuf)						\
 		/* determine the screen Y */											\
 		scry = y;																\
 		if (FBZMODE_Y_ORIGIN(FBZMODE))											\
-			scry = (v->fbi.yorigin - y) & 0x3ff;								\
+			scry = (poly->fbi.yorigin - y) & 0x3ff;								\
 																				\
 		/* get pointers to the target buffer and depth buffer */				\
-		dest = drawbuf + scry * v->fbi.rowpixels;								\
-		depth = v->fbi.aux ? (v->fbi.aux + scry * v->fbi.rowpixels) : NULL;		\
+		dest = drawbuf + scry * poly->fbi.rowpixels;							\
+		depth = poly->fbi.aux ? (poly->fbi.aux + scry * poly->fbi.rowpixels) : NULL; \
 																				\
 		/* compute the starting parameters */									\
-		dx = startx - (v->fbi.ax >> 4);											\
-		dy = y - (v->fbi.ay >> 4);												\
-		iterr = v->fbi.startr + dy * v->fbi.drdy + dx * v->fbi.drdx;			\
-		iterg = v->fbi.startg + dy * v->fbi.dgdy + dx * v->fbi.dgdx;			\
-		iterb = v->fbi.startb + dy * v->fbi.dbdy + dx * v->fbi.dbdx;			\
-		itera = v->fbi.starta + dy * v->fbi.dady + dx * v->fbi.dadx;			\
-		iterz = v->fbi.startz + dy * v->fbi.dzdy + dx * v->fbi.dzdx;			\
-		iterw = v->fbi.startw + dy * v->fbi.dwdy + dx * v->fbi.dwdx;			\
+		dx = startx - (poly->fbi.ax >> 4);										\
+		dy = y - (poly->fbi.ay >> 4);											\
+		iterr = poly->fbi.startr + dy * poly->fbi.drdy + dx * poly->fbi.drdx;	\
+		iterg = poly->fbi.startg + dy * poly->fbi.dgdy + dx * poly->fbi.dgdx;	\
+		iterb = poly->fbi.startb + dy * poly->fbi.dbdy + dx * poly->fbi.dbdx;	\
+		itera = poly->fbi.starta + dy * poly->fbi.dady + dx * poly->fbi.dadx;	\
+		iterz = poly->fbi.startz + dy * poly->fbi.dzdy + dx * poly->fbi.dzdx;	\
+		iterw = poly->fbi.startw + dy * poly->fbi.dwdy + dx * poly->fbi.dwdx;	\
 		if (TMUS >= 1)															\
 		{																		\
-			iterw0 = v->tmu[0].startw + dy * v->tmu[0].dwdy +					\
-										dx * v->tmu[0].dwdx;					\
-			iters0 = v->tmu[0].starts + dy * v->tmu[0].dsdy + 					\
-										dx * v->tmu[0].dsdx;					\
-			itert0 = v->tmu[0].startt + dy * v->tmu[0].dtdy + 					\
-										dx * v->tmu[0].dtdx;					\
+			iterw0 = poly->tmu[0].startw + dy * poly->tmu[0].dwdy +				\
+										dx * poly->tmu[0].dwdx;					\
+			iters0 = poly->tmu[0].starts + dy * poly->tmu[0].dsdy +				\
+										dx * poly->tmu[0].dsdx;					\
+			itert0 = poly->tmu[0].startt + dy * poly->tmu[0].dtdy +				\
+										dx * poly->tmu[0].dtdx;					\
 		}																		\
 		if (TMUS >= 2)															\
 		{																		\
-			iterw1 = v->tmu[1].startw + dy * v->tmu[1].dwdy + 					\
-										dx * v->tmu[1].dwdx;					\
-			iters1 = v->tmu[1].starts + dy * v->tmu[1].dsdy + 					\
-										dx * v->tmu[1].dsdx;					\
-			itert1 = v->tmu[1].startt + dy * v->tmu[1].dtdy + 					\
-										dx * v->tmu[1].dtdx;					\
+			iterw1 = poly->tmu[1].startw + dy * poly->tmu[1].dwdy +				\
+										dx * poly->tmu[1].dwdx;					\
+			iters1 = poly->tmu[1].starts + dy * poly->tmu[1].dsdy +				\
+										dx * poly->tmu[1].dsdx;					\
+			itert1 = poly->tmu[1].startt + dy * poly->tmu[1].dtdy +				\
+										dx * poly->tmu[1].dtdx;					\
 		}																		\
 																				\
 		/* loop in X */															\
@@ -3560,51 +3710,51 @@ static void raster_##name(voodoo_state *v, UINT16 *drawbuf)						\
 			rgb_t texel = 0;													\
 																				\
 			/* pixel pipeline part 1 handles depth testing and stippling */		\
-			PIXEL_PIPELINE_BEGIN(v, x, y, scry, FBZCOLORPATH, FBZMODE, 			\
+			PIXEL_PIPELINE_BEGIN(poly, x, y, scry, FBZCOLORPATH, FBZMODE,		\
 									iterz, iterw);								\
 																				\
 			/* run the texture pipeline on TMU1 to produce a value in texel */	\
 			/* note that they set LOD min to 8 to "disable" a TMU */			\
-			if (TMUS >= 2 && v->tmu[1].lodmin < (8 << 8))						\
-				TEXTURE_PIPELINE(&v->tmu[1], x, y, TEXMODE1, texel,				\
-									v->tmu[1].lookup, v->tmu[1].lodbase,		\
+			if (TMUS >= 2 && poly->tmu[1].lodmin < (8 << 8))					\
+				TEXTURE_PIPELINE(&poly->tmu[1], x, y, TEXMODE1, texel,			\
+									poly->tmu[1].lookup, poly->tmu[1].lodbase,	\
 									iters1, itert1, iterw1, texel);				\
 																				\
 			/* run the texture pipeline on TMU0 to produce a final */			\
 			/* result in texel */												\
 			/* note that they set LOD min to 8 to "disable" a TMU */			\
-			if (TMUS >= 1 && v->tmu[0].lodmin < (8 << 8))						\
-				TEXTURE_PIPELINE(&v->tmu[0], x, y, TEXMODE0, texel, 			\
-									v->tmu[0].lookup, v->tmu[0].lodbase,		\
+			if (TMUS >= 1 && poly->tmu[0].lodmin < (8 << 8))					\
+				TEXTURE_PIPELINE(&poly->tmu[0], x, y, TEXMODE0, texel,			\
+									poly->tmu[0].lookup, poly->tmu[0].lodbase,	\
 									iters0, itert0, iterw0, texel);				\
 																				\
 			/* colorpath pipeline selects source colors and does blending */	\
 			CLAMPED_ARGB(iterr, iterg, iterb, itera, FBZCOLORPATH, iterargb);	\
-			COLORPATH_PIPELINE(v, FBZCOLORPATH, FBZMODE, ALPHAMODE,	texel,		\
+			COLORPATH_PIPELINE(poly, FBZCOLORPATH, FBZMODE, ALPHAMODE,	texel,	\
 								iterz, iterw, iterargb);						\
 																				\
 			/* pixel pipeline part 2 handles fog, alpha, and final output */	\
-			PIXEL_PIPELINE_END(v, x, y, dest, depth, FBZMODE, FBZCOLORPATH,	 	\
+			PIXEL_PIPELINE_END(poly, x, y, dest, depth, FBZMODE, FBZCOLORPATH,	\
 									ALPHAMODE, FOGMODE, iterz, iterw, iterargb);\
 																				\
 			/* update the iterated parameters */								\
-			iterr += v->fbi.drdx;												\
-			iterg += v->fbi.dgdx;												\
-			iterb += v->fbi.dbdx;												\
-			itera += v->fbi.dadx;												\
-			iterz += v->fbi.dzdx;												\
-			iterw += v->fbi.dwdx;												\
+			iterr += poly->fbi.drdx;											\
+			iterg += poly->fbi.dgdx;											\
+			iterb += poly->fbi.dbdx;											\
+			itera += poly->fbi.dadx;											\
+			iterz += poly->fbi.dzdx;											\
+			iterw += poly->fbi.dwdx;											\
 			if (TMUS >= 1)														\
 			{																	\
-				iterw0 += v->tmu[0].dwdx;										\
-				iters0 += v->tmu[0].dsdx;										\
-				itert0 += v->tmu[0].dtdx;										\
+				iterw0 += poly->tmu[0].dwdx;									\
+				iters0 += poly->tmu[0].dsdx;									\
+				itert0 += poly->tmu[0].dtdx;									\
 			}																	\
 			if (TMUS >= 2)														\
 			{																	\
-				iterw1 += v->tmu[1].dwdx;										\
-				iters1 += v->tmu[1].dsdx;										\
-				itert1 += v->tmu[1].dtdx;										\
+				iterw1 += poly->tmu[1].dwdx;									\
+				iters1 += poly->tmu[1].dsdx;									\
+				itert1 += poly->tmu[1].dtdx;									\
 			}																	\
 		}																		\
 	}																			\
@@ -185,6 +185,7 @@ UINT32 reciplog[(2 << RECIPLOG_LOOKUP_BITS) + 2];
  *
  *************************************/
 
+static void voodoo_exit(running_machine *machine);
 static void init_fbi(voodoo_state *v, fbi_state *f, void *memory, int fbmem);
 static void init_tmu_shared(tmu_shared_state *s);
 static void init_tmu(voodoo_state *v, tmu_state *t, int type, voodoo_reg *reg, void *memory, int tmem);
@@ -215,10 +216,27 @@ static INT32 setup_and_draw_triangle(voodoo_state *v);
 static raster_info *add_rasterizer(voodoo_state *v, const raster_info *cinfo);
 static raster_info *find_rasterizer(voodoo_state *v, int texcount);
 static void dump_rasterizer_stats(voodoo_state *v);
+static INT32 compute_triangle_extent(voodoo_state *v, INT32 *starty, INT32 *stopy);
+static void *raster_band_callback(void *param);
+static void raster_flush(voodoo_state *v);
+static void raster_finish(voodoo_state *v, raster_batch *batch);
+static void raster_wait(voodoo_state *v);
 
-static void raster_generic_0tmu(voodoo_state *v, UINT16 *drawbuf);
-static void raster_generic_1tmu(voodoo_state *v, UINT16 *drawbuf);
-static void raster_generic_2tmu(voodoo_state *v, UINT16 *drawbuf);
+static void raster_generic_0tmu(const raster_poly *poly, raster_band *band);
+static void raster_generic_1tmu(const raster_poly *poly, raster_band *band);
+static void raster_generic_2tmu(const raster_poly *poly, raster_band *band);
+
+
+
+/*************************************
+ *
+ *  Compiled rasterizers
+ *
+ *************************************/
+
+#ifdef VOODOO_DRC
+#include "voodrc.c"
+#endif
 
 
 
@@ -330,12 +348,20 @@ void voodoo_start(int which, int scrnum, int type, int fbmem_in_mb, int tmem0_in
 	v->trigger = 51324 + which;
 
 	/* build the rasterizer table */
-#ifndef VOODOO_DRC
 {
 	const raster_info *info;
 	for (info = predef_raster_table; info->callback; info++)
 		add_rasterizer(v, info);
 }
+
+	/* create a queue for rasterizing large triangles in bands */
+	v->raster_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (which == 0)
+		add_exit_callback(Machine, voodoo_exit);
+
+	/* allocate space for compiled rasterizers */
+#ifdef VOODOO_DRC
+	drc_init(v);
 #endif
 
 	/* set up the PCI FIFO */
@@ -411,6 +437,9 @@ void voodoo_update(int which, mame_bitmap *bitmap, const rectangle *cliprect)
 	int statskey;
 	int x, y;
 
+	/* finish any pending rendering before we look at the buffers */
+	raster_wait(v);
+
 	/* if we are blank, just fill with black */
 	if (v->type <= VOODOO_2 && FBIINIT1_SOFTWARE_BLANK(v->reg[fbiInit1].u))
 	{
@@ -528,6 +557,27 @@ void voodoo_update(int which, mame_bitmap *bitmap, const rectangle *cliprect)
 
 
 
+/*************************************
+ *
+ *  Main destroy routine
+ *
+ *************************************/
+
+static void voodoo_exit(running_machine *machine)
+{
+	int which;
+
+	for (which = 0; which < MAX_VOODOO; which++)
+		if (voodoo[which] != NULL && voodoo[which]->raster_queue != NULL)
+		{
+			raster_wait(voodoo[which]);
+			osd_work_queue_free(voodoo[which]->raster_queue);
+			voodoo[which]->raster_queue = NULL;
+		}
+}
+
+
+
 /*************************************
  *
  *  Chip reset
@@ -867,6 +917,9 @@ static void swap_buffers(voodoo_state *v)
 
 	if (LOG_VBLANK_SWAP) logerror("--- swap_buffers @ %d\n", video_screen_get_vpos(v->scrnum));
 
+	/* finish drawing into the back buffer before it becomes visible */
+	raster_wait(v);
+
 	/* force a partial update */
 	video_screen_update_partial(v->scrnum, video_screen_get_vpos(v->scrnum));
 
@@ -941,6 +994,8 @@ static void swap_buffers(voodoo_state *v)
 		statsptr += sprintf(statsptr, "Chro:%6d\n", v->stats.total_chroma_fail);
 		statsptr += sprintf(statsptr, "ZFun:%6d\n", v->stats.total_zfunc_fail);
 		statsptr += sprintf(statsptr, "AFun:%6d\n", v->stats.total_afunc_fail);
+		statsptr += sprintf(statsptr, "Band:%6d\n", v->stats.total_bands);
+		statsptr += sprintf(statsptr, "Wait:%6d\n", v->stats.total_waits);
 		statsptr += sprintf(statsptr, "RegW:%6d\n", v->stats.reg_writes);
 		statsptr += sprintf(statsptr, "RegR:%6d\n", v->stats.reg_reads);
 		statsptr += sprintf(statsptr, "LFBW:%6d\n", v->stats.lfb_writes);
@@ -963,6 +1018,8 @@ static void swap_buffers(voodoo_state *v)
 	v->stats.total_afunc_fail = 0;
 	v->stats.total_clipped = 0;
 	v->stats.total_stippled = 0;
+	v->stats.total_bands = 0;
+	v->stats.total_waits = 0;
 	v->stats.reg_writes = 0;
 	v->stats.reg_reads = 0;
 	v->stats.lfb_writes = 0;
@@ -1045,6 +1102,7 @@ static TIMER_CALLBACK_PTR( vblank_callback )
 
 static void reset_counters(voodoo_state *v)
 {
+	raster_wait(v);
 	v->reg[fbiPixelsIn].u = 0;
 	v->reg[fbiChromaFail].u = 0;
 	v->reg[fbiZfuncFail].u = 0;
@@ -1055,6 +1113,7 @@ static void reset_counters(voodoo_state *v)
 
 static void soft_reset(voodoo_state *v)
 {
+	raster_wait(v);
 	reset_counters(v);
 	v->reg[fbiTrianglesOut].u = 0;
 	fifo_reset(&v->fbi.fifo);
@@ -2659,6 +2718,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case nccTable+9:
 		case nccTable+10:
 		case nccTable+11:
+			raster_wait(v);
 			if (chips & 2) ncc_table_write(&v->tmu[0].ncc[0], regnum - nccTable, data);
 			if (chips & 4) ncc_table_write(&v->tmu[1].ncc[0], regnum - nccTable, data);
 			break;
@@ -2675,6 +2735,7 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 		case nccTable+21:
 		case nccTable+22:
 		case nccTable+23:
+			raster_wait(v);
 			if (chips & 2) ncc_table_write(&v->tmu[0].ncc[1], regnum - (nccTable+12), data);
 			if (chips & 4) ncc_table_write(&v->tmu[1].ncc[1], regnum - (nccTable+12), data);
 			break;
@@ -2742,6 +2803,15 @@ static INT32 register_w(voodoo_state *v, offs_t offset, UINT32 data)
 			}
 			break;
 
+		/* queued triangles rotate the stipple as they draw */
+		case stipple:
+			raster_wait(v);
+			if (chips & 1) v->reg[0x000 + regnum].u = data;
+			if (chips & 2) v->reg[0x100 + regnum].u = data;
+			if (chips & 4) v->reg[0x200 + regnum].u = data;
+			if (chips & 8) v->reg[0x300 + regnum].u = data;
+			break;
+
 		/* by default, just feed the data to the chips */
 		default:
 			if (chips & 1) v->reg[0x000 + regnum].u = data;
@@ -2781,6 +2851,9 @@ static INT32 lfb_w(voodoo_state *v, offs_t offset, UINT32 data, UINT32 mem_mask,
 	/* statistics */
 	v->stats.lfb_writes++;
 
+	/* anything queued must finish before the state changes */
+	raster_wait(v);
+
 	/* byte swizzling */
 	if (LFBMODE_BYTE_SWIZZLE_WRITES(v->reg[lfbMode].u))
 	{
@@ -3055,6 +3128,11 @@ static INT32 lfb_w(voodoo_state *v, offs_t offset, UINT32 data, UINT32 mem_mask,
 	/* tricky case: run the full pixel pipeline on the pixel */
 	else
 	{
+		stats_block lfbstats = { 0 };
+		stats_block *stats = &lfbstats;
+
+		lfbstats.stipple_pattern = v->reg[stipple].u;
+
 		if (LOG_LFB) logerror("VOODOO.%d.LFB:write pipelined mode %X (%d,%d) = %08X & %08X\n", v->index, LFBMODE_WRITE_FORMAT(v->reg[lfbMode].u), x, y, data, mem_mask);
 
 		/* determine the screen Y */
@@ -3098,6 +3176,16 @@ static INT32 lfb_w(voodoo_state *v, offs_t offset, UINT32 data, UINT32 mem_mask,
 			x++;
 			mask >>= 4;
 		}
+
+		/* fold the pipeline statistics back into the registers */
+		v->reg[fbiPixelsIn].u += lfbstats.pixels_in;
+		v->reg[fbiPixelsOut].u += lfbstats.pixels_out;
+		v->reg[fbiChromaFail].u += lfbstats.chroma_fail;
+		v->reg[fbiZfuncFail].u += lfbstats.zfunc_fail;
+		v->reg[fbiAfuncFail].u += lfbstats.afunc_fail;
+		v->stats.total_clipped += lfbstats.clip_fail;
+		v->stats.total_stippled += lfbstats.stipple_fail;
+		v->reg[stipple].u = lfbstats.stipple_pattern;
 	}
 
 	return 0;
@@ -3119,6 +3207,9 @@ static INT32 texture_w(voodoo_state *v, offs_t offset, UINT32 data)
 	/* statistics */
 	v->stats.tex_writes++;
 
+	/* anything queued must finish before the state changes */
+	raster_wait(v);
+
 	/* point to the right TMU */
 	if (!(v->chipmask & (2 << tmunum)))
 		return 0;
@@ -3552,6 +3643,10 @@ static UINT32 register_r(voodoo_state *v, offs_t offset)
 		return 0xffffffff;
 	}
 
+	/* queued triangles still update the stipple and the pixel counters */
+	if (regnum == stipple || (regnum >= fbiPixelsIn && regnum <= fbiPixelsOut))
+		raster_wait(v);
+
 	/* default result is the FBI register value */
 	result = v->reg[regnum].u;
 
@@ -3725,6 +3820,9 @@ static UINT32 lfb_r(voodoo_state *v, offs_t offset, int forcefront)
 	/* statistics */
 	v->stats.lfb_reads++;
 
+	/* anything queued must finish before we read back results */
+	raster_wait(v);
+
 	/* compute X,Y */
 	x = (offset << 1) & 0x3fe;
 	y = (offset >> 9) & 0x3ff;
@@ -3913,6 +4011,9 @@ static UINT32 banshee_fb_r(voodoo_state *v, offs_t offset, UINT32 mem_mask)
 	if (v->pci.op_pending)
 		flush_fifos(v, mame_timer_get_time());
 
+	/* anything queued must finish before we read back results */
+	raster_wait(v);
+
 	if (offset < v->fbi.lfb_base)
 	{
 		logerror("%08X:banshee_fb_r(%X)\n", activecpu_get_pc(), offset*4);
@@ -4201,6 +4302,9 @@ static void banshee_fb_w(voodoo_state *v, offs_t offset, UINT32 data, UINT32 mem
 	if (v->pci.op_pending)
 		flush_fifos(v, mame_timer_get_time());
 
+	/* anything queued must finish before the state changes */
+	raster_wait(v);
+
 	if (offset < v->fbi.lfb_base)
 	{
 		if (v->fbi.cmdfifo[0].enable && addr >= v->fbi.cmdfifo[0].base && addr < v->fbi.cmdfifo[0].end)
@@ -4285,6 +4389,9 @@ static void banshee_io_w(voodoo_state *v, offs_t offset, UINT32 data, UINT32 mem
 	offset &= 0xff/4;
 	old = v->banshee.io[offset];
 
+	/* anything queued must finish before the state changes */
+	raster_wait(v);
+
 	/* switch off the offset */
 	switch (offset)
 	{
@@ -4377,6 +4484,9 @@ static INT32 fastfill(voodoo_state *v)
 		!FBZMODE_AUX_BUFFER_MASK(v->reg[fbzMode].u))
 		return 0;
 
+	/* queued triangles must land before we clear over them */
+	raster_wait(v);
+
 	/* are we clearing the RGB buffer? */
 	if (FBZMODE_RGB_BUFFER_MASK(v->reg[fbzMode].u))
 	{
@@ -4484,15 +4594,13 @@ static INT32 swapbuffer(voodoo_state *v, UINT32 data)
 
 static INT32 triangle(voodoo_state *v)
 {
-	INT32 start_pixels_in = v->reg[fbiPixelsIn].u;
-	INT32 start_pixels_out = v->reg[fbiPixelsOut].u;
-	INT32 start_chroma_fail = v->reg[fbiChromaFail].u;
-	INT32 start_zfunc_fail = v->reg[fbiZfuncFail].u;
-	INT32 start_afunc_fail = v->reg[fbiAfuncFail].u;
+	raster_batch *batch;
+	raster_poly *poly;
 	raster_info *info;
 	int texcount = 0;
 	UINT16 *drawbuf;
-	int destbuf;
+	INT32 starty, stopy, pixels;
+	int destbuf, tmunum;
 
 	profiler_mark(PROFILER_USER2);
 
@@ -4556,27 +4664,372 @@ static INT32 triangle(voodoo_state *v)
 
 	/* find a rasterizer that matches our current state */
 	info = find_rasterizer(v, texcount);
-	(*info->callback)(v, drawbuf);
 	info->polys++;
-	info->hits += v->reg[fbiPixelsIn].u - start_pixels_in;
 
-	/* update stats */
-	v->reg[fbiTrianglesOut].u++;
+	/* figure out how many rows and pixels we cover; this sets our timing */
+	pixels = compute_triangle_extent(v, &starty, &stopy);
+	info->hits += pixels;
+
+	/* stippled triangles need the stipple as left by everything before them */
+	if (FBZMODE_ENABLE_STIPPLE(v->reg[fbzMode].u))
+		raster_wait(v);
+
+	/* start a new batch if this one is full */
+	batch = &v->batch[v->curbatch];
+	if (batch->polys == RASTER_BATCH_POLYS)
+	{
+		raster_flush(v);
+		batch = &v->batch[v->curbatch];
+	}
+
+	/* queue a copy of everything the rasterizer looks at */
+	poly = &batch->poly[batch->polys++];
+	poly->info = info;
+	poly->drawbuf = drawbuf;
+	poly->starty = starty;
+	poly->stopy = stopy;
+	poly->stipplereg = v->reg[stipple].u;
+	memcpy(&poly->reg[fbzColorPath], &v->reg[fbzColorPath], (color1 + 1 - fbzColorPath) * sizeof(voodoo_reg));
+
+	poly->fbi.aux = v->fbi.aux;
+	poly->fbi.yorigin = v->fbi.yorigin;
+	poly->fbi.rowpixels = v->fbi.rowpixels;
+	memcpy(poly->fbi.fogblend, v->fbi.fogblend, sizeof(poly->fbi.fogblend));
+	memcpy(poly->fbi.fogdelta, v->fbi.fogdelta, sizeof(poly->fbi.fogdelta));
+	poly->fbi.fogdelta_mask = v->fbi.fogdelta_mask;
+	poly->fbi.ax = v->fbi.ax;
+	poly->fbi.ay = v->fbi.ay;
+	poly->fbi.bx = v->fbi.bx;
+	poly->fbi.by = v->fbi.by;
+	poly->fbi.cx = v->fbi.cx;
+	poly->fbi.cy = v->fbi.cy;
+	poly->fbi.startr = v->fbi.startr;
+	poly->fbi.startg = v->fbi.startg;
+	poly->fbi.startb = v->fbi.startb;
+	poly->fbi.starta = v->fbi.starta;
+	poly->fbi.startz = v->fbi.startz;
+	poly->fbi.startw = v->fbi.startw;
+	poly->fbi.drdx = v->fbi.drdx;
+	poly->fbi.dgdx = v->fbi.dgdx;
+	poly->fbi.dbdx = v->fbi.dbdx;
+	poly->fbi.dadx = v->fbi.dadx;
+	poly->fbi.dzdx = v->fbi.dzdx;
+	poly->fbi.dwdx = v->fbi.dwdx;
+	poly->fbi.drdy = v->fbi.drdy;
+	poly->fbi.dgdy = v->fbi.dgdy;
+	poly->fbi.dbdy = v->fbi.dbdy;
+	poly->fbi.dady = v->fbi.dady;
+	poly->fbi.dzdy = v->fbi.dzdy;
+	poly->fbi.dwdy = v->fbi.dwdy;
+
+	for (tmunum = 0; tmunum < texcount; tmunum++)
+	{
+		tmu_state *t = &v->tmu[tmunum];
+		raster_tmu *pt = &poly->tmu[tmunum];
+
+		pt->ram = t->ram;
+		pt->mask = t->mask;
+		pt->texmode = t->reg[textureMode].u;
+		pt->starts = t->starts;
+		pt->startt = t->startt;
+		pt->startw = t->startw;
+		pt->dsdx = t->dsdx;
+		pt->dtdx = t->dtdx;
+		pt->dwdx = t->dwdx;
+		pt->dsdy = t->dsdy;
+		pt->dtdy = t->dtdy;
+		pt->dwdy = t->dwdy;
+		pt->lodmin = t->lodmin;
+		pt->lodmax = t->lodmax;
+		pt->lodbias = t->lodbias;
+		pt->lodmask = t->lodmask;
+		memcpy(pt->lodoffset, t->lodoffset, sizeof(pt->lodoffset));
+		pt->lodbase = t->lodbase;
+		pt->detailmax = t->detailmax;
+		pt->detailbias = t->detailbias;
+		pt->detailscale = t->detailscale;
+		pt->wmask = t->wmask;
+		pt->hmask = t->hmask;
+		pt->bilinear_mask = t->bilinear_mask;
+		pt->lookup = t->lookup;
+	}
 
-	if (LOG_REGISTERS) logerror("cycles = %d\n", TRIANGLE_SETUP_CLOCKS + v->reg[fbiPixelsIn].u - start_pixels_in);
+	/* grow the batch to cover us */
+	if (batch->polys == 1 || starty < batch->starty)
+		batch->starty = starty;
+	if (batch->polys == 1 || stopy > batch->stopy)
+		batch->stopy = stopy;
+	batch->pixels += pixels;
+
+	/* a rotating stipple depends on the order of the pixels, so draw those */
+	/* right away in one piece */
+	if (FBZMODE_ENABLE_STIPPLE(v->reg[fbzMode].u) && FBZMODE_STIPPLE_PATTERN(v->reg[fbzMode].u) == 0)
+	{
+		batch->single = TRUE;
+		raster_wait(v);
+	}
 
 	/* update stats */
+	v->reg[fbiTrianglesOut].u++;
 	v->stats.total_triangles++;
-	v->stats.total_pixels_in += v->reg[fbiPixelsIn].u - start_pixels_in;
-	v->stats.total_pixels_out += v->reg[fbiPixelsOut].u - start_pixels_out;
-	v->stats.total_chroma_fail += v->reg[fbiChromaFail].u - start_chroma_fail;
-	v->stats.total_zfunc_fail += v->reg[fbiZfuncFail].u - start_zfunc_fail;
-	v->stats.total_afunc_fail += v->reg[fbiAfuncFail].u - start_afunc_fail;
+
+	if (LOG_REGISTERS) logerror("cycles = %d\n", TRIANGLE_SETUP_CLOCKS + pixels);
 
 	profiler_mark(PROFILER_END);
 
 	/* 1 pixel per clock, plus some setup time */
-	return TRIANGLE_SETUP_CLOCKS + v->reg[fbiPixelsIn].u - start_pixels_in;
+	return TRIANGLE_SETUP_CLOCKS + pixels;
+}
+
+
+/*-------------------------------------------------
+    compute_triangle_extent - compute the range
+    of rows a triangle covers and the number of
+    pixels the rasterizer will visit
+-------------------------------------------------*/
+
+static INT32 compute_triangle_extent(voodoo_state *v, INT32 *starty, INT32 *stopy)
+{
+	INT32 dxdy_minmid, dxdy_minmax, dxdy_midmax;
+	INT32 minx, miny, midx, midy, maxx, maxy;
+	INT32 pixels = 0;
+	INT32 y;
+
+	/* sort the vertices the same way the rasterizers do */
+	if (v->fbi.ay <= v->fbi.by)
+	{
+		if (v->fbi.by <= v->fbi.cy)
+		{
+			minx = v->fbi.ax;	miny = v->fbi.ay;
+			midx = v->fbi.bx;	midy = v->fbi.by;
+			maxx = v->fbi.cx;	maxy = v->fbi.cy;
+		}
+		else if (v->fbi.ay <= v->fbi.cy)
+		{
+			minx = v->fbi.ax;	miny = v->fbi.ay;
+			midx = v->fbi.cx;	midy = v->fbi.cy;
+			maxx = v->fbi.bx;	maxy = v->fbi.by;
+		}
+		else
+		{
+			minx = v->fbi.cx;	miny = v->fbi.cy;
+			midx = v->fbi.ax;	midy = v->fbi.ay;
+			maxx = v->fbi.bx;	maxy = v->fbi.by;
+		}
+	}
+	else
+	{
+		if (v->fbi.ay <= v->fbi.cy)
+		{
+			minx = v->fbi.bx;	miny = v->fbi.by;
+			midx = v->fbi.ax;	midy = v->fbi.ay;
+			maxx = v->fbi.cx;	maxy = v->fbi.cy;
+		}
+		else if (v->fbi.by <= v->fbi.cy)
+		{
+			minx = v->fbi.bx;	miny = v->fbi.by;
+			midx = v->fbi.cx;	midy = v->fbi.cy;
+			maxx = v->fbi.ax;	maxy = v->fbi.ay;
+		}
+		else
+		{
+			minx = v->fbi.cx;	miny = v->fbi.cy;
+			midx = v->fbi.bx;	midy = v->fbi.by;
+			maxx = v->fbi.ax;	maxy = v->fbi.ay;
+		}
+	}
+
+	/* compute the slopes as 16.16 numbers */
+	dxdy_minmid = (miny == midy) ? 0 : ((midx - minx) << 16) / (midy - miny);
+	dxdy_minmax = (miny == maxy) ? 0 : ((maxx - minx) << 16) / (maxy - miny);
+	dxdy_midmax = (midy == maxy) ? 0 : ((maxx - midx) << 16) / (maxy - midy);
+
+	/* clamp to full pixels */
+	*starty = (miny + 7) >> 4;
+	*stopy = (maxy + 7) >> 4;
+	if (*stopy < *starty)
+		*stopy = *starty;
+
+	/* count the pixels on each row */
+	for (y = *starty; y < *stopy; y++)
+	{
+		INT32 fully = (y << 4) + 8;
+		INT32 startx, stopx;
+
+		startx = minx + (((fully - miny) * dxdy_minmax) >> 16);
+		if (fully < midy)
+			stopx = minx + (((fully - miny) * dxdy_minmid) >> 16);
+		else
+			stopx = midx + (((fully - midy) * dxdy_midmax) >> 16);
+
+		startx = (startx + 7) >> 4;
+		stopx = (stopx + 7) >> 4;
+		pixels += (startx > stopx) ? (startx - stopx) : (stopx - startx);
+	}
+
+	return pixels;
+}
+
+
+/*-------------------------------------------------
+    raster_flush - start drawing the current
+    batch, and switch to the other one for the
+    triangles that follow
+-------------------------------------------------*/
+
+static void raster_flush(voodoo_state *v)
+{
+	raster_batch *batch = &v->batch[v->curbatch];
+	int bands, bandnum;
+
+	/* nothing to do if nothing is queued */
+	if (batch->polys == 0)
+		return;
+
+	/* the other batch must be done before this one can draw over it */
+	raster_finish(v, &v->batch[v->curbatch ^ 1]);
+
+	/* split the rows covered into bands; small batches are cheaper to draw */
+	/* right here */
+	bands = (batch->stopy - batch->starty) / RASTER_BAND_MIN_ROWS;
+	if (bands > MAX_RASTER_BANDS)
+		bands = MAX_RASTER_BANDS;
+	if (bands < 1 || batch->pixels < RASTER_BAND_THRESHOLD || v->raster_queue == NULL || batch->single)
+		bands = 1;
+
+	/* set up each band */
+	for (bandnum = 0; bandnum < bands; bandnum++)
+	{
+		raster_band *band = &batch->band[bandnum];
+
+		band->batch = batch;
+		band->starty = batch->starty + (batch->stopy - batch->starty) * bandnum / bands;
+		band->stopy = batch->starty + (batch->stopy - batch->starty) * (bandnum + 1) / bands;
+		memset(&band->stats, 0, sizeof(band->stats));
+		band->rotate = 0;
+	}
+	batch->bands = bands;
+
+	/* a single band is drawn right away */
+	if (bands == 1)
+	{
+		raster_band_callback(&batch->band[0]);
+		raster_finish(v, batch);
+	}
+
+	/* otherwise, hand the bands off to the work queue */
+	else
+	{
+		for (bandnum = 0; bandnum < bands; bandnum++)
+			osd_work_item_queue(v->raster_queue, raster_band_callback, &batch->band[bandnum], WORK_ITEM_FLAG_AUTO_RELEASE);
+		batch->queued = TRUE;
+		v->stats.total_bands += bands;
+	}
+
+	v->curbatch ^= 1;
+}
+
+
+/*-------------------------------------------------
+    raster_band_callback - work queue callback
+    that rasterizes one band of every triangle
+    in a batch, in order
+-------------------------------------------------*/
+
+static void *raster_band_callback(void *param)
+{
+	raster_band *band = param;
+	raster_batch *batch = band->batch;
+	int polynum;
+
+	for (polynum = 0; polynum < batch->polys; polynum++)
+	{
+		const raster_poly *poly = &batch->poly[polynum];
+		UINT32 before;
+
+		if (poly->stopy <= band->starty || poly->starty >= band->stopy)
+			continue;
+
+		/* each triangle starts from the stipple it was queued with; a */
+		/* rotating one is folded back in by counting the pixels it drew */
+		band->stats.stipple_pattern = poly->stipplereg;
+		before = band->stats.pixels_in - band->stats.clip_fail;
+		(*poly->info->callback)(poly, band);
+		if (FBZMODE_STIPPLE_PATTERN(poly->reg[fbzMode].u) == 0)
+			band->rotate += band->stats.pixels_in - band->stats.clip_fail - before;
+	}
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    raster_finish - wait for a batch to finish
+    and fold its statistics back into the chip
+    state
+-------------------------------------------------*/
+
+static void raster_finish(voodoo_state *v, raster_batch *batch)
+{
+	UINT32 rotate = 0;
+	int bandnum;
+
+	/* nothing to do if nothing was drawn */
+	if (batch->bands == 0)
+		return;
+
+	/* wait for the queue if we used it */
+	if (batch->queued)
+	{
+		osd_work_queue_wait(v->raster_queue, 100 * osd_ticks_per_second());
+		v->stats.total_waits++;
+	}
+
+	/* accumulate the statistics from each band */
+	for (bandnum = 0; bandnum < batch->bands; bandnum++)
+	{
+		raster_band *band = &batch->band[bandnum];
+
+		v->reg[fbiPixelsIn].u += band->stats.pixels_in;
+		v->reg[fbiPixelsOut].u += band->stats.pixels_out;
+		v->reg[fbiChromaFail].u += band->stats.chroma_fail;
+		v->reg[fbiZfuncFail].u += band->stats.zfunc_fail;
+		v->reg[fbiAfuncFail].u += band->stats.afunc_fail;
+
+		v->stats.total_pixels_in += band->stats.pixels_in;
+		v->stats.total_pixels_out += band->stats.pixels_out;
+		v->stats.total_chroma_fail += band->stats.chroma_fail;
+		v->stats.total_zfunc_fail += band->stats.zfunc_fail;
+		v->stats.total_afunc_fail += band->stats.afunc_fail;
+		v->stats.total_clipped += band->stats.clip_fail;
+		v->stats.total_stippled += band->stats.stipple_fail;
+
+		rotate += band->rotate;
+	}
+
+	/* the pipeline rotates the stipple once per unclipped pixel */
+	if ((rotate &= 31) != 0)
+		v->reg[stipple].u = (v->reg[stipple].u << rotate) | (v->reg[stipple].u >> (32 - rotate));
+
+	batch->polys = 0;
+	batch->bands = 0;
+	batch->queued = FALSE;
+	batch->single = FALSE;
+	batch->pixels = 0;
+}
+
+
+/*-------------------------------------------------
+    raster_wait - draw everything queued and fold
+    the results back into the chip state; called
+    before any access that conflicts with queued
+    triangles
+-------------------------------------------------*/
+
+static void raster_wait(voodoo_state *v)
+{
+	raster_flush(v);
+	raster_finish(v, &v->batch[0]);
+	raster_finish(v, &v->batch[1]);
 }
 
 
@@ -4845,10 +5298,10 @@ static raster_info *find_rasterizer(voodoo_state *v, int texcount)
 		}
 
 	/* attempt to generate one */
-#ifdef VOODOO_DRC
-	curinfo.callback = generate_rasterizer(v);
 	curinfo.is_generic = FALSE;
-	if (curinfo.callback == NULL)
+#ifdef VOODOO_DRC
+	curinfo.drc_span = NULL;
+	if (!generate_rasterizer(v, &curinfo))
 #endif
 	{
 		curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
@@ -4910,14 +5363,14 @@ static void dump_rasterizer_stats(voodoo_state *v)
  *
  *************************************/
 
-RASTERIZER(generic_0tmu, 0, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[alphaMode].u,
-			v->reg[fogMode].u, 0, 0)
+RASTERIZER(generic_0tmu, 0, poly->reg[fbzColorPath].u, poly->reg[fbzMode].u, poly->reg[alphaMode].u,
+			poly->reg[fogMode].u, 0, 0)
 
-RASTERIZER(generic_1tmu, 1, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[alphaMode].u,
-			v->reg[fogMode].u, v->tmu[0].reg[textureMode].u, 0)
+RASTERIZER(generic_1tmu, 1, poly->reg[fbzColorPath].u, poly->reg[fbzMode].u, poly->reg[alphaMode].u,
+			poly->reg[fogMode].u, poly->tmu[0].texmode, 0)
 
-RASTERIZER(generic_2tmu, 2, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[alphaMode].u,
-			v->reg[fogMode].u, v->tmu[0].reg[textureMode].u, v->tmu[1].reg[textureMode].u)
+RASTERIZER(generic_2tmu, 2, poly->reg[fbzColorPath].u, poly->reg[fbzMode].u, poly->reg[alphaMode].u,
+			poly->reg[fogMode].u, poly->tmu[0].texmode, poly->tmu[1].texmode)
 
 
 
@@ -0,0 +1,1136 @@
+/*************************************************************************
+
+    3dfx Voodoo Graphics SST-1/2 emulator
+
+    x86-64 compiled rasterizers
+
+    This file is #included by voodoo.c when VOODOO_DRC is defined.
+
+    Each new combination of fbzColorPath/alphaMode/fogMode/fbzMode is
+    handed to generate_rasterizer(), which either compiles a span
+    function for it or returns FALSE so that the generic rasterizer is
+    used instead. The compiled code only covers the inner X loop; the
+    triangle walk, clipping, and stipple/statistics bookkeeping are done
+    in C by raster_drc() below, so the register side effects are
+    identical to the C pipeline.
+
+    Currently handled:
+        * untextured triangles
+        * iterated, color1, or zero RGB, optionally inverted
+        * a single texture on TMU0 used as the RGB source: point-sampled
+          or bilinear, perspective-correct or not, 8-bit or 16-bit,
+          clamped or wrapped, with LOD dithering, passing through either
+          the texel color or its alpha
+        * Z-buffering with any depth function (no bias, no W-buffer)
+        * 4x4 and 2x2 dithering
+        * RGB and aux (depth) buffer writes
+        * wrapped or clamped RGBZ iterators
+
+    The texture unit itself is only compiled for its pass-through
+    combine modes, and raster_drc() hands off triangles where TMU1 is
+    live or TMU0 is disabled. Everything else (texture combining, fog,
+    alpha blend/test/mask, chroma key, stippling, alpha planes) falls
+    back to the C rasterizers.
+
+**************************************************************************/
+
+#ifndef PTR64
+#error The compiled Voodoo rasterizers require an x86-64 build
+#endif
+
+#include <stddef.h>
+#include "cpu/x86emit.h"
+
+
+/*************************************
+ *
+ *  Constants
+ *
+ *************************************/
+
+/* size of the compiled rasterizer cache */
+#define DRC_CACHE_SIZE			(1024 * 1024)
+
+/* worst-case size of a single span function */
+#define DRC_MAX_SPAN_SIZE		4096
+
+/* first argument register for the host ABI */
+#ifdef _WIN64
+#define REG_PARAM1				REG_RCX
+#else
+#define REG_PARAM1				REG_RDI
+#endif
+
+/* register assignments inside the span function */
+#define SPANREG_PARAMS			REG_RBP		/* pointer to the drc_span */
+#define SPANREG_DEST			REG_RSI		/* destination row */
+#define SPANREG_DEPTH			REG_RDI		/* depth row */
+#define SPANREG_DITHER			REG_R8		/* dither matrix row */
+#define SPANREG_DITH			REG_R9D		/* current dither value */
+#define SPANREG_X				REG_RCX		/* current X */
+#define SPANREG_ITERR			REG_R10D	/* iterated R */
+#define SPANREG_ITERG			REG_R11D	/* iterated G */
+#define SPANREG_ITERB			REG_R12D	/* iterated B */
+#define SPANREG_ITERZ			REG_R13D	/* iterated Z */
+#define SPANREG_ZFAIL			REG_R14D	/* depth test failure count */
+#define SPANREG_PIXEL			REG_R15D	/* assembled 565 pixel */
+
+/* where the color path's RGB comes from */
+enum
+{
+	SOURCE_CONSTANT,
+	SOURCE_ITERATED,
+	SOURCE_TEXEL
+};
+
+/* memory operand for a drc_span field */
+#define SPANPARAM(field)		MBD(SPANREG_PARAMS, offsetof(drc_span, field))
+
+
+
+/*************************************
+ *
+ *  Type definitions
+ *
+ *************************************/
+
+/* parameters for one compiled span; filled in by raster_drc() */
+typedef struct _drc_span drc_span;
+struct _drc_span
+{
+	UINT16 *		dest;					/* destination row */
+	UINT16 *		depth;					/* depth row, or NULL */
+	const UINT8 *	dither;					/* dither matrix row */
+	INT32			startx, stopx;			/* X range to draw */
+	INT32			iterr, iterg, iterb;	/* starting R,G,B (12.12) */
+	INT32			iterz;					/* starting Z (20.12) */
+	INT32			drdx, dgdx, dbdx;		/* delta R,G,B per X */
+	INT32			dzdx;					/* delta Z per X */
+	INT32			constr, constg, constb;	/* constant R,G,B if not iterated */
+	INT32			zacolor;				/* constant depth source */
+	INT32			zero, ff, ffff;			/* constants for cmov */
+
+	/* TMU0 parameters */
+	INT64			iters, itert, iterw;	/* current S,T (14.18) and W (2.30) */
+	INT64			dsdx, dtdx, dwdx;		/* delta S,T,W per X */
+	const UINT8 *	texram;					/* texture RAM */
+	const rgb_t *	lookup;					/* texel lookup */
+	const UINT32 *	lodoffset;				/* texture base for each LOD */
+	const UINT8 *	loddither;				/* LOD dither matrix row */
+	INT32			lodbase;				/* LOD base plus bias */
+	INT32			lodmin, lodmax;			/* LOD clamps */
+	UINT32			lodmask;				/* mask of available LODs */
+	UINT32			texmask;				/* mask to apply to texture offsets */
+	UINT32			wmask, hmask;			/* texture width and height masks */
+	UINT32			bilinear_mask;			/* fraction bits kept for filtering */
+
+	/* scratch space for the span function */
+	UINT32			curx;					/* saved X */
+	UINT32			depthval;				/* saved depth value */
+	UINT32			texbase;				/* texture base at this LOD */
+	UINT32			sfrac, tfrac;			/* bilinear fractions */
+	UINT32			factor[4];				/* bilinear weights */
+	UINT32			texel;					/* final texel RGB */
+};
+
+typedef INT32 (*drc_span_func)(drc_span *span);
+
+
+
+/*************************************
+ *
+ *  Mode filtering
+ *
+ *************************************/
+
+/*-------------------------------------------------
+    drc_uses_texel - does the color path take
+    its RGB from the TMU0 texel?
+-------------------------------------------------*/
+
+static int drc_uses_texel(const raster_info *info)
+{
+	UINT32 fbzcp = info->eff_color_path;
+
+	return (FBZCP_CC_RGBSELECT(fbzcp) == 1 && !FBZCP_CC_ZERO_OTHER(fbzcp) && !FBZCP_CC_REVERSE_BLEND(fbzcp) &&
+			info->eff_tex_mode_0 != 0xffffffff);
+}
+
+
+static int drc_mode_supported(const raster_info *info)
+{
+	UINT32 fbzcp = info->eff_color_path;
+	UINT32 fbzmode = info->eff_fbz_mode;
+
+	/* no fog, alpha test, or alpha blending */
+	if (FOGMODE_ENABLE_FOG(info->eff_fog_mode))
+		return FALSE;
+	if (ALPHAMODE_ALPHATEST(info->eff_alpha_mode) || ALPHAMODE_ALPHABLEND(info->eff_alpha_mode))
+		return FALSE;
+
+	/* c_other must be iterated, the texel, or color1; c_local must not contribute */
+	if (FBZCP_CC_RGBSELECT(fbzcp) == 3)
+		return FALSE;
+	if (FBZCP_CC_SUB_CLOCAL(fbzcp) || FBZCP_CC_MSELECT(fbzcp) != 0)
+		return FALSE;
+	if (FBZCP_CC_ADD_ACLOCAL(fbzcp) == 1 || FBZCP_CC_ADD_ACLOCAL(fbzcp) == 2)
+		return FALSE;
+
+	/* TMU0 must pass its c_local or a_local straight through; with */
+	/* c_other zero, that makes the rest of its combine unit a no-op */
+	if (drc_uses_texel(info))
+	{
+		UINT32 texmode = info->eff_tex_mode_0;
+
+		if (TEXMODE_TC_SUB_CLOCAL(texmode))
+			return FALSE;
+		if (TEXMODE_TC_ADD_ACLOCAL(texmode) != 1 && TEXMODE_TC_ADD_ACLOCAL(texmode) != 2)
+			return FALSE;
+	}
+
+	/* no chroma key, alpha mask, stipple, or alpha planes */
+	if (FBZMODE_ENABLE_CHROMAKEY(fbzmode) || FBZMODE_ENABLE_ALPHA_MASK(fbzmode))
+		return FALSE;
+	if (FBZMODE_ENABLE_STIPPLE(fbzmode) || FBZMODE_ENABLE_ALPHA_PLANES(fbzmode))
+		return FALSE;
+
+	/* Z only, no bias */
+	if (FBZMODE_WBUFFER_SELECT(fbzmode) || FBZMODE_ENABLE_DEPTH_BIAS(fbzmode))
+		return FALSE;
+
+	return TRUE;
+}
+
+
+
+/*************************************
+ *
+ *  Code generation
+ *
+ *************************************/
+
+/*-------------------------------------------------
+    emit_clamped_channel - compute an 8-bit
+    channel from a 12.12 iterator into EBX
+-------------------------------------------------*/
+
+static void emit_clamped_channel(x86code **dst, UINT8 iterreg, UINT32 fbzcp)
+{
+	emit_mov_r32_r32(dst, REG_EBX, iterreg);								// mov   ebx,iter
+	emit_sar_r32_imm(dst, REG_EBX, 12);										// sar   ebx,12
+	if (FBZCP_RGBZW_CLAMP(fbzcp) == 0)
+	{
+		emit_and_r32_imm(dst, REG_EBX, 0xfff);								// and   ebx,0xfff
+		emit_mov_r32_r32(dst, REG_EDX, REG_EBX);							// mov   edx,ebx
+		emit_and_r32_imm(dst, REG_EDX, 0xff);								// and   edx,0xff
+		emit_cmp_r32_imm(dst, REG_EBX, 0x100);								// cmp   ebx,0x100
+		emit_cmovcc_r32_m32(dst, COND_E, REG_EDX, SPANPARAM(ff));
+		emit_cmp_r32_imm(dst, REG_EBX, 0xfff);								// cmp   ebx,0xfff
+		emit_cmovcc_r32_m32(dst, COND_E, REG_EDX, SPANPARAM(zero));
+		emit_mov_r32_r32(dst, REG_EBX, REG_EDX);							// mov   ebx,edx
+	}
+	else
+	{
+		emit_cmp_r32_imm(dst, REG_EBX, 0);									// cmp   ebx,0
+		emit_cmovcc_r32_m32(dst, COND_L, REG_EBX, SPANPARAM(zero));
+		emit_cmp_r32_imm(dst, REG_EBX, 0xff);								// cmp   ebx,0xff
+		emit_cmovcc_r32_m32(dst, COND_G, REG_EBX, SPANPARAM(ff));
+	}
+}
+
+
+/*-------------------------------------------------
+    emit_dithered_channel - apply DITHER_RB
+    (shift 1) or DITHER_G (shift 2) to EBX
+-------------------------------------------------*/
+
+static void emit_dithered_channel(x86code **dst, int shift)
+{
+	/* ((val << shift) - (val >> 4) + (val >> (8 - shift)) + dith) >> shift */
+	emit_mov_r32_r32(dst, REG_EDX, REG_EBX);								// mov   edx,ebx
+	emit_shl_r32_imm(dst, REG_EBX, shift);									// shl   ebx,shift
+	emit_shr_r32_imm(dst, REG_EDX, 4);										// shr   edx,4
+	emit_sub_r32_r32(dst, REG_EBX, REG_EDX);								// sub   ebx,edx
+	emit_shr_r32_imm(dst, REG_EDX, 4 - shift);								// shr   edx,4-shift
+	emit_add_r32_r32(dst, REG_EBX, REG_EDX);								// add   ebx,edx
+	emit_add_r32_r32(dst, REG_EBX, SPANREG_DITH);							// add   ebx,dith
+	emit_shr_r32_imm(dst, REG_EBX, shift);									// shr   ebx,shift
+}
+
+
+/*-------------------------------------------------
+    emit_channel - compute one output channel,
+    dither it, and merge it into PIXEL
+-------------------------------------------------*/
+
+static void emit_channel(x86code **dst, const raster_info *info, int source, UINT8 iterreg, int constoffs, int index)
+{
+	static const UINT32 mask[3] = { 0xf8, 0xfc, 0xf8 };
+	UINT32 fbzcp = info->eff_color_path;
+	UINT32 fbzmode = info->eff_fbz_mode;
+
+	/* fetch the value */
+	if (source == SOURCE_ITERATED)
+		emit_clamped_channel(dst, iterreg, fbzcp);
+	else if (source == SOURCE_TEXEL)
+		emit_movzx_r32_m8(dst, REG_EBX, MBD(SPANREG_PARAMS, offsetof(drc_span, texel) + 2 - index));
+	else
+		emit_mov_r32_m32(dst, REG_EBX, MBD(SPANREG_PARAMS, constoffs));	// mov   ebx,[const]
+
+	/* invert */
+	if (FBZCP_CC_INVERT_OUTPUT(fbzcp))
+		emit_xor_r32_imm(dst, REG_EBX, 0xff);								// xor   ebx,0xff
+
+	/* dither */
+	if (FBZMODE_ENABLE_DITHERING(fbzmode))
+		emit_dithered_channel(dst, (index == 1) ? 2 : 1);
+
+	/* merge into the pixel */
+	emit_and_r32_imm(dst, REG_EBX, mask[index]);							// and   ebx,mask
+	if (index == 0)
+	{
+		emit_shl_r32_imm(dst, REG_EBX, 8);									// shl   ebx,8
+		emit_mov_r32_r32(dst, SPANREG_PIXEL, REG_EBX);						// mov   pixel,ebx
+	}
+	else
+	{
+		if (index == 1)
+			emit_shl_r32_imm(dst, REG_EBX, 3);								// shl   ebx,3
+		else
+			emit_shr_r32_imm(dst, REG_EBX, 3);								// shr   ebx,3
+		emit_or_r32_r32(dst, SPANREG_PIXEL, REG_EBX);						// or    pixel,ebx
+	}
+}
+
+
+/*-------------------------------------------------
+    emit_reciplog - compute fast_reciplog() of
+    the TMU0 W into EAX, and the log into EBX
+-------------------------------------------------*/
+
+static void emit_reciplog(x86code **dst)
+{
+	emit_link nospill, nonzero, posexp, signfix, done;
+
+	/* take the absolute value, keeping the sign mask in R9 */
+	emit_mov_r64_m64(dst, REG_RAX, SPANPARAM(iterw));						// mov   rax,[iterw]
+	emit_mov_r64_r64(dst, REG_R9, REG_RAX);									// mov   r9,rax
+	emit_sar_r64_imm(dst, REG_R9, 63);										// sar   r9,63
+	emit_xor_r64_r64(dst, REG_RAX, REG_R9);									// xor   rax,r9
+	emit_sub_r64_r64(dst, REG_RAX, REG_R9);									// sub   rax,r9
+
+	/* push values that spill out of 32 bits down; R15D holds the exponent */
+	emit_xor_r32_r32(dst, REG_R15D, REG_R15D);								// xor   r15d,r15d
+	emit_mov_r64_r64(dst, REG_RDX, REG_RAX);								// mov   rdx,rax
+	emit_shr_r64_imm(dst, REG_RDX, 32);										// shr   rdx,32
+	emit_test_r32_imm(dst, REG_EDX, 0xffff);								// test  edx,0xffff
+	emit_jcc_short_link(dst, COND_Z, &nospill);								// jz    nospill
+	emit_shr_r64_imm(dst, REG_RAX, 16);										// shr   rax,16
+	emit_mov_r32_imm(dst, REG_R15D, -16);									// mov   r15d,-16
+	resolve_link(dst, &nospill);										// nospill:
+
+	/* a zero value has an infinite reciprocal */
+	emit_test_r32_r32(dst, REG_EAX, REG_EAX);								// test  eax,eax
+	emit_jcc_short_link(dst, COND_NZ, &nonzero);							// jnz   nonzero
+	emit_mov_r32_imm(dst, REG_EBX, 1000 << LOG_OUTPUT_PREC);				// mov   ebx,1000<<8
+	emit_mov_r32_imm(dst, REG_EAX, 0x7fffffff);								// mov   eax,0x7fffffff
+	emit_xor_r32_r32(dst, REG_EAX, REG_R9D);								// xor   eax,r9d
+	emit_jmp_near_link(dst, &done);											// jmp   done
+	resolve_link(dst, &nonzero);										// nonzero:
+
+	/* normalize */
+	emit_bsr_r32_r32(dst, REG_EDX, REG_EAX);								// bsr   edx,eax
+	emit_mov_r32_imm(dst, REG_ECX, 31);										// mov   ecx,31
+	emit_sub_r32_r32(dst, REG_ECX, REG_EDX);								// sub   ecx,edx
+	emit_shl_r32_cl(dst, REG_EAX);											// shl   eax,cl
+	emit_add_r32_r32(dst, REG_R15D, REG_ECX);								// add   r15d,ecx
+
+	/* find the table entries and the interpolation value */
+	emit_mov_r32_r32(dst, REG_EDX, REG_EAX);								// mov   edx,eax
+	emit_shr_r32_imm(dst, REG_EDX, 31 - RECIPLOG_LOOKUP_BITS - 1);			// shr   edx,21
+	emit_and_r32_imm(dst, REG_EDX, (2 << RECIPLOG_LOOKUP_BITS) - 2);		// and   edx,0x3fe
+	emit_mov_r32_r32(dst, REG_EBX, REG_EAX);								// mov   ebx,eax
+	emit_shr_r32_imm(dst, REG_EBX, 31 - RECIPLOG_LOOKUP_BITS - 8);			// shr   ebx,14
+	emit_and_r32_imm(dst, REG_EBX, 0xff);									// and   ebx,0xff
+	emit_mov_r64_imm(dst, REG_RAX, (FPTR)reciplog);							// mov   rax,reciplog
+	emit_lea_r64_m64(dst, REG_RAX, MBISD(REG_RAX, REG_RDX, 4, 0));			// lea   rax,[rax+rdx*4]
+
+	/* interpolate the log into EDX and the reciprocal into ECX */
+	emit_mov_r32_imm(dst, REG_ECX, 0x100);									// mov   ecx,0x100
+	emit_sub_r32_r32(dst, REG_ECX, REG_EBX);								// sub   ecx,ebx
+	emit_mov_r32_m32(dst, REG_EDX, MBD(REG_RAX, 4));						// mov   edx,[rax+4]
+	emit_imul_r32_r32(dst, REG_EDX, REG_ECX);								// imul  edx,ecx
+	emit_imul_r32_m32(dst, REG_ECX, MBD(REG_RAX, 0));						// imul  ecx,[rax]
+	emit_mov_r32_r32(dst, REG_R10D, REG_EBX);								// mov   r10d,ebx
+	emit_imul_r32_m32(dst, REG_R10D, MBD(REG_RAX, 12));						// imul  r10d,[rax+12]
+	emit_add_r32_r32(dst, REG_EDX, REG_R10D);								// add   edx,r10d
+	emit_imul_r32_m32(dst, REG_EBX, MBD(REG_RAX, 8));						// imul  ebx,[rax+8]
+	emit_add_r32_r32(dst, REG_ECX, REG_EBX);								// add   ecx,ebx
+	emit_shr_r32_imm(dst, REG_EDX, 8);										// shr   edx,8
+	emit_shr_r32_imm(dst, REG_ECX, 8);										// shr   ecx,8
+
+	/* round the log and subtract it from the exponent */
+	emit_add_r32_imm(dst, REG_EDX, 1 << (RECIPLOG_LOOKUP_PREC - LOG_OUTPUT_PREC - 1));
+	emit_shr_r32_imm(dst, REG_EDX, RECIPLOG_LOOKUP_PREC - LOG_OUTPUT_PREC);
+	emit_lea_r32_m32(dst, REG_EBX, MBD(REG_R15, 1));						// lea   ebx,[r15+1]
+	emit_shl_r32_imm(dst, REG_EBX, LOG_OUTPUT_PREC);						// shl   ebx,8
+	emit_sub_r32_r32(dst, REG_EBX, REG_EDX);								// sub   ebx,edx
+
+	/* shift the reciprocal into place and apply the sign */
+	emit_mov_r32_r32(dst, REG_EAX, REG_ECX);								// mov   eax,ecx
+	emit_lea_r32_m32(dst, REG_ECX, MBD(REG_R15, (RECIP_OUTPUT_PREC - RECIPLOG_LOOKUP_PREC) - (31 - RECIPLOG_INPUT_PREC)));
+	emit_test_r32_r32(dst, REG_ECX, REG_ECX);								// test  ecx,ecx
+	emit_jcc_short_link(dst, COND_NS, &posexp);								// jns   posexp
+	emit_neg_r32(dst, REG_ECX);												// neg   ecx
+	emit_shr_r32_cl(dst, REG_EAX);											// shr   eax,cl
+	emit_jmp_short_link(dst, &signfix);										// jmp   signfix
+	resolve_link(dst, &posexp);											// posexp:
+	emit_shl_r32_cl(dst, REG_EAX);											// shl   eax,cl
+	resolve_link(dst, &signfix);										// signfix:
+	emit_xor_r32_r32(dst, REG_EAX, REG_R9D);								// xor   eax,r9d
+	emit_sub_r32_r32(dst, REG_EAX, REG_R9D);								// sub   eax,r9d
+	resolve_link(dst, &done);											// done:
+}
+
+
+/*-------------------------------------------------
+    emit_clamp_coord - clamp the coordinate in
+    'reg' to 0..'maxreg'
+-------------------------------------------------*/
+
+static void emit_clamp_coord(x86code **dst, UINT8 reg, UINT8 maxreg)
+{
+	emit_cmp_r32_imm(dst, reg, 0);											// cmp   reg,0
+	emit_cmovcc_r32_m32(dst, COND_L, reg, SPANPARAM(zero));					// cmovl reg,[zero]
+	emit_cmp_r32_r32(dst, reg, maxreg);										// cmp   reg,max
+	emit_cmovcc_r32_r32(dst, COND_G, reg, maxreg);							// cmovg reg,max
+}
+
+
+/*-------------------------------------------------
+    emit_fetch_texel - turn the texel offset in
+    'reg' into an ARGB value in 'reg'; clobbers
+    RAX and EDX
+-------------------------------------------------*/
+
+static void emit_fetch_texel(x86code **dst, UINT32 texmode, UINT8 reg)
+{
+	int format = TEXMODE_FORMAT(texmode);
+
+	/* read the raw texel */
+	if (format >= 8)
+		emit_add_r32_r32(dst, reg, reg);									// add   reg,reg
+	emit_add_r32_m32(dst, reg, SPANPARAM(texbase));							// add   reg,[texbase]
+	emit_and_r32_m32(dst, reg, SPANPARAM(texmask));							// and   reg,[texmask]
+	emit_mov_r64_m64(dst, REG_RAX, SPANPARAM(texram));						// mov   rax,[texram]
+	if (format < 8)
+		emit_movzx_r32_m8(dst, reg, MBISD(REG_RAX, reg, 1, 0));				// movzx reg,byte [rax+reg]
+	else
+		emit_movzx_r32_m16(dst, reg, MBISD(REG_RAX, reg, 1, 0));			// movzx reg,word [rax+reg]
+
+	/* look it up; 16-bit formats with alpha in the upper byte only look up the low byte */
+	emit_mov_r64_m64(dst, REG_RAX, SPANPARAM(lookup));						// mov   rax,[lookup]
+	if (format < 8 || format == 10)
+		emit_mov_r32_m32(dst, reg, MBISD(REG_RAX, reg, 4, 0));				// mov   reg,[rax+reg*4]
+	else
+	{
+		emit_movzx_r32_r8(dst, REG_EDX, reg);								// movzx edx,regb
+		emit_mov_r32_m32(dst, REG_EDX, MBISD(REG_RAX, REG_RDX, 4, 0));		// mov   edx,[rax+rdx*4]
+		emit_and_r32_imm(dst, REG_EDX, 0xffffff);							// and   edx,0xffffff
+		emit_and_r32_imm(dst, reg, 0xff00);									// and   reg,0xff00
+		emit_shl_r32_imm(dst, reg, 16);										// shl   reg,16
+		emit_or_r32_r32(dst, reg, REG_EDX);									// or    reg,edx
+	}
+}
+
+
+/*-------------------------------------------------
+    emit_point_sample - fetch the texel at S,T
+    (EAX,EDX) into EAX; ECX holds the LOD index,
+    R15D and R9D the S and T masks
+-------------------------------------------------*/
+
+static void emit_point_sample(x86code **dst, UINT32 texmode)
+{
+	/* strip the fractions */
+	emit_add_r32_imm(dst, REG_ECX, 18);										// add   ecx,18
+	emit_sar_r32_cl(dst, REG_EAX);											// sar   eax,cl
+	emit_sar_r32_cl(dst, REG_EDX);											// sar   edx,cl
+
+	/* clamp/wrap and combine into an offset */
+	if (TEXMODE_CLAMP_S(texmode))
+		emit_clamp_coord(dst, REG_EAX, REG_R15D);
+	if (TEXMODE_CLAMP_T(texmode))
+		emit_clamp_coord(dst, REG_EDX, REG_R9D);
+	emit_and_r32_r32(dst, REG_EAX, REG_R15D);								// and   eax,r15d
+	emit_and_r32_r32(dst, REG_EDX, REG_R9D);								// and   edx,r9d
+	emit_add_r32_imm(dst, REG_R15D, 1);										// add   r15d,1
+	emit_imul_r32_r32(dst, REG_EDX, REG_R15D);								// imul  edx,r15d
+	emit_lea_r32_m32(dst, REG_EBX, MBISD(REG_RDX, REG_RAX, 1, 0));			// lea   ebx,[rdx+rax]
+
+	emit_fetch_texel(dst, texmode, REG_EBX);
+	emit_mov_r32_r32(dst, REG_EAX, REG_EBX);								// mov   eax,ebx
+}
+
+
+/*-------------------------------------------------
+    emit_bilinear_weigh - accumulate one texel
+    times one weight into EBX (AG) and ECX (RB)
+-------------------------------------------------*/
+
+static void emit_bilinear_weigh(x86code **dst, UINT8 reg, int index)
+{
+	UINT8 agreg = (index == 0) ? REG_EBX : REG_EAX;
+	UINT8 rbreg = (index == 0) ? REG_ECX : reg;
+
+	emit_mov_r32_r32(dst, agreg, reg);										// mov   ag,texel
+	emit_shr_r32_imm(dst, agreg, 8);										// shr   ag,8
+	emit_and_r32_imm(dst, agreg, 0x00ff00ff);								// and   ag,0x00ff00ff
+	emit_imul_r32_m32(dst, agreg, MBD(SPANREG_PARAMS, offsetof(drc_span, factor) + 4 * index));
+	if (rbreg != reg)
+		emit_mov_r32_r32(dst, rbreg, reg);									// mov   rb,texel
+	emit_and_r32_imm(dst, rbreg, 0x00ff00ff);								// and   rb,0x00ff00ff
+	emit_imul_r32_m32(dst, rbreg, MBD(SPANREG_PARAMS, offsetof(drc_span, factor) + 4 * index));
+	if (index != 0)
+	{
+		emit_add_r32_r32(dst, REG_EBX, agreg);								// add   ebx,ag
+		emit_add_r32_r32(dst, REG_ECX, rbreg);								// add   ecx,rb
+	}
+}
+
+
+/*-------------------------------------------------
+    emit_bilinear_sample - filter the four texels
+    around S,T (EAX,EDX) into EAX; ECX holds the
+    LOD index, R15D and R9D the S and T masks
+-------------------------------------------------*/
+
+static void emit_bilinear_sample(x86code **dst, UINT32 texmode)
+{
+	/* keep 8 bits of fraction and subtract half a texel */
+	emit_add_r32_imm(dst, REG_ECX, 10);										// add   ecx,10
+	emit_sar_r32_cl(dst, REG_EAX);											// sar   eax,cl
+	emit_sar_r32_cl(dst, REG_EDX);											// sar   edx,cl
+	emit_sub_r32_imm(dst, REG_EAX, 0x80);									// sub   eax,0x80
+	emit_sub_r32_imm(dst, REG_EDX, 0x80);									// sub   edx,0x80
+
+	/* extract the fractions */
+	emit_mov_r32_r32(dst, REG_ECX, REG_EAX);								// mov   ecx,eax
+	emit_and_r32_m32(dst, REG_ECX, SPANPARAM(bilinear_mask));				// and   ecx,[bilinear_mask]
+	emit_mov_m32_r32(dst, SPANPARAM(sfrac), REG_ECX);						// mov   [sfrac],ecx
+	emit_mov_r32_r32(dst, REG_ECX, REG_EDX);								// mov   ecx,edx
+	emit_and_r32_m32(dst, REG_ECX, SPANPARAM(bilinear_mask));				// and   ecx,[bilinear_mask]
+	emit_mov_m32_r32(dst, SPANPARAM(tfrac), REG_ECX);						// mov   [tfrac],ecx
+
+	/* S,S+1 into EAX,ECX and T,T+1 into EDX,EBX */
+	emit_sar_r32_imm(dst, REG_EAX, 8);										// sar   eax,8
+	emit_sar_r32_imm(dst, REG_EDX, 8);										// sar   edx,8
+	emit_lea_r32_m32(dst, REG_ECX, MBD(REG_RAX, 1));						// lea   ecx,[rax+1]
+	emit_lea_r32_m32(dst, REG_EBX, MBD(REG_RDX, 1));						// lea   ebx,[rdx+1]
+
+	/* clamp/wrap and combine into four offsets in R10D-R12D and R9D */
+	if (TEXMODE_CLAMP_S(texmode))
+	{
+		emit_clamp_coord(dst, REG_EAX, REG_R15D);
+		emit_clamp_coord(dst, REG_ECX, REG_R15D);
+	}
+	if (TEXMODE_CLAMP_T(texmode))
+	{
+		emit_clamp_coord(dst, REG_EDX, REG_R9D);
+		emit_clamp_coord(dst, REG_EBX, REG_R9D);
+	}
+	emit_and_r32_r32(dst, REG_EAX, REG_R15D);								// and   eax,r15d
+	emit_and_r32_r32(dst, REG_ECX, REG_R15D);								// and   ecx,r15d
+	emit_and_r32_r32(dst, REG_EDX, REG_R9D);								// and   edx,r9d
+	emit_and_r32_r32(dst, REG_EBX, REG_R9D);								// and   ebx,r9d
+	emit_add_r32_imm(dst, REG_R15D, 1);										// add   r15d,1
+	emit_imul_r32_r32(dst, REG_EDX, REG_R15D);								// imul  edx,r15d
+	emit_imul_r32_r32(dst, REG_EBX, REG_R15D);								// imul  ebx,r15d
+	emit_lea_r32_m32(dst, REG_R10D, MBISD(REG_RDX, REG_RCX, 1, 0));			// lea   r10d,[rdx+rcx]
+	emit_lea_r32_m32(dst, REG_R11D, MBISD(REG_RBX, REG_RAX, 1, 0));			// lea   r11d,[rbx+rax]
+	emit_lea_r32_m32(dst, REG_R12D, MBISD(REG_RBX, REG_RCX, 1, 0));			// lea   r12d,[rbx+rcx]
+	emit_lea_r32_m32(dst, REG_R9D, MBISD(REG_RDX, REG_RAX, 1, 0));			// lea   r9d,[rdx+rax]
+
+	/* fetch the texels */
+	emit_fetch_texel(dst, texmode, REG_R9D);
+	emit_fetch_texel(dst, texmode, REG_R10D);
+	emit_fetch_texel(dst, texmode, REG_R11D);
+	emit_fetch_texel(dst, texmode, REG_R12D);
+
+	/* compute the weights */
+	emit_mov_r32_m32(dst, REG_ECX, SPANPARAM(sfrac));						// mov   ecx,[sfrac]
+	emit_mov_r32_m32(dst, REG_EDX, SPANPARAM(tfrac));						// mov   edx,[tfrac]
+	emit_mov_r32_imm(dst, REG_EAX, 0x100);									// mov   eax,0x100
+	emit_sub_r32_r32(dst, REG_EAX, REG_ECX);								// sub   eax,ecx
+	emit_mov_r32_imm(dst, REG_EBX, 0x100);									// mov   ebx,0x100
+	emit_sub_r32_r32(dst, REG_EBX, REG_EDX);								// sub   ebx,edx
+	emit_mov_r32_r32(dst, REG_R15D, REG_EAX);								// mov   r15d,eax
+	emit_imul_r32_r32(dst, REG_R15D, REG_EBX);								// imul  r15d,ebx
+	emit_shr_r32_imm(dst, REG_R15D, 8);										// shr   r15d,8
+	emit_mov_m32_r32(dst, MBD(SPANREG_PARAMS, offsetof(drc_span, factor) + 0), REG_R15D);
+	emit_imul_r32_r32(dst, REG_EBX, REG_ECX);								// imul  ebx,ecx
+	emit_shr_r32_imm(dst, REG_EBX, 8);										// shr   ebx,8
+	emit_mov_m32_r32(dst, MBD(SPANREG_PARAMS, offsetof(drc_span, factor) + 4), REG_EBX);
+	emit_imul_r32_r32(dst, REG_EAX, REG_EDX);								// imul  eax,edx
+	emit_shr_r32_imm(dst, REG_EAX, 8);										// shr   eax,8
+	emit_mov_m32_r32(dst, MBD(SPANREG_PARAMS, offsetof(drc_span, factor) + 8), REG_EAX);
+	emit_add_r32_r32(dst, REG_EAX, REG_EBX);								// add   eax,ebx
+	emit_add_r32_r32(dst, REG_EAX, REG_R15D);								// add   eax,r15d
+	emit_neg_r32(dst, REG_EAX);												// neg   eax
+	emit_add_r32_imm(dst, REG_EAX, 0x100);									// add   eax,0x100
+	emit_mov_m32_r32(dst, MBD(SPANREG_PARAMS, offsetof(drc_span, factor) + 12), REG_EAX);
+
+	/* weigh in each texel and recombine */
+	emit_bilinear_weigh(dst, REG_R9D, 0);
+	emit_bilinear_weigh(dst, REG_R10D, 1);
+	emit_bilinear_weigh(dst, REG_R11D, 2);
+	emit_bilinear_weigh(dst, REG_R12D, 3);
+	emit_and_r32_imm(dst, REG_EBX, 0xff00ff00);								// and   ebx,0xff00ff00
+	emit_shr_r32_imm(dst, REG_ECX, 8);										// shr   ecx,8
+	emit_and_r32_imm(dst, REG_ECX, 0x00ff00ff);								// and   ecx,0x00ff00ff
+	emit_or_r32_r32(dst, REG_EBX, REG_ECX);									// or    ebx,ecx
+	emit_mov_r32_r32(dst, REG_EAX, REG_EBX);								// mov   eax,ebx
+}
+
+
+/*-------------------------------------------------
+    emit_texture - run TMU0 for the current pixel
+    and store the RGB result in the span's texel;
+    clobbers everything but RSI, RDI, R8, R13
+    and R14
+-------------------------------------------------*/
+
+static void emit_texture(x86code **dst, const raster_info *info)
+{
+	UINT32 texmode = info->eff_tex_mode_0;
+	int minfilter = TEXMODE_MINIFICATION_FILTER(texmode);
+	int magfilter = TEXMODE_MAGNIFICATION_FILTER(texmode);
+	emit_link negw, bilinear, done;
+
+	/* S and T into EAX and EDX, LOD into EBX */
+	if (TEXMODE_ENABLE_PERSPECTIVE(texmode))
+	{
+		emit_reciplog(dst);
+		emit_movsxd_r64_r32(dst, REG_RAX, REG_EAX);							// movsxd rax,eax
+		emit_mov_r64_r64(dst, REG_RDX, REG_RAX);							// mov   rdx,rax
+		emit_imul_r64_m64(dst, REG_RAX, SPANPARAM(iters));					// imul  rax,[iters]
+		emit_sar_r64_imm(dst, REG_RAX, 29);									// sar   rax,29
+		emit_imul_r64_m64(dst, REG_RDX, SPANPARAM(itert));					// imul  rdx,[itert]
+		emit_sar_r64_imm(dst, REG_RDX, 29);									// sar   rdx,29
+		emit_add_r32_m32(dst, REG_EBX, SPANPARAM(lodbase));					// add   ebx,[lodbase]
+	}
+	else
+	{
+		emit_mov_r64_m64(dst, REG_RAX, SPANPARAM(iters));					// mov   rax,[iters]
+		emit_sar_r64_imm(dst, REG_RAX, 14);									// sar   rax,14
+		emit_mov_r64_m64(dst, REG_RDX, SPANPARAM(itert));					// mov   rdx,[itert]
+		emit_sar_r64_imm(dst, REG_RDX, 14);									// sar   rdx,14
+		emit_mov_r32_m32(dst, REG_EBX, SPANPARAM(lodbase));					// mov   ebx,[lodbase]
+	}
+
+	/* clamp W */
+	if (TEXMODE_CLAMP_NEG_W(texmode))
+	{
+		emit_cmp_m64_imm(dst, SPANPARAM(iterw), 0);							// cmp   [iterw],0
+		emit_jcc_short_link(dst, COND_GE, &negw);							// jge   negw
+		emit_xor_r32_r32(dst, REG_EAX, REG_EAX);							// xor   eax,eax
+		emit_xor_r32_r32(dst, REG_EDX, REG_EDX);							// xor   edx,edx
+		resolve_link(dst, &negw);										// negw:
+	}
+
+	/* dither and clamp the LOD */
+	if (TEXMODE_ENABLE_LOD_DITHER(texmode))
+	{
+		emit_mov_r32_m32(dst, REG_ECX, SPANPARAM(curx));					// mov   ecx,[curx]
+		emit_and_r32_imm(dst, REG_ECX, 3);									// and   ecx,3
+		emit_mov_r64_m64(dst, REG_R9, SPANPARAM(loddither));				// mov   r9,[loddither]
+		emit_movzx_r32_m8(dst, REG_ECX, MBISD(REG_R9, REG_RCX, 1, 0));		// movzx ecx,[r9+rcx]
+		emit_shl_r32_imm(dst, REG_ECX, 4);									// shl   ecx,4
+		emit_add_r32_r32(dst, REG_EBX, REG_ECX);							// add   ebx,ecx
+	}
+	emit_cmp_r32_m32(dst, REG_EBX, SPANPARAM(lodmin));						// cmp   ebx,[lodmin]
+	emit_cmovcc_r32_m32(dst, COND_L, REG_EBX, SPANPARAM(lodmin));			// cmovl ebx,[lodmin]
+	emit_cmp_r32_m32(dst, REG_EBX, SPANPARAM(lodmax));						// cmp   ebx,[lodmax]
+	emit_cmovcc_r32_m32(dst, COND_G, REG_EBX, SPANPARAM(lodmax));			// cmovg ebx,[lodmax]
+
+	/* take the next LOD if we don't own this one */
+	emit_mov_r32_r32(dst, REG_ECX, REG_EBX);								// mov   ecx,ebx
+	emit_sar_r32_imm(dst, REG_ECX, 8);										// sar   ecx,8
+	emit_mov_r32_m32(dst, REG_R9D, SPANPARAM(lodmask));						// mov   r9d,[lodmask]
+	emit_bt_r32_r32(dst, REG_R9D, REG_ECX);									// bt    r9d,ecx
+	emit_cmc(dst);															// cmc
+	emit_adc_r32_imm(dst, REG_ECX, 0);										// adc   ecx,0
+
+	/* texture base and S/T masks at this LOD */
+	emit_mov_r64_m64(dst, REG_R9, SPANPARAM(lodoffset));					// mov   r9,[lodoffset]
+	emit_mov_r32_m32(dst, REG_R9D, MBISD(REG_R9, REG_RCX, 4, 0));			// mov   r9d,[r9+rcx*4]
+	emit_mov_m32_r32(dst, SPANPARAM(texbase), REG_R9D);						// mov   [texbase],r9d
+	emit_mov_r32_m32(dst, REG_R15D, SPANPARAM(wmask));						// mov   r15d,[wmask]
+	emit_shr_r32_cl(dst, REG_R15D);											// shr   r15d,cl
+	emit_mov_r32_m32(dst, REG_R9D, SPANPARAM(hmask));						// mov   r9d,[hmask]
+	emit_shr_r32_cl(dst, REG_R9D);											// shr   r9d,cl
+
+	/* magnification applies only at the minimum LOD */
+	if (minfilter == magfilter)
+	{
+		if (minfilter)
+			emit_bilinear_sample(dst, texmode);
+		else
+			emit_point_sample(dst, texmode);
+	}
+	else
+	{
+		emit_cmp_r32_m32(dst, REG_EBX, SPANPARAM(lodmin));					// cmp   ebx,[lodmin]
+		emit_jcc_near_link(dst, magfilter ? COND_E : COND_NE, &bilinear);	// jcc   bilinear
+		emit_point_sample(dst, texmode);
+		emit_jmp_near_link(dst, &done);										// jmp   done
+		resolve_link(dst, &bilinear);									// bilinear:
+		emit_bilinear_sample(dst, texmode);
+		resolve_link(dst, &done);										// done:
+	}
+
+	/* c_other is zero, so the result is c_local or a_local */
+	if (TEXMODE_TC_ADD_ACLOCAL(texmode) == 1)
+		emit_and_r32_imm(dst, REG_EAX, 0xffffff);							// and   eax,0xffffff
+	else
+	{
+		emit_shr_r32_imm(dst, REG_EAX, 24);									// shr   eax,24
+		emit_imul_r32_r32_imm(dst, REG_EAX, REG_EAX, 0x010101);				// imul  eax,eax,0x010101
+	}
+	if (TEXMODE_TC_INVERT_OUTPUT(texmode))
+		emit_xor_r32_imm(dst, REG_EAX, 0xffffff);							// xor   eax,0xffffff
+	emit_mov_m32_r32(dst, SPANPARAM(texel), REG_EAX);						// mov   [texel],eax
+}
+
+
+/*-------------------------------------------------
+    emit_span - emit a span function for the
+    given rasterizer
+-------------------------------------------------*/
+
+static void emit_span(x86code **dst, const raster_info *info)
+{
+	static const UINT8 pushed[] = { REG_RBX, REG_RBP, REG_RSI, REG_RDI, REG_R12, REG_R13, REG_R14, REG_R15 };
+	UINT32 fbzcp = info->eff_color_path;
+	UINT32 fbzmode = info->eff_fbz_mode;
+	int iterated = (FBZCP_CC_RGBSELECT(fbzcp) == 0 && !FBZCP_CC_ZERO_OTHER(fbzcp) && !FBZCP_CC_REVERSE_BLEND(fbzcp));
+	int textured = drc_uses_texel(info);
+	int source = iterated ? SOURCE_ITERATED : textured ? SOURCE_TEXEL : SOURCE_CONSTANT;
+	int depthfunc = FBZMODE_ENABLE_DEPTHBUF(fbzmode) ? FBZMODE_DEPTH_FUNCTION(fbzmode) : 7;
+	int needdepth = (depthfunc != 0 && depthfunc != 7 && FBZMODE_DEPTH_SOURCE_COMPARE(fbzmode) == 0) || FBZMODE_AUX_BUFFER_MASK(fbzmode);
+	emit_link faillink, skipaux, nextlink;
+	x86code *looptop;
+	int regnum;
+
+	/* prolog: save everything we touch that the ABI says we must */
+	for (regnum = 0; regnum < ARRAY_LENGTH(pushed); regnum++)
+		emit_push_r64(dst, pushed[regnum]);									// push  reg
+	emit_mov_r64_r64(dst, SPANREG_PARAMS, REG_PARAM1);						// mov   rbp,param1
+
+	/* load the loop state */
+	emit_mov_r64_m64(dst, SPANREG_DEST, SPANPARAM(dest));
+	emit_mov_r64_m64(dst, SPANREG_DEPTH, SPANPARAM(depth));
+	emit_mov_r64_m64(dst, SPANREG_DITHER, SPANPARAM(dither));
+	emit_movsxd_r64_m32(dst, SPANREG_X, SPANPARAM(startx));
+	if (iterated)
+	{
+		emit_mov_r32_m32(dst, SPANREG_ITERR, SPANPARAM(iterr));
+		emit_mov_r32_m32(dst, SPANREG_ITERG, SPANPARAM(iterg));
+		emit_mov_r32_m32(dst, SPANREG_ITERB, SPANPARAM(iterb));
+	}
+	emit_mov_r32_m32(dst, SPANREG_ITERZ, SPANPARAM(iterz));
+	emit_xor_r32_r32(dst, SPANREG_ZFAIL, SPANREG_ZFAIL);					// xor   zfail,zfail
+
+	/* top of the X loop */
+	looptop = *dst;
+
+	/* compute the clamped depth value into EAX */
+	if (needdepth)
+	{
+		emit_mov_r32_r32(dst, REG_EAX, SPANREG_ITERZ);						// mov   eax,iterz
+		emit_sar_r32_imm(dst, REG_EAX, 12);									// sar   eax,12
+		if (FBZCP_RGBZW_CLAMP(fbzcp) == 0)
+		{
+			emit_and_r32_imm(dst, REG_EAX, 0xfffff);						// and   eax,0xfffff
+			emit_movzx_r32_r16(dst, REG_EDX, REG_AX);						// movzx edx,ax
+			emit_cmp_r32_imm(dst, REG_EAX, 0x10000);						// cmp   eax,0x10000
+			emit_cmovcc_r32_m32(dst, COND_E, REG_EDX, SPANPARAM(ffff));
+			emit_cmp_r32_imm(dst, REG_EAX, 0xfffff);						// cmp   eax,0xfffff
+			emit_cmovcc_r32_m32(dst, COND_E, REG_EDX, SPANPARAM(zero));
+			emit_mov_r32_r32(dst, REG_EAX, REG_EDX);						// mov   eax,edx
+		}
+		else
+		{
+			emit_cmp_r32_imm(dst, REG_EAX, 0);								// cmp   eax,0
+			emit_cmovcc_r32_m32(dst, COND_L, REG_EAX, SPANPARAM(zero));
+			emit_cmp_r32_imm(dst, REG_EAX, 0xffff);							// cmp   eax,0xffff
+			emit_cmovcc_r32_m32(dst, COND_G, REG_EAX, SPANPARAM(ffff));
+		}
+	}
+
+	/* depth test; the condition is the failure case */
+	if (depthfunc == 0)
+		emit_jmp_near_link(dst, &faillink);									// jmp   fail
+	else if (depthfunc != 7)
+	{
+		static const UINT8 failcond[8] = { 0, COND_GE, COND_NE, COND_G, COND_LE, COND_E, COND_L, 0 };
+		UINT8 srcreg = REG_EAX;
+
+		if (FBZMODE_DEPTH_SOURCE_COMPARE(fbzmode))
+		{
+			emit_mov_r32_m32(dst, REG_EDX, SPANPARAM(zacolor));
+			srcreg = REG_EDX;
+		}
+		emit_movzx_r32_m16(dst, REG_EBX, MBISD(SPANREG_DEPTH, SPANREG_X, 2, 0));	// movzx ebx,depth[x]
+		emit_cmp_r32_r32(dst, srcreg, REG_EBX);								// cmp   src,ebx
+		emit_jcc_near_link(dst, failcond[depthfunc], &faillink);			// jcc   fail
+	}
+
+	/* write to the framebuffer */
+	if (FBZMODE_RGB_BUFFER_MASK(fbzmode))
+	{
+		/* the texture unit needs nearly every register, so save X and the depth value */
+		if (textured)
+		{
+			emit_mov_m32_r32(dst, SPANPARAM(curx), REG_ECX);				// mov   [curx],ecx
+			if (FBZMODE_AUX_BUFFER_MASK(fbzmode))
+				emit_mov_m32_r32(dst, SPANPARAM(depthval), REG_EAX);		// mov   [depthval],eax
+			emit_texture(dst, info);
+			emit_mov_r32_m32(dst, REG_ECX, SPANPARAM(curx));				// mov   ecx,[curx]
+			if (FBZMODE_AUX_BUFFER_MASK(fbzmode))
+				emit_mov_r32_m32(dst, REG_EAX, SPANPARAM(depthval));		// mov   eax,[depthval]
+		}
+
+		if (FBZMODE_ENABLE_DITHERING(fbzmode))
+		{
+			emit_mov_r32_r32(dst, REG_EDX, REG_ECX);						// mov   edx,ecx
+			emit_and_r32_imm(dst, REG_EDX, FBZMODE_DITHER_TYPE(fbzmode) ? 1 : 3);
+			emit_movzx_r32_m8(dst, SPANREG_DITH, MBISD(SPANREG_DITHER, REG_RDX, 1, 0));
+		}
+		emit_channel(dst, info, source, SPANREG_ITERR, offsetof(drc_span, constr), 0);
+		emit_channel(dst, info, source, SPANREG_ITERG, offsetof(drc_span, constg), 1);
+		emit_channel(dst, info, source, SPANREG_ITERB, offsetof(drc_span, constb), 2);
+		emit_mov_m16_r16(dst, MBISD(SPANREG_DEST, SPANREG_X, 2, 0), REG_R15W);	// mov   dest[x],pixel
+	}
+
+	/* write to the aux buffer */
+	if (FBZMODE_AUX_BUFFER_MASK(fbzmode))
+	{
+		emit_test_r64_r64(dst, SPANREG_DEPTH, SPANREG_DEPTH);				// test  depth,depth
+		emit_jcc_short_link(dst, COND_Z, &skipaux);							// jz    skipaux
+		emit_mov_m16_r16(dst, MBISD(SPANREG_DEPTH, SPANREG_X, 2, 0), REG_AX);	// mov   depth[x],ax
+		resolve_link(dst, &skipaux);									// skipaux:
+	}
+
+	/* failed pixels are counted out of line */
+	if (depthfunc != 7)
+	{
+		emit_jmp_short_link(dst, &nextlink);								// jmp   next
+		resolve_link(dst, &faillink);									// fail:
+		emit_add_r32_imm(dst, SPANREG_ZFAIL, 1);							// add   zfail,1
+		resolve_link(dst, &nextlink);									// next:
+	}
+
+	/* update the iterators and loop */
+	if (iterated)
+	{
+		emit_add_r32_m32(dst, SPANREG_ITERR, SPANPARAM(drdx));
+		emit_add_r32_m32(dst, SPANREG_ITERG, SPANPARAM(dgdx));
+		emit_add_r32_m32(dst, SPANREG_ITERB, SPANPARAM(dbdx));
+	}
+	emit_add_r32_m32(dst, SPANREG_ITERZ, SPANPARAM(dzdx));
+	if (textured)
+	{
+		emit_mov_r64_m64(dst, REG_RAX, SPANPARAM(dsdx));					// mov   rax,[dsdx]
+		emit_add_m64_r64(dst, SPANPARAM(iters), REG_RAX);					// add   [iters],rax
+		emit_mov_r64_m64(dst, REG_RAX, SPANPARAM(dtdx));					// mov   rax,[dtdx]
+		emit_add_m64_r64(dst, SPANPARAM(itert), REG_RAX);					// add   [itert],rax
+		emit_mov_r64_m64(dst, REG_RAX, SPANPARAM(dwdx));					// mov   rax,[dwdx]
+		emit_add_m64_r64(dst, SPANPARAM(iterw), REG_RAX);					// add   [iterw],rax
+	}
+	emit_add_r64_imm(dst, SPANREG_X, 1);									// add   rcx,1
+	emit_cmp_r32_m32(dst, REG_ECX, SPANPARAM(stopx));
+	emit_jcc(dst, COND_L, looptop);											// jl    looptop
+
+	/* epilog: return the failure count */
+	emit_mov_r32_r32(dst, REG_EAX, SPANREG_ZFAIL);							// mov   eax,zfail
+	for (regnum = ARRAY_LENGTH(pushed) - 1; regnum >= 0; regnum--)
+		emit_pop_r64(dst, pushed[regnum]);									// pop   reg
+	emit_ret(dst);															// ret
+}
+
+
+
+/*************************************
+ *
+ *  Compiled rasterizer driver
+ *
+ *************************************/
+
+static void raster_drc(const raster_poly *poly, raster_band *band)
+{
+	drc_span_func spanfunc = (drc_span_func)poly->info->drc_span;
+	const raster_tmu *tmu = &poly->tmu[0];
+	int textured = drc_uses_texel(poly->info);
+	UINT16 *drawbuf = poly->drawbuf;
+	stats_block *stats = &band->stats;
+	UINT32 fbzcp = poly->reg[fbzColorPath].u;
+	UINT32 fbzmode = poly->reg[fbzMode].u;
+	INT32 dxdy_minmid, dxdy_minmax, dxdy_midmax;
+	INT32 minx, miny, midx, midy, maxx, maxy;
+	INT32 starty, stopy;
+	INT32 y;
+	drc_span span;
+
+	/* the compiled code assumes TMU0 is enabled and TMU1 contributes nothing */
+	if (textured && (tmu->lodmin >= (8 << 8) || (poly->info->eff_tex_mode_1 != 0xffffffff && poly->tmu[1].lodmin < (8 << 8))))
+	{
+		if (poly->info->eff_tex_mode_1 != 0xffffffff)
+			raster_generic_2tmu(poly, band);
+		else
+			raster_generic_1tmu(poly, band);
+		return;
+	}
+
+	/* constant parameters */
+	span.zero = 0;
+	span.ff = 0xff;
+	span.ffff = 0xffff;
+	span.zacolor = poly->reg[zaColor].u & 0xffff;
+	span.drdx = poly->fbi.drdx;
+	span.dgdx = poly->fbi.dgdx;
+	span.dbdx = poly->fbi.dbdx;
+	span.dzdx = poly->fbi.dzdx;
+	if (FBZCP_CC_ZERO_OTHER(fbzcp) || FBZCP_CC_REVERSE_BLEND(fbzcp) || FBZCP_CC_RGBSELECT(fbzcp) != 2)
+		span.constr = span.constg = span.constb = 0;
+	else
+	{
+		span.constr = RGB_RED(poly->reg[color1].u);
+		span.constg = RGB_GREEN(poly->reg[color1].u);
+		span.constb = RGB_BLUE(poly->reg[color1].u);
+	}
+	if (textured)
+	{
+		span.dsdx = tmu->dsdx;
+		span.dtdx = tmu->dtdx;
+		span.dwdx = tmu->dwdx;
+		span.texram = tmu->ram;
+		span.lookup = tmu->lookup;
+		span.lodoffset = tmu->lodoffset;
+		span.lodbase = tmu->lodbase + tmu->lodbias;
+		span.lodmin = tmu->lodmin;
+		span.lodmax = tmu->lodmax;
+		span.lodmask = tmu->lodmask;
+		span.texmask = tmu->mask;
+		span.wmask = tmu->wmask;
+		span.hmask = tmu->hmask;
+		span.bilinear_mask = tmu->bilinear_mask;
+	}
+
+	/* sort the vertices */
+	if (poly->fbi.ay <= poly->fbi.by)
+	{
+		if (poly->fbi.by <= poly->fbi.cy)
+		{
+			minx = poly->fbi.ax;	miny = poly->fbi.ay;
+			midx = poly->fbi.bx;	midy = poly->fbi.by;
+			maxx = poly->fbi.cx;	maxy = poly->fbi.cy;
+		}
+		else if (poly->fbi.ay <= poly->fbi.cy)
+		{
+			minx = poly->fbi.ax;	miny = poly->fbi.ay;
+			midx = poly->fbi.cx;	midy = poly->fbi.cy;
+			maxx = poly->fbi.bx;	maxy = poly->fbi.by;
+		}
+		else
+		{
+			minx = poly->fbi.cx;	miny = poly->fbi.cy;
+			midx = poly->fbi.ax;	midy = poly->fbi.ay;
+			maxx = poly->fbi.bx;	maxy = poly->fbi.by;
+		}
+	}
+	else
+	{
+		if (poly->fbi.ay <= poly->fbi.cy)
+		{
+			minx = poly->fbi.bx;	miny = poly->fbi.by;
+			midx = poly->fbi.ax;	midy = poly->fbi.ay;
+			maxx = poly->fbi.cx;	maxy = poly->fbi.cy;
+		}
+		else if (poly->fbi.by <= poly->fbi.cy)
+		{
+			minx = poly->fbi.bx;	miny = poly->fbi.by;
+			midx = poly->fbi.cx;	midy = poly->fbi.cy;
+			maxx = poly->fbi.ax;	maxy = poly->fbi.ay;
+		}
+		else
+		{
+			minx = poly->fbi.cx;	miny = poly->fbi.cy;
+			midx = poly->fbi.bx;	midy = poly->fbi.by;
+			maxx = poly->fbi.ax;	maxy = poly->fbi.ay;
+		}
+	}
+
+	/* compute the slopes as 16.16 numbers */
+	dxdy_minmid = (miny == midy) ? 0 : ((midx - minx) << 16) / (midy - miny);
+	dxdy_minmax = (miny == maxy) ? 0 : ((maxx - minx) << 16) / (maxy - miny);
+	dxdy_midmax = (midy == maxy) ? 0 : ((maxx - midx) << 16) / (maxy - midy);
+
+	/* clamp to full pixels, then to our band */
+	starty = (miny + 7) >> 4;
+	stopy = (maxy + 7) >> 4;
+	if (starty < band->starty)
+		starty = band->starty;
+	if (stopy > band->stopy)
+		stopy = band->stopy;
+
+	/* loop in Y */
+	for (y = starty; y < stopy; y++)
+	{
+		INT32 startx, stopx, fully, scry, dx, dy;
+		INT32 pixels, drawn, zfail;
+
+		/* compute X endpoints */
+		fully = (y << 4) + 8;
+		startx = minx + (((fully - miny) * dxdy_minmax) >> 16);
+		if (fully < midy)
+			stopx = minx + (((fully - miny) * dxdy_minmid) >> 16);
+		else
+			stopx = midx + (((fully - midy) * dxdy_midmax) >> 16);
+
+		/* clamp to full pixels */
+		startx = (startx + 7) >> 4;
+		stopx = (stopx + 7) >> 4;
+
+		/* force start < stop */
+		if (startx > stopx)
+		{
+			int temp = startx;
+			startx = stopx;
+			stopx = temp;
+		}
+		pixels = stopx - startx;
+		if (pixels == 0)
+			continue;
+		stats->pixels_in += pixels;
+
+		/* determine the screen Y */
+		scry = y;
+		if (FBZMODE_Y_ORIGIN(fbzmode))
+			scry = (poly->fbi.yorigin - y) & 0x3ff;
+
+		/* apply clipping; clipped pixels never reach the rest of the pipeline */
+		if (FBZMODE_ENABLE_CLIPPING(fbzmode))
+		{
+			INT32 clipleft = (poly->reg[clipLeftRight].u >> 16) & 0x3ff;
+			INT32 clipright = poly->reg[clipLeftRight].u & 0x3ff;
+
+			if (scry < ((poly->reg[clipLowYHighY].u >> 16) & 0x3ff) ||
+				scry >= (poly->reg[clipLowYHighY].u & 0x3ff))
+			{
+				stats->clip_fail += pixels;
+				continue;
+			}
+			if (startx < clipleft)
+				startx = clipleft;
+			if (stopx > clipright)
+				stopx = clipright;
+			drawn = (stopx > startx) ? stopx - startx : 0;
+			stats->clip_fail += pixels - drawn;
+			if (drawn == 0)
+				continue;
+		}
+		else
+			drawn = pixels;
+
+		/* rotate the stipple pattern once per unclipped pixel */
+		if (FBZMODE_STIPPLE_PATTERN(fbzmode) == 0 && (drawn & 31) != 0)
+			stats->stipple_pattern = (stats->stipple_pattern << (drawn & 31)) | (stats->stipple_pattern >> (32 - (drawn & 31)));
+
+		/* get pointers to the target buffer and depth buffer */
+		span.dest = drawbuf + scry * poly->fbi.rowpixels;
+		span.depth = poly->fbi.aux ? (poly->fbi.aux + scry * poly->fbi.rowpixels) : NULL;
+		span.dither = FBZMODE_DITHER_TYPE(fbzmode) ? &dither_matrix_2x2[(y & 1) << 1] : &dither_matrix_4x4[(y & 3) << 2];
+
+		/* compute the starting parameters */
+		dx = startx - (poly->fbi.ax >> 4);
+		dy = y - (poly->fbi.ay >> 4);
+		span.startx = startx;
+		span.stopx = stopx;
+		span.iterr = poly->fbi.startr + dy * poly->fbi.drdy + dx * poly->fbi.drdx;
+		span.iterg = poly->fbi.startg + dy * poly->fbi.dgdy + dx * poly->fbi.dgdx;
+		span.iterb = poly->fbi.startb + dy * poly->fbi.dbdy + dx * poly->fbi.dbdx;
+		span.iterz = poly->fbi.startz + dy * poly->fbi.dzdy + dx * poly->fbi.dzdx;
+		if (textured)
+		{
+			span.iters = tmu->starts + dy * tmu->dsdy + dx * tmu->dsdx;
+			span.itert = tmu->startt + dy * tmu->dtdy + dx * tmu->dtdx;
+			span.iterw = tmu->startw + dy * tmu->dwdy + dx * tmu->dwdx;
+			span.loddither = &dither_matrix_4x4[(y & 3) << 2];
+		}
+
+		/* draw and account for the results */
+		zfail = (*spanfunc)(&span);
+		stats->zfunc_fail += zfail;
+		stats->pixels_out += drawn - zfail;
+	}
+}
+
+
+
+/*************************************
+ *
+ *  Cache management
+ *
+ *************************************/
+
+static void drc_exit(running_machine *machine)
+{
+	int which;
+
+	for (which = 0; which < MAX_VOODOO; which++)
+		if (voodoo[which] != NULL && voodoo[which]->drc_cache != NULL)
+		{
+			osd_free_executable(voodoo[which]->drc_cache, DRC_CACHE_SIZE);
+			voodoo[which]->drc_cache = NULL;
+		}
+}
+
+
+static void drc_init(voodoo_state *v)
+{
+	v->drc_cache = osd_alloc_executable(DRC_CACHE_SIZE);
+	v->drc_top = v->drc_cache;
+	v->drc_end = (v->drc_cache != NULL) ? v->drc_cache + DRC_CACHE_SIZE : NULL;
+
+	/* only register the exit callback once */
+	if (v->index == 0)
+		add_exit_callback(Machine, drc_exit);
+}
+
+
+/*-------------------------------------------------
+    generate_rasterizer - try to compile a span
+    function for the mode described by 'info';
+    returns FALSE if the mode isn't handled
+-------------------------------------------------*/
+
+static int generate_rasterizer(voodoo_state *v, raster_info *info)
+{
+	x86code *code;
+
+	/* bail if the mode isn't supported or we're out of space */
+	if (!drc_mode_supported(info))
+		return FALSE;
+	if (v->drc_cache == NULL || v->drc_end - v->drc_top < DRC_MAX_SPAN_SIZE)
+		return FALSE;
+
+	/* emit the code and advance */
+	code = v->drc_top;
+	emit_span(&v->drc_top, info);
+	assert_always(v->drc_top - code <= DRC_MAX_SPAN_SIZE, "Voodoo span function overflow");
+
+	info->callback = raster_drc;
+	info->drc_span = code;
+	return TRUE;
+}
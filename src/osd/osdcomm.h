@@ -39,6 +39,7 @@
 #define ATTR_MALLOC				__attribute__((malloc))
 #define ATTR_PURE				__attribute__((pure))
 #define ATTR_CONST				__attribute__((const))
+#define ATTR_FORCE_INLINE		__attribute__((always_inline))
 #define UNEXPECTED(exp)			__builtin_expect((exp), 0)
 #define TYPES_COMPATIBLE(a,b)	__builtin_types_compatible_p(a, b)
 #define RESTRICT				__restrict__
@@ -49,6 +50,7 @@
 #define ATTR_MALLOC
 #define ATTR_PURE
 #define ATTR_CONST
+#define ATTR_FORCE_INLINE
 #define UNEXPECTED(exp)			(exp)
 #define TYPES_COMPATIBLE(a,b)	1
 #define RESTRICT
@@ -117,7 +117,13 @@ void osd_update(int skip_redraw);
 
 ******************************************************************************/
 
-void osd_update_audio_stream(INT16 *buffer, int samples_this_frame);
+/*
+  queue a buffer of interleaved stereo samples for playback. Returns the
+  number of samples that were still waiting to be played when the buffer
+  was queued, 0 if playback had run dry, or -1 if this cannot be measured.
+  The core uses this to steer its output rate and to report latency.
+*/
+int osd_update_audio_stream(INT16 *buffer, int samples_this_frame);
 
 /*
   control master volume. attenuation is the attenuation in dB (a negative
@@ -101,6 +101,17 @@ file_error osd_close(osd_file *file)
 }
 
 
+//============================================================
+//  osd_rmfile
+//============================================================
+
+file_error osd_rmfile(const char *filename)
+{
+	// the standard C library can delete a file, but can't tell us why it failed
+	return (remove(filename) == 0) ? FILERR_NONE : FILERR_FAILURE;
+}
+
+
 //============================================================
 //  osd_get_physical_drive_geometry
 //============================================================
@@ -123,3 +134,18 @@ int osd_uchar_from_osdchar(UINT32 /* unicode_char */ *uchar, const char *osdchar
 	*uchar = (UINT8)*osdchar;
 	return 1;
 }
+
+
+//============================================================
+//  osd_is_absolute_path
+//============================================================
+
+int osd_is_absolute_path(const char *path)
+{
+	// treat a leading slash or backslash, or a drive letter, as an absolute path
+	if (path[0] == '/' || path[0] == '\\')
+		return TRUE;
+	if (((path[0] >= 'a' && path[0] <= 'z') || (path[0] >= 'A' && path[0] <= 'Z')) && path[1] == ':')
+		return TRUE;
+	return FALSE;
+}
@@ -0,0 +1,146 @@
+//============================================================
+//
+//  minimain.c - Minimal main program and OSD hooks
+//
+//  Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+//  Visit http://mamedev.org for licensing and usage restrictions.
+//
+//============================================================
+
+#include "driver.h"
+#include "render.h"
+#include "clifront.h"
+
+
+//============================================================
+//  GLOBAL VARIABLES
+//============================================================
+
+// the mini OSD's only option captures the audio output
+static const options_entry mini_options[] =
+{
+	{ NULL,                        NULL,   OPTION_HEADER,  "MINI OSD OPTIONS" },
+	{ "audio_file",                NULL,   0,              "write the raw 16-bit stereo audio output to this file" },
+	{ NULL }
+};
+
+// a single render target; nothing is ever drawn from it
+static render_target *our_target;
+
+// the only audio "device" is an optional raw capture file
+static FILE *audio_file;
+
+
+
+//============================================================
+//  LOCAL FUNCTIONS
+//============================================================
+
+static void mini_exit(running_machine *machine);
+
+
+
+//============================================================
+//  main
+//============================================================
+
+int main(int argc, char *argv[])
+{
+	// there is no video or input here, and sound only ever reaches a
+	// file, which makes this OSD suitable for headless runs such as -bench
+	return cli_execute(argc, argv, mini_options);
+}
+
+
+//============================================================
+//  osd_init
+//============================================================
+
+void osd_init(running_machine *machine)
+{
+	const char *filename;
+
+	// the UI expects at least one target to exist
+	our_target = render_target_alloc(NULL, 0);
+	if (our_target == NULL)
+		fatalerror("Error creating render target");
+
+	// open the audio capture file if one was requested
+	filename = options_get_string(mame_options(), "audio_file");
+	if (filename != NULL && filename[0] != 0)
+	{
+		audio_file = fopen(filename, "wb");
+		if (audio_file == NULL)
+			fatalerror("Unable to open audio file %s", filename);
+	}
+
+	add_exit_callback(machine, mini_exit);
+}
+
+
+//============================================================
+//  mini_exit
+//============================================================
+
+static void mini_exit(running_machine *machine)
+{
+	if (audio_file != NULL)
+		fclose(audio_file);
+	audio_file = NULL;
+}
+
+
+//============================================================
+//  osd_wait_for_debugger
+//============================================================
+
+void osd_wait_for_debugger(void)
+{
+	// we don't have a debugger, so we just return here
+}
+
+
+//============================================================
+//  osd_update
+//============================================================
+
+void osd_update(int skip_redraw)
+{
+	// nothing is displayed, so the primitive list is never fetched
+}
+
+
+//============================================================
+//  osd_update_audio_stream
+//============================================================
+
+int osd_update_audio_stream(INT16 *buffer, int samples_this_frame)
+{
+	// the samples only go to the capture file, if any
+	if (audio_file != NULL)
+		fwrite(buffer, sizeof(*buffer) * 2, samples_this_frame, audio_file);
+
+	// there is no playback queue, so there is no depth to report; osd_ticks()
+	// here is clock() CPU time, which can't model a device draining in real time
+	return -1;
+}
+
+
+//============================================================
+//  osd_set_mastervolume
+//============================================================
+
+void osd_set_mastervolume(int attenuation)
+{
+	// there is no sound output to attenuate
+}
+
+
+//============================================================
+//  osd_customize_inputport_list
+//============================================================
+
+void osd_customize_inputport_list(input_port_default_entry *defaults)
+{
+	// there are no input devices, so the defaults are left alone
+}
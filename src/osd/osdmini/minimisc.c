@@ -9,6 +9,10 @@
 
 #include "osdcore.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
 
 //============================================================
 //  osd_alloc_executable
@@ -16,9 +20,16 @@
 
 void *osd_alloc_executable(size_t size)
 {
+#if defined(__unix__) || defined(__APPLE__)
+	// most hosts won't execute code in malloc'ed memory, so ask
+	// for an executable mapping where there is a standard way to
+	void *result = mmap(NULL, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANON, -1, 0);
+	return (result == MAP_FAILED) ? NULL : result;
+#else
 	// to use this version of the code, we have to assume that
 	// code injected into a malloc'ed region can be safely executed
 	return malloc(size);
+#endif
 }
 
 
@@ -28,7 +39,11 @@ void *osd_alloc_executable(size_t size)
 
 void osd_free_executable(void *ptr, size_t size)
 {
+#if defined(__unix__) || defined(__APPLE__)
+	munmap(ptr, size);
+#else
 	free(ptr);
+#endif
 }
 
 
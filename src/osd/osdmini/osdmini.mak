@@ -10,14 +10,53 @@
 ###########################################################################
 
 
+#-------------------------------------------------
+# object and source roots
+#-------------------------------------------------
+
+MINISRC = $(SRC)/osd/$(OSD)
+MINIOBJ = $(OBJ)/osd/$(OSD)
+
+OBJDIRS += $(MINIOBJ)
+
+
+
 #-------------------------------------------------
 # OSD core library
 #-------------------------------------------------
 
 OSDCOREOBJS = \
-	$(OBJ)/$(MAMEOS)/minidir.o \
-	$(OBJ)/$(MAMEOS)/minifile.o \
-	$(OBJ)/$(MAMEOS)/minimisc.o \
-	$(OBJ)/$(MAMEOS)/minisync.o \
-	$(OBJ)/$(MAMEOS)/minitime.o \
-	$(OBJ)/$(MAMEOS)/miniwork.o \
+	$(MINIOBJ)/minidir.o \
+	$(MINIOBJ)/minifile.o \
+	$(MINIOBJ)/minimisc.o \
+	$(MINIOBJ)/minisync.o \
+	$(MINIOBJ)/minitime.o \
+	$(MINIOBJ)/miniwork.o \
+
+
+
+#-------------------------------------------------
+# OSD mini library: a headless front end with no
+# video, sound or input, used for benchmarking
+#-------------------------------------------------
+
+OSDOBJS = \
+	$(MINIOBJ)/minimain.o
+
+
+
+#-------------------------------------------------
+# the C math library is separate on Unix systems
+#-------------------------------------------------
+
+LIBS += -lm
+
+
+
+#-------------------------------------------------
+# rules for building the libaries
+#-------------------------------------------------
+
+$(LIBOCORE): $(OSDCOREOBJS)
+
+$(LIBOSD): $(OSDOBJS)
@@ -0,0 +1,17 @@
+//============================================================
+//
+//  osinline.h - Minimal inline functions
+//
+//  Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+//  Visit http://mamedev.org for licensing and usage restrictions.
+//
+//============================================================
+
+#ifndef __OSINLINE__
+#define __OSINLINE__
+
+#include "osd_cpu.h"
+
+// no platform-specific versions; the core supplies C fallbacks
+
+#endif /* __OSINLINE__ */
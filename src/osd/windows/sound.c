@@ -50,6 +50,11 @@ static LPDIRECTSOUNDBUFFER	stream_buffer;
 static UINT32				stream_buffer_size;
 static UINT32				stream_buffer_in;
 
+// playback tracking between updates, for spotting underflows
+static UINT32				stream_buffer_play;		// play position at the last update
+static UINT32				stream_buffer_queued;	// bytes of ours ahead of it after that update
+static osd_ticks_t			stream_buffer_ticks;	// when that update happened, or 0 before the first
+
 // descriptors and formats
 static DSBUFFERDESC			primary_desc;
 static DSBUFFERDESC			stream_desc;
@@ -172,55 +177,87 @@ static void copy_sample_data(INT16 *data, int bytes_to_copy)
 //  osd_update_audio_stream
 //============================================================
 
-void osd_update_audio_stream(INT16 *buffer, int samples_this_frame)
+int osd_update_audio_stream(INT16 *buffer, int samples_this_frame)
 {
 	int bytes_this_frame = samples_this_frame * stream_format.nBlockAlign;
 	DWORD play_position, write_position;
 	HRESULT result;
+	int queued = -1;
 
 	// if no sound, there is no buffer
 	if (stream_buffer == NULL)
-		return;
+		return -1;
 
 	// determine the current play position
 	result = IDirectSoundBuffer_GetCurrentPosition(stream_buffer, &play_position, &write_position);
 	if (result == DS_OK)
 	{
-		DWORD stream_in;
-
-//DWORD orig_write = write_position;
-		// normalize the write position so it is always after the play position
-		if (write_position < play_position)
-			write_position += stream_buffer_size;
-
-		// normalize the stream in position so it is always after the write position
-		stream_in = stream_buffer_in;
-		if (stream_in < write_position)
-			stream_in += stream_buffer_size;
+		osd_ticks_t ticks = osd_ticks();
+		osd_ticks_t ticks_per_second = osd_ticks_per_second();
+		UINT32 committed, pending, played;
+		int underflow = FALSE;
 
-		// now we should have, in order:
+		// all distances are measured forward from the play position, modulo the buffer:
 		//    <------pp---wp---si--------------->
+		// committed is what DirectSound has already locked in for playback, pending is
+		// what we have written that hasn't been played yet
+		committed = (write_position + stream_buffer_size - play_position) % stream_buffer_size;
+		pending = (stream_buffer_in + stream_buffer_size - play_position) % stream_buffer_size;
 
-		// if we're between play and write positions, then bump forward, but only in full chunks
-		while (stream_in < write_position)
+		if (stream_buffer_ticks == 0)
 		{
-//logerror("Underflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
+			// first update: start writing right after the committed region
+			stream_buffer_in = write_position;
+			pending = committed;
+		}
+		else
+		{
+			// if the play position moved further than we were ahead of it, it has run past
+			// stream_buffer_in and pending is wrapped garbage; a stall longer than the whole
+			// buffer doesn't show up in the positions at all, so check the elapsed time too
+			played = (play_position + stream_buffer_size - stream_buffer_play) % stream_buffer_size;
+			if (played >= stream_buffer_queued)
+				underflow = TRUE;
+			else if ((ticks - stream_buffer_ticks) * stream_format.nAvgBytesPerSec >= (osd_ticks_t)stream_buffer_size * ticks_per_second)
+				underflow = TRUE;
+
+			// the write position can also pass our input before the play position does
+			else if (pending < committed)
+				underflow = TRUE;
+		}
+
+		// on an underflow, resume writing right after the committed region
+		if (underflow)
+		{
+//logerror("Underflow: PP=%d  WP=%d  SI=%d  BTF=%d\n", (int)play_position, (int)write_position, (int)stream_buffer_in, (int)bytes_this_frame);
 			buffer_underflows++;
-			stream_in += samples_this_frame;
+			stream_buffer_in = write_position;
+			pending = committed;
+			queued = 0;
 		}
+		else
+			queued = pending / stream_format.nBlockAlign;
 
 		// if we're going to overlap the play position, just skip this chunk
-		if (stream_in + bytes_this_frame > play_position + stream_buffer_size)
+		if (pending + bytes_this_frame > stream_buffer_size)
 		{
-//logerror("Overflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
+//logerror("Overflow: PP=%d  WP=%d  SI=%d  BTF=%d\n", (int)play_position, (int)write_position, (int)stream_buffer_in, (int)bytes_this_frame);
 			buffer_overflows++;
-			return;
 		}
 
-		// now we know where to copy; let's do it
-		stream_buffer_in = stream_in % stream_buffer_size;
-		copy_sample_data(buffer, bytes_this_frame);
+		// otherwise, copy it in
+		else
+		{
+			copy_sample_data(buffer, bytes_this_frame);
+			pending += bytes_this_frame;
+		}
+
+		// remember where things stood for the next update
+		stream_buffer_play = play_position;
+		stream_buffer_queued = pending;
+		stream_buffer_ticks = ticks;
 	}
+	return queued;
 }
 
 
@@ -395,6 +432,10 @@ static HRESULT dsound_create_buffers(void)
 	// clear the buffer and unlock it
 	memset(buffer, 0, locked);
 	IDirectSoundBuffer_Unlock(stream_buffer, buffer, locked, NULL, 0);
+
+	// the next update starts writing from the current write position
+	stream_buffer_in = 0;
+	stream_buffer_ticks = 0;
 	return DS_OK;
 
 	// error handling
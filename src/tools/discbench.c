@@ -0,0 +1,363 @@
+/***************************************************************************
+
+    discbench.c
+
+    Runs the discrete sound netlists of a few boards with no emulated
+    CPU, feeding their input nodes a fixed pseudo-random sequence of
+    writes once per video frame, and reports the rendering speed and a
+    checksum of the output for each one.
+
+    The checksum only depends on the netlist and the write sequence, so
+    two builds of discrete.c can be compared for bit-accuracy by running
+    both and comparing the figures.  With -wavelog every output is also
+    recorded through a DISCRETE_WAVELOG node, so the discreteN_M.wav
+    files the two builds write can be compared directly.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "zlib.h"
+#include "driver.h"
+#include "streams.h"
+#include "sound/discrete.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define SAMPLE_RATE			48000
+#define FRAME_RATE			60
+#define DEFAULT_SECONDS		60
+#define DEFAULT_CHUNK		(SAMPLE_RATE / FRAME_RATE)
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _bench_circuit bench_circuit;
+struct _bench_circuit
+{
+	const char *			name;				/* board the netlist comes from */
+	discrete_sound_block *	block;				/* the netlist itself */
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+void discrete_get_info(void *token, UINT32 state, sndinfo *info);
+
+extern discrete_sound_block asteroid_discrete_interface[];
+extern discrete_sound_block canyon_discrete_interface[];
+extern discrete_sound_block dragrace_discrete_interface[];
+extern discrete_sound_block nitedrvr_discrete_interface[];
+extern discrete_sound_block skydiver_discrete_interface[];
+extern discrete_sound_block sprint2_discrete_interface[];
+extern discrete_sound_block subs_discrete_interface[];
+extern discrete_sound_block tank8_discrete_interface[];
+
+static const bench_circuit circuit_list[] =
+{
+	{ "asteroid", asteroid_discrete_interface },
+	{ "canyon",   canyon_discrete_interface },
+	{ "dragrace", dragrace_discrete_interface },
+	{ "nitedrvr", nitedrvr_discrete_interface },
+	{ "skydiver", skydiver_discrete_interface },
+	{ "sprint2",  sprint2_discrete_interface },
+	{ "subs",     subs_discrete_interface },
+	{ "tank8",    tank8_discrete_interface },
+	{ NULL }
+};
+
+static running_machine bench_machine;
+running_machine *Machine = &bench_machine;
+
+/* the chip being run, and the stream it asked for */
+static void *bench_token;
+static stream_callback bench_callback;
+static void *bench_param;
+static int bench_outputs;
+
+/* one generator for mame_rand() and one for the input writes, */
+/* both reseeded per circuit */
+static UINT32 rand_seed;
+static UINT32 write_seed;
+
+
+
+/***************************************************************************
+    CORE RUNTIME STUBS
+***************************************************************************/
+
+/* the discrete core only needs a handful of emulator services; */
+/* memory is never freed since each run is short-lived */
+
+void *auto_malloc_file_line(size_t size, const char *file, int line)
+{
+	return malloc_or_die_file_line(size, file, line);
+}
+
+void *malloc_or_die_file_line(size_t size, const char *file, int line)
+{
+	void *result = malloc(size);
+	if (result == NULL)
+		fatalerror("Out of memory allocating %d bytes (%s:%d)", (int)size, file, line);
+	return result;
+}
+
+void CLIB_DECL fatalerror(const char *text, ...)
+{
+	va_list arg;
+
+	va_start(arg, text);
+	vfprintf(stderr, text, arg);
+	va_end(arg);
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+void CLIB_DECL logerror(const char *text, ...)
+{
+}
+
+UINT32 mame_rand(running_machine *machine)
+{
+	rand_seed = rand_seed * 1103515245 + 12345;
+	return rand_seed;
+}
+
+/* every DISCRETE_ADJUSTMENT_TAG reads the same port, which sits at mid-range */
+int port_tag_to_index(const char *tag)
+{
+	return 0;
+}
+
+UINT32 readinputport(int port)
+{
+	return 0x80;
+}
+
+void *sndti_token(int sndtype, int sndindex)
+{
+	return bench_token;
+}
+
+sound_stream *stream_create(int inputs, int outputs, int sample_rate, void *param, stream_callback callback)
+{
+	bench_callback = callback;
+	bench_param = param;
+	bench_outputs = outputs;
+	return (sound_stream *)&bench_callback;
+}
+
+void stream_update(sound_stream *stream)
+{
+	/* every write lands on a frame boundary, where the streams are already up to date */
+}
+
+
+
+/***************************************************************************
+    BENCHMARK
+***************************************************************************/
+
+/*-------------------------------------------------
+    add_wavelogs - return a copy of a netlist with
+    a wave log on the source of every output
+-------------------------------------------------*/
+
+static discrete_sound_block *add_wavelogs(const discrete_sound_block *block)
+{
+	discrete_sound_block *result;
+	int count, outputs = 0, nodenum, lognum = 0;
+
+	for (count = 0; block[count].type != DSS_NULL; count++)
+		if (block[count].type == DSO_OUTPUT)
+			outputs++;
+
+	result = malloc_or_die((count + outputs + 1) * sizeof(result[0]));
+	memcpy(result, block, count * sizeof(result[0]));
+	for (nodenum = 0; nodenum < count; nodenum++)
+		if (block[nodenum].type == DSO_OUTPUT)
+		{
+			discrete_sound_block *log = &result[count + lognum++];
+
+			memset(log, 0, sizeof(*log));
+			log->node = NODE_SPECIAL;
+			log->type = DSO_WAVELOG;
+			log->active_inputs = 2;
+			log->input_node[0] = block[nodenum].input_node[0];
+			log->input_node[1] = NODE_NC;
+			log->initial[0] = block[nodenum].input_node[0];
+			log->initial[1] = block[nodenum].initial[1];
+			log->name = "Benchmark Wave Log";
+		}
+	result[count + outputs] = block[count];
+	return result;
+}
+
+
+/*-------------------------------------------------
+    write_inputs - write a new pseudo-random value
+    to some of the input nodes, as the game's CPU
+    would between frames
+-------------------------------------------------*/
+
+static void write_inputs(const discrete_sound_block *block)
+{
+	int nodenum;
+
+	for (nodenum = 0; block[nodenum].type != DSS_NULL; nodenum++)
+		if (block[nodenum].type >= DSS_INPUT_DATA && block[nodenum].type <= DSS_INPUT_PULSE)
+		{
+			write_seed = write_seed * 1664525 + 1013904223;
+
+			/* change about one input in eight per frame, so sounds play for a while; */
+			/* data inputs get the non-zero 4-bit values the boards' latches produce, */
+			/* since some netlists divide by them */
+			if ((write_seed >> 29) == 0)
+				discrete_sound_w(block[nodenum].node, 1 + (write_seed >> 16) % 15);
+		}
+}
+
+
+/*-------------------------------------------------
+    run_circuit - run one netlist for the given
+    number of emulated seconds
+-------------------------------------------------*/
+
+static void run_circuit(int index, int seconds, int chunk, int wavelog)
+{
+	const bench_circuit *circuit = &circuit_list[index];
+	discrete_sound_block *block = wavelog ? add_wavelogs(circuit->block) : circuit->block;
+	stream_sample_t *buffer[DISCRETE_MAX_OUTPUTS];
+	UINT8 *bytes;
+	int frame, outnum, sampnum, offset, nodes;
+	osd_ticks_t start, elapsed, tps = osd_ticks_per_second();
+	UINT32 crc = 0;
+	double cpuseconds;
+	sndinfo info;
+
+	for (nodes = 0; block[nodes].type != DSS_NULL; nodes++) ;
+
+	rand_seed = 0;
+	write_seed = index;
+	discrete_get_info(NULL, SNDINFO_PTR_START, &info);
+	bench_token = (*info.start)(index, 0, block);
+	discrete_get_info(NULL, SNDINFO_PTR_RESET, &info);
+	(*info.reset)(bench_token);
+
+	for (outnum = 0; outnum < bench_outputs; outnum++)
+		buffer[outnum] = malloc_or_die(chunk * sizeof(buffer[outnum][0]));
+	bytes = malloc_or_die(chunk * bench_outputs * 4);
+
+	start = osd_ticks();
+	for (frame = 0; frame < seconds * FRAME_RATE; frame++)
+	{
+		write_inputs(block);
+
+		for (offset = 0; offset < SAMPLE_RATE / FRAME_RATE; offset += chunk)
+		{
+			int length = MIN(chunk, SAMPLE_RATE / FRAME_RATE - offset);
+			UINT8 *dest = bytes;
+
+			(*bench_callback)(bench_param, NULL, buffer, length);
+
+			/* checksum the output little-endian, interleaved by channel */
+			for (sampnum = 0; sampnum < length; sampnum++)
+				for (outnum = 0; outnum < bench_outputs; outnum++)
+				{
+					UINT32 sample = buffer[outnum][sampnum];
+					*dest++ = sample >> 0;
+					*dest++ = sample >> 8;
+					*dest++ = sample >> 16;
+					*dest++ = sample >> 24;
+				}
+			crc = crc32(crc, bytes, dest - bytes);
+		}
+	}
+	elapsed = osd_ticks() - start;
+	cpuseconds = (double)elapsed / (double)tps;
+
+	printf("%-10s %3d nodes, %d s at %d Hz in %7.3f s (%6.2f Msamples/sec), crc32 %08x\n",
+			circuit->name, nodes, seconds, SAMPLE_RATE, cpuseconds,
+			(cpuseconds > 0) ? (double)seconds * SAMPLE_RATE / cpuseconds / 1e6 : 0.0, crc);
+
+	/* stopping closes the wave logs */
+	discrete_get_info(NULL, SNDINFO_PTR_STOP, &info);
+	(*info.stop)(bench_token);
+
+	for (outnum = 0; outnum < bench_outputs; outnum++)
+		free(buffer[outnum]);
+	free(bytes);
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+int CLIB_DECL main(int argc, char *argv[])
+{
+	int seconds = DEFAULT_SECONDS, chunk = DEFAULT_CHUNK, wavelog = FALSE;
+	int argnum, index, ran = 0;
+
+	bench_machine.sample_rate = SAMPLE_RATE;
+
+	/* parse the options; anything else names a circuit to run */
+	for (argnum = 1; argnum < argc && argv[argnum][0] == '-'; argnum++)
+	{
+		if (strcmp(argv[argnum], "-wavelog") == 0)
+			wavelog = TRUE;
+		else if (strcmp(argv[argnum], "-seconds") == 0 && argnum + 1 < argc)
+			seconds = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-chunk") == 0 && argnum + 1 < argc)
+			chunk = atoi(argv[++argnum]);
+		else
+			break;
+	}
+	if (argnum < argc && argv[argnum][0] == '-')
+	{
+		fprintf(stderr, "Usage:\n  discbench [-seconds <n>] [-chunk <samples>] [-wavelog] [circuit ...]\n");
+		return 1;
+	}
+	if (seconds <= 0 || chunk <= 0)
+	{
+		fprintf(stderr, "Invalid -seconds or -chunk value\n");
+		return 1;
+	}
+
+	/* run either the named circuits or all of them */
+	for (index = 0; circuit_list[index].name != NULL; index++)
+	{
+		int which;
+
+		for (which = argnum; which < argc; which++)
+			if (strcmp(argv[which], circuit_list[index].name) == 0)
+				break;
+		if (argnum == argc || which < argc)
+		{
+			run_circuit(index, seconds, chunk, wavelog);
+			ran++;
+		}
+	}
+	if (ran == 0)
+	{
+		fprintf(stderr, "No matching circuits\n");
+		return 1;
+	}
+	return 0;
+}
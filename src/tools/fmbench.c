@@ -0,0 +1,584 @@
+/***************************************************************************
+
+    fmbench.c
+
+    Runs the Yamaha FM cores (fm.c and ym2151.c) with no emulated CPU,
+    playing a fixed pseudo-random sequence of notes on every channel
+    once per video frame, and reports the rendering speed and a
+    checksum of the output for each chip.
+
+    Two workloads are run per chip: "dense" keeps every channel busy,
+    while "sparse" leaves most channels released most of the time, as
+    in typical game music.  Each note loads a complete voice, and the
+    voices cover all eight algorithms, feedback and the LFO.
+
+    The checksum only depends on the cores and the write sequence, so
+    two builds of the cores can be compared for bit-accuracy by running
+    both and comparing the figures.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "zlib.h"
+#include "sndintrf.h"
+#include "streams.h"
+#include "sound/fm.h"
+#include "sound/ym2151.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define FRAME_RATE			60
+#define DEFAULT_SECONDS		60
+#define MAX_CHANNELS		8
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _bench_voice bench_voice;
+struct _bench_voice
+{
+	UINT8			algfb;				/* algorithm and feedback */
+	UINT8			lfo;				/* AMS/PMS bits, or 0 for no LFO */
+	UINT8			op[4][6];			/* DT/MUL, TL, KS/AR, AM/D1R, D2R, SL/RR per operator */
+};
+
+
+typedef struct _bench_chip bench_chip;
+struct _bench_chip
+{
+	const char *	name;				/* chip name */
+	int				clock;				/* input clock */
+	int				divider;			/* sample rate = clock / divider */
+	int				outputs;			/* number of output channels */
+	int				channels;			/* number of FM channels */
+	void *			(*start)(int clock, int rate);
+	void			(*stop)(void *chip);
+	void			(*key)(void *chip, int ch, int on, const bench_voice *voice, int note);
+	void			(*update)(void *chip, stream_sample_t **buffer, int length);
+};
+
+
+typedef struct _bench_channel bench_channel;
+struct _bench_channel
+{
+	int				frames;				/* frames until the next key on or off */
+	int				playing;			/* key is on */
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* one voice per algorithm; operators are listed in register order */
+static const bench_voice voice_list[8] =
+{
+	{ 0x30, 0x00, { { 0x71, 0x23, 0x5f, 0x05, 0x02, 0x11 }, { 0x0d, 0x2d, 0x99, 0x05, 0x02, 0x11 }, { 0x33, 0x26, 0x5f, 0x05, 0x02, 0x11 }, { 0x01, 0x00, 0x94, 0x07, 0x02, 0xa6 } } },
+	{ 0x39, 0x33, { { 0x02, 0x1c, 0x1f, 0x8a, 0x03, 0x36 }, { 0x01, 0x28, 0x1f, 0x0a, 0x03, 0x26 }, { 0x01, 0x22, 0x1f, 0x0a, 0x03, 0x26 }, { 0x01, 0x00, 0x1f, 0x8a, 0x03, 0x28 } } },
+	{ 0x22, 0x00, { { 0x31, 0x25, 0x1f, 0x0e, 0x00, 0x4f }, { 0x72, 0x30, 0x1f, 0x0c, 0x00, 0x4f }, { 0x34, 0x1d, 0x1f, 0x0e, 0x00, 0x4f }, { 0x02, 0x04, 0x1f, 0x09, 0x06, 0x3f } } },
+	{ 0x1b, 0x12, { { 0x07, 0x20, 0x5f, 0x02, 0x00, 0x15 }, { 0x04, 0x2a, 0x5f, 0x02, 0x00, 0x15 }, { 0x01, 0x1b, 0x5f, 0x02, 0x00, 0x15 }, { 0x01, 0x06, 0x5f, 0x83, 0x05, 0x57 } } },
+	{ 0x3c, 0x00, { { 0x61, 0x1c, 0x1f, 0x10, 0x05, 0x2a }, { 0x02, 0x08, 0x1f, 0x0c, 0x05, 0x2a }, { 0x61, 0x1e, 0x1f, 0x10, 0x05, 0x2a }, { 0x02, 0x08, 0x1f, 0x0c, 0x05, 0x2a } } },
+	{ 0x35, 0x37, { { 0x02, 0x1a, 0x1f, 0x06, 0x01, 0x16 }, { 0x01, 0x0b, 0x1f, 0x87, 0x01, 0x16 }, { 0x03, 0x0d, 0x1f, 0x07, 0x01, 0x16 }, { 0x06, 0x0a, 0x1f, 0x07, 0x01, 0x16 } } },
+	{ 0x06, 0x00, { { 0x05, 0x22, 0x1f, 0x14, 0x00, 0xf8 }, { 0x01, 0x0c, 0x1f, 0x0e, 0x00, 0xf8 }, { 0x02, 0x10, 0x1f, 0x0e, 0x00, 0xf8 }, { 0x03, 0x0c, 0x1f, 0x0e, 0x00, 0xf8 } } },
+	{ 0x07, 0x21, { { 0x01, 0x14, 0x1f, 0x8f, 0x00, 0x3a }, { 0x02, 0x14, 0x1f, 0x0f, 0x00, 0x3a }, { 0x04, 0x14, 0x1f, 0x0f, 0x00, 0x3a }, { 0x08, 0x14, 0x1f, 0x0f, 0x00, 0x3a } } }
+};
+
+/* the generator for the note sequence, reseeded per run */
+static UINT32 note_seed;
+
+
+
+/***************************************************************************
+    CORE RUNTIME STUBS
+***************************************************************************/
+
+/* the cores only need a handful of emulator services; nothing here */
+/* reads the status register, so timers and IRQs can be ignored */
+
+mame_time time_zero;
+mame_time time_never;
+
+struct _mame_timer
+{
+	int				dummy;
+};
+
+static mame_timer dummy_timer;
+
+mame_time mame_timer_get_time(void)
+{
+	return time_zero;
+}
+
+mame_timer *_mame_timer_alloc_ptr(void (*callback)(running_machine *, void *), void *param, const char *file, int line, const char *func)
+{
+	return &dummy_timer;
+}
+
+void mame_timer_adjust_ptr(mame_timer *which, mame_time duration, mame_time period)
+{
+}
+
+void _mame_timer_set_ptr(mame_time duration, void *param, void (*callback)(running_machine *, void *), const char *file, int line, const char *func)
+{
+}
+
+int mame_timer_enable(mame_timer *which, int enable)
+{
+	return 0;
+}
+
+void CLIB_DECL logerror(const char *text, ...)
+{
+}
+
+void state_save_register_memory(const char *module, UINT32 instance, const char *name, void *val, UINT32 valsize, UINT32 valcount)
+{
+}
+
+void state_save_register_func_postload_ptr(void (*func)(void *), void *param)
+{
+}
+
+#if BUILD_YM2203
+void YM2203UpdateRequest(void *param) { }
+#endif
+#if BUILD_YM2608
+void YM2608UpdateRequest(void *param) { }
+#endif
+#if (BUILD_YM2610||BUILD_YM2610B)
+void YM2610UpdateRequest(void *param) { }
+#endif
+#if BUILD_YM2612
+void YM2612UpdateRequest(void *param) { }
+#endif
+
+static void fm_timer_handler(void *param, int c, int count, int clock) { }
+static void fm_irq_handler(void *param, int irq) { }
+static void psg_set_clock(void *param, int clock) { }
+static void psg_write(void *param, int address, int data) { }
+static int psg_read(void *param) { return 0; }
+static void psg_reset(void *param) { }
+
+static const struct ssg_callbacks psgintf =
+{
+	psg_set_clock,
+	psg_write,
+	psg_read,
+	psg_reset
+};
+
+
+
+/***************************************************************************
+    OPN GLUE
+***************************************************************************/
+
+/* block/F-number pairs for an octave, at the OPN's usual 8MHz/144 rate */
+static const UINT16 opn_fnum[12] = { 0x26a, 0x28f, 0x2b5, 0x2de, 0x30a, 0x338, 0x369, 0x39d, 0x3d4, 0x40e, 0x44c, 0x48d };
+
+/*-------------------------------------------------
+    opn_key - load a voice into an OPN channel
+    and key it on, or key it off; channels 3-5
+    are on the second port
+-------------------------------------------------*/
+
+static void opn_key(void *chip, int ch, int on, const bench_voice *voice, int note,
+		int (*write)(void *chip, int a, UINT8 v))
+{
+	int port = (ch >= 3) ? 2 : 0;
+	int c = ch % 3;
+	int op, reg;
+
+	if (!on)
+	{
+		(*write)(chip, 0, 0x28);
+		(*write)(chip, 1, (port << 1) | c);
+		return;
+	}
+
+	for (op = 0; op < 4; op++)
+		for (reg = 0; reg < 6; reg++)
+		{
+			(*write)(chip, port + 0, 0x30 + reg * 0x10 + op * 4 + c);
+			(*write)(chip, port + 1, voice->op[op][reg]);
+		}
+	(*write)(chip, port + 0, 0xb0 + c);
+	(*write)(chip, port + 1, voice->algfb);
+	(*write)(chip, port + 0, 0xb4 + c);
+	(*write)(chip, port + 1, 0xc0 | voice->lfo);
+	(*write)(chip, port + 0, 0xa4 + c);
+	(*write)(chip, port + 1, ((2 + note / 12 % 4) << 3) | (opn_fnum[note % 12] >> 8));
+	(*write)(chip, port + 0, 0xa0 + c);
+	(*write)(chip, port + 1, opn_fnum[note % 12] & 0xff);
+
+	(*write)(chip, 0, 0x28);
+	(*write)(chip, 1, 0xf0 | (port << 1) | c);
+}
+
+
+#if BUILD_YM2203
+static void *ym2203_start(int clock, int rate)
+{
+	return YM2203Init(NULL, 0, clock, rate, fm_timer_handler, fm_irq_handler, &psgintf);
+}
+
+static int ym2203_write(void *chip, int a, UINT8 v)
+{
+	return YM2203Write(chip, a & 1, v);
+}
+
+static void ym2203_key(void *chip, int ch, int on, const bench_voice *voice, int note)
+{
+	opn_key(chip, ch, on, voice, note, ym2203_write);
+}
+
+static void ym2203_update(void *chip, stream_sample_t **buffer, int length)
+{
+	YM2203UpdateOne(chip, buffer[0], length);
+}
+#endif
+
+
+#if BUILD_YM2608
+static void *ym2608_start(int clock, int rate)
+{
+	void *chip = YM2608Init(NULL, 0, clock, rate, NULL, 0, fm_timer_handler, fm_irq_handler, &psgintf);
+
+	/* LFO on at a middling rate */
+	YM2608Write(chip, 0, 0x22);
+	YM2608Write(chip, 1, 0x0b);
+	return chip;
+}
+
+static void ym2608_key(void *chip, int ch, int on, const bench_voice *voice, int note)
+{
+	opn_key(chip, ch, on, voice, note, YM2608Write);
+}
+
+static void ym2608_update(void *chip, stream_sample_t **buffer, int length)
+{
+	YM2608UpdateOne(chip, buffer, length);
+}
+#endif
+
+
+#if BUILD_YM2610
+static void *ym2610_start(int clock, int rate)
+{
+	void *chip = YM2610Init(NULL, 0, clock, rate, NULL, 0, NULL, 0, fm_timer_handler, fm_irq_handler, &psgintf);
+
+	YM2610Write(chip, 0, 0x22);
+	YM2610Write(chip, 1, 0x0b);
+	return chip;
+}
+
+/* the YM2610 only has channels 1, 2, 4 and 5 */
+static void ym2610_key(void *chip, int ch, int on, const bench_voice *voice, int note)
+{
+	static const int map[4] = { 1, 2, 4, 5 };
+	opn_key(chip, map[ch], on, voice, note, YM2610Write);
+}
+
+static void ym2610_update(void *chip, stream_sample_t **buffer, int length)
+{
+	YM2610UpdateOne(chip, buffer, length);
+}
+#endif
+
+
+#if BUILD_YM2612
+static void *ym2612_start(int clock, int rate)
+{
+	void *chip = YM2612Init(NULL, 0, clock, rate, fm_timer_handler, fm_irq_handler);
+
+	YM2612Write(chip, 0, 0x22);
+	YM2612Write(chip, 1, 0x0b);
+	return chip;
+}
+
+static void ym2612_key(void *chip, int ch, int on, const bench_voice *voice, int note)
+{
+	opn_key(chip, ch, on, voice, note, YM2612Write);
+}
+
+static void ym2612_update(void *chip, stream_sample_t **buffer, int length)
+{
+	YM2612UpdateOne(chip, buffer, length);
+}
+#endif
+
+
+
+/***************************************************************************
+    OPM GLUE
+***************************************************************************/
+
+#if (HAS_YM2151)
+static void *ym2151_start(int clock, int rate)
+{
+	void *chip = YM2151Init(0, clock, rate);
+
+	/* triangle LFO with some AM and PM depth */
+	YM2151WriteReg(chip, 0x18, 0xc0);
+	YM2151WriteReg(chip, 0x19, 0x20);
+	YM2151WriteReg(chip, 0x19, 0x90);
+	YM2151WriteReg(chip, 0x1b, 0x02);
+	return chip;
+}
+
+/* the OPN voices map directly onto the OPM registers; the OPM */
+/* has no SSG-EG, and takes the same operator order */
+static void ym2151_key(void *chip, int ch, int on, const bench_voice *voice, int note)
+{
+	static const UINT8 notecode[12] = { 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14 };
+	int op, reg;
+
+	if (!on)
+	{
+		YM2151WriteReg(chip, 0x08, ch);
+		return;
+	}
+
+	for (op = 0; op < 4; op++)
+		for (reg = 0; reg < 6; reg++)
+		{
+			UINT8 data = voice->op[op][reg];
+
+			/* the OPN's D2R register lines up with the OPM's DT2/D2R */
+			if (reg == 4)
+				data &= 0x1f;
+			YM2151WriteReg(chip, 0x40 + reg * 0x20 + op * 8 + ch, data);
+		}
+	YM2151WriteReg(chip, 0x20 + ch, 0xc0 | voice->algfb);
+	YM2151WriteReg(chip, 0x38 + ch, ((voice->lfo & 7) << 4) | ((voice->lfo >> 4) & 3));
+	YM2151WriteReg(chip, 0x28 + ch, ((2 + note / 12 % 4) << 4) | notecode[note % 12]);
+	YM2151WriteReg(chip, 0x30 + ch, (note * 7) & 0xfc);
+	YM2151WriteReg(chip, 0x08, 0x78 | ch);
+}
+
+static void ym2151_update(void *chip, stream_sample_t **buffer, int length)
+{
+	YM2151UpdateOne(chip, buffer, length);
+}
+#endif
+
+
+static const bench_chip chip_list[] =
+{
+#if BUILD_YM2203
+	{ "YM2203", 3000000, 72, 1, 3, ym2203_start, YM2203Shutdown, ym2203_key, ym2203_update },
+#endif
+#if BUILD_YM2608
+	{ "YM2608", 8000000, 72, 2, 6, ym2608_start, YM2608Shutdown, ym2608_key, ym2608_update },
+#endif
+#if BUILD_YM2610
+	{ "YM2610", 8000000, 72, 2, 4, ym2610_start, YM2610Shutdown, ym2610_key, ym2610_update },
+#endif
+#if BUILD_YM2612
+	{ "YM2612", 7670454, 72, 2, 6, ym2612_start, YM2612Shutdown, ym2612_key, ym2612_update },
+#endif
+#if (HAS_YM2151)
+	{ "YM2151", 3579545, 64, 2, 8, ym2151_start, YM2151Shutdown, ym2151_key, ym2151_update },
+#endif
+	{ NULL }
+};
+
+
+
+/***************************************************************************
+    BENCHMARK
+***************************************************************************/
+
+/*-------------------------------------------------
+    next_random - advance the note generator
+-------------------------------------------------*/
+
+static UINT32 next_random(void)
+{
+	note_seed = note_seed * 1664525 + 1013904223;
+	return note_seed >> 8;
+}
+
+
+/*-------------------------------------------------
+    play_frame - key notes on and off for one
+    frame, as a sound driver would
+-------------------------------------------------*/
+
+static void play_frame(const bench_chip *chip, void *token, bench_channel *state, int sparse)
+{
+	int ch;
+
+	for (ch = 0; ch < chip->channels; ch++)
+	{
+		bench_channel *channel = &state[ch];
+
+		if (--channel->frames > 0)
+			continue;
+
+		if (channel->playing)
+		{
+			/* key off, then rest before the next note; sparse rests are long */
+			(*chip->key)(token, ch, FALSE, NULL, 0);
+			channel->playing = FALSE;
+			channel->frames = sparse ? 60 + next_random() % 240 : 1 + next_random() % 4;
+		}
+		else
+		{
+			(*chip->key)(token, ch, TRUE, &voice_list[next_random() % 8], next_random() % 48);
+			channel->playing = TRUE;
+			channel->frames = sparse ? 4 + next_random() % 12 : 6 + next_random() % 30;
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    run_chip - run one chip through one workload
+    for the given number of emulated seconds
+-------------------------------------------------*/
+
+static void run_chip(const bench_chip *chip, int sparse, int seconds)
+{
+	bench_channel state[MAX_CHANNELS];
+	stream_sample_t *buffer[2];
+	int rate = chip->clock / chip->divider;
+	int chunk = rate / FRAME_RATE + 1;
+	int frame, outnum, sampnum;
+	osd_ticks_t start, elapsed = 0, tps = osd_ticks_per_second();
+	UINT64 position = 0;
+	UINT32 crc = 0;
+	double cpuseconds;
+	UINT8 *bytes;
+	void *token;
+
+	note_seed = sparse;
+	memset(state, 0, sizeof(state));
+	token = (*chip->start)(chip->clock, rate);
+	if (token == NULL)
+	{
+		fprintf(stderr, "Unable to start %s\n", chip->name);
+		exit(1);
+	}
+
+	for (outnum = 0; outnum < 2; outnum++)
+		buffer[outnum] = malloc_or_die(chunk * sizeof(buffer[outnum][0]));
+	bytes = malloc_or_die(chunk * chip->outputs * 4);
+
+	for (frame = 0; frame < seconds * FRAME_RATE; frame++)
+	{
+		UINT64 target = (UINT64)(frame + 1) * rate / FRAME_RATE;
+		int length = target - position;
+		UINT8 *dest = bytes;
+
+		/* only the chip update is timed */
+		play_frame(chip, token, state, sparse);
+		start = osd_ticks();
+		(*chip->update)(token, buffer, length);
+		elapsed += osd_ticks() - start;
+		position = target;
+
+		/* checksum the output little-endian, interleaved by channel */
+		for (sampnum = 0; sampnum < length; sampnum++)
+			for (outnum = 0; outnum < chip->outputs; outnum++)
+			{
+				UINT32 sample = buffer[outnum][sampnum];
+				*dest++ = sample >> 0;
+				*dest++ = sample >> 8;
+				*dest++ = sample >> 16;
+				*dest++ = sample >> 24;
+			}
+		crc = crc32(crc, bytes, dest - bytes);
+	}
+	cpuseconds = (double)elapsed / (double)tps;
+
+	printf("%-7s %-7s %d s at %6d Hz in %7.3f s (%6.2f Msamples/sec), crc32 %08x\n",
+			chip->name, sparse ? "sparse" : "dense", seconds, rate, cpuseconds,
+			(cpuseconds > 0) ? (double)position / cpuseconds / 1e6 : 0.0, crc);
+
+	(*chip->stop)(token);
+	for (outnum = 0; outnum < 2; outnum++)
+		free(buffer[outnum]);
+	free(bytes);
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+/* the cores allocate with plain malloc; this is for the buffers above */
+void *malloc_or_die_file_line(size_t size, const char *file, int line)
+{
+	void *result = malloc(size);
+	if (result == NULL)
+	{
+		fprintf(stderr, "Out of memory allocating %d bytes (%s:%d)\n", (int)size, file, line);
+		exit(1);
+	}
+	return result;
+}
+
+
+int CLIB_DECL main(int argc, char *argv[])
+{
+	int seconds = DEFAULT_SECONDS;
+	int argnum, index, ran = 0;
+
+	/* parse the options; anything else names a chip to run */
+	for (argnum = 1; argnum < argc && argv[argnum][0] == '-'; argnum++)
+	{
+		if (strcmp(argv[argnum], "-seconds") == 0 && argnum + 1 < argc)
+			seconds = atoi(argv[++argnum]);
+		else
+			break;
+	}
+	if (argnum < argc && argv[argnum][0] == '-')
+	{
+		fprintf(stderr, "Usage:\n  fmbench [-seconds <n>] [chip ...]\n");
+		return 1;
+	}
+	if (seconds <= 0)
+	{
+		fprintf(stderr, "Invalid -seconds value\n");
+		return 1;
+	}
+
+	/* run either the named chips or all of them */
+	for (index = 0; chip_list[index].name != NULL; index++)
+	{
+		int which;
+
+		for (which = argnum; which < argc; which++)
+			if (mame_stricmp(argv[which], chip_list[index].name) == 0)
+				break;
+		if (argnum == argc || which < argc)
+		{
+			run_chip(&chip_list[index], FALSE, seconds);
+			run_chip(&chip_list[index], TRUE, seconds);
+			ran++;
+		}
+	}
+	if (ran == 0)
+	{
+		fprintf(stderr, "No matching chips\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,440 @@
+/***************************************************************************
+
+    gspbench.c
+
+    Runs the TMS34010 graphics instructions with no driver around them,
+    through the real memory system, and reports the drawing speed and a
+    checksum of video RAM for each of two memory layouts.
+
+    "harddriv" maps video RAM as plain RAM, as Hard Drivin', exterm and
+    btoads do.  "midway" maps it through handlers that pack a colour
+    byte next to every pixel, as the Midway Y/T/W/X-unit boards do, and
+    names those handlers in the CPU config so the blitters can call
+    them directly; -nohooks leaves them out of the config, so every
+    word goes through the memory system as before.
+
+    Each frame clears the screen with FILL L, draws transparent sprites
+    from work RAM with PIXBLT L,L and copies a band of the screen with
+    PIXBLT L,L.  Only the instructions are timed.  The checksum only
+    depends on the core, so two builds of it can be compared for
+    accuracy by running both and comparing the figures.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "zlib.h"
+#include "driver.h"
+#include "cpu/tms34010/tms34010.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define FRAME_RATE			60
+#define DEFAULT_SECONDS		60
+
+/* screen layout; addresses are bit addresses, as the GSP sees them */
+#define SCREEN_WIDTH		400
+#define SCREEN_HEIGHT		256
+#define SCREEN_PITCH		(512 * 8)
+#define SPRITES_PER_FRAME	48
+#define SPRITE_SIZE			32
+#define SPRITE_COUNT		16
+#define COPY_HEIGHT			64
+
+/* work RAM holds the sprite sheet and the instructions */
+#define WORK_RAM_BASE		0x01000000
+#define SPRITE_BASE			WORK_RAM_BASE
+#define SPRITE_PITCH		(SPRITE_SIZE * 8)
+#define CODE_BASE			0x01300000
+
+/* I/O registers we touch */
+#define IOREG_BASE			0xc0000000
+#define IOREG_CONTROL		0x0b
+#define IOREG_PSIZE			0x15
+
+/* the instructions */
+#define OP_PIXBLT_L_L		0x0f00
+#define OP_FILL_L			0x0fc0
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _bench_layout bench_layout;
+struct _bench_layout
+{
+	const char *	name;				/* layout name */
+	construct_map_t	map;				/* memory map */
+	UINT32			vram_base;			/* bit address of the screen */
+	UINT16 **		vram;				/* video RAM, for the checksum */
+	UINT32			vram_bytes;			/* bytes of video RAM */
+	int				hooks;				/* name the VRAM handlers in the config */
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* pieces of the emulator the core and the memory system reference */
+static running_machine machine;
+static machine_config machine_drv;
+running_machine *Machine = &machine;
+int activecpu;
+mame_time time_zero;
+mame_time time_never;
+
+/* memory for the two layouts */
+static UINT16 *work_ram;
+static UINT16 *hd_vram;
+static UINT16 *mw_vram;
+static UINT16 mw_vram_data[0x80000];
+static UINT16 mw_palette = 0x2300;
+
+/* the generator for sprite positions, reseeded per run */
+static UINT32 bench_seed;
+
+
+
+/***************************************************************************
+    MIDWAY VIDEO RAM
+***************************************************************************/
+
+/* every pixel is a 16-bit word holding its data byte and a colour byte; */
+/* this is the data view of midtunit_vram_w/r, with the bank select set */
+static WRITE16_HANDLER( mw_vram_w )
+{
+	offset *= 2;
+	if (ACCESSING_LSB)
+		mw_vram[offset] = (data & 0xff) | ((mw_palette & 0xff) << 8);
+	if (ACCESSING_MSB)
+		mw_vram[offset + 1] = ((data >> 8) & 0xff) | (mw_palette & 0xff00);
+}
+
+static READ16_HANDLER( mw_vram_r )
+{
+	offset *= 2;
+	return (mw_vram[offset] & 0x00ff) | (mw_vram[offset + 1] << 8);
+}
+
+
+
+/***************************************************************************
+    ADDRESS MAPS
+***************************************************************************/
+
+static ADDRESS_MAP_START( harddriv_map, ADDRESS_SPACE_PROGRAM, 16 )
+	ADDRESS_MAP_FLAGS( AMEF_UNMAP(1) )
+	AM_RANGE(0x01000000, 0x013fffff) AM_RAM AM_BASE(&work_ram)
+	AM_RANGE(0xc0000000, 0xc00001ff) AM_READWRITE(tms34010_io_register_r, tms34010_io_register_w)
+	AM_RANGE(0xff800000, 0xffffffff) AM_RAM AM_BASE(&hd_vram)
+ADDRESS_MAP_END
+
+static ADDRESS_MAP_START( midway_map, ADDRESS_SPACE_PROGRAM, 16 )
+	ADDRESS_MAP_FLAGS( AMEF_UNMAP(1) )
+	AM_RANGE(0x00000000, 0x003fffff) AM_READWRITE(mw_vram_r, mw_vram_w)
+	AM_RANGE(0x01000000, 0x013fffff) AM_RAM AM_BASE(&work_ram)
+	AM_RANGE(0xc0000000, 0xc00001ff) AM_READWRITE(tms34010_io_register_r, tms34010_io_register_w)
+ADDRESS_MAP_END
+
+static bench_layout layout_list[] =
+{
+	{ "harddriv", construct_map_harddriv_map, 0xff800000, &hd_vram, 0x100000, FALSE },
+	{ "midway",   construct_map_midway_map,   0x00000000, &mw_vram, sizeof(mw_vram_data), TRUE },
+	{ NULL }
+};
+
+
+
+/***************************************************************************
+    CORE RUNTIME STUBS
+***************************************************************************/
+
+void CLIB_DECL fatalerror(const char *text, ...)
+{
+	va_list arg;
+
+	va_start(arg, text);
+	vfprintf(stderr, text, arg);
+	va_end(arg);
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+void CLIB_DECL logerror(const char *text, ...) { }
+void CLIB_DECL mame_printf_debug(const char *text, ...) { }
+void add_exit_callback(running_machine *machine, void (*callback)(running_machine *)) { }
+int mame_get_phase(running_machine *machine) { return MAME_PHASE_INIT; }
+UINT8 *memory_region(int num) { return NULL; }
+UINT32 memory_region_length(int num) { return 0; }
+pen_t get_black_pen(running_machine *machine) { return 0; }
+
+int state_save_registration_allowed(void) { return TRUE; }
+void state_save_register_memory(const char *module, UINT32 instance, const char *name, void *val, UINT32 valsize, UINT32 valcount) { }
+void state_save_register_func_postload(void (*func)(void)) { }
+
+mame_timer *_mame_timer_alloc(void (*callback)(running_machine *, int), const char *file, int line, const char *func) { return (mame_timer *)&bench_seed; }
+void _mame_timer_set(mame_time duration, INT32 param, void (*callback)(running_machine *, int), const char *file, int line, const char *func) { }
+void mame_timer_adjust(mame_timer *which, mame_time duration, INT32 param, mame_time period) { }
+mame_time mame_timer_timeleft(mame_timer *which) { return time_never; }
+
+void video_screen_configure(int scrnum, int width, int height, const rectangle *visarea, subseconds_t refresh) { }
+void video_screen_update_partial(int scrnum, int scanline) { }
+int video_screen_get_vpos(int scrnum) { return 0; }
+int video_screen_get_hpos(int scrnum) { return 0; }
+mame_time video_screen_get_time_until_pos(int scrnum, int vpos, int hpos) { return time_never; }
+
+void cpu_triggerint(int cpunum) { }
+void cpunum_set_input_line(int cpunum, int line, int state) { }
+void cpuintrf_push_context(int cpunum) { }
+void cpuintrf_pop_context(void) { }
+UINT32 activecpu_gettotalcycles(void) { return 0; }
+void activecpu_reset_banking(void) { }
+offs_t activecpu_get_physical_pc_byte(void) { return 0; }
+void activecpu_set_opbase(offs_t val) { }
+
+INT64 activecpu_get_info_int(UINT32 state)
+{
+	cpuinfo info;
+
+	info.i = 0;
+	tms34010_get_info(state, &info);
+	return info.i;
+}
+
+INT64 cputype_get_info_int(int cputype, UINT32 state)
+{
+	return activecpu_get_info_int(state);
+}
+
+genf *cputype_get_info_fct(int cputype, UINT32 state)
+{
+	cpuinfo info;
+
+	info.f = NULL;
+	tms34010_get_info(state, &info);
+	return info.f;
+}
+
+void *malloc_or_die_file_line(size_t size, const char *file, int line)
+{
+	void *result = malloc(size);
+	if (result == NULL)
+		fatalerror("Out of memory allocating %d bytes (%s:%d)", (int)size, file, line);
+	return result;
+}
+
+void *auto_malloc_file_line(size_t size, const char *file, int line)
+{
+	return malloc_or_die_file_line(size, file, line);
+}
+
+
+
+/***************************************************************************
+    BENCHMARK
+***************************************************************************/
+
+/*-------------------------------------------------
+    next_random - advance the position generator
+-------------------------------------------------*/
+
+static UINT32 next_random(void)
+{
+	bench_seed = bench_seed * 1664525 + 1013904223;
+	return bench_seed >> 8;
+}
+
+
+/*-------------------------------------------------
+    run_op - run a single graphics instruction
+    to completion and return the ticks it took
+-------------------------------------------------*/
+
+static osd_ticks_t run_op(UINT32 pc, UINT16 control)
+{
+	cpuinfo info;
+	osd_ticks_t start;
+
+	/* the operation happens the first time through; the core then eats */
+	/* its cycles on later passes, which we skip by clearing the P flag */
+	program_write_word_16le(TOBYTE(IOREG_BASE) + IOREG_CONTROL * 2, control);
+	tms34010_get_info(CPUINFO_PTR_SET_INFO, &info);
+	{
+		cpuinfo regs;
+
+		regs.i = 0;
+		(*info.setinfo)(CPUINFO_INT_REGISTER + TMS34010_ST, &regs);
+		regs.i = pc;
+		(*info.setinfo)(CPUINFO_INT_PC, &regs);
+	}
+	tms34010_get_info(CPUINFO_PTR_EXECUTE, &info);
+
+	start = osd_ticks();
+	(*info.execute)(1);
+	return osd_ticks() - start;
+}
+
+
+/*-------------------------------------------------
+    set_breg - set a B-file register
+-------------------------------------------------*/
+
+static void set_breg(int regnum, UINT32 value)
+{
+	cpuinfo info, regs;
+
+	tms34010_get_info(CPUINFO_PTR_SET_INFO, &info);
+	regs.i = value;
+	(*info.setinfo)(CPUINFO_INT_REGISTER + TMS34010_B0 + regnum, &regs);
+}
+
+
+/*-------------------------------------------------
+    run_layout - draw frames for the given number
+    of emulated seconds in one memory layout
+-------------------------------------------------*/
+
+static void run_layout(const bench_layout *layout, int seconds, int hooks)
+{
+	static tms34010_config config;
+	osd_ticks_t fill = 0, blit = 0, copy = 0, tps = osd_ticks_per_second();
+	double scale;
+	UINT32 crc;
+	cpuinfo info;
+	int frame, index, x, y;
+
+	/* build the machine around the layout */
+	memset(&machine_drv, 0, sizeof(machine_drv));
+	machine_drv.cpu[0].cpu_type = CPU_TMS34010;
+	machine_drv.cpu[0].construct_map[ADDRESS_SPACE_PROGRAM][0] = layout->map;
+	machine.drv = &machine_drv;
+	mw_vram = mw_vram_data;
+	memset(mw_vram_data, 0, sizeof(mw_vram_data));
+	memory_init(Machine);
+	memory_set_context(0);
+
+	/* name the VRAM handlers if asked */
+	memset(&config, 0, sizeof(config));
+	if (layout->hooks && hooks)
+	{
+		config.vram_start = 0x00000000;
+		config.vram_end = 0x003fffff;
+		config.vram_read = mw_vram_r;
+		config.vram_write = mw_vram_w;
+	}
+	tms34010_get_info(CPUINFO_PTR_INIT, &info);
+	(*info.init)(0, 50000000, &config, NULL);
+	tms34010_get_info(CPUINFO_PTR_RESET, &info);
+	(*info.reset)();
+	program_write_word_16le(TOBYTE(IOREG_BASE) + IOREG_PSIZE * 2, 8);
+
+	/* the sprite sheet: random pens with transparent borders and holes */
+	bench_seed = 0;
+	for (y = 0; y < SPRITE_COUNT * SPRITE_SIZE; y++)
+		for (x = 0; x < SPRITE_SIZE; x += 2)
+		{
+			UINT16 data = 0;
+			int pixel;
+
+			for (pixel = 0; pixel < 2; pixel++)
+			{
+				int sx = x + pixel, sy = y % SPRITE_SIZE;
+				UINT8 pen = 1 + next_random() % 255;
+
+				if (sx < 4 || sx >= SPRITE_SIZE - 4 || sy < 2 || next_random() % 8 == 0)
+					pen = 0;
+				data |= pen << (pixel * 8);
+			}
+			program_write_word_16le(TOBYTE(SPRITE_BASE + y * SPRITE_PITCH + x * 8), data);
+		}
+	program_write_word_16le(TOBYTE(CODE_BASE), OP_FILL_L);
+	program_write_word_16le(TOBYTE(CODE_BASE + 0x10), OP_PIXBLT_L_L);
+
+	for (frame = 0; frame < seconds * FRAME_RATE; frame++)
+	{
+		/* clear the screen to a colour that changes per frame */
+		set_breg(2, layout->vram_base);
+		set_breg(3, SCREEN_PITCH);
+		set_breg(7, (SCREEN_HEIGHT << 16) | SCREEN_WIDTH);
+		set_breg(9, (frame & 0xff) * 0x01010101);
+		fill += run_op(CODE_BASE, 0x0000);
+
+		/* draw transparent sprites at odd and even positions */
+		for (index = 0; index < SPRITES_PER_FRAME; index++)
+		{
+			x = next_random() % (SCREEN_WIDTH - SPRITE_SIZE);
+			y = next_random() % (SCREEN_HEIGHT - SPRITE_SIZE);
+			set_breg(0, SPRITE_BASE + (next_random() % SPRITE_COUNT) * SPRITE_SIZE * SPRITE_PITCH);
+			set_breg(1, SPRITE_PITCH);
+			set_breg(2, layout->vram_base + y * SCREEN_PITCH + x * 8);
+			set_breg(3, SCREEN_PITCH);
+			set_breg(7, (SPRITE_SIZE << 16) | SPRITE_SIZE);
+			blit += run_op(CODE_BASE + 0x10, 0x0020);
+		}
+
+		/* copy the top band of the screen to the bottom */
+		set_breg(0, layout->vram_base);
+		set_breg(1, SCREEN_PITCH);
+		set_breg(2, layout->vram_base + (SCREEN_HEIGHT - COPY_HEIGHT) * SCREEN_PITCH);
+		set_breg(3, SCREEN_PITCH);
+		set_breg(7, (COPY_HEIGHT << 16) | SCREEN_WIDTH);
+		copy += run_op(CODE_BASE + 0x10, 0x0000);
+	}
+
+	/* checksum video RAM as the host holds it */
+	crc = crc32(0, (UINT8 *)*layout->vram, layout->vram_bytes);
+
+	scale = 1000.0 / (double)tps / (seconds * FRAME_RATE);
+	printf("%-8s %d frames: fill %6.3f  blit %6.3f  copy %6.3f ms/frame, crc32 %08x\n",
+			layout->name, seconds * FRAME_RATE, fill * scale, blit * scale, copy * scale, crc);
+
+	memory_exit(Machine);
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+int CLIB_DECL main(int argc, char *argv[])
+{
+	int seconds = DEFAULT_SECONDS, hooks = TRUE;
+	int argnum, index;
+
+	/* parse the options */
+	for (argnum = 1; argnum < argc; argnum++)
+	{
+		if (strcmp(argv[argnum], "-seconds") == 0 && argnum + 1 < argc)
+			seconds = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-nohooks") == 0)
+			hooks = FALSE;
+		else
+		{
+			fprintf(stderr, "Usage:\n  gspbench [-seconds <n>] [-nohooks]\n");
+			return 1;
+		}
+	}
+	if (seconds <= 0)
+	{
+		fprintf(stderr, "Invalid -seconds value\n");
+		return 1;
+	}
+
+	for (index = 0; layout_list[index].name != NULL; index++)
+		run_layout(&layout_list[index], seconds, hooks);
+	return 0;
+}
@@ -0,0 +1,309 @@
+/***************************************************************************
+
+    sharcbench.c
+
+    Runs the ADSP-21062 SHARC core with no driver around it, executing
+    a small program from internal RAM, and reports the emulated cycle
+    throughput and a checksum of what the program stored to external
+    memory for each mix.
+
+    The program seeds eight registers, then loops over fixed-point ALU
+    operations and stores two results to external memory per pass.  The
+    mixes are "alu", which just runs it; and "patch", where the host
+    rewrites the first instruction of the loop over the DMA port every
+    frame, as a host CPU loading new DSP code would.  The second one
+    only gives the same checksum if code changes reach the core.
+
+    The program is loaded the way the host boot drivers do it, through
+    the external DMA port.  Only the core's execute calls are timed.
+    The checksum only depends on the core, so two builds of it can be
+    compared for accuracy by running both and comparing the figures.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "zlib.h"
+#include "driver.h"
+#include "cpu/sharc/sharc.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define SHARC_CLOCK			40000000
+#define FRAME_RATE			60
+#define DEFAULT_SECONDS		60
+
+#define PROGRAM_START		0x20004
+#define LOOP_START			(PROGRAM_START + 8)
+#define RESULT_ADDRESS		0x400000
+
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+/* unconditional compute: Rn = Rx op Ry */
+#define COMPUTE(op,rn,rx,ry)	(((UINT64)(0x0100 | (31 << 1)) << 32) | ((op) << 12) | ((rn) << 8) | ((rx) << 4) | (ry))
+
+/* Rn = immediate */
+#define LOAD(rn,data)			(((UINT64)(0x0f00 | (rn)) << 32) | (UINT32)(data))
+
+/* DM(address) = Rn */
+#define STORE(rn,address)		(((UINT64)(0x1100 | (rn)) << 32) | (UINT32)(address))
+
+/* unconditional jump relative to this instruction */
+#define JUMP(offset)			(((UINT64)(0x0700 | (31 << 1)) << 32) | ((offset) & 0xffffff))
+
+#define ALU_ADD					0x01
+#define ALU_SUB					0x02
+#define ALU_INC					0x29
+#define ALU_XOR					0x42
+#define ALU_MAX					0x62
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _bench_mix bench_mix;
+struct _bench_mix
+{
+	const char *	name;				/* mix name */
+	int				patch;				/* rewrite the loop every frame? */
+};
+
+
+
+/***************************************************************************
+    PROGRAMS
+***************************************************************************/
+
+static const UINT64 alu_code[] =
+{
+	LOAD(0, 0x12345678),				/* 20004: r0 = 0x12345678    */
+	LOAD(1, 0x00000001),				/* 20005: r1 = 1             */
+	LOAD(2, 0x9abcdef0),				/* 20006: r2 = 0x9abcdef0    */
+	LOAD(3, 0x0f0f0f0f),				/* 20007: r3 = 0x0f0f0f0f    */
+	LOAD(4, 0x00000000),				/* 20008: r4 = 0             */
+	LOAD(5, 0x00000000),				/* 20009: r5 = 0             */
+	LOAD(6, 0x00000100),				/* 2000a: r6 = 0x100         */
+	LOAD(7, 0x00000000),				/* 2000b: r7 = 0             */
+	COMPUTE(ALU_ADD, 0, 0, 1),			/* 2000c: r0 = r0 + r1       */
+	COMPUTE(ALU_XOR, 2, 2, 0),			/* 2000d: r2 = r2 xor r0     */
+	COMPUTE(ALU_ADD, 3, 3, 2),			/* 2000e: r3 = r3 + r2       */
+	COMPUTE(ALU_INC, 1, 1, 0),			/* 2000f: r1 = r1 + 1        */
+	COMPUTE(ALU_MAX, 4, 3, 0),			/* 20010: r4 = max(r3, r0)   */
+	COMPUTE(ALU_SUB, 5, 4, 2),			/* 20011: r5 = r4 - r2       */
+	COMPUTE(ALU_XOR, 6, 6, 5),			/* 20012: r6 = r6 xor r5     */
+	COMPUTE(ALU_ADD, 7, 7, 6),			/* 20013: r7 = r7 + r6       */
+	STORE(0, RESULT_ADDRESS + 0),		/* 20014: dm(400000) = r0    */
+	STORE(7, RESULT_ADDRESS + 1),		/* 20015: dm(400001) = r7    */
+	JUMP(-10)							/* 20016: jump (pc, 2000c)   */
+};
+
+/* what "patch" alternates the first loop instruction between */
+static const UINT64 patch_code[2] =
+{
+	COMPUTE(ALU_ADD, 0, 0, 1),			/* 2000c: r0 = r0 + r1       */
+	COMPUTE(ALU_SUB, 0, 0, 1)			/* 2000c: r0 = r0 - r1       */
+};
+
+static const bench_mix mix_list[] =
+{
+	{ "alu",   FALSE },
+	{ "patch", TRUE },
+	{ NULL }
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* pieces of the emulator the core references */
+UINT8 opcode_entry;
+address_space active_address_space[ADDRESS_SPACES];
+
+/* a running hash of the external memory writes */
+static UINT32 write_hash;
+
+
+
+/***************************************************************************
+    CORE RUNTIME STUBS
+***************************************************************************/
+
+void CLIB_DECL fatalerror(const char *text, ...)
+{
+	va_list arg;
+
+	va_start(arg, text);
+	vfprintf(stderr, text, arg);
+	va_end(arg);
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+void CLIB_DECL mame_printf_debug(const char *text, ...) { }
+void memory_set_opbase(offs_t offset) { }
+
+void *auto_malloc_file_line(size_t size, const char *file, int line)
+{
+	void *result = malloc(size);
+	if (result == NULL)
+		fatalerror("Out of memory allocating %d bytes (%s:%d)", (int)size, file, line);
+	return result;
+}
+
+/* external memory reads back nothing and hashes the writes in order */
+UINT32 data_read_dword_32le(offs_t address)					{ return 0; }
+void data_write_dword_32le(offs_t address, UINT32 data)		{ write_hash = (write_hash ^ data ^ address) * 0x01000193; }
+
+
+
+/***************************************************************************
+    BENCHMARK
+***************************************************************************/
+
+/*-------------------------------------------------
+    host_load - write 48-bit instructions into
+    internal RAM through the external DMA port,
+    16 bits at a time, as a host CPU does
+-------------------------------------------------*/
+
+static void host_load(offs_t address, const UINT64 *code, int count)
+{
+	int index, shift;
+
+	sharc_external_iop_write(0x40, address);	/* II6 */
+	sharc_external_iop_write(0x41, 1);			/* IM6 */
+	sharc_external_iop_write(0x1c, 0x80);		/* DMAC6: 16/48 packing */
+	for (index = 0; index < count; index++)
+		for (shift = 0; shift < 3; shift++)
+			sharc_external_dma_write(shift, code[index] >> (shift * 16));
+}
+
+
+/*-------------------------------------------------
+    run_mix - run one mix for the given number
+    of emulated seconds
+-------------------------------------------------*/
+
+static void run_mix(const bench_mix *mix, int seconds)
+{
+	static const sharc_config config = { BOOT_MODE_HOST };
+	int (*execute)(int cycles);
+	osd_ticks_t start, elapsed = 0, tps = osd_ticks_per_second();
+	UINT64 total = 0, target = (UINT64)seconds * SHARC_CLOCK;
+	UINT32 crc = 0;
+	UINT8 bytes[8];
+	double cpuseconds;
+	cpuinfo info;
+	int frame;
+
+	/* start the core and boot the program from the host */
+	adsp21062_get_info(CPUINFO_PTR_INIT, &info);
+	(*info.init)(0, SHARC_CLOCK, &config, NULL);
+	adsp21062_get_info(CPUINFO_PTR_RESET, &info);
+	(*info.reset)();
+	adsp21062_get_info(CPUINFO_PTR_EXECUTE, &info);
+	execute = info.execute;
+	host_load(PROGRAM_START, alu_code, ARRAY_LENGTH(alu_code));
+	write_hash = 0;
+
+	/* run a frame's worth of cycles at a time, as the scheduler would */
+	for (frame = 0; total < target; frame++)
+	{
+		if (mix->patch)
+			host_load(LOOP_START, &patch_code[frame & 1], 1);
+
+		start = osd_ticks();
+		total += (*execute)(SHARC_CLOCK / FRAME_RATE);
+		elapsed += osd_ticks() - start;
+	}
+	cpuseconds = (double)elapsed / (double)tps;
+
+	/* checksum the PC, then the writes */
+	adsp21062_get_info(CPUINFO_INT_PC, &info);
+	bytes[0] = info.i >> 0;
+	bytes[1] = info.i >> 8;
+	bytes[2] = info.i >> 16;
+	bytes[3] = info.i >> 24;
+	bytes[4] = write_hash >> 0;
+	bytes[5] = write_hash >> 8;
+	bytes[6] = write_hash >> 16;
+	bytes[7] = write_hash >> 24;
+	crc = crc32(crc, bytes, sizeof(bytes));
+
+	printf("%-7s %d s at %d Hz in %7.3f s (%7.2f Mcycles/sec), crc32 %08x\n",
+			mix->name, seconds, SHARC_CLOCK, cpuseconds,
+			(cpuseconds > 0) ? (double)total / cpuseconds / 1e6 : 0.0, crc);
+
+	adsp21062_get_info(CPUINFO_PTR_EXIT, &info);
+	if (info.exit != NULL)
+		(*info.exit)();
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+int CLIB_DECL main(int argc, char *argv[])
+{
+	int seconds = DEFAULT_SECONDS;
+	int argnum, index, ran = 0;
+
+	/* parse the options; anything else names a mix to run */
+	for (argnum = 1; argnum < argc && argv[argnum][0] == '-'; argnum++)
+	{
+		if (strcmp(argv[argnum], "-seconds") == 0 && argnum + 1 < argc)
+			seconds = atoi(argv[++argnum]);
+		else
+			break;
+	}
+	if (argnum < argc && argv[argnum][0] == '-')
+	{
+		fprintf(stderr, "Usage:\n  sharcbench [-seconds <n>] [mix ...]\n");
+		return 1;
+	}
+	if (seconds <= 0)
+	{
+		fprintf(stderr, "Invalid -seconds value\n");
+		return 1;
+	}
+
+	/* run either the named mixes or all of them */
+	for (index = 0; mix_list[index].name != NULL; index++)
+	{
+		int which;
+
+		for (which = argnum; which < argc; which++)
+			if (mame_stricmp(argv[which], mix_list[index].name) == 0)
+				break;
+		if (argnum == argc || which < argc)
+		{
+			run_mix(&mix_list[index], seconds);
+			ran++;
+		}
+	}
+	if (ran == 0)
+	{
+		fprintf(stderr, "No matching mixes\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,859 @@
+/***************************************************************************
+
+    sndreplay.c
+
+    Replays a sound chip register write log (see -soundlog) through a
+    single sound core as fast as possible, reporting the rendering
+    speed and a checksum of the output.
+
+    The chips' own timers are run as well, on the same timeline as the
+    logged writes, so timer-driven behaviour such as CSM key-on is
+    reproduced; the IRQs they raise go nowhere.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include "zlib.h"
+#include "sndintrf.h"
+#include "streams.h"
+#include "sound/fm.h"
+#include "sound/ym2151.h"
+#include "sound/ymf262.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define MAX_OUTPUTS			4
+#define MAX_TIMERS			64
+#define RENDER_CHUNK		1024
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _replay_chip replay_chip;
+struct _replay_chip
+{
+	char			name[256];			/* chip name from the log */
+	UINT32			clock;				/* chip clock from the log */
+	UINT32			writes;				/* number of logged writes */
+	UINT8 *			rom[SOUNDLOG_MAX_ROMS];	/* sample ROMs from the log, or NULL */
+	UINT32			romlength[SOUNDLOG_MAX_ROMS];
+};
+
+
+typedef struct _replay_core replay_core;
+struct _replay_core
+{
+	const char *	name;				/* chip name, as written in the log */
+	int				outputs;			/* number of output channels */
+	int				divider;			/* sample rate = clock / divider */
+	void *			(*start)(const replay_chip *chip, int rate);
+	void			(*stop)(void *token);
+	void			(*write)(void *token, offs_t offset, UINT32 data);
+	void			(*update)(void *token, stream_sample_t **buffer, int length);
+};
+
+
+struct _mame_timer
+{
+	int				used;				/* allocated? */
+	int				enabled;			/* will it fire? */
+	int				temporary;			/* freed after firing? */
+	UINT32			order;				/* adjust sequence, so equal expiry times fire in order */
+	mame_time		expire;				/* when it fires next */
+	mame_time		period;				/* repeat period, or zero for one-shot */
+	void			(*callback)(running_machine *, void *);
+	void *			param;
+};
+
+
+/* glue for the OPN family, which leaves its timers to the interface */
+typedef struct _replay_fm replay_fm;
+struct _replay_fm
+{
+	void *			chip;				/* the core's own state */
+	mame_timer *	timer[2];			/* timers A and B */
+	int				(*timer_over)(void *chip, int c);
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+static UINT8 *logdata;
+static UINT32 loglength;
+static replay_chip chip_list[MAX_SOUND];
+
+/* the time of the write or timer being replayed, as seen by the core */
+static mame_time replay_time;
+
+/* the chip's timers */
+static mame_timer timer_list[MAX_TIMERS];
+static UINT32 timer_order;
+static UINT32 timer_fires;
+
+
+
+/***************************************************************************
+    CORE RUNTIME STUBS
+***************************************************************************/
+
+/* the cores only need a handful of emulator services; */
+/* IRQs and save states are meaningless here */
+
+mame_time time_zero;
+mame_time time_never;
+
+mame_time mame_timer_get_time(void)
+{
+	return replay_time;
+}
+
+void CLIB_DECL logerror(const char *text, ...)
+{
+}
+
+void state_save_register_memory(const char *module, UINT32 instance, const char *name, void *val, UINT32 valsize, UINT32 valcount)
+{
+}
+
+void state_save_register_func_postload_ptr(void (*func)(void *), void *param)
+{
+}
+
+#if BUILD_YM2203
+void YM2203UpdateRequest(void *param) { }
+#endif
+#if BUILD_YM2608
+void YM2608UpdateRequest(void *param) { }
+#endif
+#if (BUILD_YM2610||BUILD_YM2610B)
+void YM2610UpdateRequest(void *param) { }
+#endif
+#if BUILD_YM2612
+void YM2612UpdateRequest(void *param) { }
+#endif
+
+static void fm_irq_handler(void *param, int irq) { }
+static void psg_set_clock(void *param, int clock) { }
+static void psg_write(void *param, int address, int data) { }
+static int psg_read(void *param) { return 0; }
+static void psg_reset(void *param) { }
+
+static const struct ssg_callbacks psgintf =
+{
+	psg_set_clock,
+	psg_write,
+	psg_read,
+	psg_reset
+};
+
+
+
+/***************************************************************************
+    TIMERS
+***************************************************************************/
+
+/* a minimal version of timer.c: timers fire in expiry order between */
+/* the logged writes, with the replay time set to their expiry time */
+
+mame_timer *_mame_timer_alloc_ptr(void (*callback)(running_machine *, void *), void *param, const char *file, int line, const char *func)
+{
+	mame_timer *timer;
+
+	for (timer = timer_list; timer < &timer_list[MAX_TIMERS]; timer++)
+		if (!timer->used)
+		{
+			memset(timer, 0, sizeof(*timer));
+			timer->used = TRUE;
+			timer->callback = callback;
+			timer->param = param;
+			timer->expire = time_never;
+			return timer;
+		}
+
+	fprintf(stderr, "Out of timers allocating %s (%s:%d)\n", func, file, line);
+	exit(1);
+	return NULL;
+}
+
+void mame_timer_adjust_ptr(mame_timer *which, mame_time duration, mame_time period)
+{
+	which->enabled = TRUE;
+	which->order = timer_order++;
+	which->expire = add_mame_times(replay_time, duration);
+	which->period = period;
+}
+
+void _mame_timer_set_ptr(mame_time duration, void *param, void (*callback)(running_machine *, void *), const char *file, int line, const char *func)
+{
+	mame_timer *timer = _mame_timer_alloc_ptr(callback, param, file, line, func);
+
+	timer->temporary = TRUE;
+	mame_timer_adjust_ptr(timer, duration, time_zero);
+}
+
+int mame_timer_enable(mame_timer *which, int enable)
+{
+	int old = which->enabled;
+
+	which->enabled = enable;
+	return old;
+}
+
+
+/*-------------------------------------------------
+    next_timer - find the enabled timer that
+    expires first, if it expires by the limit
+-------------------------------------------------*/
+
+static mame_timer *next_timer(mame_time limit)
+{
+	mame_timer *timer, *result = NULL;
+
+	for (timer = timer_list; timer < &timer_list[MAX_TIMERS]; timer++)
+		if (timer->used && timer->enabled && compare_mame_times(timer->expire, limit) <= 0)
+		{
+			int compare = (result == NULL) ? -1 : compare_mame_times(timer->expire, result->expire);
+			if (compare < 0 || (compare == 0 && (INT32)(timer->order - result->order) < 0))
+				result = timer;
+		}
+	return result;
+}
+
+
+/*-------------------------------------------------
+    fire_timer - call a timer's callback at its
+    expiry time, then reschedule or free it
+-------------------------------------------------*/
+
+static void fire_timer(mame_timer *timer)
+{
+	UINT32 order = timer->order;
+
+	replay_time = timer->expire;
+
+	/* one-shots are disabled before the callback, which may restart them */
+	if (compare_mame_times(timer->period, time_zero) == 0 || compare_mame_times(timer->period, time_never) == 0)
+		timer->enabled = FALSE;
+
+	(*timer->callback)(NULL, timer->param);
+	timer_fires++;
+
+	/* leave it alone if the callback adjusted it */
+	if (timer->order == order)
+	{
+		if (timer->temporary)
+			timer->used = FALSE;
+		else
+			timer->expire = add_mame_times(timer->expire, timer->period);
+	}
+}
+
+
+
+/***************************************************************************
+    CORE GLUE
+***************************************************************************/
+
+/* the OPN cores report timer loads and stops; mirror 2203intf.c etc. */
+
+static TIMER_CALLBACK_PTR( fm_timer_callback_0 )
+{
+	replay_fm *info = param;
+	(*info->timer_over)(info->chip, 0);
+}
+
+static TIMER_CALLBACK_PTR( fm_timer_callback_1 )
+{
+	replay_fm *info = param;
+	(*info->timer_over)(info->chip, 1);
+}
+
+static void fm_timer_handler(void *param, int c, int count, int clock)
+{
+	replay_fm *info = param;
+
+	if (count == 0)
+		mame_timer_enable(info->timer[c], 0);
+	else
+	{
+		mame_time period = scale_up_mame_time(MAME_TIME_IN_HZ(clock), count);
+		if (!mame_timer_enable(info->timer[c], 1))
+			mame_timer_adjust_ptr(info->timer[c], period, time_zero);
+	}
+}
+
+static replay_fm *fm_alloc(int (*timer_over)(void *chip, int c))
+{
+	replay_fm *info = malloc(sizeof(*info));
+
+	if (info == NULL)
+		return NULL;
+	info->chip = NULL;
+	info->timer[0] = mame_timer_alloc_ptr(fm_timer_callback_0, info);
+	info->timer[1] = mame_timer_alloc_ptr(fm_timer_callback_1, info);
+	info->timer_over = timer_over;
+	return info;
+}
+
+static void *fm_started(replay_fm *info)
+{
+	if (info->chip != NULL)
+		return info;
+	free(info);
+	return NULL;
+}
+
+
+#if BUILD_YM2203
+static void *ym2203_start(const replay_chip *chip, int rate)
+{
+	replay_fm *info = fm_alloc(YM2203TimerOver);
+	if (info == NULL)
+		return NULL;
+	info->chip = YM2203Init(info, 0, chip->clock, rate, fm_timer_handler, fm_irq_handler, &psgintf);
+	return fm_started(info);
+}
+
+static void ym2203_stop(void *token)
+{
+	replay_fm *info = token;
+	YM2203Shutdown(info->chip);
+	free(info);
+}
+
+static void ym2203_write(void *token, offs_t offset, UINT32 data)
+{
+	replay_fm *info = token;
+	YM2203Write(info->chip, offset & 1, data);
+}
+
+static void ym2203_update(void *token, stream_sample_t **buffer, int length)
+{
+	replay_fm *info = token;
+	YM2203UpdateOne(info->chip, buffer[0], length);
+}
+#endif
+
+
+#if BUILD_YM2608
+static void *ym2608_start(const replay_chip *chip, int rate)
+{
+	replay_fm *info = fm_alloc(YM2608TimerOver);
+	if (info == NULL)
+		return NULL;
+	info->chip = YM2608Init(info, 0, chip->clock, rate, chip->rom[0], chip->romlength[0],
+			fm_timer_handler, fm_irq_handler, &psgintf);
+	return fm_started(info);
+}
+
+static void ym2608_stop(void *token)
+{
+	replay_fm *info = token;
+	YM2608Shutdown(info->chip);
+	free(info);
+}
+
+static void ym2608_write(void *token, offs_t offset, UINT32 data)
+{
+	replay_fm *info = token;
+	YM2608Write(info->chip, offset & 3, data);
+}
+
+static void ym2608_update(void *token, stream_sample_t **buffer, int length)
+{
+	replay_fm *info = token;
+	YM2608UpdateOne(info->chip, buffer, length);
+}
+#endif
+
+
+#if (BUILD_YM2610||BUILD_YM2610B)
+static void *ym2610_start(const replay_chip *chip, int rate)
+{
+	replay_fm *info = fm_alloc(YM2610TimerOver);
+	if (info == NULL)
+		return NULL;
+	info->chip = YM2610Init(info, 0, chip->clock, rate, chip->rom[0], chip->romlength[0], chip->rom[1], chip->romlength[1],
+			fm_timer_handler, fm_irq_handler, &psgintf);
+	return fm_started(info);
+}
+
+static void ym2610_stop(void *token)
+{
+	replay_fm *info = token;
+	YM2610Shutdown(info->chip);
+	free(info);
+}
+
+static void ym2610_write(void *token, offs_t offset, UINT32 data)
+{
+	replay_fm *info = token;
+	YM2610Write(info->chip, offset & 3, data);
+}
+#endif
+
+#if BUILD_YM2610
+static void ym2610_update(void *token, stream_sample_t **buffer, int length)
+{
+	replay_fm *info = token;
+	YM2610UpdateOne(info->chip, buffer, length);
+}
+#endif
+
+#if BUILD_YM2610B
+static void ym2610b_update(void *token, stream_sample_t **buffer, int length)
+{
+	replay_fm *info = token;
+	YM2610BUpdateOne(info->chip, buffer, length);
+}
+#endif
+
+
+#if BUILD_YM2612
+static void *ym2612_start(const replay_chip *chip, int rate)
+{
+	replay_fm *info = fm_alloc(YM2612TimerOver);
+	if (info == NULL)
+		return NULL;
+	info->chip = YM2612Init(info, 0, chip->clock, rate, fm_timer_handler, fm_irq_handler);
+	return fm_started(info);
+}
+
+static void ym2612_stop(void *token)
+{
+	replay_fm *info = token;
+	YM2612Shutdown(info->chip);
+	free(info);
+}
+
+static void ym2612_write(void *token, offs_t offset, UINT32 data)
+{
+	replay_fm *info = token;
+	YM2612Write(info->chip, offset & 3, data);
+}
+
+static void ym2612_update(void *token, stream_sample_t **buffer, int length)
+{
+	replay_fm *info = token;
+	YM2612UpdateOne(info->chip, buffer, length);
+}
+#endif
+
+
+#if (HAS_YM2151)
+/* the OPM core runs its own timers; the log holds (register, data) pairs */
+static void *ym2151_start(const replay_chip *chip, int rate)
+{
+	return YM2151Init(0, chip->clock, rate);
+}
+
+static void ym2151_write(void *chip, offs_t offset, UINT32 data)
+{
+	YM2151WriteReg(chip, offset & 0xff, data);
+}
+
+static void ym2151_update(void *chip, stream_sample_t **buffer, int length)
+{
+	YM2151UpdateOne(chip, buffer, length);
+}
+#endif
+
+
+#if BUILD_YMF262
+static void *ymf262_start(const replay_chip *chip, int rate)
+{
+	return YMF262Init(chip->clock, rate);
+}
+
+static void ymf262_write(void *chip, offs_t offset, UINT32 data)
+{
+	YMF262Write(chip, offset & 3, data);
+}
+
+static void ymf262_update(void *chip, stream_sample_t **buffer, int length)
+{
+	YMF262UpdateOne(chip, buffer, length);
+}
+#endif
+
+
+static const replay_core core_list[] =
+{
+#if BUILD_YM2203
+	{ "YM2203",  1,  72, ym2203_start, ym2203_stop,    ym2203_write, ym2203_update },
+#endif
+#if BUILD_YM2608
+	{ "YM2608",  2,  72, ym2608_start, ym2608_stop,    ym2608_write, ym2608_update },
+#endif
+#if BUILD_YM2610
+	{ "YM2610",  2,  72, ym2610_start, ym2610_stop,    ym2610_write, ym2610_update },
+#endif
+#if BUILD_YM2610B
+	{ "YM2610B", 2,  72, ym2610_start, ym2610_stop,    ym2610_write, ym2610b_update },
+#endif
+#if BUILD_YM2612
+	{ "YM2612",  2,  72, ym2612_start, ym2612_stop,    ym2612_write, ym2612_update },
+	{ "YM3438",  2,  72, ym2612_start, ym2612_stop,    ym2612_write, ym2612_update },
+#endif
+#if (HAS_YM2151)
+	{ "YM2151",  2,  64, ym2151_start, YM2151Shutdown, ym2151_write, ym2151_update },
+#endif
+#if BUILD_YMF262
+	{ "YMF262",  4, 288, ymf262_start, YMF262Shutdown, ymf262_write, ymf262_update },
+#endif
+	{ NULL }
+};
+
+
+
+/***************************************************************************
+    LOG PARSING
+***************************************************************************/
+
+/*-------------------------------------------------
+    read_varint - decode a varint from the log
+-------------------------------------------------*/
+
+static int read_varint(UINT32 *offset, UINT64 *result)
+{
+	UINT64 value = 0;
+	int shift = 0;
+
+	while (*offset < loglength)
+	{
+		UINT8 byte = logdata[(*offset)++];
+		value |= (UINT64)(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+		{
+			*result = value;
+			return TRUE;
+		}
+		shift += 7;
+	}
+	return FALSE;
+}
+
+
+/*-------------------------------------------------
+    next_record - parse one record; returns the
+    record tag, or 0 at the end of the log
+-------------------------------------------------*/
+
+static int next_record(UINT32 *offset, UINT64 *time, int *sndnum, UINT64 *regoffs, UINT64 *data)
+{
+	UINT64 delta;
+	int tag;
+
+	if (*offset >= loglength)
+		return 0;
+	tag = logdata[(*offset)++];
+
+	switch (tag)
+	{
+		case SOUNDLOG_CHIP:
+		{
+			replay_chip *chip;
+			int namelen;
+
+			if (*offset + 2 > loglength)
+				return 0;
+			*sndnum = logdata[(*offset)++];
+			namelen = logdata[(*offset)++];
+			if (*sndnum >= MAX_SOUND || *offset + namelen + 4 > loglength)
+				return 0;
+
+			chip = &chip_list[*sndnum];
+			memcpy(chip->name, &logdata[*offset], namelen);
+			chip->name[namelen] = 0;
+			*offset += namelen;
+			chip->clock = logdata[*offset] | (logdata[*offset + 1] << 8) | (logdata[*offset + 2] << 16) | ((UINT32)logdata[*offset + 3] << 24);
+			*offset += 4;
+			return tag;
+		}
+
+		case SOUNDLOG_ROM:
+		{
+			UINT32 length;
+			int romnum;
+
+			if (*offset + 6 > loglength)
+				return 0;
+			*sndnum = logdata[(*offset)++];
+			romnum = logdata[(*offset)++];
+			length = logdata[*offset] | (logdata[*offset + 1] << 8) | (logdata[*offset + 2] << 16) | ((UINT32)logdata[*offset + 3] << 24);
+			*offset += 4;
+			if (*sndnum >= MAX_SOUND || romnum >= SOUNDLOG_MAX_ROMS || length > loglength - *offset)
+				return 0;
+
+			/* the ROM is used straight out of the log */
+			chip_list[*sndnum].rom[romnum] = &logdata[*offset];
+			chip_list[*sndnum].romlength[romnum] = length;
+			*offset += length;
+			return tag;
+		}
+
+		case SOUNDLOG_WRITE:
+			if (!read_varint(offset, &delta) || *offset >= loglength)
+				return 0;
+			*time += delta;
+			*sndnum = logdata[(*offset)++];
+			if (*sndnum >= MAX_SOUND || !read_varint(offset, regoffs) || !read_varint(offset, data))
+				return 0;
+			return tag;
+
+		case SOUNDLOG_END:
+			if (!read_varint(offset, &delta))
+				return 0;
+			*time += delta;
+			return tag;
+	}
+
+	fprintf(stderr, "Unknown record type %02X at offset %d\n", tag, *offset - 1);
+	return 0;
+}
+
+
+
+/***************************************************************************
+    REPLAY
+***************************************************************************/
+
+/*-------------------------------------------------
+    ns_to_mame_time - convert a log timestamp
+-------------------------------------------------*/
+
+static mame_time ns_to_mame_time(UINT64 time)
+{
+	mame_time result;
+
+	result.seconds = time / 1000000000;
+	result.subseconds = (time % 1000000000) * MAX_SUBSECONDS_SQRT;
+	return result;
+}
+
+
+/*-------------------------------------------------
+    mame_time_to_sample - return the number of
+    samples rendered by the given time
+-------------------------------------------------*/
+
+static UINT64 mame_time_to_sample(mame_time time, int rate)
+{
+	UINT64 nsec = (UINT64)time.seconds * 1000000000 + time.subseconds / MAX_SUBSECONDS_SQRT;
+	return nsec * rate / 1000000000;
+}
+
+
+/*-------------------------------------------------
+    render - run the core up to the given sample
+    and fold its output into the checksum
+-------------------------------------------------*/
+
+static void render(const replay_core *core, void *token, stream_sample_t **buffer, UINT64 *position, UINT64 target, UINT32 *crc)
+{
+	UINT8 bytes[RENDER_CHUNK * MAX_OUTPUTS * 4];
+
+	while (*position < target)
+	{
+		int length = (target - *position > RENDER_CHUNK) ? RENDER_CHUNK : (int)(target - *position);
+		int outnum, sampnum;
+		UINT8 *dest = bytes;
+
+		(*core->update)(token, buffer, length);
+
+		/* checksum the output little-endian, interleaved by channel */
+		for (sampnum = 0; sampnum < length; sampnum++)
+			for (outnum = 0; outnum < core->outputs; outnum++)
+			{
+				UINT32 sample = buffer[outnum][sampnum];
+				*dest++ = sample >> 0;
+				*dest++ = sample >> 8;
+				*dest++ = sample >> 16;
+				*dest++ = sample >> 24;
+			}
+		*crc = crc32(*crc, bytes, dest - bytes);
+
+		*position += length;
+	}
+}
+
+
+/*-------------------------------------------------
+    replay_chip_log - replay all the writes to
+    one chip and report the results
+-------------------------------------------------*/
+
+static int replay_chip_log(int chipnum)
+{
+	replay_chip *chip = &chip_list[chipnum];
+	stream_sample_t *buffer[MAX_OUTPUTS];
+	const replay_core *core;
+	UINT64 time = 0, position = 0;
+	UINT32 offset = 8, crc = 0;
+	int rate, outnum, tag;
+	void *token;
+	clock_t start, elapsed;
+	double seconds;
+
+	/* find a core for this chip */
+	for (core = core_list; core->name != NULL; core++)
+		if (strcmp(core->name, chip->name) == 0)
+			break;
+	if (core->name == NULL)
+	{
+		printf("chip %d: %s has no replay support, skipped\n", chipnum, chip->name);
+		return 0;
+	}
+
+	/* each chip starts from a clean timeline */
+	memset(timer_list, 0, sizeof(timer_list));
+	timer_order = timer_fires = 0;
+	replay_time = time_zero;
+
+	rate = chip->clock / core->divider;
+	token = (*core->start)(chip, rate);
+	if (token == NULL)
+	{
+		fprintf(stderr, "Unable to start %s core\n", core->name);
+		return 1;
+	}
+	for (outnum = 0; outnum < MAX_OUTPUTS; outnum++)
+		buffer[outnum] = malloc(RENDER_CHUNK * sizeof(buffer[outnum][0]));
+
+	start = clock();
+	for (;;)
+	{
+		UINT64 regoffs, data;
+		mame_time recordtime;
+		mame_timer *timer;
+		int sndnum;
+
+		tag = next_record(&offset, &time, &sndnum, &regoffs, &data);
+		if (tag == 0)
+			break;
+		if (tag == SOUNDLOG_CHIP || tag == SOUNDLOG_ROM)
+			continue;
+		if (tag == SOUNDLOG_WRITE && sndnum != chipnum)
+			continue;
+
+		/* fire the timers that expire first, rendering up to each one */
+		recordtime = ns_to_mame_time(time);
+		while ((timer = next_timer(recordtime)) != NULL)
+		{
+			render(core, token, buffer, &position, mame_time_to_sample(timer->expire, rate), &crc);
+			fire_timer(timer);
+		}
+
+		/* then render up to the time of this record */
+		render(core, token, buffer, &position, mame_time_to_sample(recordtime, rate), &crc);
+		if (tag == SOUNDLOG_END)
+			break;
+
+		replay_time = recordtime;
+		(*core->write)(token, regoffs, data);
+	}
+	elapsed = clock() - start;
+	seconds = (double)elapsed / (double)CLOCKS_PER_SEC;
+
+	printf("chip %d: %s @ %d Hz, %d writes, %d timer callbacks, %.0f samples at %d Hz in %.3f s (%.0f samples/sec), crc32 %08x\n",
+			chipnum, core->name, chip->clock, chip->writes, timer_fires, (double)position, rate,
+			seconds, (seconds > 0) ? (double)position / seconds : 0.0, crc);
+
+	(*core->stop)(token);
+	for (outnum = 0; outnum < MAX_OUTPUTS; outnum++)
+		free(buffer[outnum]);
+	return 0;
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+int CLIB_DECL main(int argc, char *argv[])
+{
+	UINT64 time = 0, regoffs, data;
+	UINT32 offset = 8;
+	int chipnum, sndnum, tag, result = 0;
+	FILE *file;
+
+	/* print usage */
+	if (argc != 2 && argc != 3)
+	{
+		fprintf(stderr, "Usage:\n  sndreplay <logfile> [chipnum]\n");
+		return 1;
+	}
+
+	/* read the whole log into memory */
+	file = fopen(argv[1], "rb");
+	if (file == NULL)
+	{
+		fprintf(stderr, "Unable to open %s\n", argv[1]);
+		return 1;
+	}
+	fseek(file, 0, SEEK_END);
+	loglength = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	logdata = malloc(loglength);
+	if (logdata == NULL || fread(logdata, 1, loglength, file) != loglength)
+	{
+		fprintf(stderr, "Unable to read %s\n", argv[1]);
+		fclose(file);
+		return 1;
+	}
+	fclose(file);
+
+	/* version 1 logs simply have no ROM records */
+	if (loglength < 8 || memcmp(logdata, SOUNDLOG_MAGIC, 7) != 0 || logdata[7] < 1 || logdata[7] > SOUNDLOG_VERSION)
+	{
+		fprintf(stderr, "%s is not a version 1-%d sound log\n", argv[1], SOUNDLOG_VERSION);
+		return 1;
+	}
+
+	/* first pass: gather the chips and count their writes */
+	while ((tag = next_record(&offset, &time, &sndnum, &regoffs, &data)) != 0)
+		if (tag == SOUNDLOG_WRITE)
+			chip_list[sndnum].writes++;
+	printf("%s: %.3f s of logged time\n", argv[1], (double)time / 1000000000.0);
+
+	time_never.seconds = MAX_SECONDS;
+
+	/* then replay either the requested chip or all of them in turn */
+	if (argc == 3)
+	{
+		chipnum = atoi(argv[2]);
+		if (chipnum < 0 || chipnum >= MAX_SOUND || chip_list[chipnum].name[0] == 0)
+		{
+			fprintf(stderr, "No chip %d in %s\n", chipnum, argv[1]);
+			return 1;
+		}
+		result = replay_chip_log(chipnum);
+	}
+	else
+	{
+		for (chipnum = 0; chipnum < MAX_SOUND; chipnum++)
+			if (chip_list[chipnum].name[0] != 0)
+				result |= replay_chip_log(chipnum);
+	}
+
+	free(logdata);
+	return result;
+}
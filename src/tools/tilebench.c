@@ -0,0 +1,346 @@
+/***************************************************************************
+
+    tilebench.c
+
+    Runs the tilemap system with no driver around it, compositing
+    scrolling 8x8 tilemaps into a 320x224 indexed bitmap once per
+    video frame, and reports the drawing speed and a checksum of the
+    output for each workload.
+
+    Two workloads are run: "2layer" draws an opaque background and one
+    transparent foreground, while "4layer" draws an opaque background
+    and three transparent layers, one of them with per-line scroll.
+    The tile set mixes fully opaque, fully transparent and partially
+    transparent tiles, and a few tiles per layer are rewritten every
+    frame, as in a game scrolling new tiles into view.
+
+    Only tilemap_draw() is timed.  The checksum only depends on the
+    tilemap code, so two builds of it can be compared for accuracy by
+    running both and comparing the figures.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "zlib.h"
+#include "driver.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define FRAME_RATE			60
+#define DEFAULT_SECONDS		60
+
+#define SCREEN_WIDTH		320
+#define SCREEN_HEIGHT		224
+
+#define TILE_SIZE			8
+#define TILE_COUNT			1024
+#define MAP_COLS			64
+#define MAP_ROWS			64
+#define MAX_LAYERS			4
+#define DIRTY_PER_FRAME		16
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _bench_layer bench_layer;
+struct _bench_layer
+{
+	tilemap *		tmap;				/* the tilemap */
+	UINT16			tiles[MAP_COLS * MAP_ROWS];	/* tile code and color per cell */
+	int				dx, dy;				/* scroll speed in pixels per frame */
+	int				linescroll;			/* per-line scroll, as for parallax */
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* pieces of the emulator the tilemap code references */
+static running_machine machine;
+static machine_config machine_drv;
+running_machine *Machine = &machine;
+alpha_cache drawgfx_alpha_cache;
+
+/* 8bpp tile graphics and an identity colortable */
+static UINT8 tile_gfx[TILE_COUNT * TILE_SIZE * TILE_SIZE];
+static pen_t bench_pens[256 * 16];
+
+/* the layers and the generator for their contents, reseeded per run */
+static bench_layer layer[MAX_LAYERS];
+static UINT32 tile_seed;
+
+
+
+/***************************************************************************
+    CORE RUNTIME STUBS
+***************************************************************************/
+
+void CLIB_DECL fatalerror(const char *text, ...)
+{
+	va_list arg;
+
+	va_start(arg, text);
+	vfprintf(stderr, text, arg);
+	va_end(arg);
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+void add_exit_callback(running_machine *machine, void (*callback)(running_machine *)) { }
+void state_save_register_memory(const char *module, UINT32 instance, const char *name, void *val, UINT32 valsize, UINT32 valcount) { }
+void state_save_register_func_postload_ptr(void (*func)(void *), void *param) { }
+
+bitmap_t *auto_bitmap_alloc_file_line(int width, int height, bitmap_format format, const char *file, int line)
+{
+	bitmap_t *bitmap = bitmap_alloc(width, height, format);
+	if (bitmap == NULL)
+		fatalerror("Out of memory allocating a %dx%d bitmap (%s:%d)", width, height, file, line);
+	return bitmap;
+}
+
+void *malloc_or_die_file_line(size_t size, const char *file, int line)
+{
+	void *result = malloc(size);
+	if (result == NULL)
+		fatalerror("Out of memory allocating %d bytes (%s:%d)", (int)size, file, line);
+	return result;
+}
+
+
+
+/***************************************************************************
+    TILE DATA
+***************************************************************************/
+
+/*-------------------------------------------------
+    next_random - advance the tile generator
+-------------------------------------------------*/
+
+static UINT32 next_random(void)
+{
+	tile_seed = tile_seed * 1664525 + 1013904223;
+	return tile_seed >> 8;
+}
+
+
+/*-------------------------------------------------
+    make_tiles - build the tile set: a quarter
+    each fully opaque, fully transparent, edges
+    (transparent above a ragged horizon, as for
+    ground and clouds) and outlines (transparent
+    runs at the row ends and a few holes, as for
+    text and scenery)
+-------------------------------------------------*/
+
+static void make_tiles(void)
+{
+	int code, x, y;
+
+	tile_seed = 0;
+	for (code = 0; code < TILE_COUNT; code++)
+	{
+		UINT8 *base = &tile_gfx[code * TILE_SIZE * TILE_SIZE];
+		int kind = code & 3;
+		int horizon = 1 + next_random() % (TILE_SIZE - 2);
+
+		for (y = 0; y < TILE_SIZE; y++)
+		{
+			int left = next_random() % 5, right = TILE_SIZE - next_random() % 5;
+
+			for (x = 0; x < TILE_SIZE; x++)
+			{
+				UINT8 pen = 1 + next_random() % 15;
+
+				if (kind == 1)
+					pen = 0;
+				else if (kind == 2 && (y < horizon || (y == horizon && x < left)))
+					pen = 0;
+				else if (kind == 3 && (x < left || x >= right || next_random() % 16 == 0))
+					pen = 0;
+				base[y * TILE_SIZE + x] = pen;
+			}
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    get_tile_info - the tile callback; the cell
+    holds a 10-bit code and a 4-bit color
+-------------------------------------------------*/
+
+static TILE_GET_INFO( get_tile_info )
+{
+	const bench_layer *which = param;
+	UINT16 data = which->tiles[tile_index];
+
+	tileinfo->pen_data = &tile_gfx[(data & (TILE_COUNT - 1)) * TILE_SIZE * TILE_SIZE];
+	tileinfo->palette_base = (data >> 10) * 16;
+	tileinfo->flags = 0;
+}
+
+
+
+/***************************************************************************
+    BENCHMARK
+***************************************************************************/
+
+/*-------------------------------------------------
+    run_layers - draw the given number of layers
+    for the given number of emulated seconds
+-------------------------------------------------*/
+
+static void run_layers(const char *name, int layers, int seconds)
+{
+	mame_bitmap *bitmap;
+	rectangle clip;
+	osd_ticks_t start, elapsed = 0, tps = osd_ticks_per_second();
+	UINT32 crc = 0;
+	double cpuseconds;
+	int frame, index, y;
+
+	bitmap = bitmap_alloc(SCREEN_WIDTH, SCREEN_HEIGHT, BITMAP_FORMAT_INDEXED16);
+	clip.min_x = 0;
+	clip.max_x = SCREEN_WIDTH - 1;
+	clip.min_y = 0;
+	clip.max_y = SCREEN_HEIGHT - 1;
+
+	/* fill the layers; the front ones are sparser */
+	tile_seed = layers;
+	for (index = 0; index < layers; index++)
+	{
+		bench_layer *which = &layer[index];
+		int cell;
+
+		for (cell = 0; cell < MAP_COLS * MAP_ROWS; cell++)
+		{
+			UINT16 code = next_random() % TILE_COUNT;
+
+			/* the background uses the opaque tiles only */
+			if (index == 0)
+				code &= ~3;
+			else if (next_random() % (index + 1) != 0)
+				code = (code & ~3) | 1;
+			which->tiles[cell] = code | ((next_random() % 16) << 10);
+		}
+
+		which->tmap = tilemap_create(get_tile_info, tilemap_scan_rows, TILEMAP_TYPE_PEN, TILE_SIZE, TILE_SIZE, MAP_COLS, MAP_ROWS);
+		tilemap_set_user_data(which->tmap, which);
+		if (index > 0)
+			tilemap_set_transparent_pen(which->tmap, 0);
+		which->dx = index + 1;
+		which->dy = (index & 1) ? 0 : index / 2 + 1;
+		which->linescroll = (index == 2);
+		if (which->linescroll)
+			tilemap_set_scroll_rows(which->tmap, MAP_ROWS * TILE_SIZE);
+	}
+
+	for (frame = 0; frame < seconds * FRAME_RATE; frame++)
+	{
+		/* scroll, and rewrite a few tiles, as the game would */
+		for (index = 0; index < layers; index++)
+		{
+			bench_layer *which = &layer[index];
+
+			if (which->linescroll)
+				for (y = 0; y < MAP_ROWS * TILE_SIZE; y++)
+					tilemap_set_scrollx(which->tmap, y, frame * which->dx + ((y + frame) & 31));
+			else
+				tilemap_set_scrollx(which->tmap, 0, frame * which->dx);
+			tilemap_set_scrolly(which->tmap, 0, frame * which->dy);
+
+			for (y = 0; y < DIRTY_PER_FRAME; y++)
+			{
+				int cell = next_random() % (MAP_COLS * MAP_ROWS);
+				which->tiles[cell] = (which->tiles[cell] & ~(TILE_COUNT - 1)) | ((which->tiles[cell] + 4) & (TILE_COUNT - 1));
+				tilemap_mark_tile_dirty(which->tmap, cell);
+			}
+		}
+
+		/* only the drawing is timed */
+		start = osd_ticks();
+		for (index = 0; index < layers; index++)
+			tilemap_draw(bitmap, &clip, layer[index].tmap, (index == 0) ? TILEMAP_DRAW_OPAQUE : 0, 0);
+		elapsed += osd_ticks() - start;
+
+		/* checksum the frame little-endian */
+		for (y = 0; y < SCREEN_HEIGHT; y++)
+		{
+			UINT16 *src = BITMAP_ADDR16(bitmap, y, 0);
+			UINT8 bytes[SCREEN_WIDTH * 2];
+			int x;
+
+			for (x = 0; x < SCREEN_WIDTH; x++)
+			{
+				bytes[x * 2 + 0] = src[x] >> 0;
+				bytes[x * 2 + 1] = src[x] >> 8;
+			}
+			crc = crc32(crc, bytes, sizeof(bytes));
+		}
+	}
+	cpuseconds = (double)elapsed / (double)tps;
+
+	printf("%-7s %d frames in %7.3f s (%6.3f ms/frame), crc32 %08x\n",
+			name, seconds * FRAME_RATE, cpuseconds, cpuseconds * 1000.0 / (seconds * FRAME_RATE), crc);
+
+	bitmap_free(bitmap);
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+int CLIB_DECL main(int argc, char *argv[])
+{
+	int seconds = DEFAULT_SECONDS;
+	int argnum, index;
+
+	/* parse the options */
+	for (argnum = 1; argnum < argc; argnum++)
+	{
+		if (strcmp(argv[argnum], "-seconds") == 0 && argnum + 1 < argc)
+			seconds = atoi(argv[++argnum]);
+		else
+		{
+			fprintf(stderr, "Usage:\n  tilebench [-seconds <n>]\n");
+			return 1;
+		}
+	}
+	if (seconds <= 0)
+	{
+		fprintf(stderr, "Invalid -seconds value\n");
+		return 1;
+	}
+
+	/* a single screen with an identity colortable */
+	machine.drv = &machine_drv;
+	machine.screen[0].width = SCREEN_WIDTH;
+	machine.screen[0].height = SCREEN_HEIGHT;
+	for (index = 0; index < ARRAY_LENGTH(bench_pens); index++)
+		bench_pens[index] = index;
+	machine.pens = bench_pens;
+	machine.remapped_colortable = bench_pens;
+	tilemap_init(Machine);
+	make_tiles();
+
+	run_layers("2layer", 2, seconds);
+	run_layers("4layer", 4, seconds);
+	return 0;
+}
@@ -30,6 +30,7 @@ TOOLS += \
 	regrep$(EXE) \
 	srcclean$(EXE) \
 	src2html$(EXE) \
+	sndreplay$(EXE) \
 
 
 
@@ -122,3 +123,153 @@ SRC2HTMLOBJS = \
 src2html$(EXE): $(SRC2HTMLOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
 	@echo Linking $@...
 	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# sndreplay
+#-------------------------------------------------
+
+SNDREPLAYOBJS = \
+	$(TOOLSOBJ)/sndreplay.o \
+	$(filter $(SOUNDOBJ)/fm.o $(SOUNDOBJ)/ymdeltat.o $(SOUNDOBJ)/ym2151.o $(SOUNDOBJ)/ymf262.o,$(SOUNDOBJS)) \
+
+sndreplay$(EXE): $(SNDREPLAYOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# fmbench
+#
+# not part of TOOLS since it is only of use when
+# working on the FM cores; build it by name with
+# "make fmbench"
+#-------------------------------------------------
+
+FMBENCHOBJS = \
+	$(TOOLSOBJ)/fmbench.o \
+	$(filter $(SOUNDOBJ)/fm.o $(SOUNDOBJ)/ymdeltat.o $(SOUNDOBJ)/ym2151.o,$(SOUNDOBJS)) \
+
+fmbench$(EXE): $(FMBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# discbench
+#
+# not part of TOOLS since it links the discrete
+# netlists of some MAME boards; build it by name
+# with "make discbench"
+#-------------------------------------------------
+
+DISCBENCHOBJS = \
+	$(TOOLSOBJ)/discbench.o \
+	$(filter $(SOUNDOBJ)/discrete.o,$(SOUNDOBJS)) \
+	$(EMUOBJ)/sound/wavwrite.o \
+	$(AUDIO)/asteroid.o \
+	$(AUDIO)/canyon.o \
+	$(AUDIO)/dragrace.o \
+	$(AUDIO)/nitedrvr.o \
+	$(AUDIO)/skydiver.o \
+	$(AUDIO)/sprint2.o \
+	$(AUDIO)/subs.o \
+	$(AUDIO)/tank8.o \
+
+discbench$(EXE): $(DISCBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# z80bench
+#
+# not part of TOOLS since it is only of use when
+# working on the Z80 core; build it by name with
+# "make z80bench"
+#-------------------------------------------------
+
+Z80BENCHOBJS = \
+	$(TOOLSOBJ)/z80bench.o \
+	$(filter $(CPUOBJ)/z80/z80.o $(CPUOBJ)/z80/z80daisy.o,$(CPUOBJS)) \
+
+z80bench$(EXE): $(Z80BENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# tilebench
+#
+# not part of TOOLS since it is only of use when
+# working on the tilemap code; build it by name
+# with "make tilebench"
+#-------------------------------------------------
+
+TILEBENCHOBJS = \
+	$(TOOLSOBJ)/tilebench.o \
+	$(EMUOBJ)/tilemap.o \
+
+tilebench$(EXE): $(TILEBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# gspbench
+#
+# not part of TOOLS since it is only of use when
+# working on the TMS34010 core; build it by name
+# with "make gspbench"
+#-------------------------------------------------
+
+GSPBENCHOBJS = \
+	$(TOOLSOBJ)/gspbench.o \
+	$(EMUOBJ)/memory.o \
+	$(filter $(CPUOBJ)/tms34010/tms34010.o $(CPUOBJ)/tms34010/34010fld.o,$(CPUOBJS)) \
+
+gspbench$(EXE): $(GSPBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# voodbench
+#
+# not part of TOOLS since it is only of use when
+# working on the Voodoo emulation; build it by
+# name with "make voodbench"
+#-------------------------------------------------
+
+VOODBENCHOBJS = \
+	$(TOOLSOBJ)/voodbench.o \
+	$(OBJ)/mame/video/voodoo.o \
+
+voodbench$(EXE): $(VOODBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# sharcbench
+#
+# not part of TOOLS since it is only of use when
+# working on the SHARC core; build it by name
+# with "make sharcbench"
+#-------------------------------------------------
+
+SHARCBENCHOBJS = \
+	$(TOOLSOBJ)/sharcbench.o \
+	$(filter $(CPUOBJ)/sharc/sharc.o,$(CPUOBJS)) \
+
+sharcbench$(EXE): $(SHARCBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
@@ -0,0 +1,814 @@
+/***************************************************************************
+
+    voodbench.c
+
+    Drives the 3dfx Voodoo emulation with no driver around it, writing
+    its registers the way a 3D game does, and reports the drawing speed,
+    how often the CPU side had to wait for queued rendering, and a
+    checksum of the color and depth buffers for each of two boards.
+
+    "seattle" is a Voodoo 1 with one TMU, as on the Seattle boards;
+    "vegas" is a Voodoo 2 with two TMUs, as on the Vegas boards.  Each
+    frame clears the back buffer with a fast fill, draws a scene of
+    depth-tested, textured objects (a few large background triangles
+    and many small ones, with the color path, alpha and texture state
+    changing between objects), rewrites part of an animated texture
+    halfway through, draws a small overlay through the LFB and swaps.
+
+    Work queue items are not run until the queue is waited on, which is
+    when a real worker thread would be done with them at the latest, so
+    anything that reads chip state after queueing shows up as a changed
+    checksum.  The time spent in queued items is reported separately:
+    it is the part of the frame worker threads could take over.  The
+    checksum only depends on the Voodoo code, so two builds of it can be
+    compared for accuracy by running both and comparing the figures.
+
+    With -verify, no frames are timed; instead each board draws the
+    given number of single triangles with random modes, register values
+    and textures, and prints the modes, a checksum of the pixels around
+    the triangle and the statistics registers for each.  The modes lean
+    towards the ones the compiled rasterizers handle, so diffing this
+    output between a build with X86_VOODOO_DRC=1 and one without checks
+    the compiled code against the C rasterizers.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "zlib.h"
+#include "driver.h"
+#include "video/voodoo.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define FRAME_RATE			60
+#define DEFAULT_SECONDS		20
+
+#define SCREEN_WIDTH		512
+#define SCREEN_HEIGHT		384
+
+#define OBJECTS_PER_FRAME	96
+#define TRIS_PER_OBJECT		16
+#define BACKGROUND_TRIS		8
+#define TEXTURE_COUNT		8
+#define TEXTURE_SIZE		64
+#define MAX_WORK_ITEMS		256
+
+/* register offsets, in dwords */
+#define REG_VERTEXAX		(0x008/4)
+#define REG_STIPPLE			(0x140/4)
+#define REG_FBIPIXELSIN		(0x14c/4)
+#define REG_STARTR			(0x020/4)
+#define REG_DRDX			(0x040/4)
+#define REG_DRDY			(0x060/4)
+#define REG_TRIANGLECMD		(0x080/4)
+#define REG_FBZCOLORPATH	(0x104/4)
+#define REG_FOGMODE			(0x108/4)
+#define REG_ALPHAMODE		(0x10c/4)
+#define REG_FBZMODE			(0x110/4)
+#define REG_LFBMODE			(0x114/4)
+#define REG_CLIPLEFTRIGHT	(0x118/4)
+#define REG_CLIPLOWYHIGHY	(0x11c/4)
+#define REG_FASTFILLCMD		(0x124/4)
+#define REG_SWAPBUFFERCMD	(0x128/4)
+#define REG_FOGCOLOR		(0x12c/4)
+#define REG_ZACOLOR			(0x130/4)
+#define REG_COLOR0			(0x144/4)
+#define REG_COLOR1			(0x148/4)
+#define REG_FOGTABLE		(0x160/4)
+#define REG_FBIINIT1		(0x214/4)
+#define REG_FBIINIT2		(0x218/4)
+#define REG_FBIINIT3		(0x21c/4)
+#define REG_TEXTUREMODE		(0x300/4)
+#define REG_TLOD			(0x304/4)
+#define REG_TEXBASEADDR		(0x30c/4)
+
+/* the start of the LFB and texture spaces, in dwords */
+#define LFB_BASE			(0x400000/4)
+#define TEXTURE_BASE		(0x800000/4)
+
+/* 64x64 textures are LOD 2 of a 256x256 mipmap */
+#define TEXTURE_LOD			2
+#define TEXTURE_BYTES		(TEXTURE_SIZE * TEXTURE_SIZE * 2)
+
+/* -verify draws triangles up to this size, in this many modes */
+#define VERIFY_SIZE			80
+#define VERIFY_MODES		256
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _bench_board bench_board;
+struct _bench_board
+{
+	const char *	name;				/* board name */
+	int				type;				/* VOODOO_1 or VOODOO_2 */
+	int				tmus;				/* number of TMUs */
+};
+
+
+typedef struct _bench_mode bench_mode;
+struct _bench_mode
+{
+	UINT32			fbzcolorpath;		/* fbzColorPath value */
+	UINT32			alphamode;			/* alphaMode value */
+	UINT32			fogmode;			/* fogMode value */
+	UINT32			fbzmode;			/* fbzMode value */
+	UINT32			texmode;			/* textureMode value */
+	int				singletmu;			/* TMU1 disabled, as single-texture games do */
+};
+
+
+typedef struct _bench_work bench_work;
+struct _bench_work
+{
+	osd_work_callback callback;			/* the queued callback */
+	void *			param;				/* and its parameter */
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* pieces of the emulator the Voodoo code references */
+static running_machine machine;
+running_machine *Machine = &machine;
+mame_time time_zero;
+mame_time time_never;
+static mame_time bench_time;
+
+/* the two boards */
+static const bench_board board_list[] =
+{
+	{ "seattle", VOODOO_1, 1 },
+	{ "vegas",   VOODOO_2, 2 },
+	{ NULL }
+};
+
+/* the object modes; the first ones match rasterizers voodoo.c has */
+/* specialized versions of, the rest go through the generic ones, or */
+/* the compiled ones in a build with X86_VOODOO_DRC=1: decal-textured */
+/* bilinear and point-sampled, and Gouraud-shaded */
+static const bench_mode mode_list[] =
+{
+	{ 0x00000035, 0x00000000, 0x00000000, 0x000B0739, 0x0C261A0F, FALSE },
+	{ 0x00002C35, 0x00515110, 0x00000000, 0x000B07F9, 0x0C261A0F, FALSE },
+	{ 0x00002435, 0x04045119, 0x00000000, 0x00030279, 0x0C261A0F, FALSE },
+	{ 0x00482405, 0x00000000, 0x00000000, 0x000B0739, 0x0C26100F, FALSE },
+	{ 0x00000035, 0x00045119, 0x00000001, 0x000B0779, 0x0C261A0F, FALSE },
+	{ 0x00000001, 0x00000000, 0x00000000, 0x000B0731, 0x00000000, FALSE },
+	{ 0x00000001, 0x00000000, 0x00000000, 0x00020771, 0x0C261A0F, TRUE },
+	{ 0x00000001, 0x00000000, 0x00000000, 0x00020771, 0x0C261A09, TRUE },
+	{ 0x00000000, 0x00000000, 0x00000000, 0x00020771, 0x00000000, FALSE }
+};
+
+/* the work queue, run when it is waited on */
+static bench_work work_list[MAX_WORK_ITEMS];
+static int work_count;
+static osd_ticks_t work_ticks;
+static UINT32 work_items, work_waits;
+
+/* the generator for the scene, reseeded per board */
+static UINT32 bench_seed;
+
+
+
+/***************************************************************************
+    CORE RUNTIME STUBS
+***************************************************************************/
+
+void CLIB_DECL fatalerror(const char *text, ...)
+{
+	va_list arg;
+
+	va_start(arg, text);
+	vfprintf(stderr, text, arg);
+	va_end(arg);
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+void CLIB_DECL logerror(const char *text, ...) { }
+void CLIB_DECL mame_printf_debug(const char *text, ...) { }
+void CLIB_DECL popmessage(const char *text, ...) { }
+void add_exit_callback(running_machine *machine, void (*callback)(running_machine *)) { }
+INT32 input_code_pressed(input_code code) { return 0; }
+
+mame_timer *_mame_timer_alloc_ptr(void (*callback)(running_machine *, void *), void *param, const char *file, int line, const char *func) { return (mame_timer *)&bench_time; }
+void _mame_timer_set_ptr(mame_time duration, void *param, void (*callback)(running_machine *, void *), const char *file, int line, const char *func) { }
+void mame_timer_adjust_ptr(mame_timer *which, mame_time duration, mame_time period) { }
+
+void video_screen_configure(int scrnum, int width, int height, const rectangle *visarea, subseconds_t refresh) { }
+void video_screen_set_visarea(int scrnum, int min_x, int max_x, int min_y, int max_y) { }
+void video_screen_update_partial(int scrnum, int scanline) { }
+int video_screen_get_vpos(int scrnum) { return 0; }
+mame_time video_screen_get_time_until_pos(int scrnum, int vpos, int hpos) { return time_never; }
+mame_time video_screen_get_frame_period(int scrnum) { return time_never; }
+
+void cpu_trigger(int trigger) { }
+void cpu_spinuntil_trigger(int trigger) { }
+void activecpu_eat_cycles(int cycles) { }
+INT64 activecpu_get_info_int(UINT32 state) { return 0; }
+
+void *auto_malloc_file_line(size_t size, const char *file, int line)
+{
+	void *result = malloc(size);
+	if (result == NULL)
+		fatalerror("Out of memory allocating %d bytes (%s:%d)", (int)size, file, line);
+	return result;
+}
+
+
+/*-------------------------------------------------
+    mame_timer_get_time - every access is a
+    millisecond after the last one, so any
+    operation the chip has pending is done
+-------------------------------------------------*/
+
+mame_time mame_timer_get_time(void)
+{
+	bench_time = add_subseconds_to_mame_time(bench_time, MAX_SUBSECONDS / 1000);
+	return bench_time;
+}
+
+
+/*-------------------------------------------------
+    osd_work_queue_alloc/osd_work_queue_free -
+    there is a single queue, held in work_list
+-------------------------------------------------*/
+
+osd_work_queue *osd_work_queue_alloc(int flags)
+{
+	return (osd_work_queue *)work_list;
+}
+
+void osd_work_queue_free(osd_work_queue *queue)
+{
+}
+
+
+/*-------------------------------------------------
+    osd_work_queue_wait - run everything queued,
+    in order, timing it
+-------------------------------------------------*/
+
+int osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
+{
+	osd_ticks_t start = osd_ticks();
+	int index;
+
+	for (index = 0; index < work_count; index++)
+		(*work_list[index].callback)(work_list[index].param);
+	work_count = 0;
+	work_ticks += osd_ticks() - start;
+	work_waits++;
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    osd_work_item_queue - hold on to an item until
+    the queue is waited on
+-------------------------------------------------*/
+
+osd_work_item *osd_work_item_queue(osd_work_queue *queue, osd_work_callback callback, void *param, UINT32 flags)
+{
+	if (work_count == MAX_WORK_ITEMS)
+		fatalerror("Too many work items queued without a wait");
+	work_list[work_count].callback = callback;
+	work_list[work_count].param = param;
+	work_count++;
+	work_items++;
+	return (osd_work_item *)&work_list[work_count - 1];
+}
+
+
+
+/***************************************************************************
+    BENCHMARK
+***************************************************************************/
+
+/*-------------------------------------------------
+    next_random - advance the scene generator
+-------------------------------------------------*/
+
+static UINT32 next_random(void)
+{
+	bench_seed = bench_seed * 1664525 + 1013904223;
+	return bench_seed >> 8;
+}
+
+
+/*-------------------------------------------------
+    write_texture - fill one 64x64 RGB565 texture
+    on every TMU, or just some of its rows
+-------------------------------------------------*/
+
+static void write_texture(const bench_board *board, int texnum, int firstrow, int rows, UINT32 seed)
+{
+	int tmu, t, s;
+
+	voodoo_0_w(REG_TEXTUREMODE, 0x0C261A0F, 0);
+	voodoo_0_w(REG_TLOD, (TEXTURE_LOD << 2) | ((TEXTURE_LOD << 2) << 6), 0);
+	voodoo_0_w(REG_TEXBASEADDR, (texnum * TEXTURE_BYTES * 4) >> 3, 0);
+
+	for (tmu = 0; tmu < board->tmus; tmu++)
+		for (t = firstrow; t < firstrow + rows; t++)
+			for (s = 0; s < TEXTURE_SIZE; s += 2)
+			{
+				/* a checkerboard with some noise, different per texture */
+				UINT32 texel0 = (((s >> 3) ^ (t >> 3)) & 1) ? 0xf800 >> (texnum & 3) : 0x07e0 + texnum;
+				UINT32 texel1 = texel0 ^ ((seed * (s + 1) * (t + 7)) & 0x0821);
+
+				voodoo_0_w(TEXTURE_BASE + (tmu << 19) + (TEXTURE_LOD << 15) + (t << 7) + (s >> 1), texel0 | (texel1 << 16), 0);
+			}
+}
+
+
+/*-------------------------------------------------
+    draw_triangle - draw one Gouraud-shaded,
+    textured, depth-tested triangle
+-------------------------------------------------*/
+
+static void draw_triangle(int size)
+{
+	INT32 x = next_random() % (SCREEN_WIDTH - size);
+	INT32 y = next_random() % (SCREEN_HEIGHT - size);
+	INT32 ax = x + next_random() % size, ay = y;
+	INT32 bx = x, by = y + size;
+	INT32 cx = x + size, cy = y + next_random() % size;
+	INT32 area2 = (bx - ax) * (cy - ay) - (cx - ax) * (by - ay);
+	int param;
+
+	/* vertices are 12.4 */
+	voodoo_0_w(REG_VERTEXAX + 0, ax << 4, 0);
+	voodoo_0_w(REG_VERTEXAX + 1, ay << 4, 0);
+	voodoo_0_w(REG_VERTEXAX + 2, bx << 4, 0);
+	voodoo_0_w(REG_VERTEXAX + 3, by << 4, 0);
+	voodoo_0_w(REG_VERTEXAX + 4, cx << 4, 0);
+	voodoo_0_w(REG_VERTEXAX + 5, cy << 4, 0);
+
+	/* R,G,B,A are 12.12, Z 20.12, S,T 14.18 and W 2.30; the texture */
+	/* spans the triangle, give or take a little */
+	voodoo_0_w(REG_STARTR + 0, (next_random() & 0xff) << 12, 0);
+	voodoo_0_w(REG_STARTR + 1, (next_random() & 0xff) << 12, 0);
+	voodoo_0_w(REG_STARTR + 2, (next_random() & 0xff) << 12, 0);
+	voodoo_0_w(REG_STARTR + 3, (next_random() & 0xffff) << 12, 0);
+	voodoo_0_w(REG_STARTR + 4, 0x80 << 12, 0);
+	voodoo_0_w(REG_STARTR + 5, (next_random() % TEXTURE_SIZE) << 18, 0);
+	voodoo_0_w(REG_STARTR + 6, (next_random() % TEXTURE_SIZE) << 18, 0);
+	voodoo_0_w(REG_STARTR + 7, 1 << 30, 0);
+	for (param = 0; param < 8; param++)
+	{
+		INT32 delta = 0;
+
+		if (param < 3)
+			delta = ((INT32)(next_random() & 0x3ff) - 0x200) << 4;
+		else if (param == 3)
+			delta = ((INT32)(next_random() & 0xfff) - 0x800) << 8;
+		else if (param == 5 || param == 6)
+			delta = (TEXTURE_SIZE << 18) / size;
+		voodoo_0_w(REG_DRDX + param, delta, 0);
+		voodoo_0_w(REG_DRDY + param, (param == 5) ? 0 : delta, 0);
+	}
+
+	/* the sign tells the chip which side the middle vertex is on */
+	voodoo_0_w(REG_TRIANGLECMD, (area2 < 0) ? 0x80000000 : 0, 0);
+}
+
+
+/*-------------------------------------------------
+    checksum_buffer - checksum the front or aux
+    buffer through LFB reads
+-------------------------------------------------*/
+
+static UINT32 checksum_buffer(UINT32 crc, int buffer)
+{
+	int x, y;
+
+	voodoo_0_w(REG_LFBMODE, buffer << 6, 0);
+	for (y = 0; y < SCREEN_HEIGHT; y++)
+	{
+		UINT8 bytes[SCREEN_WIDTH * 2];
+
+		for (x = 0; x < SCREEN_WIDTH; x += 2)
+		{
+			UINT32 data = voodoo_0_r(LFB_BASE + (y << 9) + (x >> 1), 0);
+
+			bytes[x * 2 + 0] = data >> 0;
+			bytes[x * 2 + 1] = data >> 8;
+			bytes[x * 2 + 2] = data >> 16;
+			bytes[x * 2 + 3] = data >> 24;
+		}
+		crc = crc32(crc, bytes, sizeof(bytes));
+	}
+	return crc;
+}
+
+
+/*-------------------------------------------------
+    start_board - bring up a Voodoo with a 512x384
+    screen, double buffered with a depth buffer
+-------------------------------------------------*/
+
+static void start_board(const bench_board *board)
+{
+	int index;
+
+	machine.screen[0].visarea.max_x = SCREEN_WIDTH - 1;
+	machine.screen[0].visarea.max_y = SCREEN_HEIGHT - 1;
+	voodoo_start(0, 0, board->type, 2, 4, (board->tmus > 1) ? 4 : 0);
+	voodoo_set_init_enable(0, 1);
+	voodoo_0_w(REG_FBIINIT1, (SCREEN_WIDTH / 64) << 4, 0);
+	voodoo_0_w(REG_FBIINIT2, (SCREEN_WIDTH * SCREEN_HEIGHT * 2 / 0x1000) << 11, 0);
+	voodoo_0_w(REG_FBIINIT3, (SCREEN_HEIGHT - 1) << 22, 0);
+	voodoo_0_w(REG_CLIPLEFTRIGHT, SCREEN_WIDTH, 0);
+	voodoo_0_w(REG_CLIPLOWYHIGHY, SCREEN_HEIGHT, 0);
+	voodoo_0_w(REG_FOGCOLOR, 0x406080, 0);
+	for (index = 0; index < 32; index++)
+		voodoo_0_w(REG_FOGTABLE + index, ((index * 8 + 4) << 24) | ((index * 8) << 8) | 0x0404, 0);
+}
+
+
+/*-------------------------------------------------
+    run_board - draw frames for the given number
+    of emulated seconds on one board
+-------------------------------------------------*/
+
+static void run_board(const bench_board *board, int seconds)
+{
+	osd_ticks_t start, elapsed = 0, tps = osd_ticks_per_second();
+	UINT32 crc = 0, frames = seconds * FRAME_RATE;
+	double scale;
+	int frame, index;
+
+	start_board(board);
+	bench_seed = 0;
+	for (index = 0; index < TEXTURE_COUNT; index++)
+		write_texture(board, index, 0, TEXTURE_SIZE, next_random());
+
+	work_count = 0;
+	work_ticks = 0;
+	work_items = work_waits = 0;
+	for (frame = 0; frame < frames; frame++)
+	{
+		start = osd_ticks();
+
+		/* clear the back buffer and the depth buffer */
+		voodoo_0_w(REG_FBZMODE, 0x00004601, 0);
+		voodoo_0_w(REG_COLOR1, 0x203040 + frame, 0);
+		voodoo_0_w(REG_ZACOLOR, 0xffff, 0);
+		voodoo_0_w(REG_FASTFILLCMD, 0, 0);
+
+		/* the scene; the background first */
+		for (index = 0; index < OBJECTS_PER_FRAME; index++)
+		{
+			const bench_mode *mode = &mode_list[next_random() % ARRAY_LENGTH(mode_list)];
+			int tri, size;
+
+			voodoo_0_w(REG_FBZCOLORPATH, mode->fbzcolorpath | ((mode->texmode != 0) ? 0x08000000 : 0), 0);
+			voodoo_0_w(REG_ALPHAMODE, mode->alphamode | ((next_random() & 0x7f) << 24), 0);
+			voodoo_0_w(REG_FOGMODE, mode->fogmode, 0);
+			voodoo_0_w(REG_FBZMODE, mode->fbzmode | 0x4000, 0);
+			voodoo_0_w(REG_COLOR0, next_random() & 0xffffff, 0);
+			voodoo_0_w(REG_COLOR1, next_random() & 0xffffff, 0);
+			if (mode->texmode != 0)
+			{
+				voodoo_0_w(REG_TEXTUREMODE, mode->texmode, 0);
+				voodoo_0_w(REG_TLOD, (TEXTURE_LOD << 2) | ((TEXTURE_LOD << 2) << 6), 0);
+				voodoo_0_w(REG_TEXBASEADDR, ((next_random() % TEXTURE_COUNT) * TEXTURE_BYTES * 4) >> 3, 0);
+				if (mode->singletmu && board->tmus > 1)
+					voodoo_0_w(REG_TLOD | (4 << 8), (8 << 2) | ((8 << 2) << 6), 0);
+			}
+
+			for (tri = 0; tri < TRIS_PER_OBJECT; tri++)
+			{
+				size = 4 + next_random() % 36;
+				if (index == 0 && tri < BACKGROUND_TRIS)
+					size = 160 + next_random() % 160;
+				draw_triangle(size);
+			}
+
+			/* animate one texture halfway through */
+			if (index == OBJECTS_PER_FRAME / 2)
+				write_texture(board, TEXTURE_COUNT - 1, frame % (TEXTURE_SIZE - 8), 8, frame);
+		}
+
+		/* an overlay drawn straight into the back buffer */
+		voodoo_0_w(REG_LFBMODE, 0x0010, 0);
+		for (index = 0; index < 16 * 16; index++)
+			voodoo_0_w(LFB_BASE + ((16 + index / 16) << 9) + 8 + index % 16, 0xffff001f, 0);
+
+		/* swap right away */
+		voodoo_0_w(REG_SWAPBUFFERCMD, 0, 0);
+		elapsed += osd_ticks() - start;
+
+		/* checksum what was drawn every few frames */
+		if (frame % 16 == 15)
+			crc = checksum_buffer(checksum_buffer(crc, 0), 2);
+	}
+
+	scale = 1000.0 / (double)tps / frames;
+	printf("%-8s %d frames in %6.3f ms/frame, %6.3f ms/frame in queued work, %5.1f waits/frame, %6.1f items/frame, crc32 %08x\n",
+			board->name, frames, elapsed * scale, work_ticks * scale,
+			(double)work_waits / frames, (double)work_items / frames, crc);
+}
+
+
+
+/***************************************************************************
+    VERIFICATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    random_dword - a full 32 bits of the scene
+    generator
+-------------------------------------------------*/
+
+static UINT32 random_dword(void)
+{
+	return (next_random() << 8) ^ next_random();
+}
+
+
+/*-------------------------------------------------
+    random_delta - a signed value of random
+    magnitude, shifted down by at least 'shift'
+-------------------------------------------------*/
+
+static INT32 random_delta(int shift)
+{
+	return (INT32)random_dword() >> (shift + next_random() % (32 - shift));
+}
+
+
+/*-------------------------------------------------
+    random_texmode/random_tlod - textureMode and
+    tLOD values; mostly ones that pass the texel
+    or its alpha straight through, and LOD
+    ranges that leave the TMU enabled
+-------------------------------------------------*/
+
+static UINT32 random_texmode(void)
+{
+	UINT32 texmode = random_dword();
+	int format = (texmode >> 8) & 0xf;
+
+	/* formats 6, 7 and 15 have no lookup on the Voodoo 1 */
+	if (format == 6 || format == 7 || format == 15)
+		texmode -= 6 << 8;
+
+	if (next_random() % 8 == 0)
+		return texmode;
+	texmode &= ~((3 << 18) | (1 << 13));
+	return texmode | ((1 + next_random() % 2) << 18);
+}
+
+static UINT32 random_tlod(void)
+{
+	UINT32 lodmax = (next_random() % 4 == 0) ? next_random() % 40 : 8 << 2;
+
+	return (next_random() % 40) | (lodmax << 6) | (random_dword() & 0x007ff000);
+}
+
+
+/*-------------------------------------------------
+    checksum_rect - checksum part of the back
+    or aux buffer through LFB reads
+-------------------------------------------------*/
+
+static UINT32 checksum_rect(UINT32 crc, int buffer, int minx, int maxx, int miny, int maxy)
+{
+	int x, y;
+
+	voodoo_0_w(REG_LFBMODE, buffer << 6, 0);
+	for (y = miny; y <= maxy; y++)
+		for (x = minx & ~1; x <= maxx; x += 2)
+		{
+			UINT32 data = voodoo_0_r(LFB_BASE + (y << 9) + (x >> 1), 0);
+			UINT8 bytes[4];
+
+			bytes[0] = data >> 0;
+			bytes[1] = data >> 8;
+			bytes[2] = data >> 16;
+			bytes[3] = data >> 24;
+			crc = crc32(crc, bytes, sizeof(bytes));
+		}
+	return crc;
+}
+
+
+/*-------------------------------------------------
+    verify_board - draw random triangles on one
+    board and print what they did
+-------------------------------------------------*/
+
+static void verify_board(const bench_board *board, int cases)
+{
+	UINT32 total = 0;
+	int casenum, tmu, lod, t, s;
+
+	start_board(board);
+
+	/* fill a 256x256 RGB565 mipmap at the bottom of each TMU with noise */
+	bench_seed = board->tmus;
+	voodoo_0_w(REG_TEXTUREMODE, 0x00000A00, 0);
+	voodoo_0_w(REG_TLOD, (8 << 2) << 6, 0);
+	voodoo_0_w(REG_TEXBASEADDR, 0, 0);
+	for (tmu = 0; tmu < board->tmus; tmu++)
+		for (lod = 0; lod <= 8; lod++)
+			for (t = 0; t < (256 >> lod); t++)
+				for (s = 0; s < (256 >> lod); s += 2)
+					voodoo_0_w(TEXTURE_BASE + (tmu << 19) + (lod << 15) + (t << 7) + (s >> 1), random_dword(), 0);
+
+	for (casenum = 0; casenum < cases; casenum++)
+	{
+		INT32 x = next_random() % (SCREEN_WIDTH - VERIFY_SIZE);
+		INT32 y = next_random() % (SCREEN_HEIGHT - VERIFY_SIZE);
+		INT32 size = 1 + next_random() % VERIFY_SIZE;
+		INT32 ax = x + next_random() % size, ay = y + next_random() % size;
+		INT32 bx = x + next_random() % size, by = y + next_random() % size;
+		INT32 cx = x + next_random() % size, cy = y + next_random() % size;
+		INT32 area2 = (bx - ax) * (cy - ay) - (cx - ax) * (by - ay);
+		UINT32 fbzcp, alphamode, fogmode, fbzmode, texmode[2], tlod[2];
+		UINT32 crc, stats[6], seed;
+		char line[256];
+		int param, left, top;
+
+		/* clear both buffers to random values */
+		voodoo_0_w(REG_CLIPLEFTRIGHT, SCREEN_WIDTH, 0);
+		voodoo_0_w(REG_CLIPLOWYHIGHY, SCREEN_HEIGHT, 0);
+		voodoo_0_w(REG_FBZMODE, 0x00004601, 0);
+		voodoo_0_w(REG_COLOR1, random_dword(), 0);
+		voodoo_0_w(REG_ZACOLOR, random_dword(), 0);
+		voodoo_0_w(REG_FASTFILLCMD, 0, 0);
+
+		/* pick one of a limited set of modes, since each one needs a */
+		/* rasterizer; the color path picks the texel most of the time, */
+		/* and one in eight of each register is completely random */
+		seed = bench_seed;
+		bench_seed = next_random() % VERIFY_MODES;
+		fbzcp = random_dword();
+		if (next_random() % 8 != 0)
+		{
+			static const UINT8 rgbselect[8] = { 1, 1, 1, 1, 0, 0, 2, 3 };
+			fbzcp = (fbzcp & ((1 << 8) | (1 << 13) | (1 << 16) | (1 << 28))) | rgbselect[next_random() % 8];
+			if (next_random() % 4 != 0)
+				fbzcp &= ~((1 << 8) | (1 << 13));
+			if (next_random() % 8 != 0)
+				fbzcp |= 1 << 27;
+		}
+		alphamode = random_dword();
+		if (next_random() % 8 != 0)
+			alphamode &= 0xff000000;
+		fogmode = random_dword();
+		if (next_random() % 8 != 0)
+			fogmode = 0;
+		fbzmode = random_dword();
+		if (next_random() % 8 != 0)
+			fbzmode &= 0x00120ff1;
+		fbzmode = (fbzmode & ~0xc000) | 0x4000;
+		texmode[0] = random_texmode();
+		texmode[1] = random_texmode();
+		bench_seed = seed;
+		tlod[0] = random_tlod();
+		tlod[1] = random_tlod();
+		if (next_random() % 2 == 0)
+			tlod[1] |= 0x20;
+
+		voodoo_0_w(REG_FBZCOLORPATH, fbzcp, 0);
+		voodoo_0_w(REG_ALPHAMODE, alphamode, 0);
+		voodoo_0_w(REG_FOGMODE, fogmode, 0);
+		voodoo_0_w(REG_FBZMODE, fbzmode, 0);
+		voodoo_0_w(REG_COLOR0, random_dword(), 0);
+		voodoo_0_w(REG_COLOR1, random_dword(), 0);
+		voodoo_0_w(REG_ZACOLOR, random_dword(), 0);
+		left = next_random() % SCREEN_WIDTH;
+		top = next_random() % SCREEN_HEIGHT;
+		voodoo_0_w(REG_CLIPLEFTRIGHT, (left << 16) | (left + next_random() % (SCREEN_WIDTH + 1 - left)), 0);
+		voodoo_0_w(REG_CLIPLOWYHIGHY, (top << 16) | (top + next_random() % (SCREEN_HEIGHT + 1 - top)), 0);
+		for (tmu = 0; tmu < board->tmus; tmu++)
+		{
+			voodoo_0_w(REG_TEXTUREMODE | (2 << (tmu + 8)), texmode[tmu], 0);
+			voodoo_0_w(REG_TLOD | (2 << (tmu + 8)), tlod[tmu], 0);
+			voodoo_0_w(REG_TEXBASEADDR | (2 << (tmu + 8)), next_random() % 0x1000, 0);
+		}
+
+		/* the triangle; S and T run anywhere from tiny to huge and W */
+		/* is usually 1.0, but sometimes anything, small, huge or zero */
+		voodoo_0_w(REG_VERTEXAX + 0, ax << 4, 0);
+		voodoo_0_w(REG_VERTEXAX + 1, ay << 4, 0);
+		voodoo_0_w(REG_VERTEXAX + 2, bx << 4, 0);
+		voodoo_0_w(REG_VERTEXAX + 3, by << 4, 0);
+		voodoo_0_w(REG_VERTEXAX + 4, cx << 4, 0);
+		voodoo_0_w(REG_VERTEXAX + 5, cy << 4, 0);
+		for (param = 0; param < 8; param++)
+		{
+			INT32 start = random_dword(), delta = random_delta((param == 5 || param == 6) ? 12 : 4);
+
+			if (param == 7)
+				switch (next_random() % 5)
+				{
+					case 0:	start = 1 << 30;		delta = random_delta(12);	break;
+					case 1:	start &= 0xff;			delta >>= 20;				break;
+					case 2:	start |= 0x7f000000;								break;
+					case 3:	start = 0;				delta = 0;					break;
+				}
+			else if (param >= 5)
+				start >>= next_random() % 8;
+			voodoo_0_w(REG_STARTR + param, start, 0);
+			voodoo_0_w(REG_DRDX + param, delta, 0);
+			voodoo_0_w(REG_DRDY + param, random_delta((param == 5 || param == 6) ? 12 : 4), 0);
+		}
+		voodoo_0_w(REG_TRIANGLECMD, (area2 < 0) ? 0x80000000 : 0, 0);
+
+		/* checksum the box around it, and where the Y origin flips it to */
+		crc = 0;
+		for (param = 0; param < 2; param++)
+		{
+			INT32 minx = MIN(ax, MIN(bx, cx)), maxx = MAX(ax, MAX(bx, cx));
+			INT32 miny = MIN(ay, MIN(by, cy)), maxy = MAX(ay, MAX(by, cy));
+
+			if (param == 1)
+			{
+				INT32 temp = SCREEN_HEIGHT - 1 - miny;
+				miny = SCREEN_HEIGHT - 1 - maxy;
+				maxy = temp;
+			}
+			crc = checksum_rect(checksum_rect(crc, 1, minx, maxx, miny, maxy), 2, minx, maxx, miny, maxy);
+		}
+		stats[0] = voodoo_0_r(REG_FBIPIXELSIN + 0, 0);
+		stats[1] = voodoo_0_r(REG_FBIPIXELSIN + 1, 0);
+		stats[2] = voodoo_0_r(REG_FBIPIXELSIN + 2, 0);
+		stats[3] = voodoo_0_r(REG_FBIPIXELSIN + 3, 0);
+		stats[4] = voodoo_0_r(REG_FBIPIXELSIN + 4, 0);
+		stats[5] = voodoo_0_r(REG_STIPPLE, 0);
+
+		sprintf(line, "%-8s %5d %08x %08x %08x %08x %08x %08x %08x %08x: crc32 %08x, %06x %06x %06x %06x %06x %08x\n",
+				board->name, casenum, fbzcp, alphamode, fogmode, fbzmode, texmode[0], tlod[0], texmode[1], tlod[1],
+				crc, stats[0], stats[1], stats[2], stats[3], stats[4], stats[5]);
+		fputs(line, stdout);
+		total = crc32(total, (UINT8 *)line, strlen(line));
+	}
+
+	printf("%-8s %d cases, crc32 %08x\n", board->name, cases, total);
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+int CLIB_DECL main(int argc, char *argv[])
+{
+	int seconds = DEFAULT_SECONDS, cases = 0;
+	int argnum, index;
+
+	/* parse the options */
+	for (argnum = 1; argnum < argc; argnum++)
+	{
+		if (strcmp(argv[argnum], "-seconds") == 0 && argnum + 1 < argc)
+			seconds = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-verify") == 0 && argnum + 1 < argc)
+		{
+			cases = atoi(argv[++argnum]);
+			if (cases <= 0)
+			{
+				fprintf(stderr, "Invalid -verify value\n");
+				return 1;
+			}
+		}
+		else
+		{
+			fprintf(stderr, "Usage:\n  voodbench [-seconds <n>] [-verify <cases>]\n");
+			return 1;
+		}
+	}
+	if (seconds <= 0)
+	{
+		fprintf(stderr, "Invalid -seconds value\n");
+		return 1;
+	}
+
+	for (index = 0; board_list[index].name != NULL; index++)
+		if (cases != 0)
+			verify_board(&board_list[index], cases);
+		else
+			run_board(&board_list[index], seconds);
+	return 0;
+}
@@ -0,0 +1,344 @@
+/***************************************************************************
+
+    z80bench.c
+
+    Runs the Z80 core with no driver around it, looping over a few
+    fixed instruction mixes in 64k of flat RAM, and reports the
+    emulated cycle throughput and a checksum of the final register
+    and memory state for each mix.
+
+    The mixes are "alu", register-only arithmetic and branches;
+    "memory", loads and stores through HL/DE, the stack, I/O ports,
+    CALL/RET and LDIR, as in typical sound driver code; and "prefix",
+    CB bit operations, IX/IY indexed accesses and ED arithmetic.
+
+    Only the core's execute calls are timed.  The checksum only
+    depends on the core, so two builds of it (for example with and
+    without Z80_THREADED) can be compared for accuracy by running
+    both and comparing the figures.
+
+    Copyright (c) 1996-2007, Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "zlib.h"
+#include "cpuintrf.h"
+#include "cpu/z80/z80.h"
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+#define Z80_CLOCK			4000000
+#define FRAME_RATE			60
+#define DEFAULT_SECONDS		600
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef struct _bench_mix bench_mix;
+struct _bench_mix
+{
+	const char *	name;				/* mix name */
+	const UINT8 *	code;				/* program, loaded at 0000 */
+	int				length;				/* bytes of program */
+	offs_t			sub;				/* where to load the subroutine, if any */
+	const UINT8 *	subcode;			/* subroutine */
+	int				sublength;			/* bytes of subroutine */
+};
+
+
+
+/***************************************************************************
+    PROGRAMS
+***************************************************************************/
+
+/* register arithmetic, a forward branch and a DJNZ loop */
+static const UINT8 alu_code[] =
+{
+	0x06, 0x40,				/* 0000: ld   b,$40      */
+	0x81,					/* 0002: add  a,c        */
+	0xaa,					/* 0003: xor  d          */
+	0x1c,					/* 0004: inc  e          */
+	0x07,					/* 0005: rlca            */
+	0x94,					/* 0006: sub  h          */
+	0x6f,					/* 0007: ld   l,a        */
+	0xe6, 0x7f,				/* 0008: and  $7f        */
+	0xb3,					/* 000a: or   e          */
+	0x88,					/* 000b: adc  a,b        */
+	0x0d,					/* 000c: dec  c          */
+	0x57,					/* 000d: ld   d,a        */
+	0xbd,					/* 000e: cp   l          */
+	0x20, 0x01,				/* 000f: jr   nz,$0012   */
+	0x3c,					/* 0011: inc  a          */
+	0x67,					/* 0012: ld   h,a        */
+	0x10, 0xed,				/* 0013: djnz $0002      */
+	0xc3, 0x00, 0x00		/* 0015: jp   $0000      */
+};
+
+/* pointer loads and stores, I/O, the stack, a call and a block copy */
+static const UINT8 memory_code[] =
+{
+	0x31, 0x00, 0xff,		/* 0000: ld   sp,$ff00   */
+	0x21, 0x00, 0x80,		/* 0003: ld   hl,$8000   */
+	0x11, 0x00, 0x90,		/* 0006: ld   de,$9000   */
+	0x06, 0x20,				/* 0009: ld   b,$20      */
+	0x7e,					/* 000b: ld   a,(hl)     */
+	0x83,					/* 000c: add  a,e        */
+	0x12,					/* 000d: ld   (de),a     */
+	0x34,					/* 000e: inc  (hl)       */
+	0x23,					/* 000f: inc  hl         */
+	0x13,					/* 0010: inc  de         */
+	0x32, 0x00, 0xa0,		/* 0011: ld   ($a000),a  */
+	0xd3, 0x10,				/* 0014: out  ($10),a    */
+	0xdb, 0x11,				/* 0016: in   a,($11)    */
+	0xc5,					/* 0018: push bc         */
+	0xcd, 0x40, 0x00,		/* 0019: call $0040      */
+	0xc1,					/* 001c: pop  bc         */
+	0x10, 0xec,				/* 001d: djnz $000b      */
+	0x21, 0x00, 0x80,		/* 001f: ld   hl,$8000   */
+	0x11, 0x00, 0x90,		/* 0022: ld   de,$9000   */
+	0x01, 0x40, 0x00,		/* 0025: ld   bc,$0040   */
+	0xed, 0xb0,				/* 0028: ldir            */
+	0xc3, 0x03, 0x00		/* 002a: jp   $0003      */
+};
+
+static const UINT8 memory_subcode[] =
+{
+	0xe5,					/* 0040: push hl         */
+	0x2a, 0x00, 0xa0,		/* 0041: ld   hl,($a000) */
+	0x29,					/* 0044: add  hl,hl      */
+	0x22, 0x02, 0xa0,		/* 0045: ld   ($a002),hl */
+	0xe1,					/* 0048: pop  hl         */
+	0xc9					/* 0049: ret             */
+};
+
+/* CB, DD, FD, DDCB, FDCB and ED prefixed operations */
+static const UINT8 prefix_code[] =
+{
+	0x31, 0x00, 0xff,		/* 0000: ld   sp,$ff00   */
+	0xdd, 0x21, 0x00, 0x80,	/* 0003: ld   ix,$8000   */
+	0xfd, 0x21, 0x80, 0x80,	/* 0007: ld   iy,$8080   */
+	0x06, 0x20,				/* 000b: ld   b,$20      */
+	0xdd, 0x7e, 0x05,		/* 000d: ld   a,(ix+5)   */
+	0xfd, 0x86, 0xfe,		/* 0010: add  a,(iy-2)   */
+	0xdd, 0x77, 0x01,		/* 0013: ld   (ix+1),a   */
+	0xcb, 0x3f,				/* 0016: srl  a          */
+	0xcb, 0x11,				/* 0018: rl   c          */
+	0xcb, 0x42,				/* 001a: bit  0,d        */
+	0xcb, 0xea,				/* 001c: set  5,d        */
+	0xdd, 0xcb, 0x02, 0x06,	/* 001e: rlc  (ix+2)     */
+	0xfd, 0xcb, 0x03, 0x46,	/* 0022: bit  0,(iy+3)   */
+	0xed, 0x44,				/* 0026: neg             */
+	0xed, 0x52,				/* 0028: sbc  hl,de      */
+	0xed, 0x4a,				/* 002a: adc  hl,bc      */
+	0x08,					/* 002c: ex   af,af'     */
+	0xd9,					/* 002d: exx             */
+	0xdd, 0x23,				/* 002e: inc  ix         */
+	0xfd, 0x2b,				/* 0030: dec  iy         */
+	0xd9,					/* 0032: exx             */
+	0x08,					/* 0033: ex   af,af'     */
+	0x10, 0xd7,				/* 0034: djnz $000d      */
+	0xc3, 0x03, 0x00		/* 0036: jp   $0003      */
+};
+
+static const bench_mix mix_list[] =
+{
+	{ "alu",    alu_code,    sizeof(alu_code),    0,      NULL,           0 },
+	{ "memory", memory_code, sizeof(memory_code), 0x0040, memory_subcode, sizeof(memory_subcode) },
+	{ "prefix", prefix_code, sizeof(prefix_code), 0,      NULL,           0 },
+	{ NULL }
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* pieces of the emulator the core references */
+UINT8 opcode_entry;
+UINT8 *opcode_base;
+UINT8 *opcode_arg_base;
+offs_t opcode_mask;
+address_space active_address_space[ADDRESS_SPACES];
+int activecpu;
+
+/* the test machine: 64k of RAM and an I/O space that reads back a pattern */
+static UINT8 ram[0x10000];
+static UINT8 io_last;
+
+
+
+/***************************************************************************
+    CORE RUNTIME STUBS
+***************************************************************************/
+
+void CLIB_DECL fatalerror(const char *text, ...)
+{
+	va_list arg;
+
+	va_start(arg, text);
+	vfprintf(stderr, text, arg);
+	va_end(arg);
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+void CLIB_DECL logerror(const char *text, ...) { }
+void memory_set_opbase(offs_t offset) { }
+void state_save_register_memory(const char *module, UINT32 instance, const char *name, void *val, UINT32 valsize, UINT32 valcount) { }
+
+UINT8 program_read_byte_8(offs_t address)				{ return ram[address & 0xffff]; }
+void program_write_byte_8(offs_t address, UINT8 data)	{ ram[address & 0xffff] = data; }
+UINT8 io_read_byte_8(offs_t address)					{ return (address & 0xff) ^ io_last; }
+void io_write_byte_8(offs_t address, UINT8 data)		{ io_last = data; }
+
+
+
+/***************************************************************************
+    BENCHMARK
+***************************************************************************/
+
+/*-------------------------------------------------
+    run_mix - run one instruction mix for the
+    given number of emulated seconds
+-------------------------------------------------*/
+
+static void run_mix(const bench_mix *mix, int seconds)
+{
+	int (*execute)(int cycles);
+	osd_ticks_t start, elapsed = 0, tps = osd_ticks_per_second();
+	UINT64 total = 0, target = (UINT64)seconds * Z80_CLOCK;
+	UINT32 crc = 0;
+	double cpuseconds;
+	cpuinfo info;
+	int regnum;
+
+	/* load the program into clean RAM */
+	memset(ram, 0, sizeof(ram));
+	memcpy(ram, mix->code, mix->length);
+	if (mix->subcode != NULL)
+		memcpy(&ram[mix->sub], mix->subcode, mix->sublength);
+	io_last = 0;
+
+	/* start the core */
+	z80_get_info(CPUINFO_PTR_INIT, &info);
+	(*info.init)(0, Z80_CLOCK, NULL, NULL);
+	z80_get_info(CPUINFO_PTR_RESET, &info);
+	(*info.reset)();
+	z80_get_info(CPUINFO_PTR_EXECUTE, &info);
+	execute = info.execute;
+
+	/* run a frame's worth of cycles at a time, as the scheduler would */
+	while (total < target)
+	{
+		start = osd_ticks();
+		total += (*execute)(Z80_CLOCK / FRAME_RATE);
+		elapsed += osd_ticks() - start;
+	}
+	cpuseconds = (double)elapsed / (double)tps;
+
+	/* checksum the registers, then the RAM */
+	for (regnum = Z80_PC; regnum <= Z80_HL2; regnum++)
+	{
+		UINT8 bytes[2];
+
+		z80_get_info(CPUINFO_INT_REGISTER + regnum, &info);
+		bytes[0] = info.i >> 0;
+		bytes[1] = info.i >> 8;
+		crc = crc32(crc, bytes, 2);
+	}
+	crc = crc32(crc, ram, sizeof(ram));
+
+	printf("%-7s %d s at %d Hz in %7.3f s (%7.2f Mcycles/sec), crc32 %08x\n",
+			mix->name, seconds, Z80_CLOCK, cpuseconds,
+			(cpuseconds > 0) ? (double)total / cpuseconds / 1e6 : 0.0, crc);
+
+	z80_get_info(CPUINFO_PTR_EXIT, &info);
+	if (info.exit != NULL)
+		(*info.exit)();
+}
+
+
+
+/***************************************************************************
+    MAIN
+***************************************************************************/
+
+/* the core allocates its flag tables with plain malloc; this is for the rest */
+void *malloc_or_die_file_line(size_t size, const char *file, int line)
+{
+	void *result = malloc(size);
+	if (result == NULL)
+	{
+		fprintf(stderr, "Out of memory allocating %d bytes (%s:%d)\n", (int)size, file, line);
+		exit(1);
+	}
+	return result;
+}
+
+
+int CLIB_DECL main(int argc, char *argv[])
+{
+	int seconds = DEFAULT_SECONDS;
+	int argnum, index, ran = 0;
+
+	/* parse the options; anything else names a mix to run */
+	for (argnum = 1; argnum < argc && argv[argnum][0] == '-'; argnum++)
+	{
+		if (strcmp(argv[argnum], "-seconds") == 0 && argnum + 1 < argc)
+			seconds = atoi(argv[++argnum]);
+		else
+			break;
+	}
+	if (argnum < argc && argv[argnum][0] == '-')
+	{
+		fprintf(stderr, "Usage:\n  z80bench [-seconds <n>] [mix ...]\n");
+		return 1;
+	}
+	if (seconds <= 0)
+	{
+		fprintf(stderr, "Invalid -seconds value\n");
+		return 1;
+	}
+
+	/* the opcode fetch reads RAM directly; a zero lookup table keeps */
+	/* change_pc from ever asking for a new opcode base */
+	opcode_base = opcode_arg_base = ram;
+	opcode_mask = 0xffff;
+	active_address_space[ADDRESS_SPACE_PROGRAM].addrmask = 0xffff;
+	active_address_space[ADDRESS_SPACE_PROGRAM].readlookup = malloc_or_die(1 << LEVEL1_BITS);
+	memset(active_address_space[ADDRESS_SPACE_PROGRAM].readlookup, 0, 1 << LEVEL1_BITS);
+
+	/* run either the named mixes or all of them */
+	for (index = 0; mix_list[index].name != NULL; index++)
+	{
+		int which;
+
+		for (which = argnum; which < argc; which++)
+			if (mame_stricmp(argv[which], mix_list[index].name) == 0)
+				break;
+		if (argnum == argc || which < argc)
+		{
+			run_mix(&mix_list[index], seconds);
+			ran++;
+		}
+	}
+	if (ran == 0)
+	{
+		fprintf(stderr, "No matching mixes\n");
+		return 1;
+	}
+	return 0;
+}